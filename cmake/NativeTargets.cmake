@@ -47,6 +47,12 @@ add_custom_target(tests-radio
   DEPENDS gtests-radio
   )
 
+# host benchmarks (requires Google Benchmark)
+add_custom_target(benchmarks
+  COMMAND ${CMAKE_CURRENT_BINARY_DIR}/benchmarks-radio
+  DEPENDS benchmarks-radio
+  )
+
 if(Qt5Core_FOUND AND NOT DISABLE_COMPANION)
   add_subdirectory(${COMPANION_SRC_DIRECTORY})
   add_custom_target(tests-companion
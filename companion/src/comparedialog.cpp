@@ -185,3 +185,9 @@ void CompareDialog::on_styleButton_clicked()
   if (g->exec() == QDialog::Accepted)
     compare();
 }
+
+void CompareDialog::on_textOnlyCheckBox_toggled(bool checked)
+{
+  multimodelprinter->setTextOnly(checked);
+  compare();
+}
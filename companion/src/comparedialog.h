@@ -52,6 +52,7 @@ class CompareDialog : public QDialog
     void on_printButton_clicked();
     void on_printFileButton_clicked();
     void on_styleButton_clicked();
+    void on_textOnlyCheckBox_toggled(bool checked);
 
   protected:
     virtual void closeEvent(QCloseEvent * event);
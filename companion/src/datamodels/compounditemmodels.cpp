@@ -143,13 +143,45 @@ void RawSourceItemModel::addItems(const RawSourceType & type, const int group, c
   }
 }
 
+// source types whose names or availability depend on the updated data,
+// all of them when unknown
+static quint32 sourceTypesForEvent(const int event)
+{
+  const quint32 all = (1 << MAX_SOURCE_TYPE) - 1;
+  quint32 types = 0;
+  int handled = 0;
+
+  const struct { int event; quint32 types; } map[] = {
+    { AbstractItemModel::IMUE_Channels,         1 << SOURCE_TYPE_CH },
+    { AbstractItemModel::IMUE_GVars,            1 << SOURCE_TYPE_GVAR },
+    { AbstractItemModel::IMUE_Inputs,           1 << SOURCE_TYPE_VIRTUAL_INPUT },
+    { AbstractItemModel::IMUE_LogicalSwitches,  1 << SOURCE_TYPE_CUSTOM_SWITCH },
+    { AbstractItemModel::IMUE_Scripts,          1 << SOURCE_TYPE_LUA_OUTPUT },
+    { AbstractItemModel::IMUE_TeleSensors,      1 << SOURCE_TYPE_TELEMETRY },
+    { AbstractItemModel::IMUE_Timers,           1 << SOURCE_TYPE_SPECIAL },
+    { AbstractItemModel::IMUE_FunctionSwitches, 1 << SOURCE_TYPE_FUNCTIONSWITCH },
+  };
+
+  for (const auto & entry : map) {
+    if (event & entry.event) {
+      types |= entry.types;
+      handled |= entry.event;
+    }
+  }
+
+  return (event & ~handled) ? all : types;
+}
+
 void RawSourceItemModel::update(const int event)
 {
   if (doUpdate(event)) {
     emit aboutToBeUpdated();
 
-    for (int i = 0; i < rowCount(); ++i)
-      setDynamicItemData(item(i), RawSource(item(i)->data(IMDR_Id).toInt()));
+    const quint32 types = sourceTypesForEvent(event);
+    for (int i = 0; i < rowCount(); ++i) {
+      if (types & (1 << item(i)->data(IMDR_Type).toInt()))
+        setDynamicItemData(item(i), RawSource(item(i)->data(IMDR_Id).toInt()));
+    }
 
     emit updateComplete();
   }
@@ -238,13 +270,40 @@ void RawSwitchItemModel::addItems(const RawSwitchType & type, int count)
   }
 }
 
+// same for the switch types
+static quint32 switchTypesForEvent(const int event)
+{
+  const quint32 all = (1 << MAX_SWITCH_TYPE) - 1;
+  quint32 types = 0;
+  int handled = 0;
+
+  const struct { int event; quint32 types; } map[] = {
+    { AbstractItemModel::IMUE_FlightModes,      1 << SWITCH_TYPE_FLIGHT_MODE },
+    { AbstractItemModel::IMUE_LogicalSwitches,  1 << SWITCH_TYPE_VIRTUAL },
+    { AbstractItemModel::IMUE_TeleSensors,      (1 << SWITCH_TYPE_SENSOR) | (1 << SWITCH_TYPE_TELEMETRY) },
+    { AbstractItemModel::IMUE_FunctionSwitches, 1 << SWITCH_TYPE_FUNCTIONSWITCH },
+  };
+
+  for (const auto & entry : map) {
+    if (event & entry.event) {
+      types |= entry.types;
+      handled |= entry.event;
+    }
+  }
+
+  return (event & ~handled) ? all : types;
+}
+
 void RawSwitchItemModel::update(const int event)
 {
   if (doUpdate(event)) {
     emit aboutToBeUpdated();
 
-    for (int i = 0; i < rowCount(); ++i)
-      setDynamicItemData(item(i), RawSwitch(item(i)->data(IMDR_Id).toInt()));
+    const quint32 types = switchTypesForEvent(event);
+    for (int i = 0; i < rowCount(); ++i) {
+      if (types & (1 << item(i)->data(IMDR_Type).toInt()))
+        setDynamicItemData(item(i), RawSwitch(item(i)->data(IMDR_Id).toInt()));
+    }
 
     emit updateComplete();
   }
@@ -140,7 +140,7 @@ QString CustomFunctionData::paramToString(const ModelData * model) const
     return QString("%1").arg(param);
   }
   else if (func == FuncLogs) {
-    return QString("%1").arg(param / 10.0) + tr("s");
+    return QString("%1").arg(param / 10.0) + tr("s") + ((logsProfile & FUNC_LOGS_ON_CHANGE) ? tr(" on change") : "");
   }
   else if (func == FuncPlaySound) {
     return playSoundToString(param);
@@ -85,6 +85,17 @@ enum GVarAdjustModes
   FUNC_ADJUST_GVAR_COUNT
 };
 
+// as on the radio, only edited there
+enum LogsProfileFlags
+{
+  FUNC_LOGS_NO_STICKS = 0x01,
+  FUNC_LOGS_NO_POTS = 0x02,
+  FUNC_LOGS_NO_SWITCHES = 0x04,
+  FUNC_LOGS_NO_LOGICAL_SWITCHES = 0x08,
+  FUNC_LOGS_NO_CHANNELS = 0x10,
+  FUNC_LOGS_ON_CHANGE = 0x80,
+};
+
 class CustomFunctionData {
   Q_DECLARE_TR_FUNCTIONS(CustomFunctionData)
 
@@ -105,6 +116,7 @@ class CustomFunctionData {
     unsigned int enabled; // TODO perhaps not any more the right name
     unsigned int adjustMode;
     int repeatParam;
+    unsigned int logsProfile; // FuncLogs: LogsProfileFlags
 
     void convert(RadioDataConversionState & cstate);
 
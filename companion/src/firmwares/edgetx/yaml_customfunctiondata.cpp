@@ -208,6 +208,10 @@ Node convert<CustomFunctionData>::encode(const CustomFunctionData& rhs)
   } break;
   case FuncLogs:
     def += std::to_string(rhs.param);
+    if (rhs.logsProfile) {
+      def += ",";
+      def += std::to_string(rhs.logsProfile);
+    }
     break;
   case FuncSetScreen:
     def += std::to_string(rhs.param);
@@ -356,6 +360,12 @@ bool convert<CustomFunctionData>::decode(const Node& node,
     int param = 0;
     def >> param;
     rhs.param = param;
+    if (def.peek() == ',') {
+      def.ignore();
+      unsigned int profile = 0;
+      def >> profile;
+      rhs.logsProfile = profile;
+    }
   } break;
   case FuncSetScreen: {
     int param = 0;
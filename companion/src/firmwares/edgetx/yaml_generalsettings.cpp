@@ -86,6 +86,7 @@ const YamlLookupTable uartModeLut = {
   {  GeneralSettings::AUX_SERIAL_DEBUG, "DEBUG"  },
   {  GeneralSettings::AUX_SERIAL_SPACEMOUSE, "SPACEMOUSE"  },
   {  GeneralSettings::AUX_SERIAL_EXT_MODULE, "EXT_MODULE"  },
+  {  GeneralSettings::AUX_SERIAL_TELE_STREAM, "TELEMETRY_STREAM"  },
 };
 
 const YamlLookupTable antennaModeLut = {
@@ -96,6 +97,12 @@ const YamlLookupTable antennaModeLut = {
   {  GeneralSettings::ANTENNA_MODE_INTERNAL_EXTERNAL, "MODE_INTERNAL_EXTERNAL"  },
 };
 
+const YamlLookupTable stickFilterLut = {
+  {  GeneralSettings::STICK_FILTER_JITTER, "JITTER"  },
+  {  GeneralSettings::STICK_FILTER_ONE_EURO, "ONE_EURO"  },
+  {  GeneralSettings::STICK_FILTER_BIQUAD, "BIQUAD"  },
+};
+
 const YamlLookupTable internalModuleLut = {
   {  MODULE_TYPE_NONE, "TYPE_NONE"  },
   {  MODULE_TYPE_PPM, "TYPE_PPM"  },
@@ -210,6 +217,8 @@ Node convert<GeneralSettings>::encode(const GeneralSettings& rhs)
   node["bluetoothMode"] = bluetoothModeLut << rhs.bluetoothMode;
   node["countryCode"] = rhs.countryCode;
   node["noJitterFilter"] = (int)rhs.noJitterFilter;
+  node["stickFilter"] = stickFilterLut << rhs.stickFilter;
+  node["stickFilterCutoff"] = rhs.stickFilterCutoff;
   node["disableRtcWarning"] = (int)rhs.rtcCheckDisable;  // TODO: verify
   node["audioMuteEnable"] = (int)rhs.muteIfNoSound;
   node["keysBacklight"] = (int)rhs.keysBacklight;
@@ -474,6 +483,8 @@ bool convert<GeneralSettings>::decode(const Node& node, GeneralSettings& rhs)
   node["countryCode"] >> rhs.countryCode;
   node["jitterFilter"] >> rhs.noJitterFilter;   // PR1363 : read old name and
   node["noJitterFilter"] >> rhs.noJitterFilter; // new, but don't write old
+  node["stickFilter"] >> stickFilterLut >> rhs.stickFilter;
+  node["stickFilterCutoff"] >> rhs.stickFilterCutoff;
   node["disableRtcWarning"] >> rhs.rtcCheckDisable;  // TODO: verify
   node["audioMuteEnable"] >> rhs.muteIfNoSound;
   node["keysBacklight"] >> rhs.keysBacklight;
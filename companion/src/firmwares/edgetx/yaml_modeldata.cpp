@@ -39,7 +39,7 @@
 
 #include <string>
 
-SemanticVersion version;  // used for data conversions
+thread_local SemanticVersion version;  // used for data conversions, models are encoded concurrently
 
 static const YamlLookupTable timerModeLut = {
     {TimerData::TIMERMODE_OFF, "OFF"},
@@ -876,6 +876,8 @@ struct convert<FrSkyScreenData> {
 Node convert<ModelData>::encode(const ModelData& rhs)
 {
   version = SemanticVersion(VERSION);
+  // the model is written with the current version, convert to its layout
+  modelSettingsVersion = version;
 
   Node node;
   auto board = getCurrentBoard();
@@ -21,7 +21,7 @@
 #include "yaml_ops.h"
 
 SemanticVersion radioSettingsVersion;
-SemanticVersion modelSettingsVersion;
+thread_local SemanticVersion modelSettingsVersion;
 
 YAML::Node operator >> (const YAML::Node& node, const YamlLookupTable& lut)
 {
@@ -522,6 +522,8 @@ QString GeneralSettings::serialModeToString(int value)
       return tr("SpaceMouse");
     case AUX_SERIAL_EXT_MODULE:
       return tr("External module");
+    case AUX_SERIAL_TELE_STREAM:
+      return tr("Telemetry Stream");
     default:
       return CPN_STR_UNKNOWN_ITEM;
   }
@@ -750,3 +752,49 @@ AbstractStaticItemModel * TrainerMix::srcItemModel()
   mdl->loadItemList();
   return mdl;
 }
+
+//  static
+QString GeneralSettings::stickFilterToString(int value)
+{
+  switch(value) {
+    case STICK_FILTER_JITTER:
+      return tr("Jitter");
+    case STICK_FILTER_ONE_EURO:
+      return tr("1-Euro");
+    case STICK_FILTER_BIQUAD:
+      return tr("Biquad");
+    default:
+      return CPN_STR_UNKNOWN_ITEM;
+  }
+}
+
+//  static
+AbstractStaticItemModel * GeneralSettings::stickFilterItemModel()
+{
+  AbstractStaticItemModel * mdl = new AbstractStaticItemModel();
+  mdl->setName(AIM_GS_STICKFILTER);
+
+  for (int i = 0; i < STICK_FILTER_COUNT; i++) {
+    mdl->appendToItemList(stickFilterToString(i), i);
+  }
+
+  mdl->loadItemList();
+  return mdl;
+}
+
+//  static
+AbstractStaticItemModel * GeneralSettings::stickFilterCutoffItemModel()
+{
+  // cutoff as a divisor of the mixer rate, see radio adc_driver.cpp
+  static const int divisors[] = {8, 12, 16, 24, 32, 48, 64, 96};
+
+  AbstractStaticItemModel * mdl = new AbstractStaticItemModel();
+  mdl->setName(AIM_GS_STICKFILTERCUTOFF);
+
+  for (int i = 0; i <= 7; i++) {
+    mdl->appendToItemList(QString("1/%1").arg(divisors[i]), i);
+  }
+
+  mdl->loadItemList();
+  return mdl;
+}
@@ -42,6 +42,8 @@ constexpr char AIM_GS_SERIALMODE[]         {"gs.serialmode"};
 constexpr char AIM_GS_INTMODULEBAUDRATE[]  {"gs.intmodulebaudrate"};
 constexpr char AIM_GS_STICKDEADZONE[]      {"gs.stickdeadzone"};
 constexpr char AIM_GS_UARTSAMPLEMODE[]     {"gs.uartsamplemode"};
+constexpr char AIM_GS_STICKFILTER[]        {"gs.stickfilter"};
+constexpr char AIM_GS_STICKFILTERCUTOFF[]  {"gs.stickfiltercutoff"};
 constexpr char AIM_TRAINERMIX_MODE[]       {"trainermix.mode"};
 constexpr char AIM_TRAINERMIX_SRC[]        {"trainermix.src"};
 
@@ -144,6 +146,7 @@ class GeneralSettings {
       AUX_SERIAL_DEBUG,
       AUX_SERIAL_SPACEMOUSE,
       AUX_SERIAL_EXT_MODULE,
+      AUX_SERIAL_TELE_STREAM,
       AUX_SERIAL_COUNT
     };
 
@@ -171,6 +174,13 @@ class GeneralSettings {
       UART_SAMPLE_MODE_COUNT
     };
 
+    enum StickFilterType {
+      STICK_FILTER_JITTER,
+      STICK_FILTER_ONE_EURO,
+      STICK_FILTER_BIQUAD,
+      STICK_FILTER_COUNT
+    };
+
     GeneralSettings() { clear(); }
     void clear();
     void init();
@@ -248,6 +258,8 @@ class GeneralSettings {
     unsigned int rotarySteps;
     unsigned int countryCode;
     bool noJitterFilter;
+    unsigned int stickFilter;
+    unsigned int stickFilterCutoff;
     bool rtcCheckDisable;
     bool muteIfNoSound;
     bool keysBacklight;
@@ -321,6 +333,7 @@ class GeneralSettings {
     static FieldRange getPPM_MultiplierRange();
     static FieldRange getTxCurrentCalibration();
     static QString uartSampleModeToString(int value);
+    static QString stickFilterToString(int value);
 
     static AbstractStaticItemModel * antennaModeItemModel(bool model_setup = false);
     static AbstractStaticItemModel * bluetoothModeItemModel();
@@ -328,4 +341,6 @@ class GeneralSettings {
     static AbstractStaticItemModel * internalModuleBaudrateItemModel();
     static AbstractStaticItemModel * stickDeadZoneItemModel();
     static AbstractStaticItemModel * uartSampleModeItemModel();
+    static AbstractStaticItemModel * stickFilterItemModel();
+    static AbstractStaticItemModel * stickFilterCutoffItemModel();
 };
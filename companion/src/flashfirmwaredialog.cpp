@@ -274,6 +274,22 @@ void FlashFirmwareDialog::startFlash(const QString &filename)
 
   ProgressDialog progressDialog(this, tr("Write Firmware to Radio"), CompanionIcon("write_flash.png"));
 
+  // several radios in DFU mode: they are all flashed at once, without the
+  // compatibility check and backup which only work with a single radio
+  QStringList dfuDevices;
+  if (findMassstoragePath("FIRMWARE.BIN").isEmpty())
+    dfuDevices = findDfuDevices();
+  if (dfuDevices.size() > 1) {
+    writeFirmwareBatch(filename, dfuDevices, progressDialog.progress());
+    progressDialog.progress()->setInfo(tr("Flashing done"));
+    progressDialog.exec();
+    if (isTempFileName(filename)) {
+      qDebug() << "startFlash: removing temporary file" << filename;
+      qunlink(filename);
+    }
+    return;
+  }
+
   // check hardware compatibility if requested
   bool checkPassed = true;
   if (g.checkHardwareCompatibility()) {
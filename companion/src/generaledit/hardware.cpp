@@ -172,6 +172,22 @@ HardwarePanel::HardwarePanel(QWidget * parent, GeneralSettings & generalSettings
     filterEnable->setField(generalSettings.noJitterFilter, this, true);
     params->append(filterEnable);
     addParams();
+
+    addLabel(tr("Stick filter"));
+    AutoComboBox *stickFilter = new AutoComboBox(this);
+    stickFilter->setModel(GeneralSettings::stickFilterItemModel());
+    stickFilter->setField(generalSettings.stickFilter, this);
+    params->append(stickFilter);
+
+    QLabel *cutoffLabel = new QLabel(this);
+    cutoffLabel->setText(tr("Cutoff:"));
+    params->append(cutoffLabel);
+
+    AutoComboBox *stickFilterCutoff = new AutoComboBox(this);
+    stickFilterCutoff->setModel(GeneralSettings::stickFilterCutoffItemModel());
+    stickFilterCutoff->setField(generalSettings.stickFilterCutoff, this);
+    params->append(stickFilterCutoff);
+    addParams();
   }
 
   if (Boards::getCapability(board, Board::HasAudioMuteGPIO)) {
@@ -23,6 +23,12 @@
 #include "appdata.h"
 #include "ui_logsdialog.h"
 #include "helpers.h"
+
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
 #if defined _MSC_VER || !defined __GNUC__
 #include <windows.h>
 #else
@@ -43,6 +49,10 @@ LogsDialog::LogsDialog(QWidget *parent) :
   setWindowIcon(CompanionIcon("logs.png"));
 
   plotLock=false;
+  detailBusy = false;
+  detailPending = false;
+  plotGeneration = 0;
+  detailResultGeneration = -1;
 
   colors.append(Qt::green);
   colors.append(Qt::red);
@@ -110,6 +120,9 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), SIGNAL(rangeChanged(QCPRange)), this, SLOT(yAxisChangeRanges(QCPRange)));
+  // refine decimated graphs on zoom and pan:
+  connect(axisRect->axis(QCPAxis::atBottom), SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChangeRange(QCPRange)));
+  connect(this, SIGNAL(detailReady()), this, SLOT(applyDetail()), Qt::QueuedConnection);
 
   // connect some interaction slots:
   connect(ui->customPlot, SIGNAL(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)), this, SLOT(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)));
@@ -123,6 +136,8 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
 LogsDialog::~LogsDialog()
 {
+  if (detailThread.joinable())
+    detailThread.join();
   delete ui;
 }
 
@@ -543,6 +558,8 @@ void LogsDialog::mouseWheel()
 
 void LogsDialog::removeAllGraphs()
 {
+  detailJobs.clear();
+  plotGeneration++;
   ui->customPlot->clearGraphs();
   ui->customPlot->clearItems();
   ui->customPlot->legend->setVisible(false);
@@ -620,13 +637,10 @@ void LogsDialog::saveSession()
     sessionCsvLog.push_back(csvlog[0]);
     // find session breaks
     int currentSession = 0;
-    QDateTime lastvalue;
     for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
+      if (i == 1 || logTime.at(i - 1) - logTime.at(i - 2) > 60) {
         currentSession++;
       }
-      lastvalue = tmp;
       if(currentSession == index) {
         // add records to filtered list
         sessionCsvLog.push_back(csvlog[i]);
@@ -651,55 +665,501 @@ void LogsDialog::saveSession()
   }
 }
 
-bool LogsDialog::cvsFileParse()
+// Binary logs written by radios built with LOG_BINARY
+// (format described in radio/src/logs_binary.h)
+#define BLOG_MAGIC            "ETXB"
+#define BLOG_SECTOR_SIZE      512
+#define BLOG_HEADER_SIZE      12
+#define BLOG_RECORD_KEYFRAME  'K'
+#define BLOG_RECORD_DELTA     'D'
+
+enum BinaryLogFieldType {
+  BLOG_FIELD_TIME,
+  BLOG_FIELD_VALUE,
+  BLOG_FIELD_GPS_LAT,
+  BLOG_FIELD_GPS_LON,
+  BLOG_FIELD_BITS,
+};
+
+static int alignToSector(int pos)
 {
-  QFile file(ui->FileName_LE->text());
-  int errors=0;
-  int lines=-1;
+  return (pos + BLOG_SECTOR_SIZE - 1) / BLOG_SECTOR_SIZE * BLOG_SECTOR_SIZE;
+}
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
-    return false;
-  }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
+static QString formatPrec(qint32 value, int prec)
+{
+  if (prec == 0)
+    return QString::number(value);
+  int div = 1;
+  for (int i = 0; i < prec; i++)
+    div *= 10;
+  QString result = QString("%1.%2").arg(abs(value / div)).arg(abs(value % div), prec, 10, QChar('0'));
+  return value < 0 ? "-" + result : result;
+}
 
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
+bool LogsDialog::binaryLogParse(QFile & file)
+{
+  const QByteArray data = file.readAll();
+  const char * raw = data.constData();
+  int pos = 0;
+
+  // the log is converted into the same rows as a CSV log
+  while (pos + BLOG_HEADER_SIZE <= data.size() && data.mid(pos, 4) == BLOG_MAGIC) {
+    const int count = qFromLittleEndian<quint16>((const uchar *)raw + pos + 6);
+    const quint32 startTime = qFromLittleEndian<quint32>((const uchar *)raw + pos + 8);
+    pos += BLOG_HEADER_SIZE;
+
+    QVector<quint8> types, precs;
+    QStringList names;
+    for (int i = 0; i < count; i++) {
+      int end = data.indexOf('\0', pos + 2);
+      if (end < 0)
+        return !csvlog.isEmpty();
+      types << (quint8)raw[pos];
+      precs << (quint8)raw[pos + 1];
+      names << QString::fromUtf8(raw + pos + 2, end - pos - 2);
+      pos = end + 1;
     }
-    else {
-      return false;
+    pos = alignToSector(pos);
+
+    QStringList header;
+    header << "Date" << "Time";
+    for (int i = 1; i < count; i++) {
+      if (types[i] == BLOG_FIELD_GPS_LON)
+        continue;
+      if (types[i] == BLOG_FIELD_BITS && types[i - 1] == BLOG_FIELD_BITS)
+        continue;
+      header << names[i];
     }
+    if (csvlog.isEmpty())
+      csvlog.append(header);
+    bool sameColumns = (csvlog.at(0) == header);
+
+    QVector<qint32> values(count);
+    while (pos < data.size()) {
+      const char tag = raw[pos];
+      if (tag == BLOG_RECORD_KEYFRAME && pos + 1 + 4 * count <= data.size()) {
+        for (int i = 0; i < count; i++)
+          values[i] = qFromLittleEndian<qint32>((const uchar *)raw + pos + 1 + 4 * i);
+        pos += 1 + 4 * count;
+      }
+      else if (tag == BLOG_RECORD_DELTA && pos + 1 + 2 * count <= data.size()) {
+        for (int i = 0; i < count; i++) {
+          qint16 delta = qFromLittleEndian<qint16>((const uchar *)raw + pos + 1 + 2 * i);
+          if (types[i] == BLOG_FIELD_BITS)
+            values[i] ^= (quint16)delta;
+          else
+            values[i] += delta;
+        }
+        pos += 1 + 2 * count;
+      }
+      else {
+        // end of this segment
+        pos = alignToSector(pos + 1);
+        break;
+      }
 
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
+      if (!sameColumns)
+        continue;
+
+      QDateTime timestamp = QDateTime::fromMSecsSinceEpoch((qint64)startTime * 1000 + (qint64)values[0] * 10, Qt::UTC);
+      QStringList row;
+      row << timestamp.toString("yyyy-MM-dd") << timestamp.toString("HH:mm:ss.zzz");
+      for (int i = 1; i < count; i++) {
+        if (types[i] == BLOG_FIELD_GPS_LAT && i + 1 < count) {
+          if (values[i] || values[i + 1])
+            row << formatPrec(values[i], 6) + " " + formatPrec(values[i + 1], 6);
+          else
+            row << "";
+          i++;
+        }
+        else if (types[i] == BLOG_FIELD_BITS) {
+          quint64 bits = 0;
+          int first = i;
+          while (i < count && types[i] == BLOG_FIELD_BITS) {
+            bits |= (quint64)(quint16)values[i] << (16 * (i - first));
+            i++;
+          }
+          i--;
+          row << "0x" + QString("%1").arg(bits, 16, 16, QChar('0')).toUpper();
+        }
+        else {
+          row << formatPrec(values[i], precs[i]);
+        }
       }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
+      csvlog.append(row);
+    }
+  }
+
+  return true;
+}
+
+// Large logs are parsed in chunks on all cores
+#define LOG_PARSE_CHUNK_MIN   10000
+// Above this many records a graph is drawn from min/max buckets
+#define LOG_PLOT_MAX_POINTS   20000
+
+struct LogChunk {
+  QList<QStringList> rows;
+  QVector<double> time;
+  QVector<QVector<double>> values;
+  int errors = 0;
+};
+
+static int logChunkCount(int count)
+{
+  return qBound(1, count / LOG_PARSE_CHUNK_MIN, qMax(1, (int)std::thread::hardware_concurrency()));
+}
+
+// work(chunk, first, last) is called once per chunk, the first chunk runs on the calling thread
+template <class T>
+static void runLogChunks(int count, int chunks, T work)
+{
+  std::vector<std::thread> threads;
+  for (int i = 1; i < chunks; i++) {
+    threads.emplace_back(work, i, (int)((qint64)count * i / chunks), (int)((qint64)count * (i + 1) / chunks));
+  }
+  work(0, 0, (int)((qint64)count / chunks));
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+}
+
+struct LogTimeCache {
+  QString hour;
+  double base = -1;
+};
+
+// Same result as parsing "yyyy-MM-dd HH:mm:ss[.zzz]" as local time,
+// but the date and hour are only converted when they change
+static double logRecordTime(const QString & date, const QString & time, LogTimeCache & cache)
+{
+  if (date.size() == 10 && time.size() >= 8 && time.at(2) == ':' && time.at(5) == ':') {
+    QString hour = date + time.left(2);
+    if (hour != cache.hour) {
+      QDateTime start = QDateTime::fromString(hour, "yyyy-MM-ddHH");
+      cache.hour = hour;
+      cache.base = start.isValid() ? start.toTime_t() : -1;
+    }
+    if (cache.base >= 0) {
+      double secs = time.midRef(3, 2).toInt() * 60 + time.midRef(6, 2).toInt();
+      if (time.size() > 8)
+        secs += time.midRef(8).toDouble();
+      return cache.base + secs;
+    }
+  }
+
+  QString tstamp = date + " " + time;
+  if (time.contains('.'))
+    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz").toTime_t() + time.mid(time.indexOf('.')).toDouble();
+  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss").toTime_t();
+}
+
+static void convertLogRows(const QList<QStringList> & rows, int first, int last, int fields, LogChunk & chunk)
+{
+  LogTimeCache cache;
+  chunk.time.reserve(last - first);
+  chunk.values.resize(fields - 2);
+  for (QVector<double> & values : chunk.values) {
+    values.reserve(last - first);
+  }
+  for (int i = first; i < last; i++) {
+    const QStringList & row = rows.at(i);
+    chunk.time.append(logRecordTime(row.at(0), row.at(1), cache));
+    for (int j = 2; j < fields; j++) {
+      chunk.values[j - 2].append(row.at(j).toDouble());
+    }
+  }
+}
+
+static QStringList splitLogLine(const char * data, qint64 start, qint64 end)
+{
+  return QString::fromUtf8(data + start, end - start).trimmed().split(',');
+}
+
+void LogsDialog::clearLog()
+{
+  csvlog.clear();
+  logTime.clear();
+  logValues.clear();
+  logLod.clear();
+  overviewCache.clear();
+}
+
+void LogsDialog::parseLogValues()
+{
+  const int fields = csvlog.at(0).count();
+  const int records = csvlog.count() - 1;
+  QVector<LogChunk> chunks(logChunkCount(records));
+  LogChunk * chunkData = chunks.data();
+
+  runLogChunks(records, chunks.size(), [&](int chunk, int first, int last) {
+    convertLogRows(csvlog, first + 1, last + 1, fields, chunkData[chunk]);
+  });
+
+  logValues.resize(fields - 2);
+  for (const LogChunk & chunk : chunks) {
+    logTime += chunk.time;
+    for (int j = 0; j < logValues.size(); j++) {
+      logValues[j] += chunk.values.at(j);
+    }
+  }
+}
+
+bool LogsDialog::csvMappedParse(QFile & file, int & errors, int & lines)
+{
+  const qint64 size = file.size();
+  uchar * mapped = size > 0 ? file.map(0, size) : nullptr;
+  QByteArray buffer;
+  if (!mapped && size > 0) {
+    buffer = file.readAll();
+  }
+  const char * data = mapped ? (const char *)mapped : buffer.constData();
+  if (!size) {
+    return false;
+  }
+
+  QVector<qint64> lineStarts;
+  for (qint64 pos = 0; pos < size; ) {
+    lineStarts.append(pos);
+    const char * end = (const char *)memchr(data + pos, '\n', size - pos);
+    pos = end ? end - data + 1 : size;
+  }
+  lineStarts.append(size);
+
+  if (!QByteArray::fromRawData(data, lineStarts.at(1)).startsWith("Date,Time")) {
+    if (mapped)
+      file.unmap(mapped);
+    return false;
+  }
+
+  const QStringList header = splitLogLine(data, lineStarts.at(0), lineStarts.at(1));
+  const int fields = header.count();
+  const int records = lineStarts.size() - 2;
+  QVector<LogChunk> chunks(logChunkCount(records));
+  LogChunk * chunkData = chunks.data();
+
+  runLogChunks(records, chunks.size(), [&](int chunk, int first, int last) {
+    LogChunk & result = chunkData[chunk];
+    for (int i = first + 1; i < last + 1; i++) {
+      QStringList columns = splitLogLine(data, lineStarts.at(i), lineStarts.at(i + 1));
+      if (columns.count() == fields) {
+        result.rows.append(columns);
       }
       else {
-        errors++;
+        result.errors++;
       }
-      lines++;
     }
+    convertLogRows(result.rows, 0, result.rows.count(), fields, result);
+  });
+
+  csvlog.append(header);
+  logValues.resize(fields - 2);
+  for (const LogChunk & chunk : chunks) {
+    errors += chunk.errors;
+    csvlog += chunk.rows;
+    logTime += chunk.time;
+    for (int j = 0; j < logValues.size(); j++) {
+      logValues[j] += chunk.values.at(j);
+    }
+  }
+  lines = records;
 
+  if (mapped)
+    file.unmap(mapped);
+  return true;
+}
+
+const QVector<QVector<LogsDialog::lodBucket_t>> & LogsDialog::fieldLod(int field)
+{
+  auto it = logLod.constFind(field);
+  if (it != logLod.constEnd()) {
+    return *it;
+  }
+
+  QVector<QVector<lodBucket_t>> & levels = logLod[field];
+  const QVector<double> & values = logValues.at(field);
+
+  QVector<lodBucket_t> level(values.size() / 2);
+  for (int i = 0; i < level.size(); i++) {
+    level[i] = { values.at(2 * i), values.at(2 * i + 1) };
+  }
+
+  while (!level.isEmpty()) {
+    levels.append(level);
+    QVector<lodBucket_t> next(level.size() / 2);
+    for (int i = 0; i < next.size(); i++) {
+      const double c[4] = { level.at(2 * i).first, level.at(2 * i).second, level.at(2 * i + 1).first, level.at(2 * i + 1).second };
+      int lo = 0, hi = 0;
+      for (int k = 1; k < 4; k++) {
+        if (c[k] < c[lo]) lo = k;
+        if (c[k] > c[hi]) hi = k;
+      }
+      next[i] = { c[qMin(lo, hi)], c[qMax(lo, hi)] };
+    }
+    level = next;
+  }
+
+  return levels;
+}
+
+void LogsDialog::decimateRecords(const QVector<double> & time, const QVector<double> & values, const QVector<lodBucket_t> * lod,
+                                 int shift, int first, int end, QVector<double> & x, QVector<double> & y)
+{
+  const int size = 1 << shift;
+  int record = first;
+  while (record < end) {
+    if (lod && !(record & (size - 1)) && record + size <= end) {
+      const lodBucket_t & bucket = lod->at(record >> shift);
+      x.append(time.at(record));
+      y.append(bucket.first);
+      x.append(time.at(record + size - 1));
+      y.append(bucket.second);
+      record += size;
+    }
+    else {
+      x.append(time.at(record));
+      y.append(values.at(record));
+      record++;
+    }
+  }
+}
+
+// Runs on the detail thread: about one bucket per pixel column inside the visible range,
+// the overview points outside of it
+void LogsDialog::computeDetail(detailJob_t & job, double lower, double upper, int width)
+{
+  const double * time = job.time.constData();
+  const int begin = qMax(job.first, (int)(std::lower_bound(time + job.first, time + job.end, lower) - time) - 1);
+  const int stop = qMin(job.end, (int)(std::upper_bound(time + job.first, time + job.end, upper) - time) + 1);
+
+  if (begin >= stop || (begin == job.first && stop == job.end)) {
+    job.x = job.overviewX;
+    job.y = job.overviewY;
+    return;
+  }
+
+  int shift = 0;
+  while (((stop - begin) >> shift) > width)
+    shift++;
+  const QVector<lodBucket_t> * lod = (shift > 0 && shift <= job.lod.size()) ? &job.lod.at(shift - 1) : nullptr;
+
+  QVector<double> x, y;
+  decimateRecords(job.time, job.values, lod, lod ? shift : 0, begin, stop, x, y);
+
+  const double from = time[begin];
+  const double to = time[stop - 1];
+  int i = 0;
+  for (; i < job.overviewX.size() && job.overviewX.at(i) < from; i++) {
+    job.x.append(job.overviewX.at(i));
+    job.y.append(job.overviewY.at(i));
+  }
+  for (int j = 0; j < x.size(); j++) {
+    job.x.append(x.at(j));
+    job.y.append((y.at(j) - job.offset) * job.factor);
+  }
+  for (; i < job.overviewX.size(); i++) {
+    if (job.overviewX.at(i) > to) {
+      job.x.append(job.overviewX.at(i));
+      job.y.append(job.overviewY.at(i));
+    }
+  }
+}
+
+void LogsDialog::startDetail()
+{
+  detailBusy = true;
+  detailPending = false;
+
+  const QCPRange range = axisRect->axis(QCPAxis::atBottom)->range();
+  const int width = qMax(1, axisRect->width());
+  const int generation = plotGeneration;
+  QVector<detailJob_t> jobs = detailJobs;
+
+  detailThread = std::thread([this, jobs, range, width, generation]() mutable {
+    for (detailJob_t & job : jobs) {
+      computeDetail(job, range.lower, range.upper, width);
+    }
+    // only read by applyDetail() once this thread is joined
+    detailResult = jobs;
+    detailResultGeneration = generation;
+    emit detailReady();
+  });
+}
+
+void LogsDialog::xAxisChangeRange(QCPRange range)
+{
+  Q_UNUSED(range);
+  if (detailJobs.isEmpty())
+    return;
+
+  if (detailBusy)
+    detailPending = true;
+  else
+    startDetail();
+}
+
+void LogsDialog::applyDetail()
+{
+  detailThread.join();
+  detailBusy = false;
+
+  if (detailResultGeneration == plotGeneration) {
+    for (const detailJob_t & job : detailResult) {
+      ui->customPlot->graph(job.graph)->setData(job.x, job.y);
+    }
+    ui->customPlot->replot();
+  }
+  detailResult.clear();
+
+  if (detailPending && !detailJobs.isEmpty())
+    startDetail();
+}
+
+bool LogsDialog::cvsFileParse()
+{
+  QFile file(ui->FileName_LE->text());
+  int errors=0;
+  int lines=-1;
+
+  if (file.open(QIODevice::ReadOnly) && file.peek(4) == BLOG_MAGIC) {
+    clearLog();
     logFilename = QFileInfo(file.fileName()).baseName();
+    binaryLogParse(file);
+    file.close();
+    if (csvlog.count() <= 1) {
+      clearLog();
+      return false;
+    }
+    parseLogValues();
+    plotLock = true;
+    setFlightSessions();
+    plotLock = false;
+    return true;
   }
+  file.close();
 
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  clearLog();
+  logFilename.clear();
+  if (!csvMappedParse(file, errors, lines)) {
+    file.close();
+    clearLog();
+    return false;
+  }
+  logFilename = QFileInfo(file.fileName()).baseName();
   file.close();
+
   if (errors > 1) {
     QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
   }
 
   int n = csvlog.count();
   if (n == 1) {
-    csvlog.clear();
+    clearLog();
     return false;
   }
 
@@ -745,14 +1205,11 @@ void LogsDialog::setFlightSessions()
 
   // find session breaks
   QList<int> sessions;
-  QDateTime lastvalue;
   for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
+    if (i == 1 || logTime.at(i - 1) - logTime.at(i - 2) > 60) {
       sessions.push_back(i-1);
       // qDebug() << "session index" << i-1;
     }
-    lastvalue = tmp;
   }
   sessions.push_back(n-1);
 
@@ -839,49 +1296,65 @@ void LogsDialog::plotLogs()
   plots.min_x = QDateTime::currentDateTime().toTime_t();
   plots.max_x = 0;
 
+  // a contiguous range of records may be drawn from the min/max buckets
+  const int firstRow = hasLogSelection ? selectedRows.at(0) : 0;
+  const bool contiguous = !hasLogSelection || selectedRows.at(rowCount - 1) - firstRow + 1 == rowCount;
+
   foreach (QTableWidgetItem *plot, ui->FieldsTW->selectedItems()) {
     coords_t plotCoords;
-    int plotColumn = plot->row() + 2; // Date and Time first
+    int field = plot->row(); // Date and Time are not fields
+    const QVector<double> & values = logValues.at(field);
 
     plotCoords.min_y = INVALID_MIN;
     plotCoords.max_y = INVALID_MAX;
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
 
-    for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
-      }
-
-      y = logValue->text().toDouble();
+    auto addPoint = [&](double time, double y) {
       plotCoords.y.push_back(y);
-
       if (plotCoords.min_y > y) plotCoords.min_y = y;
       if (plotCoords.max_y < y) plotCoords.max_y = y;
 
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
-      }
       plotCoords.x.push_back(time);
-
       if (plots.min_x > time) plots.min_x = time;
       if (plots.max_x < time) plots.max_x = time;
+    };
+
+    int shift = 0;
+    const QVector<lodBucket_t> * lod = nullptr;
+    if (contiguous) {
+      while ((rowCount >> shift) > LOG_PLOT_MAX_POINTS)
+        shift++;
+      if (shift > 0) {
+        const QVector<QVector<lodBucket_t>> & levels = fieldLod(field);
+        if (shift <= levels.size())
+          lod = &levels.at(shift - 1);
+      }
+    }
+
+    plotCoords.field = field;
+    plotCoords.first = plotCoords.end = 0;
+
+    if (!lod) {
+      for (int row = 0; row < rowCount; row++) {
+        int record = hasLogSelection ? selectedRows.at(row) : row;
+        addPoint(logTime.at(record), values.at(record));
+      }
+    }
+    else {
+      // sessions are plotted as the same record ranges again and again
+      QHash<QPair<int, int>, overview_t>::const_iterator overview = overviewCache.constFind(qMakePair(field, firstRow));
+      if (overview == overviewCache.constEnd() || overview->rows != rowCount) {
+        overview_t points;
+        points.rows = rowCount;
+        decimateRecords(logTime, values, lod, shift, firstRow, firstRow + rowCount, points.x, points.y);
+        overview = overviewCache.insert(qMakePair(field, firstRow), points);
+      }
+      for (int i = 0; i < overview->x.size(); i++) {
+        addPoint(overview->x.at(i), overview->y.at(i));
+      }
+      plotCoords.first = firstRow;
+      plotCoords.end = firstRow + rowCount;
     }
 
     double range_inc = (plotCoords.max_y - plotCoords.min_y) / 100;
@@ -1047,6 +1520,21 @@ void LogsDialog::plotLogs()
 
     ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
       plots.coords.at(i).y);
+
+    if (plots.coords.at(i).first < plots.coords.at(i).end) {
+      detailJob_t job;
+      job.graph = i;
+      job.first = plots.coords.at(i).first;
+      job.end = plots.coords.at(i).end;
+      job.offset = plots.tooManyRanges ? plots.coords.at(i).min_y : 0;
+      job.factor = plots.tooManyRanges ? 100 / (plots.coords.at(i).max_y - plots.coords.at(i).min_y) : 1;
+      job.time = logTime;
+      job.values = logValues.at(plots.coords.at(i).field);
+      job.lod = fieldLod(plots.coords.at(i).field);
+      job.overviewX = plots.coords.at(i).x;
+      job.overviewY = plots.coords.at(i).y;
+      detailJobs.append(job);
+    }
     pen.setColor(colors.at(i % colors.size()));
     ui->customPlot->graph(i)->setPen(pen);
 
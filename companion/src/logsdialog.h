@@ -24,6 +24,7 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include <thread>
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -50,6 +51,9 @@ class LogsDialog : public QDialog
     double max_y;
     yaxes_t yaxis;
     QString name;
+    int field;
+    int first;          // contiguous records drawn through the min/max buckets, or first == end
+    int end;
   };
 
   struct minMax_t {
@@ -57,6 +61,31 @@ class LogsDialog : public QDialog
     double max;
   };
 
+  // extrema of a bucket of records, in order of occurrence
+  struct lodBucket_t {
+    double first;
+    double second;
+  };
+
+  // overview of a field over a plotted range of records (usually a session)
+  struct overview_t {
+    int rows;
+    QVector<double> x, y;
+  };
+
+  // finer points for the visible part of a graph, computed off the GUI thread
+  struct detailJob_t {
+    int graph;
+    int first;
+    int end;
+    double offset;      // plotted y = (value - offset) * factor
+    double factor;
+    QVector<double> time, values;
+    QVector<QVector<lodBucket_t>> lod;
+    QVector<double> overviewX, overviewY;
+    QVector<double> x, y;
+  };
+
   struct plotsCollection {
     QVarLengthArray<coords_t> coords;
     double min_x;
@@ -82,9 +111,25 @@ private slots:
   void on_sessions_CB_currentIndexChanged(int index);
   void on_mapsButton_clicked();
   void yAxisChangeRanges(QCPRange range);
+  void xAxisChangeRange(QCPRange range);
+  void applyDetail();
+
+signals:
+  void detailReady();
 
 private:
   QList<QStringList> csvlog;
+  QVector<double> logTime;                            // seconds since epoch, per record
+  QVector<QVector<double>> logValues;                 // numeric value, per field and record
+  QHash<int, QVector<QVector<lodBucket_t>>> logLod;   // per field, level n merges 2^(n+1) records
+  QHash<QPair<int, int>, overview_t> overviewCache;   // per field and first plotted record
+  QVector<detailJob_t> detailJobs;                    // per decimated graph of the current plot
+  QVector<detailJob_t> detailResult;
+  std::thread detailThread;
+  bool detailBusy;
+  bool detailPending;
+  int plotGeneration;
+  int detailResultGeneration;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -103,6 +148,15 @@ private:
   QCPItemStraightLine * cursorLine;
 
   bool cvsFileParse();
+  bool csvMappedParse(QFile & file, int & errors, int & lines);
+  bool binaryLogParse(QFile & file);
+  void clearLog();
+  void parseLogValues();
+  const QVector<QVector<lodBucket_t>> & fieldLod(int field);
+  static void decimateRecords(const QVector<double> & time, const QVector<double> & values, const QVector<lodBucket_t> * lod,
+                              int shift, int first, int end, QVector<double> & x, QVector<double> & y);
+  static void computeDetail(detailJob_t & job, double lower, double upper, int width);
+  void startDetail();
   QList<QStringList> filterGePoints(const QList<QStringList> & input);
   void exportToGoogleEarth();
   QDateTime getRecordTimeStamp(int index);
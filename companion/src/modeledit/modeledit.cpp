@@ -73,53 +73,43 @@ ModelEdit::ModelEdit(QWidget * parent, RadioData & radioData, int modelId, Firmw
 
   SetupPanel * setupPanel = new SetupPanel(this, model, generalSettings, firmware, sharedItemModels);
   addTab(setupPanel, tr("Setup"));
-  s1.report("Setup");
 
+  // the other panels are only built when their tab is first shown
   if (firmware->getCapability(Heli)) {
-    addTab(new HeliPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Heli"));
-    s1.report("Heli");
+    addTab([=, &model, &generalSettings]() { return new HeliPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Heli"));
   }
 
-  addTab(new FlightModesPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Flight Modes"));
-  s1.report("Flight Modes");
+  addTab([=, &model, &generalSettings]() { return new FlightModesPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Flight Modes"));
 
-  addTab(new InputsPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Inputs"));
-  s1.report("Inputs");
+  addTab([=, &model, &generalSettings]() { return new InputsPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Inputs"));
 
-  addTab(new MixesPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Mixes"));
-  s1.report("Mixes");
+  addTab([=, &model, &generalSettings]() { return new MixesPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Mixes"));
 
-  ChannelsPanel * channelsPanel = new ChannelsPanel(this, model, generalSettings, firmware, sharedItemModels);
-  addTab(channelsPanel, tr("Outputs"));
-  s1.report("Outputs");
+  addTab([=, &model, &generalSettings]() {
+    ChannelsPanel * channelsPanel = new ChannelsPanel(this, model, generalSettings, firmware, sharedItemModels);
+    connect(setupPanel, &SetupPanel::extendedLimitsToggled, channelsPanel, &ChannelsPanel::refreshExtendedLimits);
+    return channelsPanel;
+  }, tr("Outputs"));
 
-  addTab(new CurvesPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Curves"));
-  s1.report("Curves");
+  addTab([=, &model, &generalSettings]() { return new CurvesPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Curves"));
 
-  addTab(new LogicalSwitchesPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Logical Switches"));
-  s1.report("Logical Switches");
+  addTab([=, &model, &generalSettings]() { return new LogicalSwitchesPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Logical Switches"));
 
-  addTab(new CustomFunctionsPanel(this, &model, generalSettings, firmware, sharedItemModels), tr("Special Functions"));
-  s1.report("Special Functions");
+  addTab([=, &model, &generalSettings]() { return new CustomFunctionsPanel(this, &model, generalSettings, firmware, sharedItemModels); }, tr("Special Functions"));
 
   if (firmware->getCapability(Telemetry)) {
-    addTab(new TelemetryPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Telemetry"));
-    s1.report("Telemetry");
+    addTab([=, &model, &generalSettings]() { return new TelemetryPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Telemetry"));
   }
 
   if (Boards::getCapability(firmware->getBoard(), Board::HasColorLcd)) {
-    addTab(new ColorCustomScreensPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Custom Screens"));
-    s1.report("ColorLcd Custom Screens");
+    addTab([=, &model, &generalSettings]() { return new ColorCustomScreensPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Custom Screens"));
   }
   else if (firmware->getCapability(TelemetryCustomScreens)) {
-    addTab(new TelemetryCustomScreensPanel(this, model, generalSettings, firmware, sharedItemModels), tr("Custom Screens"));
-    s1.report("Telemetry Custom Screens");
+    addTab([=, &model, &generalSettings]() { return new TelemetryCustomScreensPanel(this, model, generalSettings, firmware, sharedItemModels); }, tr("Custom Screens"));
   }
 
-  addTab(new ModelOptionsPanel(this, model, generalSettings, firmware), tr("Enabled Features"));
-  s1.report("Enabled Features");
+  addTab([=, &model, &generalSettings]() { return new ModelOptionsPanel(this, model, generalSettings, firmware); }, tr("Enabled Features"));
 
-  connect(setupPanel, &SetupPanel::extendedLimitsToggled, channelsPanel, &ChannelsPanel::refreshExtendedLimits);
   connect(ui->tabWidget, &QTabWidget::currentChanged, this, &ModelEdit::onTabIndexChanged);
   connect(ui->pushButton, &QPushButton::clicked, this, &ModelEdit::launchSimulation);
 
@@ -141,19 +131,40 @@ void ModelEdit::closeEvent(QCloseEvent *event)
 
 void ModelEdit::addTab(GenericPanel *panel, QString text)
 {
-  panels << panel;
+  addTab([panel]() { return panel; }, text);
+  createPanel(panels.size() - 1);
+}
+
+void ModelEdit::addTab(std::function<GenericPanel *()> create, QString text)
+{
+  panels << nullptr;
+  panelFactories << create;
   QWidget * widget = new QWidget(ui->tabWidget);
-  QVBoxLayout *baseLayout = new QVBoxLayout(widget);
-  VerticalScrollArea * area = new VerticalScrollArea(widget, panel);
-  baseLayout->addWidget(area);
+  new QVBoxLayout(widget);
   ui->tabWidget->addTab(widget, text);
+}
+
+void ModelEdit::createPanel(int index)
+{
+  Stopwatch s1("ModelEdit");
+  GenericPanel * panel = panelFactories.at(index)();
+  panels[index] = panel;
+
+  QWidget * widget = ui->tabWidget->widget(index);
+  VerticalScrollArea * area = new VerticalScrollArea(widget, panel);
+  widget->layout()->addWidget(area);
   connect(panel, &GenericPanel::modified, this, &ModelEdit::modified);
+  s1.report(ui->tabWidget->tabText(index));
 }
 
 void ModelEdit::onTabIndexChanged(int index)
 {
-  if (index < panels.size())
-    panels.at(index)->update();
+  if (index < 0 || index >= panels.size())
+    return;
+
+  if (!panels.at(index))
+    createPanel(index);
+  panels.at(index)->update();
 }
 
 void ModelEdit::launchSimulation()
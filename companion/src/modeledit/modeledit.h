@@ -24,6 +24,8 @@
 #include <QtWidgets>
 #include "genericpanel.h"
 
+#include <functional>
+
 class RadioData;
 class CompoundItemModelFactory;
 
@@ -64,10 +66,13 @@ class ModelEdit : public QDialog
     int modelId;
     RadioData &radioData;
     Firmware *firmware;
-    QVector<GenericPanel *> panels;
+    QVector<GenericPanel *> panels;   // nullptr until the tab is first shown
+    QVector<std::function<GenericPanel *()>> panelFactories;
     CompoundItemModelFactory *sharedItemModels;
 
     void addTab(GenericPanel * panel, QString text);
+    void addTab(std::function<GenericPanel *()> create, QString text);
+    void createPanel(int index);
     void launchSimulation();
 
 };
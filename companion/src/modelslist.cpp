@@ -606,6 +606,9 @@ void ModelsListModel::refresh()
   removeRows(0, rowCount());
   this->blockSignals(false);
 
+  // counted once, instead of walking all models for each RX #
+  countModelIds();
+
   for (unsigned i = 0; i < radioData->models.size(); i++) {
     ModelData & model = radioData->models[i];
     int currentColumn = 0;
@@ -660,23 +663,31 @@ void ModelsListModel::refresh()
   }
 }
 
-bool ModelsListModel::isModelIdUnique(unsigned modelIdx, unsigned module, unsigned protocol)
+static quint64 rxNumKey(unsigned modelIdx, unsigned module, unsigned protocol)
 {
-  int cnt = 0;
-  if (protocol== PULSES_PXX_XJT_D8)
-    return true;
+  return ((quint64)module << 48) | ((quint64)protocol << 32) | modelIdx;
+}
 
+void ModelsListModel::countModelIds()
+{
+  modelIdCount.clear();
   for (auto const& model: radioData->models) {
     if (!model.isEmpty()) {
-      const ModuleData& moduleData = model.moduleData[module];
-      if (moduleData.protocol == protocol && moduleData.modelId == modelIdx) {
-        if (++cnt > 1) {
-          return false;
-        }
+      unsigned moduleIdx = 0;
+      for (auto const& moduleData: model.moduleData) {
+        modelIdCount[rxNumKey(moduleData.modelId, moduleIdx, moduleData.protocol)]++;
+        moduleIdx++;
       }
     }
   }
-  return true;
+}
+
+bool ModelsListModel::isModelIdUnique(unsigned modelIdx, unsigned module, unsigned protocol)
+{
+  if (protocol== PULSES_PXX_XJT_D8)
+    return true;
+
+  return modelIdCount.value(rxNumKey(modelIdx, module, protocol)) <= 1;
 }
 
 /*
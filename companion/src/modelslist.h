@@ -27,6 +27,7 @@
 #include <QSortFilterProxyModel>
 #include <QMimeData>
 #include <QUuid>
+#include <QHash>
 
 class ModelListItem
 {
@@ -143,12 +144,15 @@ class ModelsListModel : public QAbstractItemModel
 
   private:
     ModelListItem * getItem(const QModelIndex & index) const;
+    void countModelIds();
     bool isModelIdUnique(unsigned modelId, unsigned module, unsigned protocol);
 
     ModelListItem * rootItem;
     RadioData * radioData;
     MimeHeaderData mimeHeaderData;
     bool hasLabels;
+    // models using each module / protocol / RX #, see countModelIds()
+    QHash<quint64, int> modelIdCount;
 };
 
 class ModelsListProxyModel : public QSortFilterProxyModel
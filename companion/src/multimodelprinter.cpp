@@ -22,7 +22,16 @@
 #include "helpers_html.h"
 #include "multimodelprinter.h"
 #include "appdata.h"
+#include "curveimage.h"
+#include <QCryptographicHash>
+#include <QSet>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define SECTION_CACHE_SIZE       64
+#define CURVE_IMAGE_CACHE_SIZE   256
 
 MultiModelPrinter::MultiColumns::MultiColumns(int count):
   count(count),
@@ -230,7 +239,10 @@ QString MultiModelPrinter::printTitle(const QString & label)
 }
 
 MultiModelPrinter::MultiModelPrinter(Firmware * firmware):
-  firmware(firmware)
+  firmware(firmware),
+  textOnly(false),
+  sectionCache(SECTION_CACHE_SIZE),
+  curveImageCache(CURVE_IMAGE_CACHE_SIZE)
 {
 }
 
@@ -265,43 +277,70 @@ void MultiModelPrinter::clearModels()
   modelPrinterMap.clear();
 }
 
+void MultiModelPrinter::setTextOnly(bool textOnly)
+{
+  this->textOnly = textOnly;
+}
+
+// Every section depends only on the models and settings being printed, so a
+// section printed before for the same set is taken from the cache
+QString MultiModelPrinter::printSection(const QString & name, QString (MultiModelPrinter::*printer)())
+{
+  const QString key = name + ":" + modelsKey;
+  if (QString * html = sectionCache.object(key))
+    return *html;
+
+  QString html = (this->*printer)();
+  sectionCache.insert(key, new QString(html));
+  return html;
+}
+
 QString MultiModelPrinter::print(QTextDocument * document)
 {
   if (document) document->clear();
   Stylesheet css(MODEL_PRINT_CSS);
   if (css.load(Stylesheet::StyleType::STYLE_TYPE_EFFECTIVE))
     document->setDefaultStyleSheet(css.text());
+
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  hash.addData(firmware->getId().toUtf8());
+  for (int k=0; k < modelPrinterMap.size(); k++) {
+    hash.addData((const char *)modelPrinterMap.value(k).first, sizeof(ModelData));
+    hash.addData((const char *)modelPrinterMap.value(k).second->gs(), sizeof(GeneralSettings));
+  }
+  modelsKey = hash.result().toHex();
+
   QString str = "<table cellspacing='0' cellpadding='3' width='100%'>";   // attributes not settable via QT stylesheet
-  str.append(printSetup());
+  str.append(printSection("setup", &MultiModelPrinter::printSetup));
   if (firmware->getCapability(HasDisplayText))
-    str.append(printChecklist());
+    str.append(printSection("checklist", &MultiModelPrinter::printChecklist));
   if (firmware->getCapability(Timers)) {
-    str.append(printTimers());
+    str.append(printSection("timers", &MultiModelPrinter::printTimers));
   }
   if (Boards::getCapability(firmware->getBoard(), Board::FunctionSwitches)) {
-    str.append(printFunctionSwitches());
+    str.append(printSection("functionswitches", &MultiModelPrinter::printFunctionSwitches));
   }
 
-  str.append(printModules());
+  str.append(printSection("modules", &MultiModelPrinter::printModules));
   if (firmware->getCapability(Heli))
-    str.append(printHeliSetup());
+    str.append(printSection("heli", &MultiModelPrinter::printHeliSetup));
   if (firmware->getCapability(FlightModes))
-    str.append(printFlightModes());
-  str.append(printInputs());
-  str.append(printMixers());
-  str.append(printOutputs());
-  str.append(printCurves(document));
+    str.append(printSection("flightmodes", &MultiModelPrinter::printFlightModes));
+  str.append(printSection("inputs", &MultiModelPrinter::printInputs));
+  str.append(printSection("mixers", &MultiModelPrinter::printMixers));
+  str.append(printSection("outputs", &MultiModelPrinter::printOutputs));
+  str.append(printCurves(document));    // not cached, the images have to be added to the new document
   if (firmware->getCapability(Gvars) && !firmware->getCapability(GvarsFlightModes))
-    str.append(printGvars());
-  str.append(printLogicalSwitches());
+    str.append(printSection("gvars", &MultiModelPrinter::printGvars));
+  str.append(printSection("logicalswitches", &MultiModelPrinter::printLogicalSwitches));
   if (firmware->getCapability(GlobalFunctions))
-    str.append(printGlobalFunctions());
-  str.append(printSpecialFunctions());
+    str.append(printSection("globalfunctions", &MultiModelPrinter::printGlobalFunctions));
+  str.append(printSection("specialfunctions", &MultiModelPrinter::printSpecialFunctions));
   if (firmware->getCapability(Telemetry)) {
-    str.append(printTelemetry());
-    str.append(printSensors());
+    str.append(printSection("telemetry", &MultiModelPrinter::printTelemetry));
+    str.append(printSection("sensors", &MultiModelPrinter::printSensors));
     if (firmware->getCapability(TelemetryCustomScreens)) {
-      str.append(printTelemetryScreens());
+      str.append(printSection("telemetryscreens", &MultiModelPrinter::printTelemetryScreens));
     }
   }
   str.append("</table>");
@@ -657,32 +696,107 @@ QString MultiModelPrinter::printMixers()
   return str;
 }
 
+// Identical curves, e.g. the same curve in two compared models, share one image
+QString MultiModelPrinter::curveImageName(const CurveData & curve, const QColor & color)
+{
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  hash.addData((const char *)&curve.type, sizeof(curve.type));
+  hash.addData((const char *)&curve.count, sizeof(curve.count));
+  hash.addData((const char *)curve.points, sizeof(curve.points[0]) * std::max(0, std::min(curve.count, CPN_MAX_POINTS)));
+  const QRgb rgb = color.rgb();
+  hash.addData((const char *)&rgb, sizeof(rgb));
+  return QString("mydata://curve-%1.png").arg(QString(hash.result().toHex()));
+}
+
 QString MultiModelPrinter::printCurves(QTextDocument * document)
 {
   QString str;
   MultiColumns columns(modelPrinterMap.size());
   int count = 0;
-  columns.appendSectionTableStart();
+
+  struct CurveRender {
+    QString name;
+    const CurveData * curve;
+    QColor color;
+    QImage image;
+  };
+
+  QVector<int> curves;
+  QVector<QStringList> imageNames;
+  std::vector<CurveRender> renders;
+  QSet<QString> names;
+
   for (int i=0; i<firmware->getCapability(NumCurves); i++) {
-    bool curveEmpty = true;
     for (int k=0; k < modelPrinterMap.size(); k++) {
       if (!modelPrinterMap.value(k).first->curves[i].isEmpty()) {
-        curveEmpty = false;
+        curves.append(i);
         break;
       }
     }
-    if (!curveEmpty) {
-      count++;
-      columns.appendRowStart();
-      columns.appendCellStart(20, true);
-      COMPARE(modelPrinter->printCurveName(i));
-      columns.appendCellEnd(true);
-      COMPARECELL(modelPrinter->printCurve(i));
-      columns.appendRowEnd();
+  }
+
+  if (!textOnly) {
+    for (int i : curves) {
+      QStringList row;
+      for (int k=0; k < modelPrinterMap.size(); k++) {
+        const CurveData & curve = modelPrinterMap.value(k).first->curves[i];
+        const QString name = curveImageName(curve, colors[i]);
+        row.append(name);
+        if (!names.contains(name)) {
+          names.insert(name);
+          if (!curveImageCache.contains(name))
+            renders.push_back({name, &curve, colors[i], QImage()});
+        }
+      }
+      imageNames.append(row);
+    }
+
+    // QImage painting is safe outside the GUI thread, so the missing images are drawn on all cores
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+      size_t j;
+      while ((j = next++) < renders.size()) {
+        CurveImage image;
+        image.drawCurve(*renders[j].curve, renders[j].color);
+        renders[j].image = image.get().copy();
+      }
+    };
+    size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), renders.size());
+    std::vector<std::thread> threads;
+    for (size_t j = 1; j < threadCount; j++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread & thread : threads) {
+      thread.join();
+    }
+
+    for (const CurveRender & render : renders) {
+      curveImageCache.insert(render.name, new QImage(render.image));
+    }
+    if (document) {
+      for (const QString & name : names) {
+        if (QImage * image = curveImageCache.object(name))
+          document->addResource(QTextDocument::ImageResource, QUrl(name), *image);
+      }
+    }
+  }
+
+  columns.appendSectionTableStart();
+  for (int r=0; r < curves.size(); r++) {
+    int i = curves[r];
+    count++;
+    columns.appendRowStart();
+    columns.appendCellStart(20, true);
+    COMPARE(modelPrinter->printCurveName(i));
+    columns.appendCellEnd(true);
+    COMPARECELL(modelPrinter->printCurve(i));
+    columns.appendRowEnd();
+    if (!textOnly) {
       columns.appendRowStart("", 20);
       columns.appendCellStart();
       for (int k=0; k < modelPrinterMap.size(); k++)
-        columns.append(k, QString("<br/><img src='%1' border='0' /><br/>").arg(modelPrinterMap.value(k).second->createCurveImage(i, document)));
+        columns.append(k, QString("<br/><img src='%1' border='0' /><br/>").arg(imageNames[r][k]));
       columns.appendCellEnd();
       columns.appendRowEnd();
     }
@@ -23,6 +23,8 @@
 
 #include <QObject>
 #include <QTextDocument>
+#include <QCache>
+#include <QImage>
 #include "eeprominterface.h"
 #include "modelprinter.h"
 
@@ -37,6 +39,7 @@ class MultiModelPrinter: public QObject
     void setModel(int idx, const ModelData * model, const GeneralSettings * generalSettings);
     void setModel(int idx, const ModelData * model);
     void clearModels();
+    void setTextOnly(bool textOnly);
     QString print(QTextDocument * document);
 
   protected:
@@ -76,7 +79,13 @@ class MultiModelPrinter: public QObject
     Firmware * firmware;
     GeneralSettings defaultSettings;
     QMap<int, QPair<const ModelData *, ModelPrinter *> > modelPrinterMap;
+    bool textOnly;
+    QString modelsKey;                          // identifies the models being printed
+    QCache<QString, QString> sectionCache;      // section html keyed by section and modelsKey
+    QCache<QString, QImage> curveImageCache;    // curve images keyed by curve points and color
 
+    QString printSection(const QString & name, QString (MultiModelPrinter::*printer)());
+    QString curveImageName(const CurveData & curve, const QColor & color);
     QString printTitle(const QString & label);
     QString printSetup();
     QString printModules();
@@ -42,6 +42,7 @@ FlashProcess::FlashProcess(const QString & cmd, const QStringList & args, Progre
   args(args),
   process(new QProcess(this)),
   hasErrors(false),
+  exitCode(-1),
   lfuse(0),
   hfuse(0),
   efuse(0),
@@ -64,6 +65,18 @@ FlashProcess::~FlashProcess()
 }
 
 bool FlashProcess::run()
+{
+  QEventLoop loop;
+  connect(this, SIGNAL(finished()), &loop, SLOT(quit()));
+  if (!start()) {
+    return false;
+  }
+  loop.exec();
+
+  return true;
+}
+
+bool FlashProcess::start()
 {
   if (!QFile::exists(cmd)) {
     QMessageBox::critical(nullptr, CPN_STR_APP_NAME, tr("Executable %1 not found").arg(cmd));
@@ -78,10 +91,7 @@ bool FlashProcess::run()
   }
 #endif
 
-  QEventLoop loop;
-  connect(this, SIGNAL(finished()), &loop, SLOT(quit()));
   process->start(cmd, args);
-  loop.exec();
 
   return true;
 }
@@ -307,6 +317,7 @@ void FlashProcess::onFinished(int code=0)
   if (code==1 && cmd.toLower().contains("sam-ba")) {
     code = 0;
   }
+  exitCode = code;
   if (code) {
     progress->setInfo(tr("Flashing done (exit code = %1)").arg(code));
     if (cmd.toLower().contains("avrdude") || cmd.toLower().contains("dfu")) {
@@ -37,6 +37,9 @@ public:
   FlashProcess(const QString &cmd, const QStringList &args, ProgressWidget *progress);
   ~FlashProcess();
   bool run();
+  // starts the process without waiting, finished() is emitted at the end
+  bool start();
+  bool succeeded() const { return exitCode == 0 && !hasErrors; }
 
 signals:
   void finished();
@@ -58,6 +61,7 @@ protected:
   const QStringList args;
   QProcess * process;
   bool hasErrors;
+  int exitCode;
   QString currStdoutLine;
   QString currStderrLine;
   unsigned int lfuse;
@@ -22,10 +22,16 @@
 
 #include <QApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QElapsedTimer>
 #include <QMutexLocker>
+#include <QStandardPaths>
+#include <QThread>
 
 #define SYNC_MAX_ERRORS       50  // give up after this many errors per destination
+#define SYNC_COPY_THREADS     4   // files copied in parallel
+#define SYNC_COPY_QUEUE       16  // copies queued before the scan waits for them
+#define SYNC_MANIFEST_MAGIC   0x45545853  // "ETXS"
 
 // a flood of log messages can make the UI unresponsive so we'll introduce a dynamic sleep period based on log frequency (values in [us])
 #define PAUSE_FACTOR          60UL
@@ -52,12 +58,51 @@
   #define FILTER_RE_SYNTX     QRegExp::WildcardUnix
 #endif
 
+class SyncProcess::CopyTask : public QRunnable
+{
+  public:
+    CopyTask(SyncProcess * process, const CopyJob & job) :
+      process(process),
+      job(job)
+    {
+    }
+
+    void run() override
+    {
+      QFile destinationFile(job.destPath);
+      job.ok = false;
+      if (job.replace && !destinationFile.remove()) {
+        job.error = SyncProcess::tr("Could not delete destination file '%1': %2").arg(job.destPath, destinationFile.errorString());
+      }
+      else {
+        QFile sourceFile(job.srcPath);
+        if (!sourceFile.copy(job.destPath)) {
+          job.error = SyncProcess::tr("Copy failed: '%1' to '%2': %3").arg(job.srcPath, job.destPath, sourceFile.errorString());
+        }
+        else {
+          const QFileInfo destInfo(job.destPath);
+          job.dest = { destInfo.size(), destInfo.lastModified().toMSecsSinceEpoch(), job.hash };
+          job.ok = true;
+        }
+      }
+
+      QMutexLocker locker(&process->m_copyMutex);
+      process->m_copyResults.append(job);
+      process->m_copyPending.deref();
+    }
+
+  private:
+    SyncProcess * process;
+    CopyJob job;
+};
+
 SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
   m_options(options),
   m_pauseTime(PAUSE_MINTM),
   stopping(false)
 {
   qRegisterMetaType<SyncProcess::SyncStatus>();
+  m_copyPool.setMaxThreadCount(SYNC_COPY_THREADS);
 
   if (m_options.compareType == OVERWR_ALWAYS && (m_options.direction == SYNC_A2B_B2A || m_options.direction == SYNC_B2A_A2B))
     m_options.compareType = OVERWR_IF_DIFF;
@@ -85,6 +130,8 @@ SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
 
 SyncProcess::~SyncProcess()
 {
+  m_copyPool.clear();
+  m_copyPool.waitForDone();
 #ifdef Q_OS_WIN
   qt_ntfs_permission_lookup--;  // global revert NTFS permissions checking
 #endif
@@ -171,12 +218,19 @@ void SyncProcess::run()
 
 void SyncProcess::finish()
 {
-  const lldiv_t elapsed = lldiv(m_startTime.secsTo(QDateTime::currentDateTime()), 60);
+  waitForCopies();
+  saveManifests();
+
+  const qint64 elapsedMs = qMax<qint64>(1, m_startTime.msecsTo(QDateTime::currentDateTime()));
+  const lldiv_t elapsed = lldiv(elapsedMs / 1000, 60);
   QString endStr = testRunStr;
   if (m_stat.index < m_stat.count)
     endStr.append(tr("Synchronization aborted at %1 of %2 files.").arg(m_stat.index).arg(m_stat.count));
   else
     endStr.append(tr("Synchronization finished with %1 files in %2m %3s.").arg(m_stat.count).arg(elapsed.quot).arg(elapsed.rem));
+  if (m_stat.bytesCopied)
+    endStr.append(tr(" Copied %1 KB at %2 KB/s.").arg(m_stat.bytesCopied / 1024).arg(m_stat.bytesCopied * 1000 / 1024 / elapsedMs));
+  PRINT_INFO(endStr);
   emit statusMessage(endStr);
   emit finished();
 }
@@ -258,6 +312,7 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
       pushDirEntries(fi, it);
       if ((m_dirFilters & QDir::Dirs) || fi.isFile()) {
         updateEntry(fi.filePath(), srcDir, dstDir);
+        processCopyResults();
         if (fi.isFile())
           ++m_stat.index;
         emit statusUpdate(m_stat);
@@ -288,6 +343,9 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
     pause();
   }
 
+  // the other direction must see the copied files
+  waitForCopies();
+
   QString endStr = "\n" % testRunStr;
   if (isStopRequsted())
     endStr.append(tr("Aborted synchronization of:"));
@@ -336,8 +394,6 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
   }
 
   //qDebug() << destPath;
-  QFile sourceFile(srcPath);
-  QFile destinationFile(destPath);
   const bool destExists = destInfo.exists();
   bool checkDate = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_NEWER_ALWAYS);
   bool checkContent = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_IF_DIFF);
@@ -358,22 +414,23 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
     checkDate = false;
   }
 
+  QByteArray sourceHash;
   if (destExists && checkContent) {
-    if (!sourceFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, sourceFile.errorString()));
+    QString error;
+    sourceHash = fileHash(source, sourceInfo, error);
+    if (sourceHash.isEmpty()) {
+      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, error));
       ++m_stat.errored;
       return false;
     }
-    if (!destinationFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, destinationFile.errorString()));
+    const QByteArray destHash = fileHash(destination, destInfo, error);
+    if (destHash.isEmpty()) {
+      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, error));
       ++m_stat.errored;
       return false;
     }
 
-    const bool skip = QCryptographicHash::hash(sourceFile.readAll(), QCryptographicHash::Md5) == QCryptographicHash::hash(destinationFile.readAll(), QCryptographicHash::Md5);
-    sourceFile.close();
-    destinationFile.close();
-    if (skip) {
+    if (sourceHash == destHash) {
       PRINT_SKIP(tr("Skipping identical file: %1").arg(srcPath));
       ++m_stat.skipped;
       return true;
@@ -385,28 +442,156 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
     if (destInfo.exists()) {
       existed = true;
       PRINT_REPLACE(tr("Replacing file: %1").arg(destPath));
-      if (!(m_options.flags & OPT_DRY_RUN) && !destinationFile.remove()) {
-        PRINT_ERROR(tr("Could not delete destination file '%1': %2").arg(destPath, destinationFile.errorString()));
-        ++m_stat.errored;
-        return false;
-      }
     }
     else {
       PRINT_CREATE(tr("Creating file: %1").arg(destPath));
     }
-    if (!(m_options.flags & OPT_DRY_RUN) && !sourceFile.copy(destPath)) {
-      PRINT_ERROR(tr("Copy failed: '%1' to '%2': %3").arg(srcPath, destPath, sourceFile.errorString()));
-      ++m_stat.errored;
-      return false;
+
+    if (m_options.flags & OPT_DRY_RUN) {
+      if (existed)
+        ++m_stat.updated;
+      else
+        ++m_stat.created;
+      return true;
+    }
+
+    CopyJob job;
+    job.srcPath = srcPath;
+    job.destPath = destPath;
+    job.destRoot = destination.absolutePath();
+    job.destEntry = destination.relativeFilePath(destInfo.absoluteFilePath());
+    job.hash = sourceHash;
+    job.replace = existed;
+    queueCopy(job);
+  }
+
+  return true;
+}
+
+QString SyncProcess::manifestPath(const QString & root)
+{
+  const QByteArray id = QCryptographicHash::hash(QDir::cleanPath(root).toUtf8(), QCryptographicHash::Md5).toHex();
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) % "/sync/" % QString(id) % ".manifest";
+}
+
+SyncProcess::Manifest & SyncProcess::treeManifest(const QDir & root)
+{
+  const QString path = root.absolutePath();
+  QMap<QString, Manifest>::iterator it = m_manifests.find(path);
+  if (it != m_manifests.end())
+    return *it;
+
+  Manifest & manifest = m_manifests[path];
+  QFile file(manifestPath(path));
+  if (file.open(QIODevice::ReadOnly)) {
+    QDataStream in(&file);
+    quint32 magic, count;
+    in >> magic >> count;
+    if (magic == SYNC_MANIFEST_MAGIC) {
+      for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        QString entry;
+        ManifestEntry e;
+        in >> entry >> e.size >> e.modified >> e.hash;
+        manifest.insert(entry, e);
+      }
     }
+    if (in.status() != QDataStream::Ok)
+      manifest.clear();
+  }
+  return manifest;
+}
+
+QByteArray SyncProcess::fileHash(const QDir & root, const QFileInfo & fileInfo, QString & error)
+{
+  Manifest & manifest = treeManifest(root);
+  const QString entry = root.relativeFilePath(fileInfo.absoluteFilePath());
+  const qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+  Manifest::const_iterator it = manifest.constFind(entry);
+  if (it != manifest.constEnd() && it->size == fileInfo.size() && it->modified == modified && !it->hash.isEmpty())
+    return it->hash;
+
+  QFile file(fileInfo.absoluteFilePath());
+  if (!file.open(QFile::ReadOnly)) {
+    error = file.errorString();
+    return QByteArray();
+  }
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  hash.addData(&file);
+  manifest.insert(entry, { fileInfo.size(), modified, hash.result() });
+  return manifest.value(entry).hash;
+}
+
+void SyncProcess::saveManifests()
+{
+  for (QMap<QString, Manifest>::const_iterator it = m_manifests.constBegin(); it != m_manifests.constEnd(); ++it) {
+    const QString path = manifestPath(it.key());
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+      qDebug() << "Could not write sync manifest" << path << file.errorString();
+      continue;
+    }
+    QDataStream out(&file);
+    out << (quint32)SYNC_MANIFEST_MAGIC << (quint32)it->size();
+    for (Manifest::const_iterator e = it->constBegin(); e != it->constEnd(); ++e)
+      out << e.key() << e->size << e->modified << e->hash;
+  }
+}
+
+void SyncProcess::queueCopy(const CopyJob & job)
+{
+  // bounded queue: the scan waits for the copies to catch up
+  while (m_copyPending.load() >= SYNC_COPY_QUEUE && !isStopRequsted()) {
+    processCopyResults();
+    QApplication::processEvents();
+    QThread::msleep(1);
+  }
+  m_copyPending.ref();
+  m_copyPool.start(new CopyTask(this, job));
+}
+
+void SyncProcess::processCopyResults()
+{
+  QList<CopyJob> results;
+  {
+    QMutexLocker locker(&m_copyMutex);
+    results.swap(m_copyResults);
+  }
 
-    if (existed)
+  for (const CopyJob & job : results) {
+    if (!job.ok) {
+      PRINT_ERROR(job.error);
+      ++m_stat.errored;
+      continue;
+    }
+    if (job.replace)
       ++m_stat.updated;
     else
       ++m_stat.created;
+    m_stat.bytesCopied += job.dest.size;
+    if (!job.hash.isEmpty())
+      m_manifests[job.destRoot].insert(job.destEntry, job.dest);
   }
 
-  return true;
+  if (!results.isEmpty())
+    emit statusUpdate(m_stat);
+}
+
+void SyncProcess::waitForCopies()
+{
+  if (isStopRequsted()) {
+    // drop the copies which have not started yet
+    m_copyPool.clear();
+    m_copyPool.waitForDone();
+    m_copyPending.store(0);
+  }
+  while (m_copyPending.load() > 0) {
+    processCopyResults();
+    QApplication::processEvents();
+    QThread::msleep(1);
+  }
+  processCopyResults();
 }
 
 void SyncProcess::pause()
@@ -26,8 +26,12 @@
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
 #include <QReadWriteLock>
 #include <QRegExp>
+#include <QThreadPool>
 #include <QVector>
 
 class SyncProcess : public QObject
@@ -102,9 +106,18 @@ class SyncProcess : public QObject
         int updated;
         int skipped;
         int errored;
+        qint64 bytesCopied;
         void clear() { memset(this, 0, sizeof(SyncStatus)); }
     };
 
+    // content hash of a file, re-used as long as its size and modification time are unchanged
+    struct ManifestEntry {
+        qint64 size;
+        qint64 modified;   // ms since epoch
+        QByteArray hash;   // MD5
+    };
+    typedef QHash<QString, ManifestEntry> Manifest;  // by path relative to the tree root
+
     explicit SyncProcess(const SyncOptions & options);
     ~SyncProcess();
 
@@ -134,6 +147,27 @@ class SyncProcess : public QObject
     void pause();
     void emitProgressMessage(const QString &text, int type);
 
+    struct CopyJob {
+        QString srcPath;
+        QString destPath;
+        QString destRoot;
+        QString destEntry;
+        QByteArray hash;   // source content hash, if known
+        bool replace;
+        bool ok;
+        QString error;
+        ManifestEntry dest;
+    };
+    class CopyTask;
+
+    Manifest & treeManifest(const QDir & root);
+    QByteArray fileHash(const QDir & root, const QFileInfo & fileInfo, QString & error);
+    void saveManifests();
+    static QString manifestPath(const QString & root);
+    void queueCopy(const CopyJob & job);
+    void processCopyResults();
+    void waitForCopies();
+
     SyncOptions m_options;
     SyncStatus m_stat;
     QReadWriteLock stopReqMutex;
@@ -144,6 +178,11 @@ class SyncProcess : public QObject
     QDateTime m_startTime;
     unsigned long m_pauseTime;
     bool stopping;
+    QMap<QString, Manifest> m_manifests;   // by tree root
+    QThreadPool m_copyPool;
+    QMutex m_copyMutex;
+    QList<CopyJob> m_copyResults;
+    QAtomicInt m_copyPending;
 };
 
 Q_DECLARE_METATYPE(SyncProcess::SyncOptions)
@@ -29,6 +29,12 @@
 #include "storage.h"
 #include "progresswidget.h"
 
+#include <QDialog>
+#include <QEventLoop>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QVBoxLayout>
+
 QString getRadioInterfaceCmd()
 {
   burnConfigDialog bcd;
@@ -40,7 +46,7 @@ QString getRadioInterfaceCmd()
     return bcd.getSAMBA();
 }
 
-QStringList getDfuArgs(const QString & cmd, const QString & filename)
+QStringList getDfuArgs(const QString & cmd, const QString & filename, const QString & serial)
 {
   QStringList args;
   burnConfigDialog bcd;
@@ -50,6 +56,8 @@ QStringList getDfuArgs(const QString & cmd, const QString & filename)
   if (cmd == "-U")
     args.last().append(":" % QString::number(Boards::getFlashSize(getCurrentBoard())));
   args << "--device" << "0483:df11";
+  if (!serial.isEmpty())
+    args << "--serial" << serial;
   args << cmd % filename;
   return args;
 }
@@ -175,6 +183,123 @@ bool writeFirmware(const QString & filename, ProgressWidget * progress)
   return flashProcess.run();
 }
 
+QStringList findDfuDevices()
+{
+  QStringList serials;
+  QString cmd = getRadioInterfaceCmd();
+  if (!IS_STM32(getCurrentBoard()) || !QFile::exists(cmd))
+    return serials;
+
+  QProcess process;
+  process.start(cmd, QStringList() << "-l");
+  if (!process.waitForFinished(5000))
+    return serials;
+
+  // Found DFU: [0483:df11] ver=2200, devnum=5, cfg=1, intf=0, path="1-1", alt=0, name="...", serial="..."
+  QRegularExpression regex("Found DFU: \\[0483:df11\\].* alt=0,.* serial=\"([^\"]*)\"");
+  foreach (const QString & line, QString(process.readAllStandardOutput()).split('\n')) {
+    QRegularExpressionMatch match = regex.match(line);
+    if (match.hasMatch() && !serials.contains(match.captured(1))) {
+      serials << match.captured(1);
+    }
+  }
+
+  qDebug() << "findDfuDevices: found" << serials;
+  return serials;
+}
+
+// runs the processes at the same time, returns when they are all finished
+static void runFlashProcesses(const QList<FlashProcess *> & processes)
+{
+  QEventLoop loop;
+  int running = 0;
+  for (FlashProcess * process : processes) {
+    QObject::connect(process, &FlashProcess::finished, &loop, [&]() {
+      if (--running == 0)
+        loop.quit();
+    });
+    if (process->start())
+      running++;
+  }
+  if (running > 0)
+    loop.exec();
+}
+
+static bool isSameFirmware(const QString & filename, const QString & readback)
+{
+  QFile firmwareFile(filename);
+  QFile readbackFile(readback);
+  if (!firmwareFile.open(QIODevice::ReadOnly) || !readbackFile.open(QIODevice::ReadOnly))
+    return false;
+
+  QByteArray firmware = firmwareFile.readAll();
+  return !firmware.isEmpty() && readbackFile.read(firmware.size()) == firmware;
+}
+
+bool writeFirmwareBatch(const QString & filename, const QStringList & devices, ProgressWidget * progress)
+{
+  QDialog dialog(progress);
+  dialog.setWindowTitle(QCoreApplication::translate("RadioInterface", "Write Firmware to Radios"));
+  QVBoxLayout * layout = new QVBoxLayout(&dialog);
+
+  QList<ProgressWidget *> widgets;
+  QList<FlashProcess *> processes;
+  for (const QString & serial : devices) {
+    ProgressWidget * widget = new ProgressWidget(&dialog);
+    widget->setInfo(QCoreApplication::translate("RadioInterface", "Radio %1: writing...").arg(serial));
+    layout->addWidget(widget);
+    widgets << widget;
+    processes << new FlashProcess(getRadioInterfaceCmd(), getDfuArgs("-D", filename, serial), widget);
+  }
+  dialog.show();
+
+  qDebug() << "writeFirmwareBatch: writing" << filename << "to" << devices.size() << "radios";
+  runFlashProcesses(processes);
+
+  // .dfu files hold their own addresses, only raw images can be compared
+  bool verify = !filename.endsWith(".dfu");
+  QStringList readbacks;
+  QList<FlashProcess *> verifications;
+  for (int i = 0; i < devices.size(); i++) {
+    readbacks << generateProcessUniqueTempFileName(QString("verify-%1.bin").arg(i));
+    if (verify && processes[i]->succeeded()) {
+      widgets[i]->setInfo(QCoreApplication::translate("RadioInterface", "Radio %1: verifying...").arg(devices[i]));
+      verifications << new FlashProcess(getRadioInterfaceCmd(), getDfuArgs("-U", readbacks[i], devices[i]), widgets[i]);
+    }
+    else {
+      verifications << nullptr;
+    }
+  }
+
+  QList<FlashProcess *> pending = verifications;
+  pending.removeAll(nullptr);
+  runFlashProcesses(pending);
+
+  bool result = true;
+  for (int i = 0; i < devices.size(); i++) {
+    if (!processes[i]->succeeded()) {
+      progress->addMessage(QCoreApplication::translate("RadioInterface", "Radio %1: write failed").arg(devices[i]), QtFatalMsg);
+      result = false;
+    }
+    else if (!verify) {
+      progress->addMessage(QCoreApplication::translate("RadioInterface", "Radio %1: written (not verified)").arg(devices[i]));
+    }
+    else if (!verifications[i]->succeeded() || !isSameFirmware(filename, readbacks[i])) {
+      progress->addMessage(QCoreApplication::translate("RadioInterface", "Radio %1: verify failed").arg(devices[i]), QtFatalMsg);
+      result = false;
+    }
+    else {
+      progress->addMessage(QCoreApplication::translate("RadioInterface", "Radio %1: written and verified").arg(devices[i]));
+    }
+    if (QFile::exists(readbacks[i]))
+      qunlink(readbacks[i]);
+  }
+
+  qDeleteAll(processes);
+  qDeleteAll(pending);
+  return result;
+}
+
 bool readSettings(const QString & filename, ProgressWidget * progress)
 {
   Board::Type board = getCurrentBoard();
@@ -31,7 +31,7 @@ QString getRadioInterfaceCmd();
 QString findMassstoragePath(const QString &filename, bool onlyPath = false);
 
 QStringList getSambaArgs(const QString &tcl);
-QStringList getDfuArgs(const QString &cmd, const QString &filename);
+QStringList getDfuArgs(const QString &cmd, const QString &filename, const QString &serial = QString());
 
 QStringList getReadEEpromCmd(const QString &filename);
 QStringList getWriteEEpromCmd(const QString &filename);
@@ -40,6 +40,10 @@ QStringList getWriteFirmwareArgs(const QString &filename);
 
 bool readFirmware(const QString &filename, ProgressWidget *progress);
 bool writeFirmware(const QString &filename, ProgressWidget *progress);
+// serial numbers of the radios connected in DFU mode
+QStringList findDfuDevices();
+// writes and verifies the firmware on all these radios at the same time
+bool writeFirmwareBatch(const QString &filename, const QStringList &devices, ProgressWidget *progress);
 bool readSettings(const QString &filename, ProgressWidget *progress);
 bool readSettingsSDCard(const QString &filename, ProgressWidget *progress);
 bool readSettingsEeprom(const QString &filename, ProgressWidget *progress);
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "performancestats.h"
+#include "simulatorinterface.h"
+
+#include <QHeaderView>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+PerformanceStats::PerformanceStats(SimulatorInterface * simulator, QWidget * parent) :
+  QWidget(parent),
+  table(new QTableWidget(0, 3, this))
+{
+  table->setHorizontalHeaderLabels(QStringList() << tr("p50 (us)") << tr("p99 (us)") << tr("Max (us)"));
+  table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+  table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  table->setSelectionMode(QAbstractItemView::NoSelection);
+
+  auto * layout = new QVBoxLayout(this);
+  layout->setContentsMargins(0, 0, 0, 0);
+  layout->addWidget(table);
+
+  connect(simulator, &SimulatorInterface::performanceStat, this, &PerformanceStats::onPerformanceStat);
+  connect(simulator, &SimulatorInterface::started, this, &PerformanceStats::onStarted);
+}
+
+void PerformanceStats::onPerformanceStat(const QString & name, qint32 p50, qint32 p99, qint32 max)
+{
+  int row = rows.value(name, -1);
+  if (row < 0) {
+    row = table->rowCount();
+    rows.insert(name, row);
+    table->insertRow(row);
+    table->setVerticalHeaderItem(row, new QTableWidgetItem(name));
+    for (int col = 0; col < table->columnCount(); col++) {
+      auto * item = new QTableWidgetItem();
+      item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+      table->setItem(row, col, item);
+    }
+  }
+
+  const qint32 values[] = { p50, p99, max };
+  for (int col = 0; col < table->columnCount(); col++) {
+    table->item(row, col)->setText(values[col] < 0 ? "-" : QString::number(values[col]));
+  }
+}
+
+void PerformanceStats::onStarted()
+{
+  rows.clear();
+  table->setRowCount(0);
+}
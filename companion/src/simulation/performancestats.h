@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _PERFORMANCESTATS_H_
+#define _PERFORMANCESTATS_H_
+
+#include <QMap>
+#include <QWidget>
+
+class SimulatorInterface;
+class QTableWidget;
+
+// Live view of the run time counters of the simulated firmware
+class PerformanceStats : public QWidget
+{
+    Q_OBJECT
+
+  public:
+    explicit PerformanceStats(SimulatorInterface * simulator, QWidget * parent = nullptr);
+
+  protected slots:
+    void onPerformanceStat(const QString & name, qint32 p50, qint32 p99, qint32 max);
+    void onStarted();
+
+  protected:
+    QTableWidget * table;
+    QMap<QString, int> rows;
+};
+
+#endif // _PERFORMANCESTATS_H_
@@ -132,8 +132,9 @@ void SimulatedUIWidget::onLcdChange(bool backlightEnable)
   if (!m_lcd || !m_lcd->isVisible())
     return;
 
+  const QRect dirty = m_simulator->getLcdDirtyRect();
   uint8_t* lcdBuf = m_simulator->getLcd();
-  m_lcd->onLcdChanged(lcdBuf, backlightEnable);
+  m_lcd->onLcdChanged(lcdBuf, backlightEnable, dirty);
   m_simulator->lcdFlushed();
 
   setLightOn(backlightEnable);
@@ -22,7 +22,10 @@
 #include "customdebug.h"
 #include "version.h"
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
 #include <QLibraryInfo>
 
 #if defined _MSC_VER || !defined __GNUC__
@@ -34,6 +37,7 @@
 #endif
 
 QMap<QString, QLibrary *> SimulatorLoader::registeredSimulators;
+QMap<SimulatorInterface *, QLibrary *> SimulatorLoader::privateInstances;
 
 QStringList SimulatorLoader::getAvailableSimulators()
 {
@@ -105,10 +109,48 @@ void SimulatorLoader::registerSimulators()
 
 void SimulatorLoader::unregisterSimulators()
 {
+  foreach(QLibrary * lib, privateInstances)
+    unloadPrivateCopy(lib);
+  privateInstances.clear();
+
   foreach(QLibrary * lib, registeredSimulators)
     delete lib;
 }
 
+// The firmware keeps its radio state (model, settings, mixer and its tasks) in library globals,
+// so a second concurrent instance needs its own copy of the library mapped under another name.
+QLibrary * SimulatorLoader::loadPrivateCopy(QLibrary * lib)
+{
+  static quint16 copies = 0;
+
+  QFileInfo fi(lib->fileName());
+  QString copyName = QDir::temp().filePath(QString("%1-%2-%3.%4").arg(fi.completeBaseName()).arg(QCoreApplication::applicationPid()).arg(++copies).arg(fi.suffix()));
+
+  QFile::remove(copyName);
+  if (!QFile::copy(lib->fileName(), copyName)) {
+    qWarning() << "Could not copy simulator library" << lib->fileName() << "to" << copyName;
+    return NULL;
+  }
+
+  QLibrary * copy = new QLibrary(copyName);
+  if (!copy->load()) {
+    qWarning() << "Library error" << copyName << copy->errorString();
+    unloadPrivateCopy(copy);
+    return NULL;
+  }
+
+  qCDebug(simulatorInterfaceLoader) << "Loaded private copy of" << lib->fileName() << "as" << copyName;
+  return copy;
+}
+
+void SimulatorLoader::unloadPrivateCopy(QLibrary * lib)
+{
+  QString fileName = lib->fileName();
+  lib->unload();
+  delete lib;
+  QFile::remove(fileName);
+}
+
 QString SimulatorLoader::findSimulatorByName(const QString & name)
 {
   int pos;
@@ -146,48 +188,69 @@ SimulatorInterface * SimulatorLoader::loadSimulator(const QString & name)
     return si;
   }
 
+  QLibrary * shared = lib;
+  if (lib->property("instances_used").toUInt() > 0) {
+    // already running a model: give this instance its own radio state
+    lib = loadPrivateCopy(shared);
+    if (!lib)
+      return si;
+  }
+
   qCDebug(simulatorInterfaceLoader) << "Trying to load simulator in " << lib->fileName();
 
   SimulatorFactory * factory;
   RegisterSimulator registerFunc = (RegisterSimulator)lib->resolve("registerSimu");
   if (registerFunc && (factory = registerFunc()) && (si = factory->create())) {
-    quint8 instance = lib->property("instances_used").toUInt();
-    lib->setProperty("instances_used", ++instance);
-    qCDebug(simulatorInterfaceLoader) << "Loaded" << factory->name() << "simulator instance" << instance;
+    if (lib == shared) {
+      lib->setProperty("instances_used", 1);
+      qCDebug(simulatorInterfaceLoader) << "Loaded" << factory->name() << "simulator";
+    }
+    else {
+      privateInstances.insert(si, lib);
+      qCDebug(simulatorInterfaceLoader) << "Loaded" << factory->name() << "simulator instance" << privateInstances.size() + 1;
+    }
     delete factory;
   }
   else {
     qWarning() << "Library error" << lib->fileName() << lib->errorString();
+    if (lib != shared)
+      unloadPrivateCopy(lib);
   }
   return si;
 }
 
-bool SimulatorLoader::unloadSimulator(const QString & name)
+bool SimulatorLoader::unloadSimulator(const QString & name, SimulatorInterface * instance)
 {
   bool ret = false;
-#if SIMULATOR_INTERFACE_LOADER_DYNAMIC
+
+  // instance is only used as a key here, it may already be deleted
+  if (instance && privateInstances.contains(instance)) {
+    unloadPrivateCopy(privateInstances.take(instance));
+    qCDebug(simulatorInterfaceLoader) << "Unloaded private" << name << "simulator, instances remaining:" << privateInstances.size();
+    return true;
+  }
+
   QString simuName = findSimulatorByName(name);
   if (simuName.isEmpty())
     return ret;
 
   QLibrary * lib = registeredSimulators.value(simuName, NULL);
+  if (!lib)
+    return ret;
 
-  if (lib && lib->isLoaded()) {
-    quint8 instance = lib->property("instances_used").toUInt();
-    lib->setProperty("instances_used", --instance);
-    if (!instance) {
-      ret = lib->unload();
-      qCDebug(simulatorInterfaceLoader) << "Unloading" << simuName << "(" << lib->fileName() << ")" << "result:" << ret;
-    }
-    else {
-      ret = true;
-      qCDebug(simulatorInterfaceLoader) << "Simulator" << simuName << "instances remaining:" << instance;
-    }
+  // the shared library is free again for the next instance
+  lib->setProperty("instances_used", 0);
+
+#if SIMULATOR_INTERFACE_LOADER_DYNAMIC
+  if (lib->isLoaded()) {
+    ret = lib->unload();
+    qCDebug(simulatorInterfaceLoader) << "Unloading" << simuName << "(" << lib->fileName() << ")" << "result:" << ret;
   }
   else {
     qCDebug(simulatorInterfaceLoader) << "Simulator library for " << simuName << "already unloaded.";
   }
 #else
+  ret = true;
   qCDebug(simulatorInterfaceLoader) << "Keeping simulator library" << simuName << "loaded.";
 #endif
 
@@ -33,6 +33,7 @@
 #include <QDir>
 #include <QLibrary>
 #include <QMap>
+#include <QRect>
 
 #define SIMULATOR_INTERFACE_HEARTBEAT_PERIOD    1000  // ms
 
@@ -124,6 +125,7 @@ class SimulatorInterface : public QObject
     virtual bool isRunning() = 0;
     virtual void readRadioData(QByteArray & dest) = 0;
     virtual uint8_t * getLcd() = 0;
+    virtual QRect getLcdDirtyRect() = 0;  // changed since the previous call, empty if none
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0) = 0;
     virtual uint16_t getSensorRatio(uint16_t id) = 0;
     virtual const int getCapability(Capability cap) = 0;
@@ -148,6 +150,7 @@ class SimulatorInterface : public QObject
     virtual void lcdFlushed() = 0;
     virtual void setTrainerTimeout(uint16_t ms) = 0;
     virtual void sendTelemetry(const QByteArray data) = 0;
+    virtual void sendTelemetryStream(const QByteArray data) = 0;
     virtual void setLuaStateReloadPermanentScripts() = 0;
     virtual void addTracebackDevice(QIODevice * device) = 0;
     virtual void removeTracebackDevice(QIODevice * device) = 0;
@@ -167,6 +170,8 @@ class SimulatorInterface : public QObject
     void trimRangeChange(quint8 index, qint32 min, qint16 max);
     void gVarValueChange(quint8 index, qint32 value);
     void outputValueChange(int type, quint8 index, qint32 value);
+    // Run time of a part of the firmware in us (-1 when not measured), sent with the heartbeat
+    void performanceStat(const QString & name, qint32 p50, qint32 p99, qint32 max);
 };
 
 class SimulatorFactory {
@@ -186,13 +191,16 @@ class SimulatorLoader
     static QStringList getAvailableSimulators();
     static QString findSimulatorByName(const QString & name);
     static SimulatorInterface * loadSimulator(const QString & name);
-    static bool unloadSimulator(const QString & name);
+    static bool unloadSimulator(const QString & name, SimulatorInterface * instance = NULL);
 
   protected:
     typedef SimulatorFactory * (*RegisterSimulator)();
 
     static int registerSimulators(const QDir & dir);
+    static QLibrary * loadPrivateCopy(QLibrary * lib);
+    static void unloadPrivateCopy(QLibrary * lib);
     static QMap<QString, QLibrary *> registeredSimulators;
+    static QMap<SimulatorInterface *, QLibrary *> privateInstances;  // concurrent instances running from a copy of the library
 };
 
 #endif // _SIMULATORINTERFACE_H_
@@ -23,6 +23,7 @@
 
 #include "appdata.h"
 #include "debugoutput.h"
+#include "performancestats.h"
 #include "radiooutputswidget.h"
 #include "simulatorwidget.h"
 #include "simulatorinterface.h"
@@ -52,6 +53,7 @@ SimulatorMainWindow::SimulatorMainWindow(QWidget *parent, const QString & simula
   m_telemetryDockWidget(NULL),
   m_trainerDockWidget(NULL),
   m_outputsDockWidget(NULL),
+  m_perfDockWidget(NULL),
   m_simulatorId(simulatorId),
   m_exitStatusCode(0),
   m_radioProfileId(g.sessionId()),
@@ -159,6 +161,7 @@ SimulatorMainWindow::~SimulatorMainWindow()
   delete m_simulatorDockWidget;
   delete m_simulatorWidget;
   delete m_consoleDockWidget;
+  delete m_perfDockWidget;
   delete ui;
 
   if (m_simulator) {
@@ -169,8 +172,8 @@ SimulatorMainWindow::~SimulatorMainWindow()
       m_simuLogFile.close();
     }
     delete m_simulator;
+    SimulatorLoader::unloadSimulator(m_simulatorId, m_simulator);
   }
-  SimulatorLoader::unloadSimulator(m_simulatorId);
 }
 
 void SimulatorMainWindow::closeEvent(QCloseEvent *)
@@ -309,6 +312,15 @@ void SimulatorMainWindow::createDockWidgets()
     m_consoleDockWidget->setObjectName("CONSOLE");
     addTool(m_consoleDockWidget, Qt::RightDockWidgetArea, icon, QKeySequence(tr("F6")));
   }
+
+  if (!m_perfDockWidget) {
+    SimulatorIcon icon("info");
+    m_perfDockWidget = new QDockWidget(tr("Performance"), this);
+    auto * perf = new PerformanceStats(m_simulator, this);
+    m_perfDockWidget->setWidget(perf);
+    m_perfDockWidget->setObjectName("PERFORMANCE");
+    addTool(m_perfDockWidget, Qt::RightDockWidgetArea, icon, QKeySequence(tr("F10")));
+  }
 }
 
 void SimulatorMainWindow::addTool(QDockWidget * widget, Qt::DockWidgetArea area, QIcon icon, QKeySequence shortcut)
@@ -98,6 +98,7 @@ class SimulatorMainWindow : public QMainWindow
     QDockWidget * m_telemetryDockWidget;
     QDockWidget * m_trainerDockWidget;
     QDockWidget * m_outputsDockWidget;
+    QDockWidget * m_perfDockWidget;
 
     QThread simuThread;
     QFile m_simuLogFile;
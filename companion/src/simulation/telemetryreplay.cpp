@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "telemetryreplay.h"
+
+#include <QDebug>
+#include <QRegularExpression>
+
+#define REPLAY_TICK_MS        10
+// upper bound of what is sent at once, above it the replay falls behind
+// rather than overflowing the simulated module RX FIFO
+#define REPLAY_MAX_TICK_BYTES 8192
+
+TelemetryReplay::TelemetryReplay(QObject * parent):
+  QObject(parent),
+  totalBytes(0),
+  next(0),
+  replayTime(0),
+  rate(1),
+  bytesSent(0)
+{
+  timer.setInterval(REPLAY_TICK_MS);
+  timer.setTimerType(Qt::PreciseTimer);
+  connect(&timer, &QTimer::timeout, this, &TelemetryReplay::onTimer);
+}
+
+bool TelemetryReplay::load(const QString & fileName)
+{
+  clear();
+
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    qDebug() << "Unable to open" << fileName << file.errorString();
+    return false;
+  }
+
+  if (fileName.endsWith(".bin", Qt::CaseInsensitive))
+    loadCapture(file);
+  else
+    loadText(file);
+
+  qDebug() << "Telemetry capture" << fileName << ":" << totalBytes << "bytes in" << chunks.size() << "chunks,"
+           << (chunks.isEmpty() ? 0 : chunks.last().time) << "ms";
+  return isReady();
+}
+
+// Each line starts with the time the bytes were received, 10ms resolution:
+// 2023-04-01,10:20:30.120: C8 0C 14 ...
+bool TelemetryReplay::loadText(QFile & file)
+{
+  const QRegularExpression lineRe("^(\\d{4}-\\d{2}-\\d{2}),(\\d{2}:\\d{2}:\\d{2}\\.\\d{3}):(.*)$");
+  qint64 lastTime = 0;
+
+  while (!file.atEnd()) {
+    const QString line = QString::fromLatin1(file.readLine()).trimmed();
+    const QRegularExpressionMatch match = lineRe.match(line);
+    if (!match.hasMatch())
+      continue;
+
+    const QDateTime time = QDateTime::fromString(match.captured(1) + " " + match.captured(2), "yyyy-MM-dd HH:mm:ss.zzz");
+    const QByteArray data = QByteArray::fromHex(match.captured(3).toLatin1());
+    if (!time.isValid() || data.isEmpty())
+      continue;
+
+    if (!startTime.isValid())
+      startTime = time;
+    // captures appended to an existing file, or a clock jump: keep going from where we are
+    qint64 offset = startTime.msecsTo(time);
+    if (offset < lastTime)
+      offset = lastTime;
+    lastTime = offset;
+
+    chunks.append({offset, data});
+    totalBytes += data.size();
+  }
+
+  return isReady();
+}
+
+// Records as in radio/src/telemetry/telemetry.h:
+// uint32 time (ms), uint8 flags, uint8 length, data[length]
+// Only what was received from the first module seen is replayed, there is a
+// single telemetry stream in the simulator
+#define CAPTURE_HEADER_SIZE 6
+#define CAPTURE_TX          0x80
+#define CAPTURE_PADDING     0xFF
+bool TelemetryReplay::loadCapture(QFile & file)
+{
+  const QByteArray content = file.readAll();
+  const uchar * data = (const uchar *)content.constData();
+  int module = -1;
+  qint64 offset = 0;
+  quint32 lastTime = 0;
+  bool first = true;
+
+  for (int pos = 0; pos + CAPTURE_HEADER_SIZE <= content.size();) {
+    const quint32 time = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16) | ((quint32)data[pos + 3] << 24);
+    const quint8 flags = data[pos + 4];
+    const int len = data[pos + 5];
+    const int start = pos + CAPTURE_HEADER_SIZE;
+    pos = start + len;
+    if (pos > content.size())
+      break;
+    if (flags == CAPTURE_PADDING || (flags & CAPTURE_TX))
+      continue;
+    if (module < 0)
+      module = flags;
+    if (flags != module)
+      continue;
+
+    // the time restarts from 0 with each radio session appended to the file
+    if (!first && time >= lastTime)
+      offset += time - lastTime;
+    lastTime = time;
+    first = false;
+
+    if (!chunks.isEmpty() && chunks.last().time == offset)
+      chunks.last().data.append((const char *)data + start, len);
+    else
+      chunks.append({offset, QByteArray((const char *)data + start, len)});
+    totalBytes += len;
+  }
+
+  return isReady();
+}
+
+void TelemetryReplay::clear()
+{
+  stop();
+  chunks.clear();
+  startTime = QDateTime();
+  totalBytes = 0;
+  rewind();
+}
+
+void TelemetryReplay::play(double rate)
+{
+  if (!isReady())
+    return;
+  if (next >= chunks.size())
+    rewind();
+  setRate(rate);
+  clock.start();
+  timer.start();
+}
+
+void TelemetryReplay::setRate(double rate)
+{
+  this->rate = rate;
+}
+
+void TelemetryReplay::stop()
+{
+  timer.stop();
+}
+
+void TelemetryReplay::rewind()
+{
+  next = 0;
+  replayTime = 0;
+  bytesSent = 0;
+  emit positionChanged();
+}
+
+int TelemetryReplay::percentage() const
+{
+  return chunks.isEmpty() ? 0 : next * 100 / chunks.size();
+}
+
+QString TelemetryReplay::positionText() const
+{
+  const QString time = startTime.isValid() ? startTime.addMSecs(replayTime).toString("yyyy-MM-dd HH:mm:ss.zzz")
+                                            : QTime(0, 0).addMSecs(replayTime).toString("HH:mm:ss.zzz");
+  return tr("Byte %1 of %2\n%3").arg(bytesSent).arg(totalBytes).arg(time);
+}
+
+void TelemetryReplay::onTimer()
+{
+  replayTime += clock.restart() * rate;
+
+  QByteArray data;
+  while (next < chunks.size() && chunks[next].time <= replayTime && data.size() < REPLAY_MAX_TICK_BYTES) {
+    data.append(chunks[next++].data);
+  }
+
+  if (!data.isEmpty()) {
+    bytesSent += data.size();
+    emit streamData(data);
+    emit positionChanged();
+  }
+
+  if (next >= chunks.size()) {
+    stop();
+    emit finished();
+  }
+  else if (chunks[next].time < replayTime - REPLAY_TICK_MS) {
+    // could not keep up, carry on from here instead of bursting later
+    replayTime = chunks[next].time;
+  }
+}
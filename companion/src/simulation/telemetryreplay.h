@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _TELEMETRYREPLAY_H_
+#define _TELEMETRYREPLAY_H_
+
+#include <QObject>
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+
+// Replays a raw telemetry capture, as written by the radio with LOG_TELEMETRY
+// (logs/telemetry.bin, or the text logs/telemetry.log of older firmwares), at
+// the recorded pace or faster. The bytes are meant for
+// SimulatorInterface::sendTelemetryStream() so that they go through the same
+// protocol parsers (CRSF, S.Port, ...) as on the radio.
+class TelemetryReplay : public QObject
+{
+  Q_OBJECT
+
+  public:
+    explicit TelemetryReplay(QObject * parent = nullptr);
+
+    bool load(const QString & fileName);
+    void clear();
+    bool isReady() const { return !chunks.isEmpty(); }
+    bool isPlaying() const { return timer.isActive(); }
+    void play(double rate);
+    void setRate(double rate);
+    void stop();
+    void rewind();
+
+    int percentage() const;
+    QString positionText() const;
+
+  signals:
+    void streamData(const QByteArray data);
+    void positionChanged();
+    void finished();
+
+  protected slots:
+    void onTimer();
+
+  protected:
+    bool loadText(QFile & file);
+    bool loadCapture(QFile & file);
+
+    struct Chunk {
+      qint64 time;        // ms since the start of the capture
+      QByteArray data;
+    };
+
+    QVector<Chunk> chunks;
+    QDateTime startTime;  // invalid for binary captures, which only have the radio uptime
+    qint64 totalBytes;
+    int next;
+    double replayTime;    // ms since the start of the capture
+    double rate;
+    qint64 bytesSent;
+    QElapsedTimer clock;
+    QTimer timer;
+};
+
+#endif // _TELEMETRYREPLAY_H_
@@ -36,7 +36,8 @@ TelemetrySimulator::TelemetrySimulator(QWidget * parent, SimulatorInterface * si
   simulator(simulator),
   m_simuStarted(false),
   m_logReplayEnable(false),
-  logPlayback(new LogPlaybackController(ui))
+  logPlayback(new LogPlaybackController(ui)),
+  streamReplay(new TelemetryReplay(this))
 {
   ui->setupUi(this);
 
@@ -76,6 +77,8 @@ TelemetrySimulator::TelemetrySimulator(QWidget * parent, SimulatorInterface * si
   connect(ui->replayRate,        &QSlider::valueChanged,    this, &TelemetrySimulator::onReplayRateChanged);
 
   connect(this,                &TelemetrySimulator::telemetryDataChanged, simulator, &SimulatorInterface::sendTelemetry);
+  connect(streamReplay,        &TelemetryReplay::streamData,              simulator, &SimulatorInterface::sendTelemetryStream);
+  connect(streamReplay,        &TelemetryReplay::positionChanged,         this,      &TelemetrySimulator::onStreamReplayPositionChanged);
   connect(simulator,           &SimulatorInterface::started,              this,      &TelemetrySimulator::onSimulatorStarted);
   connect(simulator,           &SimulatorInterface::stopped,              this,      &TelemetrySimulator::onSimulatorStopped);
   connect(&g.currentProfile(), &Profile::telemSimEnabledChanged,          this,      &TelemetrySimulator::onSimulateToggled);
@@ -114,7 +117,7 @@ void TelemetrySimulator::startTelemetry()
 void TelemetrySimulator::stopTelemetry()
 {
   timer.stop();
-  m_logReplayEnable = logTimer.isActive();
+  m_logReplayEnable = logTimer.isActive() || streamReplay->isPlaying();
   onStop();
 
   if (!(g.currentProfile().telemSimResetRssiOnStop() && ui && ui->rssi_inst))
@@ -202,7 +205,30 @@ void TelemetrySimulator::onGpsRunLoop()
 void TelemetrySimulator::onLoadLogFile()
 {
   onStop(); // in case we are in playback mode
-  logPlayback->loadLogFile();
+
+  QString logFileNameAndPath = QFileDialog::getOpenFileName(NULL, tr("Log File"), g.logDir(), tr("LOG Files (*.csv);;Raw telemetry captures (*.bin *.log)"));
+  if (logFileNameAndPath.isEmpty())
+    return;
+
+  g.logDir(logFileNameAndPath);
+
+  const QString suffix = QFileInfo(logFileNameAndPath).suffix();
+  if (suffix.compare("log", Qt::CaseInsensitive) != 0 && suffix.compare("bin", Qt::CaseInsensitive) != 0) {
+    streamReplay->clear();
+    logPlayback->loadLogFile(logFileNameAndPath);
+    return;
+  }
+
+  logPlayback->clear();
+  bool ready = streamReplay->load(logFileNameAndPath);
+  ui->play->setEnabled(ready);
+  ui->rewind->setEnabled(ready);
+  ui->stepBack->setEnabled(false);
+  ui->stepForward->setEnabled(false);
+  ui->stop->setEnabled(ready);
+  ui->positionIndicator->setEnabled(false);
+  ui->replayRate->setEnabled(ready);
+  ui->logFileLabel->setText(ready ? QFileInfo(logFileNameAndPath).fileName() : tr("ERROR - invalid file"));
 }
 
 void TelemetrySimulator::onPlay()
@@ -212,6 +238,9 @@ void TelemetrySimulator::onPlay()
     logTimer.start(logPlayback->logFrequency * 1000 / SPEEDS[ui->replayRate->value()]);
     logPlayback->play();
   }
+  else if (streamReplay->isReady()) {
+    streamReplay->play(SPEEDS[ui->replayRate->value()]);
+  }
 }
 
 void TelemetrySimulator::onRewind()
@@ -220,6 +249,10 @@ void TelemetrySimulator::onRewind()
     logTimer.stop();
     logPlayback->rewind();
   }
+  else if (streamReplay->isReady()) {
+    streamReplay->stop();
+    streamReplay->rewind();
+  }
 }
 
 void TelemetrySimulator::onStepForward()
@@ -244,6 +277,9 @@ void TelemetrySimulator::onStop()
     logTimer.stop();
     logPlayback->stop();
   }
+  else if (streamReplay->isReady()) {
+    streamReplay->stop();
+  }
 }
 
 void TelemetrySimulator::onPositionIndicatorChanged(int value)
@@ -259,6 +295,17 @@ void TelemetrySimulator::onReplayRateChanged(int value)
   if (logTimer.isActive()) {
     logTimer.setInterval(logPlayback->logFrequency * 1000 / SPEEDS[ui->replayRate->value()]);
   }
+  streamReplay->setRate(SPEEDS[ui->replayRate->value()]);
+}
+
+void TelemetrySimulator::onStreamReplayPositionChanged()
+{
+  if (!streamReplay->isReady())
+    return;
+  ui->positionLabel->setText(streamReplay->positionText());
+  ui->positionIndicator->blockSignals(true);
+  ui->positionIndicator->setValue(streamReplay->percentage());
+  ui->positionIndicator->blockSignals(false);
 }
 
 #define SET_INSTANCE(control, id, def)  ui->control->setText(QString::number(simulator->getSensorInstance(id, ((def) & 0x1F))))
@@ -829,14 +876,13 @@ bool TelemetrySimulator::LogPlaybackController::isReady()
   return csvRecords.count() > 1;
 }
 
-void TelemetrySimulator::LogPlaybackController::loadLogFile()
+void TelemetrySimulator::LogPlaybackController::clear()
 {
-  QString logFileNameAndPath = QFileDialog::getOpenFileName(NULL, tr("Log File"), g.logDir(), tr("LOG Files (*.csv)"));
-  if (logFileNameAndPath.isEmpty())
-    return;
-
-  g.logDir(logFileNameAndPath);
+  csvRecords.clear();
+}
 
+void TelemetrySimulator::LogPlaybackController::loadLogFile(const QString & logFileNameAndPath)
+{
   // reset the playback ui
   ui->play->setEnabled(false);
   ui->rewind->setEnabled(false);
@@ -29,6 +29,7 @@
 #include <QFileDialog>
 
 #include "simulatorinterface.h"
+#include "telemetryreplay.h"
 
 static double const SPEEDS[] = { 0.2, 0.4, 0.6, 0.8, 1, 2, 3, 4, 5 };
 template<class t> t LIMIT(t mi, t x, t ma) { return std::min(std::max(mi, x), ma); }
@@ -72,6 +73,7 @@ class TelemetrySimulator : public QWidget
     void onStop();
     void onPositionIndicatorChanged(int value);
     void onReplayRateChanged(int value);
+    void onStreamReplayPositionChanged();
     void refreshSensorRatios();
     void generateTelemetryFrame();
 
@@ -92,7 +94,8 @@ class TelemetrySimulator : public QWidget
       public:
         LogPlaybackController(Ui::TelemetrySimulator * ui);
         bool isReady();
-        void loadLogFile();
+        void loadLogFile(const QString & logFileNameAndPath);
+        void clear();
         void play();
         void stop();
         void rewind();
@@ -167,6 +170,7 @@ class TelemetrySimulator : public QWidget
     };  // LogPlaybackController
 
     LogPlaybackController *logPlayback;
+    TelemetryReplay *streamReplay;   // raw captures, sent through the module protocol parsers
 
     class FlvssEmulator
     {
@@ -33,6 +33,11 @@ void LcdWidget::setData(int width, int height, int depth)
 
   localBuf = (unsigned char *)malloc(lcdSize);
   memset(localBuf, 0, lcdSize);
+
+  if (depth >= 12) {
+    lcdImage = QImage(width, height, QImage::Format_RGB32);
+    lcdImage.fill(Qt::black);
+  }
 }
 
 void LcdWidget::setBgDefaultColor(const QColor &color)
@@ -64,11 +69,17 @@ void LcdWidget::makeScreenshot(const QString &fileName)
   }
 }
 
-void LcdWidget::onLcdChanged(uint8_t* lcdBuf, bool light)
+void LcdWidget::onLcdChanged(uint8_t* lcdBuf, bool light, const QRect &dirty)
 {
   QMutexLocker locker(&lcdMtx);
   lightEnable = light;
-  if (lcdBuf) memcpy(localBuf, lcdBuf, lcdSize);
+  const QRect area = dirty & QRect(0, 0, lcdWidth, lcdHeight);
+  if (lcdBuf && !area.isEmpty()) {
+    if (lcdDepth >= 12)
+      convertArea((const uint16_t *)lcdBuf, area);
+    else
+      memcpy(localBuf, lcdBuf, lcdSize);
+  }
   if (!redrawTimer.isValid() ||
       redrawTimer.hasExpired(LCD_WIDGET_REFRESH_PERIOD)) {
     update();
@@ -76,6 +87,43 @@ void LcdWidget::onLcdChanged(uint8_t* lcdBuf, bool light)
   }
 }
 
+// Plain loops over each line, the component bits are replicated into the
+// low bits (same as 255 * c / max within 1) so that they vectorise well
+static void convertRgb565(QRgb *dst, const uint16_t *src, int count)
+{
+  for (int i = 0; i < count; i++) {
+    uint32_t z = src[i];
+    uint32_t r = (z >> 11) & 0x1F;
+    uint32_t g = (z >> 5) & 0x3F;
+    uint32_t b = z & 0x1F;
+    dst[i] = 0xFF000000 | (((r << 3) | (r >> 2)) << 16) |
+             (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+  }
+}
+
+static void convertRgb444(QRgb *dst, const uint16_t *src, int count)
+{
+  for (int i = 0; i < count; i++) {
+    uint32_t z = src[i];
+    uint32_t r = (z >> 8) & 0x0F;
+    uint32_t g = (z >> 4) & 0x0F;
+    uint32_t b = z & 0x0F;
+    dst[i] = 0xFF000000 | (r * 0x11 << 16) | (g * 0x11 << 8) | (b * 0x11);
+  }
+}
+
+void LcdWidget::convertArea(const uint16_t *lcdBuf, const QRect &area)
+{
+  for (int y = area.top(); y <= area.bottom(); y++) {
+    QRgb *dst = (QRgb *)lcdImage.scanLine(y) + area.left();
+    const uint16_t *src = lcdBuf + y * lcdWidth + area.left();
+    if (lcdDepth == 16)
+      convertRgb565(dst, src, area.width());
+    else
+      convertRgb444(dst, src, area.width());
+  }
+}
+
 void LcdWidget::doPaint(QPainter &p)
 {
   QRgb rgb;
@@ -83,28 +131,8 @@ void LcdWidget::doPaint(QPainter &p)
 
   if (!localBuf) return;
 
-  if (lcdDepth == 16) {
-    for (int x = 0; x < lcdWidth; x++) {
-      for (int y = 0; y < lcdHeight; y++) {
-        z = ((uint16_t *)localBuf)[y * lcdWidth + x];
-        rgb = qRgb(255 * ((z & 0xF800) >> 11) / 0x1F,
-                   255 * ((z & 0x07E0) >> 5) / 0x3F, 255 * (z & 0x001F) / 0x1F);
-        p.setPen(rgb);
-        p.drawPoint(x, y);
-      }
-    }
-    return;
-  }
-  if (lcdDepth == 12) {
-    for (int x = 0; x < lcdWidth; x++) {
-      for (int y = 0; y < lcdHeight; y++) {
-        z = ((uint16_t *)localBuf)[y * lcdWidth + x];
-        rgb = qRgb(255 * ((z & 0xF00) >> 8) / 0x0F,
-                   255 * ((z & 0x0F0) >> 4) / 0x0F, 255 * (z & 0x00F) / 0x0F);
-        p.setPen(rgb);
-        p.drawPoint(x, y);
-      }
-    }
+  if (lcdDepth >= 12) {
+    p.drawImage(0, 0, lcdImage);
     return;
   }
 
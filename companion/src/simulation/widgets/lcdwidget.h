@@ -26,6 +26,7 @@
 #include <QClipboard>
 #include <QDir>
 #include <QElapsedTimer>
+#include <QImage>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QMouseEvent>
@@ -63,7 +64,8 @@ class LcdWidget : public QWidget
 
   void makeScreenshot(const QString &fileName);
 
-  void onLcdChanged(uint8_t* lcdBuf, bool light);
+  // only the dirty area of lcdBuf is read, nothing if it is empty
+  void onLcdChanged(uint8_t* lcdBuf, bool light, const QRect &dirty);
 
  signals:
   void touchEvent(int type, int x, int y);
@@ -75,6 +77,7 @@ class LcdWidget : public QWidget
   int lcdSize;
 
   unsigned char *localBuf;
+  QImage lcdImage;  // colour LCDs, converted as the dirty areas come in
 
   bool lightEnable;
   QColor bgColor;
@@ -83,6 +86,7 @@ class LcdWidget : public QWidget
   QElapsedTimer redrawTimer;
 
   void doPaint(QPainter &p);
+  void convertArea(const uint16_t *lcdBuf, const QRect &area);
 
   void paintEvent(QPaintEvent *) override;
 
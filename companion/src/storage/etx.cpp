@@ -20,8 +20,7 @@
 
 #include "etx.h"
 #include <QFile>
-
-#define MZ_ALLOCATION_SIZE    (32*1024)
+#include <QSaveFile>
 
 bool EtxFormat::load(RadioData & radioData)
 {
@@ -48,44 +47,55 @@ bool EtxFormat::load(RadioData & radioData)
   return result;
 }
 
+// the archive is written straight to the file while it is built
+static size_t archiveWrite(void * opaque, mz_uint64 ofs, const void * buf, size_t n)
+{
+  QSaveFile * file = (QSaveFile *)opaque;
+  if ((mz_uint64)file->pos() != ofs && !file->seek(ofs)) {
+    return 0;
+  }
+  return (size_t)qMax<qint64>(0, file->write((const char *)buf, n));
+}
+
 bool EtxFormat::write(const RadioData & radioData)
 {
   qDebug() << "Saving to archive" << filename;
 
+  QSaveFile file(filename);
+  if (!file.open(QIODevice::WriteOnly)) {
+    setError(tr("Error creating EdgeTX file %1:\n%2.").arg(filename).arg(file.errorString()));
+    return false;
+  }
+
   memset(&zip_archive, 0, sizeof(zip_archive));
-  if (!mz_zip_writer_init_heap(&zip_archive, 0, MZ_ALLOCATION_SIZE)) {
+  zip_archive.m_pWrite = archiveWrite;
+  zip_archive.m_pIO_opaque = &file;
+  if (!mz_zip_writer_init(&zip_archive, 0)) {
     setError(tr("Error initializing EdgeTX archive writer"));
     return false;
   }
 
   bool result = LabelsStorageFormat::write(radioData);
   if (result) {
-    // finalize archive and get contents
-    char * archiveContents;
-    size_t archiveSize;
-    if (mz_zip_writer_finalize_heap_archive(&zip_archive, (void **)&archiveContents, &archiveSize)) {
-      qDebug() << "Archive size" << archiveSize;
-      // write contents to file
-      QFile file(filename);
-      if (file.open(QIODevice::WriteOnly)) {
-        qint64 len = file.write(archiveContents, archiveSize);
-        if (len != (qint64)archiveSize) {
-          setError(tr("Error writing file %1:\n%2.").arg(filename).arg(file.errorString()));
-          result = false;
-        }
-      }
-      else {
-        setError(tr("Error creating EdgeTX file %1:\n%2.").arg(filename).arg(file.errorString()));
-        result = false;
-      }
-    }
-    else {
+    if (!mz_zip_writer_finalize_archive(&zip_archive)) {
       setError(tr("Error creating EdgeTX archive"));
       result = false;
     }
   }
 
   mz_zip_writer_end(&zip_archive);
+
+  if (result) {
+    qDebug() << "Archive size" << file.size();
+    if (!file.commit()) {
+      setError(tr("Error writing file %1:\n%2.").arg(filename).arg(file.errorString()));
+      result = false;
+    }
+  }
+  else {
+    file.cancelWriting();
+  }
+
   return result;
 }
 
@@ -128,3 +138,16 @@ bool EtxFormat::getFileList(std::list<std::string>& filelist)
 
   return true;
 }
+
+bool EtxFormat::getFileChecksum(const QString & filename, quint32 & crc, quint64 & size)
+{
+  int index = mz_zip_reader_locate_file(&zip_archive, qPrintable(filename), nullptr, 0);
+  mz_zip_archive_file_stat file_stat;
+  if (index < 0 || !mz_zip_reader_file_stat(&zip_archive, index, &file_stat)) {
+    return false;
+  }
+
+  crc = file_stat.m_crc32;
+  size = file_stat.m_uncomp_size;
+  return true;
+}
@@ -43,6 +43,7 @@ class EtxFormat : public LabelsStorageFormat
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName);
     virtual bool getFileList(std::list<std::string>& filelist);
     virtual bool deleteFile(const QString & fileName) { return false; }
+    virtual bool getFileChecksum(const QString & fileName, quint32 & crc, quint64 & size);
 
     mz_zip_archive zip_archive;
 };
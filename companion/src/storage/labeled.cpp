@@ -23,7 +23,73 @@
 #include "firmwares/edgetx/edgetxinterface.h"
 #include "miniz.c"    //  Can only be included once!
 
+#include <QCache>
+#include <algorithm>
+#include <atomic>
 #include <regex>
+#include <thread>
+#include <vector>
+
+// Decoded models kept across loads, keyed by firmware and file checksum
+#define MODEL_CACHE_SIZE    256
+
+static QCache<QString, ModelData> modelCache(MODEL_CACHE_SIZE);
+
+struct ModelDecode {
+  int modelIdx;
+  std::string filename;
+  QString cacheKey;
+  QByteArray buffer;
+  ModelData model;
+  bool decoded;
+  bool ok;
+  QString error;
+};
+
+struct EncodedModel {
+  ModelData model;    // as it was when encoded
+  QByteArray data;
+};
+
+// Encoded models kept across saves, keyed by firmware and file name
+static QCache<QString, EncodedModel> encodedCache(MODEL_CACHE_SIZE);
+
+// Model YAML files are independent, so they are decoded and encoded on all cores
+template <class T>
+static void runOnAllCores(size_t count, T work)
+{
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    size_t i;
+    while ((i = next++) < count) {
+      work(i);
+    }
+  };
+
+  size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadCount; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+}
+
+static void decodeModels(std::vector<ModelDecode *> & jobs)
+{
+  runOnAllCores(jobs.size(), [&](size_t i) {
+    ModelDecode & job = *jobs[i];
+    try {
+      job.ok = loadModelFromYaml(job.model, job.buffer);
+    } catch(const std::exception& e) {
+      job.ok = false;
+      job.error = QString(e.what());
+    }
+    job.buffer.clear();
+  });
+}
 
 bool LabelsStorageFormat::load(RadioData & radioData)
 {
@@ -257,13 +323,19 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
   if (hasLabels)
     radioData.models.resize(modelFiles.size());
 
+  // extract the models which are not cached yet
+  std::vector<ModelDecode> models;
+  std::vector<bool> slotUsed(radioData.models.size());
+  const QString firmwareId = getCurrentFirmware()->getId();
+  models.reserve(modelFiles.size());
+
   for (const auto& mc : modelFiles) {
     qDebug() << "Filename: " << mc.filename.c_str();
 
     if (!hasLabels) {
       if (mc.modelIdx >= 0 && mc.modelIdx < (int)radioData.models.size()) {
         modelIdx = mc.modelIdx;
-        if (!radioData.models[modelIdx].isEmpty()) {
+        if (!radioData.models[modelIdx].isEmpty() || slotUsed[modelIdx]) {
           qDebug() << QString("Warning: file %1 skipped as slot %2 already used").arg(mc.filename.c_str()).arg(mc.modelIdx + 1);
           continue;
         }
@@ -273,39 +345,79 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
         continue;
       }
     }
+    slotUsed[modelIdx] = true;
+
+    models.emplace_back();
+    ModelDecode & job = models.back();
+    job.modelIdx = modelIdx;
+    job.filename = mc.filename;
+    job.decoded = false;
+    job.ok = false;
 
-    QByteArray modelBuffer;
     QString filename = "MODELS/" + QString::fromStdString(mc.filename);
-    if (!loadFile(modelBuffer, filename)) {
-      setError(tr("Cannot extract ") + filename);
-      return false;
+    quint32 crc;
+    quint64 size;
+    if (getFileChecksum(filename, crc, size)) {
+      job.cacheKey = QString("%1:%2:%3").arg(firmwareId).arg(crc, 8, 16, QChar('0')).arg(size);
+    }
+
+    if (job.cacheKey.isEmpty() || !modelCache.contains(job.cacheKey)) {
+      if (!loadFile(job.buffer, filename)) {
+        setError(tr("Cannot extract ") + filename);
+        return false;
+      }
+      if (job.cacheKey.isEmpty()) {
+        crc = mz_crc32(MZ_CRC32_INIT, (const unsigned char *)job.buffer.constData(), job.buffer.size());
+        job.cacheKey = QString("%1:%2:%3").arg(firmwareId).arg(crc, 8, 16, QChar('0')).arg(job.buffer.size());
+      }
     }
 
     // Please note:
     //  ModelData() use memset to clear everything to 0
     //
-    auto& model = radioData.models[modelIdx];
+    if (const ModelData * cached = modelCache.object(job.cacheKey)) {
+      job.model = *cached;
+      job.decoded = job.ok = true;
+      job.buffer.clear();
+    }
 
-    try {
-      if (!loadModelFromYaml(model,modelBuffer)) {
+    modelIdx++;
+  }
+
+  std::vector<ModelDecode *> pending;
+  for (auto& job : models) {
+    if (!job.decoded)
+      pending.push_back(&job);
+  }
+  qDebug() << "Decoding" << pending.size() << "models," << models.size() - pending.size() << "from cache";
+  decodeModels(pending);
+
+  for (auto& job : models) {
+    QString filename = "MODELS/" + QString::fromStdString(job.filename);
+    if (!job.ok) {
+      if (job.error.isEmpty())
         setError(tr("Cannot load ") + filename);
-        return false;
-      }
-    } catch(const std::runtime_error& e) {
-      setError(tr("Cannot load ") + filename + ":\n" + QString(e.what()));
+      else
+        setError(tr("Cannot load ") + filename + ":\n" + job.error);
       return false;
     }
 
-    model.modelIndex = modelIdx;
-    strncpy(model.filename, mc.filename.c_str(), sizeof(model.filename)-1);
+    if (!job.decoded) {
+      modelCache.insert(job.cacheKey, new ModelData(job.model));
+    }
+
+    auto& model = radioData.models[job.modelIdx];
+    model = job.model;
+
+    model.modelIndex = job.modelIdx;
+    strncpy(model.filename, job.filename.c_str(), sizeof(model.filename)-1);
 
     if (hasLabels && !strncmp(radioData.generalSettings.currModelFilename,
                                   model.filename, sizeof(model.filename))) {
-      radioData.generalSettings.currModelIndex = modelIdx;
+      radioData.generalSettings.currModelIndex = job.modelIdx;
     }
 
     model.used = true;
-    modelIdx++;
   }
 
   // Add the labels in the models
@@ -357,6 +469,8 @@ bool LabelsStorageFormat::writeYaml(const RadioData & radioData)
   }
 
   EtxModelfiles modelFiles;
+  std::vector<const ModelData *> models;
+  std::vector<QString> modelFilenames;
   for (const auto& model : radioData.models) {
 
     if (model.isEmpty())
@@ -374,9 +488,36 @@ bool LabelsStorageFormat::writeYaml(const RadioData & radioData)
                           .arg(model.modelIndex, 2, 10, QLatin1Char('0'));
     }
 
-    QByteArray modelData;
-    writeModelToYaml(model, modelData);
-    if (!writeFile(modelData, modelFilename)) {
+    models.push_back(&model);
+    modelFilenames.push_back(modelFilename);
+  }
+
+  // models unchanged since they were last encoded keep their previous YAML
+  const QString firmwareId = getCurrentFirmware()->getId();
+  std::vector<QByteArray> modelData(models.size());
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < models.size(); i++) {
+    const EncodedModel * encoded = encodedCache.object(firmwareId + ":" + modelFilenames[i]);
+    if (encoded && !memcmp(&encoded->model, models[i], sizeof(ModelData)))
+      modelData[i] = encoded->data;
+    else
+      pending.push_back(i);
+  }
+
+  qDebug() << "Encoding" << pending.size() << "models," << models.size() - pending.size() << "unchanged";
+  runOnAllCores(pending.size(), [&](size_t i) {
+    writeModelToYaml(*models[pending[i]], modelData[pending[i]]);
+  });
+
+  for (size_t i : pending) {
+    EncodedModel * encoded = new EncodedModel;
+    encoded->model = *models[i];
+    encoded->data = modelData[i];
+    encodedCache.insert(firmwareId + ":" + modelFilenames[i], encoded);
+  }
+
+  for (size_t i = 0; i < models.size(); i++) {
+    if (!writeFile(modelData[i], modelFilenames[i])) {
       return false;
     }
   }
@@ -45,6 +45,8 @@ class LabelsStorageFormat : public StorageFormat
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName) = 0;
     virtual bool getFileList(std::list<std::string>& filelist) = 0;
     virtual bool deleteFile(const QString & fileName) = 0;
+    // checksum of a file without extracting it, when the container stores one
+    virtual bool getFileChecksum(const QString & fileName, quint32 & crc, quint64 & size) { return false; }
 
     virtual bool loadBin(RadioData & radioData);
     virtual bool writeBin(const RadioData & radioData);
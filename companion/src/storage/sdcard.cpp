@@ -21,6 +21,21 @@
 #include "sdcard.h"
 #include <QFile>
 #include <QDir>
+#include <QHash>
+
+// Checksums of the files last read from a radio SD card, so that reading the
+// same radio again does not need to read back the files which did not change
+struct SdcardFileSnapshot {
+  qint64 size;
+  QDateTime modified;
+  quint32 crc;
+};
+
+static QHash<QString, SdcardFileSnapshot> fileSnapshots;
+
+// FAT timestamps have a 2s resolution: a file modified again within the same
+// 2s would keep its date, such files are read again next time
+#define SNAPSHOT_MIN_AGE_MS   2000
 
 bool SdcardFormat::write(const RadioData & radioData)
 {
@@ -40,6 +55,31 @@ bool SdcardFormat::loadFile(QByteArray & filedata, const QString & filename)
   }
   filedata = file.readAll();
   qDebug() << "File" << path << "read, size:" << filedata.size();
+
+  QFileInfo info(file);
+  if (info.lastModified().msecsTo(QDateTime::currentDateTime()) >= SNAPSHOT_MIN_AGE_MS) {
+    quint32 crc = mz_crc32(MZ_CRC32_INIT, (const unsigned char *)filedata.constData(), filedata.size());
+    fileSnapshots.insert(path, { info.size(), info.lastModified(), crc });
+  }
+  else {
+    fileSnapshots.remove(path);
+  }
+  return true;
+}
+
+bool SdcardFormat::getFileChecksum(const QString & filename, quint32 & crc, quint64 & size)
+{
+  QString path = this->filename + "/" + filename;
+  auto it = fileSnapshots.constFind(path);
+  if (it == fileSnapshots.constEnd())
+    return false;
+
+  QFileInfo info(path);
+  if (!info.exists() || info.size() != it->size || info.lastModified() != it->modified)
+    return false;
+
+  crc = it->crc;
+  size = it->size;
   return true;
 }
 
@@ -53,6 +93,7 @@ bool SdcardFormat::writeFile(const QByteArray & data, const QString & filename)
   }
   file.write(data.data(), data.size());
   file.close();
+  fileSnapshots.remove(path);
   qDebug() << "File" << path << "written, size:" << data.size();
   return true;
 }
@@ -78,6 +119,7 @@ bool SdcardFormat::deleteFile(const QString & filename)
     return false;
   }
 
+  fileSnapshots.remove(path);
   qDebug() << "File" << path << "deleted";
   return true;
 }
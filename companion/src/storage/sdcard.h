@@ -43,6 +43,7 @@ class SdcardFormat : public LabelsStorageFormat
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName);
     virtual bool getFileList(std::list<std::string>& filelist);
     virtual bool deleteFile(const QString & fileName);
+    virtual bool getFileChecksum(const QString & fileName, quint32 & crc, quint64 & size);
 };
 
 class SdcardStorageFactory : public DefaultStorageFactory<SdcardFormat>
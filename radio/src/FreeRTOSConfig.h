@@ -26,7 +26,7 @@
 extern uint32_t SystemCoreClock;
 
 #define configUSE_PREEMPTION            1
-#define configUSE_IDLE_HOOK             0
+#define configUSE_IDLE_HOOK             1 // power_governor.cpp
 #if defined(COLORLCD)
   #define configUSE_TICK_HOOK           1
 #else
@@ -50,6 +50,15 @@ extern uint32_t SystemCoreClock;
 #define configGENERATE_RUN_TIME_STATS   0
 #define configUSE_TIMERS                1
 
+// Per task run time accounting (see task_stats.h)
+#if !defined(__ASSEMBLER__)
+#ifdef __cplusplus
+extern "C"
+#endif
+void taskStatsSwitchedIn(const void * tcb);
+#endif
+#define traceTASK_SWITCHED_IN()         taskStatsSwitchedIn((const void *)pxCurrentTCB)
+
 #if !defined(DEBUG)
   #define configMAX_TASK_NAME_LEN         4
   #define configUSE_TRACE_FACILITY        0
@@ -294,9 +294,11 @@ void referenceSystemAudioFiles()
       // Eliminates directories / non wav files
       if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
 
+      // the base names are compared, without building each path
+      uint8_t baseLen = len - (sizeof(SOUNDS_EXT) - 1);
       for (int i=0; i<AU_SPECIAL_SOUND_FIRST; i++) {
-        getSystemAudioFile(path, i);
-        if (!strcasecmp(filename, fno.fname)) {
+        const char * name = audioFilenames[i];
+        if (strlen(name) == baseLen && !strncasecmp(name, fno.fname, baseLen)) {
           sdAvailableSystemAudioFiles.setBit(i);
           break;
         }
@@ -323,18 +325,24 @@ char *getModelAudioPath(char *path)
   return buf;
 }
 
-void getFlightmodeAudioFile(char * filename, int index, unsigned int event)
+// The model audio file names are built apart from their directory, so
+// that the directory listing can be matched without building the full
+// path (and probing the model directory) for each candidate
+
+static void strAppendFlightmodeAudioFile(char * str, int index, unsigned int event)
 {
-  char * str = getModelAudioPath(filename);
   char * tmp = strcatFlightmodeName(str, index);
   strcpy(tmp, suffixes[event]);
   strcat(tmp, SOUNDS_EXT);
 }
 
-void getSwitchAudioFile(char * filename, swsrc_t index)
+void getFlightmodeAudioFile(char * filename, int index, unsigned int event)
 {
-  char * str = getModelAudioPath(filename);
+  strAppendFlightmodeAudioFile(getModelAudioPath(filename), index, event);
+}
 
+static void strAppendSwitchAudioFile(char * str, swsrc_t index)
+{
   if (index <= MAX_SWITCHES * 3) {
     div_t swinfo = switchInfo(index);
     *str++ = 'S';
@@ -353,10 +361,13 @@ void getSwitchAudioFile(char * filename, swsrc_t index)
   strcat(str, SOUNDS_EXT);
 }
 
-void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event)
+void getSwitchAudioFile(char * filename, swsrc_t index)
 {
-  char * str = getModelAudioPath(filename);
+  strAppendSwitchAudioFile(getModelAudioPath(filename), index);
+}
 
+static void strAppendLogicalSwitchAudioFile(char * str, int index, unsigned int event)
+{
   *str++ = 'L';
   if (index >= 9) {
     div_t qr = div(index+1, 10);
@@ -371,9 +382,15 @@ void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event)
   strcat(str, SOUNDS_EXT);
 }
 
+void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event)
+{
+  strAppendLogicalSwitchAudioFile(getModelAudioPath(filename), index, event);
+}
+
 void referenceModelAudioFiles()
 {
   char path[AUDIO_FILENAME_MAXLEN+1];
+  char filename[AUDIO_FILENAME_MAXLEN+1];
   FILINFO fno;
   DIR dir;
 
@@ -381,8 +398,8 @@ void referenceModelAudioFiles()
   sdAvailableSwitchAudioFiles.reset();
   sdAvailableLogicalSwitchAudioFiles.reset();
 
-  char * filename = getModelAudioPath(path);
-  *(filename-1) = '\0';
+  char * dirEnd = getModelAudioPath(path);
+  *(dirEnd-1) = '\0';
 
   FRESULT res = f_opendir(&dir, path);        /* Open the directory */
   if (res == FR_OK) {
@@ -391,6 +408,8 @@ void referenceModelAudioFiles()
       if (res != FR_OK || fno.fname[0] == 0) break;  /* Break on error or end of dir */
       uint8_t len = strlen(fno.fname);
       bool found = false;
+      // switch and logical switch file names have a fixed first letter
+      char first = fno.fname[0] & ~0x20;
 
       // Eliminates directories / non wav files
       if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
@@ -399,7 +418,7 @@ void referenceModelAudioFiles()
       // Flight modes Audio Files <flightmodename>-[on|off].wav
       for (int i=0; i<MAX_FLIGHT_MODES && !found; i++) {
         for (int event=0; event<2; event++) {
-          getFlightmodeAudioFile(path, i, event);
+          strAppendFlightmodeAudioFile(filename, i, event);
           // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
           if (!strcasecmp(filename, fno.fname)) {
             sdAvailableFlightmodeAudioFiles.setBit(INDEX_PHASE_AUDIO_FILE(i, event));
@@ -411,8 +430,8 @@ void referenceModelAudioFiles()
       }
 
       // Switches Audio Files <switchname>-[up|mid|down].wav
-      for (unsigned i = 0; i <= MAX_SWITCH_POSITIONS && !found; i++) {
-        getSwitchAudioFile(path, i);
+      for (unsigned i = 0; i <= MAX_SWITCH_POSITIONS && !found && first == 'S'; i++) {
+        strAppendSwitchAudioFile(filename, i);
         // TRACE("referenceModelAudioFiles(): searching for %s in %s (%d)", path, fno.fname, i);
         if (!strcasecmp(filename, fno.fname)) {
           sdAvailableSwitchAudioFiles.setBit(i);
@@ -422,9 +441,9 @@ void referenceModelAudioFiles()
       }
 
       // Logical Switches Audio Files <switchname>-[on|off].wav
-      for (int i=0; i<MAX_LOGICAL_SWITCHES && !found; i++) {
+      for (int i=0; i<MAX_LOGICAL_SWITCHES && !found && first == 'L'; i++) {
         for (int event=0; event<2; event++) {
-          getLogicalSwitchAudioFile(path, i, event);
+          strAppendLogicalSwitchAudioFile(filename, i, event);
           // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
           if (!strcasecmp(filename, fno.fname)) {
             sdAvailableLogicalSwitchAudioFiles.setBit(INDEX_LOGICAL_SWITCH_AUDIO_FILE(i, event));
@@ -516,6 +535,7 @@ AudioQueue::AudioQueue()
 }
 
 #define CODEC_ID_PCM_S16LE  1
+#define CODEC_ID_IMA_ADPCM  0x11
 
 #if !defined(SIMU)
 void audioTask(void * pdata)
@@ -546,82 +566,405 @@ inline void mixSample(audio_data_t * result, int sample, unsigned int fade)
   *result = limit(AUDIO_DATA_MIN, *result + ((sample >> fade) >> (16-AUDIO_BITS_PER_SAMPLE)), AUDIO_DATA_MAX);
 }
 
+// Signed 16 bits output: two samples may be mixed at once with saturation
+#if defined(__ARM_FEATURE_DSP) && !defined(SIMU) && (defined(PCBX12S) || defined(PCBNV14))
+  #define AUDIO_MIX_DSP
+#endif
+
+// One context worth of samples at AUDIO_SAMPLE_RATE, fade already applied
+static int16_t mixScratch[AUDIO_BUFFER_SIZE];
+
+static void mixSamples(audio_data_t * result, const int16_t * samples, uint32_t count)
+{
+  uint32_t i = 0;
+#if defined(AUDIO_MIX_DSP)
+  for (; i + 1 < count; i += 2) {
+    // audio buffers are only 16 bits aligned
+    uint32_t mixed, pair;
+    memcpy(&mixed, &result[i], sizeof(mixed));
+    memcpy(&pair, &samples[i], sizeof(pair));
+    mixed = __QADD16(mixed, pair);
+    memcpy(&result[i], &mixed, sizeof(mixed));
+  }
+#endif
+  for (; i < count; i++) {
+    mixSample(&result[i], samples[i], 0);
+  }
+}
+
 #if defined(SDCARD)
 
 #define RIFF_CHUNK_SIZE 12
 uint8_t wavBuffer[AUDIO_BUFFER_SIZE*2] __DMA;
 
-int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+// Opens a WAV file and moves to the start of its samples
+static FRESULT openWavFile(FIL * file, const char * filename, WavInfo * info)
 {
-  FRESULT result = FR_OK;
   UINT read = 0;
+  FRESULT result = f_open(file, filename, FA_OPEN_EXISTING | FA_READ);
+  if (result != FR_OK) {
+    return result;
+  }
 
-  if (fragment.file[1]) {
-    result = f_open(&state.file, fragment.file, FA_OPEN_EXISTING | FA_READ);
-    fragment.file[1] = 0;
-    if (result == FR_OK) {
-      result = f_read(&state.file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
-      if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
-        uint32_t size = *((uint32_t *)(wavBuffer+16));
-        result = (size < 256 ? f_read(&state.file, wavBuffer, size+8, &read) : FR_DENIED);
-        if (result == FR_OK && read == size+8) {
-          state.codec = ((uint16_t *)wavBuffer)[0];
-          state.freq = ((uint16_t *)wavBuffer)[2];
-          uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
-          uint32_t size = wavSamplesPtr[1];
-          if (state.freq != 0 && state.freq * (AUDIO_SAMPLE_RATE / state.freq) == AUDIO_SAMPLE_RATE) {
-            state.resampleRatio = (AUDIO_SAMPLE_RATE / state.freq);
-            state.readSize = (state.codec == CODEC_ID_PCM_S16LE ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE) / state.resampleRatio;
-          }
-          else {
-            result = FR_DENIED;
-          }
-          while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
-            result = f_lseek(&state.file, f_tell(&state.file)+size);
-            if (result == FR_OK) {
-              result = f_read(&state.file, wavBuffer, 8, &read);
-              if (read != 8) result = FR_DENIED;
-              wavSamplesPtr = (uint32_t *)wavBuffer;
-              size = wavSamplesPtr[1];
-            }
-          }
-          state.size = size;
-        }
-        else {
-          result = FR_DENIED;
-        }
+  result = f_read(file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
+  if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
+    uint32_t size = *((uint32_t *)(wavBuffer+16));
+    result = (size < 256 ? f_read(file, wavBuffer, size+8, &read) : FR_DENIED);
+    if (result == FR_OK && read == size+8) {
+      info->codec = ((uint16_t *)wavBuffer)[0];
+      uint32_t freq = ((uint16_t *)wavBuffer)[2];
+      info->blockAlign = ((uint16_t *)wavBuffer)[6];
+      uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
+      uint32_t size = wavSamplesPtr[1];
+      if (freq != 0 && freq <= AUDIO_SAMPLE_RATE) {
+        // rounded up, so that one read never gives more than AUDIO_BUFFER_SIZE output samples
+        info->step = ((freq << 16) + AUDIO_SAMPLE_RATE - 1) / AUDIO_SAMPLE_RATE;
+        uint32_t samples = AUDIO_BUFFER_SIZE * freq / AUDIO_SAMPLE_RATE;
+        if (info->codec == CODEC_ID_PCM_S16LE)
+          info->readSize = 2 * samples;
+        else if (info->codec == CODEC_ID_IMA_ADPCM)
+          info->readSize = samples / 2;  // up to 2 samples per byte
+        else
+          info->readSize = samples;
       }
       else {
         result = FR_DENIED;
       }
+      if (info->codec == CODEC_ID_IMA_ADPCM) {
+        // mono, 4 bits, at least one byte of samples after the block header
+        uint16_t channels = ((uint16_t *)wavBuffer)[1];
+        uint16_t bits = ((uint16_t *)wavBuffer)[7];
+        if (channels != 1 || bits != 4 || info->blockAlign <= 4) {
+          result = FR_DENIED;
+        }
+      }
+      while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
+        result = f_lseek(file, f_tell(file)+size);
+        if (result == FR_OK) {
+          result = f_read(file, wavBuffer, 8, &read);
+          if (read != 8) result = FR_DENIED;
+          wavSamplesPtr = (uint32_t *)wavBuffer;
+          size = wavSamplesPtr[1];
+        }
+      }
+      info->size = size;
+    }
+    else {
+      result = FR_DENIED;
+    }
+  }
+  else {
+    result = FR_DENIED;
+  }
+
+  if (result != FR_OK) {
+    f_close(file);
+  }
+
+  return result;
+}
+
+#if defined(AUDIO_PROMPT_CACHE)
+static uint8_t audioCacheData[AUDIO_CACHE_ENTRIES][AUDIO_CACHE_ENTRY_SIZE] __SDRAM;
+static AudioPromptCache audioPromptCache __DMA;
+
+AudioPromptCache::AudioPromptCache():
+  useCounter(0),
+  flushRequested(false),
+  ridx(0),
+  widx(0),
+  loading(-1)
+{
+  memclear(entries, sizeof(entries));
+}
+
+void AudioPromptCache::prefetch(const char * filename)
+{
+  uint8_t next = (widx + 1) & (AUDIO_QUEUE_LENGTH - 1);
+  if (next != ridx) {
+    // when full, the file is simply played from the SD card
+    strcpy(queue[widx], filename);
+    widx = next;
+  }
+}
+
+void AudioPromptCache::clear()
+{
+  flushRequested = false;
+  if (loading >= 0) {
+    f_close(&file);
+    loading = -1;
+  }
+  for (auto & entry : entries) {
+    entry.file[0] = '\0';
+    entry.stamp++;
+  }
+  ridx = widx;
+}
+
+const AudioCacheEntry * AudioPromptCache::find(const char * filename, int8_t * index)
+{
+  if (flushRequested) {
+    clear();
+  }
+
+  for (int8_t i = 0; i < AUDIO_CACHE_ENTRIES; i++) {
+    AudioCacheEntry & entry = entries[i];
+    if (entry.file[0] && entry.loaded == entry.info.size && !strcmp(entry.file, filename)) {
+      entry.lastUse = ++useCounter;
+      *index = i;
+      return &entry;
+    }
+  }
+
+  return nullptr;
+}
+
+const AudioCacheEntry * AudioPromptCache::get(int8_t index, uint32_t stamp)
+{
+  AudioCacheEntry & entry = entries[index];
+  if (entry.stamp != stamp) {
+    // reused for another file while playing
+    return nullptr;
+  }
+  entry.lastUse = ++useCounter;
+  return &entry;
+}
+
+const uint8_t * AudioPromptCache::getData(int8_t index) const
+{
+  return audioCacheData[index];
+}
+
+int8_t AudioPromptCache::allocEntry(const char * filename)
+{
+  // least recently used, the entries being played are refreshed on each buffer
+  int8_t result = 0;
+  for (int8_t i = 1; i < AUDIO_CACHE_ENTRIES; i++) {
+    if (entries[i].lastUse < entries[result].lastUse) {
+      result = i;
+    }
+  }
+
+  AudioCacheEntry & entry = entries[result];
+  strcpy(entry.file, filename);
+  entry.loaded = 0;
+  entry.lastUse = ++useCounter;
+  entry.stamp++;
+  return result;
+}
+
+void AudioPromptCache::wakeup()
+{
+  if (flushRequested) {
+    clear();
+  }
+
+  if (loading < 0) {
+    // open the next announced file which is not in the cache yet
+    while (loading < 0 && ridx != widx) {
+      const char * filename = queue[ridx];
+      int8_t index;
+      WavInfo info;
+      if (!find(filename, &index) && openWavFile(&file, filename, &info) == FR_OK) {
+        if (info.codec == CODEC_ID_PCM_S16LE && info.size <= AUDIO_CACHE_ENTRY_SIZE) {
+          loading = allocEntry(filename);
+          entries[loading].info = info;
+        }
+        else {
+          f_close(&file);
+        }
+      }
+      ridx = (ridx + 1) & (AUDIO_QUEUE_LENGTH - 1);
     }
+    return;
   }
 
+  AudioCacheEntry & entry = entries[loading];
+  UINT read = 0;
+  uint32_t count = min<uint32_t>(AUDIO_CACHE_LOAD_SIZE, entry.info.size - entry.loaded);
+  FRESULT result = f_read(&file, audioCacheData[loading] + entry.loaded, count, &read);
+  if (result != FR_OK || read != count) {
+    // truncated file, keep playing it from the SD card
+    entry.file[0] = '\0';
+    entry.lastUse = 0;
+  }
+  else {
+    entry.loaded += read;
+    if (entry.loaded < entry.info.size) {
+      return;
+    }
+  }
+
+  f_close(&file);
+  loading = -1;
+}
+#endif
+
+static const int16_t imaStepTable[89] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+  11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+};
+
+static const int8_t imaIndexTable[16] = {
+  -1, -1, -1, -1, 2, 4, 6, 8,
+  -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static int16_t decodeImaNibble(AdpcmState & state, uint8_t nibble)
+{
+  int step = imaStepTable[state.index];
+  int diff = step >> 3;
+  if (nibble & 1)
+    diff += step >> 2;
+  if (nibble & 2)
+    diff += step >> 1;
+  if (nibble & 4)
+    diff += step;
+  if (nibble & 8)
+    diff = -diff;
+  state.predictor = limit<int>(INT16_MIN, state.predictor + diff, INT16_MAX);
+  state.index = limit<int>(0, state.index + imaIndexTable[nibble], DIM(imaStepTable) - 1);
+  return state.predictor;
+}
+
+// Decodes a stream of IMA ADPCM bytes, which may start or end anywhere in a block
+static uint32_t decodeImaAdpcm(const uint8_t * data, uint32_t count, uint16_t blockAlign, AdpcmState & state, int16_t * samples)
+{
+  uint32_t result = 0;
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint8_t value = data[i];
+    switch (state.pos) {
+      case 0:
+        // block header: first sample, step index, reserved byte
+        state.predictor = value;
+        break;
+      case 1:
+        state.predictor = int16_t(uint16_t(state.predictor & 0xFF) | (value << 8));
+        samples[result++] = state.predictor;
+        break;
+      case 2:
+        state.index = min<uint8_t>(value, DIM(imaStepTable) - 1);
+        break;
+      case 3:
+        break;
+      default:
+        samples[result++] = decodeImaNibble(state, value & 0x0F);
+        samples[result++] = decodeImaNibble(state, value >> 4);
+        break;
+    }
+    if (++state.pos == blockAlign) {
+      state.pos = 0;
+    }
+  }
+
+  return result;
+}
+
+static int16_t adpcmBuffer[AUDIO_BUFFER_SIZE];
+
+// Linear interpolation of the file samples at the output positions
+static uint32_t resampleWav(const int16_t * samples, uint32_t count, uint32_t step, uint32_t & phase, int16_t & lastSample, unsigned int fade)
+{
+  uint32_t end = count << 16;
+  uint32_t pos = phase;
+  uint32_t result = 0;
+
+  while (pos < end && result < AUDIO_BUFFER_SIZE) {
+    uint32_t idx = pos >> 16;
+    int32_t prev = (idx > 0 ? samples[idx-1] : lastSample);
+    int32_t next = samples[idx];
+    int32_t sample = prev + (((next - prev) * int32_t((pos & 0xFFFF) >> 1)) >> 15);
+    mixScratch[result++] = sample >> fade;
+    pos += step;
+  }
+
+  if (count > 0) {
+    lastSample = samples[count-1];
+    phase = (pos >= end ? pos - end : 0);
+  }
+
+  return result;
+}
+
+int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+{
+  FRESULT result = FR_OK;
+  UINT read = 0;
+  const uint8_t * data = wavBuffer;
+  bool fromFile = true;
+
+  if (fragment.file[1]) {
+#if defined(AUDIO_PROMPT_CACHE)
+    const AudioCacheEntry * entry = audioPromptCache.find(fragment.file, &state.cacheIndex);
+    if (entry) {
+      state.info = entry->info;
+      state.cacheStamp = entry->stamp;
+      state.cachePos = 0;
+    }
+    else {
+      state.cacheIndex = -1;
+      result = openWavFile(&state.file, fragment.file, &state.info);
+    }
+#else
+    result = openWavFile(&state.file, fragment.file, &state.info);
+#endif
+    fragment.file[1] = 0;
+    state.phase = 0;
+    state.lastSample = 0;
+    state.adpcm.pos = 0;
+  }
+
+#if defined(AUDIO_PROMPT_CACHE)
+  if (result == FR_OK && state.cacheIndex >= 0) {
+    fromFile = false;
+    if (audioPromptCache.get(state.cacheIndex, state.cacheStamp)) {
+      data = audioPromptCache.getData(state.cacheIndex) + state.cachePos;
+      read = min<uint32_t>(state.info.readSize, state.info.size);
+      state.cachePos += read;
+    }
+    else {
+      result = FR_DENIED;
+    }
+  }
+#endif
+
   if (result == FR_OK) {
-    read = 0;
-    result = f_read(&state.file, wavBuffer, state.readSize, &read);
+    if (fromFile) {
+      read = 0;
+      result = f_read(&state.file, wavBuffer, state.info.readSize, &read);
+    }
     if (result == FR_OK) {
-      if (read > state.size) {
-        read = state.size;
+      if (read > state.info.size) {
+        read = state.info.size;
       }
-      state.size -= read;
+      state.info.size -= read;
 
-      if (read != state.readSize) {
-        f_close(&state.file);
+      if (read != state.info.readSize) {
+        if (fromFile) {
+          f_close(&state.file);
+        }
         fragment.clear();
       }
 
-      audio_data_t * samples = buffer->data;
-      if (state.codec == CODEC_ID_PCM_S16LE) {
-        read /= 2;
-        for (uint32_t i=0; i<read; i++) {
-          for (uint8_t j=0; j<state.resampleRatio; j++) {
-            mixSample(samples++, ((int16_t *)wavBuffer)[i], fade+2-volume);
-          }
-        }
+      uint32_t count = 0;
+      if (state.info.codec == CODEC_ID_PCM_S16LE) {
+        count = resampleWav((const int16_t *)data, read / 2, state.info.step, state.phase, state.lastSample, fade+2-volume);
+        mixSamples(buffer->data, mixScratch, count);
+      }
+      else if (state.info.codec == CODEC_ID_IMA_ADPCM) {
+        uint32_t decoded = decodeImaAdpcm(data, read, state.info.blockAlign, state.adpcm, adpcmBuffer);
+        count = resampleWav(adpcmBuffer, decoded, state.info.step, state.phase, state.lastSample, fade+2-volume);
+        mixSamples(buffer->data, mixScratch, count);
       }
 
-      return samples - buffer->data;
+      return count;
     }
   }
 
@@ -699,16 +1042,17 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
         end -= (end % DIM(sineValues));
       else
         end = DIM(sineValues);
-      points = (float(end) - toneIdx) / state.step;
+      points = min<int>(AUDIO_BUFFER_SIZE, (float(end) - toneIdx) / state.step);
     }
 
     for (int i=0; i<points; i++) {
       int16_t sample = sineValues[int(toneIdx)] * state.volume;
-      mixSample(&buffer->data[i], sample, fade);
+      mixScratch[i] = sample >> fade;
       toneIdx += state.step;
       if ((unsigned int)toneIdx >= DIM(sineValues))
         toneIdx -= DIM(sineValues);
     }
+    mixSamples(buffer->data, mixScratch, points);
 
     if (remainingDuration > AUDIO_BUFFER_DURATION) {
       state.duration += AUDIO_BUFFER_DURATION;
@@ -732,6 +1076,76 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
   return result;
 }
 
+#define VARIO_FADE_STEP  (1.0f / 64) // 2ms fade in/out
+
+int VarioContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
+{
+  if (!state.active) {
+    if (!params.updated) {
+      return 0;
+    }
+    params.updated = false;
+    state.active = true;
+    state.stopping = false;
+    state.pos = 0;
+    state.idx = 0;
+    state.gain = 0;
+  }
+
+  if (params.freq != state.freq) {
+    state.freq = params.freq;
+    state.step = limit<float>(1, float(params.freq) * (float(DIM(sineValues))/float(AUDIO_SAMPLE_RATE)), 512);
+    state.volume = 1.0f / evalVolumeRatio(params.freq, volume);
+  }
+
+  uint32_t toneEnd = params.duration * (AUDIO_SAMPLE_RATE / 1000);
+  uint32_t cycleEnd = toneEnd + params.pause * (AUDIO_SAMPLE_RATE / 1000);
+  float toneIdx = state.idx;
+
+  for (int i=0; i<AUDIO_BUFFER_SIZE; i++) {
+    if (state.pos >= cycleEnd && !state.stopping) {
+      if (params.updated) {
+        // next beep cycle, without pause the tone goes on
+        params.updated = false;
+        state.pos = 0;
+      }
+      else {
+        state.stopping = true;
+      }
+    }
+
+    if (state.pos < toneEnd && !state.stopping) {
+      if (state.gain < 1.0f)
+        state.gain = min<float>(1.0f, state.gain + VARIO_FADE_STEP);
+    }
+    else if (state.gain > 0) {
+      state.gain = max<float>(0, state.gain - VARIO_FADE_STEP);
+    }
+
+    if (state.gain > 0) {
+      int16_t sample = sineValues[int(toneIdx)] * state.volume * state.gain;
+      mixScratch[i] = sample >> fade;
+      toneIdx += state.step;
+      if ((unsigned int)toneIdx >= DIM(sineValues))
+        toneIdx -= DIM(sineValues);
+    }
+    else {
+      // the next beep starts on a zero crossing
+      mixScratch[i] = 0;
+      toneIdx = 0;
+    }
+    state.pos++;
+  }
+  mixSamples(buffer->data, mixScratch, AUDIO_BUFFER_SIZE);
+  state.idx = toneIdx;
+
+  if (state.stopping && state.gain == 0) {
+    state.active = false;
+  }
+
+  return AUDIO_BUFFER_SIZE;
+}
+
 void AudioQueue::wakeup()
 {
   DEBUG_TIMER_START(debugTimerAudioConsume);
@@ -811,6 +1225,11 @@ void AudioQueue::wakeup()
     audioConsumeCurrentBuffer();
     DEBUG_TIMER_STOP(debugTimerAudioConsume);
   }
+
+#if defined(AUDIO_PROMPT_CACHE)
+  // the buffers are full, time to warm the cache
+  audioPromptCache.wakeup();
+#endif
 }
 
 inline unsigned int getToneLength(uint16_t len)
@@ -848,7 +1267,7 @@ void AudioQueue::playTone(uint16_t freq, uint16_t len, uint16_t pause, uint8_t f
   freq = limit<uint16_t>(BEEP_MIN_FREQ, freq, BEEP_MAX_FREQ);
 
   if (flags & PLAY_BACKGROUND) {
-    varioContext.setFragment(freq, len, pause, 0, 0, (flags & PLAY_NOW));
+    varioContext.set(freq, len, pause);
   }
   else {
     // adjust frequency and length according to the user preferences
@@ -869,7 +1288,35 @@ void AudioQueue::playTone(uint16_t freq, uint16_t len, uint16_t pause, uint8_t f
   RTOS_UNLOCK_MUTEX(audioMutex);
 }
 
+void AudioQueue::playVario(uint16_t freq, uint16_t len, uint16_t pause)
+{
+#if defined(SIMU) && !defined(SIMU_AUDIO)
+  return;
+#endif
+
+  RTOS_LOCK_MUTEX(audioMutex);
+  varioContext.set(limit<uint16_t>(BEEP_MIN_FREQ, freq, BEEP_MAX_FREQ), len, pause);
+  RTOS_UNLOCK_MUTEX(audioMutex);
+}
+
 #if defined(SDCARD)
+static uint8_t getAudioPriority(uint8_t id)
+{
+  if (id == ID_PLAY_TIMER) {
+    return AUDIO_PRIORITY_TIMER;
+  }
+  if (id >= ID_PLAY_PROMPT_BASE && id < ID_PLAY_PROMPT_BASE + AU_SPECIAL_SOUND_FIRST) {
+    unsigned int index = id - ID_PLAY_PROMPT_BASE;
+    if (index <= AU_ERROR)
+      return AUDIO_PRIORITY_ALARM;
+    else if (index >= AU_TIMER1_ELAPSED)
+      return AUDIO_PRIORITY_TIMER;
+    else
+      return AUDIO_PRIORITY_CLICK;
+  }
+  return AUDIO_PRIORITY_VALUE;
+}
+
 void AudioQueue::playFile(const char * filename, uint8_t flags, uint8_t id)
 {
 #if defined(SIMU)
@@ -901,7 +1348,12 @@ void AudioQueue::playFile(const char * filename, uint8_t flags, uint8_t id)
     backgroundContext.setFragment(filename, 0, id);
   }
   else {
-    fragmentsFifo.push(AudioFragment(filename, flags & 0x0f, id));
+#if defined(AUDIO_PROMPT_CACHE)
+    if (flags & PLAY_CACHED) {
+      audioPromptCache.prefetch(filename);
+    }
+#endif
+    fragmentsFifo.push(AudioFragment(filename, flags & 0x0f, id, getAudioPriority(id)));
   }
 
   RTOS_UNLOCK_MUTEX(audioMutex);
@@ -928,6 +1380,9 @@ void AudioQueue::stopPlay(uint8_t id)
 void AudioQueue::stopSD()
 {
   sdAvailableSystemAudioFiles.reset();
+#if defined(AUDIO_PROMPT_CACHE)
+  audioPromptCache.flush();
+#endif
   stopAll();
   playTone(0, 0, 100, PLAY_NOW);        // insert a 100ms pause
 }
@@ -957,7 +1412,8 @@ void audioPlay(unsigned int index, uint8_t id)
   if (g_eeGeneral.beepMode >= -1) {
     char filename[AUDIO_FILENAME_MAXLEN+1];
     if (isAudioFileReferenced(index, filename)) {
-      audioQueue.playFile(filename, 0, id);
+      bool system = (index >> 24) == SYSTEM_AUDIO_CATEGORY;
+      audioQueue.playFile(filename, system ? PLAY_CACHED : 0, id);
     }
   }
 }
@@ -1230,7 +1686,7 @@ void pushUnit(uint8_t unit, uint8_t idx, uint8_t id)
     char * tmp = strAppendSystemAudioPath(path);
     tmp = strAppendStringWithIndex(tmp, unitsFilenames[unit], idx);
     strcpy(tmp, SOUNDS_EXT);
-    audioQueue.playFile(path, 0, id);
+    audioQueue.playFile(path, PLAY_CACHED, id);
   }
   else {
     TRACE("pushUnit: out of bounds unit : %d", unit); // We should never get here, but given the nature of TTS files, this prevent segfault in case of bug there.
@@ -1248,7 +1704,7 @@ void pushPrompt(uint16_t prompt, uint8_t id)
     str[i] = '0' + (prompt%10);
     prompt /= 10;
   }
-  audioQueue.playFile(filename, 0, id);
+  audioQueue.playFile(filename, PLAY_CACHED, id);
 #endif
 }
 
@@ -73,7 +73,11 @@ constexpr uint8_t AUDIO_MODEL_FILENAME_MAXLEN = (sizeof("/SOUNDS/fr/") - 1) + LE
 constexpr uint8_t AUDIO_LUA_FILENAME_MAXLEN = 42; // Some scripts use long audio paths, even on 128x64 boards
 constexpr uint8_t AUDIO_FILENAME_MAXLEN = (AUDIO_LUA_FILENAME_MAXLEN > AUDIO_MODEL_FILENAME_MAXLEN ? AUDIO_LUA_FILENAME_MAXLEN : AUDIO_MODEL_FILENAME_MAXLEN);
 
-#define AUDIO_QUEUE_LENGTH             (16) // must be a power of 2!
+#if defined(COLORLCD)
+  #define AUDIO_QUEUE_LENGTH           (32) // must be a power of 2!
+#else
+  #define AUDIO_QUEUE_LENGTH           (16) // must be a power of 2!
+#endif
 
 #define AUDIO_SAMPLE_RATE              (32000)
 #define AUDIO_BUFFER_DURATION          (10)
@@ -136,6 +140,14 @@ enum FragmentTypes {
   FRAGMENT_FILE,
 };
 
+// Queued fragments are played by decreasing priority
+enum AudioPriority {
+  AUDIO_PRIORITY_CLICK,       // UI feedback
+  AUDIO_PRIORITY_VALUE,       // value call-outs, dropped first when the queue is full
+  AUDIO_PRIORITY_TIMER,       // timers and queued tones
+  AUDIO_PRIORITY_ALARM,       // critical alarms
+};
+
 struct Tone {
   uint16_t freq;
   uint16_t duration;
@@ -156,6 +168,7 @@ struct AudioFragment {
   uint8_t type;
   uint8_t id;
   uint8_t repeat;
+  uint8_t priority;
   union {
     Tone tone;
     char file[AUDIO_FILENAME_MAXLEN+1];
@@ -167,13 +180,15 @@ struct AudioFragment {
     type(FRAGMENT_TONE),
     id(id),
     repeat(repeat),
+    priority(AUDIO_PRIORITY_TIMER),
     tone(freq, duration, pause, freqIncr, reset)
   {};
 
-  AudioFragment(const char * filename, uint8_t repeat, uint8_t id=0):
+  AudioFragment(const char * filename, uint8_t repeat, uint8_t id=0, uint8_t priority=AUDIO_PRIORITY_VALUE):
     type(FRAGMENT_FILE),
     id(id),
-    repeat(repeat)
+    repeat(repeat),
+    priority(priority)
   {
     strcpy(file, filename);
   }
@@ -218,6 +233,115 @@ class ToneContext {
 
 };
 
+// Vario voice: the beep frequency and cadence are updated in place, at
+// audio buffer granularity. The sine keeps its phase across updates and
+// each beep is faded in and out, so that changes do not click.
+class VarioContext {
+  public:
+
+    inline void clear()
+    {
+      memset(reinterpret_cast<void*>(this), 0, sizeof(VarioContext));
+    }
+
+    // called with audioMutex held; the voice stops at the end of the
+    // current beep cycle unless it gets updated again
+    void set(uint16_t freq, uint16_t duration, uint16_t pause)
+    {
+      params.freq = freq;
+      params.duration = duration;
+      params.pause = pause;
+      params.updated = true;
+    }
+
+    int mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade);
+
+  private:
+    struct {
+      uint16_t freq;
+      uint16_t duration;
+      uint16_t pause;
+      volatile bool updated;
+    } params;
+
+    struct {
+      float step;
+      float idx;
+      float volume;
+      float gain;                        // beep fade in/out
+      uint16_t freq;
+      uint32_t pos;                      // samples since the beep cycle start
+      bool active;
+      bool stopping;
+    } state;
+};
+
+#if defined(SDCARD) && defined(SDRAM)
+  #define AUDIO_PROMPT_CACHE
+#endif
+
+struct WavInfo {
+  uint8_t  codec;
+  uint16_t readSize;                     // bytes read for one output buffer
+  uint32_t step;                         // file samples per output sample, 16.16 fixed point
+  uint32_t size;                         // samples data size in bytes
+  uint16_t blockAlign;                   // IMA ADPCM block size in bytes
+};
+
+struct AdpcmState {
+  int16_t  predictor;
+  uint8_t  index;
+  uint16_t pos;                          // byte position in the current block
+};
+
+#if defined(AUDIO_PROMPT_CACHE)
+#define AUDIO_CACHE_ENTRIES            (16)
+#define AUDIO_CACHE_ENTRY_SIZE         (32 * 1024) // 1s of 16kHz PCM
+#define AUDIO_CACHE_LOAD_SIZE          (2 * 1024)  // read per audio task loop
+
+struct AudioCacheEntry {
+  char     file[AUDIO_FILENAME_MAXLEN+1];
+  WavInfo  info;
+  uint32_t loaded;                       // bytes of samples loaded so far
+  uint32_t lastUse;
+  uint32_t stamp;                        // changes when the entry is reused
+};
+
+// Keeps the PCM samples of the short system prompts (numbers, units, ...)
+// in SDRAM, so that chained announcements do not need to open and parse
+// each file. Entries are loaded in the audio task, a few KB per loop, from
+// the files announced with prefetch() before they get played.
+class AudioPromptCache {
+  public:
+    AudioPromptCache();
+
+    // called with audioMutex held
+    void prefetch(const char * filename);
+    void flush() { flushRequested = true; }
+
+    // audio task only
+    const AudioCacheEntry * find(const char * filename, int8_t * index);
+    const AudioCacheEntry * get(int8_t index, uint32_t stamp);
+    const uint8_t * getData(int8_t index) const;
+    void wakeup();
+
+  private:
+    AudioCacheEntry entries[AUDIO_CACHE_ENTRIES];
+    uint32_t useCounter;
+    volatile bool flushRequested;
+
+    char queue[AUDIO_QUEUE_LENGTH][AUDIO_FILENAME_MAXLEN+1];
+    volatile uint8_t ridx;
+    volatile uint8_t widx;
+
+    FIL file;
+    int8_t loading;                      // entry being loaded from file
+
+    void clear();
+    int8_t allocEntry(const char * filename);
+};
+#endif
+
 class WavContext {
   public:
 
@@ -243,11 +367,15 @@ class WavContext {
 
     struct {
       FIL      file;
-      uint8_t  codec;
-      uint32_t freq;
-      uint32_t size;
-      uint8_t  resampleRatio;
-      uint16_t readSize;
+      WavInfo  info;
+      uint32_t phase;                    // position of the next output sample, 16.16 fixed point
+      int16_t  lastSample;               // last sample of the previous read, for interpolation
+      AdpcmState adpcm;
+#if defined(AUDIO_PROMPT_CACHE)
+      int8_t   cacheIndex;               // playing from the cache if >= 0
+      uint32_t cacheStamp;
+      uint32_t cachePos;
+#endif
     } state;
 };
 
@@ -306,6 +434,11 @@ class AudioBufferFifo {
     volatile uint8_t readIdx;
     volatile uint8_t writeIdx;
     volatile bool bufferFull;
+#if defined(SIMU_AUDIO)
+    // the simulator only fills ahead the buffers needed to avoid
+    // underruns on the host, new sounds would else be queued behind
+    volatile uint8_t fillLimit = AUDIO_BUFFER_COUNT;
+#endif
 
     // readIdx == writeIdx       -> buffer empty
     // readIdx == writeIdx + 1   -> buffer full
@@ -327,7 +460,7 @@ class AudioBufferFifo {
 
     uint8_t used() const
     {
-      return bufferFull ? AUDIO_BUFFER_COUNT : writeIdx - readIdx;
+      return bufferFull ? AUDIO_BUFFER_COUNT : (writeIdx + AUDIO_BUFFER_COUNT - readIdx) % AUDIO_BUFFER_COUNT;
     }
 
   public:
@@ -342,11 +475,20 @@ class AudioBufferFifo {
 #if defined(AUDIO_DUAL_BUFFER)
       AudioBuffer * buffer = &audioBuffers[writeIdx];
       return buffer->state == AUDIO_BUFFER_FREE ? buffer : NULL;
+#elif defined(SIMU_AUDIO)
+      return used() >= fillLimit ? NULL : &audioBuffers[writeIdx];
 #else
       return full() ? NULL : &audioBuffers[writeIdx];
 #endif
     }
 
+#if defined(SIMU_AUDIO)
+    void setFillLimit(uint8_t count)
+    {
+      fillLimit = count;
+    }
+#endif
+
     // puts filled buffer into FIFO
     void audioPushBuffer()
     {
@@ -424,6 +566,7 @@ class AudioFragmentFifo
   private:
     volatile uint8_t ridx;
     volatile uint8_t widx;
+    uint8_t lastId;
     AudioFragment fragments[AUDIO_QUEUE_LENGTH];
 
     uint8_t nextIdx(uint8_t idx) const
@@ -431,8 +574,39 @@ class AudioFragmentFifo
       return (idx + 1) & (AUDIO_QUEUE_LENGTH - 1);
     }
 
+    uint8_t prevIdx(uint8_t idx) const
+    {
+      return (idx - 1) & (AUDIO_QUEUE_LENGTH - 1);
+    }
+
+    // removes the fragments cleared by removePromptById()
+    void compact()
+    {
+      uint8_t dst = ridx;
+      for (uint8_t src = ridx; src != widx; src = nextIdx(src)) {
+        if (fragments[src].type != FRAGMENT_EMPTY) {
+          if (dst != src) fragments[dst] = fragments[src];
+          dst = nextIdx(dst);
+        }
+      }
+      widx = dst;
+    }
+
+    // drops the last queued announcement if it is less important
+    bool dropLowest(uint8_t priority)
+    {
+      uint8_t last = prevIdx(widx);
+      if (fragments[last].priority >= priority) return false;
+      uint8_t id = fragments[last].id;
+      do {
+        widx = last;
+        last = prevIdx(widx);
+      } while (id && widx != ridx && fragments[last].id == id);
+      return true;
+    }
+
   public:
-    AudioFragmentFifo() : ridx(0), widx(0), fragments() {};
+    AudioFragmentFifo() : ridx(0), widx(0), lastId(0), fragments() {};
 
     bool hasPromptId(uint8_t id)
     {
@@ -486,11 +660,27 @@ class AudioFragmentFifo
 
     void push(const AudioFragment & fragment)
     {
-      if (!full()) {
-        // TRACE("fragment %d at %d", fragment.type, widx);
-        fragments[widx] = fragment;
-        widx = nextIdx(widx);
+      // consecutive fragments with the same id belong to the same announcement,
+      // a new announcement replaces the one still waiting with this id
+      if (fragment.id && fragment.id != lastId) {
+        removePromptById(fragment.id);
+      }
+      lastId = fragment.id;
+      compact();
+
+      if (full() && !dropLowest(fragment.priority)) {
+        return;
+      }
+
+      // after the waiting fragments of the same or a higher priority
+      uint8_t pos = widx;
+      while (pos != ridx && fragments[prevIdx(pos)].priority < fragment.priority) {
+        fragments[pos] = fragments[prevIdx(pos)];
+        pos = prevIdx(pos);
       }
+      // TRACE("fragment %d at %d", fragment.type, pos);
+      fragments[pos] = fragment;
+      widx = nextIdx(widx);
     }
 
 };
@@ -507,6 +697,7 @@ class AudioQueue {
     AudioQueue();
     void start() { _started = true; };
     void playTone(uint16_t freq, uint16_t len, uint16_t pause=0, uint8_t flags=0, int8_t freqIncr=0);
+    void playVario(uint16_t freq, uint16_t len, uint16_t pause);
     void playFile(const char *filename, uint8_t flags=0, uint8_t id=0);
     void stopPlay(uint8_t id);
     void stopAll();
@@ -528,7 +719,7 @@ class AudioQueue {
     MixedContext normalContext;
     WavContext   backgroundContext;
     ToneContext  priorityContext;
-    ToneContext  varioContext;
+    VarioContext varioContext;
     AudioFragmentFifo fragmentsFifo;
 };
 
@@ -539,6 +730,7 @@ enum {
   // IDs for special functions [0:64]
   // IDs for global functions [64:128]
   ID_PLAY_PROMPT_BASE = 128,
+  ID_PLAY_TIMER = 254,
   ID_PLAY_FROM_SD_MANAGER = 255,
 };
 
@@ -557,7 +749,7 @@ void audioTask(void * pdata);
 #endif
 
   #define AUDIO_ERROR_MESSAGE(e) audioEvent(e)
-  #define AUDIO_TIMER_MINUTE(t)  playDuration(t, 0, 0)
+  #define AUDIO_TIMER_MINUTE(t)  playDuration(t, 0, ID_PLAY_TIMER)
 
 void onKeyError();
 
@@ -585,7 +777,7 @@ void audioTimerCountdown(uint8_t timer, int value);
 #define AUDIO_TRIM_MAX()         AUDIO_BUZZER(audioEvent(AU_TRIM_MAX), beep(2))
 #define AUDIO_TRIM_PRESS(val)    audioTrimPress(val)
 #define AUDIO_PLAY(p)            audioEvent(p)
-#define AUDIO_VARIO(fq, t, p, f) audioQueue.playTone(fq, t, p, f)
+#define AUDIO_VARIO(fq, t, p)    audioQueue.playVario(fq, t, p)
 #define AUDIO_RSSI_ORANGE()      audioEvent(AU_RSSI_ORANGE)
 #define AUDIO_RSSI_RED()         audioEvent(AU_RSSI_RED)
 #define AUDIO_RAS_RED()          audioEvent(AU_RAS_RED)
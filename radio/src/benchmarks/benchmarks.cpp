@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <QCoreApplication>
+
+#include "benchmarks.h"
+#include "hal/adc_driver.h"
+
+uint16_t simu_get_analog(uint8_t idx)
+{
+  return 0;
+}
+
+void benchmarkLoadHeavyModel()
+{
+  generalDefault();
+  memset(&g_model, 0, sizeof(g_model));
+  setModelDefaults();
+
+  // 5 points curves
+  for (uint8_t i = 0; i < MAX_CURVES; i++) {
+    memclear(&g_model.curves[i], sizeof(CurveHeader));
+  }
+  loadCurves();
+  for (uint8_t i = 0; i < MAX_CURVES; i++) {
+    int8_t * points = curveAddress(i);
+    for (uint8_t p = 0; p < 5; p++) {
+      points[p] = -100 + 50 * p - (i % 10);
+    }
+  }
+
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * expo = expoAddress(i);
+    expo->srcRaw = MIXSRC_FIRST_STICK + i % MAX_STICKS;
+    expo->chn = i % MAX_INPUTS;
+    expo->mode = 3;
+    expo->weight = 100;
+    expo->curve.type = CURVE_REF_EXPO;
+    expo->curve.value = 30;
+  }
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * mix = mixAddress(i);
+    mix->destCh = i % MAX_OUTPUT_CHANNELS;
+    mix->srcRaw = MIXSRC_FIRST_INPUT + i % MAX_INPUTS;
+    mix->weight = 100 - i;
+    mix->mltpx = MLTPX_ADD;
+    mix->curve.type = CURVE_REF_CUSTOM;
+    mix->curve.value = 1 + i % MAX_CURVES;
+  }
+
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    if (i & 1) {
+      ls->func = LS_FUNC_AND;
+      ls->v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 1;
+      ls->v2 = SWSRC_FIRST_LOGICAL_SWITCH;
+    } else {
+      ls->func = LS_FUNC_VPOS;
+      ls->v1 = MIXSRC_FIRST_CH + i % MAX_OUTPUT_CHANNELS;
+      ls->v2 = i;
+    }
+  }
+
+  extern uint8_t s_mixer_first_run_done;
+  s_mixer_first_run_done = false;
+  evalMixes(1);
+}
+
+extern const etx_hal_adc_driver_t simu_adc_driver;
+
+int main(int argc, char ** argv)
+{
+  QCoreApplication app(argc, argv);
+  simuInit();
+  adcInit(&simu_adc_driver);
+
+#if defined(LIBOPENUI)
+  lcdInitDisplayDriver();
+#endif
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+#if defined(COLORLCD)
+
+static const char quickBrownFox[] =
+    "The quick brown fox jumps over the lazy dog";
+
+static void BM_BitmapBuffer_fill(benchmark::State & state)
+{
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  for (auto _ : state) {
+    dc.drawSolidFilledRect(0, 0, LCD_W, LCD_H, COLOR_THEME_SECONDARY3);
+  }
+  state.SetItemsProcessed(state.iterations() * LCD_W * LCD_H);
+}
+BENCHMARK(BM_BitmapBuffer_fill);
+
+static void BM_BitmapBuffer_blit(benchmark::State & state)
+{
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  BitmapBuffer sprite(BMP_RGB565, 64, 64);
+  sprite.clear(COLOR_THEME_PRIMARY2);
+  for (auto _ : state) {
+    dc.drawBitmap(10, 10, &sprite);
+  }
+  state.SetItemsProcessed(state.iterations() * 64 * 64);
+}
+BENCHMARK(BM_BitmapBuffer_blit);
+
+static void BM_BitmapBuffer_text(benchmark::State & state)
+{
+  BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
+  for (auto _ : state) {
+    dc.drawText(0, LCD_H / 2, quickBrownFox, COLOR_THEME_SECONDARY1);
+  }
+}
+BENCHMARK(BM_BitmapBuffer_text);
+
+#else
+
+static void BM_lcdDrawFilledRect(benchmark::State & state)
+{
+  for (auto _ : state) {
+    lcdDrawFilledRect(0, 0, LCD_W, LCD_H, SOLID, 0);
+  }
+}
+BENCHMARK(BM_lcdDrawFilledRect);
+
+static void BM_lcdDrawText(benchmark::State & state)
+{
+  for (auto _ : state) {
+    lcdDrawText(0, 0, "The quick brown fox", 0);
+  }
+}
+BENCHMARK(BM_lcdDrawText);
+
+#endif
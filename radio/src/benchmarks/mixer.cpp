@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+static void BM_evalMixes(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+  for (auto _ : state) {
+    evalMixes(1);
+  }
+}
+BENCHMARK(BM_evalMixes);
+
+bool getLogicalSwitch(uint8_t idx);
+
+static void BM_getLogicalSwitch(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+  for (auto _ : state) {
+    for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+      benchmark::DoNotOptimize(getLogicalSwitch(i));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * MAX_LOGICAL_SWITCHES);
+}
+BENCHMARK(BM_getLogicalSwitch);
+
+static void BM_applyCurve(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+  CurveRef curve = {CURVE_REF_CUSTOM, 1};
+  for (auto _ : state) {
+    for (int x = -RESX; x <= RESX; x += 16) {
+      benchmark::DoNotOptimize(applyCurve(x, curve));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (2 * RESX / 16 + 1));
+}
+BENCHMARK(BM_applyCurve);
+
+static void BM_expo(benchmark::State & state)
+{
+  for (auto _ : state) {
+    for (int x = -RESX; x <= RESX; x += 16) {
+      benchmark::DoNotOptimize(expo(x, 40));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (2 * RESX / 16 + 1));
+}
+BENCHMARK(BM_expo);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+#if defined(CROSSFIRE)
+  #include "telemetry/crossfire.h"
+#endif
+
+#if defined(MULTIMODULE)
+  #include "telemetry/multi.h"
+#endif
+
+static void BM_TelemetryItem_setValue(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+  TelemetrySensor & sensor = g_model.telemetrySensors[0];
+  sensor.type = TELEM_TYPE_CUSTOM;
+  sensor.unit = UNIT_VOLTS;
+  sensor.prec = 2;
+  sensor.filter = 1;
+
+  TelemetryItem & item = telemetryItems[0];
+  item.clear();
+
+  int32_t value = 0;
+  for (auto _ : state) {
+    item.setValue(sensor, 1000 + (value++ & 0xFF), UNIT_VOLTS, 2);
+  }
+}
+BENCHMARK(BM_TelemetryItem_setValue);
+
+#if defined(CROSSFIRE)
+uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
+
+static void BM_Crossfire_channelsFrame(benchmark::State & state)
+{
+  int16_t channels[MAX_TRAINER_CHANNELS];
+  uint8_t frame[CROSSFIRE_FRAME_MAXLEN];
+
+  for (int i = 0; i < MAX_TRAINER_CHANNELS; i++) {
+    channels[i] = -1024 + (2048 / MAX_TRAINER_CHANNELS) * i;
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(createCrossfireChannelsFrame(frame, channels));
+  }
+}
+BENCHMARK(BM_Crossfire_channelsFrame);
+
+static void BM_Crossfire_telemetryFrame(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+
+  // battery: 12.6V, 2.5A, 1200mAh, 80%
+  const uint8_t battery[] = {RADIO_ADDRESS, 10, BATTERY_ID, 0x00, 0x7E,
+                             0x00, 0x19, 0x00, 0x04, 0xB0, 80, 0x00};
+
+  uint8_t * rxBuffer = getTelemetryRxBuffer(EXTERNAL_MODULE);
+  uint8_t & rxBufferCount = getTelemetryRxBufferCount(EXTERNAL_MODULE);
+
+  for (auto _ : state) {
+    memcpy(rxBuffer, battery, sizeof(battery));
+    rxBufferCount = sizeof(battery);
+    processCrossfireTelemetryFrame(EXTERNAL_MODULE);
+  }
+}
+BENCHMARK(BM_Crossfire_telemetryFrame);
+#endif
+
+#if defined(MULTIMODULE)
+static void BM_Multi_telemetryStream(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+
+  // status packet: 'M' 'P' type len data...
+  const uint8_t status[] = {'M', 'P', 0x01, 24,
+                            0x0F, 1, 3, 3, 20, 0, 1, 0,
+                            'F', 'r', 'S', 'k', 'y', 'X', ' ',
+                            0x0F, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  for (auto _ : state) {
+    for (uint8_t data : status) {
+      processMultiTelemetryData(data, EXTERNAL_MODULE);
+    }
+    processMultiTelemetryQueues(EXTERNAL_MODULE);
+  }
+  state.SetBytesProcessed(state.iterations() * sizeof(status));
+}
+BENCHMARK(BM_Multi_telemetryStream);
+#endif
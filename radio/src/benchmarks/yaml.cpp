@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+#include "storage/yaml/yaml_tree_walker.h"
+#include "storage/yaml/yaml_parser.h"
+#include "storage/yaml/yaml_datastructs.h"
+
+#include <memory>
+#include <string>
+
+static bool stringWriter(void * opaque, const char * str, size_t len)
+{
+  static_cast<std::string *>(opaque)->append(str, len);
+  return true;
+}
+
+static std::string generateModelYaml(ModelData * model)
+{
+  std::string yaml;
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t *)model);
+  tree.generate(stringWriter, &yaml);
+  return yaml;
+}
+
+static void BM_YamlTreeWalker_generate(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+  size_t bytes = 0;
+  for (auto _ : state) {
+    bytes += generateModelYaml(&g_model).size();
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_YamlTreeWalker_generate);
+
+static void BM_YamlParser_parse(benchmark::State & state)
+{
+  benchmarkLoadHeavyModel();
+  std::string yaml = generateModelYaml(&g_model);
+  std::unique_ptr<ModelData> model(new ModelData);
+
+  for (auto _ : state) {
+    YamlTreeWalker tree;
+    tree.reset(get_modeldata_nodes(), (uint8_t *)model.get());
+
+    YamlParser parser;
+    parser.init(YamlTreeWalker::get_parser_calls(), &tree);
+    parser.set_eof();
+    parser.parse(yaml.c_str(), yaml.size());
+  }
+  state.SetBytesProcessed(state.iterations() * yaml.size());
+}
+BENCHMARK(BM_YamlParser_parse);
@@ -27,6 +27,9 @@
 
 BinAllocator_slots1 slots1 __SDRAM;
 BinAllocator_slots2 slots2 __SDRAM;
+BinAllocator_slots3 slots3 __SDRAM;
+
+uint32_t binAllocatorHeapFallbacks = 0;
 
 #if defined(DEBUG)
 int SimulateMallocFailure = 0;    //set this to simulate allocation failure
@@ -35,13 +38,14 @@ int SimulateMallocFailure = 0;    //set this to simulate allocation failure
 bool bin_free(void * ptr)
 {
   //return TRUE if ours
-  return slots1.free(ptr) || slots2.free(ptr);
+  return slots1.free(ptr) || slots2.free(ptr) || slots3.free(ptr);
 }
 
 void * bin_malloc(size_t size) {
   //try to allocate from our space
   void * res = slots1.malloc(size);
-  return res ? res : slots2.malloc(size);
+  if (!res) res = slots2.malloc(size);
+  return res ? res : slots3.malloc(size);
 }
 
 void * bin_realloc(void * ptr, size_t size)
@@ -51,7 +55,7 @@ void * bin_realloc(void * ptr, size_t size)
     return bin_malloc(size);
   }
   else {
-    if (! (slots1.is_member(ptr) || slots2.is_member(ptr)) ) {
+    if (! (slots1.is_member(ptr) || slots2.is_member(ptr) || slots3.is_member(ptr)) ) {
       // not our data, leave it to libc realloc
       return 0;
     }
@@ -67,12 +71,17 @@ void * bin_realloc(void * ptr, size_t size)
       // TRACE("OUR realloc %p[%lu] fits in slot2", ptr, size);
       return ptr;
     }
+    if ( slots3.can_fit(ptr, size) ) {
+      // TRACE("OUR realloc %p[%lu] fits in slot3", ptr, size);
+      return ptr;
+    }
 
     //we need a bigger slot
     void * res = bin_malloc(size);
     if (res == 0) {
       // we don't have the space, use libc malloc
       // TRACE("bin_malloc [%lu] FAILURE", size);
+      ++binAllocatorHeapFallbacks;
       res = malloc(size);
       if (res == 0) {
         TRACE("libc malloc [%lu] FAILURE", size);  
@@ -80,7 +89,7 @@ void * bin_realloc(void * ptr, size_t size)
       }
     }
     //copy data
-    memcpy(res, ptr, slots1.size(ptr) + slots2.size(ptr));
+    memcpy(res, ptr, slots1.size(ptr) + slots2.size(ptr) + slots3.size(ptr));
     bin_free(ptr);
     return res;
   }
@@ -120,6 +129,7 @@ void *bin_l_alloc (void *ud, void *ptr, size_t osize, size_t nsize)
       // TRACE("OUR realloc %p[%lu] -> %p[%lu]", ptr, osize, res, nsize); 
     }
     if (res == 0) {
+      if (!ptr) ++binAllocatorHeapFallbacks;
       res = realloc(ptr, nsize);
       // TRACE("libc realloc %p[%lu] -> %p[%lu]", ptr, osize, res, nsize);
       // if (res == 0 ){
@@ -24,73 +24,104 @@
 
 #include "debug.h"
 
+// Fixed size slots, the free ones are chained through their first bytes so
+// that malloc() and free() are O(1). Slots are 8 bytes aligned for Lua.
 template <int SIZE_SLOT, int NUM_BINS> class BinAllocator {
 private:
-  PACK(struct Bin {
-    char data[SIZE_SLOT];
-    bool Used;
-  });
-  struct Bin Bins[NUM_BINS];
+  static constexpr size_t SLOT_SIZE = (SIZE_SLOT + 7) & ~7;
+  union Bin {
+    Bin * next;
+    char data[SLOT_SIZE];
+  } __attribute__((aligned(8)));
+  union Bin Bins[NUM_BINS];
+  union Bin * FreeBins;
   int NoUsedBins;
+  int MaxUsedBins;
 public:
-  BinAllocator() : NoUsedBins(0) {
-    memclear(Bins, sizeof(Bins));
+  BinAllocator() : FreeBins(nullptr), NoUsedBins(0), MaxUsedBins(0) {
+    for (int n = NUM_BINS - 1; n >= 0; --n) {
+      Bins[n].next = FreeBins;
+      FreeBins = &Bins[n];
+    }
   }
   bool free(void * ptr) {
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (ptr == Bins[n].data) {
-        Bins[n].Used = false;
-        --NoUsedBins;
-        // TRACE("\tBinAllocator<%d> free %lu ------", SIZE_SLOT, n);
-        return true;
-      }
+    if (!is_member(ptr)) {
+      return false;
     }
-    return false;
+    Bin * bin = static_cast<Bin *>(ptr);
+    bin->next = FreeBins;
+    FreeBins = bin;
+    --NoUsedBins;
+    // TRACE("\tBinAllocator<%d> free %p ------", SIZE_SLOT, ptr);
+    return true;
   }
   bool is_member(void * ptr) {
     return (ptr >= Bins[0].data && ptr <= Bins[NUM_BINS-1].data);
   }
   void * malloc(size_t size) {
-    if (size > SIZE_SLOT) {
+    if (size > SLOT_SIZE) {
       // TRACE("BinAllocator<%d> malloc [%lu] size > SIZE_SLOT", SIZE_SLOT, size);
       return 0;
     }
-    if (NoUsedBins >= NUM_BINS) {
+    Bin * bin = FreeBins;
+    if (!bin) {
       // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT, size);
       return 0;
     }
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (!Bins[n].Used) {
-        Bins[n].Used = true;
-        ++NoUsedBins;
-        // TRACE("\tBinAllocator<%d> malloc %lu[%lu]", SIZE_SLOT, n, size);
-        return Bins[n].data;
-      }
+    FreeBins = bin->next;
+    if (++NoUsedBins > MaxUsedBins) {
+      MaxUsedBins = NoUsedBins;
     }
-    // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT , size);
-    return 0;
+    // TRACE("\tBinAllocator<%d> malloc %p[%lu]", SIZE_SLOT, bin, size);
+    return bin->data;
   }
   size_t size(void * ptr) {
-    return is_member(ptr) ? SIZE_SLOT : 0;
+    return is_member(ptr) ? SLOT_SIZE : 0;
   }
   bool can_fit(void * ptr, size_t size) {
-    return is_member(ptr) && size <= SIZE_SLOT;  //todo is_member check is redundant
+    return is_member(ptr) && size <= SLOT_SIZE;  //todo is_member check is redundant
   }
   unsigned int capacity() { return NUM_BINS; }
   unsigned int size() { return NoUsedBins; }
+  unsigned int highWater() { return MaxUsedBins; }
+  static constexpr size_t slotSize() { return SLOT_SIZE; }
 };
 
+// Size classes following the Lua 5.2 objects on 32 bits targets: short
+// strings, closures and upvalues (16 bytes header + data), tables and small
+// node or array parts, then longer strings and hash parts
 #if defined(SIMU)
-typedef BinAllocator<39,300> BinAllocator_slots1;
-typedef BinAllocator<79,100> BinAllocator_slots2;
+typedef BinAllocator<24,400> BinAllocator_slots1;
+typedef BinAllocator<40,240> BinAllocator_slots2;
+typedef BinAllocator<96,100> BinAllocator_slots3;
 #else
-typedef BinAllocator<27,200> BinAllocator_slots1;
-typedef BinAllocator<91,50> BinAllocator_slots2;
+typedef BinAllocator<24,150> BinAllocator_slots1;
+typedef BinAllocator<40,90> BinAllocator_slots2;
+typedef BinAllocator<96,32> BinAllocator_slots3;
+#endif
+
+// Size classes for LVGL, which allocates and frees objects all the time
+// while navigating the menus: style and event lists, objects and their
+// extra attributes, then label texts and small buffers. Requests that do
+// not fit, or find their class full, go to the heap.
+#if defined(LIBOPENUI) && defined(SDRAM) && !defined(SIMU)
+#define LVGL_BIN_ALLOCATOR
+typedef BinAllocator<16,2048> LvglAllocator_slots1;
+typedef BinAllocator<48,2048> LvglAllocator_slots2;
+typedef BinAllocator<128,512> LvglAllocator_slots3;
+
+extern LvglAllocator_slots1 lvglSlots1;
+extern LvglAllocator_slots2 lvglSlots2;
+extern LvglAllocator_slots3 lvglSlots3;
 #endif
 
 #if defined(USE_BIN_ALLOCATOR)
 extern BinAllocator_slots1 slots1;
 extern BinAllocator_slots2 slots2;
+extern BinAllocator_slots3 slots3;
+
+// allocations which did not fit in any slot and went to the libc heap
+extern uint32_t binAllocatorHeapFallbacks;
 
 // wrapper for our BinAllocator for Lua
 void *bin_l_alloc (void *ud, void *ptr, size_t osize, size_t nsize);
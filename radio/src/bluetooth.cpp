@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include "opentx.h"
 #include "io/frsky_firmware_update.h"
+#include "io/flashing_progress.h"
 #include "bluetooth_driver.h"
 
 #if defined(LIBOPENUI)
@@ -146,6 +147,42 @@ void Bluetooth::processTrainerFrame(const uint8_t * buffer)
   }
 
   trainerInputValidityTimer = TRAINER_IN_VALID_TIMEOUT;
+  updateTrainerStats(true);
+}
+
+void Bluetooth::resetTrainerStats()
+{
+  trainerStats = {};
+  lastFrameTime = 0;
+  statsStart = RTOS_GET_MS();
+  statsGapSum = statsGapMax = 0;
+  statsFrames = statsGaps = 0;
+}
+
+void Bluetooth::updateTrainerStats(bool frame)
+{
+  uint32_t now = RTOS_GET_MS();
+
+  if (frame) {
+    if (lastFrameTime) {
+      uint32_t gap = now - lastFrameTime;
+      statsGapSum += gap;
+      if (gap > statsGapMax) statsGapMax = gap;
+      statsGaps++;
+    }
+    lastFrameTime = now;
+    statsFrames++;
+  }
+
+  uint32_t elapsed = now - statsStart;
+  if (elapsed >= 1000) {
+    trainerStats.rate = statsFrames * 1000 / elapsed;
+    trainerStats.gapAvg = statsGaps ? statsGapSum / statsGaps : 0;
+    trainerStats.gapMax = statsGapMax;
+    statsStart = now;
+    statsGapSum = statsGapMax = 0;
+    statsFrames = statsGaps = 0;
+  }
 }
 
 void Bluetooth::appendTrainerByte(uint8_t data)
@@ -271,7 +308,9 @@ void Bluetooth::sendTrainer()
   pushByte(crc);
   buffer[bufferIndex++] = START_STOP; // end byte
 
+  // the whole frame goes to the USART in one go
   write(buffer, bufferIndex);
+  updateTrainerStats(true);
 
   // If not in verbose mode output one buffer per line
   #if defined(DEBUG_BLUETOOTH) && !defined(DEBUG_BLUETOOTH_VERBOSE)
@@ -313,24 +352,27 @@ void Bluetooth::forwardTelemetry(const uint8_t * packet)
 
 void Bluetooth::receiveTrainer()
 {
-  uint8_t byte;
+  const uint8_t* data;
+  uint32_t len;
 
-  while (true) {
-    if (!bluetoothRead(&byte)) {
-      return;
-    }
+  // parse the received bytes in place, one span at a time
+  while ((len = bluetoothGetRxSpan(&data)) > 0) {
+    for (uint32_t i = 0; i < len; i++) {
+      uint8_t byte = data[i];
 
 #if defined(DEBUG_BLUETOOTH)
-    static uint8_t lastb=0;
-    BLUETOOTH_TRACE("%02X ", byte);
-    if(byte == START_STOP && lastb != START_STOP) {
-      BLUETOOTH_TRACE(CRLF);
-      BLUETOOTH_TRACE_TIMESTAMP();
-    }
-    lastb = byte;
+      static uint8_t lastb=0;
+      BLUETOOTH_TRACE("%02X ", byte);
+      if(byte == START_STOP && lastb != START_STOP) {
+        BLUETOOTH_TRACE(CRLF);
+        BLUETOOTH_TRACE_TIMESTAMP();
+      }
+      lastb = byte;
 #endif
 
-    processTrainerByte(byte);
+      processTrainerByte(byte);
+    }
+    bluetoothConsumeRx(len);
   }
 }
 
@@ -401,6 +443,14 @@ void Bluetooth::wakeup()
     }
   }
 
+  // the master parses trainer frames as soon as they arrive,
+  // not only on the state machine period
+  if (state == BLUETOOTH_STATE_CONNECTED &&
+      g_eeGeneral.bluetoothMode == BLUETOOTH_TRAINER &&
+      g_model.trainerData.mode == TRAINER_MODE_MASTER_BLUETOOTH) {
+    receiveTrainer();
+  }
+
   tmr10ms_t now = get_tmr10ms();
 
   if (now < wakeupTime)
@@ -441,11 +491,12 @@ void Bluetooth::wakeup()
   else if (state == BLUETOOTH_STATE_CONNECTED) {
     if (g_eeGeneral.bluetoothMode == BLUETOOTH_TRAINER && g_model.trainerData.mode == TRAINER_MODE_MASTER_BLUETOOTH) {
       receiveTrainer();
+      updateTrainerStats(false);
     }
     else {
       if (g_eeGeneral.bluetoothMode == BLUETOOTH_TRAINER && g_model.trainerData.mode == TRAINER_MODE_SLAVE_BLUETOOTH) {
         sendTrainer();
-        wakeupTime = now + 2; /* 20ms */
+        wakeupTime = now + BLUETOOTH_TRAINER_PERIOD;
       }
       readline(); // to deal with "ERROR"
     }
@@ -527,6 +578,7 @@ void Bluetooth::wakeup()
                (line != nullptr) && !strncmp(line, "Connected:", 10)) {
       strcpy(distantAddr, &line[10]); // TODO quick & dirty
       state = BLUETOOTH_STATE_CONNECTED;
+      resetTrainerStats();
       if (g_model.trainerData.mode == TRAINER_MODE_SLAVE_BLUETOOTH) {
         wakeupTime += 500; // it seems a 5s delay is needed before sending the 1st frame
       }
@@ -791,9 +843,10 @@ const char * Bluetooth::doFlashFirmware(const char * filename, ProgressHandler p
   if (result)
     return result;
 
+  FlashingProgress progress(progressHandler, getBasename(filename));
   uint32_t done = 0;
   while (1) {
-    progressHandler(getBasename(filename), STR_FLASH_WRITE, done, size);
+    progress.report(STR_FLASH_WRITE, done, size);
     if (f_read(&file, buffer, min<uint32_t>(sizeof(buffer), size - done), &count) != FR_OK) {
       f_close(&file);
       return "Error reading file";
@@ -804,6 +857,7 @@ const char * Bluetooth::doFlashFirmware(const char * filename, ProgressHandler p
     done += count;
     if (done >= size) {
       f_close(&file);
+      TRACE("BT flashing done, %d bytes/s", progress.bytesPerSecond());
       return nullptr;
     }
   }
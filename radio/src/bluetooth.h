@@ -54,6 +54,7 @@ enum BluetoothStates {
 #define BLUETOOTH_PACKET_SIZE           14
 #define BLUETOOTH_LINE_LENGTH           32
 #define BLUETOOTH_TRAINER_CHANNELS      8
+#define BLUETOOTH_TRAINER_PERIOD        1 /* 10ms */
 
 #if defined(LOG_BLUETOOTH)
   #define BLUETOOTH_TRACE(...)  \
@@ -75,6 +76,13 @@ enum BluetoothStates {
 #endif
 #endif
 
+// Trainer link statistics, over the last second
+struct BluetoothTrainerStats {
+  uint16_t rate;    // frames per second
+  uint16_t gapAvg;  // ms between frames
+  uint16_t gapMax;
+};
+
 class Bluetooth
 {
   public:
@@ -89,6 +97,7 @@ class Bluetooth
     volatile uint8_t state;
     char localAddr[LEN_BLUETOOTH_ADDR+1];
     char distantAddr[LEN_BLUETOOTH_ADDR+1];
+    BluetoothTrainerStats trainerStats = {};
 
   protected:
     void pushByte(uint8_t byte);
@@ -98,6 +107,8 @@ class Bluetooth
     void processTrainerByte(uint8_t data);
     void sendTrainer();
     void receiveTrainer();
+    void resetTrainerStats();
+    void updateTrainerStats(bool frame);
 
     uint8_t bootloaderChecksum(uint8_t command, const uint8_t * data, uint8_t size);
     void bootloaderSendCommand(uint8_t command, const void *data = nullptr, uint8_t size = 0);
@@ -117,6 +128,13 @@ class Bluetooth
     uint8_t bufferIndex = 0;
     tmr10ms_t wakeupTime = 0;
     uint8_t crc;
+
+    uint32_t lastFrameTime = 0;
+    uint32_t statsStart = 0;
+    uint32_t statsGapSum = 0;
+    uint16_t statsGapMax = 0;
+    uint16_t statsFrames = 0;
+    uint16_t statsGaps = 0;
 };
 
 extern Bluetooth bluetooth;
@@ -32,9 +32,28 @@
 
 #include <stdlib.h>
 
+// GPIO port index of each switch contact (high, low)
+static uint8_t _switch_ports[n_total_switches][2];
+
+// last snapshot of the switch GPIO input registers
+static uint32_t _switch_gpio_values[n_switch_gpios + 1];
+
+static uint8_t _find_switch_port(GPIO_TypeDef* GPIOx)
+{
+  for (uint8_t i = 0; i < n_switch_gpios; i++) {
+    if (_switch_gpios[i] == GPIOx) return i;
+  }
+  return n_switch_gpios;
+}
+
 void switchInit()
 {
   _init_switches();
+
+  for (uint8_t i = 0; i < n_total_switches; i++) {
+    _switch_ports[i][0] = _find_switch_port(_switch_defs[i].GPIOx_high);
+    _switch_ports[i][1] = _find_switch_port(_switch_defs[i].GPIOx_low);
+  }
 }
 
 swconfig_t switchGetDefaultConfig()
@@ -98,6 +117,30 @@ SwitchHwPos switchGetPosition(uint8_t idx)
   return stm32_switch_get_position(&_switch_defs[idx]);
 }
 
+uint64_t switchSampleInputs()
+{
+  // XOR of the ports against the previous snapshot, the (unused)
+  // last entry stands for contacts without GPIO (ADC or none)
+  uint32_t diff[n_switch_gpios + 1];
+  for (uint8_t i = 0; i < n_switch_gpios; i++) {
+    uint32_t value = LL_GPIO_ReadInputPort(_switch_gpios[i]);
+    diff[i] = value ^ _switch_gpio_values[i];
+    _switch_gpio_values[i] = value;
+  }
+  diff[n_switch_gpios] = 0;
+
+  uint64_t changed = 0;
+  for (uint8_t i = 0; i < n_total_switches; i++) {
+    const stm32_switch_t* sw = &_switch_defs[i];
+    if (sw->type == SWITCH_HW_ADC ||
+        (diff[_switch_ports[i][0]] & sw->Pin_high) ||
+        (diff[_switch_ports[i][1]] & sw->Pin_low)) {
+      changed |= (uint64_t)1 << i;
+    }
+  }
+  return changed;
+}
+
 const char* switchGetName(uint8_t idx)
 {
   if (idx >= n_total_switches) return "";
@@ -36,6 +36,17 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "module_timing.h"
+#include "mixer_profiler.h"
+#include "mixer_scheduler.h"
+#include "task_stats.h"
+#include "power_governor.h"
+#include "event_trace.h"
+
+#if defined(LIBOPENUI)
+  #include "bitmap_cache.h"
+#endif
+#include "bin_allocator.h"
 
 #include "cli.h"
 
@@ -454,6 +465,456 @@ int cliTestSD(const char ** argv)
   return 0;
 }
 
+// Benchmark suite: each kernel runs for BENCH_RUNTIME_MS, and one CSV
+// line is printed per kernel, so that radios and builds can be compared:
+//   bench,<kernel>,<runs>,<ms>,<ns per run>
+
+#include "storage/yaml/yaml_tree_walker.h"
+#include "storage/yaml/yaml_parser.h"
+#include "storage/yaml/yaml_datastructs.h"
+#include "fw_version.h"
+
+#if defined(DISK_CACHE)
+#include "disk_cache.h"
+#endif
+
+#define BENCH_RUNTIME_MS          500
+#define BENCH_YAML_BUFFER_SIZE    (16 * 1024)
+#define BENCH_SD_BLOCK_SIZE       (4 * 1024)
+#define BENCH_SD_SECTOR_SIZE      512
+#define BENCH_SD_FILE             "/bench.tmp"
+#define BENCH_MIXER_WORST_RUNS    500
+
+// the mixer must fit in the shortest frame period (4ms, e.g. CRSF)
+#define BENCH_MIXER_BUDGET_US     MIXER_SCHEDULER_DEFAULT_PERIOD_US
+
+typedef void (*benchFunc_t)();
+
+static volatile int32_t benchSink;
+
+static void runBench(const char * name, benchFunc_t func)
+{
+  const uint32_t start = RTOS_GET_MS();
+  uint32_t runs = 0;
+  uint32_t elapsed;
+  while ((elapsed = RTOS_GET_MS() - start) < BENCH_RUNTIME_MS) {
+    func();
+    runs++;
+  }
+  cliSerialPrint("bench,%s,%lu,%lu,%lu", name, runs, elapsed,
+                 uint32_t((uint64_t)elapsed * 1000000 / runs));
+}
+
+static void benchError(const char * name, const char * error)
+{
+  cliSerialPrint("bench,%s,error,%s", name, error);
+}
+
+// Mixer: all the mixer and input lines in use
+static void benchSetupHeavyModel()
+{
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * expo = expoAddress(i);
+    memclear(expo, sizeof(ExpoData));
+    expo->srcRaw = MIXSRC_FIRST_STICK + i % MAX_STICKS;
+    expo->chn = i % MAX_INPUTS;
+    expo->mode = 3;
+    expo->weight = 100;
+    expo->curve.type = CURVE_REF_EXPO;
+    expo->curve.value = 30;
+  }
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * mix = mixAddress(i);
+    memclear(mix, sizeof(MixData));
+    mix->destCh = i % MAX_OUTPUT_CHANNELS;
+    mix->srcRaw = MIXSRC_FIRST_INPUT + i % MAX_INPUTS;
+    mix->weight = 100 - i;
+    mix->mltpx = MLTPX_ADD;
+    mix->curve.type = (i & 1) ? CURVE_REF_EXPO : CURVE_REF_DIFF;
+    mix->curve.value = 20;
+  }
+}
+
+static void benchMixer()
+{
+  evalMixes(1);
+}
+
+// worst case over BENCH_MIXER_WORST_RUNS, checked against the budget:
+//   bench,mixer_worst_us,<us>,<budget us>,<pass | fail>
+static void runBenchMixerWorst(uint32_t budget)
+{
+  uint32_t worst = 0;
+  for (uint16_t i = 0; i < BENCH_MIXER_WORST_RUNS; i++) {
+    uint32_t start = ticksNow();
+    evalMixes(1);
+    uint32_t duration = ticksNow() - start;
+    if (duration > worst) {
+      worst = duration;
+    }
+  }
+
+  worst /= SYSTEM_TICKS_1US;
+  cliSerialPrint("bench,mixer_worst_us,%lu,%lu,%s", worst, budget,
+                 worst <= budget ? "pass" : "fail");
+}
+
+static void benchExpo()
+{
+  int32_t sum = 0;
+  for (int x = -RESX; x <= RESX; x += 16) {
+    sum += expo(x, 40);
+  }
+  benchSink = sum;
+}
+
+static void benchCurve()
+{
+  int32_t sum = 0;
+  for (int x = -RESX; x <= RESX; x += 16) {
+    sum += applyCustomCurve(x, 0);
+  }
+  benchSink = sum;
+}
+
+// CRC over 1kB
+static void benchCrc16()
+{
+  benchSink = crc16(CRC_1021, (const uint8_t *)&g_model, 1024);
+}
+
+static void benchCrc8()
+{
+  benchSink = crc8((const uint8_t *)&g_model, 1024);
+}
+
+// YAML: the current model, generated into / parsed from RAM
+struct BenchYamlBuffer {
+  char * data;
+  uint32_t len;
+};
+
+static BenchYamlBuffer benchYaml;
+static ModelData * benchModel = nullptr;
+
+static bool benchYamlWriter(void * opaque, const char * str, size_t len)
+{
+  auto buffer = (BenchYamlBuffer *)opaque;
+  if (buffer->len + len > BENCH_YAML_BUFFER_SIZE) {
+    return false;
+  }
+  memcpy(buffer->data + buffer->len, str, len);
+  buffer->len += len;
+  return true;
+}
+
+static bool benchYamlGenerateModel()
+{
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t *)&g_model);
+  benchYaml.len = 0;
+  return tree.generate(benchYamlWriter, &benchYaml);
+}
+
+static void benchYamlGenerate()
+{
+  benchYamlGenerateModel();
+}
+
+static void benchYamlParse()
+{
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t *)benchModel);
+
+  YamlParser parser;
+  parser.init(YamlTreeWalker::get_parser_calls(), &tree);
+  parser.set_eof();
+  parser.parse(benchYaml.data, benchYaml.len);
+}
+
+static void runBenchYaml()
+{
+  benchYaml.data = new (std::nothrow) char[BENCH_YAML_BUFFER_SIZE];
+  benchModel = new (std::nothrow) ModelData;
+
+  if (!benchYaml.data || !benchModel) {
+    benchError("yaml", "no memory");
+  } else if (!benchYamlGenerateModel()) {
+    benchError("yaml", "model too large");
+  } else {
+    cliSerialPrint("bench,yaml_size,%lu", benchYaml.len);
+    runBench("yaml_generate", benchYamlGenerate);
+    runBench("yaml_parse", benchYamlParse);
+  }
+
+  delete[] benchYaml.data;
+  benchYaml.data = nullptr;
+  delete benchModel;
+  benchModel = nullptr;
+}
+
+// Rendering
+#if defined(COLORLCD)
+static BitmapBuffer * benchBitmap = nullptr;
+static BitmapBuffer * benchSprite = nullptr;
+
+static void benchLcdFill()
+{
+  benchBitmap->drawSolidFilledRect(0, 0, benchBitmap->width(),
+                                   benchBitmap->height(),
+                                   COLOR_THEME_SECONDARY3);
+}
+
+static void benchLcdBlit()
+{
+  benchBitmap->drawBitmap(0, 0, benchSprite);
+}
+
+static void benchLcdText()
+{
+  benchBitmap->drawText(0, 0, "The quick brown fox jumps over the lazy dog",
+                        COLOR_THEME_SECONDARY1);
+}
+
+static void runBenchLcd()
+{
+  benchBitmap = new BitmapBuffer(BMP_RGB565, LCD_W / 2, LCD_H / 2);
+  benchSprite = new BitmapBuffer(BMP_RGB565, 64, 64);
+
+  if (!benchBitmap->getData() || !benchSprite->getData()) {
+    benchError("lcd", "no memory");
+  } else {
+    benchSprite->clear(COLOR_THEME_PRIMARY2);
+    runBench("lcd_fill", benchLcdFill);
+    runBench("lcd_blit", benchLcdBlit);
+    runBench("lcd_text", benchLcdText);
+  }
+
+  delete benchBitmap;
+  benchBitmap = nullptr;
+  delete benchSprite;
+  benchSprite = nullptr;
+}
+#else
+// the menus redraw the screen on their next refresh
+static void benchLcdFill()
+{
+  lcdDrawFilledRect(0, 0, LCD_W, LCD_H, SOLID, 0);
+}
+
+static void benchLcdText()
+{
+  lcdDrawText(0, 0, "The quick brown fox", 0);
+}
+
+static void benchLcdClear()
+{
+  lcdClear();
+}
+
+static void runBenchLcd()
+{
+  runBench("lcd_fill", benchLcdFill);
+  runBench("lcd_text", benchLcdText);
+  runBench("lcd_clear", benchLcdClear);
+}
+#endif
+
+// Lua VM, in a private state (the scripts state belongs to the menus)
+#if defined(LUA) && defined(LUA_COMPILER)
+static lua_State * benchLuaState = nullptr;
+
+static const char benchLuaChunk[] =
+    "local s = 0 for i = 1, 100 do s = s + i % 7 end return s";
+
+static void benchLuaOps()
+{
+  lua_pushvalue(benchLuaState, -1);
+  if (lua_pcall(benchLuaState, 0, 1, 0) == LUA_OK) {
+    benchSink = lua_tointeger(benchLuaState, -1);
+  }
+  lua_pop(benchLuaState, 1);
+}
+
+static void runBenchLua()
+{
+  benchLuaState = luaL_newstate();
+  if (!benchLuaState) {
+    benchError("lua", "no memory");
+    return;
+  }
+
+  if (luaL_loadstring(benchLuaState, benchLuaChunk) == LUA_OK) {
+    runBench("lua_ops", benchLuaOps);
+  } else {
+    benchError("lua", "compile error");
+  }
+
+  lua_close(benchLuaState);
+  benchLuaState = nullptr;
+}
+#endif
+
+// SD card, through FatFs (and the disk cache)
+static FIL * benchFile = nullptr;
+static uint8_t * benchBlock = nullptr;
+static uint32_t benchRandom = 1;
+
+static void benchSdWrite()
+{
+  UINT written;
+  f_write(benchFile, benchBlock, BENCH_SD_BLOCK_SIZE, &written);
+}
+
+static void benchSdRead()
+{
+  UINT read;
+  if (f_eof(benchFile)) {
+    f_lseek(benchFile, 0);
+  }
+  f_read(benchFile, benchBlock, BENCH_SD_BLOCK_SIZE, &read);
+}
+
+static void benchSdRandomRead()
+{
+  UINT read;
+  benchRandom = benchRandom * 1664525 + 1013904223;
+  uint32_t sectors = f_size(benchFile) / BENCH_SD_SECTOR_SIZE;
+  f_lseek(benchFile, ((benchRandom >> 8) % sectors) * BENCH_SD_SECTOR_SIZE);
+  f_read(benchFile, benchBlock, BENCH_SD_SECTOR_SIZE, &read);
+}
+
+static void runBenchSd()
+{
+  benchFile = new (std::nothrow) FIL;
+  benchBlock = new (std::nothrow) uint8_t[BENCH_SD_BLOCK_SIZE];
+
+  if (!benchFile || !benchBlock) {
+    benchError("sd", "no memory");
+  } else if (f_open(benchFile, BENCH_SD_FILE,
+                    FA_CREATE_ALWAYS | FA_WRITE | FA_READ) != FR_OK) {
+    benchError("sd", "cannot open file");
+  } else {
+    memset(benchBlock, 0x55, BENCH_SD_BLOCK_SIZE);
+    runBench("sd_write_4k", benchSdWrite);
+    f_sync(benchFile);
+    cliSerialPrint("bench,sd_file_size,%lu", (uint32_t)f_size(benchFile));
+
+    if (f_size(benchFile) >= BENCH_SD_BLOCK_SIZE) {
+      f_lseek(benchFile, 0);
+      runBench("sd_read_4k", benchSdRead);
+      runBench("sd_random_read_512", benchSdRandomRead);
+    }
+#if defined(DISK_CACHE)
+    cliSerialPrint("bench,sd_cache_hit_rate,%d", diskCache.getHitRate());
+#endif
+
+    f_close(benchFile);
+    f_unlink(BENCH_SD_FILE);
+  }
+
+  delete benchFile;
+  benchFile = nullptr;
+  delete[] benchBlock;
+  benchBlock = nullptr;
+}
+
+static bool benchSelected(const char * selected, const char * kernel)
+{
+  return selected[0] == '\0' || !strcmp(selected, kernel);
+}
+
+int cliBench(const char ** argv)
+{
+  const char * selected = argv[1] ? argv[1] : "";
+  uint32_t budget = BENCH_MIXER_BUDGET_US;
+  if (argv[1] && argv[2] && argv[2][0]) {
+    int value;
+    if (toInt(argv, 2, &value) > 0 && value > 0) {
+      budget = value;
+    }
+  }
+
+  cliSerialPrint("bench,build,%s,%s", FLAVOUR, VERSION);
+
+  // the mixer task would compete for the CPU
+  watchdogSuspend(6000 /*60s*/);
+  bool mixerRunning = mixerTaskRunning();
+  if (mixerRunning) {
+    mixerTaskStop();
+  }
+
+  if (benchSelected(selected, "mixer")) {
+    auto backup = new (std::nothrow) ModelData;
+    if (backup) {
+      memcpy(backup, &g_model, sizeof(ModelData));
+      benchSetupHeavyModel();
+      runBench("mixer_heavy", benchMixer);
+      runBenchMixerWorst(budget);
+      memcpy(&g_model, backup, sizeof(ModelData));
+      delete backup;
+    } else {
+      benchError("mixer_heavy", "no memory");
+    }
+    runBench("mixer_model", benchMixer);
+  }
+
+  if (benchSelected(selected, "expo")) {
+    runBench("expo", benchExpo);
+    runBench("curve", benchCurve);
+  }
+
+  if (benchSelected(selected, "crc")) {
+    runBench("crc16_1k", benchCrc16);
+    runBench("crc8_1k", benchCrc8);
+  }
+
+  if (benchSelected(selected, "yaml")) {
+    runBenchYaml();
+  }
+
+  if (benchSelected(selected, "lcd")) {
+    runBenchLcd();
+  }
+
+#if defined(LUA) && defined(LUA_COMPILER)
+  if (benchSelected(selected, "lua")) {
+    runBenchLua();
+  }
+#endif
+
+  if (benchSelected(selected, "sd")) {
+    runBenchSd();
+  }
+
+  if (mixerRunning) {
+    mixerTaskStart();
+  }
+  watchdogSuspend(0);
+
+  cliSerialPrint("bench,done");
+  return 0;
+}
+
+// HID reports over the last second
+int cliUsbJoystick(const char ** argv)
+{
+  if (getSelectedUsbMode() != USB_JOYSTICK_MODE) {
+    cliSerialPrint("%s: USB joystick mode not active", argv[0]);
+    return -1;
+  }
+
+  UsbJoystickStats stats;
+  usbJoystickGetStats(&stats);
+  cliSerialPrint("reports: %d/s, unchanged: %d/s", stats.sent,
+                 stats.unchanged);
+  cliSerialPrint("host poll latency: min %dus, avg %dus, max %dus",
+                 stats.latencyMin, stats.latencyAvg, stats.latencyMax);
+  cliSerialPrint("jitter: %dus", stats.latencyMax - stats.latencyMin);
+  return 0;
+}
+
 int cliTestNew()
 {
   char * tmp = 0;
@@ -854,10 +1315,93 @@ int cliStackInfo(const char ** argv)
   cliSerialPrint("[MENUS] %d available / %d bytes", menusStack.available()*4, menusStack.size());
   cliSerialPrint("[MIXER] %d available / %d bytes", mixerStack.available()*4, mixerStack.size());
   cliSerialPrint("[AUDIO] %d available / %d bytes", audioStack.available()*4, audioStack.size());
+#if defined(STORAGE_TASK)
+  cliSerialPrint("[STORAGE] %d available / %d bytes", storageStack.available()*4, storageStack.size());
+#endif
+#if defined(TELEMETRY_TASK)
+  cliSerialPrint("[TELEM] %d available / %d bytes", telemetryStack.available()*4, telemetryStack.size());
+#endif
   cliSerialPrint("[CLI] %d available / %d bytes", cliStack.available()*4, cliStack.size());
   return 0;
 }
 
+// CPU load per task and interrupt over the last second
+int cliTaskLoad(const char ** argv)
+{
+  uint8_t count = taskStatsCount();
+  if (!count) {
+    cliSerialPrint("no task statistics yet");
+    return 0;
+  }
+
+  uint16_t load = taskStatsCpuLoad();
+  cliSerialPrint("CPU load %d.%d%%", load / 10, load % 10);
+  for (uint8_t i = 0; i < count; i++) {
+    load = taskStatsLoad(i);
+    cliSerialPrint("[%s] %d.%d%%", taskStatsName(i), load / 10, load % 10);
+  }
+  for (uint8_t i = 0; i < TASK_STATS_ISR_COUNT; i++) {
+    load = taskStatsIsrLoad(i);
+    cliSerialPrint("[isr %s] %d.%d%%, %d calls", taskStatsIsrName(i),
+                   load / 10, load % 10, (int)taskStatsIsrCount(i));
+  }
+
+  load = powerSaveSleepLoad();
+  cliSerialPrint("power save %s, sleep %d.%d%%, ~%dmA saved",
+                 powerSaveActive() ? "on" : "off", load / 10, load % 10,
+                 powerSaveEstimatedSaving());
+
+  if (argv[1] && !strcmp(argv[1], "history")) {
+    uint8_t value;
+    for (uint8_t i = 0; taskStatsGetHistory(i, value); i++) {
+      cliSerialPrint("-%ds: %d%%", i, value);
+    }
+  }
+  return 0;
+}
+
+#if defined(DEBUG_EVENT_TRACE)
+// The dump is parsed by tools/trace2perfetto.py
+int cliEventTrace(const char ** argv)
+{
+  if (argv[1] && !strcmp(argv[1], "start")) {
+    eventTraceStart();
+    cliSerialPrint("event trace started");
+  }
+  else if (argv[1] && !strcmp(argv[1], "stop")) {
+    eventTraceStop();
+    cliSerialPrint("event trace stopped, %d events", eventTraceCount());
+  }
+  else if (argv[1] && !strcmp(argv[1], "dump")) {
+    // the records are only stable while stopped
+    bool running = eventTraceRunning;
+    eventTraceStop();
+
+    cliSerialPrint("evtrace,clock,%d", SYSTEM_TICKS_1US);
+    for (uint8_t i = 0; i < taskStatsCount(); i++) {
+      cliSerialPrint("evtrace,task,%d,%s", i, taskStatsName(i));
+    }
+    for (uint8_t i = 1; i < EVENT_TRACE_COUNT; i++) {
+      cliSerialPrint("evtrace,event,%d,%s", i, eventTraceName(i));
+    }
+    for (uint16_t i = 0; i < eventTraceCount(); i++) {
+      auto rec = eventTraceGet(i);
+      cliSerialPrint("evtrace,rec,%u,%d,%d", (unsigned)rec->ticks,
+                     rec->event, rec->arg);
+    }
+    cliSerialPrint("evtrace,done");
+
+    if (running) eventTraceStart();
+  }
+  else {
+    cliSerialPrint("%s: Invalid argument \"%s\"", argv[0],
+                   argv[1] ? argv[1] : "");
+    return -1;
+  }
+  return 0;
+}
+#endif
+
 extern int _end;
 extern int _heap_end;
 extern unsigned char *heap;
@@ -891,6 +1435,26 @@ int cliMemoryInfo(const char ** argv)
   cliSerialPrint("\tused  %d bytes", (int)(heap - (unsigned char *)&_end));
   cliSerialPrint("\tfree  %d bytes", (int)((unsigned char *)&_heap_end - heap));
 
+  cliSerialPrint("\nUsage:");
+  cliSerialPrint("\tfree     %u bytes", availableMemory());
+  cliSerialPrint("\tmin free %u bytes", minAvailableMemory());
+  cliSerialPrint("\tlargest  %u bytes", largestFreeMemoryBlock());
+#if defined(LIBOPENUI)
+#if !defined(SIMU)
+  cliSerialPrint("\tLVGL     %u bytes", lvglMemoryUsage);
+#endif
+  cliSerialPrint("\tbitmaps  %u bytes", bitmapCacheUsage());
+#endif
+#if defined(LVGL_BIN_ALLOCATOR)
+  cliSerialPrint("\nLVGL slots:\tsize\tused\tmax\ttotal");
+  cliSerialPrint("\t\t%u\t%u\t%u\t%u", lvglSlots1.slotSize(), lvglSlots1.size(),
+                 lvglSlots1.highWater(), lvglSlots1.capacity());
+  cliSerialPrint("\t\t%u\t%u\t%u\t%u", lvglSlots2.slotSize(), lvglSlots2.size(),
+                 lvglSlots2.highWater(), lvglSlots2.capacity());
+  cliSerialPrint("\t\t%u\t%u\t%u\t%u", lvglSlots3.slotSize(), lvglSlots3.size(),
+                 lvglSlots3.highWater(), lvglSlots3.capacity());
+#endif
+
 #if defined(LUA)
   cliSerialPrint("\nLua:");
   uint32_t s = luaGetMemUsed(lsScripts);
@@ -902,6 +1466,13 @@ int cliMemoryInfo(const char ** argv)
   cliSerialPrint("\tExtra   %u", e);
   cliSerialPrint("------------");
   cliSerialPrint("\tTotal   %u", s + w + e);
+#endif
+  cliSerialPrint("\nLua GC:\tsteps\tcycles\tfreed\tlast us\tmax us");
+  cliSerialPrint("\tScripts\t%u\t%u\t%u\t%u\t%u", luaScriptsGcStats.steps, luaScriptsGcStats.cycles,
+                 luaScriptsGcStats.freed, luaScriptsGcStats.lastPauseUs, luaScriptsGcStats.maxPauseUs);
+#if defined(COLORLCD)
+  cliSerialPrint("\tWidgets\t%u\t%u\t%u\t%u\t%u", luaWidgetsGcStats.steps, luaWidgetsGcStats.cycles,
+                 luaWidgetsGcStats.freed, luaWidgetsGcStats.lastPauseUs, luaWidgetsGcStats.maxPauseUs);
 #endif
 #endif
   return 0;
@@ -1038,17 +1609,68 @@ int cliSet(const char **argv)
 #if defined(ENABLE_SERIAL_PASSTHROUGH)
 static etx_module_state_t *spInternalModuleState = nullptr;
 
+// USB -> module: filled from the USB IRQ, sent by DMA in chunks from
+// two buffers (one is filled while the other one is sent)
+#define SP_TX_FIFO_SIZE  2048
+#define SP_TX_CHUNK_SIZE 256
+
+static Fifo<uint8_t, SP_TX_FIFO_SIZE> spTxFifo;
+static uint8_t spTxBuffers[2][SP_TX_CHUNK_SIZE] __DMA;
+static uint8_t spTxCurrent;
+static uint32_t spTxPending;
+static uint32_t spTxOverruns;
+
 static void spInternalModuleTx(uint8_t* buf, uint32_t len)
 {
-  auto drv = modulePortGetSerialDrv(spInternalModuleState->tx);
-  auto ctx = modulePortGetCtx(spInternalModuleState->tx);
-
   while (len > 0) {
-    drv->sendByte(ctx, *(buf++));
+    if (spTxFifo.isFull()) {
+      spTxOverruns += len;
+      return;
+    }
+    spTxFifo.push(*(buf++));
     len--;
   }
 }
 
+static uint32_t spFillTxBuffer(uint8_t* buf, uint32_t len)
+{
+  while (len < SP_TX_CHUNK_SIZE && spTxFifo.pop(buf[len])) len++;
+  return len;
+}
+
+static void spSendToModule(const etx_serial_driver_t* drv, void* ctx)
+{
+  auto next = spTxBuffers[spTxCurrent];
+  spTxPending = spFillTxBuffer(next, spTxPending);
+  if (!spTxPending || !drv->txCompleted(ctx)) return;
+
+  drv->sendBuffer(ctx, next, spTxPending);
+  spTxCurrent ^= 1;
+  spTxPending = 0;
+}
+
+// module -> USB: whole spans of the RX buffer, as much as the USB FIFO takes
+static void spSendToUSB(const etx_serial_driver_t* drv, void* ctx)
+{
+  if (!drv->getRxSpan) {
+    uint8_t data;
+    while (usbSerialFreeSpace() && drv->getByte(ctx, &data) > 0) {
+      cliSerialPutc(data);
+    }
+    return;
+  }
+
+  const uint8_t* data;
+  uint32_t len;
+  while ((len = drv->getRxSpan(ctx, &data)) > 0) {
+    uint32_t room = usbSerialFreeSpace();
+    if (!room) return;
+    if (len > room) len = room;
+    usbSerialPutBuf(nullptr, data, len);
+    drv->consumeRx(ctx, len);
+  }
+}
+
 static const etx_serial_init spIntmoduleSerialInitParams = {
   .baudrate = 0,
   .encoding = ETX_Encoding_8N1,
@@ -1059,6 +1681,7 @@ static const etx_serial_init spIntmoduleSerialInitParams = {
 // TODO: use proper method instead
 extern bool cdcConnected;
 extern uint32_t usbSerialBaudRate(void*);
+extern void usbSerialPutBuf(void*, const uint8_t* data, uint32_t size);
 
 int cliSerialPassthrough(const char **argv)
 {
@@ -1122,6 +1745,11 @@ int cliSerialPassthrough(const char **argv)
       auto drv = modulePortGetSerialDrv(spInternalModuleState->rx);
       auto ctx = modulePortGetCtx(spInternalModuleState->rx);
 
+      spTxFifo.clear();
+      spTxCurrent = 0;
+      spTxPending = 0;
+      spTxOverruns = 0;
+
       // backup and swap CLI input
       auto backupCB = cliReceiveCallBack;
       cliReceiveCallBack = spInternalModuleTx;
@@ -1129,28 +1757,25 @@ int cliSerialPassthrough(const char **argv)
       // loop until cable disconnected
       while (cdcConnected) {
 
+        // follow the line coding of the host, once the data in flight is sent
         uint32_t cli_br = cliGetBaudRate();
-        if (cli_br && (cli_br != (uint32_t)baudrate)) {
+        if (cli_br && (cli_br != (uint32_t)baudrate) && spTxFifo.isEmpty() &&
+            !spTxPending && drv->txCompleted(ctx)) {
           baudrate = cli_br;
           drv->setBaudrate(ctx, baudrate);
         }
 
-        uint8_t data;
-        if (drv->getByte(ctx, &data) > 0) {
-
-          uint8_t timeout = 10; // 10 ms
-          while(!usbSerialFreeSpace() && (timeout > 0)) {
-            delay_ms(1);
-            timeout--;
-          }
-
-          cliSerialPutc(data);
-        }
+        spSendToModule(drv, ctx);
+        spSendToUSB(drv, ctx);
 
         // keep us up & running
         WDG_RESET();
       }
 
+      if (spTxOverruns) {
+        TRACE("serialpassthrough: %u bytes lost", spTxOverruns);
+      }
+
       // restore callsbacks
       cliReceiveCallBack = backupCB;
 
@@ -1304,6 +1929,40 @@ int cliDisplay(const char ** argv)
       cliSerialPrint("outputs[%d] = %04d", i, (int)channelOutputs[i]);
     }
   }
+  else if (!strcmp(argv[1], "frames")) {
+    for (uint8_t module = 0; module < NUM_MODULES; module++) {
+      ModuleTimingStats stats;
+      moduleTimingGetStats(module, stats);
+      cliSerialPrint("module[%d] frames: %u, late: %u, dropped: %u, max: %uus",
+                     module, stats.frames, stats.late, stats.dropped,
+                     stats.maxSent);
+      ModuleFrameTiming frame;
+      for (uint8_t i = 0; moduleTimingGetFrame(module, i, frame); i++) {
+        cliSerialPrint("  -%d: start %uus, sent %uus, latency %uus", i,
+                       frame.start, frame.sent, frame.latency);
+      }
+    }
+  }
+  else if (!strcmp(argv[1], "latency")) {
+    // stick sampling to frame sent, over the recent frames
+    MixerStageStats stats;
+    if (adcGetSticksAge()) {
+      mixerProfilerGetStats(MIXER_STAGE_STICKS_AGE, stats);
+      cliSerialPrint("sticks age: p50 %uus, p99 %uus, max %uus", stats.p50,
+                     stats.p99, stats.max);
+    }
+    for (uint8_t module = 0; module < NUM_MODULES; module++) {
+      mixerProfilerGetStats(MIXER_STAGE_LATENCY_INT + module, stats);
+      cliSerialPrint("module[%d] latency: p50 %uus, p99 %uus, max %uus, period %uus",
+                     module, stats.p50, stats.p99, stats.max,
+                     mixerSchedulerGetPeriod(module));
+#if defined(CROSSFIRE)
+      if (isModuleCrossfire(module) && TELEMETRY_STREAMING()) {
+        cliSerialPrint("  link quality: %d%%", TELEMETRY_RSSI());
+      }
+#endif
+    }
+  }
   else if (!strcmp(argv[1], "rtc")) {
     struct gtm utm;
     gettime(&utm);
@@ -1383,6 +2042,13 @@ int cliDisplay(const char ** argv)
     DiskCacheStats stats = diskCache.getStats();
     uint32_t hitRate = diskCache.getHitRate();
     cliSerialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
+    for (int i = 0; i < DISK_CACHE_SEGMENTS; i++) {
+      const DiskCacheSegmentStats& seg = stats.segments[i];
+      cliSerialPrint("  %s: h: %u(%0.1f%%), m: %u",
+                     i == DISK_CACHE_HOT ? "hot" : "stream", seg.noHits,
+                     diskCache.getHitRate((DiskCacheSegment)i) * 0.1f,
+                     seg.noMisses);
+    }
   }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
@@ -1619,6 +2285,8 @@ const CliCommand cliCommands[] = {
   { "read", cliRead, "<filename>" },
   { "readsd", cliReadSD, "<start sector> <sectors count> <read buffer size (sectors)>" },
   { "testsd", cliTestSD, "" },
+  { "bench", cliBench, "[mixer [<budget us>] | expo | crc | yaml | lcd | lua | sd]" },
+  { "usbjoystick", cliUsbJoystick, "" },
   { "play", cliPlay, "<filename>" },
   { "reboot", cliReboot, "[wdt]" },
   { "set", cliSet, "<what> <value>" },
@@ -1629,6 +2297,10 @@ const CliCommand cliCommands[] = {
   { "print", cliDisplay, "<address> [<size>] | <what>" },
   { "p", cliDisplay, "<address> [<size>] | <what>" },
   { "stackinfo", cliStackInfo, "" },
+  { "taskload", cliTaskLoad, "[history]" },
+#if defined(DEBUG_EVENT_TRACE)
+  { "evtrace", cliEventTrace, "start | stop | dump" },
+#endif
   { "meminfo", cliMemoryInfo, "" },
   { "test", cliTest, "new | graphics | memspd" },
   { "trace", cliTrace, "on | off" },
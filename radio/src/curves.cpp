@@ -233,12 +233,41 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
    The tangents are computed via the 'cubic monotone' rules (allowing for local-maxima)
 */
+
+// Tangents of smooth curves only depend on the curve points, so they
+// are computed once per model revision instead of twice per evaluation.
+// Each curve has its own table: concurrent refills (mixer and UI) of the
+// same curve write identical values.
+static int32_t smoothCurveTangents[MAX_CURVES][MAX_POINTS_PER_CURVE];
+static uint16_t smoothCurveRevision[MAX_CURVES];
+static bool smoothCurveValid[MAX_CURVES];
+
+static const int32_t * getSmoothCurveTangents(uint8_t idx)
+{
+  if (smoothCurveValid[idx] && smoothCurveRevision[idx] == modelDataRevision)
+    return smoothCurveTangents[idx];
+
+  smoothCurveValid[idx] = false;
+  CurveHeader &crv = g_model.curves[idx];
+  int8_t *points = curveAddress(idx);
+  uint8_t count = STD_CURVE_POINTS(crv.points);
+  if (count > MAX_POINTS_PER_CURVE)
+    return nullptr;
+  for (int i = 0; i < count; i++) {
+    smoothCurveTangents[idx][i] = compute_tangent(&crv, points, i);
+  }
+  smoothCurveRevision[idx] = modelDataRevision;
+  smoothCurveValid[idx] = true;
+  return smoothCurveTangents[idx];
+}
+
 int16_t hermite_spline(int16_t x, uint8_t idx)
 {
   CurveHeader &crv = g_model.curves[idx];
   int8_t *points = curveAddress(idx);
   uint8_t count = STD_CURVE_POINTS(crv.points);
   bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+  const int32_t * tangents = getSmoothCurveTangents(idx);
 
   if (x < -RESX)
     x = -RESX;
@@ -259,8 +288,8 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
     if (x >= p0x && x <= p3x) {
       int32_t p0y = calc100toRESX(points[i]);
       int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
+      int32_t m0 = tangents ? tangents[i] : compute_tangent(&crv, points, i);
+      int32_t m3 = tangents ? tangents[i+1] : compute_tangent(&crv, points, i+1);
       int32_t y;
       int32_t h = p3x - p0x;
       int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
@@ -316,27 +345,34 @@ int intpol(int x, uint8_t idx) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
   return erg / 25; // 100*D5/RESX;
 }
 
-int applyCurve(int x, CurveRef & curve)
+int getCurveRefParam(const CurveRef & curve, uint8_t fm)
 {
   switch (curve.type) {
+    case CURVE_REF_DIFF:
+    case CURVE_REF_EXPO:
+      return GET_GVAR_PREC1(curve.value, -100, 100, fm);
+  }
+
+  return curve.value;
+}
+
+int applyCurveRef(int x, uint8_t type, int param)
+{
+  switch (type) {
     case CURVE_REF_DIFF:
     {
-      int curveParam = GET_GVAR_PREC1(curve.value, -100, 100, mixerCurrentFlightMode);
-      if (curveParam > 0 && x < 0)
-        x = (x * (1000 - curveParam)) / 1000;
-      else if (curveParam < 0 && x > 0)
-        x = (x * (1000 + curveParam)) / 1000;
+      if (param > 0 && x < 0)
+        x = (x * (1000 - param)) / 1000;
+      else if (param < 0 && x > 0)
+        x = (x * (1000 + param)) / 1000;
       return x;
     }
 
     case CURVE_REF_EXPO:
-    {
-      int curveParam = GET_GVAR_PREC1(curve.value, -100, 100, mixerCurrentFlightMode) / 10;
-      return expo(x, curveParam);
-    }
+      return expo(x, param / 10);
 
     case CURVE_REF_FUNC:
-      switch (curve.value) {
+      switch (param) {
         case CURVE_X_GT0:
           if (x < 0) x = 0; //x|x>0
           return x;
@@ -356,13 +392,12 @@ int applyCurve(int x, CurveRef & curve)
 
     case CURVE_REF_CUSTOM:
     {
-      int curveParam = curve.value;
-      if (curveParam < 0) {
+      if (param < 0) {
         x = -x;
-        curveParam = -curveParam;
+        param = -param;
       }
-      if (curveParam > 0 && curveParam <= MAX_CURVES) {
-        return applyCustomCurve(x, curveParam - 1);
+      if (param > 0 && param <= MAX_CURVES) {
+        return applyCustomCurve(x, param - 1);
       }
       break;
     }
@@ -371,6 +406,12 @@ int applyCurve(int x, CurveRef & curve)
   return x;
 }
 
+int applyCurve(int x, CurveRef & curve)
+{
+  return applyCurveRef(x, curve.type,
+                       getCurveRefParam(curve, mixerCurrentFlightMode));
+}
+
 int applyCustomCurve(int x, uint8_t idx)
 {
   if (idx >= MAX_CURVES)
@@ -45,6 +45,11 @@ point_t getPoint(uint8_t i);
 point_t getPoint(uint8_t curveIndex, uint8_t index);
 int applyCustomCurve(int x, uint8_t idx);
 int applyCurve(int x, CurveRef & curve);
+
+// GVar-resolved parameter of a curve reference for the given flight mode
+int getCurveRefParam(const CurveRef & curve, uint8_t fm);
+// apply a curve reference whose parameter is already resolved
+int applyCurveRef(int x, uint8_t type, int param);
 int applyCurrentCurve(int x);
 
 char *getCurveRefString(char *dest, size_t len, const CurveRef& curve);
@@ -243,6 +243,7 @@ enum UartModes {
   UART_MODE_DEBUG,
   UART_MODE_SPACEMOUSE,
   UART_MODE_EXT_MODULE,
+  UART_MODE_TELEMETRY_STREAM,
   UART_MODE_COUNT SKIP,
   UART_MODE_MAX SKIP = UART_MODE_COUNT-1
 };
@@ -646,6 +647,17 @@ enum AdjustGvarFunctionParam {
   FUNC_ADJUST_GVAR_INCDEC,
 };
 
+// Logs function profile: fields left out of the log, and whether lines
+// are only written when a value changed
+enum LogsFunctionProfile {
+  FUNC_LOGS_NO_STICKS = 0x01,
+  FUNC_LOGS_NO_POTS = 0x02,
+  FUNC_LOGS_NO_SWITCHES = 0x04,
+  FUNC_LOGS_NO_LOGICAL_SWITCHES = 0x08,
+  FUNC_LOGS_NO_CHANNELS = 0x10,
+  FUNC_LOGS_ON_CHANGE = 0x80,
+};
+
 enum BluetoothModes {
   BLUETOOTH_OFF,
   BLUETOOTH_TELEMETRY,
@@ -664,6 +676,15 @@ enum UartSampleModes {
   UART_SAMPLE_MODE_MAX SKIP = UART_SAMPLE_MODE_ONEBIT
 };
 
+// Filter applied to the main sticks when the ADC filter is enabled
+enum StickFilterTypes {
+  STICK_FILTER_JITTER = 0,
+  STICK_FILTER_ONE_EURO,
+  STICK_FILTER_BIQUAD,
+
+  STICK_FILTER_MAX SKIP = STICK_FILTER_BIQUAD
+};
+
 // PXX2 constants
 #define PXX2_LEN_REGISTRATION_ID            8
 #define PXX2_LEN_RX_NAME                    8
@@ -976,6 +976,9 @@ PACK(struct RadioData {
   uint8_t modelCustomScriptsDisabled:1;
   uint8_t modelTelemetryDisabled:1;
 
+  NOBACKUP(uint8_t  stickFilter:2 ENUM(StickFilterTypes));
+  NOBACKUP(uint8_t  stickFilterCutoff:3);
+
   NOBACKUP(uint8_t getBrightness() const
   {
 #if defined(OLED_SCREEN)
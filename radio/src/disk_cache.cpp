@@ -55,6 +55,9 @@ public:
   void free();
   bool empty() const;
 
+  // value of the cache use counter when the block was last read
+  uint32_t lastUse;
+
 private:
   uint8_t data[DISK_CACHE_BLOCK_SIZE];
   DWORD startSector;
@@ -62,6 +65,7 @@ private:
 };
 
 DiskCacheBlock::DiskCacheBlock():
+  lastUse(0),
   startSector(0),
   endSector(0) 
 {
@@ -81,6 +85,7 @@ DRESULT DiskCacheBlock::fill(BYTE drv, BYTE * buff, DWORD sector, UINT count)
 {
   DRESULT res = __disk_read(drv, data, sector, DISK_CACHE_BLOCK_SECTORS);
   if (res != RES_OK) {
+    endSector = 0;
     return res;
   }
   startSector = sector;
@@ -108,34 +113,51 @@ bool DiskCacheBlock::empty() const
   return (endSector == 0);
 }
 
+static inline DiskCacheSegment blockSegment(int n)
+{
+  return n < DISK_CACHE_HOT_BLOCKS ? DISK_CACHE_HOT : DISK_CACHE_STREAM;
+}
+
 DiskCache::DiskCache():
-  lastBlock(0)
+  useCounter(0),
+  lastReadEnd(0)
 {
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
+  memset(&stats, 0, sizeof(stats));
   blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
 }
 
 void DiskCache::clear()
 {
-  lastBlock = 0;
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
+  useCounter = 0;
+  lastReadEnd = 0;
+  memset(&stats, 0, sizeof(stats));
   for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
     blocks[n].free();
+    blocks[n].lastUse = 0;
   }
 }
 
-DRESULT DiskCache::read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
+// Returns a free block of the segment, or the least recently used one
+DiskCacheBlock * DiskCache::getBlock(DiskCacheSegment segment)
 {
-  // TODO: check if not caching first sectors would improve anything
-  // if (sector < 1000) {
-  //   ++stats.noMisses;
-  //   return __disk_read(drv, buff, sector, count);  
-  // }
+  int first = (segment == DISK_CACHE_HOT) ? 0 : DISK_CACHE_HOT_BLOCKS;
+  int last = (segment == DISK_CACHE_HOT) ? DISK_CACHE_HOT_BLOCKS : DISK_CACHE_BLOCKS_NUM;
+
+  DiskCacheBlock * lru = &blocks[first];
+  for (int n = first; n < last; ++n) {
+    if (blocks[n].empty()) {
+      TRACE_DISK_CACHE("\t\t using free block");
+      return &blocks[n];
+    }
+    if ((int32_t)(blocks[n].lastUse - lru->lastUse) < 0) {
+      lru = &blocks[n];
+    }
+  }
+  return lru;
+}
 
+DRESULT DiskCache::read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
+{
   // if read is bigger than cache block, then read it directly without using cache
   if (count > DISK_CACHE_BLOCK_SECTORS) {
     TRACE_DISK_CACHE("\t\t big read(%u, %u)",  (uint32_t)sector, (uint32_t)count);
@@ -148,30 +170,28 @@ DRESULT DiskCache::read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
     return __disk_read(drv, buff, sector, count);
   }
 
+  // a read continuing the previous one or spanning several sectors is
+  // file data being streamed, anything else goes to the hot segment
+  DiskCacheSegment segment =
+      (sector == lastReadEnd || count > 1) ? DISK_CACHE_STREAM : DISK_CACHE_HOT;
+  lastReadEnd = sector + count;
+  ++useCounter;
+
   for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
     if (blocks[n].read(buff, sector, count)) {
+      blocks[n].lastUse = useCounter;
       ++stats.noHits;
+      ++stats.segments[blockSegment(n)].noHits;
       return RES_OK;
     }
   }
 
   ++stats.noMisses;
+  ++stats.segments[segment].noMisses;
 
-  // find free block
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].empty()) {
-      TRACE_DISK_CACHE("\t\t using free block");
-      return blocks[n].fill(drv, buff, sector, count);
-    }
-  }
-
-  // use next block (round robin)
-  // TODO: use better strategy to select which used block gets used here
-  if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) {
-    lastBlock = 0;
-  }
-  
-  return blocks[lastBlock].fill(drv, buff, sector, count);
+  DiskCacheBlock * block = getBlock(segment);
+  block->lastUse = useCounter;
+  return block->fill(drv, buff, sector, count);
 }
 
 DRESULT DiskCache::write(BYTE drv, const BYTE* buff, DWORD sector, UINT count)
@@ -188,11 +208,21 @@ const DiskCacheStats & DiskCache::getStats() const
   return stats; 
 }
 
-int DiskCache::getHitRate() const
+static int hitRate(uint32_t hits, uint32_t misses)
 {
-  uint32_t all = stats.noHits + stats.noMisses;
+  uint32_t all = hits + misses;
   if (all == 0) return 0;
-  return (stats.noHits * 1000) / all;
+  return (hits * 1000) / all;
+}
+
+int DiskCache::getHitRate() const
+{
+  return hitRate(stats.noHits, stats.noMisses);
+}
+
+int DiskCache::getHitRate(DiskCacheSegment segment) const
+{
+  return hitRate(stats.segments[segment].noHits, stats.segments[segment].noMisses);
 }
 
 DRESULT disk_read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
@@ -27,12 +27,28 @@
 // tunable parameters
 #define DISK_CACHE_BLOCKS_NUM      32   // no cache blocks
 #define DISK_CACHE_BLOCK_SECTORS   16   // no sectors
+#define DISK_CACHE_HOT_BLOCKS      8    // no cache blocks reserved for FAT / directory sectors
+
+// Blocks are split in two segments, so that streaming reads (WAV,
+// bitmaps, logs) cannot evict the FAT and directory sectors
+enum DiskCacheSegment {
+  DISK_CACHE_HOT = 0,  // random single sector reads
+  DISK_CACHE_STREAM,   // sequential and multi sector reads
+  DISK_CACHE_SEGMENTS
+};
+
+struct DiskCacheSegmentStats
+{
+  uint32_t noHits;
+  uint32_t noMisses;
+};
 
 struct DiskCacheStats
 {
   uint32_t noHits;
   uint32_t noMisses;
   uint32_t noWrites;
+  DiskCacheSegmentStats segments[DISK_CACHE_SEGMENTS];
 };
 
 class DiskCacheBlock;
@@ -49,11 +65,15 @@ class DiskCache
 
     const DiskCacheStats & getStats() const;
     int getHitRate() const;
+    int getHitRate(DiskCacheSegment segment) const;
 
   private:
     DiskCacheStats stats;
-    uint32_t lastBlock;
+    uint32_t useCounter;
+    DWORD lastReadEnd;
     DiskCacheBlock * blocks;
+
+    DiskCacheBlock * getBlock(DiskCacheSegment segment);
 };
 
 extern DiskCache diskCache;
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "event_trace.h"
+
+#if defined(DEBUG_SEGGER_RTT)
+#include "thirdparty/Segger_RTT/RTT/SEGGER_RTT.h"
+#endif
+
+static_assert((EVENT_TRACE_LEN & (EVENT_TRACE_LEN - 1)) == 0,
+              "EVENT_TRACE_LEN must be a power of 2");
+
+volatile bool eventTraceRunning = false;
+
+static EventTraceRecord eventTraceBuffer[EVENT_TRACE_LEN];
+static uint32_t eventTraceHead = 0;  // total records written
+
+#if defined(DEBUG_SEGGER_RTT)
+static uint8_t eventTraceRttBuffer[1024];
+static bool eventTraceRttConfigured = false;
+#endif
+
+static const char * const eventTraceNames[EVENT_TRACE_COUNT] = {
+  "",
+  "task",
+  "mixer_begin",
+  "mixer_end",
+  "pulses_tx",
+  "telemetry_rx",
+  "sd_read_begin",
+  "sd_read_end",
+  "sd_write_begin",
+  "sd_write_end",
+  "lua_begin",
+  "lua_end",
+};
+
+void eventTraceRecord(uint16_t event, uint16_t arg)
+{
+  uint32_t prim = __get_PRIMASK();
+  __disable_irq();
+
+  auto & rec = eventTraceBuffer[eventTraceHead & (EVENT_TRACE_LEN - 1)];
+  rec.ticks = ticksNow();
+  rec.event = event;
+  rec.arg = arg;
+  eventTraceHead++;
+
+#if defined(DEBUG_SEGGER_RTT)
+  // non blocking: records are dropped when the probe is late
+  SEGGER_RTT_WriteNoLock(EVENT_TRACE_RTT_CHANNEL, &rec, sizeof(rec));
+#endif
+
+  if (!prim) __enable_irq();
+}
+
+void eventTraceStart()
+{
+#if defined(DEBUG_SEGGER_RTT)
+  if (!eventTraceRttConfigured) {
+    eventTraceRttConfigured = true;
+    SEGGER_RTT_ConfigUpBuffer(EVENT_TRACE_RTT_CHANNEL, "evtrace",
+                              eventTraceRttBuffer, sizeof(eventTraceRttBuffer),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+  }
+#endif
+
+  eventTraceHead = 0;
+  eventTraceRunning = true;
+}
+
+void eventTraceStop()
+{
+  eventTraceRunning = false;
+}
+
+uint16_t eventTraceCount()
+{
+  return min<uint32_t>(eventTraceHead, EVENT_TRACE_LEN);
+}
+
+const EventTraceRecord * eventTraceGet(uint16_t idx)
+{
+  if (idx >= eventTraceCount()) return nullptr;
+  uint32_t first = eventTraceHead - eventTraceCount();
+  return &eventTraceBuffer[(first + idx) & (EVENT_TRACE_LEN - 1)];
+}
+
+const char * eventTraceName(uint16_t event)
+{
+  return event < EVENT_TRACE_COUNT ? eventTraceNames[event] : "?";
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Timestamped trace of the hot path events (task switches, mixer,
+// pulses, telemetry, SD, Lua) into a RAM ring buffer.
+//
+// Records are dumped over the CLI ("evtrace dump") and, with
+// DEBUG_SEGGER_RTT, streamed over the RTT up buffer 1 as they
+// are recorded. tools/trace2perfetto.py converts both into
+// the Chrome trace format (Perfetto / chrome://tracing).
+
+// Must be a power of 2
+#define EVENT_TRACE_LEN         512
+
+#define EVENT_TRACE_RTT_CHANNEL 1
+
+enum EventTraceId {
+  EVENT_TRACE_TASK_SWITCH = 1, // arg: task index
+  EVENT_TRACE_MIXER_BEGIN,     // arg: due modules
+  EVENT_TRACE_MIXER_END,
+  EVENT_TRACE_PULSES_TX,       // arg: module
+  EVENT_TRACE_TELEMETRY_RX,
+  EVENT_TRACE_SD_READ_BEGIN,   // arg: sectors
+  EVENT_TRACE_SD_READ_END,
+  EVENT_TRACE_SD_WRITE_BEGIN,  // arg: sectors
+  EVENT_TRACE_SD_WRITE_END,
+  EVENT_TRACE_LUA_BEGIN,
+  EVENT_TRACE_LUA_END,
+  EVENT_TRACE_COUNT
+};
+
+struct EventTraceRecord {
+  uint32_t ticks;  // CPU cycles (SYSTEM_TICKS_1US per us)
+  uint16_t event;
+  uint16_t arg;
+};
+
+#if defined(DEBUG_EVENT_TRACE) && !defined(SIMU)
+
+extern volatile bool eventTraceRunning;
+
+// Safe from interrupts and from the RTOS switch hook
+void eventTraceRecord(uint16_t event, uint16_t arg);
+
+#define EVENT_TRACE(event, arg)                               \
+  do {                                                        \
+    if (eventTraceRunning) eventTraceRecord(event, arg);      \
+  } while (0)
+
+// Records 'begin' now and 'end' when leaving the scope
+struct EventTraceScope {
+  EventTraceScope(uint16_t begin, uint16_t end, uint16_t arg) : end(end)
+  {
+    EVENT_TRACE(begin, arg);
+  }
+
+  ~EventTraceScope()
+  {
+    EVENT_TRACE(end, 0);
+  }
+
+  uint16_t end;
+};
+
+#define EVENT_TRACE_SCOPE(begin, end, arg) \
+  EventTraceScope _eventTraceScope(begin, end, arg)
+
+void eventTraceStart();
+void eventTraceStop();
+
+// Recorded events, oldest first (only stable while stopped)
+uint16_t eventTraceCount();
+const EventTraceRecord * eventTraceGet(uint16_t idx);
+const char * eventTraceName(uint16_t event);
+
+#else
+
+#define EVENT_TRACE(event, arg)
+#define EVENT_TRACE_SCOPE(begin, end, arg)
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "ext_input.h"
+
+#include <atomic>
+#include <string.h>
+
+struct ExtInputPacket {
+  uint32_t timestamp;
+  int16_t values[EXT_INPUT_MAX_CHANNELS];
+};
+
+struct ExtInputState {
+  const ExtInputDriver* drv;
+
+  // written by the source, see mixerPublishOutputs() for the scheme:
+  // the source writes the packet the mixer is not pointing to and
+  // publishes it by incrementing the sequence (0 means none yet)
+  ExtInputPacket packets[2];
+  std::atomic<uint32_t> seq;
+
+  // owned by the mixer
+  ExtInputPacket sample;
+  uint32_t age;
+};
+
+static ExtInputState extInputs[EXT_INPUT_SOURCES];
+
+void extInputRegister(uint8_t source, const ExtInputDriver* drv)
+{
+  if (source >= EXT_INPUT_SOURCES) return;
+
+  auto& st = extInputs[source];
+  st.drv = nullptr;
+  st.seq.store(0, std::memory_order_relaxed);
+  st.age = EXT_INPUT_NO_DATA;
+  memset(&st.sample, 0, sizeof(st.sample));
+  st.drv = drv;
+}
+
+void extInputUnregister(uint8_t source)
+{
+  extInputRegister(source, nullptr);
+}
+
+void extInputPush(uint8_t source, const int16_t* values, uint8_t count,
+                  uint32_t timestamp)
+{
+  if (source >= EXT_INPUT_SOURCES) return;
+
+  auto& st = extInputs[source];
+  if (!st.drv) return;
+
+  uint32_t seq = st.seq.load(std::memory_order_relaxed);
+  ExtInputPacket& packet = st.packets[(seq + 1) & 1];
+
+  if (count > st.drv->channels) count = st.drv->channels;
+  if (count > EXT_INPUT_MAX_CHANNELS) count = EXT_INPUT_MAX_CHANNELS;
+
+  std::atomic_thread_fence(std::memory_order_release);
+  packet.timestamp = timestamp;
+  memcpy(packet.values, values, count * sizeof(int16_t));
+  memset(packet.values + count, 0,
+         (EXT_INPUT_MAX_CHANNELS - count) * sizeof(int16_t));
+  st.seq.store(seq + 1, std::memory_order_release);
+}
+
+void extInputSample(uint32_t now)
+{
+  for (auto& st : extInputs) {
+    auto drv = st.drv;
+    if (!drv) continue;
+
+    if (drv->poll) drv->poll();
+
+    uint32_t seq;
+    do {
+      seq = st.seq.load(std::memory_order_acquire);
+      if (!seq) break;
+      memcpy(&st.sample, &st.packets[seq & 1], sizeof(ExtInputPacket));
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while (st.seq.load(std::memory_order_relaxed) != seq);
+
+    if (!seq) {
+      st.age = EXT_INPUT_NO_DATA;
+      continue;
+    }
+
+    // a packet pushed after 'now' was taken is not older than 0
+    int32_t age = (int32_t)(now - st.sample.timestamp);
+    st.age = age > 0 ? age : 0;
+  }
+}
+
+int16_t extInputGetValue(uint8_t source, uint8_t channel)
+{
+  if (source >= EXT_INPUT_SOURCES || channel >= EXT_INPUT_MAX_CHANNELS ||
+      extInputIsStale(source)) {
+    return 0;
+  }
+
+  return extInputs[source].sample.values[channel];
+}
+
+uint32_t extInputGetAge(uint8_t source)
+{
+  if (source >= EXT_INPUT_SOURCES || !extInputs[source].drv)
+    return EXT_INPUT_NO_DATA;
+
+  return extInputs[source].age;
+}
+
+bool extInputIsStale(uint8_t source)
+{
+  return extInputGetAge(source) > EXT_INPUT_STALE_MS;
+}
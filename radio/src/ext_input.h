@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// External analog inputs (SpaceMouse, serial gimbals, ...), decoded from
+// packets received outside of the mixer.
+//
+// A source pushes each complete packet with the time it was received.
+// The mixer samples all sources once at the start of its cycle, so that
+// every mix of the cycle uses the same values, and knows how old they are.
+// Packets are double buffered: a packet pushed while the mixer samples
+// is used by the next cycle.
+
+enum ExtInputSource {
+  EXT_INPUT_SPACEMOUSE,
+  EXT_INPUT_SOURCES
+};
+
+#define EXT_INPUT_MAX_CHANNELS    8
+
+// values older than this are not used (0 is returned instead)
+#define EXT_INPUT_STALE_MS        100
+
+#define EXT_INPUT_NO_DATA         UINT32_MAX
+
+struct ExtInputDriver {
+  uint8_t channels;
+
+  // drain the pending data, called by the mixer right before sampling
+  void (*poll)();
+};
+
+void extInputRegister(uint8_t source, const ExtInputDriver* drv);
+void extInputUnregister(uint8_t source);
+
+// Called by the source for each complete packet (timestamp in ms)
+void extInputPush(uint8_t source, const int16_t* values, uint8_t count,
+                  uint32_t timestamp);
+
+// Called at the start of the mixer cycle
+void extInputSample(uint32_t now);
+
+// Values of the last sample, 0 when stale
+int16_t extInputGetValue(uint8_t source, uint8_t channel);
+
+// Age of the values of the last sample (ms), EXT_INPUT_NO_DATA if none
+uint32_t extInputGetAge(uint8_t source);
+
+bool extInputIsStale(uint8_t source);
@@ -23,6 +23,7 @@
 #define _FIFO_H_
 
 #include <inttypes.h>
+#include <atomic>
 
 template <class T, int N>
 class Fifo
@@ -55,6 +56,11 @@ class Fifo
       ridx = nextIndex(ridx);
     }
 
+    void skip(uint32_t count)
+    {
+      ridx = (ridx + count) & (N - 1);
+    }
+
     bool pop(T & element)
     {
       if (isEmpty()) {
@@ -104,6 +110,15 @@ class Fifo
       return fifo;
     }
 
+    // Next contiguous run of stored elements, in place
+    // (release them with skip(count))
+    uint32_t span(const T ** data) const
+    {
+      uint32_t w = widx;
+      *data = &fifo[ridx];
+      return (w >= ridx ? w : N) - ridx;
+    }
+
   protected:
     T fifo[N];
     volatile uint32_t widx;
@@ -115,4 +130,65 @@ class Fifo
     }
 };
 
+// Same ring with the element accesses ordered against the index updates, for
+// one producer and one consumer running in different tasks
+template <class T, int N>
+class SpscFifo
+{
+  static_assert((N > 1) & !(N & (N - 1)), "Fifo size must be a power of two!");
+
+  public:
+    SpscFifo():
+      widx(0),
+      ridx(0)
+    {
+    }
+
+    // not safe while the other side runs
+    void clear()
+    {
+      widx.store(0, std::memory_order_relaxed);
+      ridx.store(0, std::memory_order_relaxed);
+    }
+
+    bool push(const T & element)
+    {
+      uint32_t w = widx.load(std::memory_order_relaxed);
+      uint32_t next = (w + 1) & (N - 1);
+      if (next == ridx.load(std::memory_order_acquire)) {
+        return false;
+      }
+      fifo[w] = element;
+      widx.store(next, std::memory_order_release);
+      return true;
+    }
+
+    bool pop(T & element)
+    {
+      uint32_t r = ridx.load(std::memory_order_relaxed);
+      if (r == widx.load(std::memory_order_acquire)) {
+        return false;
+      }
+      element = fifo[r];
+      ridx.store((r + 1) & (N - 1), std::memory_order_release);
+      return true;
+    }
+
+    uint32_t size() const
+    {
+      return (N + widx.load(std::memory_order_acquire) -
+              ridx.load(std::memory_order_acquire)) & (N - 1);
+    }
+
+    uint32_t capacity() const
+    {
+      return N - 1;
+    }
+
+  protected:
+    T fifo[N];
+    std::atomic<uint32_t> widx;
+    std::atomic<uint32_t> ridx;
+};
+
 #endif // _FIFO_H_
@@ -129,6 +129,25 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
 #define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
 getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
 
+static void updateUsedFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+{
+  uint16_t revision = (functions == g_model.customFn ? modelDataRevision : generalDataRevision);
+  if (functionsContext.usedValid && functionsContext.usedRevision == revision)
+    return;
+
+  // functions without a switch are never evaluated
+  uint8_t count = 0;
+  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+    if (CFN_SWITCH(&functions[i])) {
+      functionsContext.usedFunctions[count++] = i;
+    }
+  }
+
+  functionsContext.usedCount = count;
+  functionsContext.usedRevision = revision;
+  functionsContext.usedValid = true;
+}
+
 void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
 {
   MASK_FUNC_TYPE newActiveFunctions  = 0;
@@ -149,7 +168,10 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
   }
 #endif
 
-  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+  updateUsedFunctions(functions, functionsContext);
+
+  for (uint8_t n=0; n<functionsContext.usedCount; n++) {
+    uint8_t i = functionsContext.usedFunctions[n];
     const CustomFunctionData * cfn = &functions[i];
     swsrc_t swtch = CFN_SWITCH(cfn);
     if (swtch) {
@@ -378,6 +400,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
               newActiveFunctions |= (1u << FUNCTION_LOGS);
               logDelay100ms = CFN_PARAM(
                   cfn);  // logging period is 0..25.5s in 100ms increments
+              logProfile = CFN_LOGS_PROFILE(cfn);
             }
             break;
 #endif
@@ -43,6 +43,7 @@
 gpsdata_t gpsData;
 
 /* This is a light implementation of a GPS frame decoding
+   (NMEA, used when the module does not support UBX, see below)
    This should work with most of modern GPS devices configured to output 5 frames.
    It assumes there are some NMEA GGA frames to decode on the serial bus
    Now verifies checksum correctly before applying data
@@ -308,8 +309,288 @@ bool gpsNewFrameNMEA(char c)
   return frameOK;
 }
 
+/* UBX binary protocol (u-blox modules)
+
+   The module is configured to send only NAV-PVT, at 10Hz and on a
+   faster baudrate. Modules which do not acknowledge the configuration
+   stay on NMEA.
+*/
+
+#define UBX_SYNC1             0xB5
+#define UBX_SYNC2             0x62
+
+#define UBX_CLASS_NAV         0x01
+#define UBX_CLASS_ACK         0x05
+#define UBX_CLASS_CFG         0x06
+
+#define UBX_NAV_PVT           0x07
+#define UBX_ACK_ACK           0x01
+#define UBX_CFG_PRT           0x00
+#define UBX_CFG_MSG           0x01
+#define UBX_CFG_RATE          0x08
+
+#define UBX_BAUDRATE          115200
+#define UBX_CONF_DELAY_MS     100   // the module applies CFG-PRT
+#define UBX_CONF_TIMEOUT_MS   500
+#define UBX_CONF_RETRIES      3
+#define UBX_LOST_TIMEOUT_MS   2000  // module reset to its defaults
+
+#define UBX_MAX_PAYLOAD       92
+
+PACK(struct ubxNavPvt {
+  uint32_t iTOW;
+  uint16_t year;
+  uint8_t month;
+  uint8_t day;
+  uint8_t hour;
+  uint8_t min;
+  uint8_t sec;
+  uint8_t valid;
+  uint32_t tAcc;
+  int32_t nano;
+  uint8_t fixType;
+  uint8_t flags;
+  uint8_t flags2;
+  uint8_t numSV;
+  int32_t lon;      // deg * 1e7
+  int32_t lat;      // deg * 1e7
+  int32_t height;   // mm
+  int32_t hMSL;     // mm
+  uint32_t hAcc;    // mm
+  uint32_t vAcc;    // mm
+  int32_t velN;     // mm/s
+  int32_t velE;     // mm/s
+  int32_t velD;     // mm/s
+  int32_t gSpeed;   // mm/s
+  int32_t headMot;  // deg * 1e5
+  uint32_t sAcc;    // mm/s
+  uint32_t headAcc;
+  uint16_t pDOP;    // 0.01
+  uint8_t reserved1[6];
+  int32_t headVeh;
+  int16_t magDec;
+  uint16_t magAcc;
+});
+
+static_assert(sizeof(ubxNavPvt) == UBX_MAX_PAYLOAD, "NAV-PVT size");
+
+#define UBX_PVT_VALID_DATE    0x01
+#define UBX_PVT_VALID_TIME    0x02
+#define UBX_PVT_GNSS_FIX_OK   0x01
+
+enum GpsConfState {
+  GPS_CONF_START,
+  GPS_CONF_BAUDRATE,
+  GPS_CONF_RATE,
+  GPS_CONF_WAIT_ACK,
+  GPS_CONF_UBX,
+  GPS_CONF_NMEA,
+};
+
+static uint8_t gpsConfState = GPS_CONF_START;
+static uint8_t gpsConfRetries = 0;
+static uint32_t gpsConfTime = 0;
+static uint32_t gpsUbxLastFrame = 0;
+
+// the payload is received in place, in the message structure
+static union {
+  ubxNavPvt navPvt;
+  uint8_t ack[2];
+  uint8_t raw[UBX_MAX_PAYLOAD];
+} ubxPayload;
+
+static uint16_t clampUINT16(uint32_t value)
+{
+  return value > UINT16_MAX ? UINT16_MAX : value;
+}
+
+static void ubxProcessNavPvt()
+{
+  const ubxNavPvt& pvt = ubxPayload.navPvt;
+  bool fix = (pvt.flags & UBX_PVT_GNSS_FIX_OK) && pvt.fixType >= 2 &&
+             pvt.fixType <= 4;
+
+  gpsData.fix = fix;
+  gpsData.numSat = pvt.numSV;
+  gpsData.hdop = pvt.pDOP;
+  gpsData.speed = clampUINT16(pvt.gSpeed / 100);
+  gpsData.groundCourse = pvt.headMot / 10000;
+  gpsData.verticalSpeed = -pvt.velD / 100;
+  gpsData.hAcc = clampUINT16(pvt.hAcc / 100);
+  gpsData.vAcc = clampUINT16(pvt.vAcc / 100);
+  gpsData.sAcc = clampUINT16(pvt.sAcc / 100);
+
+  if (fix) {
+    __disable_irq();    // do the atomic update of lat/lon
+    gpsData.latitude = pvt.lat / 10;
+    gpsData.longitude = pvt.lon / 10;
+    gpsData.altitude = pvt.hMSL > 0 ? pvt.hMSL / 1000 : 0;
+    __enable_irq();
+  }
+
+#if defined(RTCLOCK)
+  // set RTC clock if needed
+  if (g_eeGeneral.adjustRTC && fix &&
+      (pvt.valid & (UBX_PVT_VALID_DATE | UBX_PVT_VALID_TIME)) ==
+          (UBX_PVT_VALID_DATE | UBX_PVT_VALID_TIME)) {
+    rtcAdjust(pvt.year, pvt.month, pvt.day, pvt.hour, pvt.min, pvt.sec);
+  }
+#endif
+
+  gpsUbxLastFrame = RTOS_GET_MS();
+  gpsConfState = GPS_CONF_UBX;
+  gpsData.protocol = GPS_PROTOCOL_UBX;
+}
+
+static void ubxProcessAck()
+{
+  if (gpsConfState == GPS_CONF_WAIT_ACK && ubxPayload.ack[0] == UBX_CLASS_CFG &&
+      ubxPayload.ack[1] == UBX_CFG_MSG) {
+    gpsUbxLastFrame = RTOS_GET_MS();
+    gpsConfState = GPS_CONF_UBX;
+    gpsData.protocol = GPS_PROTOCOL_UBX;
+  }
+}
+
+struct UbxHandler {
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint16_t len;
+  void (*process)();
+};
+
+// messages decoded, all others are skipped
+static const UbxHandler ubxHandlers[] = {
+  { UBX_CLASS_NAV, UBX_NAV_PVT, sizeof(ubxNavPvt), ubxProcessNavPvt },
+  { UBX_CLASS_ACK, UBX_ACK_ACK, 2, ubxProcessAck },
+};
+
+static const UbxHandler* ubxFindHandler(uint8_t msgClass, uint8_t msgId,
+                                        uint16_t len)
+{
+  for (const auto& handler : ubxHandlers) {
+    if (handler.msgClass == msgClass && handler.msgId == msgId &&
+        handler.len == len)
+      return &handler;
+  }
+  return nullptr;
+}
+
+enum UbxParserState {
+  UBX_STATE_SYNC1,
+  UBX_STATE_SYNC2,
+  UBX_STATE_CLASS,
+  UBX_STATE_ID,
+  UBX_STATE_LEN1,
+  UBX_STATE_LEN2,
+  UBX_STATE_PAYLOAD,
+  UBX_STATE_CK_A,
+  UBX_STATE_CK_B,
+};
+
+static struct {
+  uint8_t state;
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint8_t ckA;
+  uint8_t ckB;
+  uint16_t len;
+  uint16_t offset;
+  const UbxHandler* handler;
+} ubxParser;
+
+static inline void ubxChecksum(uint8_t c)
+{
+  ubxParser.ckA += c;
+  ubxParser.ckB += ubxParser.ckA;
+}
+
+bool gpsNewFrameUBX(uint8_t c)
+{
+  switch (ubxParser.state) {
+    case UBX_STATE_SYNC1:
+      if (c == UBX_SYNC1)
+        ubxParser.state = UBX_STATE_SYNC2;
+      break;
+
+    case UBX_STATE_SYNC2:
+      if (c == UBX_SYNC2) {
+        ubxParser.ckA = ubxParser.ckB = 0;
+        ubxParser.state = UBX_STATE_CLASS;
+      }
+      else {
+        ubxParser.state = UBX_STATE_SYNC1;
+        return gpsNewFrameNMEA(c);
+      }
+      break;
+
+    case UBX_STATE_CLASS:
+      ubxChecksum(c);
+      ubxParser.msgClass = c;
+      ubxParser.state = UBX_STATE_ID;
+      break;
+
+    case UBX_STATE_ID:
+      ubxChecksum(c);
+      ubxParser.msgId = c;
+      ubxParser.state = UBX_STATE_LEN1;
+      break;
+
+    case UBX_STATE_LEN1:
+      ubxChecksum(c);
+      ubxParser.len = c;
+      ubxParser.state = UBX_STATE_LEN2;
+      break;
+
+    case UBX_STATE_LEN2:
+      ubxChecksum(c);
+      ubxParser.len |= c << 8;
+      ubxParser.offset = 0;
+      ubxParser.handler = ubxFindHandler(ubxParser.msgClass, ubxParser.msgId,
+                                         ubxParser.len);
+      ubxParser.state =
+          ubxParser.len > 0 ? UBX_STATE_PAYLOAD : UBX_STATE_CK_A;
+      break;
+
+    case UBX_STATE_PAYLOAD:
+      ubxChecksum(c);
+      if (ubxParser.handler) ubxPayload.raw[ubxParser.offset] = c;
+      if (++ubxParser.offset >= ubxParser.len)
+        ubxParser.state = UBX_STATE_CK_A;
+      break;
+
+    case UBX_STATE_CK_A:
+      if (c == ubxParser.ckA) {
+        ubxParser.state = UBX_STATE_CK_B;
+      }
+      else {
+        gpsData.errorCount++;
+        ubxParser.state = UBX_STATE_SYNC1;
+      }
+      break;
+
+    case UBX_STATE_CK_B:
+      ubxParser.state = UBX_STATE_SYNC1;
+      if (c != ubxParser.ckB) {
+        gpsData.errorCount++;
+        break;
+      }
+      gpsData.packetCount++;
+      if (ubxParser.handler) {
+        ubxParser.handler->process();
+        return true;
+      }
+      break;
+  }
+
+  return false;
+}
+
 bool gpsNewFrame(uint8_t c)
 {
+  // UBX frames can be received between NMEA sentences
+  if (ubxParser.state != UBX_STATE_SYNC1 || c == UBX_SYNC1)
+    return gpsNewFrameUBX(c);
   return gpsNewFrameNMEA(c);
 }
 
@@ -331,24 +612,166 @@ void gpsSetSerialDriver(void* ctx, const etx_serial_driver_t* drv)
 {
   gpsSerialCtx = ctx;
   gpsSerialDrv = drv;
+
+  ubxParser.state = UBX_STATE_SYNC1;
+  gpsConfState = GPS_CONF_START;
+  gpsConfRetries = 0;
+  gpsData.protocol = GPS_PROTOCOL_NMEA;
 }
 
-void gpsWakeup()
+static void gpsSendUbx(uint8_t msgClass, uint8_t msgId, const uint8_t* payload,
+                       uint8_t len)
 {
   if (!gpsSerialDrv) return;
-  
-  auto _getByte = gpsSerialDrv->getByte;
-  if (!_getByte) return;
 
-  uint8_t byte;
-  while (_getByte(gpsSerialCtx, &byte)) {
+  uint8_t frame[8 + 20]; // biggest payload is CFG-PRT
+  if (len > sizeof(frame) - 8) return;
+
+  frame[0] = UBX_SYNC1;
+  frame[1] = UBX_SYNC2;
+  frame[2] = msgClass;
+  frame[3] = msgId;
+  frame[4] = len;
+  frame[5] = 0;
+  memcpy(&frame[6], payload, len);
+
+  uint8_t ckA = 0, ckB = 0;
+  for (uint8_t i = 2; i < 6 + len; i++) {
+    ckA += frame[i];
+    ckB += ckA;
+  }
+  frame[6 + len] = ckA;
+  frame[7 + len] = ckB;
+
+  if (gpsSerialDrv->sendBuffer) {
+    gpsSerialDrv->sendBuffer(gpsSerialCtx, frame, 8 + len);
+  }
+  else if (gpsSerialDrv->sendByte) {
+    for (uint8_t i = 0; i < 8 + len; i++) {
+      gpsSerialDrv->sendByte(gpsSerialCtx, frame[i]);
+    }
+  }
+}
+
+static void gpsSetBaudrate(uint32_t baudrate)
+{
+  if (gpsSerialDrv->setBaudrate) {
+    gpsSerialDrv->setBaudrate(gpsSerialCtx, baudrate);
+  }
+}
+
+// UART1, 8N1, UBX+NMEA in, UBX out
+static const uint8_t ubxCfgPrt[] = {
+  0x01, 0x00, 0x00, 0x00,
+  0xD0, 0x08, 0x00, 0x00,
+  (uint8_t)UBX_BAUDRATE, (uint8_t)(UBX_BAUDRATE >> 8),
+  (uint8_t)(UBX_BAUDRATE >> 16), (uint8_t)(UBX_BAUDRATE >> 24),
+  0x03, 0x00,
+  0x01, 0x00,
+  0x00, 0x00,
+  0x00, 0x00,
+};
+
+// 100ms measurement period, 1 cycle per solution, GPS time
+static const uint8_t ubxCfgRate[] = {
+  0x64, 0x00, 0x01, 0x00, 0x01, 0x00,
+};
+
+// NAV-PVT on each solution
+static const uint8_t ubxCfgMsg[] = {
+  UBX_CLASS_NAV, UBX_NAV_PVT, 0x01,
+};
+
+static void gpsConfigure()
+{
+  uint32_t now = RTOS_GET_MS();
+
+  switch (gpsConfState) {
+    case GPS_CONF_START:
+      // the module starts with its default baudrate
+      gpsSetBaudrate(GPS_USART_BAUDRATE);
+      gpsSendUbx(UBX_CLASS_CFG, UBX_CFG_PRT, ubxCfgPrt, sizeof(ubxCfgPrt));
+      gpsConfTime = now;
+      gpsConfState = GPS_CONF_BAUDRATE;
+      break;
+
+    case GPS_CONF_BAUDRATE:
+      if (now - gpsConfTime < UBX_CONF_DELAY_MS) break;
+      // sent again in case the module was already on UBX_BAUDRATE
+      gpsSetBaudrate(UBX_BAUDRATE);
+      gpsSendUbx(UBX_CLASS_CFG, UBX_CFG_PRT, ubxCfgPrt, sizeof(ubxCfgPrt));
+      gpsConfTime = now;
+      gpsConfState = GPS_CONF_RATE;
+      break;
+
+    case GPS_CONF_RATE:
+      if (now - gpsConfTime < UBX_CONF_DELAY_MS) break;
+      gpsSendUbx(UBX_CLASS_CFG, UBX_CFG_RATE, ubxCfgRate, sizeof(ubxCfgRate));
+      gpsSendUbx(UBX_CLASS_CFG, UBX_CFG_MSG, ubxCfgMsg, sizeof(ubxCfgMsg));
+      gpsConfTime = now;
+      gpsConfState = GPS_CONF_WAIT_ACK;
+      break;
+
+    case GPS_CONF_WAIT_ACK:
+      if (now - gpsConfTime < UBX_CONF_TIMEOUT_MS) break;
+      if (++gpsConfRetries < UBX_CONF_RETRIES) {
+        gpsConfState = GPS_CONF_START;
+      }
+      else {
+        // not a u-blox module, keep NMEA
+        TRACE("gps: no UBX answer, using NMEA");
+        gpsSetBaudrate(GPS_USART_BAUDRATE);
+        gpsConfState = GPS_CONF_NMEA;
+      }
+      break;
+
+    case GPS_CONF_UBX:
+      if (now - gpsUbxLastFrame >= UBX_LOST_TIMEOUT_MS) {
+        TRACE("gps: UBX lost, configuring again");
+        gpsData.protocol = GPS_PROTOCOL_NMEA;
+        gpsConfRetries = 0;
+        gpsConfState = GPS_CONF_START;
+      }
+      break;
+  }
+}
+
+static inline void gpsProcessByte(uint8_t byte)
+{
 #if defined(DEBUG)
-    if (gpsTraceEnabled) {
-      dbgSerialPutc(byte);
+  if (gpsTraceEnabled) {
+    dbgSerialPutc(byte);
+  }
+#endif
+  gpsNewData(byte);
+}
+
+void gpsWakeup()
+{
+  if (!gpsSerialDrv) return;
+
+  if (gpsSerialDrv->getRxSpan && gpsSerialDrv->consumeRx) {
+    // parse the received bytes in place, one span at a time
+    const uint8_t* data;
+    uint32_t len;
+    while ((len = gpsSerialDrv->getRxSpan(gpsSerialCtx, &data)) > 0) {
+      for (uint32_t i = 0; i < len; i++) {
+        gpsProcessByte(data[i]);
+      }
+      gpsSerialDrv->consumeRx(gpsSerialCtx, len);
+    }
+  }
+  else if (gpsSerialDrv->getByte) {
+    uint8_t byte;
+    while (gpsSerialDrv->getByte(gpsSerialCtx, &byte)) {
+      gpsProcessByte(byte);
     }
-#endif  
-    gpsNewData(byte);
   }
+  else {
+    return;
+  }
+
+  gpsConfigure();
 }
 
 char hex(uint8_t b) {
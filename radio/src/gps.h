@@ -24,6 +24,11 @@
 
 #include <inttypes.h>
 
+enum GpsProtocol {
+  GPS_PROTOCOL_NMEA,
+  GPS_PROTOCOL_UBX,
+};
+
 struct gpsdata_t
 {
   int32_t longitude;              // degrees * 1.000.000
@@ -36,6 +41,12 @@ struct gpsdata_t
   uint16_t speed;                 // speed in 0.1m/s
   uint16_t groundCourse;          // degrees * 10
   uint16_t hdop;
+  // UBX only
+  int16_t verticalSpeed;          // 0.1m/s, positive up
+  uint16_t hAcc;                  // horizontal accuracy in 0.1m
+  uint16_t vAcc;                  // vertical accuracy in 0.1m
+  uint16_t sAcc;                  // speed accuracy in 0.1m/s
+  uint8_t protocol;               // GpsProtocol
 };
 
 extern gpsdata_t gpsData;
@@ -51,6 +51,54 @@ coord_t lcdLastRightPos;
 coord_t lcdNextPos;
 coord_t lcdLastLeftPos;
 
+// One pattern column, all the rows of a page at once: same result as the
+// lcdDrawPoint() loop below, including the border rows around small fonts
+static void lcdPutPatternColumn(coord_t x, coord_t y, const uint8_t * b, uint8_t height, bool inv, LcdFlags flags)
+{
+  uint8_t lines = (height+7)/8;
+  uint64_t glyph = 0;
+  for (uint8_t j=0; j<lines; j++) {
+    glyph |= (uint64_t)b[j] << (8*j);
+  }
+
+  // the small font uses the row below as part of the glyph
+  bool small = (FONTSIZE(flags) == SMLSIZE);
+  uint8_t bodyRows = small ? height+1 : height;
+
+  // rows relative to y-1, so that the top border row is bit 0
+  uint64_t body = ((uint64_t)1 << bodyRows) - 1;
+  uint64_t rows = body << 1;
+  uint64_t pixels = ((inv ? ~glyph : glyph) & body) << 1;
+  if (height < 12) {
+    if (inv) {
+      rows |= 1;
+      pixels |= 1;
+    }
+    if (!small) {
+      rows |= (uint64_t)1 << (height+1);
+      if (inv) pixels |= (uint64_t)1 << (height+1);
+    }
+  }
+
+  if (y == 0) {
+    rows >>= 1;
+    pixels >>= 1;
+  }
+  else {
+    rows <<= y-1;
+    pixels <<= y-1;
+  }
+
+  uint8_t * p = &displayBuf[x];
+  for (uint8_t page=0; page<LCD_H/8; page++, p+=LCD_W, rows>>=8, pixels>>=8) {
+    uint8_t mask = rows;
+    if (mask) {
+      ASSERT_IN_DISPLAY(p);
+      *p = (*p & ~mask) | (pixels & mask);
+    }
+  }
+}
+
 void lcdPutPattern(coord_t x, coord_t y, const uint8_t * pattern, uint8_t width, uint8_t height, LcdFlags flags)
 {
   bool blink = false;
@@ -108,7 +156,13 @@ void lcdPutPattern(coord_t x, coord_t y, const uint8_t * pattern, uint8_t width,
         }
       }
 
-      for (int8_t j=-1; j<=height; j++) {
+      if (blink) {
+        // nothing drawn in the blink off phase
+      }
+      else if (!(flags & VERTICAL) && y >= 0 && y < LCD_H) {
+        lcdPutPatternColumn(x, y, b, height, inv, flags);
+      }
+      else for (int8_t j=-1; j<=height; j++) {
         bool plot;
         if (j < 0 || ((j == height) && !(FONTSIZE(flags) == SMLSIZE))) {
           plot = false;
@@ -20,6 +20,7 @@
  */
 
 #include "opentx.h"
+#include "tasks/mixer_task.h"
 
 void menuChannelsView(event_t event)
 {
@@ -66,6 +67,10 @@ void menuChannelsView(event_t event)
   // Column separator
   lcdDrawSolidVerticalLine(LCD_W/2, FH, LCD_H-FH);
 
+  // all channels of the page from the same mixer cycle
+  MixerOutputSnapshot outputs;
+  mixerGetOutputSnapshot(&outputs);
+
   for (uint8_t col=0; col < 2; col++) {
     const uint8_t x = col * LCD_W / 2 + 1;
     const uint8_t ofs = (col ? 0 : 1);
@@ -73,7 +78,7 @@ void menuChannelsView(event_t event)
     // Channels
     for (uint8_t line=0; line < 8; line++) {
       const uint8_t y = 9 + line * 7;
-      const int32_t val = reusableBuffer.viewChannels.mixersView ? ex_chans[ch] : channelOutputs[ch];
+      const int32_t val = reusableBuffer.viewChannels.mixersView ? outputs.ex_chans[ch] : outputs.channelOutputs[ch];
       const uint8_t lenLabel = ZLEN(g_model.limitData[ch].name);
 
       // Channel name if present, number if not
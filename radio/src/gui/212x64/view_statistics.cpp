@@ -21,7 +21,10 @@
 
 #include "hal/adc_driver.h"
 #include "opentx.h"
+#include "bin_allocator.h"
 #include "tasks.h"
+#include "mixer_profiler.h"
+#include "module_timing.h"
 
 #define STATS_1ST_COLUMN               FW/2
 #define STATS_2ND_COLUMN               12*FW+FW/2
@@ -105,6 +108,10 @@ void menuStatisticsView(event_t event)
 #define MENU_DEBUG_ROW4       (5*FH)
 #define MENU_DEBUG_ROW5       (6*FH)
 
+#define MENU_PROFILER_COL_P50 (16*FW)
+#define MENU_PROFILER_COL_P99 (22*FW)
+#define MENU_PROFILER_COL_MAX (28*FW)
+
 void menuStatisticsDebug(event_t event)
 {
   title(STR_MENUDEBUG);
@@ -130,8 +137,12 @@ void menuStatisticsDebug(event_t event)
 #if defined(LUA)
       maxLuaInterval = 0;
       maxLuaDuration = 0;
+#if defined(LUA_MIX_SYNC_CYCLES)
+      luaMixOverruns = 0;
+#endif
 #endif
       maxMixerDuration  = 0;
+      moduleTimingReset();
       break;
 
     case EVT_KEY_FIRST(KEY_PLUS):
@@ -178,6 +189,10 @@ void menuStatisticsDebug(event_t event)
   lcdDrawNumber(lcdLastRightPos, y, 10*maxLuaDuration, LEFT);
   lcdDrawText(lcdLastRightPos+2, y+1, STR_INTERVAL_MS, SMLSIZE);
   lcdDrawNumber(lcdLastRightPos, y, 10*maxLuaInterval, LEFT);
+#if defined(LUA_MIX_SYNC_CYCLES)
+  lcdDrawText(lcdLastRightPos+2, y+1, "[O]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, luaMixOverruns, LEFT);
+#endif
   y += FH;
 #endif
 
@@ -197,6 +212,36 @@ void menuStatisticsDebug(event_t event)
   lcdDrawNumber(lcdLastRightPos, y, mainStackAvailable(), LEFT);
   y += FH;
 
+#if defined(USE_BIN_ALLOCATOR)
+  if (y < 7*FH) {
+    // high water marks of the Lua bins, then the heap fallbacks
+    lcdDrawTextAlignedLeft(y, "Lua bins");
+    lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, slots1.highWater(), LEFT);
+    lcdDrawText(lcdLastRightPos, y, "/");
+    lcdDrawNumber(lcdLastRightPos, y, slots2.highWater(), LEFT);
+    lcdDrawText(lcdLastRightPos, y, "/");
+    lcdDrawNumber(lcdLastRightPos, y, slots3.highWater(), LEFT);
+    lcdDrawText(lcdLastRightPos, y, " +");
+    lcdDrawNumber(lcdLastRightPos, y, binAllocatorHeapFallbacks, LEFT);
+    y += FH;
+  }
+#endif
+
+  if (y < 7*FH) {
+    // late / dropped frames of each module
+    lcdDrawTextAlignedLeft(y, "Late/drop");
+    coord_t x = MENU_DEBUG_COL1_OFS;
+    for (uint8_t module = 0; module < NUM_MODULES; module++) {
+      ModuleTimingStats stats;
+      moduleTimingGetStats(module, stats);
+      lcdDrawNumber(x, y, stats.late, LEFT);
+      lcdDrawText(lcdLastRightPos, y, "/");
+      lcdDrawNumber(lcdLastRightPos, y, stats.dropped, LEFT);
+      x = lcdLastRightPos + FW;
+    }
+    y += FH;
+  }
+
 #if defined(DEBUG_LATENCY)
   lcdDrawTextAlignedLeft(y, STR_HEARTBEAT_LABEL);
   if (heartbeatCapture.valid)
@@ -234,14 +279,30 @@ void menuStatisticsDebug2(event_t event)
       chainMenu(menuMainView);
       break;
 
-    // case EVT_KEY_LONG(KEY_ENTER):
-    //   telemetryErrors = 0;
-    //   break;
+    case EVT_KEY_FIRST(KEY_ENTER):
+      mixerProfilerReset();
+      break;
   }
 
-  // UART statistics
-  // lcdDrawTextAlignedLeft(MENU_DEBUG_ROW1, "Tlm RX Err");
-  // lcdDrawNumber(MENU_DEBUG_COL1_OFS, MENU_DEBUG_ROW1, telemetryErrors, RIGHT);
+  // Mixer stages timing (us)
+  uint8_t y = FH + 1;
+  lcdDrawText(MENU_PROFILER_COL_P50, y, "p50", RIGHT);
+  lcdDrawText(MENU_PROFILER_COL_P99, y, "p99", RIGHT);
+  lcdDrawText(MENU_PROFILER_COL_MAX, y, "max", RIGHT);
+  lcdDrawText(lcdLastRightPos+FW, y, "us");
+  y += FH;
+
+  // only the stages fit between the header and the reset line: the
+  // total is left to the colorlcd page, the latencies to the CLI
+  for (uint8_t stage = 0; stage < MIXER_STAGE_TOTAL; stage++) {
+    MixerStageStats stats;
+    mixerProfilerGetStats(stage, stats);
+    lcdDrawTextAlignedLeft(y, mixerProfilerStageNames[stage]);
+    lcdDrawNumber(MENU_PROFILER_COL_P50, y, stats.p50, RIGHT);
+    lcdDrawNumber(MENU_PROFILER_COL_P99, y, stats.p99, RIGHT);
+    lcdDrawNumber(MENU_PROFILER_COL_MAX, y, stats.max, RIGHT);
+    y += FH;
+  }
 
 
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
@@ -26,6 +26,8 @@
 #include "themes/etx_lv_theme.h"
 
 #include "view_main.h"
+#include "mixer_profiler.h"
+#include "mixer_scheduler.h"
 
 LvglWrapper* LvglWrapper::_instance = nullptr;
 
@@ -310,10 +312,16 @@ lv_color_t makeLvColor(uint32_t colorFlags)
   return lv_color_make(GET_RED(color), GET_GREEN(color), GET_BLUE(color));
 }
 
+static void displayMonitor(lv_disp_drv_t* drv, uint32_t time, uint32_t px)
+{
+  LvglWrapper::instance()->frameRendered(time);
+}
+
 static void init_lvgl_drivers()
 {
   // Register the driver and save the created display object
   lcdInitDisplayDriver();
+  lv_disp_get_default()->driver->monitor_cb = displayMonitor;
  
   // Register the driver in LVGL and save the created input device object
   lv_indev_drv_init(&touchDriver);          /*Basic initialization*/
@@ -348,6 +356,7 @@ void initLvglTheme()
 LvglWrapper::LvglWrapper()
 {
   init_lvgl_drivers();
+  applyFramePeriod();
 
   // Create main window and load that screen
   auto window = MainWindow::instance();
@@ -362,12 +371,84 @@ LvglWrapper* LvglWrapper::instance()
 
 void LvglWrapper::run()
 {
-#if defined(SIMU)
   tmr10ms_t tick = get_tmr10ms();
+#if defined(SIMU)
   lv_tick_inc((tick - lastTick) * 10);
   lastTick = tick;
 #endif
   lv_timer_handler();
+
+  if (tick - fpsStart >= 100) {
+    fps = fpsFrames * 100 / (tick - fpsStart);
+    fpsFrames = 0;
+    fpsStart = tick;
+  }
+}
+
+void LvglWrapper::applyFramePeriod()
+{
+  lv_disp_t* disp = lv_disp_get_default();
+  if (disp && disp->refr_timer) {
+    lv_timer_set_period(disp->refr_timer, framePeriod);
+  }
+}
+
+void LvglWrapper::setTargetFps(uint8_t value)
+{
+  targetFps = limit<uint8_t>(LCD_MIN_FPS, value, 100);
+  framePeriod = 1000 / targetFps;
+  applyFramePeriod();
+}
+
+void LvglWrapper::frameRendered(uint32_t timeMs)
+{
+  frameCount++;
+  fpsFrames++;
+
+  if (timeMs > frameMax) frameMax = timeMs;
+  uint16_t& bin = frameBins[min<uint32_t>(timeMs, LCD_FRAME_BINS - 1)];
+  if (bin == UINT16_MAX) {
+    // age all bins, as the mixer profiler does
+    for (auto& b : frameBins) b >>= 1;
+  }
+  bin += 1;
+
+  // the mixer shares the CPU and the memory bus with the rendering
+  MixerStageStats mixer;
+  mixerProfilerGetStats(MIXER_STAGE_TOTAL, mixer);
+  bool mixerBusy = mixer.p99 * 4 > getMixerSchedulerPeriod() * 3;
+
+  uint16_t period = 1000 / targetFps;
+  overBudget = timeMs > frameBudget || mixerBusy;
+  if (overBudget) {
+    framePeriod = min<uint16_t>(framePeriod + period, 1000 / LCD_MIN_FPS);
+  } else if (framePeriod > period) {
+    framePeriod = max<uint16_t>(framePeriod - LCD_FRAME_PERIOD_STEP_MS, period);
+  } else {
+    return;
+  }
+  applyFramePeriod();
+}
+
+uint16_t LvglWrapper::getFrameTimeP99() const
+{
+  uint32_t total = 0;
+  for (auto b : frameBins) total += b;
+  if (total == 0) return 0;
+
+  uint32_t rank = (total * 99 + 99) / 100;
+  uint32_t count = 0;
+  for (uint8_t i = 0; i < LCD_FRAME_BINS; i++) {
+    count += frameBins[i];
+    if (count >= rank) return i < LCD_FRAME_BINS - 1 ? i : frameMax;
+  }
+  return frameMax;
+}
+
+void LvglWrapper::resetRenderStats()
+{
+  memset(frameBins, 0, sizeof(frameBins));
+  frameMax = 0;
 }
 
 void LvglWrapper::runNested()
@@ -33,6 +33,21 @@ lv_color_t makeLvColor(uint32_t colorFlags);
 
 typedef std::function<lv_obj_t *(lv_obj_t *parent)> LvObjConstructor;
 
+// Render governor: the display is refreshed at the target frame rate, and
+// less often (down to LCD_MIN_FPS) while frames take longer than the frame
+// budget or while the mixer is running short of time.
+#if !defined(LCD_TARGET_FPS)
+  #define LCD_TARGET_FPS          30
+#endif
+
+#if !defined(LCD_FRAME_BUDGET_MS)
+  #define LCD_FRAME_BUDGET_MS     25
+#endif
+
+#define LCD_MIN_FPS               5
+#define LCD_FRAME_PERIOD_STEP_MS  5   // recovery step once back within budget
+#define LCD_FRAME_BINS            64  // frame time histogram, 1ms per bin
+
 class LvglWrapper
 {
   static LvglWrapper *_instance;
@@ -41,15 +56,49 @@ class LvglWrapper
   tmr10ms_t lastTick = 0;
   // TODO: add driver instances here
 
+  uint8_t targetFps = LCD_TARGET_FPS;
+  uint16_t frameBudget = LCD_FRAME_BUDGET_MS;
+  uint16_t framePeriod = 1000 / LCD_TARGET_FPS;
+  bool overBudget = false;
+
+  uint32_t frameCount = 0;
+  uint32_t fpsFrames = 0;
+  tmr10ms_t fpsStart = 0;
+  uint16_t fps = 0;
+  uint16_t frameBins[LCD_FRAME_BINS] = {0};
+  uint16_t frameMax = 0;
+
   LvglWrapper();
   ~LvglWrapper() {}
 
+  void applyFramePeriod();
+
  public:
   static LvglWrapper* instance();
 
   // Called from UI task: executes the LVGL timer handler 
   void run();
 
+  // Called by the display driver once a frame has been rendered
+  void frameRendered(uint32_t timeMs);
+
+  void setTargetFps(uint8_t value);
+  uint8_t getTargetFps() const { return targetFps; }
+  void setFrameBudget(uint16_t ms) { frameBudget = ms; }
+  uint16_t getFrameBudget() const { return frameBudget; }
+
+  // True while the last frame ran over budget: low priority updates
+  // (such as Lua widgets) should then skip the cycles without a new frame
+  bool isOverBudget() const { return overBudget; }
+  uint32_t getFrameCount() const { return frameCount; }
+
+  // Frames rendered during the last second
+  uint16_t getFps() const { return fps; }
+  // 99th percentile and max of the frame rendering time (ms)
+  uint16_t getFrameTimeP99() const;
+  uint16_t getFrameTimeMax() const { return frameMax; }
+  void resetRenderStats();
+
   // Call it when running the loop manually from within
   // the LVGL timer handler (blocking UI code)
   static void runNested();
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bitmap_cache.h"
+#include "opentx.h"
+
+#include <list>
+#include <string>
+
+#define THUMBNAIL_MAGIC  0x48545445  // "ETTH"
+
+struct BitmapCacheRequest {
+  std::string path;
+  coord_t w;
+  coord_t h;
+  bool upscale;
+
+  bool matches(const char * p, coord_t width, coord_t height, bool up) const
+  {
+    return w == width && h == height && upscale == up && path == p;
+  }
+};
+
+struct BitmapCacheEntry : public BitmapCacheRequest {
+  FSIZE_t fsize;
+  WORD fdate;
+  WORD ftime;
+  uint32_t size;        // bytes used by the decoded picture
+  SharedBitmap bitmap;  // nullptr if the picture could not be loaded
+};
+
+struct ThumbnailHeader {
+  uint32_t magic;
+  // picture the thumbnail has been made from
+  uint32_t srcSize;
+  uint16_t srcDate;
+  uint16_t srcTime;
+  uint16_t pathLen;
+  // requested and actual size
+  uint16_t reqWidth;
+  uint16_t reqHeight;
+  uint16_t width;
+  uint16_t height;
+  uint8_t format;
+  uint8_t upscale;
+  // followed by the source path (pathLen bytes) and the pixels
+};
+
+// Most recently used entries first
+static std::list<BitmapCacheEntry> cacheEntries;
+static std::list<BitmapCacheRequest> cacheQueue;
+static uint32_t cacheSize = 0;
+
+static bool statFile(const char * path, FILINFO & info)
+{
+  return f_stat(path, &info) == FR_OK;
+}
+
+static std::list<BitmapCacheEntry>::iterator findEntry(
+    const BitmapCacheRequest & request, const FILINFO & info)
+{
+  const char * path = request.path.c_str();
+  for (auto it = cacheEntries.begin(); it != cacheEntries.end(); ++it) {
+    if (it->matches(path, request.w, request.h, request.upscale)) {
+      if (it->fsize == info.fsize && it->fdate == info.fdate &&
+          it->ftime == info.ftime) {
+        return it;
+      }
+      // the file changed since it was decoded
+      cacheSize -= it->size;
+      cacheEntries.erase(it);
+      break;
+    }
+  }
+  return cacheEntries.end();
+}
+
+static void evictEntries(uint32_t needed)
+{
+  while (!cacheEntries.empty() && cacheSize + needed > BITMAP_CACHE_SIZE) {
+    cacheSize -= cacheEntries.back().size;
+    cacheEntries.pop_back();
+  }
+}
+
+static void getThumbnailPath(char * thumb, const BitmapCacheRequest & request)
+{
+  uint32_t h = hash(request.path.c_str(), request.path.size());
+  sprintf(thumb, THUMBNAILS_PATH PATH_SEPARATOR "%08X%c%ux%u" THUMBNAILS_EXT,
+          (unsigned)h, request.upscale ? 'u' : '_', (unsigned)request.w,
+          (unsigned)request.h);
+}
+
+static BitmapBuffer * readThumbnail(const BitmapCacheRequest & request,
+                                    const FILINFO & info)
+{
+  char thumb[64];
+  getThumbnailPath(thumb, request);
+
+  FIL file;
+  if (f_open(&file, thumb, FA_OPEN_EXISTING | FA_READ) != FR_OK) return nullptr;
+
+  ThumbnailHeader header;
+  char path[FF_MAX_LFN + 1];
+  UINT read;
+  bool valid = f_read(&file, &header, sizeof(header), &read) == FR_OK &&
+               read == sizeof(header) && header.magic == THUMBNAIL_MAGIC &&
+               header.srcSize == info.fsize && header.srcDate == info.fdate &&
+               header.srcTime == info.ftime &&
+               header.reqWidth == request.w && header.reqHeight == request.h &&
+               header.upscale == request.upscale &&
+               header.pathLen == request.path.size() &&
+               header.pathLen < sizeof(path) &&
+               f_read(&file, path, header.pathLen, &read) == FR_OK &&
+               read == header.pathLen &&
+               !memcmp(path, request.path.c_str(), header.pathLen);
+
+  BitmapBuffer * bitmap = nullptr;
+  if (valid) {
+    bitmap = new BitmapBuffer(header.format, header.width, header.height);
+    if (bitmap && bitmap->getData()) {
+      UINT size = header.width * header.height * sizeof(pixel_t);
+      if (f_read(&file, bitmap->getData(), size, &read) != FR_OK ||
+          read != size) {
+        delete bitmap;
+        bitmap = nullptr;
+      }
+    } else {
+      delete bitmap;
+      bitmap = nullptr;
+    }
+  }
+
+  f_close(&file);
+  return bitmap;
+}
+
+static void writeThumbnail(const BitmapCacheRequest & request,
+                           const FILINFO & info, const BitmapBuffer * bitmap)
+{
+  ThumbnailHeader header;
+  memclear(&header, sizeof(header));
+  header.magic = THUMBNAIL_MAGIC;
+  header.srcSize = info.fsize;
+  header.srcDate = info.fdate;
+  header.srcTime = info.ftime;
+  header.pathLen = request.path.size();
+  header.reqWidth = request.w;
+  header.reqHeight = request.h;
+  header.width = bitmap->width();
+  header.height = bitmap->height();
+  header.format = bitmap->getFormat();
+  header.upscale = request.upscale;
+
+  if (sdCheckAndCreateDirectory(THUMBNAILS_PATH)) return;
+
+  char thumb[64];
+  getThumbnailPath(thumb, request);
+
+  FIL file;
+  if (f_open(&file, thumb, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) return;
+
+  UINT size = header.width * header.height * sizeof(pixel_t);
+  UINT written;
+  bool ok = f_write(&file, &header, sizeof(header), &written) == FR_OK &&
+            written == sizeof(header) &&
+            f_write(&file, request.path.c_str(), header.pathLen, &written) ==
+                FR_OK &&
+            written == header.pathLen &&
+            f_write(&file, bitmap->getData(), size, &written) == FR_OK &&
+            written == size;
+  f_close(&file);
+
+  if (!ok) f_unlink(thumb);
+}
+
+static BitmapBuffer * decodeBitmap(const BitmapCacheRequest & request,
+                                   const FILINFO & info)
+{
+  coord_t w = request.w;
+  coord_t h = request.h;
+  if (w <= 0 || h <= 0) return nullptr;
+
+  auto scaled = readThumbnail(request, info);
+  if (scaled) return scaled;
+
+  std::unique_ptr<BitmapBuffer> bitmap(
+      BitmapBuffer::loadBitmap(request.path.c_str()));
+  if (!bitmap) return nullptr;
+
+  float vscale = float(h) / bitmap->height();
+  float hscale = float(w) / bitmap->width();
+  float scale = vscale < hscale ? vscale : hscale;
+  if (!request.upscale && scale > 1.0f) scale = 1.0f;
+  if (scale == 1.0f) return bitmap.release();
+
+  coord_t scaledw = max<coord_t>(1, bitmap->width() * scale);
+  coord_t scaledh = max<coord_t>(1, bitmap->height() * scale);
+
+  // keep the alpha channel of the source, if any
+  scaled = new BitmapBuffer(bitmap->getFormat(), scaledw, scaledh);
+  if (scaled && scaled->getData()) {
+    scaled->clear();
+    scaled->drawScaledBitmap(bitmap.get(), 0, 0, scaledw, scaledh);
+    if (scale < 1.0f &&
+        scaledw * scaledh * sizeof(pixel_t) <= THUMBNAIL_MAX_SIZE) {
+      writeThumbnail(request, info, scaled);
+    }
+  } else {
+    delete scaled;
+    scaled = nullptr;
+  }
+  return scaled;
+}
+
+static SharedBitmap insertEntry(const BitmapCacheRequest & request,
+                                const FILINFO & info)
+{
+  BitmapCacheEntry entry;
+  static_cast<BitmapCacheRequest &>(entry) = request;
+  entry.fsize = info.fsize;
+  entry.fdate = info.fdate;
+  entry.ftime = info.ftime;
+
+  auto bitmap = decodeBitmap(request, info);
+  if (bitmap) {
+    entry.size = bitmap->width() * bitmap->height() * sizeof(pixel_t);
+    entry.bitmap.reset(bitmap);
+  } else {
+    TRACE("bitmapCache: could not load '%s'", request.path.c_str());
+    entry.size = 0;
+  }
+
+  evictEntries(entry.size);
+  cacheSize += entry.size;
+  cacheEntries.push_front(entry);
+  return cacheEntries.front().bitmap;
+}
+
+static std::list<BitmapCacheRequest>::iterator findRequest(
+    const BitmapCacheRequest & request)
+{
+  const char * path = request.path.c_str();
+  for (auto it = cacheQueue.begin(); it != cacheQueue.end(); ++it) {
+    if (it->matches(path, request.w, request.h, request.upscale)) return it;
+  }
+  return cacheQueue.end();
+}
+
+SharedBitmap bitmapCacheGet(const char * path, coord_t w, coord_t h,
+                            bool wait, bool upscale)
+{
+  FILINFO info;
+  if (!path || !statFile(path, info)) return nullptr;
+
+  BitmapCacheRequest request = {path, w, h, upscale};
+  auto it = findEntry(request, info);
+  if (it != cacheEntries.end()) {
+    cacheEntries.splice(cacheEntries.begin(), cacheEntries, it);
+    return it->bitmap;
+  }
+
+  auto queued = findRequest(request);
+  if (wait) {
+    if (queued != cacheQueue.end()) cacheQueue.erase(queued);
+    return insertEntry(request, info);
+  }
+
+  if (queued == cacheQueue.end()) {
+    // requests nobody is waiting for anymore are dropped first
+    if (cacheQueue.size() >= BITMAP_CACHE_QUEUE_LEN) cacheQueue.pop_front();
+    cacheQueue.push_back(request);
+  }
+  return nullptr;
+}
+
+BitmapBuffer * bitmapCacheLoad(const char * path)
+{
+  FILINFO info;
+  if (!path || !statFile(path, info)) return nullptr;
+
+  // a picture with no target size is kept at its original size
+  BitmapCacheRequest request = {path, 0, 0, false};
+  BitmapBuffer * bitmap = readThumbnail(request, info);
+  if (bitmap) return bitmap;
+
+  bitmap = BitmapBuffer::loadBitmap(path);
+  if (bitmap) {
+    // BMP files are read as fast as their decoded copy
+    const char * ext = getFileExtension(path);
+    if (!ext || strcasecmp(ext, BMP_EXT)) writeThumbnail(request, info, bitmap);
+  }
+  return bitmap;
+}
+
+bool bitmapCachePending(const char * path, coord_t w, coord_t h, bool upscale)
+{
+  return path && findRequest({path, w, h, upscale}) != cacheQueue.end();
+}
+
+uint32_t bitmapCacheUsage()
+{
+  return cacheSize;
+}
+
+void bitmapCacheWakeup()
+{
+  if (cacheQueue.empty()) return;
+
+  BitmapCacheRequest request = cacheQueue.front();
+  cacheQueue.pop_front();
+
+  FILINFO info;
+  if (statFile(request.path.c_str(), info) &&
+      findEntry(request, info) == cacheEntries.end()) {
+    insertEntry(request, info);
+  }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <memory>
+#include "bitmapbuffer.h"
+
+// Total size of the decoded pictures kept around (bytes)
+#if !defined(BITMAP_CACHE_SIZE)
+  #define BITMAP_CACHE_SIZE     (1024 * 1024)
+#endif
+
+// Maximum number of pictures waiting to be decoded
+#define BITMAP_CACHE_QUEUE_LEN  16
+
+// Scaled copies of the pictures are also stored on the SD card, so that
+// they are read back instead of decoding the full picture next time. Only
+// the pictures scaled down to at most THUMBNAIL_MAX_SIZE bytes are stored.
+#define THUMBNAILS_PATH         BITMAPS_PATH PATH_SEPARATOR ".thumbs"
+#define THUMBNAILS_EXT          ".thm"
+#define THUMBNAIL_MAX_SIZE      (64 * 1024)
+
+typedef std::shared_ptr<const BitmapBuffer> SharedBitmap;
+
+// Returns the picture stored in 'path', scaled to fit w x h while keeping
+// its aspect ratio (smaller pictures are only enlarged with 'upscale').
+// Entries are keyed by path, file size/date and target size, so an edited
+// picture is decoded again.
+//
+// With 'wait' set, the picture is decoded right away if not yet cached.
+// Otherwise it is queued for bitmapCacheWakeup() and nullptr is returned
+// until it is ready: bitmapCachePending() tells both cases apart from a
+// picture that could not be loaded.
+SharedBitmap bitmapCacheGet(const char * path, coord_t w, coord_t h,
+                            bool wait = true, bool upscale = true);
+bool bitmapCachePending(const char * path, coord_t w, coord_t h,
+                        bool upscale = true);
+
+// Loads the picture stored in 'path' at its original size, for pictures
+// drawn on every screen such as the theme backgrounds. The decoded pixels
+// are stored next to the thumbnails, so that compressed pictures are only
+// decoded again once edited. The caller owns the returned bitmap.
+BitmapBuffer * bitmapCacheLoad(const char * path);
+
+// Decodes the oldest queued picture, called once per GUI cycle
+void bitmapCacheWakeup();
+
+// Bytes used by the decoded pictures currently cached
+uint32_t bitmapCacheUsage();
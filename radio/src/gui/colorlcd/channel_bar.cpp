@@ -20,6 +20,7 @@
  */
 
 #include "channel_bar.h"
+#include "tasks/mixer_task.h"
 
 #define VIEW_CHANNELS_LIMIT_PCT \
   (g_model.extendedLimits ? LIMIT_EXT_PERCENT : LIMIT_STD_PERCENT)
@@ -34,7 +35,7 @@ ChannelBar::ChannelBar(Window* parent, const rect_t& rect, uint8_t channel) :
 
 void MixerChannelBar::paint(BitmapBuffer * dc)
 {
-  int chanVal = calcRESXto100(ex_chans[channel]);
+  int chanVal = calcRESXto100(mixerGetMixOutput(channel));
   const int displayVal = chanVal;
 
   // this could be handled nicer, but slower, by checking actual range for this
@@ -70,10 +71,12 @@ void MixerChannelBar::paint(BitmapBuffer * dc)
   }
 }
 
+// Only redraw when the displayed percentage changes, not on every
+// change of the raw channel value
 void MixerChannelBar::checkEvents()
 {
   Window::checkEvents();
-  int newValue = ex_chans[channel];
+  int newValue = calcRESXto100(mixerGetMixOutput(channel));
   if (value != newValue) {
     value = newValue;
     invalidate();
@@ -101,7 +104,7 @@ static void drawOutputBarLimits(BitmapBuffer* dc, coord_t left, coord_t right,
 
 void OutputChannelBar::paint(BitmapBuffer* dc)
 {
-  int chanVal = calcRESXto100(channelOutputs[channel]);
+  int chanVal = calcRESXto100(mixerGetChannelOutput(channel));
   int displayVal = chanVal;
 
   chanVal =
@@ -166,7 +169,7 @@ void OutputChannelBar::paint(BitmapBuffer* dc)
 void OutputChannelBar::checkEvents()
 {
   Window::checkEvents();
-  int newValue = channelOutputs[channel];
+  int newValue = calcRESXto100(mixerGetChannelOutput(channel));
   if (value != newValue) {
     value = newValue;
     invalidate();
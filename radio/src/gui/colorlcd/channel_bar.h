@@ -145,10 +145,11 @@ class ComboChannelBar : public Window
     void checkEvents() override
     {
       Window::checkEvents();
-      int newValue = channelOutputs[channel];
+      // the bars refresh themselves, only the text line is redrawn here
+      int newValue = PPM_CH_CENTER(channel) + channelOutputs[channel] / 2;
       if (value != newValue) {
         value = newValue;
-        invalidate();
+        invalidate({0, 0, width(), BAR_HEIGHT + TMARGIN});
       }
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
       int newSafetyChValue = safetyCh[channel];
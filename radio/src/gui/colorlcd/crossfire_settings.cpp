@@ -21,6 +21,7 @@
 
 #include "crossfire_settings.h"
 #include "opentx.h"
+#include "radio_crossfire_config.h"
 
 #include "mixer_scheduler.h"
 
@@ -66,4 +67,12 @@ CrossfireSettings::CrossfireSettings(Window* parent, const FlexGridLayout& g,
     sprintf(msg, "%d Hz", 1000000 / getMixerSchedulerPeriod());
     return std::string(msg);
   });
+
+  // full device configuration, without the Lua tool
+  line = newLine(&grid);
+  new StaticText(line, rect_t{}, "CRSF", 0, COLOR_THEME_PRIMARY1);
+  new TextButton(line, rect_t{}, STR_MODULE_OPTIONS, [=]() -> uint8_t {
+    new RadioCrossfireConfig(moduleIdx);
+    return 0;
+  });
 }
@@ -21,6 +21,7 @@
 
 #include "custom_failsafe.h"
 #include "opentx.h"
+#include "tasks/mixer_task.h"
 
 #define SET_DIRTY()     storageDirty(EE_MODEL)
 
@@ -42,7 +43,7 @@ class ChannelFailsafeBargraph : public Window
   void paint(BitmapBuffer* dc) override
   {
     int32_t failsafeValue = g_model.failsafeChannels[channel];
-    int32_t channelValue = channelOutputs[channel];
+    int32_t channelValue = mixerGetChannelOutput(channel);
 
     const int lim = g_model.extendedLimits ? 1024 * LIMIT_EXT_PERCENT / 100 : 1024;
 
@@ -149,7 +150,7 @@ public:
 
   void copyChannel()
   {
-    g_model.failsafeChannels[channel] = channelOutputs[channel];
+    g_model.failsafeChannels[channel] = mixerGetChannelOutput(channel);
     update();
   }
 };
@@ -468,6 +468,27 @@ void drawSourceCustomValue(BitmapBuffer * dc, coord_t x, coord_t y, source_t sou
   }
 }
 
+int32_t getSourceDisplayValue(source_t source, int32_t value)
+{
+  // only the sources before the global variables are shown scaled
+#if defined(LUA_INPUTS)
+  if (source >= MIXSRC_FIRST_LUA && source <= MIXSRC_LAST_LUA) {
+    return value;
+  }
+#endif
+  if (source < MIXSRC_FIRST_CH) {
+    return calcRESXto100(value);
+  }
+  else if (source <= MIXSRC_LAST_CH) {
+#if defined(PPM_UNIT_PERCENT_PREC1)
+    return calcRESXto1000(value);
+#else
+    return calcRESXto100(value);
+#endif
+  }
+  return value;
+}
+
 void drawValueWithUnit(BitmapBuffer * dc, coord_t x, coord_t y, int val, uint8_t unit, LcdFlags flags)
 {
   if ((flags & NO_UNIT) || unit == UNIT_RAW) {
@@ -23,8 +23,10 @@
 #include "libopenui_file.h"
 #include "font.h"
 
+#include <algorithm>
 #include <list>
 #include <string>
+#include <vector>
 
 #define CELL_CTRL_DIR  LV_TABLE_CELL_CTRL_CUSTOM_1
 #define CELL_CTRL_FILE LV_TABLE_CELL_CTRL_CUSTOM_2
@@ -127,38 +129,74 @@ static bool natural_compare_nocase(const std::string & first, const std::string
   return strnatcasecmp(first.c_str(), second.c_str()) < 0;
 }
 
-static int scan_files(std::list<std::string>& files,
-                      std::list<std::string>& directories)
-{
-  FILINFO fno;
-  DIR dir;
+// Sorted listing of one directory. The fingerprint sums a hash of each
+// entry (name, attributes, size and date), so that a listing read again
+// can be compared with the cached one without sorting it.
+struct DirListing {
+  std::string path;
+  uint32_t fingerprint = 0;
+  std::vector<std::string> directories;
+  std::vector<std::string> files;
 
-  FRESULT res = f_opendir(&dir, "."); // Open the directory
-  if (res != FR_OK) return -1;
+  size_t size() const { return directories.size() + files.size(); }
+};
 
-  // read all entries
-  bool firstTime = true;
-  for (;;) {
-    res = sdReadDir(&dir, &fno, firstTime);
+#define DIR_CACHE_SIZE         4
+#define DIR_CACHE_MAX_ENTRIES  4096
+#define READ_ENTRIES_PER_CALL  32
+#define FILL_ROWS_PER_CALL     64
 
-    if (res != FR_OK || fno.fname[0] == 0)
-      break; // Break on error or end of dir
-    // if (strlen((const char*)fno.fname) > SD_SCREEN_FILE_LENGTH)
-    //   continue;
-    if (fno.fattrib & (AM_HID|AM_SYS)) continue;     /* Ignore hidden and system files */
-    if (fno.fname[0] == '.' && fno.fname[1] != '.') continue; // Ignore hidden files under UNIX, but not ..
+// most recently shown first
+static std::list<std::shared_ptr<DirListing>> dirCache;
 
-    if (fno.fattrib & AM_DIR) {
-      directories.push_back((char*)fno.fname);
-    } else {
-      files.push_back((char*)fno.fname);
+static std::shared_ptr<DirListing> findCachedListing(const char* path)
+{
+  for (auto it = dirCache.begin(); it != dirCache.end(); ++it) {
+    if ((*it)->path == path) {
+      auto dirListing = *it;
+      dirCache.erase(it);
+      dirCache.push_front(dirListing);
+      return dirListing;
     }
   }
+  return nullptr;
+}
 
-  directories.sort(natural_compare_nocase);
-  files.sort(natural_compare_nocase);
+static void dropCachedListing(const char* path)
+{
+  dirCache.remove_if([=](const std::shared_ptr<DirListing>& l) {
+    return l->path == path;
+  });
+}
 
-  return 0;
+static void cacheListing(const std::shared_ptr<DirListing>& dirListing)
+{
+  dropCachedListing(dirListing->path.c_str());
+  dirCache.push_front(dirListing);
+
+  size_t entries = 0;
+  uint8_t count = 0;
+  for (auto it = dirCache.begin(); it != dirCache.end(); ++it) {
+    entries += (*it)->size();
+    if (++count > DIR_CACHE_SIZE ||
+        (count > 1 && entries > DIR_CACHE_MAX_ENTRIES)) {
+      dirCache.erase(it, dirCache.end());
+      break;
+    }
+  }
+}
+
+static uint32_t entryHash(const FILINFO& fno)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (const char* c = fno.fname; *c; c++) {
+    hash = (hash ^ (uint8_t)*c) * 16777619u;
+  }
+  hash = (hash ^ fno.fattrib) * 16777619u;
+  hash = (hash ^ (uint32_t)fno.fsize) * 16777619u;
+  hash = (hash ^ ((uint32_t)fno.fdate << 16 | fno.ftime)) * 16777619u;
+  return hash;
 }
 
 FileBrowser::FileBrowser(Window* parent, const rect_t& rect, const char* dir) :
@@ -179,31 +217,124 @@ FileBrowser::FileBrowser(Window* parent, const rect_t& rect, const char* dir) :
 void FileBrowser::setFileAction(FileAction fct) { fileAction = std::move(fct); }
 void FileBrowser::setFileSelected(FileAction fct) { fileSelected = std::move(fct); }
 
+FileBrowser::~FileBrowser() { stopReading(); }
+
+void FileBrowser::stopReading()
+{
+  if (reading) {
+    f_closedir(&dir);
+    reading = false;
+  }
+  pending.reset();
+}
+
 void FileBrowser::refresh()
 {
-  std::list<std::string> files;
-  std::list<std::string> directories;
-  if (scan_files(files, directories) < 0) return;
+  stopReading();
 
-  setRowCount(files.size() + directories.size());
+  const char* path = getCurrentPath();
+  auto cached = findCachedListing(path);
+  if (cached) show(cached);
+
+  if (f_opendir(&dir, ".") != FR_OK) return;
+  reading = true;
+  firstTime = true;
+  pending = std::make_shared<DirListing>();
+  pending->path = path;
 
-  uint16_t row = 0;
-  for (const auto& name: directories) {
+  // small directories are complete at once
+  readStep();
+}
 
-    // LV_SYMBOL_DIRECTORY
-    lv_table_set_cell_value(lvobj, row, 0, name.c_str());
-    lv_table_add_cell_ctrl(lvobj, row, 0, CELL_CTRL_DIR);
-    row++;
+void FileBrowser::invalidate()
+{
+  dropCachedListing(getCurrentPath());
+  refresh();
+}
+
+void FileBrowser::checkEvents()
+{
+  TableField::checkEvents();
+  if (reading) readStep();
+  if (listing && filledRows < listing->size()) fillStep();
+}
+
+void FileBrowser::readStep()
+{
+  FILINFO fno;
+  for (uint8_t i = 0; i < READ_ENTRIES_PER_CALL; i++) {
+    FRESULT res = sdReadDir(&dir, &fno, firstTime);
+    if (res != FR_OK || fno.fname[0] == 0) {
+      f_closedir(&dir);
+      reading = false;
+      break;  // Break on error or end of dir
+    }
+
+    if (fno.fattrib & (AM_HID|AM_SYS)) continue;     /* Ignore hidden and system files */
+    if (fno.fname[0] == '.' && fno.fname[1] != '.') continue; // Ignore hidden files under UNIX, but not ..
+
+    pending->fingerprint += entryHash(fno);
+    if (fno.fattrib & AM_DIR) {
+      pending->directories.push_back((char*)fno.fname);
+    } else {
+      pending->files.push_back((char*)fno.fname);
+    }
+  }
+
+  if (reading) return;
+
+  auto dirListing = std::move(pending);
+  if (listing && listing->path == dirListing->path &&
+      listing->fingerprint == dirListing->fingerprint &&
+      listing->size() == dirListing->size()) {
+    // the cached listing is still valid
+    return;
   }
 
-  for (const auto& name: files) {
-    // LV_SYMBOL_FILE
-    lv_table_set_cell_value(lvobj, row, 0, name.c_str());
-    lv_table_clear_cell_ctrl(lvobj, row, 0, CELL_CTRL_DIR);
-    row++;
+  std::sort(dirListing->directories.begin(), dirListing->directories.end(),
+            natural_compare_nocase);
+  std::sort(dirListing->files.begin(), dirListing->files.end(),
+            natural_compare_nocase);
+  cacheListing(dirListing);
+  show(dirListing);
+}
+
+void FileBrowser::show(const std::shared_ptr<DirListing>& dirListing)
+{
+  // keep the selected row when the same directory is updated
+  uint16_t row = 0, col = 0;
+  if (listing && listing->path == dirListing->path) {
+    lv_table_get_selected_cell(lvobj, &row, &col);
+    if (row >= dirListing->size()) row = 0;
   }
 
-  select(0, 0);
+  listing = dirListing;
+  filledRows = 0;
+  selected = nullptr;
+  setRowCount(listing->size());
+  fillStep();
+
+  select(row, 0);
+}
+
+void FileBrowser::fillStep()
+{
+  uint16_t dirs = listing->directories.size();
+  uint16_t rows = listing->size();
+  uint16_t last = std::min<uint16_t>(rows, filledRows + FILL_ROWS_PER_CALL);
+
+  for (uint16_t row = filledRows; row < last; row++) {
+    if (row < dirs) {
+      // LV_SYMBOL_DIRECTORY
+      lv_table_set_cell_value(lvobj, row, 0, listing->directories[row].c_str());
+      lv_table_add_cell_ctrl(lvobj, row, 0, CELL_CTRL_DIR);
+    } else {
+      // LV_SYMBOL_FILE
+      lv_table_set_cell_value(lvobj, row, 0, listing->files[row - dirs].c_str());
+      lv_table_clear_cell_ctrl(lvobj, row, 0, CELL_CTRL_DIR);
+    }
+  }
+  filledRows = last;
 }
 
 void FileBrowser::adjustWidth()
@@ -262,6 +393,8 @@ void FileBrowser::onDrawEnd(uint16_t row, uint16_t col, lv_obj_draw_part_dsc_t*
 
 void FileBrowser::onSelected(const char* name, bool is_dir)
 {
+  if (!name || !name[0]) return;  // row not filled yet
+
   if (is_dir) {
     if (fileSelected) fileSelected(nullptr, nullptr, nullptr);
     return;
@@ -275,6 +408,8 @@ void FileBrowser::onSelected(const char* name, bool is_dir)
 
 void FileBrowser::onPress(const char* name, bool is_dir)
 {
+  if (!name || !name[0]) return;  // row not filled yet
+
   const char* path = getCurrentPath();
   const char* fullpath = getFullPath(name);  
   if (is_dir) {
@@ -22,6 +22,11 @@
 #pragma once
 
 #include "table.h"
+#include "ff.h"
+
+#include <memory>
+
+struct DirListing;
 
 class FileBrowser : public TableField
 {
@@ -30,11 +35,20 @@ class FileBrowser : public TableField
   typedef std::function<void(const char*, const char*, const char*)> FileAction;
 
   FileBrowser(Window* parent, const rect_t& rect, const char* dir);
+  ~FileBrowser();
 
   void setFileAction(FileAction fct);
   void setFileSelected(FileAction fct);
+
+  // Show the current directory. A cached listing is shown at once while
+  // the directory is read again in the background.
   void refresh();
 
+  // Same as refresh(), after the current directory has been modified
+  void invalidate();
+
+  void checkEvents() override;
+
   void adjustWidth();
   
  protected:
@@ -51,4 +65,19 @@ class FileBrowser : public TableField
   const char* selected = nullptr;
   FileAction fileAction;
   FileAction fileSelected;
+
+  // background directory reading
+  DIR dir;
+  bool reading = false;
+  bool firstTime = false;
+  std::shared_ptr<DirListing> pending;
+
+  // listing being written into the table, FILL_ROWS_PER_CALL rows at a time
+  std::shared_ptr<DirListing> listing;
+  uint16_t filledRows = 0;
+
+  void stopReading();
+  void readStep();
+  void show(const std::shared_ptr<DirListing>& dirListing);
+  void fillStep();
 };
@@ -28,22 +28,17 @@ FilePreview::FilePreview(Window *parent, const rect_t &rect,
 {
 }
 
-FilePreview::~FilePreview()
-{
-  if (bitmap != nullptr) delete bitmap;
-}
-
 void FilePreview::setFile(const char *filename)
 {
-  if (bitmap != nullptr) delete bitmap;
-  bitmap = nullptr;
+  path.clear();
+  bitmap.reset();
+  bitmapWidth = bitmapHeight = 0;
+  waiting = false;
 
   if (filename) {
     const char *ext = getFileExtension(filename);
     if (ext && isExtensionMatching(ext, BITMAPS_EXT)) {
-      bitmap = BitmapBuffer::loadBitmap(filename);
-    } else {
-      bitmap = nullptr;
+      path = filename;
     }
   }
   invalidate();
@@ -61,20 +56,43 @@ coord_t FilePreview::getBitmapHeight() const
   return 0;
 }
 
+void FilePreview::load(coord_t w, coord_t h)
+{
+  bitmapWidth = w;
+  bitmapHeight = h;
+  if (w <= 0 || h <= 0) return;
+
+  // the picture is decoded (or read from its thumbnail) by
+  // bitmapCacheWakeup(), so browsing the files doesn't stall
+  bitmap = bitmapCacheGet(path.c_str(), w, h, false, false);
+  waiting = !bitmap && bitmapCachePending(path.c_str(), w, h, false);
+}
+
+void FilePreview::checkEvents()
+{
+  Window::checkEvents();
+  if (waiting &&
+      !bitmapCachePending(path.c_str(), bitmapWidth, bitmapHeight, false)) {
+    waiting = false;
+    bitmapWidth = bitmapHeight = 0;
+    invalidate();
+  }
+}
+
 void FilePreview::paint(BitmapBuffer *dc)
 {
-  if (!bitmap) return;
+  if (path.empty()) return;
 
   coord_t w = lv_obj_get_content_width(lvobj);
   coord_t h = lv_obj_get_content_height(lvobj);
-
-  coord_t bm_w = min<coord_t>(w, bitmap->width());
-  coord_t bm_h = min<coord_t>(h, bitmap->height());
+  if (w != bitmapWidth || h != bitmapHeight) load(w, h);
+  if (!bitmap) return;
 
   coord_t border_w = lv_obj_get_style_border_width(lvobj, 0);
   coord_t x = border_w + lv_obj_get_style_pad_left(lvobj, 0);
   coord_t y = border_w + lv_obj_get_style_pad_top(lvobj, 0);
 
   dc->setFormat(BMP_RGB565);
-  dc->drawScaledBitmap(bitmap, x + (w - bm_w) / 2, y + (h - bm_h) / 2, bm_w, bm_h);
+  dc->drawBitmap(x + (w - bitmap->width()) / 2, y + (h - bitmap->height()) / 2,
+                 bitmap.get());
 }
@@ -21,12 +21,12 @@
 
 #pragma once
 #include "libopenui.h"
+#include "bitmap_cache.h"
 
 class FilePreview : public Window
 {
  public:
   FilePreview(Window *parent, const rect_t &rect, bool drawCentered = true);
-  ~FilePreview();
 
 #if defined(DEBUG_WINDOWS)
   std::string getName() const override { return "FilePreview"; }
@@ -36,9 +36,16 @@ class FilePreview : public Window
   coord_t getBitmapWidth() const;
   coord_t getBitmapHeight() const;
 
+  void checkEvents() override;
   void paint(BitmapBuffer *dc) override;
 
  protected:
-  BitmapBuffer *bitmap = nullptr;
+  std::string path;
+  SharedBitmap bitmap;
+  coord_t bitmapWidth = 0;   // size the picture has been requested at
+  coord_t bitmapHeight = 0;
+  bool waiting = false;
   bool _drawCentered = true;
+
+  void load(coord_t w, coord_t h);
 };
@@ -47,8 +47,120 @@
   FONT_TABLE(roboto);
 #endif
 
+#if defined(SDRAM)
+  #define GLYPH_CACHE
+#endif
+
 #endif // BOOT
 
+#if defined(GLYPH_CACHE)
+// The larger fonts are compressed and LVGL decompresses each glyph every
+// time it is drawn. The decompressed bitmaps are kept in a 4-way set
+// associative cache in SDRAM (LRU inside each set), in two slot sizes.
+// Labels and BitmapBuffer::drawSizedText() both use it, as both get the
+// glyphs from the font's get_glyph_bitmap().
+#define GLYPH_CACHE_WAYS        4
+#define GLYPH_SMALL_SETS        128
+#define GLYPH_SMALL_SIZE        128
+#define GLYPH_LARGE_SETS        32
+#define GLYPH_LARGE_SIZE        2048
+
+struct GlyphCacheEntry {
+  const lv_font_t* font;
+  uint32_t letter;
+  uint32_t stamp;
+};
+
+struct GlyphCacheSet {
+  GlyphCacheEntry* entries;
+  uint8_t* data;
+  uint16_t sets;
+  uint16_t slotSize;
+};
+
+static GlyphCacheEntry glyphSmallEntries[GLYPH_SMALL_SETS * GLYPH_CACHE_WAYS] __SDRAM;
+static uint8_t glyphSmallData[GLYPH_SMALL_SETS * GLYPH_CACHE_WAYS * GLYPH_SMALL_SIZE] __SDRAM;
+static GlyphCacheEntry glyphLargeEntries[GLYPH_LARGE_SETS * GLYPH_CACHE_WAYS] __SDRAM;
+static uint8_t glyphLargeData[GLYPH_LARGE_SETS * GLYPH_CACHE_WAYS * GLYPH_LARGE_SIZE] __SDRAM;
+
+static const GlyphCacheSet glyphCaches[] = {
+  { glyphSmallEntries, glyphSmallData, GLYPH_SMALL_SETS, GLYPH_SMALL_SIZE },
+  { glyphLargeEntries, glyphLargeData, GLYPH_LARGE_SETS, GLYPH_LARGE_SIZE },
+};
+
+static uint32_t glyphCacheStamp = 0;
+
+// Fonts with a cached get_glyph_bitmap(), copies of the compressed ones
+static lv_font_t cachedFonts[FONTS_COUNT];
+
+static const uint8_t* getCachedGlyphBitmap(const lv_font_t* font, uint32_t letter)
+{
+  lv_font_glyph_dsc_t g;
+  if (!font->get_glyph_dsc(font, &g, letter, 0))
+    return lv_font_get_bitmap_fmt_txt(font, letter);
+
+  // size of the decompressed bitmap (3 bpp is decompressed to 4 bpp)
+  uint32_t bpp = g.bpp == 3 ? 4 : g.bpp;
+  uint32_t size = ((uint32_t)g.box_w * g.box_h * bpp + 7) / 8;
+
+  const GlyphCacheSet* cache = nullptr;
+  for (const auto& c : glyphCaches) {
+    if (size <= c.slotSize) {
+      cache = &c;
+      break;
+    }
+  }
+  if (!cache || size == 0)
+    return lv_font_get_bitmap_fmt_txt(font, letter);
+
+  uint32_t set = ((uintptr_t)font * 31 + letter) % cache->sets;
+  GlyphCacheEntry* ways = &cache->entries[set * GLYPH_CACHE_WAYS];
+  GlyphCacheEntry* victim = &ways[0];
+  for (uint8_t i = 0; i < GLYPH_CACHE_WAYS; i++) {
+    GlyphCacheEntry* e = &ways[i];
+    if (e->font == font && e->letter == letter) {
+      e->stamp = ++glyphCacheStamp;
+      return &cache->data[(set * GLYPH_CACHE_WAYS + i) * cache->slotSize];
+    }
+    if (e->stamp < victim->stamp) victim = e;
+  }
+
+  const uint8_t* bitmap = lv_font_get_bitmap_fmt_txt(font, letter);
+  if (!bitmap) return nullptr;
+
+  uint8_t* slot = &cache->data[(victim - cache->entries) * cache->slotSize];
+  memcpy(slot, bitmap, size);
+  victim->font = font;
+  victim->letter = letter;
+  victim->stamp = ++glyphCacheStamp;
+  return slot;
+}
+
+static const lv_font_t* getCachedFont(uint8_t fontIndex)
+{
+  static bool cacheCleared = false;
+  if (!cacheCleared) {
+    // SDRAM is not cleared at startup
+    for (const auto& c : glyphCaches)
+      memset(c.entries, 0, c.sets * GLYPH_CACHE_WAYS * sizeof(GlyphCacheEntry));
+    cacheCleared = true;
+  }
+
+  lv_font_t* font = &cachedFonts[fontIndex];
+  if (!font->get_glyph_bitmap) {
+    *font = *lvglFontTable[fontIndex];
+    auto dsc = (const lv_font_fmt_txt_dsc_t*)font->dsc;
+    if (font->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt &&
+        dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+      font->get_glyph_bitmap = getCachedGlyphBitmap;
+    }
+  }
+  return font->get_glyph_bitmap == getCachedGlyphBitmap
+             ? font
+             : lvglFontTable[fontIndex];
+}
+#endif
+
 // used to set the line height to the line heights used in Edgetx < 2.7 and OpenTX
 static const int8_t FontHeightCorrection[FONTS_COUNT] {
   -2, // STD
@@ -67,8 +179,12 @@ const lv_font_t* getFont(LcdFlags flags)
 #else
   auto fontIndex = FONT_INDEX(flags);
   if (fontIndex >= FONTS_COUNT) return LV_FONT_DEFAULT;
+#if defined(GLYPH_CACHE)
+  return getCachedFont(fontIndex);
+#else
   return lvglFontTable[fontIndex];
 #endif
+#endif
 }
 
 uint8_t getFontHeight(LcdFlags flags)
@@ -56,12 +56,34 @@ static const lv_coord_t row_dsc[] = {LV_GRID_CONTENT,
                                      LV_GRID_TEMPLATE_LAST};
 #endif
 
+lv_coord_t InputMixButton::lineHeight = 0;
+
 InputMixButton::InputMixButton(Window* parent, uint8_t index) :
     ListLineButton(parent, index)
 {
   lv_obj_set_layout(lvobj, LV_LAYOUT_GRID);
   lv_obj_set_grid_dsc_array(lvobj, col_dsc, row_dsc);
 
+  if (!lineHeight) {
+    lineHeight = lv_font_get_line_height(getFont(FONT(STD))) +
+                 lv_obj_get_style_pad_top(lvobj, LV_PART_MAIN) +
+                 lv_obj_get_style_pad_bottom(lvobj, LV_PART_MAIN);
+  }
+  lv_obj_set_style_min_height(lvobj, lineHeight, LV_PART_MAIN);
+
+  lv_obj_add_event_cb(lvobj, InputMixButton::on_draw,
+                      LV_EVENT_DRAW_MAIN_BEGIN, nullptr);
+}
+
+void InputMixButton::on_draw(lv_event_t* e)
+{
+  lv_obj_t* target = lv_event_get_target(e);
+  auto line = (InputMixButton*)lv_obj_get_user_data(target);
+  if (line && !line->init) line->delayed_init(e);
+}
+
+void InputMixButton::delayed_init(lv_event_t* e)
+{
   weight = lv_label_create(lvobj);
   lv_obj_set_grid_cell(weight, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_START, 0, 1);
   
@@ -74,6 +96,18 @@ InputMixButton::InputMixButton(Window* parent, uint8_t index) :
 #else
   lv_obj_set_grid_cell(opts, LV_GRID_ALIGN_STRETCH, 2, 1, LV_GRID_ALIGN_START, 0, 2);
 #endif
+
+  init = true;
+  refresh();
+
+  lv_obj_set_style_min_height(lvobj, 0, LV_PART_MAIN);
+  lv_obj_update_layout(lvobj);
+  lineHeight = lv_obj_get_height(lvobj);
+
+  if (e) {
+    auto param = lv_event_get_param(e);
+    lv_event_send(lvobj, LV_EVENT_DRAW_MAIN, param);
+  }
 }
 
 InputMixButton::~InputMixButton()
@@ -30,14 +30,24 @@ class InputMixButton : public ListLineButton
   void* fm_buffer = nullptr;
   uint16_t fm_modes = 0;
 
+  // height of the last line built, used for the lines not built yet
+  static lv_coord_t lineHeight;
+
+  static void on_draw(lv_event_t* e);
+
  public:
   InputMixButton(Window* parent, uint8_t index);
   ~InputMixButton();
 
  protected:
-  lv_obj_t* weight;
-  lv_obj_t* source;
-  lv_obj_t* opts;
+  // the labels are only created once the line is drawn for the first time,
+  // so that the lines scrolled out of view cost a bare button
+  bool init = false;
+  lv_obj_t* weight = nullptr;
+  lv_obj_t* source = nullptr;
+  lv_obj_t* opts = nullptr;
+
+  void delayed_init(lv_event_t* e);
 
   void setWeight(gvar_t value, gvar_t min, gvar_t max);
   void setSource(mixsrc_t idx);
@@ -130,7 +130,7 @@ void loadCustomScreens()
     viewMain->setCurrentMainView(g_model.view);
   } else if (viewMain->getMainViewsCount() > 0) {
     g_model.view = viewMain->getMainViewsCount() - 1;
-    storageDirty(EE_MODEL);
+    storageDirty(EE_SCREENS);
     viewMain->setCurrentMainView(g_model.view);
   }
   // else {
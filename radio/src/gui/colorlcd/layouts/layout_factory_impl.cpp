@@ -133,8 +133,22 @@ rect_t Layout::getMainZone() const
 
 rect_t Layout::getZone(unsigned int index) const
 {
-  rect_t z = getMainZone();
+  if (index >= zoneCount) return computeZone(getMainZone(), index);
+
+  // zones only move when the decoration settings change
+  if (zoneRectsSettings != decorationSettings) {
+    rect_t z = getMainZone();
+    for (unsigned int i = 0; i < zoneCount; i++) {
+      zoneRects[i] = computeZone(z, i);
+    }
+    zoneRectsSettings = decorationSettings;
+  }
+
+  return zoneRects[index];
+}
 
+rect_t Layout::computeZone(const rect_t& z, unsigned int index) const
+{
   unsigned int i = index * 4;
 
   coord_t xo = z.w * zoneMap[i] / LAYOUT_MAP_DIV;
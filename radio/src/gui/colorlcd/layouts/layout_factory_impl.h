@@ -137,9 +137,15 @@ class Layout: public LayoutBase
     // Last time we refreshed the window
     uint32_t lastRefresh = 0;
   
+    // Zones computed for these decoration settings
+    mutable rect_t zoneRects[MAX_LAYOUT_ZONES];
+    mutable uint8_t zoneRectsSettings = DECORATION_UNKNOWN;
+
     // Get the available space for widgets
     rect_t getMainZone() const;
 
+    rect_t computeZone(const rect_t& mainZone, unsigned int index) const;
+
     unsigned int getZonesCount() const override { return zoneCount; }
     rect_t getZone(unsigned int index) const override;
 };
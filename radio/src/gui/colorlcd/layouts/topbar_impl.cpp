@@ -22,7 +22,6 @@
 #include "topbar_impl.h"
 #include "opentx.h"
 
-constexpr uint32_t TOPBAR_REFRESH = 1000 / 10; // 10 Hz
 
 TopBar::TopBar(Window * parent) :
   TopBarBase(parent, {0, 0, LCD_W, MENU_HEADER_HEIGHT}, &g_model.topbarData)
@@ -51,16 +50,22 @@ rect_t TopBar::getZone(unsigned int index) const
 
 void TopBar::setVisible(float visible) // 0.0 -> 1.0
 {
+  coord_t top;
   if (visible == 0.0) {
-    setTop(-(int)MENU_HEADER_HEIGHT);
+    top = -(int)MENU_HEADER_HEIGHT;
   }
   else if (visible == 1.0) {
-    setTop(0);
+    top = 0;
   }
   else if (visible > 0.0 && visible < 1.0){
-    float top = - (float)MENU_HEADER_HEIGHT * (1.0 - visible);
-    setTop((coord_t)top);
+    top = (coord_t)(- (float)MENU_HEADER_HEIGHT * (1.0 - visible));
   }
+  else {
+    return;
+  }
+
+  // called on each scroll event while swiping between views
+  if (top != rect.y) setTop(top);
 }
 
 coord_t TopBar::getVisibleHeight(float visible) const // 0.0 -> 1.0
@@ -84,11 +89,8 @@ void TopBar::paint(BitmapBuffer * dc)
 
 void TopBar::checkEvents()
 {
-  uint32_t now = RTOS_GET_MS();
-  if (now - lastRefresh >= TOPBAR_REFRESH) {
-    lastRefresh = now;
-    invalidate();
-  }
+  // widgets redraw themselves when what they show changes
+  TopBarBase::checkEvents();
 }
 
 void TopBar::removeWidget(unsigned int index)
@@ -57,7 +57,4 @@ class TopBar: public TopBarBase
     bool isTopBar() override { return true; }
 
     void removeWidget(unsigned int index) override;
-
-  protected:
-    uint32_t lastRefresh = 0;
 };
@@ -58,23 +58,104 @@ void lcdSetFlushCb(void (*cb)(lv_disp_drv_t *, uint16_t*, const rect_t&))
 
 static lv_disp_drv_t* refr_disp = nullptr;
 
-#if !defined(LCD_VERTICAL_INVERT) && 0
-// TODO: DMA copy would be possible (use function from draw_ctx???
-static void _copy_screen_area(uint16_t* dst, uint16_t* src, const lv_area_t& copy_area)
+#if !defined(LCD_VERTICAL_INVERT)
+// In direct mode, both frame buffers have to be kept in sync: the areas
+// refreshed in the previous frame are copied into the current buffer, except
+// the parts that have been redrawn in this frame anyway. This is done just
+// before the buffer is sent to the display, when both lists are known.
+#define LCD_SYNC_AREAS_MAX  LV_INV_BUF_SIZE
+
+static lv_area_t sync_areas[LCD_SYNC_AREAS_MAX];
+static uint8_t sync_count = 0;
+
+static lv_area_t refr_areas[LCD_SYNC_AREAS_MAX];
+static uint8_t refr_count = 0;
+
+// Collects the refreshed areas of the current frame, merging the
+// overlapping ones when their union is not larger than both of them
+static void _collect_refr_areas(lv_disp_t* disp)
 {
-  lv_coord_t x1 = copy_area.x1;
-  lv_coord_t y1 = copy_area.y1;
-  lv_coord_t area_w = copy_area.x2 - copy_area.x1 + 1;
-
-  auto offset = y1 * LCD_W + x1;
-  auto px_src = src + offset;
-  auto px_dst = dst + offset;
-
-  for (auto line = copy_area.y1; line <= copy_area.y2; line++) {
-    memcpy(px_dst, px_src, area_w * sizeof(uint16_t));
-    px_dst += LCD_W;
-    px_src += LCD_W;
+  refr_count = 0;
+  for (int i = 0; i < disp->inv_p && refr_count < LCD_SYNC_AREAS_MAX; i++) {
+    if (disp->inv_area_joined[i]) continue;
+    refr_areas[refr_count++] = disp->inv_areas[i];
   }
+
+  bool merged;
+  do {
+    merged = false;
+    for (uint8_t i = 0; i < refr_count; i++) {
+      for (uint8_t j = i + 1; j < refr_count; j++) {
+        if (!_lv_area_is_on(&refr_areas[i], &refr_areas[j])) continue;
+
+        lv_area_t joined;
+        _lv_area_join(&joined, &refr_areas[i], &refr_areas[j]);
+        if (lv_area_get_size(&joined) > lv_area_get_size(&refr_areas[i]) +
+                                            lv_area_get_size(&refr_areas[j]))
+          continue;
+
+        refr_areas[i] = joined;
+        refr_areas[j] = refr_areas[--refr_count];
+        merged = true;
+        j = i;
+      }
+    }
+  } while (merged);
+}
+
+static void _copy_sync_area(uint16_t* dst, uint16_t* src, const lv_area_t& area)
+{
+  DMACopyBitmap(dst, LCD_W, LCD_H, area.x1, area.y1,
+                src, LCD_W, LCD_H, area.x1, area.y1,
+                lv_area_get_width(&area), lv_area_get_height(&area));
+}
+
+// Copies what is left of area once the refreshed areas from index
+// 'first' are taken out of it
+static void _sync_area(uint16_t* dst, uint16_t* src, const lv_area_t& area,
+                       uint8_t first)
+{
+  for (uint8_t i = first; i < refr_count; i++) {
+    const lv_area_t& refr = refr_areas[i];
+    if (!_lv_area_is_on(&area, &refr)) continue;
+    if (_lv_area_is_in(&area, &refr, 0)) return;
+
+    // up to 4 parts around the refreshed area
+    lv_area_t part;
+    if (area.y1 < refr.y1) {
+      part = {area.x1, area.y1, area.x2, (lv_coord_t)(refr.y1 - 1)};
+      _sync_area(dst, src, part, i + 1);
+    }
+    if (area.y2 > refr.y2) {
+      part = {area.x1, (lv_coord_t)(refr.y2 + 1), area.x2, area.y2};
+      _sync_area(dst, src, part, i + 1);
+    }
+    lv_coord_t y1 = LV_MAX(area.y1, refr.y1);
+    lv_coord_t y2 = LV_MIN(area.y2, refr.y2);
+    if (area.x1 < refr.x1) {
+      part = {area.x1, y1, (lv_coord_t)(refr.x1 - 1), y2};
+      _sync_area(dst, src, part, i + 1);
+    }
+    if (area.x2 > refr.x2) {
+      part = {(lv_coord_t)(refr.x2 + 1), y1, area.x2, y2};
+      _sync_area(dst, src, part, i + 1);
+    }
+    return;
+  }
+
+  _copy_sync_area(dst, src, area);
+}
+
+static void _sync_buffers(uint16_t* dst, uint16_t* src)
+{
+  for (uint8_t i = 0; i < sync_count; i++) {
+    _sync_area(dst, src, sync_areas[i], 0);
+  }
+  DMAWait();
+
+  // what has been refreshed now has to be copied into the other buffer
+  memcpy(sync_areas, refr_areas, refr_count * sizeof(lv_area_t));
+  sync_count = refr_count;
 }
 #endif
 
@@ -106,30 +187,23 @@ static void flushLcd(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_
                         area->x2 - area->x1 + 1,
                         area->y2 - area->y1 + 1};
 
-    lcd_flush_cb(disp_drv, (uint16_t*)color_p, copy_area);
-
 #if !defined(LCD_VERTICAL_INVERT)
-    uint16_t* src = (uint16_t*)color_p;
-    uint16_t* dst = nullptr;
+    uint16_t* dst = (uint16_t*)color_p;
+    uint16_t* src = nullptr;
     if ((uint16_t*)color_p == LCD_FIRST_FRAME_BUFFER)
-      dst = LCD_SECOND_FRAME_BUFFER;
+      src = LCD_SECOND_FRAME_BUFFER;
     else
-      dst = LCD_FIRST_FRAME_BUFFER;
+      src = LCD_FIRST_FRAME_BUFFER;
 
-    lv_disp_t* disp = _lv_refr_get_disp_refreshing();
-    for(int i = 0; i < disp->inv_p; i++) {
-      if(disp->inv_area_joined[i]) continue;
-
-      const lv_area_t& refr_area = disp->inv_areas[i];
+    // bring the parts of this buffer which have not been refreshed
+    // up to date with the displayed one before it is displayed
+    _collect_refr_areas(_lv_refr_get_disp_refreshing());
+    _sync_buffers(dst, src);
+#endif
 
-      auto area_w = refr_area.x2 - refr_area.x1 + 1;
-      auto area_h = refr_area.y2 - refr_area.y1 + 1;
+    lcd_flush_cb(disp_drv, (uint16_t*)color_p, copy_area);
 
-      DMACopyBitmap(dst, LCD_W, LCD_H, refr_area.x1, refr_area.y1,
-                    src, LCD_W, LCD_H, refr_area.x1, refr_area.y1,
-                    area_w, area_h);      
-    }
-    
+#if !defined(LCD_VERTICAL_INVERT)
     lv_disp_flush_ready(disp_drv);
 #endif
   } else {
@@ -22,6 +22,28 @@
 #include "lz4_bitmaps.h"
 #include "libopenui/thirdparty/lz4/lz4.h"
 #include "opentx_helpers.h"
+#include "definitions.h"
+
+// The masks are decoded once on first use and kept for the whole run, so
+// they are packed one after the other in a single buffer instead of being
+// spread over the heap. Masks that do not fit anymore are malloc'ed.
+#if !defined(LZ4_ATLAS_SIZE)
+  #define LZ4_ATLAS_SIZE  (64 * 1024)
+#endif
+
+static uint8_t atlas[LZ4_ATLAS_SIZE] __SDRAM;
+static uint32_t atlasUsed = 0;
+
+static uint8_t* atlasAlloc(uint32_t size)
+{
+  if (atlasUsed + size > LZ4_ATLAS_SIZE) {
+    return (uint8_t*)malloc(size);
+  }
+
+  uint8_t* mem = &atlas[atlasUsed];
+  atlasUsed += size;
+  return mem;
+}
 
 const uint8_t* _decompressed_mask(const uint8_t* lz4_compressed, uint8_t** raw)
 {
@@ -36,7 +58,7 @@ const uint8_t* _decompressed_mask(const uint8_t* lz4_compressed, uint8_t** raw)
     lz4_compressed += 8;
 
     uint32_t pixels = width * height;
-    *raw = (uint8_t*)malloc(align32(pixels + 4));
+    *raw = atlasAlloc(align32(pixels + 4));
 
     uint16_t* raw_hdr = (uint16_t*)*raw;
     raw_hdr[0] = width;
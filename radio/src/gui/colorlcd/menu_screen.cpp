@@ -32,7 +32,7 @@ ScreenMenu::ScreenMenu(int8_t tabIdx):
 
   setCloseHandler([]{
       ViewMain::instance()->updateTopbarVisibility();
-      storageDirty(EE_MODEL);
+      storageDirty(EE_SCREENS);
   });
 }
 
@@ -113,6 +113,8 @@ class InputLineButton : public InputMixButton
 
   void refresh() override
   {
+    if (!init) return;
+
     const ExpoData &line = g_model.expoData[index];
     setWeight(line.weight, -100, 100);
     setSource(line.srcRaw);
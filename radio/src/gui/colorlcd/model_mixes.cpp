@@ -253,6 +253,8 @@ void MixLineButton::deleteLater(bool detach, bool trash)
 
 void MixLineButton::refresh()
 {
+  if (!init) return;
+
   const MixData& line = g_model.mixData[index];
   setWeight(line.weight, MIX_WEIGHT_MIN, MIX_WEIGHT_MAX);
   setSource(line.srcRaw);
@@ -25,6 +25,7 @@
 #include "channel_bar.h"
 
 #include "opentx.h"
+#include "tasks/mixer_task.h"
 
 #define SET_DIRTY() storageDirty(EE_MODEL)
 
@@ -235,7 +236,7 @@ class OutputLineButton : public ListLineButton
     Window::checkEvents();
     if (!init) return;
 
-    int newValue = channelOutputs[index];
+    int newValue = mixerGetChannelOutput(index);
     if (value != newValue) {
       value = newValue;
 
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <vector>
 
+#include "bitmap_cache.h"
 #include "libopenui.h"
 #include "listbox.h"
 #include "model_templates.h"
@@ -250,42 +251,24 @@ class ModelButton : public Button
     setHeight(MODEL_SELECT_CELL_HEIGHT);
   }
 
-  ~ModelButton()
+  void load()
   {
-    if (buffer) {
-      delete buffer;
-    }
+    // Pictures are decoded by bitmapCacheWakeup(), one per GUI cycle, so
+    // that scrolling through the models doesn't stall on each of them
+    GET_FILENAME(filename, BITMAPS_PATH, modelCell->modelBitmap, "");
+    bitmap = bitmapCacheGet(filename, width(), height(), false);
+    waiting = !bitmap && bitmapCachePending(filename, width(), height());
   }
 
-  void load()
+  void checkEvents() override
   {
-    const char *error = nullptr;
-
-    delete buffer;
-    buffer = new BitmapBuffer(BMP_RGB565, width(), height());
-    if (buffer == nullptr) {
-      return;
-    }
-    buffer->clear(COLOR_THEME_PRIMARY2);
-
-    if (error) {
-      std::string errorMsg = "(";
-      errorMsg += STR_INVALID_MODEL;
-      errorMsg += ")";
-      buffer->drawText(width() / 2, height() / 2, errorMsg.c_str(),
-                       COLOR_THEME_SECONDARY1 | CENTERED);
-    } else {
+    Button::checkEvents();
+    if (waiting) {
       GET_FILENAME(filename, BITMAPS_PATH, modelCell->modelBitmap, "");
-      const BitmapBuffer *bitmap = BitmapBuffer::loadBitmap(filename);
-      if (bitmap) {
-        buffer->drawScaledBitmap(bitmap, 0, 0, width(), height());
-        delete bitmap;
-      } else {
-        std::string errorMsg = "(";
-        errorMsg += STR_NO_PICTURE;
-        errorMsg += ")";
-        buffer->drawText(width() / 2, 56, errorMsg.c_str(),
-                         FONT(XXS) | COLOR_THEME_SECONDARY1 | CENTERED);
+      if (!bitmapCachePending(filename, width(), height())) {
+        waiting = false;
+        loaded = false;
+        invalidate();
       }
     }
   }
@@ -298,7 +281,17 @@ class ModelButton : public Button
     }
     FormField::paint(dc);
 
-    if (buffer) dc->drawBitmap(0, 0, buffer);
+    dc->drawSolidFilledRect(0, 0, width(), height(), COLOR_THEME_PRIMARY2);
+    if (bitmap) {
+      dc->drawBitmap((width() - bitmap->width()) / 2,
+                     (height() - bitmap->height()) / 2, bitmap.get());
+    } else if (!waiting) {
+      std::string errorMsg = "(";
+      errorMsg += STR_NO_PICTURE;
+      errorMsg += ")";
+      dc->drawText(width() / 2, 56, errorMsg.c_str(),
+                   FONT(XXS) | COLOR_THEME_SECONDARY1 | CENTERED);
+    }
 
     if (modelCell == modelslist.getCurrentModel()) {
       dc->drawSolidFilledRect(0, 0, width(), 20, COLOR_THEME_ACTIVE);
@@ -327,8 +320,9 @@ class ModelButton : public Button
 
  protected:
   bool loaded = false;
+  bool waiting = false;
   ModelCell *modelCell;
-  BitmapBuffer *buffer = nullptr;
+  SharedBitmap bitmap;
   std::function<void()> m_setSelected = nullptr;
 
   void onClicked() override {
@@ -369,6 +363,29 @@ ModelsPageBody::ModelsPageBody(Window *parent, const rect_t &rect) :
   padRow(MODEL_CELL_PADDING);
 }
 
+ModelsPageBody::~ModelsPageBody()
+{
+  releasePreloadedModel();
+}
+
+// highlighted model is read once the focus stopped moving for that long
+#define MODEL_PRELOAD_DELAY 50 /*0.5s*/
+
+void ModelsPageBody::checkEvents()
+{
+  FormWindow::checkEvents();
+
+  if (focusedModel != preloadCandidate) {
+    preloadCandidate = focusedModel;
+    preloadTime = get_tmr10ms();
+  } else if (preloadCandidate &&
+             preloadCandidate != modelslist.getCurrentModel() &&
+             (tmr10ms_t)(get_tmr10ms() - preloadTime) >= MODEL_PRELOAD_DELAY) {
+    preloadModel(preloadCandidate->modelFilename);
+    preloadCandidate = nullptr;
+  }
+}
+
 void ModelsPageBody::selectModel(ModelCell *model)
 {
   // Don't need to check connection to receiver if re-selecting the active model
@@ -36,6 +36,9 @@ class ModelsPageBody : public FormWindow
 {
  public:
   ModelsPageBody(Window *parent, const rect_t &rect);
+  ~ModelsPageBody();
+
+  void checkEvents() override;
 
   void update();
 
@@ -63,6 +66,8 @@ class ModelsPageBody : public FormWindow
   std::string selectedLabel;
   LabelsVector selectedLabels;
   ModelCell *focusedModel = nullptr;
+  ModelCell *preloadCandidate = nullptr;
+  tmr10ms_t preloadTime = 0;
   std::function<void()> refreshLabels = nullptr;
 
   void openMenu();
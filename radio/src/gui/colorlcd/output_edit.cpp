@@ -24,6 +24,7 @@
 #include "gvar_numberedit.h"
 
 #include "opentx.h"
+#include "tasks/mixer_task.h"
 
 #define SET_DIRTY() storageDirty(EE_MODEL)
 
@@ -76,11 +77,11 @@ OutputEditWindow::OutputEditWindow(uint8_t channel) :
 
 void OutputEditWindow::checkEvents()
 {
-  int newValue = channelOutputs[channel];
+  int newValue = mixerGetChannelOutput(channel);
   if (value != newValue) {
     value = newValue;
 
-    int chanVal = calcRESXto100(ex_chans[channel]);
+    int chanVal = calcRESXto100(mixerGetMixOutput(channel));
 
     if(chanVal < -DEADBAND) {
       lv_obj_set_style_text_font(minEdit->getLvObj(), getFont(FONT(BOLD)), 0);   
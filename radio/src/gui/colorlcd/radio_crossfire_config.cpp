@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "radio_crossfire_config.h"
+#include "opentx.h"
+#include "libopenui.h"
+#include "confirm_dialog.h"
+#include "telemetry/crossfire.h"
+#include "telemetry/crossfire_params.h"
+
+static const lv_coord_t col_dsc[] = {LV_GRID_FR(1), LV_GRID_FR(1),
+                                     LV_GRID_TEMPLATE_LAST};
+static const lv_coord_t row_dsc[] = {LV_GRID_CONTENT,
+                                     LV_GRID_TEMPLATE_LAST};
+
+// rebuilt at most every so often while the fields are read
+#define REBUILD_PERIOD  50  // 10ms ticks
+
+static std::string getFieldText(uint8_t id)
+{
+  CrossfireParam param;
+  uint8_t buffer[CRSF_PARAM_MAX_SIZE];
+  if (!crossfireParamsGetField(id, param, buffer) || !param.text) return "";
+  return param.text;
+}
+
+static int getFieldValue(uint8_t id)
+{
+  CrossfireParam param;
+  uint8_t buffer[CRSF_PARAM_MAX_SIZE];
+  return crossfireParamsGetField(id, param, buffer) ? param.value : 0;
+}
+
+static void setFieldValue(uint8_t id, int value)
+{
+  CrossfireParam param;
+  uint8_t buffer[CRSF_PARAM_MAX_SIZE];
+  if (crossfireParamsGetField(id, param, buffer)) {
+    crossfireParamsWriteValue(param, value);
+  }
+}
+
+RadioCrossfireConfig::RadioCrossfireConfig(uint8_t moduleIdx) :
+    Page(ICON_RADIO_TOOLS), moduleIdx(moduleIdx)
+{
+  header.setTitle(moduleIdx == INTERNAL_MODULE ? STR_INTERNALRF : STR_EXTERNALRF);
+  header.setTitle2("CRSF");
+
+  crossfireParamsStart(moduleIdx);
+  structureRevision = crossfireParamsStructureRevision();
+  valuesRevision = crossfireParamsValuesRevision();
+  rebuild();
+}
+
+RadioCrossfireConfig::~RadioCrossfireConfig()
+{
+  crossfireParamsStop();
+}
+
+void RadioCrossfireConfig::onCancel()
+{
+  if (address && folder) {
+    CrossfireParam param;
+    uint8_t buffer[CRSF_PARAM_MAX_SIZE];
+    folder = crossfireParamsGetField(folder, param, buffer) ? param.parent : 0;
+    rebuild();
+  } else if (address && crossfireParamsDevicesCount() > 1) {
+    address = 0;
+    rebuild();
+  } else {
+    Page::onCancel();
+  }
+}
+
+void RadioCrossfireConfig::selectDevice(uint8_t device)
+{
+  address = device;
+  folder = 0;
+  cacheSaved = false;
+  confirmField = 0;
+  crossfireParamsSelectDevice(device);
+  rebuild();
+}
+
+void RadioCrossfireConfig::rebuild()
+{
+  numberEdits.clear();
+  choices.clear();
+  body.clear();
+
+  form = new FormWindow(&body, rect_t{});
+  form->setFlexLayout();
+  form->padAll(lv_dpx(8));
+
+  if (address)
+    buildFields();
+  else
+    buildDevices();
+
+  structureRevision = crossfireParamsStructureRevision();
+  nextRebuild = get_tmr10ms() + REBUILD_PERIOD;
+}
+
+void RadioCrossfireConfig::buildDevices()
+{
+  uint8_t count = crossfireParamsDevicesCount();
+  if (count == 0) {
+    new StaticText(form, rect_t{}, STR_WAITING, 0, COLOR_THEME_PRIMARY1);
+    return;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    CrossfireDevice device;
+    if (!crossfireParamsGetDevice(i, device)) continue;
+    uint8_t deviceAddress = device.address;
+    auto button = new TextButton(form, rect_t{}, device.name, [=]() -> uint8_t {
+      selectDevice(deviceAddress);
+      return 0;
+    });
+    button->setWidth(lv_pct(100));
+  }
+}
+
+void RadioCrossfireConfig::buildFields()
+{
+  FlexGridLayout grid(col_dsc, row_dsc, 2);
+
+  uint8_t count = crossfireParamsFieldsCount();
+  if (crossfireParamsFieldsLoaded() < count) {
+    auto line = form->newLine(&grid);
+    new StaticText(line, rect_t{}, STR_WAITING, 0, COLOR_THEME_PRIMARY1);
+    new DynamicText(line, rect_t{}, [=]() {
+      return std::to_string(crossfireParamsFieldsLoaded()) + "/" +
+             std::to_string(crossfireParamsFieldsCount());
+    });
+  }
+
+  for (uint8_t id = 1; id <= count; id++) {
+    CrossfireParam param;
+    uint8_t buffer[CRSF_PARAM_MAX_SIZE];
+    if (!crossfireParamsGetField(id, param, buffer) || param.hidden ||
+        param.parent != folder)
+      continue;
+
+    if (param.type == CRSF_FOLDER) {
+      auto button = new TextButton(form, rect_t{}, param.name, [=]() -> uint8_t {
+        folder = id;
+        rebuild();
+        return 0;
+      });
+      button->setWidth(lv_pct(100));
+      continue;
+    }
+
+    auto line = form->newLine(&grid);
+    switch (param.type) {
+      case CRSF_UINT8:
+      case CRSF_INT8:
+      case CRSF_UINT16:
+      case CRSF_INT16:
+      case CRSF_UINT32:
+      case CRSF_INT32:
+      case CRSF_FLOAT:
+      {
+        new StaticText(line, rect_t{}, param.name, 0, COLOR_THEME_PRIMARY1);
+        LcdFlags flags = 0;
+        if (param.type == CRSF_FLOAT && param.prec == 1) flags = PREC1;
+        else if (param.type == CRSF_FLOAT && param.prec >= 2) flags = PREC2;
+        auto edit = new NumberEdit(
+            line, rect_t{}, param.min, param.max,
+            [=]() { return getFieldValue(id); },
+            [=](int value) { setFieldValue(id, value); }, 0, flags);
+        if (param.type == CRSF_FLOAT && param.step > 0) edit->setStep(param.step);
+        if (param.unit && param.unit[0]) edit->setSuffix(std::string(" ") + param.unit);
+        numberEdits.push_back(edit);
+        break;
+      }
+
+      case CRSF_TEXT_SELECTION:
+      {
+        new StaticText(line, rect_t{}, param.name, 0, COLOR_THEME_PRIMARY1);
+        std::vector<std::string> values;
+        char option[32];
+        for (int i = param.min; i <= param.max; i++) {
+          std::string value = crossfireParamOption(param, i, option, sizeof(option));
+          if (param.unit && param.unit[0]) value += param.unit;
+          values.push_back(value);
+        }
+        auto choice = new Choice(
+            line, rect_t{}, values, param.min, param.max,
+            [=]() { return getFieldValue(id); },
+            [=](int value) { setFieldValue(id, value); });
+        // empty options are not available
+        int vmin = param.min;
+        choice->setAvailableHandler([=](int value) {
+          return value - vmin < (int)values.size() && !values[value - vmin].empty();
+        });
+        choices.push_back(choice);
+        break;
+      }
+
+      case CRSF_COMMAND:
+      {
+        new TextButton(line, rect_t{}, param.name, [=]() -> uint8_t {
+          CrossfireParam command;
+          uint8_t data[CRSF_PARAM_MAX_SIZE];
+          if (crossfireParamsGetField(id, command, data)) {
+            crossfireParamsCommand(command, CRSF_COMMAND_START);
+          }
+          return 0;
+        });
+        new DynamicText(line, rect_t{}, [=]() { return getFieldText(id); });
+        break;
+      }
+
+      default:  // info and strings
+        new StaticText(line, rect_t{}, param.name, 0, COLOR_THEME_PRIMARY1);
+        new DynamicText(line, rect_t{}, [=]() { return getFieldText(id); });
+        break;
+    }
+  }
+}
+
+void RadioCrossfireConfig::updateValues()
+{
+  for (auto edit : numberEdits) {
+    edit->update();
+  }
+  for (auto choice : choices) {
+    lv_event_send(choice->getLvObj(), LV_EVENT_VALUE_CHANGED, nullptr);
+  }
+
+  // commands which need a confirmation
+  uint8_t count = crossfireParamsFieldsCount();
+  for (uint8_t id = 1; id <= count; id++) {
+    CrossfireParam param;
+    uint8_t buffer[CRSF_PARAM_MAX_SIZE];
+    if (!crossfireParamsGetField(id, param, buffer) ||
+        param.type != CRSF_COMMAND)
+      continue;
+
+    if (param.value != CRSF_COMMAND_CONFIRMATION_NEEDED) {
+      if (confirmField == id) confirmField = 0;
+    } else if (confirmField != id) {
+      confirmField = id;
+      new ConfirmDialog(
+          this, param.name, param.text ? param.text : "",
+          [=]() {
+            CrossfireParam command;
+            uint8_t data[CRSF_PARAM_MAX_SIZE];
+            if (crossfireParamsGetField(id, command, data))
+              crossfireParamsCommand(command, CRSF_COMMAND_CONFIRM);
+          },
+          [=]() {
+            CrossfireParam command;
+            uint8_t data[CRSF_PARAM_MAX_SIZE];
+            if (crossfireParamsGetField(id, command, data))
+              crossfireParamsCommand(command, CRSF_COMMAND_CANCEL);
+          });
+    }
+  }
+}
+
+void RadioCrossfireConfig::checkEvents()
+{
+  Page::checkEvents();
+
+  if (structureRevision != crossfireParamsStructureRevision() &&
+      (int32_t)(get_tmr10ms() - nextRebuild) >= 0) {
+    rebuild();
+  }
+
+  if (valuesRevision != crossfireParamsValuesRevision()) {
+    valuesRevision = crossfireParamsValuesRevision();
+    updateValues();
+  }
+
+  // the tree is shown from the SD cache the next time
+  uint8_t count = crossfireParamsFieldsCount();
+  if (address && !cacheSaved && count > 0 &&
+      crossfireParamsFieldsLoaded() == count) {
+    crossfireParamsSaveCache();
+    cacheSaved = true;
+  }
+}
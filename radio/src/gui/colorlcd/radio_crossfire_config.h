@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "opentx_types.h"
+#include "page.h"
+
+class Choice;
+class FormWindow;
+class NumberEdit;
+
+// Native browser of the parameters of CRSF devices (ELRS / Crossfire)
+class RadioCrossfireConfig : public Page
+{
+ public:
+  explicit RadioCrossfireConfig(uint8_t moduleIdx);
+  ~RadioCrossfireConfig() override;
+
+#if defined(DEBUG_WINDOWS)
+  std::string getName() const override { return "RadioCrossfireConfig"; }
+#endif
+
+  void checkEvents() override;
+  void onCancel() override;
+
+ protected:
+  uint8_t moduleIdx;
+  uint8_t address = 0;  // selected device
+  uint8_t folder = 0;
+  uint16_t structureRevision = 0;
+  uint16_t valuesRevision = 0;
+  tmr10ms_t nextRebuild = 0;
+  bool cacheSaved = false;
+  uint8_t confirmField = 0;
+
+  FormWindow* form = nullptr;
+  std::list<NumberEdit*> numberEdits;
+  std::list<Choice*> choices;
+
+  void rebuild();
+  void buildDevices();
+  void buildFields();
+  void updateValues();
+  void selectDevice(uint8_t device);
+};
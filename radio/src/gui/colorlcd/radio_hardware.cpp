@@ -126,6 +126,24 @@ void RadioHardwarePage::build(FormWindow * window)
   new StaticText(line, rect_t{}, STR_JITTER_FILTER, 0, COLOR_THEME_PRIMARY1);
   new ToggleSwitch(line, rect_t{}, GET_SET_INVERTED(g_eeGeneral.noJitterFilter));
 
+  // Stick filter
+  line = window->newLine(&grid);
+  new StaticText(line, rect_t{}, STR_STICK_FILTER, 0, COLOR_THEME_PRIMARY1);
+
+  box = new FormWindow(line, rect_t{});
+  box->setFlexLayout(LV_FLEX_FLOW_ROW, lv_dpx(8));
+  lv_obj_set_style_grid_cell_x_align(box->getLvObj(), LV_GRID_ALIGN_STRETCH, 0);
+  lv_obj_set_style_flex_cross_place(box->getLvObj(), LV_FLEX_ALIGN_CENTER, 0);
+  new Choice(box, rect_t{}, STR_STICK_FILTER_TYPES, 0, STICK_FILTER_MAX,
+             GET_SET_DEFAULT(g_eeGeneral.stickFilter));
+
+  new StaticText(box, rect_t{}, STR_STICK_FILTER_CUTOFF, 0, COLOR_THEME_PRIMARY1);
+  auto cutoff = new Choice(box, rect_t{}, 0, 7,
+                           GET_SET_DEFAULT(g_eeGeneral.stickFilterCutoff));
+  cutoff->setTextHandler([](uint8_t value) {
+    return "1/" + std::to_string(adcStickFilterDivisor(value));
+  });
+
 #if defined(AUDIO_MUTE_GPIO)
   // Mute audio
   line = window->newLine(&grid);
@@ -515,16 +515,16 @@ void RadioSdManagerPage::fileAction(const char* path, const char* name,
                    destNamePtr, lfn);
         clipboard.type = CLIPBOARD_TYPE_NONE;
 
-        browser->refresh();
+        browser->invalidate();
       });
     }
     menu->addLine(STR_RENAME_FILE, [=]() {
       auto few = new FileNameEditWindow(name);
-      few->setCloseHandler([=]() { browser->refresh(); });
+      few->setCloseHandler([=]() { browser->invalidate(); });
     });
     menu->addLine(STR_DELETE_FILE, [=]() {
       f_unlink(fullpath);
-      browser->refresh();
+      browser->invalidate();
     });
   }
 }
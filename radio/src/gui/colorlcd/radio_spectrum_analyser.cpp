@@ -97,13 +97,40 @@ class SpectrumFooterWindow: public FormWindow
     }
 };
 
+// Detects footer edits (frequency, span, tracker) which need a full redraw
+class SpectrumSettingsWatcher
+{
+  public:
+    bool changed()
+    {
+      auto& spectrum = reusableBuffer.spectrumAnalyser;
+      if (spectrum.freq == freq && spectrum.span == span &&
+          spectrum.track == track)
+        return false;
+      freq = spectrum.freq;
+      span = spectrum.span;
+      track = spectrum.track;
+      return true;
+    }
+
+  protected:
+    uint32_t freq = 0;
+    uint32_t span = 0;
+    uint32_t track = 0;
+};
+
 class SpectrumScaleWindow: public Window
 {
   public:
     SpectrumScaleWindow(Window * parent, const rect_t & rect) :
       Window(parent, rect)
     {
-      // This window will be automatically invalidated because it's between the frequency analyser (always invalidated) and the modified field
+    }
+
+    void checkEvents() override
+    {
+      Window::checkEvents();
+      if (settings.changed()) invalidate();
     }
 
     void paint(BitmapBuffer * dc) override
@@ -127,73 +154,131 @@ class SpectrumScaleWindow: public Window
         }
       }
     }
+
+  protected:
+    SpectrumSettingsWatcher settings;
 };
 
+// Width of the drawn columns, and height of a waterfall row
+constexpr uint8_t SPECTRUM_COLUMN_WIDTH = 4;
+constexpr coord_t WATERFALL_ROW_HEIGHT = 4;
+constexpr uint8_t WATERFALL_COLUMNS = LCD_W / SPECTRUM_COLUMN_WIDTH;
+constexpr uint8_t WATERFALL_ROWS = SPECTRUM_HEIGHT / WATERFALL_ROW_HEIGHT;
+constexpr tmr10ms_t WATERFALL_ROW_PERIOD = 10;  // 100ms
+
+// Only the columns which received new data are redrawn. In waterfall mode,
+// rows are written in place in a ring (newest row under the cursor), so
+// that a new row does not scroll the whole plot.
 class SpectrumWindow: public Window
 {
   public:
     SpectrumWindow(Window * parent, const rect_t & rect) :
-      Window(parent, rect, REFRESH_ALWAYS)
+      Window(parent, rect)
     {
     }
 
-    void paint(BitmapBuffer * dc) override
+    void onClicked() override
     {
-      if (TELEMETRY_STREAMING()) {
-        dc->drawText(width() / 2, height() / 2, STR_TURN_OFF_RECEIVER, CENTERED);
-        return;
+      // toggle bars / waterfall
+      waterfall = !waterfall;
+      memclear(rows, sizeof(rows));
+      currentRow = 0;
+      rowTime = get_tmr10ms();
+      invalidate();
+    }
+
+    void checkEvents() override
+    {
+      Window::checkEvents();
+
+      auto& spectrum = reusableBuffer.spectrumAnalyser;
+
+      bool streaming = TELEMETRY_STREAMING();
+      if (streaming != receiverOn || settings.changed()) {
+        receiverOn = streaming;
+        invalidate();
       }
 
 #if defined(SIMU)
-      // Geneate random data for simu
-      for (coord_t x= 0; x < width(); x++) {
-        uint8_t power = rand() % 80;
-        reusableBuffer.spectrumAnalyser.bars[x] = power;
-        reusableBuffer.spectrumAnalyser.bars[x+1] = power;
-        if (power > reusableBuffer.spectrumAnalyser.max[x]) {
-          reusableBuffer.spectrumAnalyser.max[x] = power;
-          reusableBuffer.spectrumAnalyser.max[x+1] = power;
-        }
+      // Generate random data for simu
+      for (coord_t x = 0; x < width(); x += 2) {
+        spectrumAnalyserSetColumns(x, 2, rand() % 80);
       }
 #endif
 
-      coord_t SCALE_TOP = height() - MENU_FOOTER_HEIGHT;
+      if (spectrum.changedFrom < spectrum.changedTo) {
+        coord_t from = spectrum.changedFrom - spectrum.changedFrom % SPECTRUM_COLUMN_WIDTH;
+        coord_t to = spectrum.changedTo;
+        if (waterfall) {
+          // keep the peak of the period in the current row
+          for (coord_t x = from; x < to && x < WATERFALL_COLUMNS * SPECTRUM_COLUMN_WIDTH; x += SPECTRUM_COLUMN_WIDTH) {
+            uint8_t& value = rows[currentRow][x / SPECTRUM_COLUMN_WIDTH];
+            value = max<uint8_t>(value, getAverage(SPECTRUM_COLUMN_WIDTH, &spectrum.bars[x]));
+          }
+          invalidate({from, currentRow * WATERFALL_ROW_HEIGHT, to - from + SPECTRUM_COLUMN_WIDTH, WATERFALL_ROW_HEIGHT + 1});
+        }
+        else {
+          invalidate({from, 0, to - from + SPECTRUM_COLUMN_WIDTH, height()});
+        }
+        spectrum.changedFrom = LCD_W;
+        spectrum.changedTo = 0;
+      }
 
-      // Draw fixed part (scale,..)
-      for (uint32_t frequency = ((reusableBuffer.spectrumAnalyser.freq - reusableBuffer.spectrumAnalyser.span / 2) / 10000000) * 10000000 + 10000000; ; frequency += 10000000) {
-        int offset = frequency - (reusableBuffer.spectrumAnalyser.freq - reusableBuffer.spectrumAnalyser.span / 2);
-        int x = offset / reusableBuffer.spectrumAnalyser.step;
-        if (x >= LCD_W - 1)
-          break;
-        dc->drawVerticalLine(x, 0, height(), STASHED, COLOR_THEME_SECONDARY2);
+      if (waterfall && (tmr10ms_t)(get_tmr10ms() - rowTime) >= WATERFALL_ROW_PERIOD) {
+        rowTime = get_tmr10ms();
+        // previous row loses the cursor, the new one starts empty
+        invalidate({0, currentRow * WATERFALL_ROW_HEIGHT, width(), WATERFALL_ROW_HEIGHT + 1});
+        if (++currentRow >= WATERFALL_ROWS) currentRow = 0;
+        memclear(rows[currentRow], sizeof(rows[currentRow]));
+        invalidate({0, currentRow * WATERFALL_ROW_HEIGHT, width(), WATERFALL_ROW_HEIGHT + 1});
       }
+    }
 
-      for (uint8_t power = 20;; power += 20) {
-        int y = SCALE_TOP - 1 - limit<int>(0, power << 1, SCALE_TOP);
-        if (y <= 0)
-          break;
-        dc->drawHorizontalLine(0, y, width(), STASHED, COLOR_THEME_SECONDARY2);
+    void paint(BitmapBuffer * dc) override
+    {
+      if (TELEMETRY_STREAMING()) {
+        dc->drawText(width() / 2, height() / 2, STR_TURN_OFF_RECEIVER, CENTERED);
+        return;
       }
 
-      // Draw spectrum data
-      constexpr uint8_t step = 4;
+      coord_t SCALE_TOP = height() - MENU_FOOTER_HEIGHT;
 
-      for (coord_t xv = 0; xv < width(); xv += step) {
-        coord_t yv = SCALE_TOP - 1 - limit<int>(0, getAverage(step, &reusableBuffer.spectrumAnalyser.bars[xv]) << 1, SCALE_TOP);
-        coord_t max_yv = SCALE_TOP - 1 - limit<int>(0, getAverage(step, &reusableBuffer.spectrumAnalyser.max[xv]) << 1, SCALE_TOP);
+      if (waterfall) {
+        paintWaterfall(dc);
+      }
+      else {
+        // Draw fixed part (scale,..)
+        for (uint32_t frequency = ((reusableBuffer.spectrumAnalyser.freq - reusableBuffer.spectrumAnalyser.span / 2) / 10000000) * 10000000 + 10000000; ; frequency += 10000000) {
+          int offset = frequency - (reusableBuffer.spectrumAnalyser.freq - reusableBuffer.spectrumAnalyser.span / 2);
+          int x = offset / reusableBuffer.spectrumAnalyser.step;
+          if (x >= LCD_W - 1)
+            break;
+          dc->drawVerticalLine(x, 0, height(), STASHED, COLOR_THEME_SECONDARY2);
+        }
+
+        for (uint8_t power = 20;; power += 20) {
+          int y = SCALE_TOP - 1 - limit<int>(0, power << 1, SCALE_TOP);
+          if (y <= 0)
+            break;
+          dc->drawHorizontalLine(0, y, width(), STASHED, COLOR_THEME_SECONDARY2);
+        }
 
-        // Signal bar
-        dc->drawSolidFilledRect(xv, yv, step - 1, SCALE_TOP - yv, COLOR_THEME_ACTIVE);
-        // lcdDrawSolidRect(xv, yv, step - 1, SCALE_TOP - yv, 1, TEXT_COLOR);
+        // Draw spectrum data
+        constexpr uint8_t step = SPECTRUM_COLUMN_WIDTH;
 
-        // Signal max
-        dc->drawSolidHorizontalLine(xv, max_yv, step - 1, COLOR_THEME_PRIMARY1);
+        for (coord_t xv = 0; xv < width(); xv += step) {
+          coord_t yv = SCALE_TOP - 1 - limit<int>(0, getAverage(step, &reusableBuffer.spectrumAnalyser.bars[xv]) << 1, SCALE_TOP);
+          coord_t max_yv = SCALE_TOP - 1 - limit<int>(0, getAverage(step, &reusableBuffer.spectrumAnalyser.max[xv]) << 1, SCALE_TOP);
+          coord_t avg_yv = SCALE_TOP - 1 - limit<int>(0, getAverage(step, &reusableBuffer.spectrumAnalyser.avg[xv]) << 1, SCALE_TOP);
 
-        // Decay max values
-        if (max_yv < yv) { // Those value are INVERTED (MENU_FOOTER_TOP - value)
-          for (uint8_t i = 0; i < step; i++) {
-            reusableBuffer.spectrumAnalyser.max[xv + i] = max<int>(0, reusableBuffer.spectrumAnalyser.max[xv + i] - 1);
-          }
+          // Signal bar
+          dc->drawSolidFilledRect(xv, yv, step - 1, SCALE_TOP - yv, COLOR_THEME_ACTIVE);
+
+          // Signal average
+          dc->drawSolidHorizontalLine(xv, avg_yv, step - 1, COLOR_THEME_SECONDARY1);
+
+          // Signal max
+          dc->drawSolidHorizontalLine(xv, max_yv, step - 1, COLOR_THEME_PRIMARY1);
         }
       }
 
@@ -204,7 +289,39 @@ class SpectrumWindow: public Window
     }
 
   protected:
+    SpectrumSettingsWatcher settings;
+    bool receiverOn = false;
+    bool waterfall = false;
+    uint8_t currentRow = 0;
+    tmr10ms_t rowTime = 0;
+    uint8_t rows[WATERFALL_ROWS][WATERFALL_COLUMNS] = {};
+
+    static LcdFlags waterfallColor(uint8_t power)
+    {
+      // black -> blue -> green -> yellow -> red
+      uint8_t v = min<int>(power * 3, 255);
+      if (v < 64)
+        return RGB2FLAGS(0, 0, v * 4);
+      if (v < 128)
+        return RGB2FLAGS(0, (v - 64) * 4, 255 - (v - 64) * 4);
+      if (v < 192)
+        return RGB2FLAGS((v - 128) * 4, 255, 0);
+      return RGB2FLAGS(255, 255 - (v - 192) * 4, 0);
+    }
+
+    void paintWaterfall(BitmapBuffer * dc)
+    {
+      for (uint8_t row = 0; row < WATERFALL_ROWS; row++) {
+        coord_t y = row * WATERFALL_ROW_HEIGHT;
+        for (uint8_t col = 0; col < WATERFALL_COLUMNS; col++) {
+          dc->drawSolidFilledRect(col * SPECTRUM_COLUMN_WIDTH, y, SPECTRUM_COLUMN_WIDTH,
+                                  WATERFALL_ROW_HEIGHT, waterfallColor(rows[row][col]));
+        }
+      }
 
+      // cursor under the newest row
+      dc->drawSolidHorizontalLine(0, currentRow * WATERFALL_ROW_HEIGHT + WATERFALL_ROW_HEIGHT, width(), COLOR_THEME_PRIMARY1);
+    }
 };
 
 
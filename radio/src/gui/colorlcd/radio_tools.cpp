@@ -23,6 +23,7 @@
 #include "radio_tools.h"
 #include "radio_spectrum_analyser.h"
 #include "radio_ghost_module_config.h"
+#include "radio_crossfire_config.h"
 #include "opentx.h"
 #include "libopenui.h"
 #include "lua/lua_api.h"
@@ -168,6 +169,13 @@ static void run_ghost_config(Window* parent, const std::string&)
 }
 #endif
 
+#if defined(CROSSFIRE)
+static void run_crossfire_config(Window* parent, const std::string&)
+{
+  new RadioCrossfireConfig(isModuleCrossfire(INTERNAL_MODULE) ? INTERNAL_MODULE : EXTERNAL_MODULE);
+}
+#endif
+
 struct ToolButton : public TextButton {
   ToolButton(Window* parent, const ToolEntry& tool) :
     TextButton(parent, rect_t{}, tool.label, [=]() {
@@ -237,6 +245,12 @@ void RadioToolsPage::rebuild(FormWindow * window)
   }
 #endif
 
+#if defined(CROSSFIRE)
+  if (isModuleCrossfire(INTERNAL_MODULE) || isModuleCrossfire(EXTERNAL_MODULE)) {
+    tools.emplace_back(ToolEntry{ "CRSF device config", {}, run_crossfire_config });
+  }
+#endif
+
 #if defined(LUA)
   scanLuaTools(tools);
 #endif
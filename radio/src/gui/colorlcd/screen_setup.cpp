@@ -29,7 +29,7 @@
 #include "widgets_setup.h"
 #include "color_picker.h"
 
-#define SET_DIRTY()   storageDirty(EE_MODEL)
+#define SET_DIRTY()   storageDirty(EE_SCREENS)
 #define BUTTON_HEIGHT 30
 #define BUTTON_WIDTH  75
 
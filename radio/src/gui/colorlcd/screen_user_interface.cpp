@@ -146,9 +146,9 @@ void ScreenUserInterfacePage::build(FormWindow* window)
       preview = new FilePreview(line, rect_t{}, false);
       preview->setFile(themeImage[0].c_str());
 
-      // adjust width according to max
-      preview->setWidth(min(MAX_PREVIEW_WIDTH, preview->getBitmapWidth()));
-      preview->setHeight(min(MAX_PREVIEW_HEIGHT, preview->getBitmapHeight()));
+      // the picture is loaded later on and centered within the preview
+      preview->setWidth(MAX_PREVIEW_WIDTH);
+      preview->setHeight(MAX_PREVIEW_HEIGHT);
 
       // center within cell
       auto obj = preview->getLvObj();
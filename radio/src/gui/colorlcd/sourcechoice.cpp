@@ -63,6 +63,19 @@ class SourceChoiceMenuToolbar : public MenuToolbar
 // defined in gui/gui_common.cpp
 uint8_t switchToMix(uint8_t source);
 
+// The menu contents only change with the model or radio settings,
+// and with the outputs of the model scripts
+static uint32_t sourceChoiceCacheKey()
+{
+  uint32_t key = modelDataRevision + ((uint32_t)generalDataRevision << 16);
+#if defined(LUA_MODEL_SCRIPTS)
+  for (uint8_t i = 0; i < MAX_SCRIPTS; i++) {
+    key = key * 31 + scriptInputsOutputs[i].outputsCount;
+  }
+#endif
+  return key;
+}
+
 SourceChoice::SourceChoice(Window* parent, const rect_t &rect, int16_t vmin,
                            int16_t vmax, std::function<int16_t()> getValue,
                            std::function<void(int16_t)> setValue,
@@ -104,4 +117,5 @@ SourceChoice::SourceChoice(Window* parent, const rect_t &rect, int16_t vmin,
   });
 
   setAvailableHandler([](int v){ return isSourceAvailable(v); });
+  setCacheKeyHandler(sourceChoiceCacheKey);
 }
@@ -101,6 +101,23 @@ class SpecialFunctionEditPage : public Page
     return new NumberEdit(line, rect_t{}, vmin, vmax, GET_SET_DEFAULT(CFN_PARAM(cfn)));
   }
 
+  // the profile keeps the fields that are left out, the toggles show
+  // the ones that are logged
+  void addLogsProfileToggle(FormWindow::Line* line, const char* title, CustomFunctionData* cfn, uint8_t flag, bool included)
+  {
+    new StaticText(line, rect_t{}, title, 0, COLOR_THEME_PRIMARY1);
+    new ToggleSwitch(
+        line, rect_t{},
+        [=]() { return ((CFN_LOGS_PROFILE(cfn) & flag) != 0) != included; },
+        [=](uint8_t newValue) {
+          if ((newValue != 0) == included)
+            CFN_LOGS_PROFILE(cfn) &= ~flag;
+          else
+            CFN_LOGS_PROFILE(cfn) |= flag;
+          SET_DIRTY();
+        });
+  }
+
   void updateSpecialFunctionOneWindow()
   {
     specialFunctionOneWindow->clear();
@@ -243,6 +260,19 @@ class SpecialFunctionEditPage : public Page
             [=](int32_t value) {
               return formatNumberAsString(CFN_PARAM(cfn), PREC1, 0, nullptr, "s");
             });
+
+        line = specialFunctionOneWindow->newLine(&grid);
+        addLogsProfileToggle(line, STR_LOGS_ON_CHANGE, cfn, FUNC_LOGS_ON_CHANGE, false);
+        line = specialFunctionOneWindow->newLine(&grid);
+        addLogsProfileToggle(line, STR_STICKS, cfn, FUNC_LOGS_NO_STICKS, true);
+        line = specialFunctionOneWindow->newLine(&grid);
+        addLogsProfileToggle(line, STR_POTS, cfn, FUNC_LOGS_NO_POTS, true);
+        line = specialFunctionOneWindow->newLine(&grid);
+        addLogsProfileToggle(line, STR_SWITCHES, cfn, FUNC_LOGS_NO_SWITCHES, true);
+        line = specialFunctionOneWindow->newLine(&grid);
+        addLogsProfileToggle(line, STR_LOGS_LOGICAL_SWITCHES, cfn, FUNC_LOGS_NO_LOGICAL_SWITCHES, true);
+        line = specialFunctionOneWindow->newLine(&grid);
+        addLogsProfileToggle(line, STR_CHANS, cfn, FUNC_LOGS_NO_CHANNELS, true);
         break;
       }
 
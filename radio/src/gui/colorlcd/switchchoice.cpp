@@ -41,6 +41,12 @@ class SwitchChoiceMenuToolbar : public MenuToolbar
   }
 };
 
+// The menu contents only change with the model or radio settings
+static uint32_t switchChoiceCacheKey()
+{
+  return modelDataRevision + ((uint32_t)generalDataRevision << 16);
+}
+
 void SwitchChoice::LongPressHandler(void* data)
 {
   SwitchChoice* swch = (SwitchChoice*)data;
@@ -94,4 +100,5 @@ SwitchChoice::SwitchChoice(Window* parent, const rect_t& rect, int vmin,
   set_lv_LongPressHandler(LongPressHandler, this);
 
   setAvailableHandler(isSwitchAvailableInMixes);
+  setCacheKeyHandler(switchChoiceCacheKey);
 }
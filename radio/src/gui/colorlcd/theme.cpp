@@ -178,6 +178,20 @@ void EdgeTxTheme::drawUsbPluggedScreen(BitmapBuffer * dc) const
   dc->drawBitmapPattern((LCD_W - LBM_USB_PLUGGED_W) / 2,
                         (LCD_H - LBM_USB_PLUGGED_H) / 2,
                         LBM_USB_PLUGGED, COLOR_THEME_SECONDARY1);
+
+#if defined(STM32) && !defined(SIMU)
+  // mass storage throughput, in 0.1 MB/s
+  UsbStorageStats stats;
+  usbStorageGetStats(&stats);
+  uint32_t rate = (stats.readRate + stats.writeRate) / 100000;
+  if (rate) {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u MB/s", (unsigned)(rate / 10),
+             (unsigned)(rate % 10));
+    dc->drawText(LCD_W / 2, (LCD_H + LBM_USB_PLUGGED_H) / 2 + 10, text,
+                 CENTERED | COLOR_THEME_SECONDARY1);
+  }
+#endif
 }
 
 
@@ -23,6 +23,7 @@
 #include "tabsgroup.h"
 #include "bitmaps.h"
 #include "theme_manager.h"
+#include "bitmap_cache.h"
 
 #include <memory>
 using std::unique_ptr;
@@ -109,7 +110,7 @@ class Theme480: public EdgeTxTheme
       if (backgroundBitmap != nullptr)
         delete backgroundBitmap;
       EdgeTxTheme::setBackgroundImageFileName(fileName);  // set the filename
-      backgroundBitmap = BitmapBuffer::loadBitmap(backgroundImageFileName);
+      backgroundBitmap = bitmapCacheLoad(backgroundImageFileName);
     }
 
     void load() const override
@@ -118,7 +119,7 @@ class Theme480: public EdgeTxTheme
       ThemePersistance::instance()->loadDefaultTheme();
       EdgeTxTheme::load();
       if (!backgroundBitmap) {
-        backgroundBitmap = BitmapBuffer::loadBitmap(getFilePath("background.png"));
+        backgroundBitmap = bitmapCacheLoad(getFilePath("background.png"));
       }
       update();
     }
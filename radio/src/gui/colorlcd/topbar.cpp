@@ -85,5 +85,5 @@ void SetupTopBarWidgetsPage::deleteLater(bool detach, bool trash)
   // restore screen setting tab on top
   new ScreenMenu(0);
 
-  storageDirty(EE_MODEL);
+  storageDirty(EE_SCREENS);
 }
@@ -88,6 +88,10 @@ BluetoothTrainerWindow::BluetoothTrainerWindow(Window* parent) :
   new StaticText(lclline, rect_t{}, STR_BLUETOOTH_LOCAL_ADDR, 0, COLOR_THEME_PRIMARY1);
   new StaticText(lclline, rect_t{}, bluetooth.localAddr, 0, COLOR_THEME_PRIMARY1);
 
+  auto statsline = newLine(&grid);
+  new StaticText(statsline, rect_t{}, STR_INTERVAL, 0, COLOR_THEME_PRIMARY1);
+  stats = new StaticText(statsline, rect_t{}, "", 0, COLOR_THEME_PRIMARY1);
+
   btn_line = newLine(&grid);
   grid.nextCell();
 
@@ -116,6 +120,26 @@ void BluetoothTrainerWindow::checkEvents()
     refresh();
   lastbtstate = bluetooth.state;
   devcount = reusableBuffer.moduleSetup.bt.devicesCount;
+
+  if (memcmp(&bluetooth.trainerStats, &laststats, sizeof(laststats))) {
+    laststats = bluetooth.trainerStats;
+    refreshStats();
+  }
+}
+
+void BluetoothTrainerWindow::refreshStats()
+{
+  if (bluetooth.state != BLUETOOTH_STATE_CONNECTED ||
+      !bluetooth.trainerStats.rate) {
+    stats->setText(_empty_addr);
+    return;
+  }
+
+  char s[32];
+  snprintf(s, sizeof(s), "%dms (max %dms), %dHz",
+           bluetooth.trainerStats.gapAvg, bluetooth.trainerStats.gapMax,
+           bluetooth.trainerStats.rate);
+  stats->setText(s);
 }
 
 void BluetoothTrainerWindow::refresh()
@@ -175,6 +199,8 @@ void BluetoothTrainerWindow::refresh()
     state->setText(STR_NOT_CONNECTED);
     if (!is_master) r_addr->setText(_empty_addr);
   }
+
+  refreshStats();
 }
 
 void BluetoothTrainerWindow::startScan()
@@ -35,10 +35,13 @@ class BluetoothTrainerWindow : public FormWindow
   StaticText* state;
   StaticText* r_addr;
   StaticText* l_addr;
+  StaticText* stats;
+  BluetoothTrainerStats laststats = {};
 
   Window* btn_line;
   TextButton* btn;
   void startScan();
+  void refreshStats();
 
 public:
   BluetoothTrainerWindow(Window* parent);
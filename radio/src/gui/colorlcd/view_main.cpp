@@ -45,7 +45,7 @@ static void saveViewId(unsigned view)
   if (view != g_model.view) {
     TRACE("save view #%d", view);
     g_model.view = view;
-    storageDirty(EE_MODEL);
+    storageDirty(EE_SCREENS);
   }
 }
 
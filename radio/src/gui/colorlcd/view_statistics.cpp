@@ -26,6 +26,12 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "mixer_profiler.h"
+#include "module_timing.h"
+#include "task_stats.h"
+#include "telemetry/link_history.h"
+#include "hal/adc_driver.h"
+#include "LvglWrapper.h"
 
 static const lv_coord_t col_dsc[] = {LV_GRID_FR(1), LV_GRID_FR(1),
                                      LV_GRID_FR(1), LV_GRID_FR(1),
@@ -57,6 +63,7 @@ static const lv_coord_t row_dsc[] = {LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
 #define CV_HEIGHT (CV_SCALE * 32 + 5)
 
 #define DBG_B_HEIGHT 20
+#define LH_HEIGHT 60
 
 template <class T>
 class DebugInfoNumber : public Window
@@ -83,6 +90,27 @@ class DebugInfoNumber : public Window
   const char* suffix;
 };
 
+static std::string formatLoad(const char* name, uint16_t load)
+{
+  char s[32];
+  snprintf(s, sizeof(s), "%s %d.%d%%", name, load / 10, load % 10);
+  return s;
+}
+
+static MixerStageStats getMixerStageStats(uint8_t stage)
+{
+  MixerStageStats stats;
+  mixerProfilerGetStats(stage, stats);
+  return stats;
+}
+
+static ModuleTimingStats getModuleTimingStats(uint8_t module)
+{
+  ModuleTimingStats stats;
+  moduleTimingGetStats(module, stats);
+  return stats;
+}
+
 StatisticsViewPageGroup::StatisticsViewPageGroup() : TabsGroup(ICON_STATS)
 {
   addTab(new StatisticsViewPage());
@@ -142,6 +170,103 @@ class ThrottleCurveWindow : public Window
   unsigned previousTraceWr = 0;
 };
 
+class CpuLoadWindow : public Window
+{
+ public:
+  CpuLoadWindow(Window* parent, const rect_t& rect) : Window(parent, rect) {}
+
+  void checkEvents() override
+  {
+    Window::checkEvents();
+    if (previousWindows != taskStatsWindows()) {
+      previousWindows = taskStatsWindows();
+      invalidate();
+    }
+  }
+
+  void paint(BitmapBuffer* dc) override
+  {
+    // Axis
+    coord_t h = height() - 1;
+    dc->drawHorizontalLine(0, h, width(), SOLID, COLOR_THEME_SECONDARY1);
+    dc->drawVerticalLine(0, 0, h, SOLID, COLOR_THEME_SECONDARY1);
+
+    // History, newest on the right
+    coord_t barWidth = (width() - 2) / TASK_STATS_HISTORY;
+    if (barWidth < 1) barWidth = 1;
+    coord_t x = width() - barWidth;
+    uint8_t load;
+    for (uint8_t idx = 0; x > 1 && taskStatsGetHistory(idx, load); idx++) {
+      coord_t y = (h - 1) * load / 100;
+      if (y > 0) {
+        dc->drawSolidFilledRect(x, h - y, barWidth, y,
+                                COLOR_THEME_SECONDARY1);
+      }
+      x -= barWidth;
+    }
+  }
+
+ protected:
+  uint32_t previousWindows = 0;
+};
+
+class LinkHistoryWindow : public Window
+{
+ public:
+  LinkHistoryWindow(Window* parent, const rect_t& rect) : Window(parent, rect)
+  {
+  }
+
+  void checkEvents() override
+  {
+    Window::checkEvents();
+    if (previousCount != linkHistoryCount(LINK_HISTORY_FINE)) {
+      previousCount = linkHistoryCount(LINK_HISTORY_FINE);
+      invalidate();
+    }
+  }
+
+  // RSSI in dB (0..100) or in dBm (-120..-20)
+  static int16_t rssiPercent(int16_t rssi)
+  {
+    return limit<int16_t>(0, rssi < 0 ? rssi + 120 : rssi, 100);
+  }
+
+  void paint(BitmapBuffer* dc) override
+  {
+    // Axis
+    coord_t h = height() - 1;
+    dc->drawHorizontalLine(0, h, width(), SOLID, COLOR_THEME_SECONDARY1);
+    dc->drawVerticalLine(0, 0, h, SOLID, COLOR_THEME_SECONDARY1);
+
+    // Last minutes of the fine track, newest on the right
+    uint16_t count = min<uint16_t>(linkHistoryCount(LINK_HISTORY_FINE),
+                                   width() - 2);
+    LinkHistoryReader reader(LINK_HISTORY_FINE, count);
+    LinkHistorySample sample;
+    coord_t x = width() - count;
+    while (x < width() && reader.next(sample)) {
+      int16_t lq = sample.values[LINK_HISTORY_LQ];
+      int16_t rssi = sample.values[LINK_HISTORY_RSSI];
+      if (lq == LINK_HISTORY_NO_DATA && rssi == LINK_HISTORY_NO_DATA) {
+        dc->drawVerticalLine(x, h - 4, 4, SOLID, COLOR_THEME_WARNING);
+      }
+      if (rssi != LINK_HISTORY_NO_DATA) {
+        dc->drawBitmapPattern(x, h - 3 - (h - 4) * rssiPercent(rssi) / 100,
+                              LBM_POINT, COLOR_THEME_ACTIVE);
+      }
+      if (lq != LINK_HISTORY_NO_DATA) {
+        coord_t y = h - 3 - (h - 4) * limit<int16_t>(0, lq, 100) / 100;
+        dc->drawBitmapPattern(x, y, LBM_POINT, COLOR_THEME_SECONDARY1);
+      }
+      x++;
+    }
+  }
+
+ protected:
+  uint16_t previousCount = 0;
+};
+
 void StatisticsViewPage::build(FormWindow* window)
 {
   window->padAll(0);
@@ -215,6 +340,16 @@ void StatisticsViewPage::build(FormWindow* window)
   line->padAll(0);
   line->padTop(3);
 
+  // Link quality (LQ and RSSI) history
+  auto link = new LinkHistoryWindow(line, {0, 0, CV_WIDTH, LH_HEIGHT});
+
+  lv_obj_set_grid_cell(link->getLvObj(), LV_GRID_ALIGN_CENTER, 0, 4,
+                       LV_GRID_ALIGN_CENTER, 0, 1);
+
+  line = form->newLine(&grid);
+  line->padAll(0);
+  line->padTop(3);
+
   // Reset
   auto btn = new TextButton(line, rect_t{0, 0, 0, 24}, STR_MENUTORESET,
                             [=]() -> uint8_t {
@@ -258,6 +393,65 @@ void DebugViewPage::build(FormWindow* window)
       line, rect_t{}, [] { return DURATION_MS_PREC2(maxMixerDuration); },
       PREC2 | COLOR_THEME_PRIMARY1, nullptr, pad_STR_MS.c_str());
 
+  // Mixer stages timing
+  for (uint8_t stage = 0; stage < MIXER_STAGE_COUNT; stage++) {
+    // only radios with serial gimbals report the stick age
+    if (stage == MIXER_STAGE_STICKS_AGE && !adcGetSticksAge()) continue;
+
+    line = form->newLine(&grid);
+    line->padAll(0);
+    line->padLeft(10);
+
+    new StaticText(line, rect_t{}, mixerProfilerStageNames[stage], 0,
+                   COLOR_THEME_PRIMARY1 | FONT(XS));
+#if LCD_H > LCD_W
+    line = form->newLine(&grid2);
+    line->padAll(0);
+    line->padLeft(10);
+#endif
+    new DebugInfoNumber<uint16_t>(
+        line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+        [=] { return getMixerStageStats(stage).p50; }, COLOR_THEME_PRIMARY1,
+        "p50 ", nullptr);
+    new DebugInfoNumber<uint16_t>(
+        line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+        [=] { return getMixerStageStats(stage).p99; }, COLOR_THEME_PRIMARY1,
+        "p99 ", nullptr);
+    new DebugInfoNumber<uint16_t>(
+        line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+        [=] { return getMixerStageStats(stage).max; }, COLOR_THEME_PRIMARY1,
+        "max ", nullptr);
+  }
+
+  // Module frames timing
+  for (uint8_t module = 0; module < NUM_MODULES; module++) {
+    line = form->newLine(&grid);
+    line->padAll(0);
+    line->padLeft(10);
+
+    new StaticText(line, rect_t{},
+                   module == INTERNAL_MODULE ? STR_INTERNAL_MODULE
+                                             : STR_EXTERNAL_MODULE,
+                   0, COLOR_THEME_PRIMARY1 | FONT(XS));
+#if LCD_H > LCD_W
+    line = form->newLine(&grid2);
+    line->padAll(0);
+    line->padLeft(10);
+#endif
+    new DebugInfoNumber<uint32_t>(
+        line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+        [=] { return getModuleTimingStats(module).late; },
+        COLOR_THEME_PRIMARY1, "late ", nullptr);
+    new DebugInfoNumber<uint32_t>(
+        line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+        [=] { return getModuleTimingStats(module).dropped; },
+        COLOR_THEME_PRIMARY1, "drop ", nullptr);
+    new DebugInfoNumber<uint16_t>(
+        line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+        [=] { return getModuleTimingStats(module).maxSent; },
+        COLOR_THEME_PRIMARY1, "max ", nullptr);
+  }
+
   line = form->newLine(&grid);
   line->padAll(2);
 
@@ -268,6 +462,29 @@ void DebugViewPage::build(FormWindow* window)
       line, rect_t{}, [] { return availableMemory(); }, COLOR_THEME_PRIMARY1, 
       nullptr, pad_STR_BYTES.c_str());
 
+  line = form->newLine(&grid);
+  line->padAll(0);
+#if LCD_H > LCD_W
+  line->padLeft(10);
+#else
+  grid.nextCell();
+#endif
+
+  // memory high-water mark and fragmentation
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return minAvailableMemory(); }, COLOR_THEME_PRIMARY1, "min ",
+      nullptr);
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return largestFreeMemoryBlock(); }, COLOR_THEME_PRIMARY1, "blk ",
+      nullptr);
+#if !defined(SIMU)
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return lvglMemoryUsage; }, COLOR_THEME_PRIMARY1, "ui ", nullptr);
+#endif
+
 #if defined(LUA)
   line = form->newLine(&grid);
   line->padAll(2);
@@ -288,6 +505,26 @@ void DebugViewPage::build(FormWindow* window)
       line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
       [] { return 10 * maxLuaInterval; }, COLOR_THEME_PRIMARY1, STR_INTERVAL_MS,
       nullptr);
+#if defined(LUA_MIX_SYNC_CYCLES)
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return luaMixOverruns; }, COLOR_THEME_PRIMARY1, "ovr ", nullptr);
+#endif
+
+#if LCD_H > LCD_W
+  line = form->newLine(&grid);
+  line->padAll(0);
+  line->padLeft(10);
+#endif
+
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return luaWidgetsMaxUs; }, COLOR_THEME_PRIMARY1, STR_WIDGET_MAX_US,
+      nullptr);
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return luaWidgetsCachedPaints; }, COLOR_THEME_PRIMARY1,
+      STR_WIDGET_CACHED, nullptr);
 
   line = form->newLine(&grid);
   line->padAll(0);
@@ -342,6 +579,77 @@ void DebugViewPage::build(FormWindow* window)
       [] { return audioStack.available(); }, COLOR_THEME_PRIMARY1,
       STR_STACK_AUDIO, nullptr);
 
+  // CPU load per task / interrupt
+  uint8_t taskCount = taskStatsCount();
+  if (taskCount > 0) {
+    line = form->newLine(&grid);
+    line->padAll(2);
+
+    new StaticText(line, rect_t{}, STR_CPU_LOAD, 0, COLOR_THEME_PRIMARY1);
+
+    line = form->newLine();
+    line->padAll(0);
+    line->padLeft(10);
+    new CpuLoadWindow(line, rect_t{0, 0, LCD_W - 24, 50});
+
+    // CPU, tasks and interrupts, DBG_COL_CNT - 1 per line
+    uint8_t itemCount = 1 + taskCount + TASK_STATS_ISR_COUNT;
+    for (uint8_t item = 0; item < itemCount; item++) {
+      if (item % (DBG_COL_CNT - 1) == 0) {
+#if LCD_W > LCD_H
+        line = form->newLine(&grid);
+        line->padAll(0);
+        line->padLeft(10);
+        new StaticText(line, rect_t{}, "", 0, COLOR_THEME_PRIMARY1);
+#else
+        line = form->newLine(&grid2);
+        line->padAll(0);
+        line->padLeft(10);
+#endif
+      }
+
+      std::function<std::string()> text;
+      if (item == 0) {
+        text = [] { return formatLoad("CPU", taskStatsCpuLoad()); };
+      } else if (item <= taskCount) {
+        uint8_t idx = item - 1;
+        text = [=] {
+          return formatLoad(taskStatsName(idx), taskStatsLoad(idx));
+        };
+      } else {
+        uint8_t isr = item - 1 - taskCount;
+        text = [=] {
+          return formatLoad(taskStatsIsrName(isr), taskStatsIsrLoad(isr));
+        };
+      }
+      new DynamicText(line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT}, text,
+                      COLOR_THEME_PRIMARY1 | FONT(XS));
+    }
+  }
+
+  line = form->newLine(&grid);
+  line->padAll(2);
+
+  // Display rendering
+  new StaticText(line, rect_t{}, STR_LCD, 0, COLOR_THEME_PRIMARY1);
+#if LCD_H > LCD_W
+  line = form->newLine(&grid2);
+  line->padAll(0);
+  line->padLeft(10);
+#endif
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return LvglWrapper::instance()->getFps(); }, COLOR_THEME_PRIMARY1,
+      STR_FRAME_RATE, nullptr);
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return LvglWrapper::instance()->getFrameTimeP99(); },
+      COLOR_THEME_PRIMARY1, STR_FRAME_P99_MS, nullptr);
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return LvglWrapper::instance()->getFrameTimeMax(); },
+      COLOR_THEME_PRIMARY1, STR_FRAME_MAX_MS, nullptr);
+
 #if defined(DEBUG_LATENCY)
   line = form->newLine(&grid2);
   line->padAll(2);
@@ -387,9 +695,17 @@ void DebugViewPage::build(FormWindow* window)
   auto btn = new TextButton(line, rect_t{0, 0, 0, 24}, STR_MENUTORESET,
                             [=]() -> uint8_t {
                               maxMixerDuration = 0;
+                              mixerProfilerReset();
+                              moduleTimingReset();
+                              LvglWrapper::instance()->resetRenderStats();
 #if defined(LUA)
                               maxLuaInterval = 0;
                               maxLuaDuration = 0;
+                              luaWidgetsMaxUs = 0;
+                              luaWidgetsCachedPaints = 0;
+#if defined(LUA_MIX_SYNC_CYCLES)
+                              luaMixOverruns = 0;
+#endif
 #endif
                               return 0;
                             });
@@ -24,7 +24,8 @@
 #include "opentx.h"
 #include "sdcard.h"
 
-constexpr int maxTxtBuffSize = 64 * 1024;
+constexpr uint32_t TEXT_PAGE_SIZE = 8 * 1024;
+constexpr uint32_t TEXT_PAGE_LINES = 100;
 
 ViewTextWindow::ViewTextWindow(const std::string path, const std::string name,
                                unsigned int icon) :
@@ -36,6 +37,7 @@ ViewTextWindow::ViewTextWindow(const std::string path, const std::string name,
   header.setTitle(this->name);
 
   lv_obj_add_event_cb(lvobj, ViewTextWindow::on_draw, LV_EVENT_DRAW_MAIN_BEGIN, nullptr);
+  lv_obj_add_event_cb(body.getLvObj(), ViewTextWindow::on_scroll, LV_EVENT_SCROLL_END, this);
 };
 
 void ViewTextWindow::on_draw(lv_event_t * e)
@@ -48,6 +50,30 @@ void ViewTextWindow::on_draw(lv_event_t * e)
   }
 }
 
+// Loads the next or previous page when scrolled to the end of the current one
+void ViewTextWindow::on_scroll(lv_event_t * e)
+{
+  auto view = (ViewTextWindow*)lv_event_get_user_data(e);
+  if (!view || !view->lb || view->paging) return;
+
+  lv_obj_t* obj = lv_event_get_target(e);
+  if (lv_obj_get_scroll_bottom(obj) <= 0 && view->hasNextPage()) {
+    view->showPage(view->topLine + view->pageLines);
+  } else if (lv_obj_get_scroll_top(obj) <= 0 && view->topLine > 0) {
+    view->showPage(view->topLine - std::min(view->topLine, TEXT_PAGE_LINES), true);
+  }
+}
+
+void ViewTextWindow::checkEvents()
+{
+  Page::checkEvents();
+
+  // the rest of the file is indexed in the background
+  if (lb && !index.complete) {
+    textIndexUpdate(index, fullPath.c_str());
+  }
+}
+
 void ViewTextWindow::onCancel()
 {
   Page::onCancel();
@@ -67,32 +93,38 @@ void ViewTextWindow::extractNameSansExt()
 
 bool ViewTextWindow::openFile()
 {
-  FILINFO info;
-
-  if (buffer) {
-    free(buffer);
-    buffer = nullptr;
-    bufSize = 0;
+  if (!buffer) {
+    buffer = (char *)malloc(TEXT_PAGE_SIZE);
+    if (!buffer) return false;
   }
 
-  auto res = f_stat((TCHAR *)fullPath.c_str(), &info);
-  if (res == FR_OK) {
-    fileLength = int(info.fsize);
-    bufSize = std::min(fileLength, maxTxtBuffSize) + 1;
-
-    buffer = (char *)malloc(bufSize);
-    if (buffer) {
-      offset =
-          std::max(int(openFromEnd ? int(info.fsize) - bufSize + 1 : 0), 0);
-      TRACE("info.fsize=%d\tbufSize=%d\toffset=%d", info.fsize, bufSize,
-            int(info.fsize) - bufSize + 1);
-      if (sdReadTextFileBlock(bufSize, offset) == FR_OK) {
-        return true;
-      }
-    }
+  textIndexInit(index);
+  textIndexUpdate(index, fullPath.c_str());
+  if (openFromEnd) {
+    while (!textIndexUpdate(index, fullPath.c_str()));
   }
 
-  return false;
+  uint32_t lines = textIndexLines(index);
+  topLine = openFromEnd && lines > TEXT_PAGE_LINES ? lines - TEXT_PAGE_LINES : 0;
+
+  return readPage(topLine) == FR_OK;
+}
+
+bool ViewTextWindow::hasNextPage() const
+{
+  return topLine + pageLines < textIndexLines(index);
+}
+
+void ViewTextWindow::showPage(uint32_t line, bool atEnd)
+{
+  if (readPage(line) != FR_OK) return;
+
+  lv_label_set_text_static(lb, buffer);
+
+  // do not page again on the scroll event sent from here
+  paging = true;
+  lv_obj_scroll_to_y(body.getLvObj(), atEnd ? LV_COORD_MAX : 0, LV_ANIM_OFF);
+  paging = false;
 }
 
 void ViewTextWindow::buildBody(Window *window)
@@ -113,74 +145,79 @@ void ViewTextWindow::buildBody(Window *window)
 
     lv_group_add_obj(g, obj);
     lv_group_set_editing(g, true);
-    lv_label_set_text_static(lb, buffer);
 
-    if (openFromEnd)
-      lv_obj_scroll_to_y(obj, LV_COORD_MAX, LV_ANIM_OFF);
-    else
-      lv_obj_scroll_to_y(obj, 0, LV_ANIM_OFF);
+    showPage(topLine, openFromEnd);
   }
 }
 
-FRESULT ViewTextWindow::sdReadTextFileBlock(const uint32_t bufSize,
-                                            const uint32_t offset)
+// Escape sequences are decoded in place, they are never shorter than
+// what they are replaced with. Returns the end of the line.
+static char* decodeTextLine(char* line)
 {
-  FIL file;
-  char escape_chars[4];
+  char escape_chars[4] = {0};
   int escape = 0;
-
-  auto res = f_open(&file, (TCHAR *)fullPath.c_str(), FA_OPEN_EXISTING | FA_READ);
-  if (res == FR_OK) {
-    res = f_lseek(&file, offset);
-    if (res == FR_OK) {
-      UINT br;
-      char c;
-      char *ptr = buffer;
-      for (int i = 0; i < (int)bufSize; i++) {
-        res = f_read(&file, &c, 1, &br);
-        if (res == FR_OK && br == 1) {
-          if (c == '\\' && escape == 0) {
-            escape = 1;
-            continue;
-          } else if (c != '\\' && escape > 0 &&
-                     escape < (int)sizeof(escape_chars)) {
-            escape_chars[escape - 1] = c;
-
-            if (escape == 2 && !strncmp(escape_chars, "up", 2)) {
-              *ptr++ = STR_CHAR_UP[0];
-              c = STR_CHAR_UP[1];
-              escape = 0;
-            } else if (escape == 2 && !strncmp(escape_chars, "dn", 2)) {
-              *ptr++ = STR_CHAR_DOWN[0];
-              c = STR_CHAR_DOWN[1];
-              escape = 0;
-            } else if (escape == 3) {
-              int val = atoi(escape_chars);
-              if (val >= 200 && val < 225) {
-                *ptr++ = '\302';
-                c = '\200' + val - 200;
-              }
-            } else if (escape == 1 && c == '~') {
-              c = 'z' + 1;
-            } else {
-              escape++;
-              continue;
-            }
-          } else if (c == '\t') {
-            c = 0x1D;  // tab
-          }
-          escape = 0;
-
-          if (c == 0xA && *(ptr - 1) == 0xD) {
-            *(ptr - 1) = '\n';
-            continue;
-          }
-          *ptr++ = c;
+  char* ptr = line;
+
+  for (const char* src = line; *src; src++) {
+    char c = *src;
+    if (c == '\\' && escape == 0) {
+      escape = 1;
+      continue;
+    } else if (c != '\\' && escape > 0 &&
+               escape < (int)sizeof(escape_chars)) {
+      escape_chars[escape - 1] = c;
+
+      if (escape == 2 && !strncmp(escape_chars, "up", 2)) {
+        *ptr++ = STR_CHAR_UP[0];
+        c = STR_CHAR_UP[1];
+        escape = 0;
+      } else if (escape == 2 && !strncmp(escape_chars, "dn", 2)) {
+        *ptr++ = STR_CHAR_DOWN[0];
+        c = STR_CHAR_DOWN[1];
+        escape = 0;
+      } else if (escape == 3) {
+        int val = atoi(escape_chars);
+        if (val >= 200 && val < 225) {
+          *ptr++ = '\302';
+          c = '\200' + val - 200;
         }
+      } else if (escape == 1 && c == '~') {
+        c = 'z' + 1;
+      } else {
+        escape++;
+        continue;
       }
-      *ptr = '\0';
+    } else if (c == '\t') {
+      c = 0x1D;  // tab
     }
-    f_close(&file);
+    escape = 0;
+    *ptr++ = c;
+  }
+
+  *ptr = '\0';
+  return ptr;
+}
+
+FRESULT ViewTextWindow::readPage(uint32_t line)
+{
+  TextFileReader reader;
+
+  auto res = reader.open(fullPath.c_str());
+  if (res == FR_OK) res = reader.seekLine(index, line);
+  if (res == FR_OK) {
+    char* ptr = buffer;
+    char* end = buffer + TEXT_PAGE_SIZE;
+    pageLines = 0;
+    // keep room for the end of line and the final '\0'
+    while (pageLines < TEXT_PAGE_LINES && end - ptr > 2) {
+      if (reader.readLine(ptr, end - ptr - 1) < 0) break;
+      ptr = decodeTextLine(ptr);
+      *ptr++ = '\n';
+      pageLines++;
+    }
+    if (ptr > buffer) ptr--;
+    *ptr = '\0';
+    topLine = line;
   }
   return res;
 }
@@ -188,24 +225,14 @@ FRESULT ViewTextWindow::sdReadTextFileBlock(const uint32_t bufSize,
 void ViewTextWindow::onEvent(event_t event)
 {
 #if defined(HARDWARE_KEYS)
-  if (int(bufSize) < fileLength) {
-    TRACE("BEFORE offset=%d", offset);
-    if (event == EVT_KEY_BREAK(KEY_PAGEDN)) {
-      offset += bufSize;
-      TRACE("event=DOWN");
+  if (lb) {
+    if (event == EVT_KEY_BREAK(KEY_PAGEDN) && hasNextPage()) {
+      showPage(topLine + pageLines);
     }
 
-    if (event == EVT_KEY_BREAK(KEY_PAGEUP)) {
-      TRACE("event=UP");
-      offset -= bufSize;
+    if (event == EVT_KEY_BREAK(KEY_PAGEUP) && topLine > 0) {
+      showPage(topLine - std::min(topLine, TEXT_PAGE_LINES));
     }
-
-    offset = std::max(offset, 0);
-    offset = std::min(offset, fileLength - (int)bufSize);
-
-    TRACE("AFTER offset=%d", offset);
-    sdReadTextFileBlock(bufSize, offset);
-    lv_label_set_text_static(lb, buffer);
   }
 
   if(event == EVT_KEY_BREAK(KEY_EXIT))
@@ -319,14 +346,11 @@ class ViewChecklistWindow : public ViewTextWindow
 
         checkBoxes.clear();
 
-        size_t cur = 0;
-
-        for(int i=0; i<bufSize; ++i)
-        {
-          if (buffer[i] == '\n' || buffer[i] == '\r') {
-            buffer[i] = 0;
-            if (buffer[i] == '\r' && buffer[i+1] == '\n')
-              i += 1;
+        TextFileReader reader;
+        if (reader.open(fullPath.c_str()) == FR_OK) {
+          while (reader.readLine(buffer, TEXT_PAGE_SIZE) >= 0) {
+            decodeTextLine(buffer);
+            const char* text = buffer;
 
             lv_obj_t* row = lv_obj_create(obj);
             lv_obj_set_layout(row, LV_LAYOUT_FLEX);
@@ -339,8 +363,8 @@ class ViewChecklistWindow : public ViewTextWindow
 
             lv_coord_t w = lv_obj_get_content_width(obj) - 6;
 
-            if (buffer[cur] == '=') {
-              cur++;
+            if (text[0] == '=') {
+              text++;
               w -= 46;
 
               lv_obj_set_style_pad_left(row, 10, 0);
@@ -361,9 +385,7 @@ class ViewChecklistWindow : public ViewTextWindow
             auto lbl = lv_label_create(row);
             lv_obj_set_width(lbl, w);
             lv_label_set_long_mode(lbl, LV_LABEL_LONG_WRAP);
-            lv_label_set_text_static(lbl, &buffer[cur]);
-
-            cur = i + 1;
+            lv_label_set_text(lbl, text);
           }
         }
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include "ff.h"
+#include "text_file.h"
 #include "menus.h"
 #include "page.h"
 
@@ -30,8 +31,7 @@ class ViewTextWindow : public Page
   ViewTextWindow(const std::string path, const std::string name,
                  unsigned int icon = ICON_RADIO_SD_MANAGER);
 
-  FRESULT sdReadTextFileBlock(const uint32_t bufSize,
-                              const uint32_t offset);
+  FRESULT readPage(uint32_t line);
 
   ~ViewTextWindow()
   {
@@ -53,22 +53,29 @@ class ViewTextWindow : public Page
   std::string fullPath;
   std::string extension;
 
-  lv_obj_t* lb;
+  lv_obj_t* lb = nullptr;
 
-  int offset = 0;
+  // one page of lines at a time, from the line index
   char* buffer = nullptr;
-  size_t bufSize = 0;
-  int fileLength = 0;
+  TextFileIndex index;
+  uint32_t topLine = 0;
+  uint32_t pageLines = 0;
   bool openFromEnd;
+  bool paging = false;
 
   void extractNameSansExt(void);
   virtual void buildBody(Window* window);
 
   bool openFile();
+  bool hasNextPage() const;
+  void showPage(uint32_t line, bool atEnd = false);
+
+  void checkEvents() override;
 
   void onEvent(event_t event) override;
 
   static void on_draw(lv_event_t * e);
+  static void on_scroll(lv_event_t * e);
 };
 
 void readModelNotes(bool fromMenu = false);
@@ -103,6 +103,20 @@ void Widget::update()
 {
 }
 
+bool Widget::invalidateOnChange(uint32_t & lastKey, uint32_t key)
+{
+  return invalidateOnChange(lastKey, key, {0, 0, width(), height()});
+}
+
+bool Widget::invalidateOnChange(uint32_t & lastKey, uint32_t key,
+                                const rect_t & rect)
+{
+  if (key == lastKey) return false;
+  lastKey = key;
+  invalidate(rect);
+  return true;
+}
+
 void Widget::setFullscreen(bool enable)
 {
   if (!fsAllowed) return;
@@ -121,6 +121,13 @@ class Widget : public Button
 
     virtual void onFullscreen(bool enable) {}
     void openMenu();
+
+    // Change detection: 'key' stands for what is displayed (formatted text,
+    // quantized values...). The widget, or only 'rect' within it, is
+    // invalidated if the key differs from 'lastKey', which is then updated.
+    bool invalidateOnChange(uint32_t & lastKey, uint32_t key);
+    bool invalidateOnChange(uint32_t & lastKey, uint32_t key,
+                            const rect_t & rect);
 };
 
 void registerWidget(const WidgetFactory * factory);
@@ -26,7 +26,7 @@
 #include "view_main.h"
 #include "color_picker.h"
 
-#define SET_DIRTY()     storageDirty(EE_MODEL)
+#define SET_DIRTY()     storageDirty(EE_SCREENS)
 
 static const rect_t widgetSettingsDialogRect = {
   LCD_W / 10, // x
@@ -30,12 +30,12 @@ class GaugeWidget: public Widget
     {
     }
 
-    void refresh(BitmapBuffer * dc) override
+    // Gauge fill width (pixels) and percentage, as displayed
+    void getGauge(int & w, int & percent)
     {
       mixsrc_t index = persistentData->options[0].value.unsignedValue;
       int32_t min = persistentData->options[1].value.signedValue;
       int32_t max = persistentData->options[2].value.signedValue;
-      uint16_t color = persistentData->options[3].value.unsignedValue;
 
       int32_t value = getValue(index);
 
@@ -46,8 +46,17 @@ class GaugeWidget: public Widget
 
       value = limit(min, value, max);
 
-      int w = divRoundClosest(width() * (value - min), (max - min));
-      int percent = divRoundClosest(100 * (value - min), (max - min));
+      w = divRoundClosest(width() * (value - min), (max - min));
+      percent = divRoundClosest(100 * (value - min), (max - min));
+    }
+
+    void refresh(BitmapBuffer * dc) override
+    {
+      mixsrc_t index = persistentData->options[0].value.unsignedValue;
+      uint16_t color = persistentData->options[3].value.unsignedValue;
+
+      int w, percent;
+      getGauge(w, percent);
 
       // Gauge label
       drawSource(dc, 0, 0, index, FONT(XS) | COLOR_THEME_PRIMARY2);
@@ -63,15 +72,13 @@ class GaugeWidget: public Widget
     {
       Widget::checkEvents();
 
-      auto newValue = getValue(persistentData->options[0].value.unsignedValue);
-      if (lastValue != newValue) {
-        lastValue = newValue;
-        invalidate();
-      }
+      int w, percent;
+      getGauge(w, percent);
+      invalidateOnChange(lastKey, (w << 8) | percent);
     }
 
     static const ZoneOption options[];
-    int32_t lastValue = 0;
+    uint32_t lastKey = 0;
 };
 
 const ZoneOption GaugeWidget::options[] = {
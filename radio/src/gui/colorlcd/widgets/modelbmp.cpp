@@ -21,8 +21,7 @@
 
 #include "opentx.h"
 #include "widgets_container_impl.h"
-
-#include <memory>
+#include "bitmap_cache.h"
 
 class ModelBitmapWidget: public Widget
 {
@@ -53,9 +52,8 @@ class ModelBitmapWidget: public Widget
         dc->drawSolidFilledRect(0, 0, width(), height(), fillColour);
       }
 
-      if (buffer &&
-          ((buffer->width() != width()) || (buffer->height() != height()) ||
-           (deps_hash != getHash()))) {
+      if ((loadedWidth != width()) || (loadedHeight != height()) ||
+          (deps_hash != getHash())) {
 
         loadBitmap();
         deps_hash = getHash();
@@ -64,16 +62,19 @@ class ModelBitmapWidget: public Widget
       // big space to draw
       if (rect.h >= 96 && rect.w >= 120) {
 
-        if (!filename.empty() && buffer) {
-          dc->drawBitmap(0, 38, buffer.get());
+        if (!filename.empty() && bitmap) {
+          dc->drawBitmap((width() - bitmap->width()) / 2,
+                         38 + (height() - 38 - bitmap->height()) / 2,
+                         bitmap.get());
         }
 
         dc->drawSizedText(5, 5, g_model.header.name, LEN_MODEL_NAME, fontSize | fontColor);
       }
       // smaller space to draw
       else {
-        if (!filename.empty() && buffer) {
-          dc->drawBitmap(0, 0, buffer.get());
+        if (!filename.empty() && bitmap) {
+          dc->drawBitmap((width() - bitmap->width()) / 2,
+                         (height() - bitmap->height()) / 2, bitmap.get());
         }
         else {
           dc->drawSizedText(0, 0, g_model.header.name, LEN_MODEL_NAME, fontSize | fontColor);
@@ -92,7 +93,9 @@ class ModelBitmapWidget: public Widget
     static const ZoneOption options[];
 
   protected:
-    std::unique_ptr<BitmapBuffer> buffer;
+    SharedBitmap bitmap;
+    coord_t loadedWidth = 0;
+    coord_t loadedHeight = 0;
     uint32_t deps_hash = 0;
 
     uint32_t getHash()
@@ -105,22 +108,18 @@ class ModelBitmapWidget: public Widget
       std::string filename = std::string(g_model.header.bitmap);
       std::string fullpath = std::string(BITMAPS_PATH PATH_SEPARATOR) + filename;
 
-      if (!buffer || (buffer->width() != width()) || (buffer->height() != height())) {
-        buffer.reset(new BitmapBuffer(BMP_ARGB4444, width(), height()));
-      }
+      loadedWidth = width();
+      loadedHeight = height();
 
-      buffer->clear();
+      bitmap.reset();
       if (!filename.empty()) {
-        std::unique_ptr<BitmapBuffer> bitmap(BitmapBuffer::loadBitmap(fullpath.c_str()));
-        if (!bitmap) {
-          TRACE("could not load bitmap '%s'", filename.c_str());
-          return;
-        }
-
         if (rect.h >= 96 && rect.w >= 120) {
-          buffer->drawScaledBitmap(bitmap.get(), 0, 0, width(), height() - 38);
+          bitmap = bitmapCacheGet(fullpath.c_str(), width(), height() - 38);
         } else {
-          buffer->drawScaledBitmap(bitmap.get(), 0, 0, width(), height());
+          bitmap = bitmapCacheGet(fullpath.c_str(), width(), height());
+        }
+        if (!bitmap) {
+          TRACE("could not load bitmap '%s'", filename.c_str());
         }
       }
     }
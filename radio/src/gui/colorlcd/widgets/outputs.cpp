@@ -28,8 +28,6 @@
 #define VIEW_CHANNELS_LIMIT_PCT \
   (g_model.extendedLimits ? LIMIT_EXT_PERCENT : 100)
 
-constexpr uint32_t OUTPUTS_REFRESH = 1000 / 5;  // 5 Hz
-
 class OutputsWidget : public Widget
 {
  public:
@@ -131,21 +129,40 @@ class OutputsWidget : public Widget
   {
     Widget::checkEvents();
 
-    // Last time we refreshed the window
-    uint32_t now = RTOS_GET_MS();
-    if (now - lastRefresh >= OUTPUTS_REFRESH) {
-      lastRefresh = now;
-      invalidate();
-    }
+    uint8_t columns;
+    if (width() > 300 && height() > 20)
+      columns = 2;
+    else if (width() > 100 && height() > 20)
+      columns = 1;
+    else
+      return;
 
-    invalidate();
+    // same layout as drawChannels()
+    const coord_t w = (columns == 2 ? (width() / 2) - 1 : width());
+    const uint8_t numChan = height() / ROW_HEIGHT;
+    const uint8_t rowH =
+        (height() - numChan * ROW_HEIGHT >= numChan ? ROW_HEIGHT + 1
+                                                    : ROW_HEIGHT);
+    uint8_t curChan = persistentData->options[0].value.unsignedValue;
+
+    // only the rows whose value or name changed are redrawn
+    for (uint8_t col = 0; col < columns; col++) {
+      for (uint8_t row = 0; row < numChan; row++, curChan++) {
+        if (curChan < 1 || curChan > MAX_OUTPUT_CHANNELS) return;
+        const LimitData& limitData = g_model.limitData[curChan - 1];
+        uint32_t key = calcRESXto100(channelOutputs[curChan - 1]) ^
+                       hash(limitData.name, sizeof(limitData.name));
+        invalidateOnChange(lastKeys[curChan - 1], key,
+                           {col * (width() / 2), row * rowH, w, rowH + 1});
+      }
+    }
   }
 
   static const ZoneOption options[];
 
  protected:
-  // Last time we refreshed the window
-  uint32_t lastRefresh = 0;
+  // What each channel row shows
+  uint32_t lastKeys[MAX_OUTPUT_CHANNELS] = {0};
 };
 
 const ZoneOption OutputsWidget::options[] = {
@@ -83,9 +83,54 @@ STATIC_LZ4_BITMAP(LBM_TOPMENU_TXBATT);
 STATIC_LZ4_BITMAP(LBM_TOPMENU_TXBATT_CHARGING);
 STATIC_LZ4_BITMAP(LBM_TOPMENU_ANTENNA);
 
+static const uint8_t rssiBarsValue[] = {30, 40, 50, 60, 80};
+static const uint8_t rssiBarsHeight[] = {5, 10, 15, 21, 31};
+
+static uint8_t rssiBars()
+{
+  uint8_t bars = 0;
+  while (bars < DIM(rssiBarsValue) && TELEMETRY_RSSI() >= rssiBarsValue[bars])
+    bars++;
+  return bars;
+}
+
+// 0 (muted) to 4
+static uint8_t volumeLevel()
+{
+  if (requiredSpeakerVolume == 0 || g_eeGeneral.beepMode == e_mode_quiet)
+    return 0;
+  else if (requiredSpeakerVolume < 7)
+    return 1;
+  else if (requiredSpeakerVolume < 13)
+    return 2;
+  else if (requiredSpeakerVolume < 19)
+    return 3;
+  return 4;
+}
+
 class RadioInfoWidget: public Widget
 {
   protected:
+    uint32_t lastKey = 0;
+
+    // everything shown, so that the widget is only redrawn when it changes
+    uint32_t statusKey() const
+    {
+      uint32_t key = usbPlugged();
+      key = (key << 1) | (getSelectedUsbMode() == USB_UNSELECTED_MODE);
+      key = (key << 1) | (isFunctionActive(FUNCTION_LOGS) && BLINK_ON_PHASE);
+#if defined(INTERNAL_MODULE_PXX1) && defined(EXTERNAL_ANTENNA)
+      key = (key << 1) | (isModuleXJT(INTERNAL_MODULE) && isExternalAntennaEnabled());
+#endif
+#if defined(USB_CHARGER)
+      key = (key << 1) | usbChargerLed();
+#endif
+      key = (key << 3) | rssiBars();
+      key = (key << 3) | volumeLevel();
+      key = (key << 3) | GET_TXBATT_BARS(5);
+      // never 0, so that the first check draws the widget
+      return (key << 1) | 1;
+    }
 
   public:
     RadioInfoWidget(const WidgetFactory* factory, Window* parent,
@@ -113,14 +158,12 @@ class RadioInfoWidget: public Widget
       }
 
       // RSSI
-      const uint8_t rssiBarsValue[] = {30, 40, 50, 60, 80};
-      const uint8_t rssiBarsHeight[] = {5, 10, 15, 21, 31};
+      uint8_t rssi = rssiBars();
       for (unsigned int i = 0; i < DIM(rssiBarsHeight); i++) {
         uint8_t height = rssiBarsHeight[i];
         dc->drawSolidFilledRect(W_RSSI_X + i * 6, 35 - height, 4, height,
-                                TELEMETRY_RSSI() >= rssiBarsValue[i]
-                                    ? COLOR_THEME_PRIMARY2
-                                    : COLOR_THEME_PRIMARY3);
+                                i < rssi ? COLOR_THEME_PRIMARY2
+                                         : COLOR_THEME_PRIMARY3);
       }
 
 #if defined(INTERNAL_MODULE_PXX1) && defined(EXTERNAL_ANTENNA)
@@ -131,13 +174,14 @@ class RadioInfoWidget: public Widget
 
       /* Audio volume */
       dc->drawBitmapPattern(W_AUDIO_X, 1, LBM_TOPMENU_VOLUME_SCALE, COLOR_THEME_PRIMARY3);
-      if (requiredSpeakerVolume == 0 || g_eeGeneral.beepMode == e_mode_quiet)
+      uint8_t volume = volumeLevel();
+      if (volume == 0)
         dc->drawBitmapPattern(W_AUDIO_X, 1, LBM_TOPMENU_VOLUME_0, COLOR_THEME_PRIMARY2);
-      else if (requiredSpeakerVolume < 7)
+      else if (volume == 1)
         dc->drawBitmapPattern(W_AUDIO_X, 1, LBM_TOPMENU_VOLUME_1, COLOR_THEME_PRIMARY2);
-      else if (requiredSpeakerVolume < 13)
+      else if (volume == 2)
         dc->drawBitmapPattern(W_AUDIO_X, 1, LBM_TOPMENU_VOLUME_2, COLOR_THEME_PRIMARY2);
-      else if (requiredSpeakerVolume < 19)
+      else if (volume == 3)
         dc->drawBitmapPattern(W_AUDIO_X, 1, LBM_TOPMENU_VOLUME_3, COLOR_THEME_PRIMARY2);
       else
         dc->drawBitmapPattern(W_AUDIO_X, 1, LBM_TOPMENU_VOLUME_4, COLOR_THEME_PRIMARY2);
@@ -162,7 +206,7 @@ class RadioInfoWidget: public Widget
     void checkEvents() override
     {
       Widget::checkEvents();
-      invalidate();
+      invalidateOnChange(lastKey, statusKey());
     }
 
     static const ZoneOption options[];
@@ -210,9 +254,17 @@ class DateTimeWidget: public Widget
     void checkEvents() override
     {
       Widget::checkEvents();
-      invalidate();
+
+      struct gtm t;
+      gettime(&t);
+      uint32_t shown[3] = {(uint32_t)getValue(MIXSRC_TX_TIME),
+                           (uint32_t)(t.tm_mon << 8 | t.tm_mday),
+                           persistentData->options[0].value.unsignedValue};
+      invalidateOnChange(lastKey, hash(shown, sizeof(shown)));
     }
 
+    uint32_t lastKey = 0;
+
     static const ZoneOption options[];
 };
 
@@ -259,9 +311,14 @@ class InternalGPSWidget: public Widget
     void checkEvents() override
     {
       Widget::checkEvents();
-      invalidate();
+      uint32_t key = (hasSerialMode(UART_MODE_GPS) != -1);
+      key = (key << 1) | gpsData.fix;
+      key = (key << 8) | gpsData.numSat;
+      invalidateOnChange(lastKey, (key << 1) | 1);
     }
 
+    uint32_t lastKey = 0;
+
     static const ZoneOption options[];
 };
 
@@ -151,16 +151,14 @@ class TimerWidget : public Widget
   void checkEvents() override
   {
     Widget::checkEvents();
-    auto newValue =
-        timersStates[persistentData->options[0].value.unsignedValue].val;
-    if (lastValue != newValue) {
-      lastValue = newValue;
-      invalidate();
-    }
+    // the timer is shown with a 1s resolution
+    invalidateOnChange(
+        lastKey,
+        timersStates[persistentData->options[0].value.unsignedValue].val);
   }
 
   static const ZoneOption options[];
-  tmrval_t lastValue = 0;
+  uint32_t lastKey = 0;
 };
 
 const ZoneOption TimerWidget::options[] = {
@@ -192,15 +192,19 @@ class ValueWidget: public Widget
     {
       Widget::checkEvents();
 
-      auto newValue = getValue(persistentData->options[0].value.unsignedValue);
-      if (lastValue != newValue) {
-        lastValue = newValue;
-        invalidate();
+      // redraw only when the value shown or its colour changes
+      mixsrc_t field = persistentData->options[0].value.unsignedValue;
+      int32_t shown[2] = {getSourceDisplayValue(field, getValue(field)), 0};
+      if (field >= MIXSRC_FIRST_TELEM) {
+        TelemetryItem& telemetryItem =
+            telemetryItems[(field - MIXSRC_FIRST_TELEM) / 3];
+        shown[1] = telemetryItem.isAvailable() && !telemetryItem.isOld();
       }
+      invalidateOnChange(lastKey, hash(shown, sizeof(shown)));
     }
 
     static const ZoneOption options[];
-    int32_t lastValue = 0;
+    uint32_t lastKey = 0;
 };
 
 const ZoneOption ValueWidget::options[] = {
@@ -135,8 +135,11 @@ class WidgetsContainerImpl : public WidgetsContainer
     for (int i = 0; i < N; i++) {
       if (widgets[i]) {
         auto zone = getZone(i);
-        widgets[i]->setRect(zone);
-        widgets[i]->updateZoneRect(zone);
+        // moving a widget re-lays it out: leave those in place alone
+        if (widgets[i]->getRect() != zone) {
+          widgets[i]->setRect(zone);
+          widgets[i]->updateZoneRect(zone);
+        }
       }
     }
   }
@@ -127,7 +127,7 @@ void SetupWidgetsPage::deleteLater(bool detach, bool trash)
   FormWindow::deleteLater(detach, trash);
   new ScreenMenu(customScreenIdx + 1);
 
-  storageDirty(EE_MODEL);
+  storageDirty(EE_SCREENS);
 }
 
 void SetupWidgetsPage::onEvent(event_t event)
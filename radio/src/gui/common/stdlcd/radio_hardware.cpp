@@ -78,6 +78,8 @@ enum {
   ITEM_RADIO_HARDWARE_SERIAL_PORT,
   ITEM_RADIO_HARDWARE_SERIAL_PORT_END = ITEM_RADIO_HARDWARE_SERIAL_PORT + MAX_SERIAL_PORTS - 1,
   ITEM_RADIO_HARDWARE_JITTER_FILTER,
+  ITEM_RADIO_HARDWARE_STICK_FILTER,
+  ITEM_RADIO_HARDWARE_STICK_FILTER_CUTOFF,
   ITEM_RADIO_HARDWARE_RAS,
   ITEM_RADIO_HARDWARE_SPORT_UPDATE_POWER,
   ITEM_RADIO_HARDWARE_DEBUG,
@@ -202,6 +204,9 @@ static void _init_menu_tab_array(uint8_t* tab, size_t len)
   }
   tab[ITEM_RADIO_HARDWARE_SERIAL_PORT_LABEL] = has_serial ? READONLY_ROW : HIDDEN_ROW;
   tab[ITEM_RADIO_HARDWARE_JITTER_FILTER] = 0;
+  tab[ITEM_RADIO_HARDWARE_STICK_FILTER] = 0;
+  tab[ITEM_RADIO_HARDWARE_STICK_FILTER_CUTOFF] =
+    g_eeGeneral.stickFilter != STICK_FILTER_JITTER ? (uint8_t)0 : HIDDEN_ROW;
   tab[ITEM_RADIO_HARDWARE_RAS] = READONLY_ROW;
 
   auto mod_desc = modulePortGetModuleDescription(SPORT_MODULE);
@@ -400,6 +405,19 @@ void menuRadioHardware(event_t event)
                              event);
         break;
 
+      case ITEM_RADIO_HARDWARE_STICK_FILTER:
+        g_eeGeneral.stickFilter = editChoice(HW_SETTINGS_COLUMN2, y, STR_STICK_FILTER, STR_STICK_FILTER_TYPES, g_eeGeneral.stickFilter, 0, STICK_FILTER_MAX, attr, event);
+        break;
+
+      case ITEM_RADIO_HARDWARE_STICK_FILTER_CUTOFF:
+        lcdDrawTextAlignedLeft(y, STR_STICK_FILTER_CUTOFF);
+        lcdDrawText(HW_SETTINGS_COLUMN2, y, "1/", attr);
+        lcdDrawNumber(lcdNextPos, y, adcStickFilterDivisor(g_eeGeneral.stickFilterCutoff), attr|LEFT);
+        if (attr) {
+          g_eeGeneral.stickFilterCutoff = checkIncDecGen(event, g_eeGeneral.stickFilterCutoff, 0, 7);
+        }
+        break;
+
       case ITEM_RADIO_HARDWARE_RAS:
 #if defined(HARDWARE_INTERNAL_RAS)
         lcdDrawTextAlignedLeft(y, "RAS");
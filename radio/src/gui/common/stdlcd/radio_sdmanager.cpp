@@ -117,6 +117,11 @@ void onUpdateStateChanged()
 }
 #endif
 
+static void onPasteProgress(const char * destPath, uint32_t done, uint32_t total)
+{
+  drawProgressScreen(STR_PASTE, getBasename(destPath), done, total);
+}
+
 void onSdManagerMenu(const char * result)
 {
   TCHAR lfn[FF_MAX_LFN+1];
@@ -152,7 +157,8 @@ void onSdManagerMenu(const char * result)
         destNamePtr = destFileName;
     }
     POPUP_WARNING(sdCopyFile(clipboard.data.sd.filename,
-                             clipboard.data.sd.directory, destNamePtr, lfn));
+                             clipboard.data.sd.directory, destNamePtr, lfn,
+                             onPasteProgress));
     REFRESH_FILES();
   }
   else if (result == STR_RENAME_FILE) {
@@ -21,76 +21,68 @@
 
 #include "opentx.h"
 
-constexpr uint32_t TEXT_FILE_MAXSIZE = 2048;
 constexpr char NON_CHECKABLE_PREFIX = '=';
 int checklistPosition;
 
-static void sdReadTextFile(const char * filename, char lines[TEXT_VIEWER_LINES][LCD_COLS + 1], int & lines_count)
+static void decodeTextLine(const char * src, char * line)
 {
-  FIL file;
-  int result;
-  char c;
-  unsigned int sz;
   int line_length = 0;
   uint8_t escape = 0;
   char escape_chars[4] = {0};
-  int current_line = 0;
 
-  memclear(lines, TEXT_VIEWER_LINES * (LCD_COLS + 1));
-
-  result = f_open(&file, filename, FA_OPEN_EXISTING | FA_READ);
-  if (result == FR_OK) {
-    for (uint32_t i = 0; i < TEXT_FILE_MAXSIZE && f_read(&file, &c, 1, &sz) == FR_OK && sz == 1 && (lines_count == 0 || current_line - menuVerticalOffset < int(TEXT_VIEWER_LINES)); i++) {
-      if (c == '\n') {
-        ++current_line;
-        line_length = 0;
-        escape = 0;
+  for (char c = *src; c != '\0' && line_length < LCD_COLS; c = *++src) {
+    if (c == '\\' && escape == 0) {
+      escape = 1;
+      continue;
+    }
+    else if (c != '\\' && escape > 0 && escape < sizeof(escape_chars)) {
+      escape_chars[escape - 1] = c;
+      if (escape == 2 && !strncmp(escape_chars, "up", 2)) {
+        line[line_length++] = STR_CHAR_UP[0];
+        c = STR_CHAR_UP[1];
       }
-      else if (c != '\r' && current_line >= menuVerticalOffset && current_line - menuVerticalOffset < int(TEXT_VIEWER_LINES) && line_length < LCD_COLS) {
-        if (c == '\\' && escape == 0) {
-          escape = 1;
-          continue;
-        }
-        else if (c != '\\' && escape > 0 && escape < sizeof(escape_chars)) {
-          escape_chars[escape - 1] = c;
-          if (escape == 2 && !strncmp(escape_chars, "up", 2)) {
-            lines[current_line-menuVerticalOffset][line_length++] = STR_CHAR_UP[0];
-            c = STR_CHAR_UP[1];
-          }
-          else if (escape == 2 && !strncmp(escape_chars, "dn", 2)) {
-            lines[current_line-menuVerticalOffset][line_length++] = STR_CHAR_DOWN[0];
-            c = STR_CHAR_DOWN[1];
-          }
-          else if (escape == 3) {
-            int val = atoi(escape_chars);
-            if (val >= 200 && val < 225) {
-              lines[current_line-menuVerticalOffset][line_length++] = '\302';
-              c = '\200' + val - 200;
-            }
-          }
-          else {
-            escape++;
-            continue;
-          }
-        }
-        else if (c=='~') {
-          c = 'z'+1;
-        }
-        else if (c=='\t') {
-          c = 0x1D; //tab
+      else if (escape == 2 && !strncmp(escape_chars, "dn", 2)) {
+        line[line_length++] = STR_CHAR_DOWN[0];
+        c = STR_CHAR_DOWN[1];
+      }
+      else if (escape == 3) {
+        int val = atoi(escape_chars);
+        if (val >= 200 && val < 225) {
+          line[line_length++] = '\302';
+          c = '\200' + val - 200;
         }
-        escape = 0;
-        lines[current_line-menuVerticalOffset][line_length++] = c;
       }
+      else {
+        escape++;
+        continue;
+      }
+    }
+    else if (c=='~') {
+      c = 'z'+1;
     }
-    if (c != '\n') {
-      current_line += 1;
+    else if (c=='\t') {
+      c = 0x1D; //tab
     }
-    f_close(&file);
+    escape = 0;
+    line[line_length++] = c;
   }
+  line[LCD_COLS] = '\0';
+}
+
+// Only the visible lines are read, from the line index
+static void sdReadTextFile(const char * filename, char lines[TEXT_VIEWER_LINES][LCD_COLS + 1])
+{
+  TextFileReader reader;
+  char line[4 * LCD_COLS + 1];  // escape sequences take up to 4 characters
 
-  if (lines_count == 0) {
-    lines_count = current_line;
+  memclear(lines, TEXT_VIEWER_LINES * (LCD_COLS + 1));
+
+  if (reader.open(filename) == FR_OK &&
+      reader.seekLine(reusableBuffer.viewText.index, menuVerticalOffset) == FR_OK) {
+    for (int i = 0; i < int(TEXT_VIEWER_LINES); i++) {
+      if (reader.readLine(line, sizeof(line)) < 0) break;
+      decodeTextLine(line, lines[i]);
+    }
   }
 }
 
@@ -132,17 +124,25 @@ void menuTextView(event_t event)
       menuVerticalOffset = 0;
 	  checklistPosition = 0;
       reusableBuffer.viewText.checklistComplete = false;
-      reusableBuffer.viewText.linesCount = 0;
-      sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines, reusableBuffer.viewText.linesCount);
-  } else if (IS_PREVIOUS_EVENT(event)) {
+      textIndexInit(reusableBuffer.viewText.index);
+      textIndexUpdate(reusableBuffer.viewText.index, reusableBuffer.viewText.filename);
+      reusableBuffer.viewText.linesCount = textIndexLines(reusableBuffer.viewText.index);
+      sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines);
+  } else if (!reusableBuffer.viewText.index.complete) {
+    // the rest of the file is indexed in the background
+    textIndexUpdate(reusableBuffer.viewText.index, reusableBuffer.viewText.filename);
+    reusableBuffer.viewText.linesCount = textIndexLines(reusableBuffer.viewText.index);
+  }
+
+  if (IS_PREVIOUS_EVENT(event)) {
     if (menuVerticalOffset > 0) {
       menuVerticalOffset--;
-      sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines, reusableBuffer.viewText.linesCount);
+      sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines);
     }
   } else if (IS_NEXT_EVENT(event)) {
     if (menuVerticalOffset + LCD_LINES-1 < reusableBuffer.viewText.linesCount) {
       ++menuVerticalOffset;
-      sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines, reusableBuffer.viewText.linesCount);
+      sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines);
     }
   } else if (event == EVT_KEY_BREAK(KEY_ENTER)) {
     if (g_model.checklistInteractive && !reusableBuffer.viewText.pushMenu && checklistPosition-(int)menuVerticalOffset >= 0){
@@ -151,7 +151,7 @@ void menuTextView(event_t event)
           ++checklistPosition;
           if (checklistPosition-(int)menuVerticalOffset >= LCD_LINES-2 && menuVerticalOffset+LCD_LINES-1 < reusableBuffer.viewText.linesCount) {
             ++menuVerticalOffset;
-            sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines, reusableBuffer.viewText.linesCount);
+            sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines);
           }
         }
       }
@@ -175,7 +175,7 @@ void menuTextView(event_t event)
           ++checklistPosition;
           if (checklistPosition-(int)menuVerticalOffset == LCD_LINES-1 && menuVerticalOffset+LCD_LINES-1 < reusableBuffer.viewText.linesCount) {
             ++menuVerticalOffset;
-            sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines, reusableBuffer.viewText.linesCount);
+            sdReadTextFile(reusableBuffer.viewText.filename, reusableBuffer.viewText.lines);
             i = 0;  // Reset rendering of the display after changing the offest
           }
         }
@@ -374,6 +374,10 @@ const char * getMultiOptionTitleStatic(uint8_t moduleIdx);
 const char *getMultiOptionTitle(uint8_t moduleIdx);
 
 const char * writeScreenshot();
+#if defined(COLORLCD)
+// Writes the next rows of the screenshot being taken, if any
+void screenshotWakeup();
+#endif
 
 uint8_t expandableSection(coord_t y, const char* title, uint8_t value, uint8_t attr, event_t event);
 
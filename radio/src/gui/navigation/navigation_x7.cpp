@@ -59,7 +59,8 @@ int checkIncDec(event_t event, int val, int i_min, int i_max,
       if (IS_KEY_REPT(event) && (i_flags & INCDEC_REP10)) {
         newval += min(10, i_max - val);
       } else {
-        newval += min<int>(rotaryEncoderGetAccel(), i_max - val);
+        newval += min<int>(rotaryEncoderGetAccel() * rotaryEncoderGetSteps(),
+                           i_max - val);
       }
 
       while (isValueAvailable && !isValueAvailable(newval) && newval <= i_max) {
@@ -76,7 +77,8 @@ int checkIncDec(event_t event, int val, int i_min, int i_max,
       if (IS_KEY_REPT(event) && (i_flags & INCDEC_REP10)) {
         newval -= min(10, val - i_min);
       } else {
-        newval -= min<int>(rotaryEncoderGetAccel(), val - i_min);
+        newval -= min<int>(rotaryEncoderGetAccel() * rotaryEncoderGetSteps(),
+                           val - i_min);
       }
 
       while (isValueAvailable && !isValueAvailable(newval) && newval >= i_min) {
@@ -373,18 +375,21 @@ void check(event_t event, uint8_t curr, const MenuHandler *menuTab,
         }
       }
 
-      do {
+      // coalesced rotary events move by several rows
+      for (uint8_t steps = rotaryEncoderGetSteps(); steps > 0; steps--) {
+        do {
 #if defined(ROTARY_ENCODER_NAVIGATION)
-        if (g_eeGeneral.rotEncMode >=
-            ROTARY_ENCODER_MODE_INVERT_VERT_HORZ_NORM) {
-          DEC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
-        } else {
-          INC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
-        }
+          if (g_eeGeneral.rotEncMode >=
+              ROTARY_ENCODER_MODE_INVERT_VERT_HORZ_NORM) {
+            DEC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
+          } else {
+            INC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
+          }
 #else
-        INC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount-1);
+          INC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount-1);
 #endif
-      } while (CURSOR_NOT_ALLOWED_IN_ROW(l_posVert));
+        } while (CURSOR_NOT_ALLOWED_IN_ROW(l_posVert));
+      }
 
       s_editMode = 0; // if we go down, we must be in this mode
 
@@ -415,18 +420,20 @@ void check(event_t event, uint8_t curr, const MenuHandler *menuTab,
 #endif
       }
 
-      do {
+      for (uint8_t steps = rotaryEncoderGetSteps(); steps > 0; steps--) {
+        do {
 #if defined(ROTARY_ENCODER_NAVIGATION)
-        if (g_eeGeneral.rotEncMode >=
-            ROTARY_ENCODER_MODE_INVERT_VERT_HORZ_NORM) {
-          INC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
-        } else {
-          DEC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
-        }
+          if (g_eeGeneral.rotEncMode >=
+              ROTARY_ENCODER_MODE_INVERT_VERT_HORZ_NORM) {
+            INC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
+          } else {
+            DEC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount - 1);
+          }
 #else
-        DEC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount-1);
+          DEC(l_posVert, MENU_FIRST_LINE_EDIT(horTab, horTabMax), rowcount-1);
 #endif
-      } while (CURSOR_NOT_ALLOWED_IN_ROW(l_posVert));
+        } while (CURSOR_NOT_ALLOWED_IN_ROW(l_posVert));
+      }
 
       s_editMode = 0; // if we go up, we must be in this mode
 
@@ -24,7 +24,7 @@
 constexpr uint16_t BMP_HEADERSIZE = 0x76;
 
 #if defined(COLORLCD)
-constexpr uint8_t BMP_BITS_PER_PIXEL = 32;
+constexpr uint8_t BMP_BITS_PER_PIXEL = 24;
 #else
 constexpr uint8_t BMP_BITS_PER_PIXEL = 4;
 #endif
@@ -50,9 +50,8 @@ const uint8_t BMP_HEADER[] = {
   0x11, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-const char * writeScreenshot()
+static const char * openScreenshot(FIL * bmpFile)
 {
-  FIL bmpFile;
   UINT written;
   char filename[42]; // /SCREENSHOTS/screen-2013-01-01-123540.bmp
 
@@ -74,58 +73,119 @@ const char * writeScreenshot()
   strcpy(tmp, BMP_EXT);
 #endif
 
-  FRESULT result = f_open(&bmpFile, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  FRESULT result = f_open(bmpFile, filename, FA_CREATE_ALWAYS | FA_WRITE);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
-  result = f_write(&bmpFile, BMP_HEADER, sizeof(BMP_HEADER), &written);
+  result = f_write(bmpFile, BMP_HEADER, sizeof(BMP_HEADER), &written);
   if (result != FR_OK || written != sizeof(BMP_HEADER)) {
-    f_close(&bmpFile);
+    f_close(bmpFile);
     return SDCARD_ERROR(result);
   }
 
+  return nullptr;
+}
+
 #if defined(COLORLCD)
-  lv_img_dsc_t* snapshot = lv_snapshot_take(lv_scr_act(), LV_IMG_CF_TRUE_COLOR);
-  if (!snapshot) { f_close(&bmpFile); return nullptr; }
 
-  auto w = snapshot->header.w;
-  auto h = snapshot->header.h;
+// Rows written to the SD card per GUI cycle
+constexpr uint8_t SCREENSHOT_ROWS_PER_CYCLE = 8;
+constexpr uint32_t SCREENSHOT_ROW_SIZE = LCD_W * BMP_BITS_PER_PIXEL / 8;
 
-  for (int y = h - 1; y >= 0; y--) {
-    for (uint32_t x = 0; x < w; x++) {
+// The screen is captured at once into a snapshot, which is then written
+// a few rows per GUI cycle by screenshotWakeup(), so that the UI keeps
+// running while the file is written
+static FIL screenshotFile;
+static lv_img_dsc_t * screenshot = nullptr;
+static int screenshotRow;
+static uint8_t screenshotRows[SCREENSHOT_ROWS_PER_CYCLE * SCREENSHOT_ROW_SIZE] __DMA;
+
+static void closeScreenshot()
+{
+  lv_snapshot_free(screenshot);
+  screenshot = nullptr;
+  f_close(&screenshotFile);
+}
+
+const char * writeScreenshot()
+{
+  // the previous screenshot is still being written
+  if (screenshot) return nullptr;
+
+  const char * error = openScreenshot(&screenshotFile);
+  if (error) return error;
+
+  screenshot = lv_snapshot_take(lv_scr_act(), LV_IMG_CF_TRUE_COLOR);
+  if (!screenshot) {
+    f_close(&screenshotFile);
+    return nullptr;
+  }
+
+  // BMP rows are stored bottom-up
+  screenshotRow = screenshot->header.h - 1;
+  return nullptr;
+}
 
-      lv_color_t pixel = lv_img_buf_get_px_color(snapshot, x, y, {});
+void screenshotWakeup()
+{
+  if (!screenshot) return;
 
-      uint32_t dst = (0xFF << 24)
-          | (pixel.ch.red << 19)
-          | (pixel.ch.green << 10)
-          | (pixel.ch.blue << 3);
+  auto w = min<uint32_t>(screenshot->header.w, LCD_W);
+  uint8_t * dst = screenshotRows;
 
-      if (f_write(&bmpFile, &dst, sizeof(dst), &written) != FR_OK || written != sizeof(dst)) {
-        lv_snapshot_free(snapshot);
-        f_close(&bmpFile);
-        return SDCARD_ERROR(result);
-      }
+  for (int n = 0; n < SCREENSHOT_ROWS_PER_CYCLE && screenshotRow >= 0;
+       n++, screenshotRow--) {
+    uint8_t * row = dst;
+    for (uint32_t x = 0; x < w; x++) {
+      lv_color_t pixel = lv_img_buf_get_px_color(screenshot, x, screenshotRow, {});
+      *dst++ = pixel.ch.blue << 3;
+      *dst++ = pixel.ch.green << 2;
+      *dst++ = pixel.ch.red << 3;
     }
+    memclear(dst, row + SCREENSHOT_ROW_SIZE - dst);
+    dst = row + SCREENSHOT_ROW_SIZE;
   }
 
-  lv_snapshot_free(snapshot);
+  UINT size = dst - screenshotRows;
+  UINT written;
+  if (f_write(&screenshotFile, screenshotRows, size, &written) != FR_OK ||
+      written != size) {
+    TRACE("screenshot: write error");
+    closeScreenshot();
+    return;
+  }
+
+  if (screenshotRow < 0) {
+    closeScreenshot();
+  }
+}
 
 #else // stdlcd
 
+const char * writeScreenshot()
+{
+  FIL bmpFile;
+  UINT written;
+
+  const char * error = openScreenshot(&bmpFile);
+  if (error) return error;
+
+  uint8_t row[(LCD_W + 7) / 8 * 4];
   for (int y=LCD_H-1; y>=0; y-=1) {
+    uint8_t * dst = row;
     for (int x=0; x<8*((LCD_W+7)/8); x+=2) {
-      pixel_t byte = getPixel(x+1, y) + (getPixel(x, y) << 4);
-      if (f_write(&bmpFile, &byte, 1, &written) != FR_OK || written != 1) {
-        f_close(&bmpFile);
-        return SDCARD_ERROR(result);
-      }
+      *dst++ = getPixel(x+1, y) + (getPixel(x, y) << 4);
+    }
+    FRESULT result = f_write(&bmpFile, row, sizeof(row), &written);
+    if (result != FR_OK || written != sizeof(row)) {
+      f_close(&bmpFile);
+      return SDCARD_ERROR(result);
     }
   }
-#endif
 
   f_close(&bmpFile);
 
   return nullptr;
 }
+#endif
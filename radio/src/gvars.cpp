@@ -24,7 +24,14 @@
 uint8_t gvarDisplayTimer = 0;
 uint8_t gvarLastChanged = 0;
 
-uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+// Flight mode holding the value of each GVar, for each flight mode.
+// The inheritance chains only change with the model data, so they are
+// followed once per model revision instead of on every lookup.
+static uint8_t gvarFlightModes[MAX_FLIGHT_MODES][MAX_GVARS];
+static uint16_t gvarFlightModesRevision;
+static bool gvarFlightModesValid = false;
+
+static uint8_t resolveGVarFlightMode(uint8_t fm, uint8_t gv)
 {
   for (uint8_t i=0; i<MAX_FLIGHT_MODES; i++) {
     if (fm == 0) return 0;
@@ -37,6 +44,29 @@ uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to
   return 0;
 }
 
+static void updateGVarFlightModes()
+{
+  uint16_t revision = modelDataRevision;
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv=0; gv<MAX_GVARS; gv++) {
+      gvarFlightModes[fm][gv] = resolveGVarFlightMode(fm, gv);
+    }
+  }
+  gvarFlightModesRevision = revision;
+  gvarFlightModesValid = true;
+}
+
+uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+{
+  if (fm >= MAX_FLIGHT_MODES || gv >= MAX_GVARS)
+    return resolveGVarFlightMode(fm, gv);
+
+  if (!gvarFlightModesValid || gvarFlightModesRevision != modelDataRevision)
+    updateGVarFlightModes();
+
+  return gvarFlightModes[fm][gv];
+}
+
 int16_t getGVarValue(int8_t gv, int8_t fm)
 {
   int8_t mul = 1;
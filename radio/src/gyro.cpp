@@ -20,36 +20,87 @@
  */
 
 #include "opentx.h"
-#define _USE_MATH_DEFINES
-#include <math.h>
 
-#define ACC_LSB_VALUE	0.000488  // 0.488 mg/LSB
+// 1/65536 degree per LSB and per sample (0.0078 deg/s / LSB at 208 Hz)
+#define GYRO_SCALE_NUM    20133
+#define GYRO_SCALE_SHIFT  13
 
-#define ALPHA 0.98
-#define DT    0.01
-#define SCALE_FACT_ACC  0.005
-#define SCALE_FACT_GYRO 0.0078 // 250deg/s / 32000
+// accelerometer weight per sample, 1/65536 (time constant ~0.5s)
+#define ACC_WEIGHT        637
+
+#define ANGLE_ONE         (1 << 16)
+#define ANGLE_90          (90 * ANGLE_ONE)
+#define ANGLE_180         (180 * ANGLE_ONE)
 
 Gyro gyro;
 
-static float deg2RESX(float deg)
+// atan2 in 1/65536 degree, error below 0.1 degree, in bounded time
+static int32_t atan2Angle(int32_t y, int32_t x)
+{
+  int32_t ax = abs(x);
+  int32_t ay = abs(y);
+  if (ax == 0 && ay == 0) return 0;
+
+  // z = min / max in Q15
+  bool swap = ay > ax;
+  int64_t z = swap ? ((int64_t)ax << 15) / ay : ((int64_t)ay << 15) / ax;
+
+  // atan(z) = 45z - z(z - 1)(14.02 + 3.80z) degrees, for 0 <= z <= 1
+  int64_t poly = 918834 + ((248952 * z) >> 15);
+  int64_t corr = (z * (z - (1 << 15))) >> 15;
+  int32_t angle = ((ANGLE_90 / 2 * z) >> 15) - ((corr * poly) >> 15);
+
+  if (swap) angle = ANGLE_90 - angle;
+  if (x < 0) angle = ANGLE_180 - angle;
+  return y < 0 ? -angle : angle;
+}
+
+static int16_t angle2RESX(int32_t angle)
 {
   // [-90 : 90] -> [-RESX : RESX]
-  return (deg * float(RESX)) / 90.0;
+  return ((int64_t)angle * RESX) / ANGLE_90;
 }
 
-void Gyro::wakeup()
+void Gyro::fuse(const int16_t values[IMU_VALUES_COUNT], uint16_t periods)
 {
-  static tmr10ms_t gyroWakeupTime = 0;
+  int32_t gx = values[0];
+  int32_t gy = values[1];
+  // int32_t gz = values[2];
 
-  tmr10ms_t now = get_tmr10ms();
-  if (errors >= 100 || now < gyroWakeupTime)
-    return;
+  int32_t ax = values[3];
+  int32_t ay = values[4];
+  int32_t az = values[5];
+
+  // integrate gyro
+  roll  -= (gx * GYRO_SCALE_NUM >> GYRO_SCALE_SHIFT) * periods;
+  pitch += (gy * GYRO_SCALE_NUM >> GYRO_SCALE_SHIFT) * periods;
+
+  int32_t magn = abs(ax) + abs(ay) + abs(az);
+  if (magn > 8192 && magn < 32768) {
+
+    if (az < 0) az = -az;
+
+    int32_t rollAcc  = atan2Angle(ay, az);
+    int32_t pitchAcc = atan2Angle(ax, az);
+
+    int32_t weight = min<int32_t>(ACC_WEIGHT * periods, ANGLE_ONE);
+    roll  += ((int64_t)(rollAcc - roll) * weight) >> 16;
+    pitch += ((int64_t)(pitchAcc - pitch) * weight) >> 16;
+  }
+
+  roll = limit<int32_t>(-ANGLE_180, roll, ANGLE_180);
+  pitch = limit<int32_t>(-ANGLE_180, pitch, ANGLE_180);
+}
 
-  gyroWakeupTime = now + 1; /* 10ms default */
+void Gyro::wakeup()
+{
+  if (errors >= 100)
+    return;
 
-  int16_t values[IMU_VALUES_COUNT];
-  if (gyroRead((uint8_t*)values) < 0) {
+  int16_t samples[IMU_FIFO_MAX_SAMPLES][IMU_VALUES_COUNT];
+  uint16_t dropped;
+  int count = gyroReadFifo(samples, IMU_FIFO_MAX_SAMPLES, &dropped);
+  if (count < 0) {
     ++errors;
     return;
   }
@@ -59,32 +110,17 @@ void Gyro::wakeup()
   // stopping the sensor forever
   errors = 0;
 
-  int16_t gx = values[0];
-  int16_t gy = values[1];
-  // int16_t gz = values[2];
-
-  int16_t ax = values[3];
-  int16_t ay = values[4];
-  int16_t az = values[5];
-
-  // integrate gyro
-  roll  -= gx * SCALE_FACT_GYRO * DT;
-  pitch += gy * SCALE_FACT_GYRO * DT;
-
-  int32_t magn = abs(ax) + abs(ay) + abs(az);
-  if (magn > 8192 && magn < 32768) {
-
-    if (az < 0) az = -az;
-        
-    float rollAcc  = atan2f((float)ay,(float)az) * 57.3 /* 180/PI */;
-    float pitchAcc = atan2f((float)ax,(float)az) * 57.3 /* 180/PI */;
+  if (count == 0)
+    return;
 
-    roll  = roll  * ALPHA + rollAcc  * (1.0-ALPHA);
-    pitch = pitch * ALPHA + pitchAcc * (1.0-ALPHA);
+  // dropped samples are covered by the first one
+  for (int i = 0; i < count; i++) {
+    fuse(samples[i], i == 0 ? 1 + dropped : 1);
   }
 
-  outputs[0] = deg2RESX(roll);
-  outputs[1] = deg2RESX(pitch);
+  outputs[0] = angle2RESX(roll);
+  outputs[1] = angle2RESX(pitch);
+  timestamp = RTOS_GET_MS();
 }
 
 int16_t Gyro::scaledX()
@@ -33,15 +33,25 @@
 #define IMU_SAMPLES_EXPONENT  3
 #define IMU_SAMPLES_COUNT     (2 ^ IMU_SAMPLES_EXPONENT)
 
+// Samples are queued in the sensor FIFO, and read in bursts once per
+// mixer cycle: at most IMU_FIFO_MAX_SAMPLES, the older ones are dropped
+#define IMU_SAMPLE_RATE       208 // Hz
+#define IMU_FIFO_MAX_SAMPLES  8
+
 class Gyro
 {
  protected:
   uint8_t errors = 0;
-  float roll = 0.0;
-  float pitch = 0.0;
+  // angles in 1/65536 degree
+  int32_t roll = 0;
+  int32_t pitch = 0;
+
+  void fuse(const int16_t values[IMU_VALUES_COUNT], uint16_t periods);
 
  public:
   int16_t outputs[2];
+  // time of the newest sample in outputs (ms)
+  uint32_t timestamp = 0;
 
   void wakeup();
 
@@ -54,3 +64,9 @@ extern Gyro gyro;
 // Gyro driver
 int gyroInit();
 int gyroRead(uint8_t buffer[IMU_BUFFER_LENGTH]);
+
+// Read up to maxSamples from the FIFO, oldest first. When more are
+// pending, they are dropped (count in dropped) and only the newest one
+// is returned. Returns the number of samples read, -1 on error.
+int gyroReadFifo(int16_t samples[][IMU_VALUES_COUNT], uint8_t maxSamples,
+                 uint16_t* dropped);
@@ -28,6 +28,7 @@
 
 const etx_hal_adc_driver_t* _hal_adc_driver = nullptr;
 const etx_hal_adc_inputs_t* _hal_adc_inputs = nullptr;
+static const etx_hal_serial_sticks_t* _hal_serial_sticks = nullptr;
 
 static uint16_t adcValues[MAX_ANALOG_INPUTS] __DMA;
 
@@ -44,6 +45,17 @@ bool adcInit(const etx_hal_adc_driver_t* driver)
   return false;
 }
 
+void adcSetSerialSticks(const etx_hal_serial_sticks_t* driver)
+{
+  _hal_serial_sticks = driver;
+}
+
+uint32_t adcGetSticksAge()
+{
+  if (!_hal_serial_sticks || !_hal_serial_sticks->get_age_us) return 0;
+  return _hal_serial_sticks->get_age_us();
+}
+
 static bool adcSingleRead()
 {
   if (!_hal_adc_driver)
@@ -62,6 +74,11 @@ static bool adcSingleRead()
 bool adcRead()
 {
   adcSingleRead();
+
+  // fetch the freshest serial sticks frame
+  if (_hal_serial_sticks && _hal_serial_sticks->poll) {
+    _hal_serial_sticks->poll();
+  }
   
   // TODO: this hack needs to go away...
   if (isVBatBridgeEnabled()) {
@@ -258,6 +275,144 @@ uint32_t s_anaFilt[MAX_ANALOG_INPUTS];
   #error "JITTER_FILTER_STRENGTH and ANALOG_SCALE are too big, their summ should be <= 5 !!!"
 #endif
 
+// Stick filters (see StickFilterTypes)
+//
+// Both filters run once per getADC() call, that is once per mixer period,
+// so their cutoff is expressed as a divisor of the mixer rate. The input
+// and the stored outputs use s_anaFilt[] units, outputs with 8 extra
+// fractional bits so that low cutoffs do not lose small stick moves.
+#define STICK_FILTER_FRAC       8
+#define STICK_FILTER_MAX        ((ADC_MAX_VALUE >> (1 - ANALOG_SCALE)) * JITTER_ALPHA)
+
+static const uint8_t _stick_filter_divisors[] = {8, 12, 16, 24, 32, 48, 64, 96};
+
+// 2nd order Butterworth low-pass at fc = fs / divisor (Q28),
+// with b1 = 2 * b0 and b2 = b0
+#define BIQUAD_COEFF_BITS       28
+
+struct BiquadCoeffs {
+  int32_t b0;
+  int32_t a1;
+  int32_t a2;
+};
+
+static const BiquadCoeffs _biquad_coeffs[] = {
+  { 26207642, -253083375,  89478485 },
+  { 13284859, -343498714, 128202693 },
+  {  8040872, -390370540, 154098572 },
+  {  3865857, -438353264, 185381237 },
+  {  2266318, -462722643, 203352459 },
+  {  1051227, -487301911, 223071364 },
+  {   604405, -499655328, 233637491 },
+  {   274668, -512041069, 244704284 },
+};
+
+// 1-euro: the cutoff starts at fs / divisor and rises with the
+// (low-passed) stick speed, so fast moves only see a very short lag.
+// Cutoffs are stored as w = 2 * PI * fc / fs (Q16).
+#define ONE_EURO_TWO_PI         411775  // 2 * PI (Q16)
+#define ONE_EURO_BETA           64      // w increase per s_anaFilt unit per period
+#define ONE_EURO_DX_SHIFT       2       // speed low-pass, alpha = 1/4
+
+struct StickFilterState {
+  int32_t x1, x2;  // previous inputs
+  int32_t y1, y2;  // previous outputs (Q8)
+  int32_t dx;      // 1-euro speed estimate (Q8)
+};
+
+static StickFilterState _stick_filter[MAX_STICKS];
+static uint8_t _stick_filter_config = 0xFF;
+static bool _stick_filter_primed = false;
+
+// Multipos decoding table: first position candidate for each range of
+// filtered values, built again whenever the calibration changes
+// (the steps are sorted by the calibration)
+#define XPOT_LUT_SHIFT 3
+#define XPOT_LUT_SIZE  (256 >> XPOT_LUT_SHIFT)
+
+struct XPotLookup {
+  StepsCalibData calib;
+  uint8_t pos[XPOT_LUT_SIZE];
+};
+
+static XPotLookup _xpot_lookup[MAX_POTS];
+
+static uint8_t xpotDecode(uint8_t pot, const StepsCalibData* calib,
+                          uint8_t value)
+{
+  XPotLookup& lut = _xpot_lookup[pot];
+  if (memcmp(&lut.calib, calib, sizeof(StepsCalibData)) != 0) {
+    lut.calib = *calib;
+    uint8_t pos = 0;
+    for (uint32_t i = 0; i < XPOT_LUT_SIZE; i++) {
+      while (pos < calib->count && (i << XPOT_LUT_SHIFT) >= calib->steps[pos])
+        pos++;
+      lut.pos[i] = pos;
+    }
+  }
+
+  // boundaries within the range are then checked one by one
+  uint8_t pos = lut.pos[value >> XPOT_LUT_SHIFT];
+  while (pos < calib->count && value >= calib->steps[pos]) pos++;
+  return pos;
+}
+
+uint8_t adcStickFilterDivisor(uint8_t cutoff)
+{
+  if (cutoff >= DIM(_stick_filter_divisors)) return 0;
+  return _stick_filter_divisors[cutoff];
+}
+
+static int32_t biquadFilter(StickFilterState& st, uint8_t cutoff, int32_t x)
+{
+  const BiquadCoeffs& c = _biquad_coeffs[cutoff];
+  int64_t acc = (int64_t)c.b0 * ((x + 2 * st.x1 + st.x2) << STICK_FILTER_FRAC)
+                - (int64_t)c.a1 * st.y1 - (int64_t)c.a2 * st.y2;
+  int32_t y = (int32_t)((acc + (1 << (BIQUAD_COEFF_BITS - 1))) >> BIQUAD_COEFF_BITS);
+
+  st.x2 = st.x1;
+  st.x1 = x;
+  st.y2 = st.y1;
+  st.y1 = y;
+  return y;
+}
+
+static int32_t oneEuroFilter(StickFilterState& st, uint8_t cutoff, int32_t x)
+{
+  int32_t in = x << STICK_FILTER_FRAC;
+  st.dx += ((in - st.y1) - st.dx) >> ONE_EURO_DX_SHIFT;
+
+  uint32_t speed = (uint32_t)abs(st.dx) >> STICK_FILTER_FRAC;
+  uint32_t w = ONE_EURO_TWO_PI / _stick_filter_divisors[cutoff] + ONE_EURO_BETA * speed;
+
+  // alpha = w / (w + 1), as 1 - 1 / (w + 1) to stay within 32 bit
+  int32_t alpha = 65536 - (int32_t)(0xFFFFFFFFu / (w + 65536));
+  int32_t y = st.y1 + (int32_t)(((int64_t)alpha * (in - st.y1)) >> 16);
+
+  st.y1 = y;
+  return y;
+}
+
+static uint32_t stickFilterApply(uint8_t stick, uint32_t v)
+{
+  StickFilterState& st = _stick_filter[stick];
+  int32_t x = v * JITTER_ALPHA;
+
+  if (!_stick_filter_primed) {
+    st.x1 = st.x2 = x;
+    st.y1 = st.y2 = x << STICK_FILTER_FRAC;
+    st.dx = 0;
+  }
+
+  uint8_t cutoff = g_eeGeneral.stickFilterCutoff;
+  int32_t y = (g_eeGeneral.stickFilter == STICK_FILTER_BIQUAD) ?
+    biquadFilter(st, cutoff, x) : oneEuroFilter(st, cutoff, x);
+
+  // the biquad slightly overshoots on steps
+  y = (y + (1 << (STICK_FILTER_FRAC - 1))) >> STICK_FILTER_FRAC;
+  return limit<int32_t>(0, y, STICK_FILTER_MAX);
+}
+
 uint16_t anaIn(uint8_t chan)
 {
   if (chan >= MAX_ANALOG_INPUTS) return 0;
@@ -279,6 +434,7 @@ void anaSetFiltered(uint8_t chan, uint16_t val)
 void anaResetFiltered()
 {
   memset(s_anaFilt, 0, sizeof(s_anaFilt));
+  _stick_filter_primed = false;
 }
 
 #if defined(JITTER_MEASURE)
@@ -312,6 +468,8 @@ void getADC()
 {
   uint8_t max_analogs = adcGetMaxInputs(ADC_INPUT_ALL);
   uint8_t pot_offset = adcGetInputOffset(ADC_INPUT_POT);
+  uint8_t stick_offset = adcGetInputOffset(ADC_INPUT_MAIN);
+  uint8_t max_sticks = min<uint8_t>(adcGetMaxInputs(ADC_INPUT_MAIN), MAX_STICKS);
 
 #if defined(JITTER_MEASURE)
   if (JITTER_MEASURE_ACTIVE() && jitterResetTime < get_tmr10ms()) {
@@ -329,6 +487,16 @@ void getADC()
       TRACE("adcRead failed");
   DEBUG_TIMER_STOP(debugTimerAdcRead);
 
+  // restart the stick filters from the current position
+  // whenever their settings change
+  uint8_t stick_filter_config =
+      (g_eeGeneral.stickFilter << 3) | g_eeGeneral.stickFilterCutoff;
+  if (stick_filter_config != _stick_filter_config) {
+    _stick_filter_config = stick_filter_config;
+    _stick_filter_primed = false;
+  }
+  bool stick_filter_used = false;
+
   // TODO: jitter filter should probably still be applied
   //       to VBAT and RTC_BAT, no matter what is configured
   //
@@ -385,7 +553,14 @@ void getADC()
       useJitterFilter = (g_model.jitterFilter == OVERRIDE_ON)?1:0;
     }
 
-    if (useJitterFilter && diff < (10*ANALOG_MULTIPLIER)) {
+    uint8_t stick = x - stick_offset;
+    if (useJitterFilter && x >= stick_offset && stick < max_sticks &&
+        g_eeGeneral.stickFilter != STICK_FILTER_JITTER) {
+      // sticks use the selected filter, without any bypass
+      s_anaFilt[x] = stickFilterApply(stick, v);
+      stick_filter_used = true;
+    }
+    else if (useJitterFilter && diff < (10*ANALOG_MULTIPLIER)) {
       // apply jitter filter
       s_anaFilt[x] = (s_anaFilt[x] - previous) + v;
     }
@@ -405,15 +580,16 @@ void getADC()
     if (IS_POT_MULTIPOS(x - pot_offset) && IS_MULTIPOS_CALIBRATED(calib)) {
       // TODO: consider adding another low pass filter to eliminate multipos switching glitches
       uint8_t vShifted = ANA_FILT(x) >> 4;
-      s_anaFilt[x] = ANAFILT_MAX;
-      for (uint32_t i = 0; i < calib->count; i++) {
-        if (vShifted < calib->steps[i]) {
-          s_anaFilt[x] = (i * (ANAFILT_MAX + JITTER_ALPHA * ANALOG_MULTIPLIER)) / calib->count;
-          break;
-        }
-      }
+      uint8_t i = xpotDecode(x - pot_offset, calib, vShifted);
+      if (i < calib->count)
+        s_anaFilt[x] = (i * (ANAFILT_MAX + JITTER_ALPHA * ANALOG_MULTIPLIER)) / calib->count;
+      else
+        s_anaFilt[x] = ANAFILT_MAX;
     }
   }
+
+  // filters that did not run this time are restarted on next use
+  _stick_filter_primed = stick_filter_used;
 }
 
 potconfig_t adcGetDefaultPotsConfig()
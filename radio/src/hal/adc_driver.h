@@ -80,7 +80,22 @@ struct etx_hal_adc_driver_t {
   void (*wait_completion)();
 };
 
+// Sticks read over a serial link instead of the ADC
+// (e.g. FlySky hall gimbals)
+struct etx_hal_serial_sticks_t {
+
+  // process pending frames, called right before the values are used
+  void (*poll)();
+
+  // time since the current values were received (us)
+  uint32_t (*get_age_us)();
+};
+
 bool adcInit(const etx_hal_adc_driver_t* driver);
+void adcSetSerialSticks(const etx_hal_serial_sticks_t* driver);
+
+// Age of the current stick values (us), 0 if sampled by the ADC
+uint32_t adcGetSticksAge();
 // void adcDeInit();
 
 bool     adcRead();
@@ -124,6 +139,9 @@ potconfig_t adcGetDefaultPotsConfig();
 uint8_t adcGetMaxInputs(uint8_t type);
 uint8_t adcGetInputOffset(uint8_t type);
 
+// Stick filter cutoff as a divisor of the mixer rate (0 if invalid)
+uint8_t adcStickFilterDivisor(uint8_t cutoff);
+
 uint8_t adcGetMaxCalibratedInputs();
 
 uint16_t adcGetInputValue(uint8_t type, uint8_t idx);
@@ -58,4 +58,13 @@ struct etx_proto_driver_t {
 
     // Process input data byte (telemetry)
     void (*processData)(void* context, uint8_t data, uint8_t* buffer, uint8_t* len);
+
+    // Process a block of input data (optional, used instead of
+    // processData() when the serial driver exposes its receive buffer)
+    void (*processSpan)(void* context, const uint8_t* data, uint32_t size,
+                        uint8_t* buffer, uint8_t* len);
+
+    // Process the frames queued while receiving
+    // (optional, called once per telemetry poll)
+    void (*processQueued)(void* context);
 };
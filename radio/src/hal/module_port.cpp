@@ -22,6 +22,7 @@
 #include "module_port.h"
 #include "dataconstants.h" // MAX_MODULES
 #include "myeeprom.h"      // g_eeGeneral
+#include "debug.h"
 
 #include <string.h>
 
@@ -31,6 +32,18 @@ extern const uint8_t _n_modules;
 static etx_module_state_t _module_states[MAX_MODULES];
 static uint8_t _module_power;
 
+// Serial ports released by a driver during a swap keep running, so that
+// the next driver of the same module can take them over
+struct etx_parked_port_t {
+  etx_module_driver_t drv;
+  etx_serial_init params;
+};
+
+static etx_serial_init _serial_params[MAX_MODULES][2]; // TX, RX
+static etx_parked_port_t _parked_ports[MAX_MODULES][2];
+static uint8_t _module_swapping;
+static void (*_rx_idle_cb)() = nullptr;
+
 #if defined(CONFIGURABLE_MODULE_PORT)
 // supplemental configurable port
 static etx_module_port_t _extra_module_port;
@@ -44,7 +57,10 @@ void modulePortConfigExtra(const etx_module_port_t* port)
 void modulePortInit()
 {
   memset(_module_states, 0, sizeof(_module_states));
+  memset(_serial_params, 0, sizeof(_serial_params));
+  memset(_parked_ports, 0, sizeof(_parked_ports));
   _module_power = 0;
+  _module_swapping = 0;
 
 #if defined(CONFIGURABLE_MODULE_PORT)
   memset(&_extra_module_port, 0, sizeof(_extra_module_port));
@@ -57,11 +73,90 @@ static void modulePortClear(etx_module_state_t* st)
   memset(st, 0, sizeof(etx_module_state_t));
 }
 
-static void _init_serial_driver(etx_module_driver_t* d, const etx_module_port_t* port,
+static void _deinit_driver(etx_module_driver_t* d);
+
+// a parked port can be taken over if only the baudrate changes
+// (and S.PORT stays on the same side of the over-sampling threshold)
+static bool _can_reuse_port(const etx_parked_port_t* p,
+                            const etx_module_port_t* port,
+                            const etx_serial_init* params)
+{
+  if (p->drv.port != port) return false;
+  if (p->params.encoding != params->encoding ||
+      p->params.direction != params->direction)
+    return false;
+
+  if (p->params.baudrate != params->baudrate) {
+    if (!port->drv.serial->setBaudrate) return false;
+    if (port->port == ETX_MOD_PORT_SPORT &&
+        (p->params.baudrate >= 400000) != (params->baudrate >= 400000))
+      return false;
+  }
+
+  return true;
+}
+
+static void _release_parked(etx_parked_port_t* p)
+{
+  if (p->drv.port) _deinit_driver(&p->drv);
+  memset(p, 0, sizeof(etx_parked_port_t));
+}
+
+static void _release_all_parked(uint8_t module)
+{
+  auto parked = _parked_ports[module];
+  if (parked[1].drv.ctx == parked[0].drv.ctx) {
+    // bidir port: de-init only once
+    memset(&parked[1], 0, sizeof(etx_parked_port_t));
+  }
+  _release_parked(&parked[0]);
+  _release_parked(&parked[1]);
+}
+
+// returns the context of a parked port taken over, nullptr otherwise
+static void* _take_over_parked(uint8_t module, const etx_module_port_t* port,
+                               const etx_serial_init* params)
+{
+  auto parked = _parked_ports[module];
+  for (uint8_t i = 0; i < 2; i++) {
+    auto p = &parked[i];
+    if (!p->drv.port || p->drv.port->hw_def != port->hw_def) continue;
+
+    if (!_can_reuse_port(p, port, params)) {
+      _release_all_parked(module);
+      return nullptr;
+    }
+
+    void* ctx = p->drv.ctx;
+    auto drv = port->drv.serial;
+    if (p->params.baudrate != params->baudrate) {
+      drv->setBaudrate(ctx, params->baudrate);
+    }
+    if (drv->clearRxBuffer) drv->clearRxBuffer(ctx);
+
+    // the other side of a bidir port goes along
+    auto other = &parked[i ^ 1];
+    if (other->drv.ctx == ctx) memset(other, 0, sizeof(etx_parked_port_t));
+    memset(p, 0, sizeof(etx_parked_port_t));
+    return ctx;
+  }
+  return nullptr;
+}
+
+static void _init_serial_driver(uint8_t module, etx_module_driver_t* d,
+                                const etx_module_port_t* port,
                                 const etx_serial_init* params)
 {
   auto drv = port->drv.serial;
-  d->ctx = drv->init(port->hw_def, params);
+  d->ctx = _take_over_parked(module, port, params);
+  if (!d->ctx) {
+    d->ctx = drv->init(port->hw_def, params);
+    if (!d->ctx && (_module_swapping & (1 << module))) {
+      // the hardware might still be held by a parked port
+      _release_all_parked(module);
+      d->ctx = drv->init(port->hw_def, params);
+    }
+  }
   d->port = port;
 
   // S.PORT specific HW settings
@@ -137,6 +232,44 @@ static const etx_module_port_t* _find_port(uint8_t module, uint8_t type,
   return found_port;
 }
 
+static bool _driver_uses(const etx_module_driver_t* d, const etx_module_port_t* port)
+{
+  return d->port && d->port->hw_def == port->hw_def;
+}
+
+int8_t modulePortGetOwner(const etx_module_port_t* port)
+{
+  for (uint8_t i = 0; i < MAX_MODULES; i++) {
+    auto st = &_module_states[i];
+    if (_driver_uses(&st->tx, port) || _driver_uses(&st->rx, port) ||
+        _driver_uses(&_parked_ports[i][0].drv, port) ||
+        _driver_uses(&_parked_ports[i][1].drv, port)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static bool _check_owner(uint8_t module, const etx_module_port_t* port)
+{
+  int8_t owner = modulePortGetOwner(port);
+  if (owner >= 0 && owner != module) {
+    TRACE("Module #%d: port %d already used by module #%d", module,
+          port->port, owner);
+    return false;
+  }
+  return true;
+}
+
+bool modulePortIsAvailable(uint8_t module, uint8_t type, uint8_t port,
+                           uint8_t polarity)
+{
+  auto found_port = _find_port(module, type, port, polarity);
+  if (!found_port) return false;
+  int8_t owner = modulePortGetOwner(found_port);
+  return owner < 0 || owner == module;
+}
+
 const etx_module_t* modulePortGetModuleDescription(uint8_t module)
 {
   if (module >= _n_modules) return nullptr;
@@ -169,13 +302,26 @@ bool modulePortPowered(uint8_t module)
   return _module_power & (1 << module);
 }
 
+void modulePortSetRxIdleCb(void (*cb)())
+{
+  _rx_idle_cb = cb;
+}
+
+static void _set_rx_idle_cb(etx_module_driver_t* d)
+{
+  auto drv = d->port->drv.serial;
+  if (_rx_idle_cb && d->ctx && drv->setIdleCb) {
+    drv->setIdleCb(d->ctx, _rx_idle_cb);
+  }
+}
+
 etx_module_state_t* modulePortInitSerial(uint8_t module, uint8_t port,
                                          const etx_serial_init* params)
 {
   // TODO: match capabilities (1. USART -> 2. SOFT-SERIAL)
   const etx_module_port_t* found_port = _find_port(module, ETX_MOD_TYPE_SERIAL,
                                                    port, params->polarity);
-  if (!found_port) return nullptr;
+  if (!found_port || !_check_owner(module, found_port)) return nullptr;
 
   auto state = &(_module_states[module]);
 
@@ -185,18 +331,24 @@ etx_module_state_t* modulePortInitSerial(uint8_t module, uint8_t port,
   if (dir == duplex) {
 
     // init RX first, in case TX was already done previously
-    _init_serial_driver(&state->rx, found_port, params);
+    _init_serial_driver(module, &state->rx, found_port, params);
+    _set_rx_idle_cb(&state->rx);
+    _serial_params[module][1] = *params;
 
     // do not overwrite TX state if it has already been set:
     // -> support using S.PORT in bidir mode
     if (!state->tx.port) {
       state->tx.port = state->rx.port;
       state->tx.ctx = state->rx.ctx;
+      _serial_params[module][0] = *params;
     }
   } else if (dir == ETX_Dir_TX) {
-    _init_serial_driver(&state->tx, found_port, params);
+    _init_serial_driver(module, &state->tx, found_port, params);
+    _serial_params[module][0] = *params;
   } else if (dir == ETX_Dir_RX) {
-    _init_serial_driver(&state->rx, found_port, params);
+    _init_serial_driver(module, &state->rx, found_port, params);
+    _set_rx_idle_cb(&state->rx);
+    _serial_params[module][1] = *params;
   }
 
   return state;
@@ -207,7 +359,7 @@ etx_module_state_t* modulePortInitTimer(uint8_t module, uint8_t port,
 {
   const etx_module_port_t* found_port = _find_port(module, ETX_MOD_TYPE_TIMER,
                                                    port, ETX_Pol_Normal);
-  if (!found_port) return nullptr;
+  if (!found_port || !_check_owner(module, found_port)) return nullptr;
 
   auto state = &(_module_states[module]);
   _init_timer_driver(&state->tx, found_port, cfg);
@@ -229,19 +381,56 @@ static void _deinit_driver(etx_module_driver_t* d)
   }
 }
 
+static bool _park_driver(uint8_t module, uint8_t idx, etx_module_driver_t* d)
+{
+  if (!d->port || d->port->type != ETX_MOD_TYPE_SERIAL) return false;
+
+  auto p = &_parked_ports[module][idx];
+  p->drv = *d;
+  p->params = _serial_params[module][idx];
+  return true;
+}
+
 void modulePortDeInit(etx_module_state_t* st)
 {
+  uint8_t module = modulePortGetModule(st);
+  bool swapping = module < MAX_MODULES && (_module_swapping & (1 << module));
+
   if (st->tx.port != nullptr) {
-    _deinit_driver(&st->tx);
+    if (!swapping || !_park_driver(module, 0, &st->tx))
+      _deinit_driver(&st->tx);
   }
 
-  if (st->rx.port != nullptr && st->rx.port != st->tx.port) {
-    _deinit_driver(&st->rx);
+  if (st->rx.port != nullptr) {
+    if (st->rx.ctx == st->tx.ctx) {
+      // bidir port: parked along with TX
+      if (swapping && _parked_ports[module][0].drv.ctx == st->rx.ctx) {
+        _parked_ports[module][1] = _parked_ports[module][0];
+        _parked_ports[module][1].params = _serial_params[module][1];
+      }
+    } else if (!swapping || !_park_driver(module, 1, &st->rx)) {
+      _deinit_driver(&st->rx);
+    }
   }
 
+  if (module < MAX_MODULES)
+    memset(_serial_params[module], 0, sizeof(_serial_params[module]));
   modulePortClear(st);
 }
 
+void modulePortBeginSwap(uint8_t module)
+{
+  if (module >= MAX_MODULES) return;
+  _module_swapping |= (1 << module);
+}
+
+void modulePortEndSwap(uint8_t module)
+{
+  if (module >= MAX_MODULES) return;
+  _module_swapping &= ~(1 << module);
+  _release_all_parked(module);
+}
+
 etx_module_state_t* modulePortGetState(uint8_t module)
 {
   if (module >= MAX_MODULES) return nullptr;
@@ -124,6 +124,10 @@ void modulePortSetPower(uint8_t module, uint8_t enabled);
 
 bool modulePortPowered(uint8_t module);
 
+// Callback installed on the serial RX ports supporting an idle line IRQ
+// (called from the IRQ at the end of each received frame)
+void modulePortSetRxIdleCb(void (*cb)());
+
 // Init module port with params (driver & context stored locally)
 etx_module_state_t* modulePortInitSerial(uint8_t module, uint8_t port,
                                          const etx_serial_init* params);
@@ -135,6 +139,19 @@ etx_module_state_t* modulePortInitTimer(uint8_t module, uint8_t port,
 // De-init port and clear data
 void modulePortDeInit(etx_module_state_t* st);
 
+// Between these calls, the serial ports de-initialised by the module
+// driver keep running, and the next driver can take them over when only
+// the baudrate changes. Ports not taken over are de-initialised at the end.
+void modulePortBeginSwap(uint8_t module);
+void modulePortEndSwap(uint8_t module);
+
+// Module holding the hardware of this port (-1 if unused)
+int8_t modulePortGetOwner(const etx_module_port_t* port);
+
+// Port exists and is not used by another module
+bool modulePortIsAvailable(uint8_t module, uint8_t type, uint8_t port,
+                           uint8_t polarity);
+
 // Once initialized, retrieve module serial driver and context
 etx_module_state_t* modulePortGetState(uint8_t module);
 
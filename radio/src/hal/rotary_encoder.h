@@ -27,6 +27,9 @@
 #define ROTENC_MIDSPEED   5
 #define ROTENC_HIGHSPEED 50
 
+// max number of detents coalesced into one rotary event
+#define ROTENC_MAX_STEPS 16
+
 #if defined(RADIO_T20)
 #define ROTARY_ENCODER_GRANULARITY 4
 #else
@@ -46,3 +49,6 @@ rotenc_t rotaryEncoderGetRawValue();
 
 int8_t rotaryEncoderGetAccel();
 void rotaryEncoderResetAccel();
+
+// returns the # detents carried by the last event returned by getEvent()
+uint8_t rotaryEncoderGetSteps();
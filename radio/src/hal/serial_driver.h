@@ -90,6 +90,13 @@ typedef struct {
 
   // Fetch a byte by its index from the end of the buffer
   int (*getLastByte)(void* ctx, uint32_t idx, uint8_t* data);
+
+  // Get the next contiguous span of received bytes, in place
+  // (returns its length, 0 if none available)
+  uint32_t (*getRxSpan)(void* ctx, const uint8_t** data);
+
+  // Release the first 'len' bytes returned by getRxSpan()
+  void (*consumeRx)(void* ctx, uint32_t len);
   
   // Clear internal buffer
   void (*clearRxBuffer)(void* ctx);
@@ -78,5 +78,10 @@ uint32_t switchState(uint8_t pos_idx);
 // returns a position for a switch index
 SwitchHwPos switchGetPosition(uint8_t idx);
 
+// samples all switch inputs at once and returns a mask (bit = switch index)
+// of the switches whose inputs changed since the previous call
+// (ADC switches are always reported as changed)
+uint64_t switchSampleInputs();
+
 const char* switchGetName(uint8_t idx);
 SwitchHwType switchGetHwType(uint8_t idx);
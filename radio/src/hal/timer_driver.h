@@ -38,4 +38,8 @@ typedef struct {
   void* (*init)(void* hw_def, const etx_timer_config_t* cfg);
   void (*deinit)(void* ctx);
   void (*send)(void* ctx, const etx_timer_config_t* cfg, const void* pulses, uint16_t length);
+
+  // Optional: repeat the pulses in a loop until the next call or de-init.
+  // The pulses buffer is read continuously and can be updated in place.
+  void (*send_cyclic)(void* ctx, const etx_timer_config_t* cfg, const void* pulses, uint16_t length);
 } etx_timer_driver_t;
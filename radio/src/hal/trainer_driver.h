@@ -51,4 +51,6 @@ void stop_trainer_module_cppm();
 void init_trainer_module_sbus();
 void stop_trainer_module_sbus();
 int trainerModuleSbusGetByte(uint8_t* byte);
+uint32_t trainerModuleSbusGetRxSpan(const uint8_t** data);
+void trainerModuleSbusConsumeRx(uint32_t len);
 #endif
@@ -30,6 +30,7 @@ hapticQueue::hapticQueue()
   t_queueWidx = 0;
 
   hapticTick = 0;
+  hapticActive = false;
 }
 
 void hapticQueue::heartbeat()
@@ -40,8 +41,13 @@ void hapticQueue::heartbeat()
   if (buzzTimeLeft > 0) {
     buzzTimeLeft--; // time gets counted down
 #if defined(HAPTIC_PWM)
-    hapticOn(HAPTIC_STRENGTH() * 20);
+    // the PWM timer drives the motor, it is only set when a buzz starts
+    if (!hapticActive) {
+      hapticOn(HAPTIC_STRENGTH() * 20);
+      hapticActive = true;
+    }
 #else
+    hapticActive = true;
     if (hapticTick-- > 0) {
       hapticOn();
     }
@@ -52,7 +58,10 @@ void hapticQueue::heartbeat()
 #endif
   }
   else {
-    hapticOff();
+    if (hapticActive) {
+      hapticOff();
+      hapticActive = false;
+    }
     if (buzzPause > 0) {
       buzzPause--;
     }
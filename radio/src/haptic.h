@@ -62,6 +62,9 @@ class hapticQueue
 
     uint8_t hapticTick;
 
+    // the output is only written when it changes, not on each heartbeat
+    bool hapticActive;
+
     // queue arrays
     uint8_t queueHapticLength[HAPTIC_QUEUE_LENGTH];
     uint8_t queueHapticPause[HAPTIC_QUEUE_LENGTH];
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "popups.h"
+#include "timers_driver.h"
+
+// redrawing the progress screen takes longer than sending a block
+// to most devices, so it is refreshed at most this often
+#define FLASHING_PROGRESS_PERIOD    10 /*100ms*/
+
+// Progress and throughput of a firmware transfer, shared by the device
+// flashing drivers: the ProgressHandler is only called when the message
+// changes, the transfer completes or FLASHING_PROGRESS_PERIOD elapsed
+class FlashingProgress
+{
+  public:
+    FlashingProgress(ProgressHandler progressHandler, const char * title):
+      progressHandler(progressHandler),
+      title(title),
+      start(get_tmr10ms())
+    {
+    }
+
+    void report(const char * message, int count, int total)
+    {
+      tmr10ms_t now = get_tmr10ms();
+      if (message != lastMessage || count >= total ||
+          (tmr10ms_t)(now - lastReport) >= FLASHING_PROGRESS_PERIOD) {
+        lastMessage = message;
+        lastReport = now;
+        progressHandler(title, message, count, total);
+      }
+      transferred = count;
+    }
+
+    // average rate since the transfer started
+    uint32_t bytesPerSecond() const
+    {
+      tmr10ms_t elapsed = get_tmr10ms() - start;
+      return elapsed ? transferred * 100 / elapsed : 0;
+    }
+
+  protected:
+    ProgressHandler progressHandler;
+    const char * title;
+    const char * lastMessage = nullptr;
+    tmr10ms_t start;
+    tmr10ms_t lastReport = 0;
+    uint32_t transferred = 0;
+};
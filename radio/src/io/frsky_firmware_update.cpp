@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include "opentx.h"
 #include "frsky_firmware_update.h"
+#include "flashing_progress.h"
 #include "debug.h"
 #include "timers_driver.h"
 #include "tasks/mixer_task.h"
@@ -391,9 +392,10 @@ const char *FrskyDeviceFirmwareUpdate::uploadFileToHorusXJT(
   uart_drv->sendByte(uart_ctx, 0x82);
   readBuffer(frame, 1, 100);
 
+  FlashingProgress progress(progressHandler, getBasename(filename));
   uint8_t index = 0;
   while (true) {
-    progressHandler(getBasename(filename), STR_WRITING, file->fptr, file->obj.objsize);
+    progress.report(STR_WRITING, file->fptr, file->obj.objsize);
 
     if (f_read(file, buffer, 1024, &count) != FR_OK) {
       return STR_DEVICE_FILE_ERROR;
@@ -459,6 +461,7 @@ const char *FrskyDeviceFirmwareUpdate::uploadFileNormal(
   startFrame(PRIM_CMD_DOWNLOAD);
   sendFrame();
 
+  FlashingProgress progress(progressHandler, getBasename(filename));
   uint8_t retries = 0;
 
   while (true) {
@@ -482,7 +485,7 @@ const char *FrskyDeviceFirmwareUpdate::uploadFileNormal(
       sendDataTransfer(buffer);
 
       if (i == 0) {
-        progressHandler(getBasename(filename), STR_WRITING, file->fptr, file->obj.objsize);
+        progress.report(STR_WRITING, file->fptr, file->obj.objsize);
       }
     }
 
@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include "opentx.h"
+#include "flashing_progress.h"
 #include "multi_firmware_update.h"
 #include "stk500.h"
 #include "debug.h"
@@ -356,8 +357,9 @@ const char* MultiFirmwareUpdateDriver::flashFirmware(
     writeOffset = 0x1000; // start offset (word address)
   }
 
+  FlashingProgress progress(progressHandler, label);
   while (!f_eof(file)) {
-    progressHandler(label, STR_WRITING, file->fptr, file->obj.objsize);
+    progress.report(STR_WRITING, file->fptr, file->obj.objsize);
 
     UINT count = 0;
     memclear(buffer, pageSize);
@@ -385,7 +387,7 @@ const char* MultiFirmwareUpdateDriver::flashFirmware(
   }
 
   if (f_eof(file)) {
-    progressHandler(label, STR_WRITING, file->fptr, file->obj.objsize);
+    progress.report(STR_WRITING, file->fptr, file->obj.objsize);
   }
 
   leaveProgMode();
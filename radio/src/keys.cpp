@@ -77,6 +77,8 @@ class Key
  public:
   event_t input(bool val);
   bool pressed() const { return (m_vals & FILTER_MASK) == FILTER_MASK; }
+  // released for long enough that input(false) changes nothing
+  bool idle() const { return !m_vals && !m_state; }
   void pauseEvents();
   void killEvents();
 };
@@ -159,8 +161,13 @@ event_t Key::input(bool val)
   return evt;
 }
 
+// false while every key is idle(): the polling cycle skips them
+static bool keysActive = false;
+
+// an idle key has no events left to pause or kill
 void Key::pauseEvents()
 {
+  if (idle()) return;
   m_state = KSTATE_PAUSE;
   m_cnt = 0;
 }
@@ -168,6 +175,7 @@ void Key::pauseEvents()
 void Key::killEvents()
 {
   // TRACE("key %d killed", key());
+  if (idle()) return;
   m_state = KSTATE_KILLED;
 }
 
@@ -188,10 +196,27 @@ void pushEvent(event_t evt)
   s_evt = evt;
 }
 
+#if !defined(COLORLCD)
+// rotary detents accumulated since the last rotary event was consumed,
+// and the number of detents carried by the event last returned
+static volatile rotenc_t rotencSteps = 0;
+static uint8_t rotencDelta = 1;
+#endif
+
 event_t getEvent()
 {
   auto event = s_evt;
   s_evt = 0;
+#if !defined(COLORLCD)
+  if (event == EVT_ROTARY_LEFT || event == EVT_ROTARY_RIGHT) {
+    rotenc_t steps = rotencSteps;
+    rotencSteps = 0;
+    if (steps < 0) steps = -steps;
+    rotencDelta = limit<rotenc_t>(1, steps, ROTENC_MAX_STEPS);
+  } else {
+    rotencDelta = 1;
+  }
+#endif
   return event;
 }
 
@@ -330,6 +355,11 @@ bool keysPollingCycle()
   trims_input = readTrims();
 #endif
 
+  // most of the time nothing is pressed: skip the key state machines
+  if (!keys_input && !trims_input && !keysActive) {
+    return false;
+  }
+
   for (int i = 0; i < MAX_KEYS; i++) {
     event_t evt = keys[i].input(keys_input & (1 << i));
     if (evt) {
@@ -346,13 +376,24 @@ bool keysPollingCycle()
     if (evt) pushTrimEvent(evt | i);
   }
 
+  keysActive = false;
+  for (int i = 0; i < MAX_KEYS && !keysActive; i++) {
+    keysActive = !keys[i].idle();
+  }
+  for (int i = 0; i < trim_switches && !keysActive; i++) {
+    keysActive = !trim_keys[i].idle();
+  }
+
   return keys_input || trims_input;
 }
 
 #if !defined(COLORLCD)
 
-#define ROTENC_DELAY_MIDSPEED  32
-#define ROTENC_DELAY_HIGHSPEED 16
+// average time between detents (ms) below which the speed goes up
+#define ROTENC_DELAY_MIDSPEED  40
+#define ROTENC_DELAY_HIGHSPEED 20
+
+extern volatile uint32_t rotencDt;
 
 int8_t rotencSpeed = ROTENC_LOWSPEED;
 
@@ -361,14 +402,23 @@ int8_t rotaryEncoderGetAccel()
   return rotencSpeed;
 }
 
+uint8_t rotaryEncoderGetSteps()
+{
+  return rotencDelta;
+}
+
 void rotaryEncoderResetAccel()
 {
   rotencSpeed = ROTENC_LOWSPEED;
 }
 
+// Detents are not pushed one by one: the menus only run every 50ms and
+// the single event slot would drop them, so they are accumulated here and
+// the pending rotary event carries their count (see getEvent()).
 bool rotaryEncoderPollingCycle()
 {
   static rotenc_t rePreviousValue;
+  static uint32_t lastDt;
   static bool cw = false;
   rotenc_t reNewValue = rotaryEncoderGetValue();
   rotenc_t scrollRE = reNewValue - rePreviousValue;
@@ -376,17 +426,19 @@ bool rotaryEncoderPollingCycle()
     static uint32_t lastEvent;
     rePreviousValue = reNewValue;
 
+    // time elapsed between the encoder edges, as seen by the driver
+    uint32_t dt = rotencDt - lastDt;
+    lastDt = rotencDt;
+
     bool new_cw = (scrollRE < 0) ? false : true;
     if ((g_tmr10ms - lastEvent >= 10) || (cw == new_cw)) {  // 100ms
 
-      pushEvent(new_cw ? EVT_ROTARY_RIGHT : EVT_ROTARY_LEFT);
-
       // rotary encoder navigation speed (acceleration) detection/calculation
       static uint32_t delay = 2 * ROTENC_DELAY_MIDSPEED;
 
       if (new_cw == cw) {
         // Modified moving average filter used for smoother change of speed
-        delay = (((g_tmr10ms - lastEvent) << 3) + delay) >> 1;
+        delay = (dt / (new_cw ? scrollRE : -scrollRE) + delay) >> 1;
       } else {
         delay = 2 * ROTENC_DELAY_MIDSPEED;
       }
@@ -397,6 +449,16 @@ bool rotaryEncoderPollingCycle()
         rotencSpeed = ROTENC_MIDSPEED;
       else
         rotencSpeed = ROTENC_LOWSPEED;
+
+      // keep adding up while the previous event has not been consumed
+      // (steps pending in the other direction are dropped)
+      event_t evt = new_cw ? EVT_ROTARY_RIGHT : EVT_ROTARY_LEFT;
+      if (s_evt == evt)
+        rotencSteps += scrollRE;
+      else
+        rotencSteps = scrollRE;
+      pushEvent(evt);
+
       cw = new_cw;
       lastEvent = g_tmr10ms;
     }
@@ -26,6 +26,11 @@
 #include "switches.h"
 #include "hal/adc_driver.h"
 #include "hal/switch_driver.h"
+#include "tasks/mixer_task.h"
+
+#if defined(LOG_BINARY)
+  #include "logs_binary.h"
+#endif
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -39,8 +44,6 @@ static tmr10ms_t lastLogTime = 0;
 #include <FreeRTOS/include/FreeRTOS.h>
 #include <FreeRTOS/include/timers.h>
 
-#include "tasks/mixer_task.h"
-
 static TimerHandle_t loggingTimer = nullptr;
 static StaticTimer_t loggingTimerBuffer;
 
@@ -100,13 +103,214 @@ void initLoggingTimer() {                                       // called cyclic
 }
 #endif
 
-void writeHeader();
+#if defined(LOG_BINARY)
+static void binaryLogStart();
+static void binaryLogEnd();
+#else
+static void textLogStart();
+static void textLogEnd();
+#endif
+
+uint8_t logProfile;
 
 int getSwitchState(uint8_t swtch) {
   int value = getValue(MIXSRC_FIRST_SWITCH + swtch);
   return (value == 0) ? 0 : (value < 0) ? -1 : +1;
 }
 
+uint32_t getLogicalSwitchesStates(uint8_t first)
+{
+  uint32_t result = 0;
+  for (uint8_t i=0; i<32; i++) {
+    result |= (getSwitch(SWSRC_FIRST_LOGICAL_SWITCH+first+i) << i);
+  }
+  return result;
+}
+
+// The columns of the log, decided when the file is opened, in file order.
+// The time always comes first and is not part of the list.
+enum LogFieldType {
+  LOG_FIELD_SENSOR,
+  LOG_FIELD_STICK,
+  LOG_FIELD_POT,
+  LOG_FIELD_SWITCH,
+  LOG_FIELD_LOGICAL_SWITCHES,
+  LOG_FIELD_CHANNEL,
+  LOG_FIELD_TX_BATTERY,
+};
+
+struct LogField {
+  uint8_t type;
+  uint8_t index;
+};
+
+#define LOG_MAX_FIELDS                                              \
+  (MAX_TELEMETRY_SENSORS + MAX_ANALOG_INPUTS + MAX_SWITCHES + 1 + \
+   MAX_OUTPUT_CHANNELS + 1)
+
+static LogField logFields[LOG_MAX_FIELDS];
+static uint16_t logFieldsCount;
+static uint8_t logFieldsProfile;
+
+// Change needed in FUNC_LOGS_ON_CHANGE mode for a field to trigger a line,
+// in the unit of the field. Sensors and switches trigger on any change.
+static const uint8_t logFieldThresholds[] = {
+  0,   // LOG_FIELD_SENSOR
+  10,  // LOG_FIELD_STICK: 1%
+  10,  // LOG_FIELD_POT
+  0,   // LOG_FIELD_SWITCH
+  0,   // LOG_FIELD_LOGICAL_SWITCHES
+  5,   // LOG_FIELD_CHANNEL: 5us
+  0,   // LOG_FIELD_TX_BATTERY
+};
+
+// a line at least every 10s when nothing changes
+#define LOG_KEEPALIVE_10MS 1000
+
+static int32_t logLastValues[LOG_MAX_FIELDS];
+static uint32_t logLastLogicalSwitches[MAX_LOGICAL_SWITCHES / 32];
+static tmr10ms_t logLastLineTime;
+static bool logFirstLine;
+
+// channel outputs, taken once per line
+static MixerOutputSnapshot logOutputs;
+
+static bool isLoggedSensor(int index)
+{
+  TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  if (!isTelemetryFieldAvailable(index) || !sensor.logs)
+    return false;
+#if defined(LOG_BINARY)
+  // text and date sensors do not fit fixed width records
+  return sensor.unit != UNIT_TEXT && sensor.unit != UNIT_DATETIME;
+#else
+  return true;
+#endif
+}
+
+static void logsAddField(uint8_t type, uint8_t index)
+{
+  logFields[logFieldsCount++] = {type, index};
+}
+
+static void logsInitFields()
+{
+  logFieldsCount = 0;
+  logFieldsProfile = logProfile & ~FUNC_LOGS_ON_CHANGE;
+  logFirstLine = true;
+
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (isLoggedSensor(i))
+      logsAddField(LOG_FIELD_SENSOR, i);
+  }
+
+  if (!(logFieldsProfile & FUNC_LOGS_NO_STICKS)) {
+    for (uint8_t i = 0; i < adcGetMaxInputs(ADC_INPUT_MAIN); i++)
+      logsAddField(LOG_FIELD_STICK, i);
+  }
+
+  if (!(logFieldsProfile & FUNC_LOGS_NO_POTS)) {
+    for (uint8_t i = 0; i < adcGetMaxInputs(ADC_INPUT_POT); i++) {
+      if (IS_POT_AVAILABLE(i))
+        logsAddField(LOG_FIELD_POT, i);
+    }
+  }
+
+  if (!(logFieldsProfile & FUNC_LOGS_NO_SWITCHES)) {
+    for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+      if (SWITCH_EXISTS(i))
+        logsAddField(LOG_FIELD_SWITCH, i);
+    }
+  }
+
+  if (!(logFieldsProfile & FUNC_LOGS_NO_LOGICAL_SWITCHES))
+    logsAddField(LOG_FIELD_LOGICAL_SWITCHES, 0);
+
+  if (!(logFieldsProfile & FUNC_LOGS_NO_CHANNELS)) {
+    for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++)
+      logsAddField(LOG_FIELD_CHANNEL, channel);
+  }
+
+  logsAddField(LOG_FIELD_TX_BATTERY, 0);
+}
+
+// value of the plain number fields
+static int32_t logsGetFieldValue(const LogField & field)
+{
+  switch (field.type) {
+    case LOG_FIELD_SENSOR:
+      return telemetryItems[field.index].value;
+    case LOG_FIELD_STICK:
+      return calibratedAnalogs[inputMappingConvertMode(
+          adcGetInputOffset(ADC_INPUT_MAIN) + field.index)];
+    case LOG_FIELD_POT:
+      return calibratedAnalogs[adcGetInputOffset(ADC_INPUT_POT) + field.index];
+    case LOG_FIELD_SWITCH:
+      return getSwitchState(field.index);
+    case LOG_FIELD_CHANNEL:
+      return PPM_CENTER + logOutputs.channelOutputs[field.index] / 2;  // in us
+    case LOG_FIELD_TX_BATTERY:
+      return g_vbat100mV;
+  }
+  return 0;
+}
+
+// what is compared to decide if a field changed
+static int32_t logsGetWatchValue(const LogField & field)
+{
+  if (field.type == LOG_FIELD_SENSOR) {
+    uint8_t unit = g_model.telemetrySensors[field.index].unit;
+    // these are not numbers, they change with each update
+    if (unit == UNIT_GPS || unit == UNIT_TEXT || unit == UNIT_DATETIME)
+      return telemetryItems[field.index].generation;
+  }
+  return logsGetFieldValue(field);
+}
+
+// true when the line is to be written: always, or in FUNC_LOGS_ON_CHANGE
+// mode when a field moved by more than its threshold since the last line
+static bool logsFieldsChanged()
+{
+  tmr10ms_t now = get_tmr10ms();
+  bool changed = logFirstLine || !(logProfile & FUNC_LOGS_ON_CHANGE) ||
+                 (tmr10ms_t)(now - logLastLineTime) >= LOG_KEEPALIVE_10MS;
+
+  for (uint16_t i = 0; i < logFieldsCount && !changed; i++) {
+    const LogField & field = logFields[i];
+    if (field.type == LOG_FIELD_LOGICAL_SWITCHES) {
+      for (uint8_t j = 0; j < MAX_LOGICAL_SWITCHES / 32; j++) {
+        if (getLogicalSwitchesStates(32 * j) != logLastLogicalSwitches[j])
+          changed = true;
+      }
+      continue;
+    }
+    int32_t delta = logsGetWatchValue(field) - logLastValues[i];
+    int32_t threshold = logFieldThresholds[field.type];
+    if (delta > threshold || delta < -threshold)
+      changed = true;
+  }
+
+  if (!changed)
+    return false;
+
+  if (logProfile & FUNC_LOGS_ON_CHANGE) {
+    for (uint16_t i = 0; i < logFieldsCount; i++) {
+      const LogField & field = logFields[i];
+      if (field.type == LOG_FIELD_LOGICAL_SWITCHES) {
+        for (uint8_t j = 0; j < MAX_LOGICAL_SWITCHES / 32; j++)
+          logLastLogicalSwitches[j] = getLogicalSwitchesStates(32 * j);
+      }
+      else {
+        logLastValues[i] = logsGetWatchValue(field);
+      }
+    }
+  }
+
+  logFirstLine = false;
+  logLastLineTime = now;
+  return true;
+}
+
 void logsInit()
 {
   memset(&g_oLogFile, 0, sizeof(g_oLogFile));
@@ -165,16 +369,25 @@ const char * logsOpen()
   tmp = strAppendDate(tmp, true);
 #endif
 
+#if defined(LOG_BINARY)
+  strcpy(tmp, LOGS_BINARY_EXT);
+#else
   strcpy(tmp, STR_LOGS_EXT);
+#endif
 
   result = f_open(&g_oLogFile, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
-  if (f_size(&g_oLogFile) == 0) {
-    writeHeader();
-  }
+  logsInitFields();
+
+#if defined(LOG_BINARY)
+  // each session gets its own header, the sensors may have changed
+  binaryLogStart();
+#else
+  textLogStart();
+#endif
 
   return nullptr;
 }
@@ -182,6 +395,11 @@ const char * logsOpen()
 void logsClose()
 {
   if (g_oLogFile.obj.fs && sdMounted()) {
+#if defined(LOG_BINARY)
+    binaryLogEnd();
+#else
+    textLogEnd();
+#endif
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
@@ -191,77 +409,463 @@ void logsClose()
 
 }
 
-void writeHeader()
+#if defined(LOG_BINARY)
+#define BLOG_MAX_FIELDS                                            \
+  (1 + 2 * MAX_TELEMETRY_SENSORS + MAX_ANALOG_INPUTS + MAX_SWITCHES + \
+   MAX_LOGICAL_SWITCHES / 16 + MAX_OUTPUT_CHANNELS + 1)
+
+// Records are assembled in one sector and written to the card
+// in whole sectors, so that file offsets stay sector aligned
+static uint8_t binaryLogBuffer[BLOG_SECTOR_SIZE] __DMA;
+static uint16_t binaryLogBufferPos;
+static bool binaryLogError;
+
+static uint16_t binaryLogFieldsCount;
+static uint8_t binaryLogTypes[BLOG_MAX_FIELDS];
+static int32_t binaryLogValues[BLOG_MAX_FIELDS];
+static uint8_t binaryLogDeltas;
+
+static uint32_t binaryLogStartTime;
+static tmr10ms_t binaryLogStartTicks;
+
+static void binaryLogFlush()
+{
+  UINT written;
+  if (f_write(&g_oLogFile, binaryLogBuffer, BLOG_SECTOR_SIZE, &written) != FR_OK ||
+      written != BLOG_SECTOR_SIZE) {
+    binaryLogError = true;
+  }
+  binaryLogBufferPos = 0;
+}
+
+static void binaryLogPut(const void * data, uint16_t len)
+{
+  auto p = (const uint8_t *)data;
+  while (len--) {
+    binaryLogBuffer[binaryLogBufferPos++] = *p++;
+    if (binaryLogBufferPos == BLOG_SECTOR_SIZE) {
+      binaryLogFlush();
+    }
+  }
+}
+
+// zero fill up to the next sector boundary
+static void binaryLogPad()
+{
+  if (binaryLogBufferPos > 0) {
+    memclear(&binaryLogBuffer[binaryLogBufferPos],
+             BLOG_SECTOR_SIZE - binaryLogBufferPos);
+    binaryLogFlush();
+  }
+}
+
+static void binaryLogPutField(uint8_t type, uint8_t prec, const char * name)
+{
+  binaryLogTypes[binaryLogFieldsCount++] = type;
+  binaryLogPut(&type, 1);
+  binaryLogPut(&prec, 1);
+  binaryLogPut(name, strlen(name) + 1);
+}
+
+static uint16_t binaryLogCountFields()
+{
+  uint16_t count = 1;
+  for (uint16_t i = 0; i < logFieldsCount; i++) {
+    const LogField & field = logFields[i];
+    if (field.type == LOG_FIELD_LOGICAL_SWITCHES)
+      count += MAX_LOGICAL_SWITCHES / 16;
+    else if (field.type == LOG_FIELD_SENSOR &&
+             g_model.telemetrySensors[field.index].unit == UNIT_GPS)
+      count += 2;
+    else
+      count += 1;
+  }
+  return count;
+}
+
+static void binaryLogStart()
 {
+  binaryLogBufferPos = 0;
+  binaryLogError = false;
+  binaryLogFieldsCount = 0;
+  binaryLogDeltas = BLOG_KEYFRAME_INTERVAL;
+
+  // align on a sector in case the file was truncated
+  uint32_t misalignment = f_size(&g_oLogFile) % BLOG_SECTOR_SIZE;
+  if (misalignment) {
+    UINT written;
+    memclear(binaryLogBuffer, sizeof(binaryLogBuffer));
+    f_write(&g_oLogFile, binaryLogBuffer, BLOG_SECTOR_SIZE - misalignment,
+            &written);
+  }
+
+  uint16_t count = binaryLogCountFields();
+  binaryLogStartTicks = get_tmr10ms();
 #if defined(RTCLOCK)
-  f_puts("Date,Time,", &g_oLogFile);
+  binaryLogStartTime = g_rtcTime;
 #else
-  f_puts("Time,", &g_oLogFile);
+  binaryLogStartTime = 0;
 #endif
 
-
-  char label[TELEM_LABEL_LEN+7];
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    if (isTelemetryFieldAvailable(i)) {
-      TelemetrySensor & sensor = g_model.telemetrySensors[i];
-      if (sensor.logs) {
-        memset(label, 0, sizeof(label));
+  uint8_t header[BLOG_HEADER_SIZE];
+  memcpy(header, BLOG_MAGIC, 4);
+  header[4] = BLOG_VERSION;
+  header[5] = 0;
+  memcpy(&header[6], &count, sizeof(count));
+  memcpy(&header[8], &binaryLogStartTime, sizeof(binaryLogStartTime));
+  binaryLogPut(header, sizeof(header));
+
+  binaryLogPutField(BLOG_FIELD_TIME, 0, "Time");
+
+  for (uint16_t i = 0; i < logFieldsCount; i++) {
+    const LogField & field = logFields[i];
+    switch (field.type) {
+      case LOG_FIELD_SENSOR: {
+        TelemetrySensor & sensor = g_model.telemetrySensors[field.index];
+        char label[TELEM_LABEL_LEN + 7];
+        memclear(label, sizeof(label));
         strncpy(label, sensor.label, TELEM_LABEL_LEN);
+        if (sensor.unit == UNIT_GPS) {
+          binaryLogPutField(BLOG_FIELD_GPS_LAT, 6, label);
+          binaryLogPutField(BLOG_FIELD_GPS_LON, 6, label);
+          break;
+        }
         uint8_t unit = sensor.unit;
-        if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
+        if (unit == UNIT_CELLS) unit = UNIT_VOLTS;
         if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
           strcat(label, "(");
           strncat(label, STR_VTELEMUNIT[unit], 3);
           strcat(label, ")");
         }
-        strcat(label, ",");
-        f_puts(label, &g_oLogFile);
+        binaryLogPutField(BLOG_FIELD_VALUE, sensor.prec, label);
+        break;
+      }
+
+      case LOG_FIELD_STICK:
+        binaryLogPutField(BLOG_FIELD_VALUE, 0,
+                          analogGetCanonicalName(ADC_INPUT_MAIN, field.index));
+        break;
+
+      case LOG_FIELD_POT:
+        binaryLogPutField(BLOG_FIELD_VALUE, 0,
+                          analogGetCanonicalName(ADC_INPUT_POT, field.index));
+        break;
+
+      case LOG_FIELD_SWITCH: {
+        char s[LEN_SWITCH_NAME + 2];
+        *getSwitchName(s, field.index) = '\0';
+        binaryLogPutField(BLOG_FIELD_VALUE, 0, s);
+        break;
+      }
+
+      case LOG_FIELD_LOGICAL_SWITCHES:
+        for (uint8_t j = 0; j < MAX_LOGICAL_SWITCHES / 16; j++) {
+          binaryLogPutField(BLOG_FIELD_BITS, 0, "LSW");
+        }
+        break;
+
+      case LOG_FIELD_CHANNEL: {
+        char s[sizeof("CH00(us)")];
+        strcpy(strAppendUnsigned(strAppend(s, "CH"), field.index + 1), "(us)");
+        binaryLogPutField(BLOG_FIELD_VALUE, 0, s);
+        break;
+      }
+
+      case LOG_FIELD_TX_BATTERY:
+        binaryLogPutField(BLOG_FIELD_VALUE, 1, "TxBat(V)");
+        break;
+    }
+  }
+
+  binaryLogPad();
+}
+
+static void binaryLogEnd()
+{
+  binaryLogPad();
+}
+
+static void binaryLogWriteRecord()
+{
+  // static: the timer task stack is small
+  static int32_t values[BLOG_MAX_FIELDS];
+  static int16_t deltas[BLOG_MAX_FIELDS];
+  uint16_t n = 0;
+
+#if defined(RTCLOCK)
+  values[n++] = (g_rtcTime - binaryLogStartTime) * 100 + g_ms100 * 10;
+#else
+  values[n++] = (tmr10ms_t)(get_tmr10ms() - binaryLogStartTicks);
+#endif
+
+  for (uint16_t i = 0; i < logFieldsCount; i++) {
+    const LogField & field = logFields[i];
+    if (field.type == LOG_FIELD_LOGICAL_SWITCHES) {
+      for (uint8_t j = 0; j < MAX_LOGICAL_SWITCHES / 32; j++) {
+        uint32_t states = getLogicalSwitchesStates(32 * j);
+        values[n++] = states & 0xFFFF;
+        values[n++] = states >> 16;
       }
     }
+    else if (field.type == LOG_FIELD_SENSOR &&
+             g_model.telemetrySensors[field.index].unit == UNIT_GPS) {
+      TelemetryItem & telemetryItem = telemetryItems[field.index];
+      values[n++] = telemetryItem.gps.latitude;
+      values[n++] = telemetryItem.gps.longitude;
+    }
+    else {
+      values[n++] = logsGetFieldValue(field);
+    }
   }
 
-  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
-  for (uint8_t i = 0; i < n_inputs; i++) {
-    const char* p = analogGetCanonicalName(ADC_INPUT_MAIN, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+  // a delta record if all differences fit, a keyframe otherwise
+  bool keyframe = (binaryLogDeltas >= BLOG_KEYFRAME_INTERVAL);
+  for (uint16_t i = 0; i < n && !keyframe; i++) {
+    int32_t delta;
+    if (binaryLogTypes[i] == BLOG_FIELD_BITS)
+      delta = (int16_t)(values[i] ^ binaryLogValues[i]);
+    else
+      delta = values[i] - binaryLogValues[i];
+    if (delta < INT16_MIN || delta > INT16_MAX)
+      keyframe = true;
+    deltas[i] = delta;
   }
 
-  n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
-  for (uint8_t i = 0; i < n_inputs; i++) {
-    if (!IS_POT_AVAILABLE(i)) continue;
-    const char* p = analogGetCanonicalName(ADC_INPUT_POT, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+  uint8_t tag;
+  if (keyframe) {
+    tag = BLOG_RECORD_KEYFRAME;
+    binaryLogPut(&tag, 1);
+    binaryLogPut(values, n * sizeof(int32_t));
+    binaryLogDeltas = 0;
+  }
+  else {
+    tag = BLOG_RECORD_DELTA;
+    binaryLogPut(&tag, 1);
+    binaryLogPut(deltas, n * sizeof(int16_t));
+    binaryLogDeltas++;
   }
+  memcpy(binaryLogValues, values, n * sizeof(int32_t));
+}
+#else
+#define TEXT_LOG_BUFFER_SIZE 512
+
+// Lines are formatted with integer to text routines into a sector
+// sized buffer, which is written to the card when full
+static char textLogBuffer[TEXT_LOG_BUFFER_SIZE] __DMA;
+static uint16_t textLogBufferPos;
+static uint16_t textLogBufferEnd;
+static bool textLogError;
 
-  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
-    if (SWITCH_EXISTS(i)) {
-      char s[LEN_SWITCH_NAME + 2];
-      char * temp;
-      temp = getSwitchName(s, i);
-      *temp++ = ',';
-      *temp = '\0';
-      f_puts(s, &g_oLogFile);
+static void textLogFlush()
+{
+  if (textLogBufferPos > 0) {
+    UINT written;
+    if (f_write(&g_oLogFile, textLogBuffer, textLogBufferPos, &written) != FR_OK ||
+        written != textLogBufferPos) {
+      textLogError = true;
     }
+    textLogBufferPos = 0;
   }
-  f_puts("LSW,", &g_oLogFile);
-  
-  for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-    f_printf(&g_oLogFile, "CH%d(us),", channel+1);
+  textLogBufferEnd = TEXT_LOG_BUFFER_SIZE;
+}
+
+static void textLogPut(const char * s, const char * end)
+{
+  while (s < end) {
+    textLogBuffer[textLogBufferPos++] = *s++;
+    if (textLogBufferPos == textLogBufferEnd) {
+      textLogFlush();
+    }
   }
+}
 
-  f_puts("TxBat(V)\n", &g_oLogFile);
+static void textLogPuts(const char * s)
+{
+  textLogPut(s, s + strlen(s));
 }
 
-uint32_t getLogicalSwitchesStates(uint8_t first)
+// value with 'prec' decimals
+static char * textLogAppendNumber(char * s, int32_t value, uint8_t prec)
 {
-  uint32_t result = 0;
-  for (uint8_t i=0; i<32; i++) {
-    result |= (getSwitch(SWSRC_FIRST_LOGICAL_SWITCH+first+i) << i);
+  uint32_t absValue = value < 0 ? -(uint32_t)value : value;
+  uint32_t divisor = 1;
+  for (uint8_t i = 0; i < prec; i++) {
+    divisor *= 10;
+  }
+  if (value < 0) {
+    *s++ = '-';
+  }
+  s = strAppendUnsigned(s, absValue / divisor);
+  if (prec) {
+    *s++ = '.';
+    s = strAppendUnsigned(s, absValue % divisor, prec);
+  }
+  return s;
+}
+
+static void textLogWriteHeader()
+{
+#if defined(RTCLOCK)
+  textLogPuts("Date,Time,");
+#else
+  textLogPuts("Time,");
+#endif
+
+  for (uint16_t i = 0; i < logFieldsCount; i++) {
+    const LogField & field = logFields[i];
+    char s[32];
+    char * p = s;
+    switch (field.type) {
+      case LOG_FIELD_SENSOR: {
+        TelemetrySensor & sensor = g_model.telemetrySensors[field.index];
+        p = strAppend(p, sensor.label, TELEM_LABEL_LEN);
+        uint8_t unit = sensor.unit;
+        if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
+        if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
+          *p++ = '(';
+          p = strAppend(p, STR_VTELEMUNIT[unit], 3);
+          *p++ = ')';
+        }
+        break;
+      }
+
+      case LOG_FIELD_STICK:
+        textLogPuts(analogGetCanonicalName(ADC_INPUT_MAIN, field.index));
+        break;
+
+      case LOG_FIELD_POT:
+        textLogPuts(analogGetCanonicalName(ADC_INPUT_POT, field.index));
+        break;
+
+      case LOG_FIELD_SWITCH:
+        p = getSwitchName(p, field.index);
+        break;
+
+      case LOG_FIELD_LOGICAL_SWITCHES:
+        p = strAppend(p, "LSW");
+        break;
+
+      case LOG_FIELD_CHANNEL:
+        p = strAppend(strAppendUnsigned(strAppend(p, "CH"), field.index + 1), "(us)");
+        break;
+
+      case LOG_FIELD_TX_BATTERY:
+        p = strAppend(p, "TxBat(V)");
+        break;
+    }
+    *p++ = (field.type == LOG_FIELD_TX_BATTERY ? '\n' : ',');
+    textLogPut(s, p);
+  }
+}
+
+static void textLogStart()
+{
+  textLogBufferPos = 0;
+  textLogError = false;
+
+  // the first write completes the last sector of the file, the next ones
+  // are whole sectors
+  uint32_t size = f_size(&g_oLogFile);
+  textLogBufferEnd = TEXT_LOG_BUFFER_SIZE - size % TEXT_LOG_BUFFER_SIZE;
+
+  if (size == 0) {
+    textLogWriteHeader();
+  }
+}
+
+static void textLogEnd()
+{
+  textLogFlush();
+}
+
+static void textLogWriteLine()
+{
+  // large enough for a GPS position or a text sensor
+  char s[32];
+  char * p = s;
+
+#if defined(RTCLOCK)
+  static struct gtm utm;
+  static gtime_t lastRtcTime = 0;
+  if (g_rtcTime != lastRtcTime) {
+    lastRtcTime = g_rtcTime;
+    gettime(&utm);
+  }
+  p = strAppendUnsigned(p, utm.tm_year + TM_YEAR_BASE, 4);
+  *p++ = '-';
+  p = strAppendUnsigned(p, utm.tm_mon + 1, 2);
+  *p++ = '-';
+  p = strAppendUnsigned(p, utm.tm_mday, 2);
+  *p++ = ',';
+  p = strAppendUnsigned(p, utm.tm_hour, 2);
+  *p++ = ':';
+  p = strAppendUnsigned(p, utm.tm_min, 2);
+  *p++ = ':';
+  p = strAppendUnsigned(p, utm.tm_sec, 2);
+  *p++ = '.';
+  p = strAppendUnsigned(p, g_ms100, 2);
+  *p++ = '0';
+#else
+  p = strAppendUnsigned(p, lastLogTime);
+#endif
+  *p++ = ',';
+  textLogPut(s, p);
+
+  for (uint16_t i = 0; i < logFieldsCount; i++) {
+    const LogField & field = logFields[i];
+    p = s;
+    if (field.type == LOG_FIELD_SENSOR) {
+      TelemetrySensor & sensor = g_model.telemetrySensors[field.index];
+      TelemetryItem & telemetryItem = telemetryItems[field.index];
+      if (sensor.unit == UNIT_GPS) {
+        if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
+          p = textLogAppendNumber(p, telemetryItem.gps.latitude, 6);
+          *p++ = ' ';
+          p = textLogAppendNumber(p, telemetryItem.gps.longitude, 6);
+        }
+      }
+      else if (sensor.unit == UNIT_DATETIME) {
+        p = strAppendUnsigned(p, telemetryItem.datetime.year, 4);
+        *p++ = '-';
+        p = strAppendUnsigned(p, telemetryItem.datetime.month, 2);
+        *p++ = '-';
+        p = strAppendUnsigned(p, telemetryItem.datetime.day, 2);
+        *p++ = ' ';
+        p = strAppendUnsigned(p, telemetryItem.datetime.hour, 2);
+        *p++ = ':';
+        p = strAppendUnsigned(p, telemetryItem.datetime.min, 2);
+        *p++ = ':';
+        p = strAppendUnsigned(p, telemetryItem.datetime.sec, 2);
+      }
+      else if (sensor.unit == UNIT_TEXT) {
+        *p++ = '"';
+        p = strAppend(p, telemetryItem.text, sizeof(telemetryItem.text));
+        *p++ = '"';
+      }
+      else {
+        p = textLogAppendNumber(p, telemetryItem.value, sensor.prec <= 2 ? sensor.prec : 0);
+      }
+    }
+    else if (field.type == LOG_FIELD_LOGICAL_SWITCHES) {
+      uint32_t high = getLogicalSwitchesStates(32);
+      uint32_t low = getLogicalSwitchesStates(0);
+      p = strAppend(p, "0x");
+      p = strAppendUnsigned(p, high >> 16, 4, 16);
+      p = strAppendUnsigned(p, high & 0xFFFF, 4, 16);
+      p = strAppendUnsigned(p, low >> 16, 4, 16);
+      p = strAppendUnsigned(p, low & 0xFFFF, 4, 16);
+    }
+    else if (field.type == LOG_FIELD_TX_BATTERY) {
+      p = textLogAppendNumber(p, logsGetFieldValue(field), 1);
+    }
+    else {
+      p = textLogAppendNumber(p, logsGetFieldValue(field), 0);
+    }
+    *p++ = (field.type == LOG_FIELD_TX_BATTERY ? '\n' : ',');
+    textLogPut(s, p);
   }
-  return result;
 }
+#endif
 
 void logsWrite()
 {
@@ -282,6 +886,11 @@ void logsWrite()
 
       bool sdCardFull = sdIsFull();
 
+      // the columns follow the profile, a new one needs a new header
+      if (g_oLogFile.obj.fs && logFieldsProfile != (logProfile & ~FUNC_LOGS_ON_CHANGE)) {
+        logsClose();
+      }
+
       // check if file needs to be opened
       if (!g_oLogFile.obj.fs) {
         const char *result = sdCardFull ? STR_SDCARD_FULL_EXT : logsOpen();
@@ -304,92 +913,19 @@ void logsWrite()
         return;
       }
 
-
-#if defined(RTCLOCK)
-      {
-        static struct gtm utm;
-        static gtime_t lastRtcTime = 0;
-        if (g_rtcTime != lastRtcTime) {
-          lastRtcTime = g_rtcTime;
-          gettime(&utm);
-        }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+      mixerGetOutputSnapshot(&logOutputs);
+      if (!logsFieldsChanged()) {
+        return;
       }
+
+#if defined(LOG_BINARY)
+      binaryLogWriteRecord();
+      int result = binaryLogError ? -1 : 0;
 #else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
+      textLogWriteLine();
+      int result = textLogError ? -1 : 0;
 #endif
 
-      for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-        if (isTelemetryFieldAvailable(i)) {
-          TelemetrySensor & sensor = g_model.telemetrySensors[i];
-          TelemetryItem & telemetryItem = telemetryItems[i];
-          if (sensor.logs) {
-            if (sensor.unit == UNIT_GPS) {
-              if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
-                div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
-                qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
-              }
-              else {
-                f_printf(&g_oLogFile, ",");
-              }
-            }
-            else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
-            }
-            else if (sensor.unit == UNIT_TEXT) {
-              f_printf(&g_oLogFile, "\"%s\",", telemetryItem.text);
-            }
-            else if (sensor.prec == 2) {
-              div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
-            }
-            else if (sensor.prec == 1) {
-              div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
-            }
-            else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
-            }
-          }
-        }
-      }
-
-      auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
-      auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
-
-      for (uint8_t i = 0; i < n_inputs; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
-      }
-
-      n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
-      offset = adcGetInputOffset(ADC_INPUT_POT);
-
-      for (uint8_t i = 0; i < n_inputs; i++) {
-        if (IS_POT_AVAILABLE(i))
-          f_printf(&g_oLogFile, "%d,", calibratedAnalogs[offset + i]);
-      }
-
-      for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
-        if (SWITCH_EXISTS(i)) {
-          f_printf(&g_oLogFile, "%d,", getSwitchState(i));
-        }
-      }
-      f_printf(&g_oLogFile, "0x%08X%08X,", getLogicalSwitchesStates(32),
-               getLogicalSwitchesStates(0));
-
-      for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-        f_printf(&g_oLogFile, "%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
-      }
-
-      div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
-
       if (result<0 && !error_displayed) {
         error_displayed = STR_SDCARD_ERROR;
         POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
@@ -400,7 +936,7 @@ void logsWrite()
   else {
     error_displayed = nullptr;
     logsClose();
-    
+
     #if !defined(SIMU)
     loggingTimerStop();
     #endif
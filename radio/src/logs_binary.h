@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Binary flight log format (all values little endian)
+//
+// A file is a sequence of segments, one per logging session. Each segment
+// starts on a sector boundary with a header:
+//
+//   char     magic[4]     BLOG_MAGIC
+//   uint8_t  version      BLOG_VERSION
+//   uint8_t  reserved
+//   uint16_t fieldCount
+//   uint32_t startTime    RTC time of the segment start (s since 1970), or 0
+//   fieldCount x { uint8_t type, uint8_t prec, char name[] (zero terminated) }
+//   zero padding up to the next sector boundary
+//
+// followed by records:
+//
+//   BLOG_RECORD_KEYFRAME  fieldCount x int32_t: values
+//   BLOG_RECORD_DELTA     fieldCount x int16_t: difference to the previous
+//                         record (changed bits for BLOG_FIELD_BITS)
+//   0                     end of segment: skip to the next sector boundary
+//
+// Field 0 is the record time, in 10ms since startTime. Field names are the
+// column names of the CSV logs.
+
+#define BLOG_MAGIC             "ETXB"
+#define BLOG_VERSION           1
+#define BLOG_SECTOR_SIZE       512
+#define BLOG_HEADER_SIZE       12
+
+#define BLOG_RECORD_KEYFRAME   'K'
+#define BLOG_RECORD_DELTA      'D'
+
+// max number of delta records between two keyframes
+#define BLOG_KEYFRAME_INTERVAL 64
+
+enum BinaryLogFieldType {
+  BLOG_FIELD_TIME,
+  BLOG_FIELD_VALUE,    // value with 'prec' decimals
+  BLOG_FIELD_GPS_LAT,  // in 1/1000000 degree, followed by BLOG_FIELD_GPS_LON
+  BLOG_FIELD_GPS_LON,
+  BLOG_FIELD_BITS,     // 16 logical switches, lowest first
+};
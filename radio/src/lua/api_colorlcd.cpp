@@ -1400,6 +1400,142 @@ static int luaLcdDrawHudRectangle(lua_State *L)
   return 0;
 }
 
+/*luadoc
+@function lcd.drawList(list [, x, y])
+
+Draw many primitives in one call
+
+@param list (table) flat array of integers, each primitive is its DRAW_xxx
+code followed by its arguments:
+ * DRAW_COLOR flags (applies to the following primitives)
+ * DRAW_POINT x y
+ * DRAW_LINE x1 y1 x2 y2
+ * DRAW_RECT x y w h
+ * DRAW_FILLED_RECT x y w h
+ * DRAW_CIRCLE x y r
+ * DRAW_FILLED_CIRCLE x y r
+ * DRAW_TRIANGLE x1 y1 x2 y2 x3 y3
+ * DRAW_FILLED_TRIANGLE x1 y1 x2 y2 x3 y3
+
+@param x,y (optional numbers) offset added to all coordinates
+
+@retval count (number) of primitives drawn, the list is processed until the
+first unknown code
+
+@notice Primitives entirely outside of the drawing area are skipped. The list
+can be built once and reused as long as the shapes do not change.
+
+@status current Introduced in 2.9.0
+*/
+static int luaLcdDrawList(lua_State *L)
+{
+  static const uint8_t opArgs[DRAW_OP_COUNT] = {0, 1, 2, 4, 4, 4, 3, 3, 6, 6};
+
+  if (!luaLcdAllowed || !luaLcdBuffer)
+    return 0;
+
+  luaL_checktype(L, 1, LUA_TTABLE);
+  coord_t dx = luaL_optinteger(L, 2, 0);
+  coord_t dy = luaL_optinteger(L, 3, 0);
+  int len = lua_rawlen(L, 1);
+
+  coord_t ox = luaLcdBuffer->getOffsetX();
+  coord_t oy = luaLcdBuffer->getOffsetY();
+  dx += ox;
+  dy += oy;
+  luaLcdBuffer->setOffset(dx, dy);
+
+  // drawing area in list coordinates, the same for the whole list
+  coord_t xmin, xmax, ymin, ymax;
+  luaLcdBuffer->getClippingRect(xmin, xmax, ymin, ymax);
+  xmin -= dx; xmax -= dx;
+  ymin -= dy; ymax -= dy;
+
+  LcdFlags flags = flagsRGB(0);
+  int count = 0;
+  int a[6];
+
+  for (int i = 1; i <= len; ) {
+    lua_rawgeti(L, 1, i++);
+    unsigned op = lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    if (op == 0 || op >= DRAW_OP_COUNT || i + opArgs[op] > len + 1)
+      break;
+
+    for (uint8_t n = 0; n < opArgs[op]; n++) {
+      lua_rawgeti(L, 1, i++);
+      a[n] = lua_tointeger(L, -1);
+      lua_pop(L, 1);
+    }
+
+    // bounding box, to skip what is out of the drawing area
+    int bx1, by1, bx2, by2;
+    switch (op) {
+      case DRAW_OP_COLOR:
+        flags = flagsRGB(a[0]);
+        continue;
+      case DRAW_OP_RECT:
+      case DRAW_OP_FILLED_RECT:
+        bx1 = a[0]; by1 = a[1];
+        bx2 = a[0] + a[2]; by2 = a[1] + a[3];
+        break;
+      case DRAW_OP_CIRCLE:
+      case DRAW_OP_FILLED_CIRCLE:
+        bx1 = a[0] - a[2]; by1 = a[1] - a[2];
+        bx2 = a[0] + a[2]; by2 = a[1] + a[2];
+        break;
+      default:
+        bx1 = bx2 = a[0]; by1 = by2 = a[1];
+        for (uint8_t n = 2; n < opArgs[op]; n += 2) {
+          bx1 = min(bx1, a[n]); bx2 = max(bx2, a[n]);
+          by1 = min(by1, a[n + 1]); by2 = max(by2, a[n + 1]);
+        }
+        break;
+    }
+    if (bx2 < xmin || bx1 >= xmax || by2 < ymin || by1 >= ymax)
+      continue;
+
+    switch (op) {
+      case DRAW_OP_POINT:
+        luaLcdBuffer->drawPixel(a[0], a[1], COLOR_VAL(flags));
+        break;
+      case DRAW_OP_LINE:
+        if (a[0] == a[2])
+          luaLcdBuffer->drawSolidVerticalLine(a[0], min(a[1], a[3]), abs(a[3] - a[1]) + 1, flags);
+        else if (a[1] == a[3])
+          luaLcdBuffer->drawSolidHorizontalLine(min(a[0], a[2]), a[1], abs(a[2] - a[0]) + 1, flags);
+        else
+          luaLcdBuffer->drawLine(a[0], a[1], a[2], a[3], SOLID, flags);
+        break;
+      case DRAW_OP_RECT:
+        luaLcdBuffer->drawRect(a[0], a[1], a[2], a[3], 1, SOLID, flags);
+        break;
+      case DRAW_OP_FILLED_RECT:
+        luaLcdBuffer->drawSolidFilledRect(a[0], a[1], a[2], a[3], flags);
+        break;
+      case DRAW_OP_CIRCLE:
+        luaLcdBuffer->drawCircle(a[0], a[1], a[2], flags);
+        break;
+      case DRAW_OP_FILLED_CIRCLE:
+        luaLcdBuffer->drawFilledCircle(a[0], a[1], a[2], flags);
+        break;
+      case DRAW_OP_TRIANGLE:
+        luaLcdBuffer->drawLine(a[0], a[1], a[2], a[3], SOLID, flags);
+        luaLcdBuffer->drawLine(a[2], a[3], a[4], a[5], SOLID, flags);
+        luaLcdBuffer->drawLine(a[4], a[5], a[0], a[1], SOLID, flags);
+        break;
+      case DRAW_OP_FILLED_TRIANGLE:
+        luaLcdBuffer->drawFilledTriangle(a[0], a[1], a[2], a[3], a[4], a[5], flags);
+        break;
+    }
+    count++;
+  }
+
+  luaLcdBuffer->setOffset(ox, oy);
+  lua_pushinteger(L, count);
+  return 1;
+}
+
 /*luadoc
 @function lcd.exitFullScreen()
 
@@ -1452,6 +1588,7 @@ LROT_BEGIN(lcdlib, NULL, 0)
   LROT_FUNCENTRY( drawAnnulus, luaLcdDrawAnnulus )
   LROT_FUNCENTRY( drawLineWithClipping, luaLcdDrawLineWithClipping )
   LROT_FUNCENTRY( drawHudRectangle, luaLcdDrawHudRectangle )
+  LROT_FUNCENTRY( drawList, luaLcdDrawList )
   LROT_FUNCENTRY( exitFullScreen, luaLcdExitFullScreen )
 LROT_END(lcdlib, NULL, 0)
 
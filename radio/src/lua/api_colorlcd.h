@@ -22,3 +22,17 @@
 #include "definitions.h"
 
 EXTERN_C(LUALIB_API int luaopen_bitmap(lua_State * L));
+
+// Primitives of lcd.drawList(), each followed by its integer arguments
+enum LuaDrawOp {
+  DRAW_OP_COLOR = 1,        // flags
+  DRAW_OP_POINT,            // x, y
+  DRAW_OP_LINE,             // x1, y1, x2, y2
+  DRAW_OP_RECT,             // x, y, w, h
+  DRAW_OP_FILLED_RECT,      // x, y, w, h
+  DRAW_OP_CIRCLE,           // x, y, r
+  DRAW_OP_FILLED_CIRCLE,    // x, y, r
+  DRAW_OP_TRIANGLE,         // x1, y1, x2, y2, x3, y3
+  DRAW_OP_FILLED_TRIANGLE,  // x1, y1, x2, y2, x3, y3
+  DRAW_OP_COUNT
+};
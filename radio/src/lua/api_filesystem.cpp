@@ -45,17 +45,27 @@ static int dir_iter(lua_State* L)
   }
  
   lua_pushstring(L, info.fname);
-  return 1;
+  if (!lua_toboolean(L, lua_upvalueindex(2))) {
+    return 1;
+  }
+
+  // saves an fstat() per entry
+  lua_pushunsigned(L, info.fattrib);
+  lua_pushunsigned(L, info.fsize);
+  return 3;
 }
 
 /*luadoc
-@function dir(directory)
+@function dir(directory [, info])
 
  Return an iterator listing all the files and directories name in a directory
 
 @param directory (string) Working directory
 
-@status current Introduced in 2.5.0
+@param info (boolean) optional, when true the iterator also returns the
+attribute flags (number, see `fstat`) and the size (number) of each entry
+
+@status current Introduced in 2.5.0, info added in 2.10.0
 
 ### Example
 
@@ -63,11 +73,18 @@ static int dir_iter(lua_State* L)
   for fname in dir(".") do
     print(fname)
   end
+
+  for fname, attrib, size in dir("/LOGS", true) do
+    if attrib ~= AM_DIR then
+      print(fname, size)
+    end
+  end
 ```
 */
 int luaDir(lua_State* L)
 {
   const char* path = luaL_optstring(L, 1, nullptr);
+  bool info = lua_toboolean(L, 2);
   DIR* dir = (DIR*)lua_newuserdata(L, sizeof(DIR));
 
   luaL_getmetatable(L, DIR_METATABLE);
@@ -78,7 +95,8 @@ int luaDir(lua_State* L)
     printf("luaDir cannot open %s\n", path);
   }
   
-  lua_pushcclosure(L, dir_iter, 1);
+  lua_pushboolean(L, info);
+  lua_pushcclosure(L, dir_iter, 2);
   return 1;
 }
 
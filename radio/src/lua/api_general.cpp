@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include "opentx.h"
 #include "stamp.h"
+#include "module_timing.h"
 #include "lua_api.h"
 #include "api_filesystem.h"
 #include "hal/module_port.h"
@@ -32,6 +33,7 @@
 #include "hal/rotary_encoder.h"
 #include "switches.h"
 #include "input_mapping.h"
+#include "tasks/mixer_task.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -40,6 +42,7 @@
 #endif
 
 #include "telemetry/frsky.h"
+#include "telemetry/link_history.h"
 
 #if defined(MULTIMODULE)
   #include "telemetry/multi.h"
@@ -79,19 +82,32 @@ static int luaRxFifoGetByte(void*, uint8_t* data)
   return luaRxFifo->pop(*data);
 }
 
+static uint32_t luaRxFifoGetSpan(void*, const uint8_t** data)
+{
+  if (!luaRxFifo) return 0;
+  return luaRxFifo->span(data);
+}
+
+static void luaRxFifoConsume(void*, uint32_t len)
+{
+  if (luaRxFifo) luaRxFifo->skip(len);
+}
+
 void luaAllocRxFifo()
 {
   if (!luaRxFifo) {
     auto fifo = new Fifo<uint8_t, LUA_FIFO_SIZE>();
     luaRxFifo = fifo;
-    luaSetGetSerialByte(nullptr, luaRxFifoGetByte);
   }
+  luaSetGetSerialByte(nullptr, luaRxFifoGetByte);
+  luaSetSerialRxSpan(nullptr, luaRxFifoGetSpan, luaRxFifoConsume);
 }
 
 void luaFreeRxFifo()
 {
   auto fifo = luaRxFifo;
   luaSetGetSerialByte(nullptr, nullptr);
+  luaSetSerialRxSpan(nullptr, nullptr, nullptr);
   luaRxFifo = nullptr;
   delete(fifo);
 }
@@ -123,6 +139,20 @@ void luaSetGetSerialByte(void* ctx, int (*fct)(void*, uint8_t*))
   luaGetSerialByte = fct;
 }
 
+// Bulk access to the receive buffer, preferred over luaGetSerialByte
+static uint32_t (*luaGetSerialRxSpan)(void*, const uint8_t**) = nullptr;
+static void (*luaConsumeSerialRx)(void*, uint32_t) = nullptr;
+static void* luaSerialRxSpanCtx = nullptr;
+
+void luaSetSerialRxSpan(void* ctx, uint32_t (*getRxSpan)(void*, const uint8_t**),
+                        void (*consumeRx)(void*, uint32_t))
+{
+  luaGetSerialRxSpan = nullptr;
+  luaConsumeSerialRx = consumeRx;
+  luaSerialRxSpanCtx = ctx;
+  luaGetSerialRxSpan = getRxSpan;
+}
+
 /*luadoc
 @function getVersion()
 
@@ -541,6 +571,50 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
   return false;  // not found
 }
 
+// Name to source id cache for getValue() / getSourceValue(), which widgets
+// and telemetry scripts call with the same names on every refresh. Sensors
+// can only appear or be renamed through storageDirty(EE_MODEL), and a model
+// load bumps the revision as well, so entries are dropped on any change.
+#define LUA_SOURCE_CACHE_SIZE  32
+
+struct LuaSourceCacheEntry {
+  uint16_t modelRevision;
+  uint16_t generalRevision;
+  uint16_t id;  // MIXSRC_NONE when the name is unknown
+  bool valid;
+  char name[sizeof(LuaField::name)];
+};
+
+static LuaSourceCacheEntry luaSourceCache[LUA_SOURCE_CACHE_SIZE];
+
+static int luaFindSourceByName(const char * name)
+{
+  uint32_t hash = 2166136261u;
+  size_t len = 0;
+  for (; name[len]; len++) {
+    hash = (hash ^ (uint8_t)name[len]) * 16777619u;
+  }
+
+  // longer names than a LuaField can hold are never cached
+  if (len >= sizeof(LuaField::name)) {
+    LuaField field;
+    return luaFindFieldByName(name, field) ? field.id : MIXSRC_NONE;
+  }
+
+  LuaSourceCacheEntry & entry = luaSourceCache[hash % LUA_SOURCE_CACHE_SIZE];
+  if (entry.valid && entry.modelRevision == modelDataRevision &&
+      entry.generalRevision == generalDataRevision && !strcmp(entry.name, name))
+    return entry.id;
+
+  LuaField field;
+  entry.id = luaFindFieldByName(name, field) ? field.id : MIXSRC_NONE;
+  memcpy(entry.name, name, len + 1);
+  entry.modelRevision = modelDataRevision;
+  entry.generalRevision = generalDataRevision;
+  entry.valid = true;
+  return entry.id;
+}
+
 // Return field data for a given field id
 bool luaFindFieldById(int id, LuaField & field, unsigned int flags)
 {
@@ -715,17 +789,193 @@ static int luaGetValue(lua_State * L)
   }
   else {
     // convert from field name to its id
-    const char *name = luaL_checkstring(L, 1);
-    LuaField field;
-    bool found = luaFindFieldByName(name, field);
-    if (found) {
-      src = field.id;
-    }
+    src = luaFindSourceByName(luaL_checkstring(L, 1));
   }
   luaGetValueAndPush(L, src);
   return 1;
 }
 
+/*luadoc
+@function getValues(sources [, values])
+
+Returns the current values of several sources in one call.
+
+@param sources (table) array of source indexes (numbers) or names (strings).
+Names are replaced by their index on the first call, so keeping the same
+table between calls skips the name lookups afterwards.
+
+@param values (table) optional table to fill in, usually the one returned
+by the previous call. Passing it back avoids creating a new table on every
+refresh.
+
+@retval values (table) array with one item per source, with the same value
+`getValue` returns for it.
+
+@status current Introduced in 2.10.0
+
+@notice Values of sources which `getValue` returns as tables (GPS, date/time
+and cells) are still created on every call.
+*/
+static int luaGetValues(lua_State * L)
+{
+  luaL_checktype(L, 1, LUA_TTABLE);
+  int count = lua_rawlen(L, 1);
+
+  if (lua_istable(L, 2)) {
+    lua_settop(L, 2);
+  }
+  else {
+    lua_settop(L, 1);
+    lua_createtable(L, count, 0);
+  }
+
+  for (int i = 1; i <= count; i++) {
+    lua_rawgeti(L, 1, i);
+    int src = MIXSRC_NONE;
+    if (lua_type(L, -1) == LUA_TSTRING) {
+      src = luaFindSourceByName(lua_tostring(L, -1));
+      lua_pushinteger(L, src);
+      lua_rawseti(L, 1, i);
+    }
+    else {
+      src = lua_tointeger(L, -1);
+    }
+    lua_pop(L, 1);
+
+    luaGetValueAndPush(L, src);
+    lua_rawseti(L, 2, i);
+  }
+
+  return 1;
+}
+
+/*luadoc
+@function getSensorStats(source [, seconds])
+
+Returns the average and the rate of change of a telemetry sensor over the
+last seconds, without having to keep its values in the script.
+
+@param source telemetry source, as an index (number) or a name (string) like
+for `getValue`. The `-` and `+` sources of a sensor give the same result.
+
+@param seconds (number) optional length of the window, from 1 to 10 seconds
+(default 10). The current second is not included until it is complete.
+
+@retval nil when no statistics are available. They are started by the first
+call for a sensor, so that call returns nil.
+
+@retval multiple values:
+ * average (number) of the values received during the window
+ * rate (number) change per second between the oldest and the newest second
+   of the window, or nil when values were received in only one second
+
+@status current Introduced in 2.10.0
+
+@notice Statistics are kept for up to 8 sensors, and are reset with the
+telemetry (e.g. when loading another model).
+*/
+static int luaGetSensorStats(lua_State * L)
+{
+  int src = MIXSRC_NONE;
+  if (lua_isnumber(L, 1)) {
+    src = luaL_checkinteger(L, 1);
+  }
+  else {
+    src = luaFindSourceByName(luaL_checkstring(L, 1));
+  }
+  uint8_t seconds = limit<int>(1, luaL_optinteger(L, 2, TELEMETRY_STATS_SECONDS),
+                               TELEMETRY_STATS_SECONDS);
+
+  if (src < MIXSRC_FIRST_TELEM || src > MIXSRC_LAST_TELEM ||
+      IS_FAI_FORBIDDEN(src)) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  uint8_t index = (src - MIXSRC_FIRST_TELEM) / 3;
+  const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  TelemetryStats * stats = nullptr;
+  if (sensor.unit < UNIT_FIRST_VIRTUAL) {
+    stats = getTelemetryStats(index);
+  }
+
+  uint16_t now = get_tmr10ms() / 100;
+  int32_t average;
+  if (!stats || !stats->getAverage(seconds, now, average)) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  float divisor = sensor.prec > 0 ? sensor.getPrecDivisor() : 1;
+  lua_pushnumber(L, average / divisor);
+
+  int32_t delta;
+  uint8_t elapsed;
+  if (stats->getChange(seconds, now, delta, elapsed)) {
+    lua_pushnumber(L, delta / divisor / elapsed);
+  }
+  else {
+    lua_pushnil(L);
+  }
+  return 2;
+}
+
+/*luadoc
+@function getLinkHistory(metric [, coarse [, count]])
+
+Returns the recorded history of one link quality metric, so that widgets can
+draw it without sampling the sensors themselves.
+
+@param metric (string) `"RSSI"`, `"LQ"`, `"SNR"` or `"TXPW"` (TX power in mW)
+
+@param coarse (boolean) optional, `true` for the session track instead of
+the last 10 minutes (default `false`)
+
+@param count (number) optional, only return the newest samples (default all)
+
+@retval nil for an unknown metric
+
+@retval multiple values:
+ * values (table) from the oldest to the newest sample, `false` when the
+   metric had no data
+ * period (number) seconds between samples
+
+@status current Introduced in 2.10.0
+
+@notice Large steps are recorded over a few samples.
+*/
+static int luaGetLinkHistory(lua_State * L)
+{
+  static const char * const metrics[] = {"RSSI", "LQ", "SNR", "TXPW"};
+
+  const char * name = luaL_checkstring(L, 1);
+  uint8_t track = lua_toboolean(L, 2) ? LINK_HISTORY_COARSE : LINK_HISTORY_FINE;
+  uint16_t count = luaL_optinteger(L, 3, 0);
+
+  uint8_t metric = 0;
+  while (metric < LINK_HISTORY_METRICS && strcmp(name, metrics[metric])) {
+    metric++;
+  }
+  if (metric == LINK_HISTORY_METRICS) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  lua_newtable(L);
+  LinkHistoryReader reader(track, count);
+  LinkHistorySample sample;
+  for (int i = 1; reader.next(sample); i++) {
+    int16_t value = sample.values[metric];
+    if (value == LINK_HISTORY_NO_DATA)
+      lua_pushboolean(L, false);
+    else
+      lua_pushinteger(L, value);
+    lua_rawseti(L, -2, i);
+  }
+  lua_pushinteger(L, linkHistoryPeriod(track));
+  return 2;
+}
+
 /*luadoc
 @function getSourceValue(source)
 
@@ -786,12 +1036,7 @@ static int luaGetSourceValue(lua_State * L)
   }
   else {
     // convert from field name to its id
-    const char *name = luaL_checkstring(L, 1);
-    LuaField field;
-    bool found = luaFindFieldByName(name, field);
-    if (found) {
-      src = field.id;
-    }
+    src = luaFindSourceByName(luaL_checkstring(L, 1));
   }
 
   // Get source value. Ignored for GPS, DATETIME, and CELLS
@@ -1124,6 +1369,54 @@ static int luaAccessTelemetryPush(lua_State * L)
 }
 #endif
 
+#if defined(CROSSFIRE) || defined(GHOST)
+// Pops up to `max` length prefixed frames (Crossfire and Ghost use the same
+// layout in the queue) into an array of strings, each holding the
+// command / type byte followed by the payload
+static int luaTelemetryPopFrames(lua_State * L)
+{
+  if (!luaInputTelemetryFifo) {
+    luaInputTelemetryFifo = new Fifo<uint8_t, LUA_TELEMETRY_INPUT_FIFO_SIZE>();
+    if (!luaInputTelemetryFifo) {
+      return 0;
+    }
+  }
+
+  int max = luaL_optinteger(L, 1, LUA_TELEMETRY_INPUT_FIFO_SIZE);
+  if (lua_istable(L, 2)) {
+    lua_settop(L, 2);
+  }
+  else {
+    lua_settop(L, 1);
+    lua_newtable(L);
+  }
+
+  static uint8_t frame[UINT8_MAX];
+  int count = 0;
+  uint8_t length = 0;
+  while (count < max && luaInputTelemetryFifo->probe(length) &&
+         luaInputTelemetryFifo->size() >= uint32_t(length)) {
+    luaInputTelemetryFifo->skip();
+    if (length < 2) continue;
+    for (uint8_t i = 0; i < length - 1; i++) {
+      luaInputTelemetryFifo->pop(frame[i]);
+    }
+    lua_pushlstring(L, (const char *)frame, length - 1);
+    lua_rawseti(L, 2, ++count);
+  }
+
+  // drop the frames left over from the previous call
+  int previous = lua_rawlen(L, 2);
+  for (int i = count + 1; i <= previous; i++) {
+    lua_pushnil(L);
+    lua_rawseti(L, 2, i);
+  }
+
+  lua_pushinteger(L, count);
+  return 2;
+}
+#endif
+
 #if defined(CROSSFIRE)
 /*luadoc
 @function crossfireTelemetryPop()
@@ -1166,6 +1459,29 @@ static int luaCrossfireTelemetryPop(lua_State * L)
   return 0;
 }
 
+/*luadoc
+@function crossfireTelemetryPopFrames([max [, frames]])
+
+Pops several received Crossfire Telemetry packets from the queue at once.
+
+@param max (number) optional, maximum number of packets to pop. All the
+complete packets in the queue are returned by default.
+
+@param frames (table) optional table to fill in, usually the one returned by
+the previous call.
+
+@retval multiple returns 2 values:
+ * frames (table) array of packets, each a string holding the command byte
+   followed by the data bytes (use `string.byte` to read them)
+ * count (number) number of packets
+
+@status current Introduced in 2.10.0
+*/
+static int luaCrossfireTelemetryPopFrames(lua_State * L)
+{
+  return luaTelemetryPopFrames(L);
+}
+
 /*luadoc
 @function crossfireTelemetryPush()
 
@@ -1264,6 +1580,29 @@ static int luaGhostTelemetryPop(lua_State * L)
   return 0;
 }
 
+/*luadoc
+@function ghostTelemetryPopFrames([max [, frames]])
+
+Pops several received Ghost Telemetry packets from the queue at once.
+
+@param max (number) optional, maximum number of packets to pop. All the
+complete packets in the queue are returned by default.
+
+@param frames (table) optional table to fill in, usually the one returned by
+the previous call.
+
+@retval multiple returns 2 values:
+ * frames (table) array of packets, each a string holding the type byte
+   followed by the payload and crc bytes (use `string.byte` to read them)
+ * count (number) number of packets
+
+@status current Introduced in 2.10.0
+*/
+static int luaGhostTelemetryPopFrames(lua_State * L)
+{
+  return luaTelemetryPopFrames(L);
+}
+
 /*luadoc
 @function ghostTelemetryPush()
 
@@ -1367,13 +1706,16 @@ Return the internal GPS position or nil if no valid hardware found
  * `speed` (number) internal GPSspeed in 0.1m/s
  * `heading`  (number) internal GPS ground course estimation in degrees * 10
  * `hdop` (number)  internal GPS horizontal dilution of precision
+ * `vspeed` (number) internal GPS vertical speed in 0.1m/s, positive up (UBX only)
+ * `hacc` (number) internal GPS horizontal accuracy in 0.1m (UBX only)
+ * `vacc` (number) internal GPS vertical accuracy in 0.1m (UBX only)
 
-@status current Introduced in 2.2.2
+@status current Introduced in 2.2.2, `vspeed`, `hacc` and `vacc` introduced in 2.10.0
 */
 static int luaGetTxGPS(lua_State * L)
 {
 #if defined(INTERNAL_GPS)
-  lua_createtable(L, 0, 8);
+  lua_createtable(L, 0, 11);
   lua_pushtablenumber(L, "lat", gpsData.latitude * 0.000001);
   lua_pushtablenumber(L, "lon", gpsData.longitude * 0.000001);
   lua_pushtableinteger(L, "numsat", gpsData.numSat);
@@ -1381,6 +1723,9 @@ static int luaGetTxGPS(lua_State * L)
   lua_pushtableinteger(L, "speed", gpsData.speed);
   lua_pushtableinteger(L, "heading", gpsData.groundCourse);
   lua_pushtableinteger(L, "hdop", gpsData.hdop);
+  lua_pushtableinteger(L, "vspeed", gpsData.verticalSpeed);
+  lua_pushtableinteger(L, "hacc", gpsData.hAcc);
+  lua_pushtableinteger(L, "vacc", gpsData.vAcc);
   if (gpsData.fix)
     lua_pushtableboolean(L, "fix", true);
   else
@@ -1972,6 +2317,47 @@ static int luaGetRSSI(lua_State * L)
   return 3;
 }
 
+/*luadoc
+@function getModuleTiming(moduleIndex)
+
+Get the frame timing statistics of a module, counted since boot
+or since the last reset from the statistics page
+
+@param moduleIndex (number) module index (0 for internal, 1 for external)
+
+@retval nil for an invalid module index
+
+@retval table with:
+ * `frames` (number) frames sent on a scheduler trigger
+ * `late` (number) frames whose transfer started more than one period after the trigger
+ * `dropped` (number) scheduled frames that were never sent
+ * `last` (number) delay from trigger to transfer start of the last frame (us)
+ * `max` (number) longest such delay over the last 16 frames (us)
+ * `latency` (number) delay from stick sampling to transfer start of the last frame (us)
+
+@status current Introduced in 2.9.0
+*/
+static int luaGetModuleTiming(lua_State * L)
+{
+  uint8_t idx = luaL_checkunsigned(L, 1);
+  if (idx >= NUM_MODULES) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  ModuleTimingStats stats;
+  moduleTimingGetStats(idx, stats);
+
+  lua_newtable(L);
+  lua_pushtableinteger(L, "frames", stats.frames);
+  lua_pushtableinteger(L, "late", stats.late);
+  lua_pushtableinteger(L, "dropped", stats.dropped);
+  lua_pushtableinteger(L, "last", stats.lastSent);
+  lua_pushtableinteger(L, "max", stats.maxSent);
+  lua_pushtableinteger(L, "latency", stats.lastLatency);
+  return 1;
+}
+
 /*luadoc
 @function chdir(directory)
 
@@ -2024,6 +2410,10 @@ then the loaded script (or "chunk") is returned as a function. Otherwise, return
 
 @param env (integer) See documentation for Lua function loadfile().
 
+@notice On color LCD radios, widgets loading a script without `env` share the
+  loaded chunk: it is read and compiled only once for all the widgets, until the
+  widgets are reloaded.
+
 @retval function The loaded script, or `nil` if there was an error (e.g. file not found or syntax error).
 
 @retval string Error message(s), if any. Blank if no error occurred.
@@ -2042,6 +2432,61 @@ then the loaded script (or "chunk") is returned as a function. Otherwise, return
 ```
 
 */
+#if defined(COLORLCD)
+#define LUA_CHUNK_CACHE "edgetx.chunks"
+
+// Pushes the chunk cache of the widgets state, a table with weak values
+// so that chunks no widget refers to anymore can still be collected
+static void luaPushChunkCache(lua_State * L)
+{
+  lua_getfield(L, LUA_REGISTRYINDEX, LUA_CHUNK_CACHE);
+  if (lua_istable(L, -1)) return;
+
+  lua_pop(L, 1);
+  lua_newtable(L);
+  lua_newtable(L);
+  lua_pushliteral(L, "v");
+  lua_setfield(L, -2, "__mode");
+  lua_setmetatable(L, -2);
+  lua_pushvalue(L, -1);
+  lua_setfield(L, LUA_REGISTRYINDEX, LUA_CHUNK_CACHE);
+}
+
+// Widgets without their own environment share the chunks they load:
+// several instances of a widget load the same libraries only once
+static bool luaLoadCachedScript(lua_State * L, const char * fname, const char * mode)
+{
+  luaPushChunkCache(L);
+  lua_pushfstring(L, "%s|%s", fname, mode ? mode : "");
+  lua_pushvalue(L, -1);
+  lua_rawget(L, -3);
+  if (lua_isfunction(L, -1)) {
+    lua_replace(L, 1);
+    lua_settop(L, 1);
+    return true;
+  }
+  lua_pop(L, 1);
+
+  // cache and key stay below the chunk
+  if (luaLoadScriptFileToState(L, fname, mode) != SCRIPT_OK) {
+    if (lua_isstring(L, -1)) {
+      lua_replace(L, 1);
+      lua_settop(L, 1);
+    }
+    else {
+      lua_settop(L, 0);
+    }
+    return false;
+  }
+  lua_pushvalue(L, -2);
+  lua_pushvalue(L, -2);
+  lua_rawset(L, -5);
+  lua_replace(L, 1);
+  lua_settop(L, 1);
+  return true;
+}
+#endif
+
 static int luaLoadScript(lua_State * L)
 {
   // this function is replicated pretty much verbatim from luaB_loadfile() and load_aux() in lbaselib.c
@@ -2049,6 +2494,14 @@ static int luaLoadScript(lua_State * L)
   const char *mode = luaL_optstring(L, 2, NULL);
   int env = (!lua_isnone(L, 3) ? 3 : 0);  // 'env' index or 0 if no 'env'
   lua_settop(L, 0);
+#if defined(COLORLCD)
+  // forced compilation is not skipped
+  if (fname != NULL && env == 0 && L == lsWidgets && !(mode && strchr(mode, 'c'))) {
+    if (luaLoadCachedScript(L, fname, mode))
+      return 1;
+  }
+  else
+#endif
   if (fname != NULL && luaLoadScriptFileToState(L, fname , mode) == SCRIPT_OK) {
     if (env != 0) {  // 'env' parameter?
       lua_pushvalue(L, env);  // environment for loaded function
@@ -2057,16 +2510,15 @@ static int luaLoadScript(lua_State * L)
     }
     return 1;
   }
-  else {
-    // error (message should be on top of the stack)
-    if (!lua_isstring(L, -1)) {
-      // probably didn't find a file or had some other error before luaL_loadfile() was run
-      lua_pushfstring(L, "loadScript(\"%s\", \"%s\") error: File not found", (fname != NULL ? fname : "nul"), (mode != NULL ? mode : "bt"));
-    }
-    lua_pushnil(L);
-    lua_insert(L, -2);  // move nil before error message
-    return 2;  // return nil plus error message
+
+  // error (message should be on top of the stack)
+  if (!lua_isstring(L, -1)) {
+    // probably didn't find a file or had some other error before luaL_loadfile() was run
+    lua_pushfstring(L, "loadScript(\"%s\", \"%s\") error: File not found", (fname != NULL ? fname : "nul"), (mode != NULL ? mode : "bt"));
   }
+  lua_pushnil(L);
+  lua_insert(L, -2);  // move nil before error message
+  return 2;  // return nil plus error message
 }
 
 /*luadoc
@@ -2076,11 +2528,91 @@ Get percent of already used Lua instructions in current script execution cycle.
 
 @retval usage (number) a value from 0 to 100 (percent)
 
-@status current Introduced in 2.2.1
+@retval average (number) rolling average run time of the calling script in us
+
+@retval peak (number) longest run time of the calling script in us
+
+@retval current (number) time already spent in the current run in us
+
+@status current Introduced in 2.2.1, run times added in 2.9.0
 */
 static int luaGetUsage(lua_State * L)
 {
   lua_pushinteger(L, instructionsPercent);
+  LuaScriptUsage * usage = luaRunningUsage;
+  if (!usage) return 1;
+
+  luaUsageTick();
+  lua_pushunsigned(L, usage->avgUs);
+  lua_pushunsigned(L, usage->peakUs);
+  lua_pushunsigned(L, usage->current / 2);
+  return 4;
+}
+
+/*luadoc
+@function setWakeup([conditions])
+
+Parks the background function of the running script: the scheduler skips it
+until one of the conditions is met, so a script waiting for something to
+happen does not use any CPU time. The script is woken up only once, it has to
+call `setWakeup` again to be parked again.
+
+Only the `background` functions of function scripts, telemetry scripts and
+widgets can be parked. Mix scripts run on every cycle.
+
+@param conditions (table) any of:
+ * `timeout` (number) longest wait in 10ms units
+ * `sources` (table) up to 4 source indexes or names, the script is woken up
+ when the value of one of them changes. Switches and logical switches are
+ sources as well, so this also catches switch edges
+ * `telemetry` (boolean) the script is woken up when a sensor value is
+ received, or when a telemetry frame is waiting to be popped by Lua
+
+Calling `setWakeup()` without a table cancels a previous call.
+
+@retval parked (boolean) `true` if the script is parked
+
+@status current Introduced in 2.10.0
+*/
+static int luaSetWakeup(lua_State * L)
+{
+  LuaWakeup * wakeup = luaRunningWakeup;
+  if (!wakeup || !lua_istable(L, 1)) {
+    if (wakeup) wakeup->parked = false;
+    lua_pushboolean(L, false);
+    return 1;
+  }
+
+  memclear(wakeup, sizeof(LuaWakeup));
+  wakeup->start = get_tmr10ms();
+
+  lua_getfield(L, 1, "timeout");
+  wakeup->timeout = min<lua_Unsigned>(lua_tounsigned(L, -1), UINT16_MAX);
+  lua_pop(L, 1);
+
+  lua_getfield(L, 1, "telemetry");
+  wakeup->telemetry = lua_toboolean(L, -1);
+  wakeup->telemetryValues = telemetryValuesCount;
+  lua_pop(L, 1);
+
+  lua_getfield(L, 1, "sources");
+  if (lua_istable(L, -1)) {
+    int count = min<int>(lua_rawlen(L, -1), LUA_WAKEUP_MAX_SOURCES);
+    for (int i = 1; i <= count; i++) {
+      lua_rawgeti(L, -1, i);
+      int src = lua_type(L, -1) == LUA_TSTRING
+                    ? luaFindSourceByName(lua_tostring(L, -1))
+                    : lua_tointeger(L, -1);
+      lua_pop(L, 1);
+      if (src == MIXSRC_NONE) continue;
+      wakeup->sources[wakeup->sourcesCount] = src;
+      wakeup->values[wakeup->sourcesCount++] = getValue(src);
+    }
+  }
+  lua_pop(L, 1);
+
+  wakeup->parked = wakeup->timeout || wakeup->telemetry || wakeup->sourcesCount;
+  lua_pushboolean(L, wakeup->parked);
   return 1;
 }
 
@@ -2090,11 +2622,17 @@ static int luaGetUsage(lua_State * L)
 Get available memory remaining in the Heap for Lua.
 
 @retval usage (number) a value returned in b
+
+@retval minimum (number) lowest value seen since the radio was started, in b
+
+@retval largest (number) largest block that can still be allocated in one go, in b
 */
 static int luaGetAvailableMemory(lua_State * L)
 {
   lua_pushunsigned(L, availableMemory());
-  return 1;
+  lua_pushunsigned(L, minAvailableMemory());
+  lua_pushunsigned(L, largestFreeMemoryBlock());
+  return 3;
 }
 
 /*luadoc
@@ -2244,34 +2782,54 @@ Reads characters from the serial port. The string is allowed to contain any char
 static int luaSerialRead(lua_State * L)
 {
 #if defined(LUA) && !defined(CLI)
-  int num = luaL_optunsigned(L, 1, 0);
+  uint32_t num = luaL_optunsigned(L, 1, 0);
+  uint32_t max = (num > 0 && num < LUA_FIFO_SIZE) ? num : LUA_FIFO_SIZE;
+  uint32_t len = 0;
 
-  uint8_t str[LUA_FIFO_SIZE];
-  uint8_t *p = str;
+  luaL_Buffer b;
+  luaL_buffinit(L, &b);
+
+  auto _getRxSpan = luaGetSerialRxSpan;
+  auto _consumeRx = luaConsumeSerialRx;
+  auto _spanCtx = luaSerialRxSpanCtx;
 
   auto _getByte = luaGetSerialByte;
   auto _ctx = luaGetSerialByteCtx;
 
-  if (_getByte) {
-    while (_getByte(_ctx, p) > 0) {
-      p++;  // increment only when pop was successful
-      if (p - str >= LUA_FIFO_SIZE) {
-        // buffer full
-        break;
-      }
+  if (_getRxSpan && _consumeRx) {
+    // copy whole spans straight out of the receive buffer
+    bool eol = false;
+    while (len < max && !eol) {
+      const uint8_t* data = nullptr;
+      uint32_t span = min<uint32_t>(_getRxSpan(_spanCtx, &data), max - len);
+      if (span == 0) break;
       if (num == 0) {
-        if (*(p - 1) == '\n' || *(p - 1) == '\r') {
-          // found newline
-          break;
+        for (uint32_t i = 0; i < span; i++) {
+          if (data[i] == '\n' || data[i] == '\r') {
+            // found newline
+            span = i + 1;
+            eol = true;
+            break;
+          }
         }
       }
-      else if (p - str >= num) {
-        // requested number of characters reached
+      luaL_addlstring(&b, (const char*)data, span);
+      _consumeRx(_spanCtx, span);
+      len += span;
+    }
+  }
+  else if (_getByte) {
+    uint8_t c;
+    while (len < max && _getByte(_ctx, &c) > 0) {
+      luaL_addchar(&b, c);
+      len++;
+      if (num == 0 && (c == '\n' || c == '\r')) {
+        // found newline
         break;
       }
     }
   }
-  lua_pushlstring(L, (const char*)str, p - str);
+  luaL_pushresult(&b);
 #else
   lua_pushlstring(L, "", 0);
 #endif
@@ -2416,6 +2974,226 @@ static int luaGetShmVar(lua_State * L)
 }
 #endif
 
+struct LuaShmRecord {
+  uint8_t type;
+  uint8_t count;
+  int32_t values[3];
+};
+
+enum LuaShmMode {
+  LUA_SHM_LUA,           // between Lua scripts and widgets
+  LUA_SHM_TO_GVAR,       // popped by the mixer into a GVar
+  LUA_SHM_FROM_SOURCE,   // pushed by the mixer with the value of a source
+};
+
+struct LuaShmRing {
+  SpscFifo<LuaShmRecord, LUA_SHM_RING_SIZE> records;
+  uint8_t mode;
+  uint8_t gvar;
+  mixsrc_t source;
+  uint16_t dropped;      // records pushed while the ring was full
+};
+
+static LuaShmRing luaShmRings[LUA_SHM_RINGS];
+
+static LuaShmRing * luaCheckShmRing(lua_State * L)
+{
+  int id = luaL_checkinteger(L, 1);
+  luaL_argcheck(L, 1 <= id && id <= LUA_SHM_RINGS, 1, "invalid ring");
+  return &luaShmRings[id - 1];
+}
+
+void luaShmPopGVars()
+{
+#if defined(GVARS)
+  for (LuaShmRing & ring : luaShmRings) {
+    LuaShmRecord record;
+    if (ring.mode != LUA_SHM_TO_GVAR || !ring.records.pop(record)) continue;
+
+    // streamed values are not saved on their own: only the
+    // mixer caches are invalidated, not the model
+    uint8_t gv = ring.gvar;
+    uint8_t fm = getGVarFlightMode(mixerCurrentFlightMode, gv);
+    int16_t value = limit<int32_t>(MODEL_GVAR_MIN(gv), record.values[0],
+                                   MODEL_GVAR_MAX(gv));
+    if (GVAR_VALUE(gv, fm) != value) {
+      GVAR_VALUE(gv, fm) = value;
+      modelRuntimeRevision++;
+    }
+  }
+#endif
+}
+
+void luaShmPushSources()
+{
+  for (LuaShmRing & ring : luaShmRings) {
+    if (ring.mode != LUA_SHM_FROM_SOURCE) continue;
+
+    LuaShmRecord record = {0, 1, {getValue(ring.source)}};
+    if (!ring.records.push(record) && ring.dropped < UINT16_MAX) {
+      ring.dropped++;
+    }
+  }
+}
+
+/*luadoc
+@function shmRingPush(id, type, value1 [, value2 [, value3]])
+
+Appends a record to a shared ring. Rings carry records of up to 3 integers
+tagged with a type, from one producer to one consumer: a Lua script to a
+widget (or the other way round), a script to the mixer (see `shmRingBind`)
+or the mixer to a script. They never block, and a full ring is reported
+rather than overwritten.
+
+@param id (number) ring number, 1 to 4 (1 to 2 on radios without color display)
+
+@param type (number) 0 to 255, free for the scripts to use
+
+@param value1..value3 (number) record values
+
+@retval ok (boolean) `false` if the ring is full, or is filled by the mixer
+
+@status current Introduced in 2.10.0
+*/
+static int luaShmRingPush(lua_State * L)
+{
+  LuaShmRing * ring = luaCheckShmRing(L);
+  LuaShmRecord record;
+  record.type = luaL_checkunsigned(L, 2);
+  record.count = min<int>(lua_gettop(L) - 2, DIM(record.values));
+  luaL_argcheck(L, record.count > 0, 3, "value expected");
+  for (uint8_t i = 0; i < DIM(record.values); i++) {
+    record.values[i] = i < record.count ? luaL_checkinteger(L, 3 + i) : 0;
+  }
+
+  bool ok = false;
+  if (ring->mode != LUA_SHM_FROM_SOURCE) {
+    ok = ring->records.push(record);
+    if (!ok && ring->dropped < UINT16_MAX) ring->dropped++;
+  }
+  lua_pushboolean(L, ok);
+  return 1;
+}
+
+/*luadoc
+@function shmRingPop(id)
+
+Removes the oldest record of a shared ring.
+
+@param id (number) ring number
+
+@retval type (number) type of the record, `nil` if the ring is empty. Records
+pushed by the mixer have type 0 and hold the source value.
+
+@retval value1..value3 (number) record values, as many as were pushed
+
+@status current Introduced in 2.10.0
+*/
+static int luaShmRingPop(lua_State * L)
+{
+  LuaShmRing * ring = luaCheckShmRing(L);
+  LuaShmRecord record;
+  if (ring->mode == LUA_SHM_TO_GVAR || !ring->records.pop(record)) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  lua_pushunsigned(L, record.type);
+  for (uint8_t i = 0; i < record.count; i++) {
+    lua_pushinteger(L, record.values[i]);
+  }
+  return 1 + record.count;
+}
+
+/*luadoc
+@function shmRingInfo(id)
+
+@param id (number) ring number
+
+@retval used (number) records waiting in the ring
+
+@retval free (number) records that can still be pushed
+
+@retval dropped (number) records lost because the ring was full
+
+@status current Introduced in 2.10.0
+*/
+static int luaShmRingInfo(lua_State * L)
+{
+  LuaShmRing * ring = luaCheckShmRing(L);
+  uint32_t used = ring->records.size();
+  lua_pushunsigned(L, used);
+  lua_pushunsigned(L, ring->records.capacity() - used);
+  lua_pushunsigned(L, ring->dropped);
+  return 3;
+}
+
+/*luadoc
+@function shmRingBind(id [, target])
+
+Connects a shared ring to the mixer. The ring is emptied.
+
+@param id (number) ring number
+
+@param target (table) one of:
+ * `gvar` (number) GVar index (0 for GV1): the mixer pops one record per
+ cycle and sets the GVar (in the current flight mode) to its first value,
+ before the mixes are evaluated. Streamed values are not saved on their own
+ * `source` (number or string) source index or name: the mixer pushes its
+ value every cycle, after the mixes are evaluated
+
+Without target the ring is used between Lua scripts and widgets again.
+
+@status current Introduced in 2.10.0
+
+@notice When the mixer runs at 4ms, a ring holds 256ms worth of records on
+radios with color display (128ms otherwise): a script has to push or pop
+them at least that often.
+*/
+static int luaShmRingBind(lua_State * L)
+{
+  LuaShmRing * ring = luaCheckShmRing(L);
+  uint8_t mode = LUA_SHM_LUA;
+  uint8_t gvar = 0;
+  mixsrc_t source = MIXSRC_NONE;
+
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "gvar");
+    if (lua_isnumber(L, -1)) {
+      int idx = lua_tointeger(L, -1);
+#if defined(GVARS)
+      luaL_argcheck(L, 0 <= idx && idx < MAX_GVARS, 2, "invalid gvar");
+#else
+      luaL_argerror(L, 2, "no gvars");
+#endif
+      mode = LUA_SHM_TO_GVAR;
+      gvar = idx;
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, 2, "source");
+    if (!lua_isnil(L, -1)) {
+      if (lua_type(L, -1) == LUA_TSTRING)
+        source = luaFindSourceByName(lua_tostring(L, -1));
+      else
+        source = lua_tointeger(L, -1);
+      luaL_argcheck(L, source != MIXSRC_NONE, 2, "invalid source");
+      mode = LUA_SHM_FROM_SOURCE;
+    }
+    lua_pop(L, 1);
+  }
+
+  // the mixer is the other side
+  mixerTaskLock();
+  ring->records.clear();
+  ring->mode = mode;
+  ring->gvar = gvar;
+  ring->source = source;
+  ring->dropped = 0;
+  mixerTaskUnlock();
+  return 0;
+}
+
 /*luadoc
 @function setStickySwitch(id, value)
 
@@ -2747,7 +3525,7 @@ static int luaGetOutputValue(lua_State * L)
 {
   mixsrc_t idx = luaL_checkinteger(L, 1);
   if (idx < MAX_OUTPUT_CHANNELS) {           // mixsrc_t is unsigned, no need to check for <0
-    lua_pushinteger(L, channelOutputs[idx]);
+    lua_pushinteger(L, mixerGetChannelOutput(idx));
   } else {
     lua_pushinteger(L, 0);
   }
@@ -2791,6 +3569,9 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( getRotEncSpeed, luaGetRotEncSpeed )
   LROT_FUNCENTRY( getRotEncMode, luaGetRotEncMode )
   LROT_FUNCENTRY( getValue, luaGetValue )
+  LROT_FUNCENTRY( getValues, luaGetValues )
+  LROT_FUNCENTRY( getSensorStats, luaGetSensorStats )
+  LROT_FUNCENTRY( getLinkHistory, luaGetLinkHistory )
   LROT_FUNCENTRY( getOutputValue, luaGetOutputValue )
   LROT_FUNCENTRY( getSourceValue, luaGetSourceValue )
   LROT_FUNCENTRY( getTrainerStatus, luaGetTrainerStatus )
@@ -2817,6 +3598,8 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( chdir, luaChdir )
   LROT_FUNCENTRY( loadScript, luaLoadScript )
   LROT_FUNCENTRY( getUsage, luaGetUsage )
+  LROT_FUNCENTRY( setWakeup, luaSetWakeup )
+  LROT_FUNCENTRY( getModuleTiming, luaGetModuleTiming )
   LROT_FUNCENTRY( getAvailableMemory, luaGetAvailableMemory )
   LROT_FUNCENTRY( resetGlobalTimer, luaResetGlobalTimer )
 #if LCD_DEPTH > 1 && !defined(COLORLCD)
@@ -2830,10 +3613,12 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( setTelemetryValue, luaSetTelemetryValue )
 #if defined(CROSSFIRE)
   LROT_FUNCENTRY( crossfireTelemetryPop, luaCrossfireTelemetryPop )
+  LROT_FUNCENTRY( crossfireTelemetryPopFrames, luaCrossfireTelemetryPopFrames )
   LROT_FUNCENTRY( crossfireTelemetryPush, luaCrossfireTelemetryPush )
 #endif
 #if defined(GHOST)
   LROT_FUNCENTRY( ghostTelemetryPop, luaGhostTelemetryPop )
+  LROT_FUNCENTRY( ghostTelemetryPopFrames, luaGhostTelemetryPopFrames )
   LROT_FUNCENTRY( ghostTelemetryPush, luaGhostTelemetryPush )
 #endif
 #if defined(MULTIMODULE)
@@ -2850,6 +3635,10 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( setShmVar, luaSetShmVar )
   LROT_FUNCENTRY( getShmVar, luaGetShmVar )
 #endif
+  LROT_FUNCENTRY( shmRingPush, luaShmRingPush )
+  LROT_FUNCENTRY( shmRingPop, luaShmRingPop )
+  LROT_FUNCENTRY( shmRingInfo, luaShmRingInfo )
+  LROT_FUNCENTRY( shmRingBind, luaShmRingBind )
   LROT_FUNCENTRY( setStickySwitch, luaSetStickySwitch )
   LROT_FUNCENTRY( getLogicalSwitchValue, luaGetLogicalSwitchValue )
   LROT_FUNCENTRY( getSwitchIndex, luaGetSwitchIndex )
@@ -2962,6 +3751,17 @@ LROT_BEGIN(etxcst, NULL, 0)
   LROT_NUMENTRY( ALIGNMENT, ZoneOption::Align )
   LROT_NUMENTRY( MENU_HEADER_HEIGHT, COLOR2FLAGS(MENU_HEADER_HEIGHT) )
 
+  // lcd.drawList() primitives
+  LROT_NUMENTRY( DRAW_COLOR, DRAW_OP_COLOR )
+  LROT_NUMENTRY( DRAW_POINT, DRAW_OP_POINT )
+  LROT_NUMENTRY( DRAW_LINE, DRAW_OP_LINE )
+  LROT_NUMENTRY( DRAW_RECT, DRAW_OP_RECT )
+  LROT_NUMENTRY( DRAW_FILLED_RECT, DRAW_OP_FILLED_RECT )
+  LROT_NUMENTRY( DRAW_CIRCLE, DRAW_OP_CIRCLE )
+  LROT_NUMENTRY( DRAW_FILLED_CIRCLE, DRAW_OP_FILLED_CIRCLE )
+  LROT_NUMENTRY( DRAW_TRIANGLE, DRAW_OP_TRIANGLE )
+  LROT_NUMENTRY( DRAW_FILLED_TRIANGLE, DRAW_OP_FILLED_TRIANGLE )
+
   // Colors gui/colorlcd/colors.h
   LROT_NUMENTRY( COLOR_THEME_PRIMARY1, COLOR2FLAGS(COLOR_THEME_PRIMARY1_INDEX) )
   LROT_NUMENTRY( COLOR_THEME_PRIMARY2, COLOR2FLAGS(COLOR_THEME_PRIMARY2_INDEX) )
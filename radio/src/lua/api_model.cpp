@@ -37,6 +37,67 @@
 #include "pulses/multi.h"
 #endif
 
+// Batch getters (model.getInputs(), model.getMixes(), ...) fill the table
+// passed by the caller, reusing the item tables it already holds, and may be
+// limited to a set of fields: `fields` is the stack index of a table whose
+// keys are the wanted field names, or 0 for all fields.
+static bool luaWantField(lua_State * L, int fields, const char * key)
+{
+  if (!fields) return true;
+  lua_getfield(L, fields, key);
+  bool want = lua_toboolean(L, -1);
+  lua_pop(L, 1);
+  return want;
+}
+
+// Leaves the result table at stack index `idx` (and on top of the stack)
+static void luaBatchResult(lua_State * L, int idx)
+{
+  if (lua_istable(L, idx)) {
+    lua_settop(L, idx);
+  }
+  else {
+    lua_settop(L, idx - 1);
+    lua_newtable(L);
+  }
+}
+
+// Pushes the `i`-th item table of the result, creating it when missing
+static void luaBatchItem(lua_State * L, int result, int i)
+{
+  lua_rawgeti(L, result, i);
+  if (!lua_istable(L, -1)) {
+    lua_pop(L, 1);
+    lua_newtable(L);
+    lua_pushvalue(L, -1);
+    lua_rawseti(L, result, i);
+  }
+}
+
+// Pushes the sub-table `key` of the table on top of the stack, creating it
+// when missing
+static void luaBatchSubTable(lua_State * L, const char * key)
+{
+  lua_getfield(L, -1, key);
+  if (!lua_istable(L, -1)) {
+    lua_pop(L, 1);
+    lua_newtable(L);
+    lua_pushvalue(L, -1);
+    lua_setfield(L, -3, key);
+  }
+}
+
+// Drops the items after `count` left over from a previous call
+static void luaBatchTrim(lua_State * L, int result, int count)
+{
+  result = lua_absindex(L, result);
+  int previous = lua_rawlen(L, result);
+  for (int i = count + 1; i <= previous; i++) {
+    lua_pushnil(L);
+    lua_rawseti(L, result, i);
+  }
+}
+
 /*luadoc
 @function model.getInfo()
 
@@ -577,6 +638,21 @@ static int luaModelSetFlightMode(lua_State * L)
   return 1;
 }
 
+static void luaPushInput(lua_State * L, unsigned int chn, const ExpoData * expo, int fields)
+{
+  if (luaWantField(L, fields, "name")) lua_pushtablenstring(L, "name", expo->name);
+  if (luaWantField(L, fields, "inputName")) lua_pushtablenstring(L, "inputName", g_model.inputNames[chn]);
+  if (luaWantField(L, fields, "source")) lua_pushtableinteger(L, "source", expo->srcRaw);
+  if (luaWantField(L, fields, "scale")) lua_pushtableinteger(L, "scale", expo->scale);
+  if (luaWantField(L, fields, "weight")) lua_pushtableinteger(L, "weight", expo->weight);
+  if (luaWantField(L, fields, "offset")) lua_pushtableinteger(L, "offset", expo->offset);
+  if (luaWantField(L, fields, "switch")) lua_pushtableinteger(L, "switch", expo->swtch);
+  if (luaWantField(L, fields, "curveType")) lua_pushtableinteger(L, "curveType", expo->curve.type);
+  if (luaWantField(L, fields, "curveValue")) lua_pushtableinteger(L, "curveValue", expo->curve.value);
+  if (luaWantField(L, fields, "trimSource")) lua_pushtableinteger(L, "trimSource", - expo->trimSource);
+  if (luaWantField(L, fields, "flightModes")) lua_pushtableinteger(L, "flightModes", expo->flightModes);
+}
+
 /*luadoc
 @function model.getInput(input, line)
 
@@ -611,19 +687,8 @@ static int luaModelGetInput(lua_State *L)
   unsigned int first = getFirstInput(chn);
   unsigned int count = getInputsCountFromFirst(chn, first);
   if (idx < count) {
-    ExpoData * expo = expoAddress(first+idx);
     lua_newtable(L);
-    lua_pushtablenstring(L, "name", expo->name);
-    lua_pushtablenstring(L, "inputName", g_model.inputNames[chn]);
-    lua_pushtableinteger(L, "source", expo->srcRaw);
-    lua_pushtableinteger(L, "scale", expo->scale);
-    lua_pushtableinteger(L, "weight", expo->weight);
-    lua_pushtableinteger(L, "offset", expo->offset);
-    lua_pushtableinteger(L, "switch", expo->swtch);
-    lua_pushtableinteger(L, "curveType", expo->curve.type);
-    lua_pushtableinteger(L, "curveValue", expo->curve.value);
-    lua_pushtableinteger(L, "trimSource", - expo->trimSource);
-    lua_pushtableinteger(L, "flightModes", expo->flightModes);
+    luaPushInput(L, chn, expoAddress(first+idx), 0);
   }
   else {
     lua_pushnil(L);
@@ -631,6 +696,45 @@ static int luaModelGetInput(lua_State *L)
   return 1;
 }
 
+/*luadoc
+@function model.getInputs(input [, fields [, lines]])
+
+Return the data of all the lines of an input in one call
+
+@param input (unsigned number) input number (use 0 for Input1)
+
+@param fields (table) optional, set of the wanted fields (i.e. `{source=true, weight=true}`).
+All fields are returned when omitted.
+
+@param lines (table) optional table to fill in, usually the one returned by the
+previous call. The line tables it holds are reused, fields which are not requested
+are left untouched.
+
+@retval table array of input lines, see model.getInput() for the format of each line
+
+@status current Introduced in 2.10.0
+*/
+static int luaModelGetInputs(lua_State *L)
+{
+  unsigned int chn = luaL_checkunsigned(L, 1);
+  int fields = lua_istable(L, 2) ? 2 : 0;
+  luaBatchResult(L, 3);
+
+  unsigned int count = 0;
+  if (chn < MAX_INPUTS) {
+    unsigned int first = getFirstInput(chn);
+    count = getInputsCountFromFirst(chn, first);
+    for (unsigned int i = 0; i < count; i++) {
+      luaBatchItem(L, 3, i + 1);
+      luaPushInput(L, chn, expoAddress(first + i), fields);
+      lua_pop(L, 1);
+    }
+  }
+
+  luaBatchTrim(L, 3, count);
+  return 1;
+}
+
 /*luadoc
 @function model.insertInput(input, line, value)
 
@@ -805,6 +909,25 @@ static int luaModelGetMixesCount(lua_State *L)
   return 1;
 }
 
+static void luaPushMix(lua_State * L, const MixData * mix, int fields)
+{
+  if (luaWantField(L, fields, "name")) lua_pushtablenstring(L, "name", mix->name);
+  if (luaWantField(L, fields, "source")) lua_pushtableinteger(L, "source", mix->srcRaw);
+  if (luaWantField(L, fields, "weight")) lua_pushtableinteger(L, "weight", mix->weight);
+  if (luaWantField(L, fields, "offset")) lua_pushtableinteger(L, "offset", mix->offset);
+  if (luaWantField(L, fields, "switch")) lua_pushtableinteger(L, "switch", mix->swtch);
+  if (luaWantField(L, fields, "curveType")) lua_pushtableinteger(L, "curveType", mix->curve.type);
+  if (luaWantField(L, fields, "curveValue")) lua_pushtableinteger(L, "curveValue", mix->curve.value);
+  if (luaWantField(L, fields, "multiplex")) lua_pushtableinteger(L, "multiplex", mix->mltpx);
+  if (luaWantField(L, fields, "flightModes")) lua_pushtableinteger(L, "flightModes", mix->flightModes);
+  if (luaWantField(L, fields, "carryTrim")) lua_pushtableboolean(L, "carryTrim", mix->carryTrim);
+  if (luaWantField(L, fields, "mixWarn")) lua_pushtableinteger(L, "mixWarn", mix->mixWarn);
+  if (luaWantField(L, fields, "delayUp")) lua_pushtableinteger(L, "delayUp", mix->delayUp);
+  if (luaWantField(L, fields, "delayDown")) lua_pushtableinteger(L, "delayDown", mix->delayDown);
+  if (luaWantField(L, fields, "speedUp")) lua_pushtableinteger(L, "speedUp", mix->speedUp);
+  if (luaWantField(L, fields, "speedDown")) lua_pushtableinteger(L, "speedDown", mix->speedDown);
+}
+
 /*luadoc
 @function model.getMix(channel, line)
 
@@ -842,23 +965,8 @@ static int luaModelGetMix(lua_State *L)
   unsigned int first = getFirstMix(chn);
   unsigned int count = getMixesCountFromFirst(chn, first);
   if (idx < count) {
-    MixData * mix = mixAddress(first+idx);
     lua_newtable(L);
-    lua_pushtablenstring(L, "name", mix->name);
-    lua_pushtableinteger(L, "source", mix->srcRaw);
-    lua_pushtableinteger(L, "weight", mix->weight);
-    lua_pushtableinteger(L, "offset", mix->offset);
-    lua_pushtableinteger(L, "switch", mix->swtch);
-    lua_pushtableinteger(L, "curveType", mix->curve.type);
-    lua_pushtableinteger(L, "curveValue", mix->curve.value);
-    lua_pushtableinteger(L, "multiplex", mix->mltpx);
-    lua_pushtableinteger(L, "flightModes", mix->flightModes);
-    lua_pushtableboolean(L, "carryTrim", mix->carryTrim);
-    lua_pushtableinteger(L, "mixWarn", mix->mixWarn);
-    lua_pushtableinteger(L, "delayUp", mix->delayUp);
-    lua_pushtableinteger(L, "delayDown", mix->delayDown);
-    lua_pushtableinteger(L, "speedUp", mix->speedUp);
-    lua_pushtableinteger(L, "speedDown", mix->speedDown);
+    luaPushMix(L, mixAddress(first+idx), 0);
   }
   else {
     lua_pushnil(L);
@@ -866,6 +974,45 @@ static int luaModelGetMix(lua_State *L)
   return 1;
 }
 
+/*luadoc
+@function model.getMixes(channel [, fields [, lines]])
+
+Get the configuration of all the mixes of a channel in one call
+
+@param channel (unsigned number) channel number (use 0 for CH1)
+
+@param fields (table) optional, set of the wanted fields (i.e. `{source=true, weight=true}`).
+All fields are returned when omitted.
+
+@param lines (table) optional table to fill in, usually the one returned by the
+previous call. The mix tables it holds are reused, fields which are not requested
+are left untouched.
+
+@retval table array of mixes, see model.getMix() for the format of each mix
+
+@status current Introduced in 2.10.0
+*/
+static int luaModelGetMixes(lua_State *L)
+{
+  unsigned int chn = luaL_checkunsigned(L, 1);
+  int fields = lua_istable(L, 2) ? 2 : 0;
+  luaBatchResult(L, 3);
+
+  unsigned int count = 0;
+  if (chn < MAX_OUTPUT_CHANNELS) {
+    unsigned int first = getFirstMix(chn);
+    count = getMixesCountFromFirst(chn, first);
+    for (unsigned int i = 0; i < count; i++) {
+      luaBatchItem(L, 3, i + 1);
+      luaPushMix(L, mixAddress(first + i), fields);
+      lua_pop(L, 1);
+    }
+  }
+
+  luaBatchTrim(L, 3, count);
+  return 1;
+}
+
 /*luadoc
 @function model.insertMix(channel, line, value)
 
@@ -987,6 +1134,17 @@ static int luaModelDeleteMixes(lua_State *L)
   return 0;
 }
 
+static void luaPushLogicalSwitch(lua_State * L, const LogicalSwitchData * sw, int fields)
+{
+  if (luaWantField(L, fields, "func")) lua_pushtableinteger(L, "func", sw->func);
+  if (luaWantField(L, fields, "v1")) lua_pushtableinteger(L, "v1", sw->v1);
+  if (luaWantField(L, fields, "v2")) lua_pushtableinteger(L, "v2", sw->v2);
+  if (luaWantField(L, fields, "v3")) lua_pushtableinteger(L, "v3", sw->v3);
+  if (luaWantField(L, fields, "and")) lua_pushtableinteger(L, "and", sw->andsw);
+  if (luaWantField(L, fields, "delay")) lua_pushtableinteger(L, "delay", sw->delay);
+  if (luaWantField(L, fields, "duration")) lua_pushtableinteger(L, "duration", sw->duration);
+}
+
 /*luadoc
 @function model.getLogicalSwitch(switch)
 
@@ -1011,15 +1169,8 @@ static int luaModelGetLogicalSwitch(lua_State *L)
 {
   unsigned int idx = luaL_checkunsigned(L, 1);
   if (idx < MAX_LOGICAL_SWITCHES) {
-    LogicalSwitchData * sw = lswAddress(idx);
     lua_newtable(L);
-    lua_pushtableinteger(L, "func", sw->func);
-    lua_pushtableinteger(L, "v1", sw->v1);
-    lua_pushtableinteger(L, "v2", sw->v2);
-    lua_pushtableinteger(L, "v3", sw->v3);
-    lua_pushtableinteger(L, "and", sw->andsw);
-    lua_pushtableinteger(L, "delay", sw->delay);
-    lua_pushtableinteger(L, "duration", sw->duration);
+    luaPushLogicalSwitch(L, lswAddress(idx), 0);
   }
   else {
     lua_pushnil(L);
@@ -1027,6 +1178,69 @@ static int luaModelGetLogicalSwitch(lua_State *L)
   return 1;
 }
 
+/*luadoc
+@function model.getLogicalSwitches([fields [, switches]])
+
+Get the parameters of all the Logical Switches in one call
+
+@param fields (table) optional, set of the wanted fields (i.e. `{func=true, v1=true}`).
+All fields are returned when omitted.
+
+@param switches (table) optional table to fill in, usually the one returned by the
+previous call. The switch tables it holds are reused, fields which are not requested
+are left untouched.
+
+@retval table array of logical switches (LS1 at index 1), see model.getLogicalSwitch()
+for the format of each switch
+
+@status current Introduced in 2.10.0
+*/
+static int luaModelGetLogicalSwitches(lua_State *L)
+{
+  int fields = lua_istable(L, 1) ? 1 : 0;
+  luaBatchResult(L, 2);
+
+  for (unsigned int i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    luaBatchItem(L, 2, i + 1);
+    luaPushLogicalSwitch(L, lswAddress(i), fields);
+    lua_pop(L, 1);
+  }
+
+  return 1;
+}
+
+// Sets the logical switch from the table on top of the stack
+static void luaSetLogicalSwitch(lua_State * L, LogicalSwitchData * sw)
+{
+  memclear(sw, sizeof(LogicalSwitchData));
+  luaL_checktype(L, -1, LUA_TTABLE);
+  for (lua_pushnil(L); lua_next(L, -2); lua_pop(L, 1)) {
+    luaL_checktype(L, -2, LUA_TSTRING); // key is string
+    const char * key = luaL_checkstring(L, -2);
+    if (!strcmp(key, "func")) {
+      sw->func = luaL_checkinteger(L, -1);
+    }
+    else if (!strcmp(key, "v1")) {
+      sw->v1 = luaL_checkinteger(L, -1);
+    }
+    else if (!strcmp(key, "v2")) {
+      sw->v2 = luaL_checkinteger(L, -1);
+    }
+    else if (!strcmp(key, "v3")) {
+      sw->v3 = luaL_checkinteger(L, -1);
+    }
+    else if (!strcmp(key, "and")) {
+      sw->andsw = luaL_checkinteger(L, -1);
+    }
+    else if (!strcmp(key, "delay")) {
+      sw->delay = luaL_checkinteger(L, -1);
+    }
+    else if (!strcmp(key, "duration")) {
+      sw->duration = luaL_checkinteger(L, -1);
+    }
+  }
+}
+
 /*luadoc
 @function model.setLogicalSwitch(switch, value)
 
@@ -1048,40 +1262,89 @@ static int luaModelSetLogicalSwitch(lua_State *L)
 {
   unsigned int idx = luaL_checkunsigned(L, 1);
   if (idx < MAX_LOGICAL_SWITCHES) {
-    LogicalSwitchData * sw = lswAddress(idx);
-    memclear(sw, sizeof(LogicalSwitchData));
-    luaL_checktype(L, -1, LUA_TTABLE);
-    for (lua_pushnil(L); lua_next(L, -2); lua_pop(L, 1)) {
-      luaL_checktype(L, -2, LUA_TSTRING); // key is string
-      const char * key = luaL_checkstring(L, -2);
-      if (!strcmp(key, "func")) {
-        sw->func = luaL_checkinteger(L, -1);
-      }
-      else if (!strcmp(key, "v1")) {
-        sw->v1 = luaL_checkinteger(L, -1);
-      }
-      else if (!strcmp(key, "v2")) {
-        sw->v2 = luaL_checkinteger(L, -1);
-      }
-      else if (!strcmp(key, "v3")) {
-        sw->v3 = luaL_checkinteger(L, -1);
-      }
-      else if (!strcmp(key, "and")) {
-        sw->andsw = luaL_checkinteger(L, -1);
-      }
-      else if (!strcmp(key, "delay")) {
-        sw->delay = luaL_checkinteger(L, -1);
-      }
-      else if (!strcmp(key, "duration")) {
-        sw->duration = luaL_checkinteger(L, -1);
-      }
-    }
+    luaSetLogicalSwitch(L, lswAddress(idx));
     storageDirty(EE_MODEL);
   }
 
   return 0;
 }
 
+/*luadoc
+@function model.setLogicalSwitches(first, values)
+
+Set the parameters of several consecutive Logical Switches in one call
+
+@param first (unsigned number) first logical switch number (use 0 for LS1)
+
+@param values (table) array of switch parameters, see model.getLogicalSwitch()
+for the format of each switch
+
+@notice The model is marked as modified once, after all the switches are set.
+
+@status current Introduced in 2.10.0
+*/
+static int luaModelSetLogicalSwitches(lua_State *L)
+{
+  unsigned int first = luaL_checkunsigned(L, 1);
+  luaL_checktype(L, 2, LUA_TTABLE);
+  lua_settop(L, 2);
+
+  int count = lua_rawlen(L, 2);
+  bool changed = false;
+  for (int i = 0; i < count && first + i < MAX_LOGICAL_SWITCHES; i++) {
+    lua_rawgeti(L, 2, i + 1);
+    luaSetLogicalSwitch(L, lswAddress(first + i));
+    lua_pop(L, 1);
+    changed = true;
+  }
+
+  if (changed) {
+    storageDirty(EE_MODEL);
+  }
+
+  return 0;
+}
+
+static void luaPushCurve(lua_State * L, unsigned int idx, int fields)
+{
+  CurveHeader & CurveHeader = g_model.curves[idx];
+  if (luaWantField(L, fields, "name")) lua_pushtablenstring(L, "name", CurveHeader.name);
+  if (luaWantField(L, fields, "type")) lua_pushtableinteger(L, "type", CurveHeader.type);
+  if (luaWantField(L, fields, "smooth")) lua_pushtableboolean(L, "smooth", CurveHeader.smooth);
+  if (luaWantField(L, fields, "points")) lua_pushtableinteger(L, "points", CurveHeader.points + 5);
+  int8_t * point = curveAddress(idx);
+  if (luaWantField(L, fields, "y")) {
+    luaBatchSubTable(L, "y");
+    for (int i=0; i < CurveHeader.points + 5; i++) {
+      lua_pushinteger(L, point[i]);
+      lua_rawseti(L, -2, i + 1);
+    }
+    luaBatchTrim(L, -1, CurveHeader.points + 5);
+    lua_pop(L, 1);
+  }
+  if (luaWantField(L, fields, "x")) {
+    if (CurveHeader.type == CURVE_TYPE_CUSTOM) {
+      point += CurveHeader.points + 5;
+      luaBatchSubTable(L, "x");
+      lua_pushinteger(L, -100);
+      lua_rawseti(L, -2, 1);
+      for (int i=0; i < CurveHeader.points + 3; i++) {
+        lua_pushinteger(L, *point++);
+        lua_rawseti(L, -2, i + 2);
+      }
+      lua_pushinteger(L, 100);
+      lua_rawseti(L, -2, CurveHeader.points + 5);
+      luaBatchTrim(L, -1, CurveHeader.points + 5);
+      lua_pop(L, 1);
+    }
+    else {
+      // reused table of a curve which was custom
+      lua_pushnil(L);
+      lua_setfield(L, -2, "x");
+    }
+  }
+}
+
 /*luadoc
 @function model.getCurve(curve)
 
@@ -1112,37 +1375,8 @@ static int luaModelGetCurve(lua_State *L)
 {
   unsigned int idx = luaL_checkunsigned(L, 1);
   if (idx < MAX_CURVES) {
-    CurveHeader & CurveHeader = g_model.curves[idx];
-    lua_newtable(L);
-    lua_pushtablenstring(L, "name", CurveHeader.name);
-    lua_pushtableinteger(L, "type", CurveHeader.type);
-    lua_pushtableboolean(L, "smooth", CurveHeader.smooth);
-    lua_pushtableinteger(L, "points", CurveHeader.points + 5);
-    lua_pushstring(L, "y");
     lua_newtable(L);
-    int8_t * point = curveAddress(idx);
-    for (int i=0; i < CurveHeader.points + 5; i++) {
-      lua_pushinteger(L, i + 1);
-      lua_pushinteger(L, *point++);
-      lua_settable(L, -3);
-    }
-    lua_settable(L, -3);
-    if (CurveHeader.type == CURVE_TYPE_CUSTOM) {
-      lua_pushstring(L, "x");
-      lua_newtable(L);
-      lua_pushinteger(L, 1);
-      lua_pushinteger(L, -100);
-      lua_settable(L, -3);
-      for (int i=0; i < CurveHeader.points + 3; i++) {
-        lua_pushinteger(L, i + 2);
-        lua_pushinteger(L, *point++);
-        lua_settable(L, -3);
-      }
-      lua_pushinteger(L, CurveHeader.points + 5);
-      lua_pushinteger(L, 100);
-      lua_settable(L, -3);
-      lua_settable(L, -3);
-    }
+    luaPushCurve(L, idx, 0);
   }
   else {
     lua_pushnil(L);
@@ -1150,6 +1384,37 @@ static int luaModelGetCurve(lua_State *L)
   return 1;
 }
 
+/*luadoc
+@function model.getCurves([fields [, curves]])
+
+Get the parameters of all the Curves in one call
+
+@param fields (table) optional, set of the wanted fields (i.e. `{name=true, points=true}`).
+All fields are returned when omitted.
+
+@param curves (table) optional table to fill in, usually the one returned by the
+previous call. The curve tables (and their `x` / `y` tables) it holds are reused,
+fields which are not requested are left untouched.
+
+@retval table array of curves (Curve1 at index 1), see model.getCurve() for the
+format of each curve
+
+@status current Introduced in 2.10.0
+*/
+static int luaModelGetCurves(lua_State *L)
+{
+  int fields = lua_istable(L, 1) ? 1 : 0;
+  luaBatchResult(L, 2);
+
+  for (unsigned int i = 0; i < MAX_CURVES; i++) {
+    luaBatchItem(L, 2, i + 1);
+    luaPushCurve(L, i, fields);
+    lua_pop(L, 1);
+  }
+
+  return 1;
+}
+
 /*luadoc
 @function model.setCurve(curve, params)
 
@@ -1764,20 +2029,25 @@ LROT_BEGIN(modellib, NULL, 0)
   LROT_FUNCENTRY( setFlightMode, luaModelSetFlightMode )
   LROT_FUNCENTRY( getInputsCount, luaModelGetInputsCount )
   LROT_FUNCENTRY( getInput, luaModelGetInput )
+  LROT_FUNCENTRY( getInputs, luaModelGetInputs )
   LROT_FUNCENTRY( insertInput, luaModelInsertInput )
   LROT_FUNCENTRY( deleteInput, luaModelDeleteInput )
   LROT_FUNCENTRY( deleteInputs, luaModelDeleteInputs )
   LROT_FUNCENTRY( defaultInputs, luaModelDefaultInputs )
   LROT_FUNCENTRY( getMixesCount, luaModelGetMixesCount )
   LROT_FUNCENTRY( getMix, luaModelGetMix )
+  LROT_FUNCENTRY( getMixes, luaModelGetMixes )
   LROT_FUNCENTRY( insertMix, luaModelInsertMix )
   LROT_FUNCENTRY( deleteMix, luaModelDeleteMix )
   LROT_FUNCENTRY( deleteMixes, luaModelDeleteMixes )
   LROT_FUNCENTRY( getLogicalSwitch, luaModelGetLogicalSwitch )
   LROT_FUNCENTRY( setLogicalSwitch, luaModelSetLogicalSwitch )
+  LROT_FUNCENTRY( getLogicalSwitches, luaModelGetLogicalSwitches )
+  LROT_FUNCENTRY( setLogicalSwitches, luaModelSetLogicalSwitches )
   LROT_FUNCENTRY( getCustomFunction, luaModelGetCustomFunction )
   LROT_FUNCENTRY( setCustomFunction, luaModelSetCustomFunction )
   LROT_FUNCENTRY( getCurve, luaModelGetCurve )
+  LROT_FUNCENTRY( getCurves, luaModelGetCurves )
   LROT_FUNCENTRY( setCurve, luaModelSetCurve )
   LROT_FUNCENTRY( getOutput, luaModelGetOutput )
   LROT_FUNCENTRY( setOutput, luaModelSetOutput )
@@ -34,6 +34,8 @@
 #include "sdcard.h"
 #include "api_filesystem.h"
 #include "switches.h"
+#include "event_trace.h"
+#include "tasks/mixer_task.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -68,6 +70,18 @@ bool    luaLcdAllowed = false;
 ScriptInternalData scriptInternalData[MAX_SCRIPTS];
 ScriptInputsOutputs scriptInputsOutputs[MAX_SCRIPTS];
 
+#if defined(LUA_MODEL_SCRIPTS)
+// Outputs returned during the current pass over the mix scripts, handed to
+// the mixer together once the last mix script has run
+static int16_t luaMixOutputs[MAX_SCRIPTS][MAX_SCRIPT_OUTPUTS];
+static uint16_t luaMixDone = 0;
+static bool luaMixPassOpen = false;
+#if defined(LUA_MIX_SYNC_CYCLES)
+static uint32_t luaMixPassCycle = 0;
+uint16_t luaMixOverruns = 0;
+#endif
+#endif
+
 uint16_t maxLuaInterval = 0;
 uint16_t maxLuaDuration = 0;
 uint8_t instructionsPercent = 0;
@@ -131,6 +145,9 @@ int custom_lua_atpanic(lua_State * L)
 static void luaHook(lua_State * L, lua_Debug *ar)
 {
   if (ar->event == LUA_HOOKCOUNT) {
+    if (luaUsageTick()) {
+      luaL_error(L, "CPU limit");
+    }
     if (get_tmr10ms() - luaCycleStart >= LUA_TASK_PERIOD_TICKS) {
       lua_yield(lsScripts, 0);
     }
@@ -290,16 +307,78 @@ void luaRegisterLibraries(lua_State * L)
 
 #define GC_REPORT_TRESHOLD    (2*1024)
 
+LuaGcStats luaScriptsGcStats;
+#if defined(COLORLCD)
+LuaGcStats luaWidgetsGcStats;
+#endif
+
+static LuaGcStats * luaGetGcStats(lua_State * L)
+{
+#if defined(COLORLCD)
+  if (L == lsWidgets) return &luaWidgetsGcStats;
+#endif
+  return &luaScriptsGcStats;
+}
+
+static void luaUpdateGcStats(lua_State * L, uint16_t t0, uint32_t memBefore, uint16_t steps, bool cycleDone)
+{
+  LuaGcStats * stats = luaGetGcStats(L);
+  uint16_t pause = (uint16_t)(getTmr2MHz() - t0) / 2;
+  uint32_t memAfter = luaGetMemUsed(L);
+  stats->lastPauseUs = pause;
+  if (pause > stats->maxPauseUs) stats->maxPauseUs = pause;
+  stats->steps += steps;
+  if (cycleDone) stats->cycles++;
+  if (memAfter < memBefore) stats->freed += memBefore - memAfter;
+}
+
+static void luaGcError(lua_State * L)
+{
+  // we disable Lua for the rest of the session
+  if (L == lsScripts) luaDisable();
+#if defined(COLORLCD)
+  if (L == lsWidgets) lsWidgets = 0;
+#endif
+}
+
+void luaDoGcBudget(lua_State * L, uint16_t budgetUs)
+{
+  if (!L) return;
+
+  // the 2MHz timer wraps after 32ms
+  budgetUs = min<uint16_t>(budgetUs, 30000);
+
+  PROTECT_LUA() {
+    uint16_t t0 = getTmr2MHz();
+    uint32_t memBefore = luaGetMemUsed(L);
+    uint16_t steps = 0;
+    bool cycleDone = false;
+    do {
+      // a single basic step, true when the cycle is finished
+      cycleDone = lua_gc(L, LUA_GCSTEP, 0);
+      steps++;
+    } while (!cycleDone && (uint16_t)(getTmr2MHz() - t0) < 2 * budgetUs);
+    luaUpdateGcStats(L, t0, memBefore, steps, cycleDone);
+  }
+  else {
+    luaGcError(L);
+  }
+  UNPROTECT_LUA();
+}
+
 void luaDoGc(lua_State * L, bool full)
 {
   if (L) {
     PROTECT_LUA() {
+      uint16_t t0 = getTmr2MHz();
+      uint32_t memBefore = luaGetMemUsed(L);
       if (full) {
         lua_gc(L, LUA_GCCOLLECT, 0);
       }
       else {
         lua_gc(L, LUA_GCSTEP, 10);
       }
+      luaUpdateGcStats(L, t0, memBefore, full ? 0 : 1, full);
 #if defined(DEBUG)
       if (L == lsScripts) {
         static uint32_t lastgcSctipts = 0;
@@ -322,16 +401,91 @@ void luaDoGc(lua_State * L, bool full)
 #endif
     }
     else {
-      // we disable Lua for the rest of the session
-      if (L == lsScripts) luaDisable();
-#if defined(COLORLCD)
-      if (L == lsWidgets) lsWidgets = 0;
-#endif
+      luaGcError(L);
     }
     UNPROTECT_LUA();
   }
 }
 
+LuaScriptUsage * luaRunningUsage = nullptr;
+
+void luaUsageReset(LuaScriptUsage & usage)
+{
+  memclear(&usage, sizeof(usage));
+}
+
+void luaUsageBegin(LuaScriptUsage & usage, uint32_t budgetUs)
+{
+  usage.current = 0;
+  usage.budget = 2 * budgetUs;
+  luaUsageResume(usage);
+}
+
+void luaUsageResume(LuaScriptUsage & usage)
+{
+  usage.mark = getTmr2MHz();
+  luaRunningUsage = &usage;
+}
+
+bool luaUsageTick()
+{
+  LuaScriptUsage * usage = luaRunningUsage;
+  if (!usage) return false;
+
+  // called often enough that the 2MHz timer cannot wrap in between
+  uint16_t now = getTmr2MHz();
+  usage->current += (uint16_t)(now - usage->mark);
+  usage->mark = now;
+  return usage->budget && usage->current > usage->budget;
+}
+
+void luaUsagePause()
+{
+  luaUsageTick();
+  luaRunningUsage = nullptr;
+}
+
+void luaUsageEnd()
+{
+  LuaScriptUsage * usage = luaRunningUsage;
+  if (!usage) return;
+
+  luaUsageTick();
+  uint16_t us = min<uint32_t>(usage->current / 2, UINT16_MAX);
+  usage->lastUs = us;
+  usage->avgUs = usage->runs ? usage->avgUs - usage->avgUs / 8 + us / 8 : us;
+  if (us > usage->peakUs) usage->peakUs = us;
+  if (usage->runs < UINT16_MAX) usage->runs++;
+  luaRunningUsage = nullptr;
+}
+
+LuaWakeup * luaRunningWakeup = nullptr;
+
+bool luaWakeupParked(LuaWakeup & wakeup)
+{
+  if (!wakeup.parked) return false;
+
+  bool wake = wakeup.timeout &&
+              (tmr10ms_t)(get_tmr10ms() - wakeup.start) >= wakeup.timeout;
+  if (!wake && wakeup.telemetry) {
+    wake = telemetryValuesCount != wakeup.telemetryValues ||
+           (luaInputTelemetryFifo && !luaInputTelemetryFifo->isEmpty());
+  }
+  for (uint8_t i = 0; !wake && i < wakeup.sourcesCount; i++) {
+    wake = getValue(wakeup.sources[i]) != wakeup.values[i];
+  }
+
+  if (wake) wakeup.parked = false;
+  return !wake;
+}
+
+uint8_t luaGetCpuUsed(uint8_t idx)
+{
+  const LuaScriptUsage & usage = scriptInternalData[idx].usage;
+  uint32_t limit = usage.budget ? usage.budget / 2 : LUA_TASK_PERIOD_TICKS * 10000;
+  return min<uint32_t>(100 * usage.avgUs / limit, 100);
+}
+
 void luaFree(lua_State * L, ScriptInternalData & sid)
 {
   PROTECT_LUA() {
@@ -371,21 +525,246 @@ static int luaDumpWriter(lua_State * L, const void* p, size_t size, void* u)
   @param stripDebug This is passed directly to luaU_dump()
     1 = remove debug info from bytecode (smaller but errors are less informative)
     0 = keep debug info
+  @retval true if the file was written
 */
-static void luaDumpState(lua_State * L, const char * filename, const FILINFO * finfo, int stripDebug)
+static bool luaDumpState(lua_State * L, const char * filename, const FILINFO * finfo, int stripDebug)
 {
   FIL D;
   if (f_open(&D, filename, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK) {
     lua_lock(L);
-    luaU_dump(L, getproto(L->top - 1), luaDumpWriter, &D, stripDebug);
+    int result = luaU_dump(L, getproto(L->top - 1), luaDumpWriter, &D, stripDebug);
     lua_unlock(L);
-    if (f_close(&D) == FR_OK) {
+    if (f_close(&D) == FR_OK && result == 0) {
       if (finfo != nullptr)
         f_utime(filename, finfo);  // set the file mod time
       TRACE("luaDumpState(%s): Saved bytecode to file.", filename);
+      return true;
     }
   } else
     TRACE_ERROR("luaDumpState(%s): Error: Could not open output file\n", filename);
+  return false;
+}
+
+/*
+  Compile cache manifest
+
+  luaCompileScripts() walks the directories of the scripts loaded at startup and
+  model load, compiles the sources whose bytecode is missing or older, and records
+  the size and date of each source in LUA_COMPILE_CACHE_FILE. The sources checked
+  since the SD card was mounted are marked fresh, and luaLoadScriptFileToState()
+  loads their bytecode without looking at either file first.
+*/
+#define LUA_COMPILE_CACHE_FILE   SCRIPTS_PATH PATH_SEPARATOR "luac.idx"
+#define LUA_COMPILE_CACHE_MAGIC  0x3149434C  // "LCI1"
+#if defined(COLORLCD)
+  #define LUA_COMPILE_CACHE_MAX  128
+#else
+  #define LUA_COMPILE_CACHE_MAX  32
+#endif
+
+struct LuaCompileCacheEntry {
+  uint32_t hash;      // source path, case insensitive
+  uint32_t fsize;     // source size and date when its bytecode was written
+  uint16_t fdate;
+  uint16_t ftime;
+};
+
+static LuaCompileCacheEntry luaCompileCache[LUA_COMPILE_CACHE_MAX];
+static uint32_t luaCompileCacheFresh[(LUA_COMPILE_CACHE_MAX + 31) / 32];
+static uint8_t luaCompileCacheCount = 0;
+static bool luaCompileCacheLoaded = false;
+static bool luaCompileCacheDirty = false;
+
+static uint32_t luaCompileCacheHash(const char * path)
+{
+  // FNV-1a, FatFs names are case insensitive
+  uint32_t hash = 2166136261u;
+  while (*path) {
+    hash = (hash ^ (uint8_t)tolower(*path++)) * 16777619u;
+  }
+  return hash;
+}
+
+static int luaCompileCacheFind(uint32_t hash)
+{
+  for (int i = 0; i < luaCompileCacheCount; i++) {
+    if (luaCompileCache[i].hash == hash)
+      return i;
+  }
+  return -1;
+}
+
+static bool luaCompileCacheIsFresh(int index)
+{
+  return index >= 0 && (luaCompileCacheFresh[index / 32] & (1u << (index % 32)));
+}
+
+static void luaCompileCacheSetFresh(int index)
+{
+  luaCompileCacheFresh[index / 32] |= 1u << (index % 32);
+}
+
+static void luaCompileCacheLoad()
+{
+  FIL file;
+  UINT read;
+  uint32_t header[2];
+
+  luaCompileCacheLoaded = true;
+  luaCompileCacheCount = 0;
+
+  if (f_open(&file, LUA_COMPILE_CACHE_FILE, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return;
+
+  if (f_read(&file, header, sizeof(header), &read) == FR_OK && read == sizeof(header) &&
+      header[0] == LUA_COMPILE_CACHE_MAGIC && header[1] <= LUA_COMPILE_CACHE_MAX) {
+    UINT size = header[1] * sizeof(LuaCompileCacheEntry);
+    if (f_read(&file, luaCompileCache, size, &read) == FR_OK && read == size) {
+      luaCompileCacheCount = header[1];
+    }
+  }
+
+  f_close(&file);
+}
+
+static void luaCompileCacheSave()
+{
+  FIL file;
+  UINT written;
+  uint32_t header[2] = { LUA_COMPILE_CACHE_MAGIC, luaCompileCacheCount };
+
+  luaCompileCacheDirty = false;
+
+  if (f_open(&file, LUA_COMPILE_CACHE_FILE, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) {
+    TRACE_ERROR("luaCompileCacheSave(): Error: Could not open %s\n", LUA_COMPILE_CACHE_FILE);
+    return;
+  }
+
+  f_write(&file, header, sizeof(header), &written);
+  f_write(&file, luaCompileCache, luaCompileCacheCount * sizeof(LuaCompileCacheEntry), &written);
+  f_close(&file);
+}
+
+static void luaCompileCacheSet(uint32_t hash, const FILINFO & source)
+{
+  int index = luaCompileCacheFind(hash);
+  if (index < 0) {
+    if (luaCompileCacheCount < LUA_COMPILE_CACHE_MAX) {
+      index = luaCompileCacheCount++;
+    }
+    else {
+      // reuse an entry which was not seen since the SD card was mounted
+      for (int i = 0; i < LUA_COMPILE_CACHE_MAX && index < 0; i++) {
+        if (!luaCompileCacheIsFresh(i))
+          index = i;
+      }
+      if (index < 0)
+        return;
+    }
+  }
+
+  LuaCompileCacheEntry & entry = luaCompileCache[index];
+  entry.hash = hash;
+  entry.fsize = source.fsize;
+  entry.fdate = source.fdate;
+  entry.ftime = source.ftime;
+  luaCompileCacheSetFresh(index);
+  luaCompileCacheDirty = true;
+}
+
+void luaCompileCacheReset()
+{
+  // the sources may be changed while the SD card is not mounted
+  memclear(luaCompileCacheFresh, sizeof(luaCompileCacheFresh));
+  luaCompileCacheLoaded = false;
+}
+
+// path ends with SCRIPT_EXT, len is its length
+static void luaCompileFile(lua_State * L, char * path, uint16_t len, const FILINFO & source)
+{
+  uint32_t hash = luaCompileCacheHash(path);
+  int index = luaCompileCacheFind(hash);
+  if (index >= 0) {
+    const LuaCompileCacheEntry & entry = luaCompileCache[index];
+    if (entry.fsize == source.fsize && entry.fdate == source.fdate && entry.ftime == source.ftime) {
+      luaCompileCacheSetFresh(index);
+      return;
+    }
+  }
+
+  uint16_t baselen = len - (sizeof(SCRIPT_EXT) - 1);
+  FILINFO binary;
+  strcpy(path + baselen, SCRIPT_BIN_EXT);
+  // same rule as luaLoadScriptFileToState(), the bytecode gets the date of its source
+  bool upToDate = (f_stat(path, &binary) == FR_OK &&
+                   (uint32_t)((binary.fdate << 16) + binary.ftime) >= (uint32_t)((source.fdate << 16) + source.ftime));
+
+  if (!upToDate) {
+    strcpy(path + baselen, SCRIPT_EXT);
+    TRACE("luaCompileFile(%s)", path);
+    if (luaL_loadfilex(L, path, "t") == LUA_OK) {
+      strcpy(path + baselen, SCRIPT_BIN_EXT);
+      upToDate = luaDumpState(L, path, &source, (strchr(LUA_SCRIPT_LOAD_MODE, 'd') ? 0 : 1));
+    }
+    else {
+      TRACE_ERROR("luaCompileFile(%s): Error: %s\n", path, lua_tostring(L, -1));
+    }
+    lua_pop(L, 1);
+  }
+
+  strcpy(path + baselen, SCRIPT_EXT);
+  if (upToDate) {
+    luaCompileCacheSet(hash, source);
+  }
+}
+
+static void luaCompileDirectory(lua_State * L, char * path, uint16_t pathlen, uint8_t depth)
+{
+  DIR dir;
+  FILINFO fno;
+
+  if (f_opendir(&dir, path) != FR_OK)
+    return;
+
+  path[pathlen++] = '/';
+  for (;;) {
+    FRESULT res = f_readdir(&dir, &fno);
+    if (res != FR_OK || fno.fname[0] == 0) break;  // break on error or end of dir
+    if (fno.fname[0] == '.') continue;
+
+    uint16_t len = strlen(fno.fname);
+    if (pathlen + len + sizeof(SCRIPT_BIN_EXT) > LEN_FILE_PATH_MAX + FF_MAX_LFN + 1) continue;
+    memcpy(path + pathlen, fno.fname, len + 1);
+
+    if (fno.fattrib & AM_DIR) {
+      if (depth > 0) {
+        luaCompileDirectory(L, path, pathlen + len, depth - 1);
+      }
+    }
+    else if (isRadioScriptTool(fno.fname)) {
+      luaCompileFile(L, path, pathlen + len, fno);
+    }
+  }
+
+  f_closedir(&dir);
+}
+
+void luaCompileScripts(lua_State * L, const char * directory, uint8_t depth)
+{
+  if (!L || !strchr(LUA_SCRIPT_LOAD_MODE, 'b') || !sdMounted())
+    return;
+
+  if (!luaCompileCacheLoaded) {
+    luaCompileCacheLoad();
+  }
+
+  char path[LEN_FILE_PATH_MAX + FF_MAX_LFN + 1];
+  strcpy(path, directory);
+  luaCompileDirectory(L, path, strlen(path), depth);
+
+  if (luaCompileCacheDirty) {
+    luaCompileCacheSave();
+  }
 }
 #endif  // LUA_COMPILER
 
@@ -453,6 +832,18 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   }
   strncat(filenameFull, filename, fnamelen);
 
+  // source checked by luaCompileScripts(): load its bytecode straight away
+  strcpy(filenameFull + fnamelen, SCRIPT_EXT);
+  if (strchr(lmode, 'b') && !strchr(lmode, 'c') && luaCompileCacheIsFresh(luaCompileCacheFind(luaCompileCacheHash(filenameFull)))) {
+    strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
+    TRACE("luaLoadScriptFileToState(%s, %s): loading %s", filename, lmode, filenameFull);
+    if (luaL_loadfilex(L, filenameFull, nullptr) == LUA_OK) {
+      return SCRIPT_OK;
+    }
+    TRACE_ERROR("luaLoadScriptFileToState(%s, %s): Error loading script: %s\n", filename, lmode, lua_tostring(L, -1));
+    lua_pop(L, 1);
+  }
+
   // check if binary version exists
   strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
   frLuaC = f_stat(filenameFull, &fnoLuaC);
@@ -586,6 +977,8 @@ static const char * getScriptName(uint8_t idx)
 
 static bool luaLoad(const char * pathname, ScriptInternalData & sid)
 {
+  luaUsageReset(sid.usage);
+  memclear(&sid.wakeup, sizeof(sid.wakeup));
   sid.state = luaLoadScriptFileToState(lsScripts, pathname, LUA_SCRIPT_LOAD_MODE);
 
   if (sid.state != SCRIPT_OK) {
@@ -999,6 +1392,69 @@ void luaExec(const char * filename)
   luaLoadScripts(true, filename);
 }
 
+static uint32_t luaScriptBudgetUs(uint8_t ref)
+{
+#if defined(LUA_MODEL_SCRIPTS)
+  if (ref <= SCRIPT_MIX_LAST) return LUA_MIX_BUDGET_US;
+#endif
+  if (ref <= SCRIPT_GFUNC_LAST) return LUA_FUNCTION_BUDGET_US;
+#if defined(PCBTARANIS)
+  if (ref <= SCRIPT_TELEMETRY_LAST) return LUA_TELEMETRY_BUDGET_US;
+#endif
+  return 0;
+}
+
+#if defined(LUA_MODEL_SCRIPTS)
+static void luaMixStartPass()
+{
+#if defined(LUA_MIX_SYNC_CYCLES)
+  // One pass every LUA_MIX_SYNC_CYCLES mixer cycles, on a fixed grid so
+  // that a late pass does not shift the following ones
+  uint32_t cycles = mixerGetCycleCount() - luaMixPassCycle;
+  if (cycles < LUA_MIX_SYNC_CYCLES) {
+    luaMixPassOpen = false;
+    return;
+  }
+  if (luaMixPassCycle && cycles >= 2 * LUA_MIX_SYNC_CYCLES) {
+    uint32_t missed = cycles / LUA_MIX_SYNC_CYCLES - 1;
+    TRACE("Lua mix scripts: %u pass(es) missed", missed);
+    luaMixOverruns += missed;
+  }
+  luaMixPassCycle += cycles - cycles % LUA_MIX_SYNC_CYCLES;
+#endif
+  luaMixPassOpen = true;
+  luaMixDone = 0;
+}
+
+static void luaMixPublish()
+{
+  if (!luaMixPassOpen) return;
+  luaMixPassOpen = false;
+  if (!luaMixDone) return;
+
+  // the mixer sees either all the outputs of a pass or none of them
+  mixerTaskLock();
+  for (uint8_t i = 0; i < MAX_SCRIPTS; i++) {
+    if (luaMixDone & (1 << i)) {
+      ScriptInputsOutputs & sio = scriptInputsOutputs[i];
+      for (uint8_t j = 0; j < sio.outputsCount; j++) {
+        sio.outputs[j].value = luaMixOutputs[i][j];
+      }
+    }
+  }
+  mixerTaskUnlock();
+}
+#endif
+
+// Only background functions can be parked by setWakeup()
+static bool luaScriptCanPark(uint8_t ref)
+{
+#if defined(LUA_MODEL_SCRIPTS)
+  if (ref <= SCRIPT_MIX_LAST) return false;
+#endif
+  return ref != SCRIPT_STANDALONE;
+}
+
 static bool resumeLua(bool init, bool allowLcdUsage)
 {
   static uint8_t idx;
@@ -1024,10 +1480,21 @@ static bool resumeLua(bool init, bool allowLcdUsage)
   } else {
     luaLcdAllowed = allowLcdUsage;
   }
+
+#if defined(LUA_MODEL_SCRIPTS)
+  if (!allowLcdUsage && idx == 0 && lua_status(lsScripts) == LUA_OK) {
+    luaMixStartPass();
+  }
+#endif
   
   for (; idx < luaScriptsCount; idx++) {
     ScriptInternalData & sid = scriptInternalData[idx];
     uint8_t ref = sid.reference;
+
+#if defined(LUA_MODEL_SCRIPTS)
+    // mix scripts come first: the pass is over
+    if (ref > SCRIPT_MIX_LAST) luaMixPublish();
+#endif
     
     if (sid.state != SCRIPT_OK) {
       displayLuaError();
@@ -1078,6 +1545,7 @@ static bool resumeLua(bool init, bool allowLcdUsage)
       else {
 #if defined(LUA_MODEL_SCRIPTS)
         if (ref <= SCRIPT_MIX_LAST) {
+          if (!luaMixPassOpen) continue;
           lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.run);
          
           ScriptData & sd = g_model.scriptsData[ref - SCRIPT_MIX_FIRST];
@@ -1116,12 +1584,14 @@ static bool resumeLua(bool init, bool allowLcdUsage)
           }
           else {
             if (sid.background == LUA_NOREF) continue;
+            if (luaWakeupParked(sid.wakeup)) continue;
             lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.background);
           }
         }
 #if defined(PCBTARANIS)
         else if (ref <= SCRIPT_TELEMETRY_LAST) {
           if (sid.background == LUA_NOREF) continue;
+          if (luaWakeupParked(sid.wakeup)) continue;
           lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.background);
         }
 #endif
@@ -1134,19 +1604,29 @@ static bool resumeLua(bool init, bool allowLcdUsage)
     fullGC = false;
 
     // Resume running the coroutine
+    if (luaStatus == LUA_OK)
+      luaUsageBegin(sid.usage, luaScriptBudgetUs(ref));
+    else
+      luaUsageResume(sid.usage);
+    luaRunningWakeup = luaScriptCanPark(ref) ? &sid.wakeup : nullptr;
     luaStatus = lua_resume(lsScripts, 0, inputsCount);
+    luaRunningWakeup = nullptr;
 
     if (luaStatus == LUA_YIELD) {
       // Coroutine yielded - wait for the next cycle
+      luaUsagePause();
       return scriptWasRun;
     }
-    else if (luaStatus == LUA_OK) {
+
+    luaUsageEnd();
+    if (luaStatus == LUA_OK) {
       // Coroutine returned
       scriptWasRun = true;
       
 #if defined(LUA_MODEL_SCRIPTS)
       if (ref <= SCRIPT_MIX_LAST) {
-        ScriptInputsOutputs * sio = & scriptInputsOutputs[ref - SCRIPT_MIX_FIRST];
+        uint8_t mixIdx = ref - SCRIPT_MIX_FIRST;
+        ScriptInputsOutputs * sio = & scriptInputsOutputs[mixIdx];
         lua_settop(lsScripts, sio -> outputsCount);
 
         for (int j = sio -> outputsCount - 1; j >= 0; j--) {
@@ -1156,9 +1636,10 @@ static bool resumeLua(bool init, bool allowLcdUsage)
             luaError(lsScripts, sid.state);
             break;
           }
-          sio -> outputs[j].value = lua_tointeger(lsScripts, -1);
+          luaMixOutputs[mixIdx][j] = lua_tointeger(lsScripts, -1);
           lua_pop(lsScripts, 1);
         }
+        if (sid.state == SCRIPT_OK) luaMixDone |= 1 << mixIdx;
       } else
 #endif
       if (ref == SCRIPT_STANDALONE) {
@@ -1226,6 +1707,10 @@ static bool resumeLua(bool init, bool allowLcdUsage)
     
     scriptWasRun = true;
   } // for
+
+#if defined(LUA_MODEL_SCRIPTS)
+  luaMixPublish();
+#endif
  
   // Start a new cycle
   idx = 0;
@@ -1238,6 +1723,8 @@ bool luaTask(event_t evt, bool allowLcdUsage)
 {
   bool init = false;
   bool scriptWasRun = false;
+  uint16_t t0 = getTmr2MHz();
+  EVENT_TRACE_SCOPE(EVENT_TRACE_LUA_BEGIN, EVENT_TRACE_LUA_END, 0);
  
   // Add event to buffer
   if (evt != 0) { luaPushEvent(evt); }
@@ -1280,6 +1767,19 @@ bool luaTask(event_t evt, bool allowLcdUsage)
       else luaDisable();
       UNPROTECT_LUA();
   }
+
+  // incremental GC in what is left of the time slot
+  uint16_t elapsed = (uint16_t)(getTmr2MHz() - t0) / 2;
+  if (luaState == INTERPRETER_RUNNING && elapsed + LUA_GC_MIN_BUDGET_US < LUA_GC_SLOT_US) {
+    luaDoGcBudget(lsScripts, LUA_GC_SLOT_US - elapsed);
+  }
+#if defined(COLORLCD)
+  elapsed = (uint16_t)(getTmr2MHz() - t0) / 2;
+  if (lsWidgets && elapsed + LUA_GC_MIN_BUDGET_US < LUA_GC_SLOT_US) {
+    luaDoGcBudget(lsWidgets, LUA_GC_SLOT_US - elapsed);
+  }
+#endif
+
   return scriptWasRun;
 }
 
@@ -1342,6 +1842,9 @@ void luaInit()
       // Clear loaded scripts
       memclear(scriptInternalData, sizeof(scriptInternalData));
       memclear(scriptInputsOutputs, sizeof(scriptInputsOutputs));
+#if defined(LUA_MODEL_SCRIPTS)
+      luaMixPassOpen = false;
+#endif
       luaScriptsCount = 0;
 
       // protect libs and constants registration
@@ -1355,6 +1858,16 @@ void luaInit()
       }
       UNPROTECT_LUA();
       TRACE("lsScripts %p", lsScripts);
+
+#if defined(LUA_COMPILER)
+      if (luaState != INTERPRETER_PANIC) {
+#if defined(LUA_MODEL_SCRIPTS)
+        luaCompileScripts(lsScripts, SCRIPTS_MIXES_PATH, 0);
+#endif
+        luaCompileScripts(lsScripts, SCRIPTS_FUNCS_PATH, 0);
+        luaCompileScripts(lsScripts, SCRIPTS_TELEM_PATH, 0);
+      }
+#endif
     }
     else {
       /* log error and return */
@@ -48,13 +48,38 @@ extern "C" {
 #endif
 
 // LUA serial connection
-#define LUA_FIFO_SIZE 256
+#if !defined(LUA_FIFO_SIZE)
+  #if defined(COLORLCD)
+    #define LUA_FIFO_SIZE 1024
+  #else
+    #define LUA_FIFO_SIZE 256
+  #endif
+#endif
 void luaAllocRxFifo();
 void luaFreeRxFifo();
 void luaReceiveData(uint8_t* buf, uint32_t len);
 
 void luaSetSendCb(void* ctx, void (*cb)(void*, uint8_t));
 void luaSetGetSerialByte(void* ctx, int (*fct)(void*, uint8_t*));
+void luaSetSerialRxSpan(void* ctx, uint32_t (*getRxSpan)(void*, const uint8_t**),
+                        void (*consumeRx)(void*, uint32_t));
+
+// Shared rings of typed records (shmRing* functions), each with a single
+// producer and a single consumer: between Lua states, from Lua to a GVar
+// (one record per mixer cycle) or from a source to Lua (one per cycle)
+#if !defined(LUA_SHM_RINGS)
+  #if defined(COLORLCD)
+    #define LUA_SHM_RINGS       4
+    #define LUA_SHM_RING_SIZE   64
+  #else
+    #define LUA_SHM_RINGS       2
+    #define LUA_SHM_RING_SIZE   32
+  #endif
+#endif
+
+// in the mixer task, before and after the mixes are evaluated
+void luaShmPopGVars();
+void luaShmPushSources();
 
 extern lua_State * lsScripts;
 
@@ -157,12 +182,70 @@ enum ScriptReference {
   SCRIPT_STANDALONE                                              // Standalone script
 };
 
+// Execution time of one script, measured in 2MHz ticks while it runs
+struct LuaScriptUsage {
+  uint32_t current;        // ticks spent in the current run, across yields
+  uint32_t budget;         // ticks allowed per run, 0 for no limit
+  uint16_t mark;
+  uint16_t lastUs;
+  uint16_t avgUs;          // rolling average (1/8 weight for the last run)
+  uint16_t peakUs;
+  uint16_t runs;
+};
+
+void luaUsageBegin(LuaScriptUsage & usage, uint32_t budgetUs);
+void luaUsageResume(LuaScriptUsage & usage);
+bool luaUsageTick();       // from the hooks, true when over budget
+void luaUsagePause();      // the run yielded, it will be resumed later
+void luaUsageEnd();
+void luaUsageReset(LuaScriptUsage & usage);
+extern LuaScriptUsage * luaRunningUsage;
+
+// Per run time budgets (us), 0 for no limit. The scripts run in luaTask() are
+// preempted at the end of each cycle anyway, so by default only widgets (which
+// cannot be preempted) are limited. Stay below 32ms, the 2MHz timer wraps.
+#if !defined(LUA_MIX_BUDGET_US)
+  #if defined(LUA_MIX_SYNC_CYCLES)
+    #define LUA_MIX_BUDGET_US       2000
+  #else
+    #define LUA_MIX_BUDGET_US       0
+  #endif
+#endif
+#if !defined(LUA_FUNCTION_BUDGET_US)
+  #define LUA_FUNCTION_BUDGET_US    0
+#endif
+#if !defined(LUA_TELEMETRY_BUDGET_US)
+  #define LUA_TELEMETRY_BUDGET_US   0
+#endif
+#if !defined(LUA_WIDGET_BUDGET_US)
+  #define LUA_WIDGET_BUDGET_US      20000
+#endif
+
+// What a script parked with setWakeup() waits for
+#define LUA_WAKEUP_MAX_SOURCES  4
+
+struct LuaWakeup {
+  bool parked;
+  bool telemetry;          // new sensor values or frames queued for Lua
+  uint8_t sourcesCount;
+  uint16_t timeout;        // 10ms, 0 for none
+  tmr10ms_t start;
+  uint32_t telemetryValues;
+  mixsrc_t sources[LUA_WAKEUP_MAX_SOURCES];
+  getvalue_t values[LUA_WAKEUP_MAX_SOURCES];
+};
+
+// true while none of the conditions is met, the script is unparked otherwise
+bool luaWakeupParked(LuaWakeup & wakeup);
+extern LuaWakeup * luaRunningWakeup;  // the script that may be parked, if any
+
 struct ScriptInternalData {
   uint8_t reference;
   uint8_t state;
   int run;
   int background;
-  uint8_t instructions;
+  LuaScriptUsage usage;
+  LuaWakeup wakeup;
 };
 
 struct ScriptInputsOutputs {
@@ -188,16 +271,44 @@ extern bool    luaLcdAllowed;
 extern ScriptInternalData scriptInternalData[MAX_SCRIPTS];
 extern ScriptInputsOutputs scriptInputsOutputs[MAX_SCRIPTS];
 
+#if defined(LUA_MIX_SYNC_CYCLES)
+// Mix script passes started late, or still running when the next one was due
+extern uint16_t luaMixOverruns;
+#endif
+
 void luaClose(lua_State ** L);
 bool luaTask(event_t evt, bool allowLcdUsage);
 void checkLuaMemoryUsage();
 void luaExec(const char * filename);
 void luaDoGc(lua_State * L, bool full);
+
+// Time given to Lua by each luaTask() call, the GC steps run in the slack
+#define LUA_GC_SLOT_US         2000
+#define LUA_GC_MIN_BUDGET_US   100
+
+struct LuaGcStats {
+  uint32_t steps;
+  uint32_t cycles;         // completed collections
+  uint32_t freed;          // bytes
+  uint16_t lastPauseUs;
+  uint16_t maxPauseUs;
+};
+
+extern LuaGcStats luaScriptsGcStats;
+#if defined(COLORLCD)
+extern LuaGcStats luaWidgetsGcStats;
+extern uint16_t luaWidgetsMaxUs;  // longest widget call
+extern uint32_t luaWidgetsCachedPaints;  // paints served from a cached surface
+#endif
+
+// GC steps until the cycle is done or budgetUs is spent
+void luaDoGcBudget(lua_State * L, uint16_t budgetUs);
 uint32_t luaGetMemUsed(lua_State * L);
 void luaGetValueAndPush(lua_State * L, int src);
 bool isTelemetryScriptAvailable();
 
-#define luaGetCpuUsed(idx) scriptInternalData[idx].instructions
+// Average run time in percent of the budget, or of the Lua task period
+uint8_t luaGetCpuUsed(uint8_t idx);
 #define LUA_LOAD_MODEL_SCRIPTS()   luaState = INTERPRETER_RELOAD_PERMANENT_SCRIPTS
 #define LUA_LOAD_MODEL_SCRIPT(idx) luaState = INTERPRETER_RELOAD_PERMANENT_SCRIPTS
 
@@ -235,6 +346,11 @@ void luaRegisterLibraries(lua_State * L);
 void registerBitmapClass(lua_State * L);
 void luaSetInstructionsLimit(lua_State* L, int count);
 int luaLoadScriptFileToState(lua_State * L, const char * filename, const char * mode);
+#if defined(LUA_COMPILER)
+// Compiles the outdated sources in directory (and depth levels of sub-directories)
+void luaCompileScripts(lua_State * L, const char * directory, uint8_t depth);
+void luaCompileCacheReset();
+#endif
 void luaPushDateTime(lua_State * L, uint32_t year, uint32_t mon, uint32_t day,
                             uint32_t hour, uint32_t min, uint32_t sec);
 
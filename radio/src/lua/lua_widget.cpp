@@ -26,6 +26,8 @@
 #include "lua_event.h"
 #include "draw_functions.h"
 #include "touch.h"
+#include "LvglWrapper.h"
+#include "power_governor.h"
 
 #define MAX_INSTRUCTIONS       (20000/100)
 
@@ -210,6 +212,40 @@ LuaWidget::~LuaWidget()
   luaL_unref(lsWidgets, LUA_REGISTRYINDEX, luaWidgetDataRef);
   luaL_unref(lsWidgets, LUA_REGISTRYINDEX, zoneRectDataRef);
   free(errorMessage);
+  delete surface;
+}
+
+bool LuaWidget::isCached() const
+{
+  return ((LuaWidgetFactory*)factory)->cached && !fullscreen && !errorMessage;
+}
+
+// Keeps what refresh() just drew (over the already painted background),
+// provided the whole widget was inside the area being drawn
+void LuaWidget::captureSurface(BitmapBuffer* dc)
+{
+  coord_t x = dc->getOffsetX();
+  coord_t y = dc->getOffsetY();
+  coord_t xmin, xmax, ymin, ymax;
+  dc->getClippingRect(xmin, xmax, ymin, ymax);
+  if (x < xmin || y < ymin || x + rect.w > xmax || y + rect.h > ymax) return;
+
+  if (surface && (surface->width() != rect.w || surface->height() != rect.h)) {
+    delete surface;
+    surface = nullptr;
+  }
+  if (!surface) {
+    surface = new BitmapBuffer(BMP_RGB565, rect.w, rect.h);
+    if (!surface->getData()) {
+      // not enough memory: keep refreshing the usual way
+      delete surface;
+      surface = nullptr;
+      return;
+    }
+  }
+
+  surface->drawBitmap(0, 0, dc, x, y, rect.w, rect.h);
+  surfaceValid = true;
 }
 
 void LuaWidget::onClicked()
@@ -236,6 +272,27 @@ void LuaWidget::checkEvents()
 {
   Widget::checkEvents();
 
+  // display dark: run the widget as when it is not visible
+  if (powerSaveActive()) {
+    runBackground();
+    return;
+  }
+
+  // low priority: while the display runs over its frame budget, wait
+  // for the next frame to be rendered before running the widget again
+  auto lvgl = LvglWrapper::instance();
+  if (lvgl->isOverBudget() && lvgl->getFrameCount() == lastFrame) return;
+  lastFrame = lvgl->getFrameCount();
+
+  if (isCached()) {
+    // redrawn only when background() returns true
+    if (runBackground() || !surfaceValid) {
+      surfaceValid = false;
+      invalidate();
+    }
+    return;
+  }
+
   // paint has not been called
   if (!refreshed) {
     background();
@@ -250,6 +307,20 @@ void LuaWidget::checkEvents()
 #endif
 }
 
+uint16_t luaWidgetsMaxUs = 0;
+uint32_t luaWidgetsCachedPaints = 0;
+
+static void luaWidgetBegin(LuaScriptUsage& usage)
+{
+  luaUsageBegin(usage, LUA_WIDGET_BUDGET_US);
+}
+
+static void luaWidgetEnd(LuaScriptUsage& usage)
+{
+  luaUsageEnd();
+  if (usage.lastUs > luaWidgetsMaxUs) luaWidgetsMaxUs = usage.lastUs;
+}
+
 static void l_pushtableint(const char * key, int value)
 {
   lua_pushstring(lsWidgets, key);
@@ -260,7 +331,8 @@ static void l_pushtableint(const char * key, int value)
 void LuaWidget::update()
 {
   Widget::update();
-  
+  surfaceValid = false;
+
   if (lsWidgets == 0 || errorMessage) return;
   LuaWidgetFactory * lua_factory = (LuaWidgetFactory *)factory;
 
@@ -286,9 +358,11 @@ void LuaWidget::update()
     }
   }
 
+  luaWidgetBegin(usage);
   if (lua_pcall(lsWidgets, 2, 0, 0) != 0) {
     setErrorMessage("update()");
   }
+  luaWidgetEnd(usage);
 }
 
 // Update table on top of Lua stack - set entry with name 'idx' to value 'val'
@@ -340,6 +414,8 @@ void LuaWidget::updateZoneRect(rect_t rect)
 
 void LuaWidget::onFullscreen(bool enable)
 {
+  surfaceValid = false;
+
   if (enable) {
     setupHandler(this);
   } else {
@@ -379,6 +455,13 @@ void LuaWidget::refresh(BitmapBuffer* dc)
     return;
   }
 
+  bool cached = isCached();
+  if (cached && surfaceValid) {
+    dc->drawBitmap(0, 0, surface);
+    luaWidgetsCachedPaints++;
+    return;
+  }
+
   luaSetInstructionsLimit(lsWidgets, MAX_INSTRUCTIONS);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->refreshFunction);
@@ -409,34 +492,55 @@ void LuaWidget::refresh(BitmapBuffer* dc)
   luaLcdAllowed = true;
   runningFS = this;
 
+  luaWidgetBegin(usage);
   if (lua_pcall(lsWidgets, 3, 0, 0) != 0) {
     setErrorMessage("refresh()");
   }
+  luaWidgetEnd(usage);
   runningFS = nullptr;
   // Remove LCD
   luaLcdAllowed = lla;
   luaLcdBuffer = nullptr;
 
+  if (cached && !errorMessage) captureSurface(dc);
+
   // mark as refreshed
   refreshed = true;
 }
 
 void LuaWidget::background()
 {
-  if (lsWidgets == 0 || errorMessage) return;
+  runBackground();
+}
+
+// Returns true when the (cached) widget asks to be redrawn
+bool LuaWidget::runBackground()
+{
+  if (lsWidgets == 0 || errorMessage) return false;
+  if (luaWakeupParked(wakeup)) return false;
 
   // TRACE("LuaWidget::background()");
+  bool redraw = false;
   luaSetInstructionsLimit(lsWidgets, MAX_INSTRUCTIONS);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   if (factory->backgroundFunction) {
     lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->backgroundFunction);
     lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, luaWidgetDataRef);
     runningFS = this;
-    if (lua_pcall(lsWidgets, 1, 0, 0) != 0) {
+    luaRunningWakeup = &wakeup;
+    luaWidgetBegin(usage);
+    if (lua_pcall(lsWidgets, 1, 1, 0) != 0) {
       setErrorMessage("background()");
     }
+    else {
+      redraw = lua_toboolean(lsWidgets, -1);
+    }
+    lua_pop(lsWidgets, 1);
+    luaWidgetEnd(usage);
+    luaRunningWakeup = nullptr;
     runningFS = nullptr;
   }
+  return redraw;
 }
 
 void LuaWidget::onEvent(event_t event)
@@ -63,6 +63,18 @@ class LuaWidget : public Widget, public LuaEventHandler
   int zoneRectDataRef;
   char* errorMessage;
   bool refreshed = false;
+  uint32_t lastFrame = 0;
+  LuaScriptUsage usage = {};
+  LuaWakeup wakeup = {};
+
+  // Off-screen copy of the last refresh() output (widgets declared with
+  // 'cached = true'), painted back until the widget asks for a redraw
+  BitmapBuffer* surface = nullptr;
+  bool surfaceValid = false;
+
+  bool isCached() const;
+  void captureSurface(BitmapBuffer* dc);
+  bool runBackground();
 
   // Window interface
   void onClicked() override;
@@ -97,4 +109,6 @@ class LuaWidget : public Widget, public LuaEventHandler
 
   // Calls LUA widget 'refresh' method
   void refresh(BitmapBuffer* dc) override;
+
+  const LuaScriptUsage& getUsage() const { return usage; }
 };
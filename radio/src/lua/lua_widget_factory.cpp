@@ -40,7 +40,8 @@ LuaWidgetFactory::LuaWidgetFactory(const char* name, ZoneOption* widgetOptions,
     updateFunction(0),
     refreshFunction(0),
     backgroundFunction(0),
-    translateFunction(0)
+    translateFunction(0),
+    cached(false)
 {
 }
 
@@ -47,4 +47,7 @@ class LuaWidgetFactory : public WidgetFactory
   int refreshFunction;
   int backgroundFunction;
   int translateFunction;
+
+  // refresh() output is kept in an off-screen surface
+  bool cached;
 };
@@ -48,6 +48,7 @@ static void luaHook(lua_State *L, lua_Debug *ar)
 {
   if (ar->event == LUA_HOOKCOUNT) {
     instructionsPercent++;
+    bool overBudget = luaUsageTick();
 #if defined(DEBUG)
     // Disable Lua script instructions limit in DEBUG mode,
     // just report max value reached
@@ -60,8 +61,13 @@ static void luaHook(lua_State *L, lua_Debug *ar)
     } else if (instructionsPercent < 10) {
       max = 0;
     }
+    if (overBudget) {
+      // report once per call
+      TRACE("LUA widget over %uus budget", (uint32_t)LUA_WIDGET_BUDGET_US);
+      luaRunningUsage->budget = 0;
+    }
 #else
-    if (instructionsPercent > 100) {
+    if (instructionsPercent > 100 || overBudget) {
       // From now on, as soon as a line is executed, error
       // keep erroring until you're script reaches the top
       lua_sethook(L, luaHook, LUA_MASKLINE, 0);
@@ -219,6 +225,7 @@ void luaLoadWidgetCallback()
 
   int widgetOptions = 0, createFunction = 0, updateFunction = 0,
       refreshFunction = 0, backgroundFunction = 0, translateFunction = 0;
+  bool cached = false;
 
   luaL_checktype(lsWidgets, -1, LUA_TTABLE);
 
@@ -251,6 +258,9 @@ void luaLoadWidgetCallback()
       translateFunction = luaL_ref(lsWidgets, LUA_REGISTRYINDEX);
       lua_pushnil(lsWidgets);
     }
+    else if (!strcmp(key, "cached")) {
+      cached = lua_toboolean(lsWidgets, -1);
+    }
   }
 
   if (name && createFunction) {
@@ -261,6 +271,7 @@ void luaLoadWidgetCallback()
       factory->refreshFunction = refreshFunction;
       factory->backgroundFunction = backgroundFunction;   // NOSONAR
       factory->translateFunction = translateFunction;
+      factory->cached = cached;
       factory->translateOptions(options);
       TRACE("Loaded Lua widget %s", name);
     }
@@ -367,6 +378,9 @@ void luaInitThemesAndWidgets()
     }
     UNPROTECT_LUA();
     TRACE("lsWidgets %p", lsWidgets);
+#if defined(LUA_COMPILER)
+    luaCompileScripts(lsWidgets, WIDGETS_PATH, 1);
+#endif
     luaLoadFiles(WIDGETS_PATH, luaLoadWidgetCallback);
     luaDoGc(lsWidgets, true);
   }
@@ -61,9 +61,26 @@
 
 #else       /*LV_MEM_CUSTOM*/
     #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
+  #if defined(SIMU) || defined(BOOT)
     #define LV_MEM_CUSTOM_ALLOC   malloc
     #define LV_MEM_CUSTOM_FREE    free
     #define LV_MEM_CUSTOM_REALLOC realloc
+  #else
+    /*malloc() wrappers accounting the heap used by LVGL (opentx.cpp)*/
+    #include <stddef.h>
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+    void * lvMemAlloc(size_t size);
+    void lvMemFree(void * ptr);
+    void * lvMemRealloc(void * ptr, size_t size);
+    #ifdef __cplusplus
+    }
+    #endif
+    #define LV_MEM_CUSTOM_ALLOC   lvMemAlloc
+    #define LV_MEM_CUSTOM_FREE    lvMemFree
+    #define LV_MEM_CUSTOM_REALLOC lvMemRealloc
+  #endif
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
@@ -21,11 +21,15 @@
 
 #include "opentx.h"
 #include "hal/adc_driver.h"
+#include "tasks.h"
+#include "tasks/storage_task.h"
+#include "storage/modelslist.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
   #include "gui/colorlcd/LvglWrapper.h"
   #include "gui/colorlcd/view_main.h"
+  #include "gui/colorlcd/bitmap_cache.h"
 #endif
 
 #if defined(CLI)
@@ -159,6 +163,8 @@ void handleUsbConnection()
 
       if (getSelectedUsbMode() == USB_MASS_STORAGE_MODE) {
         opentxClose(false);
+        // MSC_BOT_Data lives in reusableBuffer
+        reusableBufferAcquire(REUSABLE_BUFFER_MSC);
       }
 #if defined(USB_SERIAL)
       else if (getSelectedUsbMode() == USB_SERIAL_MODE) {
@@ -175,6 +181,7 @@ void handleUsbConnection()
     usbStop();
     TRACE("USB stopped");
     if (getSelectedUsbMode() == USB_MASS_STORAGE_MODE) {
+      reusableBufferRelease(REUSABLE_BUFFER_MSC);
       opentxResume();
       pushEvent(EVT_ENTRY);
     } else if (getSelectedUsbMode() == USB_SERIAL_MODE) {
@@ -288,6 +295,11 @@ void checkEeprom()
   if (TIME_TO_WRITE()) {
     storageCheck(false);
   }
+#if defined(STORAGE_TASK)
+  if (storageTaskWritten() & EE_MODEL) {
+    modelslist.updateCurrentModelCell();
+  }
+#endif
 }
 #endif
 
@@ -376,6 +388,8 @@ void guiMain(event_t evt)
 
   LvglWrapper::instance()->run();
   MainWindow::instance()->run();
+  bitmapCacheWakeup();
+  screenshotWakeup();
 
   bool mainViewRequested = (mainRequestFlags & (1u << REQUEST_MAIN_VIEW));
   if (mainViewRequested) {
@@ -507,6 +521,8 @@ void perMain()
     #endif
   }
 
+  LOG_TELEMETRY_FLUSH();
+
   handleUsbConnection();
 
 #if defined(PCBXLITES)
@@ -515,6 +531,7 @@ void perMain()
 
   checkTrainerSettings();
   periodicTick();
+  memoryStatsWakeup();
   DEBUG_TIMER_STOP(debugTimerPerMain1);
 
   if (mainRequestFlags & (1u << REQUEST_FLIGHT_RESET)) {
@@ -541,6 +558,8 @@ void perMain()
     sdMount();
   }
 
+  sdFreeSpaceWakeup();
+
 #if !defined(EEPROM)
   // In case the SD card is removed during the session
   if ((!usbPlugged() || (getSelectedUsbMode() == USB_UNSELECTED_MODE))
@@ -151,7 +151,40 @@ int expo(int x, int k)
   return neg ? -y : y;
 }
 
-void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue)
+// Inputs read by the mixer itself (mix lines and swash). The inactive
+// flight modes evaluated during a fade only need these ones: the other
+// inputs are left to the flight mode in use.
+static uint32_t mixerInputs;
+static uint16_t mixerInputsRevision;
+static bool mixerInputsValid = false;
+
+static inline void addMixerInput(mixsrc_t source)
+{
+  if (source >= MIXSRC_FIRST_INPUT && source <= MIXSRC_LAST_INPUT)
+    mixerInputs |= (uint32_t)1 << (source - MIXSRC_FIRST_INPUT);
+}
+
+static uint32_t getMixerInputs()
+{
+  if (mixerInputsValid && mixerInputsRevision == modelDataRevision)
+    return mixerInputs;
+
+  mixerInputs = 0;
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    addMixerInput(mixAddress(i)->srcRaw);
+  }
+#if defined(HELI)
+  addMixerInput(g_model.swashR.collectiveSource);
+  addMixerInput(g_model.swashR.aileronSource);
+  addMixerInput(g_model.swashR.elevatorSource);
+#endif
+
+  mixerInputsRevision = modelDataRevision;
+  mixerInputsValid = true;
+  return mixerInputs;
+}
+
+void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue, uint32_t inputs)
 {
   int8_t cur_chn = -1;
 
@@ -161,6 +194,8 @@ void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue
     if (!EXPO_VALID(ed)) break; // end of list
     if (ed->chn == cur_chn)
       continue;
+    if (!(inputs & ((uint32_t)1 << ed->chn)))
+      continue;
     if (ed->flightModes & (1<<mixerCurrentFlightMode))
       continue;
     if (ed->srcRaw >= MIXSRC_FIRST_TRAINER && ed->srcRaw <= MIXSRC_LAST_TRAINER && !is_trainer_connected())
@@ -222,12 +257,101 @@ void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue
 // a bulletproof implementation would take about additional 100bytes flash
 // therefore with go with this compromize, interested people could activate this define
 
-// @@@2 open.20.fsguruh ;
+// Key of the caches holding GVar-resolved values: streamed GVars
+// change the values without marking the model dirty
+static inline uint32_t mixerCacheRevision()
+{
+  return modelDataRevision + ((uint32_t)modelRuntimeRevision << 16);
+}
+
+// Output stage of each channel, resolved from LimitData (GVars included)
+// once per model revision and flight mode, so that the per-cycle pass over
+// the channels is only a few multiplications and clamps
+struct OutputPlan {
+  int16_t ofs[MAX_OUTPUT_CHANNELS];       // subtrim, within min / max
+  int16_t minValue[MAX_OUTPUT_CHANNELS];
+  int16_t maxValue[MAX_OUTPUT_CHANNELS];
+  int16_t posScale[MAX_OUTPUT_CHANNELS];  // range above the subtrim
+  int16_t negScale[MAX_OUTPUT_CHANNELS];  // range below the subtrim
+  int8_t curve[MAX_OUTPUT_CHANNELS];
+  bitfield_channels_t curves;
+  bitfield_channels_t revert;
+  uint32_t revision;
+  uint8_t flightMode;
+  bool valid;
+};
+
+static OutputPlan outputPlan;
+
+// The +/-RESX input clamp is a power of 2: a single saturation
+#if defined(__ARM_FEATURE_DSP) && !defined(SIMU)
+  #define OUTPUT_CLAMP_INPUT(v) __SSAT((v), 19)
+#else
+  #define OUTPUT_CLAMP_INPUT(v) limit<int32_t>(-RESXl*256, (v), RESXl*256-1)
+#endif
+
+static void checkOutputPlan()
+{
+  if (outputPlan.valid && outputPlan.revision == mixerCacheRevision() &&
+      outputPlan.flightMode == mixerCurrentFlightMode) {
+    return;
+  }
+
+  outputPlan.curves = 0;
+  outputPlan.revert = 0;
+
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    LimitData * lim = limitAddress(i);
+    int16_t ofs   = LIMIT_OFS_RESX(lim);
+    int16_t lim_p = LIMIT_MAX_RESX(lim);
+    int16_t lim_n = LIMIT_MIN_RESX(lim);
+
+    if (ofs > lim_p) ofs = lim_p;
+    if (ofs < lim_n) ofs = lim_n;
+
+    outputPlan.ofs[i] = ofs;
+    outputPlan.minValue[i] = lim_n;
+    outputPlan.maxValue[i] = lim_p;
+#if defined(PPM_LIMITS_SYMETRICAL)
+    if (lim->symetrical) {
+      outputPlan.posScale[i] = lim_p;
+      outputPlan.negScale[i] = -lim_n;
+    }
+    else
+#endif
+    {
+      outputPlan.posScale[i] = lim_p - ofs;
+      outputPlan.negScale[i] = -lim_n + ofs;
+    }
+
+    outputPlan.curve[i] = lim->curve;
+    if (lim->curve) outputPlan.curves |= (bitfield_channels_t)1 << i;
+    if (lim->revert) outputPlan.revert |= (bitfield_channels_t)1 << i;
+  }
+
+  outputPlan.revision = mixerCacheRevision();
+  outputPlan.flightMode = mixerCurrentFlightMode;
+  outputPlan.valid = true;
+}
+
+// Curves work on -RESX..RESX: they are interpolated between the two
+// steps around the value, which keeps the 1/256 precision of the mixer
+static int32_t applyOutputCurve(int32_t value, int8_t curve)
+{
+  uint8_t idx = (curve > 0 ? curve : -curve) - 1;
+  if (curve < 0) value = -value;
+
+  int32_t x = value >> 8;
+  int32_t frac = value & 0xFF;
+  int32_t y = applyCustomCurve(x, idx);
+  if (!frac) return 256 * y;
+  return 256 * y + (applyCustomCurve(x + 1, idx) - y) * frac;
+}
+
 // channel = channelnumber -1;
-// value = outputvalue with 100 mulitplied usual range -102400 to 102400; output -1024 to 1024
-// changed rescaling from *100 to *256 to optimize performance
-// rescaled from -262144 to 262144
-int16_t applyLimits(uint8_t channel, int32_t value)
+// value = output value with 256 multiplied, usual range -262144 to 262144
+// output -1024 to 1024
+static inline int16_t applyOutputStage(uint8_t channel, int32_t value, bool trainerChannels)
 {
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
   if (safetyCh[channel] != OVERRIDE_CHANNEL_UNDEFINED) {
@@ -236,63 +360,36 @@ int16_t applyLimits(uint8_t channel, int32_t value)
   }
 #endif
 
-  if (isFunctionActive(FUNCTION_TRAINER_CHANNELS) && is_trainer_connected()) {
+  if (trainerChannels) {
     return trainerInput[channel] * 2;
   }
 
-  LimitData * lim = limitAddress(channel);
-
-  if (lim->curve) {
-    // TODO we loose precision here, applyCustomCurve could work with int32_t on ARM boards...
-    if (lim->curve > 0)
-      value = 256 * applyCustomCurve(value/256, lim->curve-1);
-    else
-      value = 256 * applyCustomCurve(-value/256, -lim->curve-1);
+  bitfield_channels_t mask = (bitfield_channels_t)1 << channel;
+  if (outputPlan.curves & mask) {
+    value = applyOutputCurve(value, outputPlan.curve[channel]);
   }
 
-  int16_t ofs   = LIMIT_OFS_RESX(lim);
-  int16_t lim_p = LIMIT_MAX_RESX(lim);
-  int16_t lim_n = LIMIT_MIN_RESX(lim);
-
-  if (ofs > lim_p) ofs = lim_p;
-  if (ofs < lim_n) ofs = lim_n;
+  // the clamp keeps 32x of calculation reserve before the multiplication
+  value = OUTPUT_CLAMP_INPUT(value);
+  value *= (value > 0 ? outputPlan.posScale[channel] : outputPlan.negScale[channel]);
 
-  // because the rescaling optimization would reduce the calculation reserve we activate this for all builds
-  // it increases the calculation reserve from factor 20,25x to 32x, which it slightly better as original
-  // without it we would only have 16x which is slightly worse as original, we should not do this
+  // div by 1024*256, round away from 0
+  int32_t result = outputPlan.ofs[channel] + ((value + (value < 0 ? (1<<17)-1 : (1<<17))) >> 18);
+  result = max<int32_t>(min<int32_t>(result, outputPlan.maxValue[channel]), outputPlan.minValue[channel]);
 
-  // thanks to gbirkus, he motivated this change, which greatly reduces overruns
-  // unfortunately the constants and 32bit compares generates about 50 bytes codes; didn't find a way to get it down.
-  value = limit(int32_t(-RESXl*256), value, int32_t(RESXl*256));  // saves 2 bytes compared to other solutions up to now
-
-#if defined(PPM_LIMITS_SYMETRICAL)
-  if (value) {
-    int16_t tmp;
-    if (lim->symetrical)
-      tmp = (value > 0) ? (lim_p) : (-lim_n);
-    else
-      tmp = (value > 0) ? (lim_p - ofs) : (-lim_n + ofs);
-    value = (int32_t) value * tmp;   //  div by 1024*256 -> output = -1024..1024
-#else
-  if (value) {
-    int16_t tmp = (value > 0) ? (lim_p - ofs) : (-lim_n + ofs);
-    value = (int32_t) value * tmp;   //  div by 1024*256 -> output = -1024..1024
-#endif
-
-    // Round away from 0
-    tmp = (value + (value < 0 ? (1<<17)-1 : (1<<17))) >> 18;
-
-    ofs += tmp;  // ofs can to added directly because already recalculated,
-  }
+  // finally do the reverse
+  return (outputPlan.revert & mask) ? -result : result;
+}
 
-  if (ofs > lim_p)
-    ofs = lim_p;
-  if (ofs < lim_n)
-    ofs = lim_n;
-  if (lim->revert)
-    ofs = -ofs; // finally do the reverse.
+static bool isTrainerChannelsActive()
+{
+  return isFunctionActive(FUNCTION_TRAINER_CHANNELS) && is_trainer_connected();
+}
 
-  return ofs;
+int16_t applyLimits(uint8_t channel, int32_t value)
+{
+  checkOutputPlan();
+  return applyOutputStage(channel, value, isTrainerChannelsActive());
 }
 
 // TODO same naming convention than the drawSource
@@ -468,7 +565,8 @@ getvalue_t getValue(mixsrc_t i, bool* valid)
 void evalTrims()
 {
   uint8_t phase = mixerCurrentFlightMode;
-  for (uint8_t i = 0; i < keysGetMaxTrims(); i++) {
+  uint8_t maxTrims = keysGetMaxTrims();
+  for (uint8_t i = 0; i < maxTrims; i++) {
     // do trim -> throttle trim if applicable
     int16_t trim = getTrimValue(phase, i);
     if (trimsCheckTimer > 0) {
@@ -598,7 +696,8 @@ void evalInputs(uint8_t mode)
   }
 
   // EXPOs
-  applyExpos(anas, mode);
+  applyExpos(anas, mode, 0, 0,
+             mode == e_perout_mode_inactive_flight_mode ? getMixerInputs() : (uint32_t)-1);
 
   // TRIMs
   // when no virtual inputs, the trims need the anas array calculated above
@@ -651,79 +750,259 @@ int getSourceTrimValue(int source, int stickValue=0)
 
 uint8_t mixerCurrentFlightMode;
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+// Weight, offset and curves of a mix line: this part does not depend
+// on any state, only on the input value and the resolved parameters
+static int32_t applyMixLineWeightAndCurves(const MixData * md, getvalue_t v,
+                                           int32_t weight, int32_t offset,
+                                           int curveParam,
+                                           bool applyOffsetAndCurve)
 {
-  evalInputs(mode);
+  uint8_t curveType = md->curve.type;
 
-  if (tick10ms)
-    evalLogicalSwitches(mode==e_perout_mode_normal);
+  //========== CURVES ===============
+  if (applyOffsetAndCurve && curveType != CURVE_REF_DIFF && md->curve.value) {
+    v = applyCurveRef(v, curveType, curveParam);
+  }
+
+  //========== WEIGHT ===============
+  int32_t dv = (int32_t)v * calc100to256_16Bits(weight);
+  dv = divRoundClosest(dv, 10);
+
+  //========== OFFSET / AFTER ===============
+  if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+
+  //========== DIFFERENTIAL =========
+  if (curveType == CURVE_REF_DIFF && md->curve.value) {
+    dv = applyCurveRef(dv, curveType, curveParam);
+  }
+
+  return dv;
+}
+
+// Mixer plan: the GVar-encoded parameters of each mix line are resolved
+// once per model revision and flight mode instead of on every cycle.
+// The raw fields are kept as well, so that a line edited without
+// going through storageDirty() is still resolved again.
+struct MixerPlan {
+  int16_t    rawWeight[MAX_MIXERS];
+  int16_t    rawOffset[MAX_MIXERS];
+  uint8_t    rawCurveType[MAX_MIXERS];
+  int8_t     rawCurveValue[MAX_MIXERS];
+
+  int16_t    weight[MAX_MIXERS];
+  int16_t    offset[MAX_MIXERS];
+  int16_t    curveParam[MAX_MIXERS];
+  bool       resolved[MAX_MIXERS];
+
+#if defined(MIXER_LINE_CACHE)
+  // Last result of each line, re-used as long as the line input is
+  // unchanged. Curve points and GVars are covered by mixerCacheRevision().
+  getvalue_t input[MAX_MIXERS];
+  int32_t    output[MAX_MIXERS];
+  bool       cached[MAX_MIXERS];
+#endif
+
+  uint32_t   revision;
+  uint8_t    flightMode;
+};
+
+static MixerPlan mixerPlan;
+
+static void checkMixerPlan()
+{
+  if (mixerPlan.revision != mixerCacheRevision() ||
+      mixerPlan.flightMode != mixerCurrentFlightMode) {
+    memclear(mixerPlan.resolved, sizeof(mixerPlan.resolved));
+#if defined(MIXER_LINE_CACHE)
+    memclear(mixerPlan.cached, sizeof(mixerPlan.cached));
+#endif
+    mixerPlan.revision = mixerCacheRevision();
+    mixerPlan.flightMode = mixerCurrentFlightMode;
+  }
+}
+
+static void resolveMixLine(uint8_t idx, const MixData * md)
+{
+  int16_t rawWeight = md->weight;
+  int16_t rawOffset = md->offset;
+
+  if (mixerPlan.resolved[idx] && mixerPlan.rawWeight[idx] == rawWeight &&
+      mixerPlan.rawOffset[idx] == rawOffset &&
+      mixerPlan.rawCurveType[idx] == md->curve.type &&
+      mixerPlan.rawCurveValue[idx] == md->curve.value) {
+    return;
+  }
+
+  mixerPlan.rawWeight[idx] = rawWeight;
+  mixerPlan.rawOffset[idx] = rawOffset;
+  mixerPlan.rawCurveType[idx] = md->curve.type;
+  mixerPlan.rawCurveValue[idx] = md->curve.value;
+
+  mixerPlan.weight[idx] = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+  mixerPlan.offset[idx] = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+  mixerPlan.curveParam[idx] = getCurveRefParam(md->curve, mixerCurrentFlightMode);
+  mixerPlan.resolved[idx] = true;
+
+#if defined(MIXER_LINE_CACHE)
+  mixerPlan.cached[idx] = false;
+#endif
+}
+
+static int32_t applyMixLinePlan(uint8_t idx, const MixData * md, getvalue_t v,
+                                bool applyOffsetAndCurve)
+{
+  resolveMixLine(idx, md);
+
+  int32_t weight = mixerPlan.weight[idx];
+  int curveParam = mixerPlan.curveParam[idx];
+
+  if (!applyOffsetAndCurve) {
+    return applyMixLineWeightAndCurves(md, v, weight, 0, curveParam, false);
+  }
+
+#if defined(MIXER_LINE_CACHE)
+  if (mixerPlan.cached[idx] && mixerPlan.input[idx] == v) {
+    return mixerPlan.output[idx];
+  }
+#endif
+
+  int32_t dv = applyMixLineWeightAndCurves(md, v, weight, mixerPlan.offset[idx],
+                                           curveParam, true);
+
+#if defined(MIXER_LINE_CACHE)
+  mixerPlan.input[idx] = v;
+  mixerPlan.output[idx] = dv;
+  mixerPlan.cached[idx] = true;
+#endif
+
+  return dv;
+}
 
 #if defined(HELI)
-  if (modelHeliEnabled()) {
-    int heliEleValue = getValue(g_model.swashR.elevatorSource);
-    int heliAilValue = getValue(g_model.swashR.aileronSource);
-    if (g_model.swashR.value) {
-      uint32_t v = ((int32_t)heliEleValue*heliEleValue + (int32_t)heliAilValue*heliAilValue);
-      uint32_t q = calc100toRESX(g_model.swashR.value);
-      q *= q;
-      if (v>q) {
-        uint16_t d = isqrt32(v);
-        int16_t tmp = calc100toRESX(g_model.swashR.value);
-        heliEleValue = (int32_t) heliEleValue*tmp/d;
-        heliAilValue = (int32_t) heliAilValue*tmp/d;
-      }
-    }
+#define REZ_SWASH_X(x)  ((x) - (x)/8 - (x)/128 - (x)/512)   //  1024*sin(60) ~= 886
+#define REZ_SWASH_Y(x)  ((x))   //  1024 => 1024
+
+// Part of the elevator / aileron value added to the collective on a servo
+enum SwashTerm {
+  SWASH_TERM_NONE,
+  SWASH_TERM_FULL,
+  SWASH_TERM_NEG,
+  SWASH_TERM_HALF,
+};
+
+struct SwashGeometry {
+  bool    elevatorRez; // scaled by sin(60)
+  bool    aileronRez;
+  uint8_t elevator[3];
+  uint8_t aileron[3];
+};
+
+// Indexed by swash type - 1
+static const SwashGeometry swashGeometries[] = {
+  // 120
+  { false, true,
+    { SWASH_TERM_NEG, SWASH_TERM_HALF, SWASH_TERM_HALF },
+    { SWASH_TERM_NONE, SWASH_TERM_FULL, SWASH_TERM_NEG } },
+  // 120X
+  { true, false,
+    { SWASH_TERM_NONE, SWASH_TERM_FULL, SWASH_TERM_NEG },
+    { SWASH_TERM_NEG, SWASH_TERM_HALF, SWASH_TERM_HALF } },
+  // 140
+  { false, false,
+    { SWASH_TERM_NEG, SWASH_TERM_FULL, SWASH_TERM_FULL },
+    { SWASH_TERM_NONE, SWASH_TERM_FULL, SWASH_TERM_NEG } },
+  // 90
+  { false, false,
+    { SWASH_TERM_NEG, SWASH_TERM_NONE, SWASH_TERM_NONE },
+    { SWASH_TERM_NONE, SWASH_TERM_FULL, SWASH_TERM_NEG } },
+};
+
+static_assert(DIM(swashGeometries) == SWASH_TYPE_MAX, "Missing swash geometry");
+
+static void evalSwash()
+{
+  if (!modelHeliEnabled()) {
+    cyc_anas[0] = cyc_anas[1] = cyc_anas[2] = 0;
+    return;
+  }
 
-  #define REZ_SWASH_X(x)  ((x) - (x)/8 - (x)/128 - (x)/512)   //  1024*sin(60) ~= 886
-  #define REZ_SWASH_Y(x)  ((x))   //  1024 => 1024
-
-    if (g_model.swashR.type) {
-      getvalue_t vp = heliEleValue + getSourceTrimValue(g_model.swashR.elevatorSource);
-      getvalue_t vr = heliAilValue + getSourceTrimValue(g_model.swashR.aileronSource);
-      getvalue_t vc = 0;
-      if (g_model.swashR.collectiveSource)
-        vc = getValue(g_model.swashR.collectiveSource);
-
-      vp = (vp * g_model.swashR.elevatorWeight) / 100;
-      vr = (vr * g_model.swashR.aileronWeight) / 100;
-      vc = (vc * g_model.swashR.collectiveWeight) / 100;
-
-      switch (g_model.swashR.type) {
-        case SWASH_TYPE_120:
-          vp = REZ_SWASH_Y(vp);
-          vr = REZ_SWASH_X(vr);
-          cyc_anas[0] = vc - vp;
-          cyc_anas[1] = vc + vp/2 + vr;
-          cyc_anas[2] = vc + vp/2 - vr;
-          break;
-        case SWASH_TYPE_120X:
-          vp = REZ_SWASH_X(vp);
-          vr = REZ_SWASH_Y(vr);
-          cyc_anas[0] = vc - vr;
-          cyc_anas[1] = vc + vr/2 + vp;
-          cyc_anas[2] = vc + vr/2 - vp;
-          break;
-        case SWASH_TYPE_140:
-          vp = REZ_SWASH_Y(vp);
-          vr = REZ_SWASH_Y(vr);
-          cyc_anas[0] = vc - vp;
-          cyc_anas[1] = vc + vp + vr;
-          cyc_anas[2] = vc + vp - vr;
-          break;
-        case SWASH_TYPE_90:
-          vp = REZ_SWASH_Y(vp);
-          vr = REZ_SWASH_Y(vr);
-          cyc_anas[0] = vc - vp;
-          cyc_anas[1] = vc + vr;
-          cyc_anas[2] = vc - vr;
-          break;
-        default:
-          break;
-      }
+  int heliEleValue = getValue(g_model.swashR.elevatorSource);
+  int heliAilValue = getValue(g_model.swashR.aileronSource);
+
+  // cyclic ring: the square root is only needed outside of the ring
+  if (g_model.swashR.value) {
+    uint32_t v = ((int32_t)heliEleValue*heliEleValue + (int32_t)heliAilValue*heliAilValue);
+    int16_t ring = calc100toRESX(g_model.swashR.value);
+    if (v > (uint32_t)ring * ring) {
+      uint16_t d = isqrt32(v);
+      heliEleValue = (int32_t) heliEleValue*ring/d;
+      heliAilValue = (int32_t) heliAilValue*ring/d;
     }
-  } else {
-    cyc_anas[0] = cyc_anas[1] = cyc_anas[2] = 0;
   }
+
+  if (!g_model.swashR.type || g_model.swashR.type > SWASH_TYPE_MAX)
+    return;
+
+  const SwashGeometry & geometry = swashGeometries[g_model.swashR.type - 1];
+
+  getvalue_t vp = heliEleValue + getSourceTrimValue(g_model.swashR.elevatorSource);
+  getvalue_t vr = heliAilValue + getSourceTrimValue(g_model.swashR.aileronSource);
+  getvalue_t vc = 0;
+  if (g_model.swashR.collectiveSource)
+    vc = getValue(g_model.swashR.collectiveSource);
+
+  vp = (vp * g_model.swashR.elevatorWeight) / 100;
+  vr = (vr * g_model.swashR.aileronWeight) / 100;
+  vc = (vc * g_model.swashR.collectiveWeight) / 100;
+
+  vp = geometry.elevatorRez ? REZ_SWASH_X(vp) : REZ_SWASH_Y(vp);
+  vr = geometry.aileronRez ? REZ_SWASH_X(vr) : REZ_SWASH_Y(vr);
+
+  const getvalue_t elevatorTerms[] = { 0, vp, (getvalue_t)-vp, (getvalue_t)(vp/2) };
+  const getvalue_t aileronTerms[] = { 0, vr, (getvalue_t)-vr, (getvalue_t)(vr/2) };
+
+  for (uint8_t i = 0; i < 3; i++) {
+    cyc_anas[i] = vc + elevatorTerms[geometry.elevator[i]] + aileronTerms[geometry.aileron[i]];
+  }
+}
+#endif
+
+// Rest of the slow movement of each line smaller than one unit of act[]
+static uint16_t actRemainder[MAX_MIXERS];
+
+#define DEL_MULT_SHIFT 8
+
+// Move of a slow line during one mixer cycle: the full range takes
+// speed * 0.1s. When the cycle time is known in us, the remainder is
+// carried over to the next cycle, so that the rate is the same whatever
+// the mixer period; the value then moves on each cycle, not each 10ms.
+static int32_t getSlowStep(uint8_t idx, uint8_t speed, uint8_t tick10ms, uint16_t tickUs)
+{
+  if (!tickUs) {
+    actRemainder[idx] = 0;
+    int32_t rate = (int32_t) tick10ms << (DEL_MULT_SHIFT+11);  // = DEL_MULT*2048*tick10ms
+    return rate / ((int16_t)10 * speed);
+  }
+
+  uint32_t step10ms = ((uint32_t)1 << (DEL_MULT_SHIFT+11)) / ((uint16_t)10 * speed);
+  uint32_t total = step10ms * tickUs + actRemainder[idx];
+  actRemainder[idx] = total % 10000;
+  return total / 10000;
+}
+
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms, bitfield_channels_t channels, uint16_t tickUs)
+{
+  evalInputs(mode);
+
+  if (mode == e_perout_mode_normal) {
+    checkMixerPlan();
+  }
+
+  if (tick10ms)
+    evalLogicalSwitches(mode==e_perout_mode_normal);
+
+#if defined(HELI)
+  evalSwash();
 #endif
 
   memclear(chans, sizeof(chans)); // all outputs to 0
@@ -733,7 +1012,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
   uint8_t pass = 0;
 
-  bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
+  bitfield_channels_t dirtyChannels = channels; // all requested channels dirty when mixer starts
 
   do {
     bitfield_channels_t passDirtyChannels = 0;
@@ -859,40 +1138,35 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
         }
       }
 
-      int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-      weight = calc100to256_16Bits(weight);
       //========== SPEED ===============
       // now its on input side, but without weight compensation. More like other remote controls
       // lower weight causes slower movement
 
       if (mode <= e_perout_mode_inactive_flight_mode && (md->speedUp || md->speedDown)) { // there are delay values
-#define DEL_MULT_SHIFT 8
         // we recale to a mult 256 higher value for calculation
         int32_t tact = act[i];
         int16_t diff = v - (tact>>DEL_MULT_SHIFT);
         if (diff) {
           // open.20.fsguruh: speed is defined in % movement per second; In menu we specify the full movement (-100% to 100%) = 200% in total
           // the unit of the stored value is the value from md->speedUp or md->speedDown * 0.1s; e.g. value 4 means 0.4 seconds
-          // because we get a tick each 10msec, we need 100 ticks for one second
           // the value in md->speedXXX gives the time it should take to do a full movement from -100 to 100 therefore 200%. This equals 2048 in recalculated internal range
-          if (tick10ms || !s_mixer_first_run_done) {
+          if (tick10ms || tickUs || !s_mixer_first_run_done) {
             // only if already time is passed add or substract a value according the speed configured
-            int32_t rate = (int32_t) tick10ms << (DEL_MULT_SHIFT+11);  // = DEL_MULT*2048*tick10ms
-            // rate equals a full range for one second; if less time is passed rate is accordingly smaller
-            // if one second passed, rate would be 2048 (full motion)*256(recalculated weight)*100(100 ticks needed for one second)
             int32_t currentValue = ((int32_t) v<<DEL_MULT_SHIFT);
             if (diff > 0) {
               if (s_mixer_first_run_done && md->speedUp > 0) {
                 // if a speed upwards is defined recalculate the new value according configured speed; the higher the speed the smaller the add value is
-                int32_t newValue = tact+rate/((int16_t)10*md->speedUp);
+                int32_t newValue = tact + getSlowStep(i, md->speedUp, tick10ms, tickUs);
                 if (newValue<currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
+                else actRemainder[i] = 0;
               }
             }
             else {  // if is <0 because ==0 is not possible
               if (s_mixer_first_run_done && md->speedDown > 0) {
                 // see explanation in speedUp
-                int32_t newValue = tact-rate/((int16_t)10*md->speedDown);
+                int32_t newValue = tact - getSlowStep(i, md->speedDown, tick10ms, tickUs);
                 if (newValue>currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
+                else actRemainder[i] = 0;
               }
             }
             act[i] = tact = currentValue;
@@ -902,24 +1176,18 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
         }
       }
 
-      //========== CURVES ===============
-      if (applyOffsetAndCurve && md->curve.type != CURVE_REF_DIFF && md->curve.value) {
-        v = applyCurve(v, md->curve);
-      }
-
-      //========== WEIGHT ===============
-      int32_t dv = (int32_t)v * weight;
-      dv = divRoundClosest(dv, 10);
-
-      //========== OFFSET / AFTER ===============
-      if (applyOffsetAndCurve) {
-        int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-        if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+      int32_t dv;
+      if (mode == e_perout_mode_normal) {
+        dv = applyMixLinePlan(i, md, v, applyOffsetAndCurve);
       }
-
-      //========== DIFFERENTIAL =========
-      if (md->curve.type == CURVE_REF_DIFF && md->curve.value) {
-        dv = applyCurve(dv, md->curve);
+      else {
+        int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+        int32_t offset = 0;
+        if (applyOffsetAndCurve) {
+          offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+        }
+        int curveParam = getCurveRefParam(md->curve, mixerCurrentFlightMode);
+        dv = applyMixLineWeightAndCurves(md, v, weight, offset, curveParam, applyOffsetAndCurve);
       }
 
       int32_t * ptr = &chans[md->destCh]; // Save calculating address several times
@@ -987,6 +1255,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
     } //endfor mixers
 
     tick10ms = 0;
+    tickUs = 0;
     dirtyChannels &= passDirtyChannels;
 
   } while (++pass < 5 && dirtyChannels);
@@ -996,13 +1265,190 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
 
 
+// Fade plan: a fading flight mode only needs the channels which may give
+// another result than in the current flight mode. The parts which only
+// depend on the model are analysed once per model revision and flight
+// mode, the trims are compared on each cycle.
+struct FadePlan {
+  uint16_t            modes[MAX_OUTPUT_CHANNELS];   // flight modes in which the channel differs
+  uint8_t             trims[MAX_OUTPUT_CHANNELS];   // trims used by the channel
+  bitfield_channels_t sources[MAX_OUTPUT_CHANNELS]; // channels read by the channel
+
+  uint32_t            revision;
+  uint8_t             flightMode;
+  bool                valid;
+};
+
+static FadePlan fadePlan;
+
+static bool isSwitchFlightModeDependent(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  return (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH) ||
+         (swtch >= SWSRC_FIRST_FLIGHT_MODE && swtch <= SWSRC_LAST_FLIGHT_MODE);
+}
+
+static bool isCurveFlightModeDependent(const CurveRef & curve)
+{
+  return (curve.type == CURVE_REF_DIFF || curve.type == CURVE_REF_EXPO) &&
+         GV_IS_GV_VALUE(curve.value, -100, 100);
+}
+
+// Trims are not reported here but added to the trims mask
+static bool isSourceFlightModeDependent(mixsrc_t source, uint8_t & trims)
+{
+  if (source >= MIXSRC_FIRST_TRIM && source <= MIXSRC_LAST_TRIM) {
+    trims |= 1 << (source - MIXSRC_FIRST_TRIM);
+    return false;
+  }
+
+  return (source >= MIXSRC_FIRST_HELI && source <= MIXSRC_LAST_HELI) ||
+         (source >= MIXSRC_FIRST_LOGICAL_SWITCH && source <= MIXSRC_LAST_LOGICAL_SWITCH) ||
+         (source >= MIXSRC_FIRST_GVAR && source <= MIXSRC_LAST_GVAR);
+}
+
+// Flight modes in which a line with these flight modes is not in the
+// same state as in the current flight mode
+static uint16_t getFlightModesDifferentFrom(uint16_t flightModes, uint8_t fm)
+{
+  return (flightModes & (1 << fm)) ? ~flightModes : flightModes;
+}
+
+static void checkFadePlan(uint8_t fm)
+{
+  if (fadePlan.valid && fadePlan.revision == mixerCacheRevision() &&
+      fadePlan.flightMode == fm) {
+    return;
+  }
+
+  uint16_t inputModes[MAX_INPUTS];
+  uint8_t inputTrims[MAX_INPUTS];
+  memclear(inputModes, sizeof(inputModes));
+  memclear(inputTrims, sizeof(inputTrims));
+
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * ed = expoAddress(i);
+    if (!EXPO_VALID(ed)) break; // end of list
+    uint8_t & trims = inputTrims[ed->chn];
+    if (GV_IS_GV_VALUE(ed->weight, -100, 100) ||
+        GV_IS_GV_VALUE(ed->offset, -100, 100) ||
+        isCurveFlightModeDependent(ed->curve) ||
+        isSwitchFlightModeDependent(ed->swtch) ||
+        isSourceFlightModeDependent(ed->srcRaw, trims)) {
+      inputModes[ed->chn] = 0xFFFF;
+    }
+    else {
+      inputModes[ed->chn] |= getFlightModesDifferentFrom(ed->flightModes, fm);
+    }
+    if (ed->trimSource < TRIM_ON)
+      trims |= 1 << (-ed->trimSource - 1);
+    else if (ed->trimSource == TRIM_ON && ed->srcRaw >= MIXSRC_FIRST_STICK &&
+             ed->srcRaw <= MIXSRC_LAST_STICK)
+      trims |= 1 << (ed->srcRaw - MIXSRC_FIRST_STICK);
+  }
+
+  memclear(fadePlan.modes, sizeof(fadePlan.modes));
+  memclear(fadePlan.trims, sizeof(fadePlan.trims));
+  memclear(fadePlan.sources, sizeof(fadePlan.sources));
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * md = mixAddress(i);
+
+    if (md->srcRaw == 0)
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+
+    uint8_t ch = md->destCh;
+    uint8_t & trims = fadePlan.trims[ch];
+    // delays and slow-up/down only run in the current flight mode
+    if (md->delayUp || md->delayDown || md->speedUp || md->speedDown ||
+        GV_IS_GV_VALUE(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE) ||
+        GV_IS_GV_VALUE(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE) ||
+        isCurveFlightModeDependent(md->curve) ||
+        isSwitchFlightModeDependent(md->swtch) ||
+        isSourceFlightModeDependent(md->srcRaw, trims)) {
+      fadePlan.modes[ch] = 0xFFFF;
+    }
+    else {
+      fadePlan.modes[ch] |= getFlightModesDifferentFrom(md->flightModes, fm);
+    }
+
+    if (md->srcRaw >= MIXSRC_FIRST_INPUT && md->srcRaw <= MIXSRC_LAST_INPUT) {
+      fadePlan.modes[ch] |= inputModes[md->srcRaw - MIXSRC_FIRST_INPUT];
+      trims |= inputTrims[md->srcRaw - MIXSRC_FIRST_INPUT];
+    }
+    else if (md->srcRaw >= MIXSRC_FIRST_STICK && md->srcRaw <= MIXSRC_LAST_STICK) {
+      trims |= 1 << (md->srcRaw - MIXSRC_FIRST_STICK);
+    }
+    else if (md->srcRaw >= MIXSRC_FIRST_CH && md->srcRaw <= MIXSRC_LAST_CH &&
+             md->srcRaw - MIXSRC_FIRST_CH != ch) {
+      fadePlan.sources[ch] |= (bitfield_channels_t)1 << (md->srcRaw - MIXSRC_FIRST_CH);
+    }
+  }
+
+  // a channel differs as soon as one of the channels it reads differs
+  bool changed;
+  do {
+    changed = false;
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      for (uint8_t src = 0; src < MAX_OUTPUT_CHANNELS; src++) {
+        if (!(fadePlan.sources[ch] & ((bitfield_channels_t)1 << src)))
+          continue;
+        uint16_t modes = fadePlan.modes[ch] | fadePlan.modes[src];
+        uint8_t trims = fadePlan.trims[ch] | fadePlan.trims[src];
+        bitfield_channels_t sources = (fadePlan.sources[ch] | fadePlan.sources[src]) &
+                                      ~((bitfield_channels_t)1 << ch);
+        if (modes != fadePlan.modes[ch] || trims != fadePlan.trims[ch] ||
+            sources != fadePlan.sources[ch]) {
+          fadePlan.modes[ch] = modes;
+          fadePlan.trims[ch] = trims;
+          fadePlan.sources[ch] = sources;
+          changed = true;
+        }
+      }
+    }
+  } while (changed);
+
+  fadePlan.revision = mixerCacheRevision();
+  fadePlan.flightMode = fm;
+  fadePlan.valid = true;
+}
+
+// Returns the channels which may differ in the fading flight mode, and
+// in evalChannels the channels needed to compute them
+static bitfield_channels_t getFadeChannels(uint8_t p, uint8_t fm,
+                                           bitfield_channels_t & evalChannels)
+{
+  uint8_t trims = 0;
+  uint8_t maxTrims = keysGetMaxTrims();
+  for (uint8_t i = 0; i < maxTrims; i++) {
+    if (getTrimValue(p, i) != getTrimValue(fm, i))
+      trims |= 1 << i;
+  }
+
+  bitfield_channels_t channels = 0;
+  evalChannels = 0;
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    if ((fadePlan.modes[ch] & (1 << p)) || (fadePlan.trims[ch] & trims)) {
+      channels |= (bitfield_channels_t)1 << ch;
+      evalChannels |= fadePlan.sources[ch];
+    }
+  }
+  evalChannels |= channels;
+
+  return channels;
+}
+
 #define MAX_ACT 0xffff
 uint8_t lastFlightMode = 255; // TODO reinit everything here when the model changes, no???
 
 tmr10ms_t flightModeTransitionTime;
 uint8_t   flightModeTransitionLast = 255;
 
-void evalMixes(uint8_t tick10ms)
+void evalMixes(uint8_t tick10ms, uint16_t tickUs)
 {
   int32_t sum_chans512[MAX_OUTPUT_CHANNELS];
 
@@ -1047,23 +1493,54 @@ void evalMixes(uint8_t tick10ms)
   }
 
   int32_t weight = 0;
+  bitfield_channels_t fadeChannels = 0;
   if (flightModesFade) {
+    // the fading flight modes are evaluated first, and only for the
+    // channels which differ, so that the current flight mode is left
+    // in the inputs, trims and channels
+    bitfield_channels_t modeChannels[MAX_FLIGHT_MODES];
     memclear(sum_chans512, sizeof(sum_chans512));
+    checkFadePlan(fm);
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
-      if (flightModesFade & (0x01 << p)) {
-        mixerCurrentFlightMode = p;
-        evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
-        for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
-          sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
+      if (p != fm && (flightModesFade & (0x01 << p))) {
+        bitfield_channels_t evalChannels;
+        modeChannels[p] = getFadeChannels(p, fm, evalChannels);
+        if (modeChannels[p]) {
+          mixerCurrentFlightMode = p;
+          evalFlightModeMixes(e_perout_mode_inactive_flight_mode, 0, evalChannels);
+          for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+            if (modeChannels[p] & ((bitfield_channels_t)1 << i))
+              sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
+          }
+          fadeChannels |= modeChannels[p];
+        }
         weight += fp_act[p];
       }
     }
-    assert(weight);
+
     mixerCurrentFlightMode = fm;
+    evalFlightModeMixes(e_perout_mode_normal, tick10ms, (bitfield_channels_t)-1, tickUs);
+
+    // the current flight mode also stands for the fading flight modes
+    // in which a channel does not differ
+    int32_t activeWeight = (flightModesFade & (0x01 << fm)) ? fp_act[fm] : 0;
+    weight += activeWeight;
+    assert(weight);
+    for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      bitfield_channels_t mask = (bitfield_channels_t)1 << i;
+      if (!(fadeChannels & mask))
+        continue;
+      int32_t channelWeight = activeWeight;
+      for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
+        if (p != fm && (flightModesFade & (0x01 << p)) && !(modeChannels[p] & mask))
+          channelWeight += fp_act[p];
+      }
+      sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * channelWeight;
+    }
   }
   else {
     mixerCurrentFlightMode = fm;
-    evalFlightModeMixes(e_perout_mode_normal, tick10ms);
+    evalFlightModeMixes(e_perout_mode_normal, tick10ms, (bitfield_channels_t)-1, tickUs);
   }
 
   //========== FUNCTIONS ===============
@@ -1082,17 +1559,19 @@ void evalMixes(uint8_t tick10ms)
   }
 
   //========== LIMITS ===============
+  checkOutputPlan();
+  bool trainerChannels = isTrainerChannelsActive();
   for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
     // chans[i] holds data from mixer.   chans[i] = v*weight => 1024*256
     // later we multiply by the limit (up to 100) and then we need to normalize
     // at the end chans[i] = chans[i]/256 =>  -1024..1024
     // interpolate value with min/max so we get smooth motion from center to stop
     // this limits based on v original values and min=-1024, max=1024  RESX=1024
-    int32_t q = (flightModesFade ? (sum_chans512[i] / weight) << 4 : chans[i]);
+    int32_t q = ((fadeChannels & ((bitfield_channels_t)1 << i)) ? (sum_chans512[i] / weight) << 4 : chans[i]);
 
     ex_chans[i] = q / 256;
 
-    int16_t value = applyLimits(i, q);  // applyLimits will remove the 256 100% basis
+    int16_t value = applyOutputStage(i, q, trainerChannels);  // removes the 256 100% basis
 
     channelOutputs[i] = value;  // copy consistent word to int-level
   }
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "mixer_profiler.h"
+
+const char * const mixerProfilerStageNames[MIXER_STAGE_COUNT] = {
+  "ADC",
+  "Switches",
+  "Mixes",
+  "Pulses",
+  "Periodic",
+  "Total",
+  "Stick age",
+  "Int. latency",
+  "Ext. latency",
+};
+
+struct MixerStageHistogram {
+  uint16_t bins[MIXER_PROFILER_BINS];
+  uint16_t max;
+};
+
+static MixerStageHistogram mixerProfilerHistograms[MIXER_STAGE_COUNT];
+
+static inline uint8_t getBinIndex(uint16_t ticks)
+{
+  if (ticks < 2) return ticks;
+
+  // position of the most significant bit (1..15)
+  uint8_t msb = 31 - __builtin_clz(ticks);
+  uint8_t sub = (ticks >> (msb - 1)) & 1;
+  return 2 + (msb - 1) * 2 + sub;
+}
+
+static inline uint32_t getBinLowerBound(uint8_t idx)
+{
+  if (idx < 2) return idx;
+  uint8_t msb = (idx - 2) / 2 + 1;
+  uint8_t sub = (idx - 2) & 1;
+  return (uint32_t)(2 + sub) << (msb - 1);
+}
+
+void mixerProfilerRecord(uint8_t stage, uint16_t ticks)
+{
+  MixerStageHistogram & h = mixerProfilerHistograms[stage];
+
+  if (ticks > h.max) h.max = ticks;
+
+  uint16_t & bin = h.bins[getBinIndex(ticks)];
+  if (bin == UINT16_MAX) {
+    // age all bins to keep the histogram representative
+    // of the recent load instead of saturating
+    for (auto & b : h.bins) b >>= 1;
+  }
+  bin += 1;
+}
+
+uint16_t mixerProfilerStep(uint8_t stage, uint16_t start)
+{
+  uint16_t now = getTmr2MHz();
+  mixerProfilerRecord(stage, (uint16_t)(now - start));
+  return now;
+}
+
+// interpolate linearly within the bin where the
+// cumulated count reaches 'rank'
+static uint32_t getPercentile(const MixerStageHistogram & h, uint32_t total,
+                              uint8_t percent)
+{
+  uint32_t rank = (total * percent + 99) / 100;
+  uint32_t count = 0;
+
+  for (uint8_t i = 0; i < MIXER_PROFILER_BINS; i++) {
+    uint16_t n = h.bins[i];
+    if (n && count + n >= rank) {
+      uint32_t lower = getBinLowerBound(i);
+      uint32_t width = getBinLowerBound(i + 1) - lower;
+      uint32_t value = lower + width * (rank - count) / n;
+      return value > h.max ? h.max : value;
+    }
+    count += n;
+  }
+
+  return h.max;
+}
+
+void mixerProfilerGetStats(uint8_t stage, MixerStageStats & stats)
+{
+  const MixerStageHistogram & h = mixerProfilerHistograms[stage];
+
+  uint32_t total = 0;
+  for (auto b : h.bins) total += b;
+
+  if (total == 0) {
+    stats.p50 = stats.p99 = stats.max = 0;
+    return;
+  }
+
+  stats.p50 = getPercentile(h, total, 50) / 2;
+  stats.p99 = getPercentile(h, total, 99) / 2;
+  stats.max = h.max / 2;
+}
+
+void mixerProfilerReset()
+{
+  memset(mixerProfilerHistograms, 0, sizeof(mixerProfilerHistograms));
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Stages of one mixer cycle, as measured in the mixer task
+enum MixerProfilerStage {
+  MIXER_STAGE_ADC,
+  MIXER_STAGE_SWITCHES,
+  MIXER_STAGE_EVAL_MIXES,
+  MIXER_STAGE_PULSES,
+  MIXER_STAGE_PERIODIC,
+  MIXER_STAGE_TOTAL,
+  MIXER_STAGE_STICKS_AGE,  // serial sticks only
+  MIXER_STAGE_LATENCY_INT, // sticks sampled to internal module frame sent
+  MIXER_STAGE_LATENCY_EXT, // sticks sampled to external module frame sent
+  MIXER_STAGE_COUNT
+};
+
+// Log-linear histogram: 2 bins per octave of 2MHz ticks
+// over the full 16-bit range
+#define MIXER_PROFILER_BINS 32
+
+struct MixerStageStats {
+  uint16_t p50;  // us
+  uint16_t p99;  // us
+  uint16_t max;  // us
+};
+
+extern const char * const mixerProfilerStageNames[MIXER_STAGE_COUNT];
+
+// Record one sample (in 2MHz ticks) for the given stage.
+// Must only be called from the mixer task.
+void mixerProfilerRecord(uint8_t stage, uint16_t ticks);
+
+// Record the time elapsed since 'start' for the given stage
+// and return the current timer value, so that consecutive
+// stages can be chained without reading the timer twice.
+uint16_t mixerProfilerStep(uint8_t stage, uint16_t start);
+
+// Compute percentiles from the current histogram.
+//
+// Please note: this is meant to be called from the UI and reads
+//              the histogram without locking. The result may thus
+//              be off by one sample, which is fine for display.
+void mixerProfilerGetStats(uint8_t stage, MixerStageStats & stats);
+
+// Clear all histograms
+void mixerProfilerReset();
@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "mixer_scheduler.h"
+#include "module_timing.h"
 #include "tasks/mixer_task.h"
 
 bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
@@ -53,14 +54,38 @@ bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
 
 // Global trigger flag
 
+// modules due within this delay are sent in the same mixer cycle
+#define MIXER_SCHEDULER_SLACK_US  100
+
 // Mixer schedule
 struct MixerSchedule {
 
   // period in us
   volatile uint16_t period;
+
+  // time left until the next frame, in us
+  int32_t remaining;
 };
 
 static MixerSchedule mixerSchedules[NUM_MODULES];
+static volatile uint8_t mixerDueModules;
+
+// The mixes run at the period of the first scheduled module,
+// the other modules are sent from the last outputs at their own rate
+static uint8_t getMixingModule()
+{
+#if defined(HARDWARE_INTERNAL_MODULE)
+  if (mixerSchedules[INTERNAL_MODULE].period) {
+    return INTERNAL_MODULE;
+  }
+#endif
+#if defined(HARDWARE_EXTERNAL_MODULE)
+  if (mixerSchedules[EXTERNAL_MODULE].period) {
+    return EXTERNAL_MODULE;
+  }
+#endif
+  return NUM_MODULES;
+}
 
 uint16_t getMixerSchedulerPeriod()
 {
@@ -104,6 +129,77 @@ uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx)
   return mixerSchedules[moduleIdx].period;
 }
 
+uint16_t mixerSchedulerNextInterval(uint16_t elapsedUs, bool resync)
+{
+  uint8_t mixingModule = getMixingModule();
+  uint8_t due = 0;
+  int32_t next = MAX_REFRESH_RATE;
+
+  if (mixingModule >= NUM_MODULES) {
+    // no module schedule: fixed mixer period
+    due = MIXER_SCHEDULER_DUE_MIXES;
+    next = getMixerSchedulerPeriod();
+  }
+
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    auto& schedule = mixerSchedules[i];
+    int32_t period = schedule.period;
+    if (!period) {
+      schedule.remaining = 0;
+      continue;
+    }
+
+    schedule.remaining -= elapsedUs;
+    if (resync && i == mixingModule) {
+      schedule.remaining = 0;
+    }
+
+    if (schedule.remaining <= MIXER_SCHEDULER_SLACK_US) {
+      due |= MIXER_SCHEDULER_DUE_MODULE(i);
+      if (i == mixingModule) {
+        due |= MIXER_SCHEDULER_DUE_MIXES;
+      }
+      if (mixerDueModules & MIXER_SCHEDULER_DUE_MODULE(i)) {
+        // previous frame not taken yet by the mixer task
+        moduleTimingDropped(i, 1);
+      }
+      moduleTimingDue(i);
+      schedule.remaining += period;
+      if (schedule.remaining <= MIXER_SCHEDULER_SLACK_US) {
+        // late by more than one period: restart from now
+        moduleTimingDropped(
+            i, (MIXER_SCHEDULER_SLACK_US - schedule.remaining) / period + 1);
+        schedule.remaining = period;
+      }
+    }
+
+    if (schedule.remaining < next) {
+      next = schedule.remaining;
+    }
+  }
+
+  if (due & MIXER_SCHEDULER_DUE_MIXES) {
+    // modules without schedule follow the mixes
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+      if (!mixerSchedules[i].period) {
+        due |= MIXER_SCHEDULER_DUE_MODULE(i);
+      }
+    }
+  }
+
+  mixerDueModules |= due;
+  return (uint16_t)next;
+}
+
+uint8_t mixerSchedulerTakeDueModules()
+{
+  // the trigger is disabled until the mixer task re-enables it,
+  // so the ISR cannot update the bits concurrently
+  uint8_t due = mixerDueModules;
+  mixerDueModules = 0;
+  return due;
+}
+
 void mixerSchedulerISRTrigger()
 {
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
@@ -29,6 +29,12 @@
 #define MIN_REFRESH_RATE       850 /* us */
 #define MAX_REFRESH_RATE     50000 /* us */
 
+// Bits returned by mixerSchedulerTakeDueModules(): one per module
+// whose frame is due, plus one if the mixes have to be computed
+#define MIXER_SCHEDULER_DUE_MODULE(m) (1 << (m))
+#define MIXER_SCHEDULER_DUE_MIXES     0x80
+#define MIXER_SCHEDULER_DUE_ALL       0xFF
+
 #if !defined(SIMU)
 
 // Call once to initialize the mixer scheduler
@@ -61,6 +67,14 @@ uint16_t getMixerSchedulerPeriod();
 // Trigger mixer from an ISR
 void mixerSchedulerISRTrigger();
 
+// Advance the module schedules by the time elapsed since the last
+// trigger and return the delay until the next frame is due (from ISR).
+// With 'resync' the module driving the mixes is due immediately.
+uint16_t mixerSchedulerNextInterval(uint16_t elapsedUs, bool resync);
+
+// Return and clear the due bits collected since the last call
+uint8_t mixerSchedulerTakeDueModules();
+
 #else
 
 #define mixerSchedulerInit()
@@ -76,6 +90,7 @@ void mixerSchedulerISRTrigger();
 
 #define getMixerSchedulerPeriod() (MIXER_SCHEDULER_DEFAULT_PERIOD_US)
 #define mixerSchedulerISRTrigger()
+#define mixerSchedulerTakeDueModules() ((uint8_t)MIXER_SCHEDULER_DUE_ALL)
 
 #endif
 
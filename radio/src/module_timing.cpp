@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "module_timing.h"
+#include "mixer_profiler.h"
+#include "event_trace.h"
+
+struct ModuleTiming {
+  ModuleFrameTiming frames[MODULE_TIMING_RING_SIZE];
+  uint8_t count;
+  uint8_t last;
+  volatile bool due;
+  volatile uint16_t dueTime;
+  volatile uint32_t dropped;
+  uint32_t sent;
+  uint32_t late;
+};
+
+static ModuleTiming moduleTimings[NUM_MODULES];
+
+static uint16_t sticksSampledTime;
+static bool sticksSampled = false;
+
+void moduleTimingSticksSampled(uint16_t time)
+{
+  sticksSampledTime = time;
+  sticksSampled = true;
+}
+
+void moduleTimingDue(uint8_t module)
+{
+  auto & t = moduleTimings[module];
+  t.dueTime = getTmr2MHz();
+  t.due = true;
+}
+
+void moduleTimingDropped(uint8_t module, uint16_t count)
+{
+  moduleTimings[module].dropped += count;
+}
+
+void moduleTimingSent(uint8_t module, uint16_t start, uint16_t end,
+                      uint16_t periodUs)
+{
+  if (module >= NUM_MODULES) return;
+  EVENT_TRACE(EVENT_TRACE_PULSES_TX, module);
+
+  // stick to RF latency: the frame carries the
+  // channels computed from the last sampled sticks
+  uint16_t latency = 0;
+  if (sticksSampled) {
+    latency = end - sticksSampledTime;
+    mixerProfilerRecord(MIXER_STAGE_LATENCY_INT + module, latency);
+  }
+
+  auto & t = moduleTimings[module];
+
+  // frames sent without a trigger (mixer timeout,
+  // simulator) have no reference to be timed against
+  if (!t.due) return;
+  t.due = false;
+
+  uint16_t dueTime = t.dueTime;
+  uint8_t next = (t.last + 1) % MODULE_TIMING_RING_SIZE;
+  auto & frame = t.frames[next];
+  frame.start = (uint16_t)(start - dueTime) / 2;
+  frame.sent = (uint16_t)(end - dueTime) / 2;
+  frame.latency = latency / 2;
+  t.last = next;
+  if (t.count < MODULE_TIMING_RING_SIZE) t.count++;
+
+  t.sent++;
+  if (periodUs && frame.sent > periodUs) {
+    t.late++;
+  }
+}
+
+bool moduleTimingGetFrame(uint8_t module, uint8_t idx,
+                          ModuleFrameTiming & frame)
+{
+  if (module >= NUM_MODULES) return false;
+
+  const auto & t = moduleTimings[module];
+  if (idx >= t.count) return false;
+
+  uint8_t pos = (t.last + MODULE_TIMING_RING_SIZE - idx) % MODULE_TIMING_RING_SIZE;
+  frame = t.frames[pos];
+  return true;
+}
+
+void moduleTimingGetStats(uint8_t module, ModuleTimingStats & stats)
+{
+  const auto & t = moduleTimings[module];
+
+  stats.frames = t.sent;
+  stats.late = t.late;
+  stats.dropped = t.dropped;
+  stats.lastSent = t.count ? t.frames[t.last].sent : 0;
+  stats.lastLatency = t.count ? t.frames[t.last].latency : 0;
+  stats.maxSent = 0;
+  for (uint8_t i = 0; i < t.count; i++) {
+    stats.maxSent = max(stats.maxSent, t.frames[i].sent);
+  }
+}
+
+void moduleTimingReset()
+{
+  for (auto & t : moduleTimings) {
+    t.count = 0;
+    t.last = 0;
+    t.sent = 0;
+    t.late = 0;
+    t.dropped = 0;
+  }
+}
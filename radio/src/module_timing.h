@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Last frames of each module, kept for inspection (CLI)
+#define MODULE_TIMING_RING_SIZE 16
+
+// Timing of one frame, relative to the scheduler trigger
+// that made it due (us)
+struct ModuleFrameTiming {
+  uint16_t start;    // module driver called (mixes done)
+  uint16_t sent;     // frame encoded and transfer started
+  uint16_t latency;  // frame sent, since its sticks were sampled
+};
+
+struct ModuleTimingStats {
+  uint32_t frames;
+  uint32_t late;     // transfer started more than one period after trigger
+  uint32_t dropped;  // scheduled frames that were never sent
+  uint16_t lastSent; // us
+  uint16_t maxSent;  // us, over the last MODULE_TIMING_RING_SIZE frames
+  uint16_t lastLatency; // us, since the sticks were sampled
+};
+
+// Record when the sticks used by the next mixes were sampled (2MHz ticks).
+// Must only be called from the mixer task.
+void moduleTimingSticksSampled(uint16_t time);
+
+// Mark module frame as due (from the scheduler ISR)
+void moduleTimingDue(uint8_t module);
+
+// Account for frames due while the previous
+// one was still pending (from the scheduler ISR)
+void moduleTimingDropped(uint8_t module, uint16_t count);
+
+// Record a frame sent between 'start' and 'end' (2MHz ticks).
+// Must only be called from the mixer task.
+void moduleTimingSent(uint8_t module, uint16_t start, uint16_t end,
+                      uint16_t periodUs);
+
+// Fetch the frame 'idx' frames ago (0 is the last one),
+// returns false if there is none
+bool moduleTimingGetFrame(uint8_t module, uint8_t idx,
+                          ModuleFrameTiming & frame);
+
+// Please note: as mixerProfilerGetStats(), this reads
+//              without locking and is meant for display
+void moduleTimingGetStats(uint8_t module, ModuleTimingStats & stats);
+
+// Clear all counters and frames
+void moduleTimingReset();
@@ -78,6 +78,7 @@
 #define CFN_PLAY_REPEAT_MUL            1
 #define CFN_PLAY_REPEAT_NOSTART        0xFF
 #define CFN_GVAR_MODE(p)               ((p)->all.mode)
+#define CFN_LOGS_PROFILE(p)            ((p)->all.mode)
 #define CFN_PARAM(p)                   ((p)->all.val)
 #define CFN_RESET(p)                   ((p)->active=0, (p)->clear.val1=0, (p)->clear.val2=0)
 #define CFN_GVAR_CST_MIN               -GVAR_MAX
@@ -295,5 +296,8 @@ PACK(union u_int8int16_t {
 constexpr uint8_t EE_GENERAL = 0x01;
 constexpr uint8_t EE_MODEL = 0x02;
 constexpr uint8_t EE_LABELS = 0x04;
+// screens / widgets / current view: saved with the model, but only once
+// they have settled (or along with any other model change)
+constexpr uint8_t EE_SCREENS = 0x08;
 
 #endif // _MYEEPROM_H_
@@ -28,7 +28,9 @@
 
 #include "switches.h"
 #include "inactivity_timer.h"
+#include "power_governor.h"
 #include "input_mapping.h"
+#include "bin_allocator.h"
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
@@ -72,6 +74,60 @@ union ReusableBuffer reusableBuffer __DMA;
 
 uint8_t* MSC_BOT_Data = reusableBuffer.MSC_BOT_Data;
 
+// REUSABLE_BUFFER_MENUS while nobody holds a lease
+static std::atomic<uint8_t> reusableBufferLeaseOwner(REUSABLE_BUFFER_MENUS);
+
+static bool leaseAcquire(std::atomic<uint8_t> & current, uint8_t owner)
+{
+  uint8_t expected = REUSABLE_BUFFER_MENUS;
+  if (current.compare_exchange_strong(expected, owner) || expected == owner)
+    return true;
+  TRACE("Buffer lease by %d refused, held by %d", owner, expected);
+  return false;
+}
+
+static void leaseRelease(std::atomic<uint8_t> & current, uint8_t owner)
+{
+  uint8_t expected = owner;
+  if (!current.compare_exchange_strong(expected, REUSABLE_BUFFER_MENUS)) {
+    TRACE("Buffer released by %d, held by %d", owner, expected);
+  }
+}
+
+bool reusableBufferAcquire(uint8_t owner)
+{
+  if (owner == REUSABLE_BUFFER_MENUS)
+    return reusableBufferLeaseOwner == REUSABLE_BUFFER_MENUS;
+  return leaseAcquire(reusableBufferLeaseOwner, owner);
+}
+
+void reusableBufferRelease(uint8_t owner)
+{
+  if (owner != REUSABLE_BUFFER_MENUS)
+    leaseRelease(reusableBufferLeaseOwner, owner);
+}
+
+uint8_t reusableBufferOwner()
+{
+  return reusableBufferLeaseOwner;
+}
+
+#if defined(SDRAM)
+static uint8_t extendedBuffer[EXTENDED_BUFFER_SIZE] __SDRAM;
+static std::atomic<uint8_t> extendedBufferOwner(REUSABLE_BUFFER_MENUS);
+
+void * extendedBufferLease(uint8_t owner, uint32_t size)
+{
+  if (size > EXTENDED_BUFFER_SIZE) return nullptr;
+  return leaseAcquire(extendedBufferOwner, owner) ? extendedBuffer : nullptr;
+}
+
+void extendedBufferRelease(uint8_t owner)
+{
+  leaseRelease(extendedBufferOwner, owner);
+}
+#endif
+
 #if defined(DEBUG_LATENCY)
 uint8_t latencyToggleSwitch = 0;
 #endif
@@ -206,32 +262,6 @@ void per10ms()
   heartbeat |= HEART_TIMER_10MS;
 }
 
-FlightModeData *flightModeAddress(uint8_t idx)
-{
-  return &g_model.flightModeData[idx];
-}
-
-ExpoData *expoAddress(uint8_t idx )
-{
-  return &g_model.expoData[idx];
-}
-
-MixData *mixAddress(uint8_t idx)
-{
-  return &g_model.mixData[idx];
-}
-
-LimitData *limitAddress(uint8_t idx)
-{
-  return &g_model.limitData[idx];
-}
-
-USBJoystickChData *usbJChAddress(uint8_t idx)
-{
-  return &g_model.usbJoystickCh[idx];
-}
-
-
 void memswap(void * a, void * b, uint8_t size)
 {
   uint8_t * x = (uint8_t *)a;
@@ -526,6 +556,7 @@ void checkBacklight()
     if (requiredBacklightBright == BACKLIGHT_FORCED_ON) {
       currentBacklightBright = g_eeGeneral.getBrightness();
       BACKLIGHT_ENABLE();
+      powerGovernorSetBacklight(true);
     } else {
       bool backlightOn = ((g_eeGeneral.backlightMode == e_backlight_mode_on) ||
                           (g_eeGeneral.backlightMode != e_backlight_mode_off &&
@@ -547,6 +578,7 @@ void checkBacklight()
       } else {
         BACKLIGHT_DISABLE();
       }
+      powerGovernorSetBacklight(backlightOn);
     }
   }
 }
@@ -1552,10 +1584,10 @@ void opentxInit()
     rambackupRestore();
   }
   else {
-    storageReadAll();
+    storageReadAll(true);
   }
 #else
-  storageReadAll();
+  storageReadAll(true);
 #endif
 #endif  // #if !defined(EEPROM)
 
@@ -1615,6 +1647,17 @@ void opentxInit()
   WDG_ENABLE(WDG_DURATION);
 }
 
+// Boot steps the RF link does not depend on: they run in the menus task
+// once the mixer task has been started
+void opentxDeferredInit()
+{
+  TRACE("opentxDeferredInit");
+
+#if !defined(EEPROM) && !defined(STORAGE_MODELSLIST)
+  loadDeferredModelHeaders();
+#endif
+}
+
 #if defined(SEMIHOSTING)
 extern "C" void initialise_monitor_handles();
 #endif
@@ -1887,6 +1930,123 @@ uint32_t availableMemory()
 #endif
 }
 
+static uint32_t minFreeMemory = UINT32_MAX;
+
+uint32_t minAvailableMemory()
+{
+  return minFreeMemory == UINT32_MAX ? availableMemory() : minFreeMemory;
+}
+
+uint32_t largestFreeMemoryBlock()
+{
+#if defined(SIMU)
+  return 1000;
+#else
+  extern unsigned char *heap;
+  extern int _heap_end;
+
+  // the top free chunk and the space not yet claimed by sbrk() are
+  // contiguous; mallinfo() does not tell about bigger holes further down
+  struct mallinfo info = mallinfo();
+
+  return ((uint32_t)((unsigned char *)&_heap_end - heap)) + info.keepcost;
+#endif
+}
+
+void memoryStatsWakeup()
+{
+  // mallinfo() walks the free chunks: once per second is enough
+  static tmr10ms_t lastCheck = 0;
+  tmr10ms_t now = get_tmr10ms();
+  if ((tmr10ms_t)(now - lastCheck) < 100)
+    return;
+  lastCheck = now;
+
+  uint32_t available = availableMemory();
+  if (available < minFreeMemory)
+    minFreeMemory = available;
+}
+
+#if defined(LIBOPENUI) && !defined(SIMU)
+// LVGL allocations (LV_MEM_CUSTOM_ALLOC in lv_conf.h)
+uint32_t lvglMemoryUsage = 0;
+
+#if defined(LVGL_BIN_ALLOCATOR)
+LvglAllocator_slots1 lvglSlots1 __SDRAM;
+LvglAllocator_slots2 lvglSlots2 __SDRAM;
+LvglAllocator_slots3 lvglSlots3 __SDRAM;
+
+static size_t lvglSlotSize(void * ptr)
+{
+  return lvglSlots1.size(ptr) + lvglSlots2.size(ptr) + lvglSlots3.size(ptr);
+}
+
+static void * lvglSlotAlloc(size_t size)
+{
+  void * ptr = lvglSlots1.malloc(size);
+  if (!ptr) ptr = lvglSlots2.malloc(size);
+  if (!ptr) ptr = lvglSlots3.malloc(size);
+  return ptr;
+}
+#endif
+
+static void * lvHeapAlloc(size_t size)
+{
+  void * ptr = malloc(size);
+  if (ptr) lvglMemoryUsage += malloc_usable_size(ptr);
+  return ptr;
+}
+
+extern "C" void * lvMemAlloc(size_t size)
+{
+#if defined(LVGL_BIN_ALLOCATOR)
+  void * ptr = lvglSlotAlloc(size);
+  if (ptr) {
+    lvglMemoryUsage += lvglSlotSize(ptr);
+    return ptr;
+  }
+#endif
+  return lvHeapAlloc(size);
+}
+
+extern "C" void lvMemFree(void * ptr)
+{
+  if (!ptr) return;
+#if defined(LVGL_BIN_ALLOCATOR)
+  size_t slot = lvglSlotSize(ptr);
+  if (slot) {
+    lvglMemoryUsage -= slot;
+    lvglSlots1.free(ptr) || lvglSlots2.free(ptr) || lvglSlots3.free(ptr);
+    return;
+  }
+#endif
+  lvglMemoryUsage -= malloc_usable_size(ptr);
+  free(ptr);
+}
+
+extern "C" void * lvMemRealloc(void * ptr, size_t size)
+{
+  if (!ptr) return lvMemAlloc(size);
+#if defined(LVGL_BIN_ALLOCATOR)
+  size_t slot = lvglSlotSize(ptr);
+  if (slot) {
+    if (size <= slot) return ptr;
+    // outgrown its slot: move it to a bigger class or the heap
+    void * result = lvMemAlloc(size);
+    if (result) {
+      memcpy(result, ptr, slot);
+      lvMemFree(ptr);
+    }
+    return result;
+  }
+#endif
+  size_t previous = malloc_usable_size(ptr);
+  void * result = realloc(ptr, size);
+  if (result) lvglMemoryUsage += malloc_usable_size(result) - previous;
+  return result;
+}
+#endif
+
 // Radio menu tab state
 #if defined(COLORLCD)
 bool radioThemesEnabled() {
@@ -305,6 +305,12 @@ struct CustomFunctionsContext {
   MASK_CFN_TYPE  activeSwitches;
   tmr10ms_t lastFunctionTime[MAX_SPECIAL_FUNCTIONS];
 
+  // indexes of the functions with a switch, rebuilt when the data changes
+  uint8_t usedFunctions[MAX_SPECIAL_FUNCTIONS];
+  uint8_t usedCount;
+  uint16_t usedRevision;
+  bool usedValid;
+
   inline bool isFunctionActive(uint8_t func)
   {
     return activeFunctions & ((MASK_FUNC_TYPE)1 << func);
@@ -435,10 +441,21 @@ extern uint8_t lastFlightMode;
 extern uint8_t flightModeTransitionLast;
 
 extern uint32_t availableMemory();
+// lowest availableMemory() seen by memoryStatsWakeup() since boot
+extern uint32_t minAvailableMemory();
+// contiguous free space at the top of the heap
+extern uint32_t largestFreeMemoryBlock();
+void memoryStatsWakeup();
+#if defined(LIBOPENUI) && !defined(SIMU)
+extern uint32_t lvglMemoryUsage;
+#endif
 
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms);
-void evalMixes(uint8_t tick10ms);
+// tickUs: time since the previous mixer cycle, 0 if only known in 10ms ticks
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms,
+                         bitfield_channels_t channels = (bitfield_channels_t)-1,
+                         uint16_t tickUs = 0);
+void evalMixes(uint8_t tick10ms, uint16_t tickUs = 0);
 void doMixerCalculations();
 void doMixerPeriodicUpdates();
 
@@ -617,7 +634,9 @@ inline void getGVarIncDecRange(int16_t & valMin, int16_t & valMax)
 }
 #endif
 
-void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx=0, int16_t ovwrValue=0);
+// inputs: mask of the inputs to evaluate
+void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx=0, int16_t ovwrValue=0,
+                uint32_t inputs=(uint32_t)-1);
 int16_t applyLimits(uint8_t channel, int32_t value);
 
 void evalInputs(uint8_t mode);
@@ -625,12 +644,36 @@ uint16_t anaIn(uint8_t chan);
 
 #define FLASH_DURATION 20 /*200ms*/
 
-FlightModeData * flightModeAddress(uint8_t idx);
-ExpoData * expoAddress(uint8_t idx);
-MixData * mixAddress(uint8_t idx);
-LimitData * limitAddress(uint8_t idx);
-LogicalSwitchData * lswAddress(uint8_t idx);
-USBJoystickChData * usbJChAddress(uint8_t idx);
+// Model accessors, inline as the mixer calls them for each line and pass
+inline FlightModeData * flightModeAddress(uint8_t idx)
+{
+  return &g_model.flightModeData[idx];
+}
+
+inline ExpoData * expoAddress(uint8_t idx)
+{
+  return &g_model.expoData[idx];
+}
+
+inline MixData * mixAddress(uint8_t idx)
+{
+  return &g_model.mixData[idx];
+}
+
+inline LimitData * limitAddress(uint8_t idx)
+{
+  return &g_model.limitData[idx];
+}
+
+inline LogicalSwitchData * lswAddress(uint8_t idx)
+{
+  return &g_model.logicalSw[idx];
+}
+
+inline USBJoystickChData * usbJChAddress(uint8_t idx)
+{
+  return &g_model.usbJoystickCh[idx];
+}
 
 void applyDefaultTemplate();
 void instantTrim();
@@ -694,6 +737,7 @@ const char* funcGetLabel(uint8_t func);
 #define PLAY_REPEAT(x)            (x)                 /* Range 0 to 15 */
 #define PLAY_NOW                  0x10
 #define PLAY_BACKGROUND           0x20
+#define PLAY_CACHED               0x40                /* system prompt, worth keeping in RAM */
 
 enum AUDIO_SOUNDS {
   AUDIO_HELLO,
@@ -792,6 +836,7 @@ enum AUDIO_SOUNDS {
 
 #if defined(SDCARD)
 #include "sdcard.h"
+#include "text_file.h"
 #endif
 
 #if defined(RTCLOCK)
@@ -802,6 +847,7 @@ enum AUDIO_SOUNDS {
 void checkBattery();
 void opentxClose(uint8_t shutdown=true);
 void opentxInit();
+void opentxDeferredInit();
 void opentxResume();
 
 constexpr uint8_t OPENTX_START_NO_SPLASH = 0x01;
@@ -936,6 +982,9 @@ union ReusableBuffer
   struct {
     uint8_t bars[LCD_W];
     uint8_t max[LCD_W];
+    uint8_t avg[LCD_W];
+    uint16_t changedFrom;
+    uint16_t changedTo;
     uint32_t freq;
     uint32_t span;
     uint32_t step;
@@ -975,6 +1024,7 @@ union ReusableBuffer
     char filename[TEXT_FILENAME_MAXLEN];
     char lines[NUM_BODY_LINES][LCD_COLS + 1];
     int linesCount;
+    TextFileIndex index;
     bool checklistComplete;
     bool pushMenu;
   } viewText;
@@ -1002,6 +1052,43 @@ union ReusableBuffer
 
 extern ReusableBuffer reusableBuffer;
 
+// Arbitration of reusableBuffer. The menus are its default owner and use
+// it without a lease. Any other user first leases it, and gets nullptr
+// while another owner holds it.
+enum ReusableBufferOwner : uint8_t {
+  REUSABLE_BUFFER_MENUS,    // default owner, no lease needed
+  REUSABLE_BUFFER_MSC,      // USB mass storage
+  REUSABLE_BUFFER_SCRATCH,  // scratch space for caches and the like
+};
+
+bool reusableBufferAcquire(uint8_t owner);
+void reusableBufferRelease(uint8_t owner);
+uint8_t reusableBufferOwner();
+
+// Typed lease of one member, e.g.
+//   auto sd = reusableBufferLease(owner, &ReusableBuffer::sdManager);
+template <class T>
+T * reusableBufferLease(uint8_t owner, T ReusableBuffer::* member)
+{
+  return reusableBufferAcquire(owner) ? &(reusableBuffer.*member) : nullptr;
+}
+
+#if defined(SDRAM)
+// Extended arena in SDRAM, for scratch buffers bigger than reusableBuffer.
+// Leased in one piece, with the same owners.
+#define EXTENDED_BUFFER_SIZE  (256 * 1024)
+
+void * extendedBufferLease(uint8_t owner, uint32_t size);
+void extendedBufferRelease(uint8_t owner);
+
+template <class T>
+T * extendedBufferLease(uint8_t owner)
+{
+  static_assert(sizeof(T) <= EXTENDED_BUFFER_SIZE, "Extended buffer too small");
+  return (T *)extendedBufferLease(owner, sizeof(T));
+}
+#endif
+
 uint8_t zlen(const char *str, uint8_t size);
 bool zexist(const char *str, uint8_t size);
 char * strcat_zchar(char *dest, const char *name, uint8_t size, const char spaceSym = 0, const char *defaultName=nullptr, uint8_t defaultNameSize=0, uint8_t defaultIdx=0);
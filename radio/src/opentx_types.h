@@ -75,6 +75,11 @@ struct rect_t
   {
     return left() <= other.left() && right() >= other.right() && top() <= other.top() && bottom() >= other.bottom();
   }
+
+  bool operator != (const rect_t & b) const
+  {
+    return x != b.x || y != b.y || w != b.w || h != b.h;
+  }
 };
 
 static const rect_t nullRect = {0, 0, 0, 0};
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// Hands out fixed size blocks carved from chunks of BLOCKS_PER_CHUNK.
+// Freed blocks are kept on a free list for the next allocation and chunks
+// are never returned: long lived objects that are frequently replaced
+// (models list entries) stay packed together instead of fragmenting the
+// heap shared with Lua.
+template <size_t BLOCK_SIZE, size_t BLOCKS_PER_CHUNK>
+class BlockPool
+{
+  union Block {
+    Block* next;
+    alignas(max_align_t) char data[BLOCK_SIZE];
+  };
+
+  struct Chunk {
+    Chunk* next;
+    Block blocks[BLOCKS_PER_CHUNK];
+  };
+
+  Chunk* chunks = nullptr;
+  Block* freeList = nullptr;
+  size_t used = 0;
+
+  void grow()
+  {
+    auto chunk = (Chunk*)::malloc(sizeof(Chunk));
+    if (!chunk) return;
+    chunk->next = chunks;
+    chunks = chunk;
+    for (size_t i = 0; i < BLOCKS_PER_CHUNK; i++) {
+      chunk->blocks[i].next = freeList;
+      freeList = &chunk->blocks[i];
+    }
+  }
+
+ public:
+  void* alloc()
+  {
+    if (!freeList) grow();
+    Block* block = freeList;
+    if (block) {
+      freeList = block->next;
+      used++;
+    }
+    return block;
+  }
+
+  void free(void* ptr)
+  {
+    if (!ptr) return;
+    auto block = (Block*)ptr;
+    block->next = freeList;
+    freeList = block;
+    used--;
+  }
+
+  size_t size() const { return used; }
+
+  size_t capacity() const
+  {
+    size_t n = 0;
+    for (auto chunk = chunks; chunk; chunk = chunk->next) {
+      n += BLOCKS_PER_CHUNK;
+    }
+    return n;
+  }
+};
+
+// Standard allocator backed by one BlockPool per object type, for node
+// based containers (std::map, std::set, std::list) which allocate their
+// nodes one by one. Bulk allocations go to the heap as usual.
+template <class T, size_t BLOCKS_PER_CHUNK = 16>
+struct PoolAllocator {
+  typedef T value_type;
+
+  template <class U>
+  struct rebind {
+    typedef PoolAllocator<U, BLOCKS_PER_CHUNK> other;
+  };
+
+  PoolAllocator() = default;
+
+  template <class U>
+  PoolAllocator(const PoolAllocator<U, BLOCKS_PER_CHUNK>&)
+  {
+  }
+
+  static BlockPool<sizeof(T), BLOCKS_PER_CHUNK>& pool()
+  {
+    static BlockPool<sizeof(T), BLOCKS_PER_CHUNK> _pool;
+    return _pool;
+  }
+
+  T* allocate(size_t n)
+  {
+    if (n == 1) return (T*)pool().alloc();
+    return (T*)::malloc(n * sizeof(T));
+  }
+
+  void deallocate(T* ptr, size_t n)
+  {
+    if (n == 1)
+      pool().free(ptr);
+    else
+      ::free(ptr);
+  }
+
+  template <class U>
+  bool operator==(const PoolAllocator<U, BLOCKS_PER_CHUNK>&) const
+  {
+    return true;
+  }
+
+  template <class U>
+  bool operator!=(const PoolAllocator<U, BLOCKS_PER_CHUNK>&) const
+  {
+    return false;
+  }
+};
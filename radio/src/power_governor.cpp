@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "power_governor.h"
+
+#if defined(LIBOPENUI)
+#include "LvglWrapper.h"
+#endif
+
+static bool backlightOn = true;
+static bool powerSave = false;
+
+// 2MHz timer ticks spent in sleep, only ever incremented by the idle hook
+static volatile uint32_t sleepTicks = 0;
+static uint32_t windowSleepTicks = 0;
+static tmr10ms_t windowStart = 0;
+static uint16_t sleepLoad = 0;
+
+#if defined(LIBOPENUI)
+static uint8_t savedFps = 0;
+#endif
+
+void powerGovernorSetBacklight(bool on)
+{
+  backlightOn = on;
+}
+
+static bool displayDark()
+{
+  if (backlightOn) return false;
+#if defined(COLORLCD)
+  // the backlight off brightness might still leave the screen readable
+  if (g_eeGeneral.blOffBright != BACKLIGHT_LEVEL_MIN) return false;
+#endif
+  return true;
+}
+
+static bool powerSaveAllowed()
+{
+  if (!displayDark() || usbPlugged()) return false;
+#if defined(LUA)
+  // model scripts are run from the menus task at its usual rate
+  if (luaScriptsCount > 0) return false;
+#endif
+  return true;
+}
+
+static void powerSaveEnter()
+{
+#if defined(LIBOPENUI)
+  auto lvgl = LvglWrapper::instance();
+  savedFps = lvgl->getTargetFps();
+  lvgl->setTargetFps(LCD_MIN_FPS);
+#endif
+  powerSave = true;
+  TRACE("Power save on");
+}
+
+static void powerSaveLeave()
+{
+  powerSave = false;
+#if defined(LIBOPENUI)
+  LvglWrapper::instance()->setTargetFps(savedFps);
+#endif
+  TRACE("Power save off");
+}
+
+void powerGovernorUpdate()
+{
+  bool allowed = powerSaveAllowed();
+  if (allowed && !powerSave)
+    powerSaveEnter();
+  else if (!allowed && powerSave)
+    powerSaveLeave();
+
+  tmr10ms_t now = get_tmr10ms();
+  tmr10ms_t elapsed = now - windowStart;
+  if (elapsed >= 100) {
+    uint32_t ticks = sleepTicks;
+    uint32_t slept = ticks - windowSleepTicks;
+    windowSleepTicks = ticks;
+    windowStart = now;
+    // 20000 ticks of the 2MHz timer per 10ms
+    sleepLoad = min<uint32_t>(1000, (uint64_t)slept * 1000 / (elapsed * 20000));
+  }
+}
+
+bool powerSaveActive()
+{
+  return powerSave;
+}
+
+uint16_t powerSaveSleepLoad()
+{
+  return sleepLoad;
+}
+
+uint16_t powerSaveEstimatedSaving()
+{
+  return (uint32_t)sleepLoad * POWER_SAVE_SLEEP_SAVING_MA / 1000;
+}
+
+#if !defined(SIMU)
+// FreeRTOS idle hook: sleep until the next interrupt. Only in power save,
+// the cycle counter used by the task statistics stops while sleeping.
+extern "C" void vApplicationIdleHook()
+{
+  if (!powerSave) return;
+
+  uint16_t start = getTmr2MHz();
+  __DSB();
+  __WFI();
+  sleepTicks += (uint16_t)(getTmr2MHz() - start);
+}
+#endif
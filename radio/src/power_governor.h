@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+// Power governor: while the display is dark and nothing needs the UI,
+// the menus task runs less often, the display is refreshed at a lower
+// rate, the Lua widgets are not redrawn and the CPU sleeps (WFI)
+// whenever the RTOS is idle. The mixer and the pulses run from their
+// own timer interrupts, which wake the CPU: their timing is unchanged.
+
+#define POWER_SAVE_MENUS_PERIOD_MS   200
+
+// Estimated difference between the MCU run and sleep currents
+#if !defined(POWER_SAVE_SLEEP_SAVING_MA)
+  #define POWER_SAVE_SLEEP_SAVING_MA 30
+#endif
+
+// Called from checkBacklight() with the current backlight state
+void powerGovernorSetBacklight(bool on);
+
+// Called from the menus task, once per cycle
+void powerGovernorUpdate();
+
+bool powerSaveActive();
+
+// Time spent in sleep over the last second, in 0.1% steps
+uint16_t powerSaveSleepLoad();
+
+// Estimated current saved over the last second (mA)
+uint16_t powerSaveEstimatedSaving();
@@ -425,6 +425,9 @@ void ProtoState::setupFrame()
   // Process backlog, not check states
   if (trsp.processQueue()) return;
 
+  // Re-send timed out config requests
+  if (trsp.processWindow()) return;
+
   ::ModuleSettingsMode moduleMode = getModuleMode(module_index);
 
   if (moduleMode == ::ModuleSettingsMode::MODULE_MODE_BIND) {
@@ -520,7 +523,13 @@ void ProtoState::setupFrame()
           int16_t failSafe[18];
           setFailSafe(&failSafe[0], len);
           std::memcpy( &data[3], failSafe, 2*len );
-          trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, 2*len+3);
+          if (trsp.isRequestPending(RX_CMD_FAILSAFE_VALUE) ||
+              !trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, 2*len+3)) {
+            sendChannelsData();
+          }
+      }
+      else {
+          sendChannelsData();
       }
     } else {
       trsp.putFrame(cmd, FRAME_TYPE::REQUEST_GET_DATA);
@@ -796,59 +805,63 @@ bool ProtoState::syncSettings()
 
   auto *cfg = this->getConfig();
 
-  // Handles old receivers bug
+  // Commands are windowed: skip the ones still in flight and go on with
+  // the next dirty one, channels data is sent when the window is full
+  if (!trsp.hasFreeRequestSlot()) return false;
+
+  // Handles old receivers bug, other commands depend on RX version
   if ( checkDirtyFlag(DC_RX_CMD_GET_RX_VERSION) )
   {
+    if (trsp.isRequestPending(RX_CMD_GET_VERSION)) return false;
     uint8_t data[] = { (uint8_t)(RX_CMD_GET_VERSION&0xFF), (uint8_t)((RX_CMD_GET_VERSION>>8)&0xFF), 0x00 };
-    trsp.putFrame( COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data) );
-    return true;
+    return trsp.putRequest( COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data) );
   }
   // Sync settings when dirty flag is set
-  if (checkDirtyFlag(DC_RX_CMD_TX_PWR))
+  if (checkDirtyFlag(DC_RX_CMD_TX_PWR) && !trsp.isRequestPending(RX_CMD_TX_PWR))
   {
     TRACE("AFHDS3 [RX_CMD_TX_PWR] %d", AFHDS3_POWER[moduleData->afhds3.rfPower] / 4);
     uint8_t data[] = { (uint8_t)(RX_CMD_TX_PWR&0xFF), (uint8_t)((RX_CMD_TX_PWR>>8)&0xFF), 2,
                        (uint8_t)(AFHDS3_POWER[moduleData->afhds3.rfPower]&0xFF),  (uint8_t)((AFHDS3_POWER[moduleData->afhds3.rfPower]>>8)&0xFF)};
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     clearDirtyFlag(DC_RX_CMD_TX_PWR);
     return true;
   }
 
-  if (checkDirtyFlag(DC_RX_CMD_RSSI_CHANNEL_SETUP))
+  if (checkDirtyFlag(DC_RX_CMD_RSSI_CHANNEL_SETUP) && !trsp.isRequestPending(RX_CMD_RSSI_CHANNEL_SETUP))
   {
     TRACE("AFHDS3 [RX_CMD_RSSI_CHANNEL_SETUP]");
     uint8_t data[] = { (uint8_t)(RX_CMD_RSSI_CHANNEL_SETUP&0xFF), (uint8_t)((RX_CMD_RSSI_CHANNEL_SETUP>>8)&0xFF), 1, cfg->v1.SignalStrengthRCChannelNb };
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     return true;
   }
 
-  if (checkDirtyFlag(DC_RX_CMD_OUT_PWM_PPM_MODE))
+  if (checkDirtyFlag(DC_RX_CMD_OUT_PWM_PPM_MODE) && !trsp.isRequestPending(RX_CMD_OUT_PWM_PPM_MODE))
   {
     TRACE("AFHDS3 [RX_CMD_OUT_PWM_PPM_MODE]");
     uint8_t data[] = { (uint8_t)(RX_CMD_OUT_PWM_PPM_MODE&0xFF), (uint8_t)((RX_CMD_OUT_PWM_PPM_MODE>>8)&0xFF), 1, cfg->v0.AnalogOutput };
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     return true;
   }
-  if (checkDirtyFlag(DC_RX_CMD_FREQUENCY_V0))
+  if (checkDirtyFlag(DC_RX_CMD_FREQUENCY_V0) && !trsp.isRequestPending(RX_CMD_FREQUENCY_V0))
   {
     TRACE("AFHDS3 [RX_CMD_FREQUENCY_V0]");
     uint16_t Frequency = ((cfg->v0.PWMFrequency.Synchronized<<15)| cfg->v0.PWMFrequency.Frequency);
     uint8_t data[] = { (uint8_t)(RX_CMD_FREQUENCY_V0&0xFF), (uint8_t)((RX_CMD_FREQUENCY_V0>>8)&0xFF), 2,
                         (uint8_t)(Frequency&0xFF), (uint8_t)((Frequency>>8)&0xFF) };
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     return true;
   }
 
-  if (checkDirtyFlag(DC_RX_CMD_PORT_TYPE_V1))
+  if (checkDirtyFlag(DC_RX_CMD_PORT_TYPE_V1) && !trsp.isRequestPending(RX_CMD_PORT_TYPE_V1))
   {
     TRACE("AFHDS3 [RX_CMD_PORT_TYPE_V1]");
     uint8_t data[] = { (uint8_t)(RX_CMD_PORT_TYPE_V1&0xFF), (uint8_t)((RX_CMD_PORT_TYPE_V1>>8)&0xFF), 4, 0, 0, 0, 0 };
     std::memcpy(&data[3], &cfg->v1.NewPortTypes, SES_NPT_NB_MAX_PORTS);
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     return true;
   }
 
-  if (checkDirtyFlag(DC_RX_CMD_FREQUENCY_V1))
+  if (checkDirtyFlag(DC_RX_CMD_FREQUENCY_V1) && !trsp.isRequestPending(RX_CMD_FREQUENCY_V1))
   {
     TRACE("AFHDS3 [RX_CMD_FREQUENCY_V1]");
     uint8_t data[32 + 3 + 3] = { (uint8_t)(RX_CMD_FREQUENCY_V1&0xFF), (uint8_t)((RX_CMD_FREQUENCY_V1>>8)&0xFF), 32+3};
@@ -856,12 +869,12 @@ bool ProtoState::syncSettings()
     std::memcpy(&data[4], &cfg->v1.PWMFrequenciesV1.PWMFrequencies[0], 32);
     data[36] = cfg->v1.PWMFrequenciesV1.Synchronized & 0xff;
     data[37] = (cfg->v1.PWMFrequenciesV1.Synchronized>>8) & 0xff;
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     DIRTY_CMD(cfg, DC_RX_CMD_FREQUENCY_V1_2);
     return true;
   }
 
-  if (checkDirtyFlag(DC_RX_CMD_FREQUENCY_V1_2))
+  if (checkDirtyFlag(DC_RX_CMD_FREQUENCY_V1_2) && !trsp.isRequestPending(RX_CMD_FREQUENCY_V1_2))
   {
     TRACE("AFHDS3 [RX_CMD_FREQUENCY_V1_2]");
     uint8_t data[32 + 3 + 3] = { (uint8_t)(RX_CMD_FREQUENCY_V1_2&0xFF), (uint8_t)((RX_CMD_FREQUENCY_V1_2>>8)&0xFF), 32+3};
@@ -869,7 +882,7 @@ bool ProtoState::syncSettings()
     std::memcpy(&data[4], &cfg->v1.PWMFrequenciesV1.PWMFrequencies[16], 32);
     data[36] = (cfg->v1.PWMFrequenciesV1.Synchronized>>16) & 0xff;
     data[37] = (cfg->v1.PWMFrequenciesV1.Synchronized>>24) & 0xff;
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     return true;
   }
 
@@ -887,7 +900,7 @@ bool ProtoState::syncSettings()
     clearDirtyFlag(DC_RX_CMD_BUS_TYPE_V0);
   }
 
-  if (checkDirtyFlag(DC_RX_CMD_BUS_TYPE_V0_2))
+  if (checkDirtyFlag(DC_RX_CMD_BUS_TYPE_V0_2) && !trsp.isRequestPending(RX_CMD_BUS_TYPE_V0))
   {
     TRACE("AFHDS3 [RX_CMD_BUS_TYPE_V0]");
     bool onlySupportIBUSOut = (1==receiver_type(rx_version.ProductNumber));
@@ -899,12 +912,12 @@ bool ProtoState::syncSettings()
 
     uint8_t data[] = { (uint8_t)(RX_CMD_BUS_TYPE_V0&0xFF), (uint8_t)((RX_CMD_BUS_TYPE_V0>>8)&0xFF), 1,
                        cfg->others.ExternalBusType == EB_BT_SBUS1 ? EB_BT_SBUS1 : EB_BT_IBUS1};
-    trsp.putFrame(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
 
     return true;
   }
 
-  if (checkDirtyFlag(DC_RX_CMD_BUS_DIRECTION))
+  if (checkDirtyFlag(DC_RX_CMD_BUS_DIRECTION) && !trsp.isRequestPending(RX_CMD_IBUS_DIRECTION))
   {
     static uint8_t bus_dir;
 
@@ -914,7 +927,7 @@ bool ProtoState::syncSettings()
         bus_dir = BUS_IN;
     TRACE("AFHDS3 [RX_CMD_IBUS_DIRECTION]");
     uint8_t data[4] = { (uint8_t)(RX_CMD_IBUS_DIRECTION&0xFF), (uint8_t)((RX_CMD_IBUS_DIRECTION>>8)&0xFF), 1, bus_dir };
-    trsp.putFrame( COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data) );
+    trsp.putRequest(COMMAND::SEND_COMMAND, FRAME_TYPE::REQUEST_SET_EXPECT_DATA, data, sizeof(data));
     return true;
   }
 
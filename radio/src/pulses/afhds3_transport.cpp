@@ -26,6 +26,7 @@
 #include "board.h"
 #include "dataconstants.h"
 #include "mixer_scheduler.h"
+#include "timers_driver.h"
 
 // timer is 2 MHz
 #if defined(AFHDS3_SLOW)
@@ -38,6 +39,11 @@
 
 #define MAX_RETRIES_AFHDS3 5
 
+// windowed requests: time to wait for the response before re-sending,
+// and for the COMMAND_RESULT once the response has been received
+#define REQUEST_TIMEOUT_AFHDS3 5   // 50ms
+#define RESULT_TIMEOUT_AFHDS3  100 // 1s
+
 namespace afhds3
 {
 
@@ -229,6 +235,8 @@ void Transport::clear()
   // reset command layer
   fifo.clearCommandFifo();
 
+  clearWindow();
+
   frameIndex = 1;
   repeatCount = 0;
 
@@ -262,6 +270,135 @@ void Transport::enqueue(COMMAND command, FRAME_TYPE frameType, bool useData,
   fifo.enqueue(command, frameType, useData, byteContent);
 }
 
+void Transport::clearWindow()
+{
+  for (auto& req : window) {
+    req.command = COMMAND::UNDEFINED;
+  }
+}
+
+bool Transport::hasFreeRequestSlot() const
+{
+  for (const auto& req : window) {
+    if (req.isFree()) return true;
+  }
+  return false;
+}
+
+bool Transport::isRequestPending(uint16_t rxCommand) const
+{
+  for (const auto& req : window) {
+    if (req.command == COMMAND::SEND_COMMAND &&
+        req.rxCommand() == rxCommand) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Transport::putRequest(COMMAND command, FRAME_TYPE frameType,
+                           uint8_t* data, uint8_t dataLength)
+{
+  if (dataLength > AFHDS3_MAX_REQUEST_DATA) return false;
+
+  for (auto& req : window) {
+    if (!req.isFree()) continue;
+
+    req.command = command;
+    req.frameType = frameType;
+    req.frameNumber = frameIndex;
+    req.dataLength = dataLength;
+    req.retries = 0;
+    req.acked = false;
+    req.timeout = get_tmr10ms() + REQUEST_TIMEOUT_AFHDS3;
+    memcpy(req.data, data, dataLength);
+
+    trsp.putFrame(command, frameType, data, dataLength, frameIndex);
+    frameIndex++;
+    return true;
+  }
+
+  return false;
+}
+
+bool Transport::processWindow()
+{
+  tmr10ms_t now = get_tmr10ms();
+
+  for (auto& req : window) {
+    if (req.isFree() || (int32_t)(now - req.timeout) < 0) continue;
+
+    if (req.acked) {
+      // no result: the owner will issue the command again if still needed
+      TRACE("AFHDS3 [NO RESULT] frame %02X", req.frameNumber);
+      req.command = COMMAND::UNDEFINED;
+      continue;
+    }
+
+    if (req.retries++ >= MAX_RETRIES_AFHDS3) {
+      TRACE("AFHDS3 [NO RESP] frame %02X", req.frameNumber);
+      req.command = COMMAND::UNDEFINED;
+      continue;
+    }
+
+    // re-send with the same frame number, one frame per cycle
+    req.timeout = now + REQUEST_TIMEOUT_AFHDS3;
+    trsp.putFrame(req.command, req.frameType, req.data, req.dataLength,
+                  req.frameNumber);
+    return true;
+  }
+
+  return false;
+}
+
+bool Transport::acknowledgeRequest(uint8_t command, uint8_t frameNumber,
+                                   bool exactMatch)
+{
+  PendingRequest* match = nullptr;
+
+  for (auto& req : window) {
+    if (req.isFree() || req.acked || req.command != command) continue;
+    if (req.frameNumber == frameNumber) {
+      match = &req;
+      break;
+    }
+    // otherwise the oldest outstanding request for this command
+    if (!exactMatch &&
+        (!match || (int8_t)(req.frameNumber - match->frameNumber) < 0)) {
+      match = &req;
+    }
+  }
+
+  if (!match) return false;
+
+  if (match->command == COMMAND::SEND_COMMAND) {
+    match->acked = true;
+    match->timeout = get_tmr10ms() + RESULT_TIMEOUT_AFHDS3;
+  } else {
+    match->command = COMMAND::UNDEFINED;
+  }
+
+  return true;
+}
+
+void Transport::completeRequest(uint16_t rxCommand)
+{
+  PendingRequest* match = nullptr;
+
+  for (auto& req : window) {
+    if (req.command != COMMAND::SEND_COMMAND ||
+        req.rxCommand() != rxCommand) {
+      continue;
+    }
+    // results are returned in order
+    if (!match || (int8_t)(req.frameNumber - match->frameNumber) < 0) {
+      match = &req;
+    }
+  }
+
+  if (match) match->command = COMMAND::UNDEFINED;
+}
+
 void Transport::sendBuffer()
 {
 #if !defined(SIMU)
@@ -321,6 +458,11 @@ bool Transport::handleReply(uint8_t* buffer, uint8_t len)
   // TODO: check len...
 
   AfhdsFrame* responseFrame = reinterpret_cast<AfhdsFrame*>(buffer);
+  if (responseFrame->command == COMMAND::COMMAND_RESULT && len > 7) {
+    uint8_t* data = &responseFrame->value;
+    completeRequest(data[0] | (data[1] << 8));
+  }
+
   if (responseFrame->frameType == FRAME_TYPE::REQUEST_SET_EXPECT_ACK) {
 
     // check if such request is not queued
@@ -345,8 +487,16 @@ bool Transport::handleReply(uint8_t* buffer, uint8_t len)
   } else if (responseFrame->frameType == FRAME_TYPE::RESPONSE_DATA ||
              responseFrame->frameType == FRAME_TYPE::RESPONSE_ACK) {
 
-    if (operationState == State::AWAITING_RESPONSE) {
-      operationState = State::IDLE;
+    auto command = responseFrame->command;
+    auto frameNumber = responseFrame->frameNumber;
+
+    if (!acknowledgeRequest(command, frameNumber, true)) {
+      if (operationState == State::AWAITING_RESPONSE) {
+        operationState = State::IDLE;
+      } else {
+        // module not echoing the frame number
+        acknowledgeRequest(command, frameNumber, false);
+      }
     }
   }
 
@@ -89,6 +89,30 @@ struct Frame {
   uint8_t payloadSize;
 };
 
+// number of config requests that may be outstanding at the same time
+#define AFHDS3_REQUEST_WINDOW 4
+
+// largest request payload kept for retransmission (failsafe values)
+#define AFHDS3_MAX_REQUEST_DATA 40
+
+// windowed request, kept until the module has answered it
+struct PendingRequest {
+  enum COMMAND command;
+  enum FRAME_TYPE frameType;
+  uint8_t frameNumber;
+  uint8_t dataLength;
+  uint8_t retries;
+  // response received, waiting for COMMAND_RESULT
+  bool acked;
+  // 10ms ticks
+  uint32_t timeout;
+  uint8_t data[AFHDS3_MAX_REQUEST_DATA];
+
+  inline bool isFree() const { return command == COMMAND::UNDEFINED; }
+
+  inline uint16_t rxCommand() const { return data[0] | (data[1] << 8); }
+};
+
 union AfhdsFrameData;
 
 PACK(struct AfhdsFrame {
@@ -189,8 +213,20 @@ class Transport
    */
   uint16_t repeatCount;
 
+  /**
+   * Config requests sent without waiting for the previous ones to be answered
+   */
+  PendingRequest window[AFHDS3_REQUEST_WINDOW];
+
   bool handleReply(uint8_t* buffer, uint8_t len);
 
+  void clearWindow();
+
+  bool acknowledgeRequest(uint8_t command, uint8_t frameNumber,
+                          bool exactMatch);
+
+  void completeRequest(uint16_t rxCommand);
+
  public:
   void init(void* buffer, etx_module_state_t* mod_st, uint8_t fAddr);
 
@@ -202,6 +238,20 @@ class Transport
   void enqueue(COMMAND command, FRAME_TYPE frameType, bool useData = false,
                uint8_t byteContent = 0);
 
+  /**
+   * Send a request tracked in the window instead of blocking until answered
+   * @return false if the window is full
+   */
+  bool putRequest(COMMAND command, FRAME_TYPE frameType, uint8_t* data,
+                  uint8_t dataLength);
+
+  bool hasFreeRequestSlot() const;
+
+  /**
+   * Check if a SEND_COMMAND request for rxCommand is still outstanding
+   */
+  bool isRequestPending(uint16_t rxCommand) const;
+
   void sendBuffer();
 
   /**
@@ -217,6 +267,12 @@ class Transport
    */
   bool processQueue();
 
+  /**
+   * Re-send windowed requests whose response timed out
+   * @return true if something was just sent
+   */
+  bool processWindow();
+
   bool processTelemetryData(uint8_t byte, uint8_t* rxBuffer,
                             uint8_t& rxBufferCount, uint8_t maxSize);
 };
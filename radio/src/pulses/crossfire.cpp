@@ -27,7 +27,6 @@
 #include "crossfire.h"
 #include "telemetry/crossfire.h"
 
-#define CROSSFIRE_CH_BITS           11
 #define CROSSFIRE_CENTER            0x3E0
 #if defined(PPM_CENTER_ADJUSTABLE)
   #define CROSSFIRE_CENTER_CH_OFFSET(ch)            ((2 * limitAddress(ch)->ppmCenter) + 1)  // + 1 is for rouding
@@ -60,18 +59,11 @@ uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses)
   *buf++ = 24; // 1(ID) + 22 + 1(CRC)
   uint8_t * crc_start = buf;
   *buf++ = CHANNELS_ID;
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  uint16_t values[CROSSFIRE_CHANNELS_COUNT];
   for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
-    uint32_t val = limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulses[i] * 4) / 5, 2 * CROSSFIRE_CENTER);
-    bits |= val << bitsavailable;
-    bitsavailable += CROSSFIRE_CH_BITS;
-    while (bitsavailable >= 8) {
-      *buf++ = bits;
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    values[i] = limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulses[i] * 4) / 5, 2 * CROSSFIRE_CENTER);
   }
+  buf = pack11BitChannels(buf, values, CROSSFIRE_CHANNELS_COUNT);
   *buf++ = crc8(crc_start, 23);
   return buf - frame;
 }
@@ -80,15 +72,14 @@ static void setupPulsesCrossfire(uint8_t module, uint8_t*& p_buf,
                                  uint8_t endpoint, int16_t* channels,
                                  uint8_t nChannels)
 {
-#if defined(LUA)
+  // frames from Lua scripts or from the parameters browser
   if (outputTelemetryBuffer.destination == endpoint) {
     auto len = outputTelemetryBuffer.size;
     memcpy(p_buf, outputTelemetryBuffer.data, len);
+    LOG_TELEMETRY_TX(module, p_buf, len);
     outputTelemetryBuffer.reset();
     p_buf += len;
-  } else
-#endif
-  {
+  } else {
     if (moduleState[module].counter == CRSF_FRAME_MODELID) {
       p_buf += createCrossfireModelIDFrame(module, p_buf);
       moduleState[module].counter = CRSF_FRAME_MODELID_SENT;
@@ -169,6 +160,28 @@ static void _seekStart(uint8_t* buffer, uint8_t* len)
   *len = 0;
 }
 
+static void crossfireCheckFrame(void* ctx, uint8_t* buffer, uint8_t* len)
+{
+  // rxBuffer[1] holds the packet length-2, check if the whole packet was received
+  while (*len > 4 && (buffer[1]+2) == *len) {
+    if (_checkFrameCRC(buffer)) {
+#if defined(BLUETOOTH) // TODO: generic telemetry mirror to BT
+      if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
+          bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
+        bluetooth.write(buffer, *len);
+      }
+#endif
+      auto mod_st = (etx_module_state_t*)ctx;
+      processCrossfireTelemetryFrame(modulePortGetModule(mod_st));
+      *len = 0;
+    }
+    else {
+      TRACE("[XF] CRC error ");
+      _seekStart(buffer, len); // adjusts len
+    }
+  }
+}
+
 static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
 {
   if (*len == 0 && data != RADIO_ADDRESS && data != UART_SYNC) {
@@ -190,22 +203,54 @@ static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8
     *len = 0;
   }
 
-  // rxBuffer[1] holds the packet length-2, check if the whole packet was received
-  while (*len > 4 && (buffer[1]+2) == *len) {
-    if (_checkFrameCRC(buffer)) {
-#if defined(BLUETOOTH) // TODO: generic telemetry mirror to BT
-      if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
-          bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
-        bluetooth.write(buffer, *len);
+  crossfireCheckFrame(ctx, buffer, len);
+}
+
+// Same as crossfireProcessData(), but the frame body is copied at once
+// using the length byte instead of going through the parser byte by byte
+static void crossfireProcessSpan(void* ctx, const uint8_t* data, uint32_t size,
+                                 uint8_t* buffer, uint8_t* len)
+{
+  while (size > 0) {
+    if (*len == 0) {
+      // skip up to the next frame start
+      while (size > 0 && *data != RADIO_ADDRESS && *data != UART_SYNC) {
+        data++;
+        size--;
       }
-#endif
-      auto mod_st = (etx_module_state_t*)ctx;
-      processCrossfireTelemetryFrame(modulePortGetModule(mod_st));
-      *len = 0;
+      if (size == 0) break;
+      buffer[(*len)++] = *data++;
+      size--;
+      continue;
     }
-    else {
-      TRACE("[XF] CRC error ");
-      _seekStart(buffer, len); // adjusts len
+
+    if (*len == 1) {
+      if (!_lenIsSane(*data)) {
+        TRACE("[XF] length 0x%02X error", *data);
+        *len = 0;
+      } else {
+        buffer[(*len)++] = *data;
+      }
+      data++;
+      size--;
+      continue;
+    }
+
+    uint8_t frameLen = buffer[1] + 2;
+    if (*len < frameLen) {
+      uint32_t count = min<uint32_t>(frameLen - *len, size);
+      memcpy(&buffer[*len], data, count);
+      *len += count;
+      data += count;
+      size -= count;
+    }
+
+    if (*len == frameLen) {
+      crossfireCheckFrame(ctx, buffer, len);
+    } else if (*len > frameLen) {
+      // left over by a resync: drop it
+      TRACE("[XF] frame length %d error", *len);
+      *len = 0;
     }
   }
 }
@@ -257,4 +302,5 @@ const etx_proto_driver_t CrossfireDriver = {
   .deinit = crossfireDeInit,
   .sendPulses = crossfireSendPulses,
   .processData = crossfireProcessData,
+  .processSpan = crossfireProcessSpan,
 };
@@ -204,6 +204,7 @@ static void ghostSendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8
       p_data += 12; f_data += 12;
       len -= 12;
     }
+    LOG_TELEMETRY_TX(module, buffer, p_data - buffer);
     outputTelemetryBuffer.reset();
   } else
 #endif
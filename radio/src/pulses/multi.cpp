@@ -35,7 +35,6 @@
 #define MULTI_SEND_AUTOBIND                 (1 << 6)
 
 #define MULTI_CHANS                         16
-#define MULTI_CHAN_BITS                     11
 
 #define MULTI_NORMAL   0x00
 #define MULTI_FAILSAFE 0x01
@@ -81,8 +80,7 @@ static void updateMultiSync(uint8_t module)
 
 static void sendFailsafeChannels(uint8_t*& p_buf, uint8_t module)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  uint16_t values[MULTI_CHANS];
 
   for (int i = 0; i < MULTI_CHANS; i++) {
     int16_t failsafeValue = g_model.failsafeChannels[i];
@@ -102,14 +100,10 @@ static void sendFailsafeChannels(uint8_t*& p_buf, uint8_t module)
       pulseValue = limit(1, (failsafeValue * 800 / 1000) + 1024, 2046);
     }
 
-    bits |= pulseValue << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendMulti(p_buf, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    values[i] = pulseValue;
   }
+
+  p_buf = pack11BitChannels(p_buf, values, MULTI_CHANS);
 }
 
 static void setupPulsesMulti(uint8_t*& p_buf, uint8_t module)
@@ -283,6 +277,14 @@ static void multiProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t*
   processMultiTelemetryData(data, module);
 }
 
+static void multiProcessQueued(void* ctx)
+{
+  auto mod_st = (etx_module_state_t*)ctx;
+  auto module = modulePortGetModule(mod_st);
+
+  processMultiTelemetryQueues(module);
+}
+
 #include "hal/module_driver.h"
 
 const etx_proto_driver_t MultiDriver = {
@@ -291,32 +293,34 @@ const etx_proto_driver_t MultiDriver = {
   .deinit = multiDeInit,
   .sendPulses = multiSendPulses,
   .processData = multiProcessData,
+  .processSpan = nullptr,
+  .processQueued = multiProcessQueued,
 };
 
+static ChannelsEncodingCache<MULTI_CHANS> multiChannelsCache[NUM_MODULES];
+
 static void sendChannels(uint8_t*& p_buf, uint8_t module)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-
-  // byte 4-25, channels 0..2047
-  // Range for pulses (channelsOutputs) is [-1024:+1024] for [-100%;100%]
-  // Multi uses [204;1843] as [-100%;100%]
-  for (int i = 0; i < MULTI_CHANS; i++) {
-    int channel = g_model.moduleData[module].channelsStart + i;
-    int value = channelOutputs[channel] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER;
-
-    // Scale to 80%
-    value = value * 800 / 1000 + 1024;
-    value = limit(0, value, 2047);
-
-    bits |= value << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendMulti(p_buf, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
+  const int16_t* channels = &channelOutputs[g_model.moduleData[module].channelsStart];
+  auto& cache = multiChannelsCache[module];
+
+  // the channels are only scaled again when they changed
+  if (!cache.matches(channels, MULTI_CHANS, modelDataRevision)) {
+    // byte 4-25, channels 0..2047
+    // Range for pulses (channelsOutputs) is [-1024:+1024] for [-100%;100%]
+    // Multi uses [204;1843] as [-100%;100%]
+    for (int i = 0; i < MULTI_CHANS; i++) {
+      int channel = g_model.moduleData[module].channelsStart + i;
+      int value = channels[i] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER;
+
+      // Scale to 80%
+      value = value * 800 / 1000 + 1024;
+      cache.values[i] = limit(0, value, 2047);
     }
+    cache.store(channels, MULTI_CHANS, modelDataRevision);
   }
+
+  p_buf = pack11BitChannels(p_buf, cache.values, MULTI_CHANS);
 }
 
 void sendFrameProtocolHeader(uint8_t*& p_buf, uint8_t module, bool failsafe)
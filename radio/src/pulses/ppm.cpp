@@ -84,18 +84,62 @@ void setupPulsesPPMTrainer()
   trainerPulsesData.ppm.ptr = p_data;
 }
 
-static uint32_t setupPulsesPPMModule(uint8_t module, pulse_duration_t*& data)
+// Module PPM frames are built from a template, computed again only when
+// the model changes: each frame just writes the channel widths.
+//
+// When the timer driver can repeat the pulses by itself, the frame is
+// started once and then looped by DMA without any IRQ. Each mixer cycle
+// updates the channel widths and the sync gap in place, and the output is
+// only re-started when the layout (channels, delay, polarity) changes.
+// An update landing in the middle of a frame may shift that single frame.
+#define PPM_FRAME_MAX_CHANNELS 16
+
+struct PpmFrameTemplate {
+  uint16_t revision;
+  bool valid;
+  bool cyclic;  // frame being repeated by the timer
+  uint8_t firstCh;
+  uint8_t count;
+  int16_t range;
+  uint16_t centers[PPM_FRAME_MAX_CHANNELS];
+  etx_timer_config_t cfg;
+};
+
+static PpmFrameTemplate ppmFrames[MAX_MODULES];
+
+static void updatePpmFrame(uint8_t module, PpmFrameTemplate& frame)
 {
-  auto start = data;
-  setupPulsesPPM(data,
-                 g_model.moduleData[module].channelsStart,
-                 g_model.moduleData[module].channelsCount);
+  if (frame.valid && frame.revision == modelDataRevision) return;
+
+  uint8_t firstCh = g_model.moduleData[module].channelsStart;
+  uint8_t lastCh = min<uint8_t>(
+      MAX_OUTPUT_CHANNELS,
+      firstCh + 8 + g_model.moduleData[module].channelsCount);
+  uint8_t count = min<uint8_t>(PPM_FRAME_MAX_CHANNELS, lastCh - firstCh);
+
+  etx_timer_config_t cfg = {
+    .type = ETX_PWM,
+    .polarity = !GET_MODULE_PPM_POLARITY(module),
+    .cmp_val = (uint16_t)(GET_MODULE_PPM_DELAY(module) * 2),
+  };
+
+  if (!frame.valid || frame.firstCh != firstCh || frame.count != count ||
+      frame.cfg.polarity != cfg.polarity || frame.cfg.cmp_val != cfg.cmp_val) {
+    frame.cyclic = false;
+  }
 
-  // Set the final period to 1ms after which the
-  // PPM will be switched OFF
-  *data++ = PPM_SAFE_MARGIN * 2;
+  frame.firstCh = firstCh;
+  frame.count = count;
+  frame.cfg = cfg;
+  // range of 0.7 .. 1.7msec (x2, the pulses are in half us)
+  frame.range =
+      g_model.extendedLimits ? (512 * LIMIT_EXT_PERCENT / 100) * 2 : 512 * 2;
+  for (uint8_t i = 0; i < count; i++) {
+    frame.centers[i] = 2 * PPM_CH_CENTER(firstCh + i);
+  }
 
-  return data - start;
+  frame.revision = modelDataRevision;
+  frame.valid = true;
 }
 
 static void* ppmInit(uint8_t module)
@@ -115,6 +159,7 @@ static void* ppmInit(uint8_t module)
   auto mod_st = modulePortInitTimer(module, ETX_MOD_PORT_TIMER, &cfg);
   if (!mod_st) return nullptr;
 
+  memclear(&ppmFrames[module], sizeof(PpmFrameTemplate));
   mixerSchedulerSetPeriod(module, PPM_PERIOD(module));
   return (void*)mod_st;  
 }
@@ -134,20 +179,41 @@ static void ppmSendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8_t
   auto mod_st = (etx_module_state_t*)ctx;
   auto module = modulePortGetModule(mod_st);
 
+  auto& frame = ppmFrames[module];
+  updatePpmFrame(module, frame);
+
   pulse_duration_t* pulses = (pulse_duration_t*)buffer;
-  auto length = setupPulsesPPMModule(module, pulses);
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < frame.count; i++) {
+    int16_t v = limit<int16_t>(-frame.range, channelOutputs[frame.firstCh + i],
+                               frame.range) + frame.centers[i];
+    pulses[i] = v;
+    total += v;
+  }
 
   auto drv = modulePortGetTimerDrv(mod_st->tx);
   auto drv_ctx = modulePortGetCtx(mod_st->tx);
 
-  auto delay = GET_MODULE_PPM_DELAY(module) * 2;
-  etx_timer_config_t cfg = {
-    .type = ETX_PWM,
-    .polarity = !GET_MODULE_PPM_POLARITY(module),
-    .cmp_val = (uint16_t)delay,
-  };
-
-  drv->send(drv_ctx, &cfg, buffer, length);
+  if (drv->send_cyclic) {
+    // the sync gap completes the frame period, as the timer does not
+    // stop between frames
+    uint32_t rest = PPM_PERIOD_HALF_US(module);
+    if (total + PPM_SAFE_MARGIN * 2 < rest)
+      rest -= total;
+    else
+      rest = PPM_SAFE_MARGIN * 2;
+    pulses[frame.count] = min<uint32_t>(rest, USHRT_MAX - 1);
+
+    if (!frame.cyclic) {
+      drv->send_cyclic(drv_ctx, &frame.cfg, buffer, frame.count + 1);
+      frame.cyclic = true;
+    }
+  } else {
+    // Set the final period to 1ms after which the
+    // PPM will be switched OFF
+    pulses[frame.count] = PPM_SAFE_MARGIN * 2;
+    drv->send(drv_ctx, &frame.cfg, buffer, frame.count + 1);
+  }
 
   // PPM_PERIOD is not a constant! It can be set from UI
   mixerSchedulerSetPeriod(module, PPM_PERIOD(module));
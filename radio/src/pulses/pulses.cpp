@@ -23,6 +23,7 @@
 #include "opentx.h"
 
 #include "mixer_scheduler.h"
+#include "module_timing.h"
 #include "heartbeat_driver.h"
 #include "hal/module_port.h"
 #include "tasks/mixer_task.h"
@@ -155,21 +156,32 @@ void ModuleState::startBind(BindInformation* destination,
 {
   bindInformation = destination;
   callback = bindCallback;
+  pxx2InvalidateCache(this - moduleState);
   mode = MODULE_MODE_BIND;
 }
 
 void ModuleState::readModuleInformation(ModuleInformation* destination,
                                         int8_t first, int8_t last)
 {
+  uint8_t module = this - moduleState;
+
+  // skip what is still in cache
+  while (first <= last && pxx2GetCachedInformation(module, first, destination))
+    first++;
+
   moduleInformation = destination;
   moduleInformation->current = first;
   moduleInformation->maximum = last;
-  mode = MODULE_MODE_GET_HARDWARE_INFO;
+  mode = first <= last ? MODULE_MODE_GET_HARDWARE_INFO : MODULE_MODE_NORMAL;
 }
 
 void ModuleState::readModuleSettings(ModuleSettings* destination)
 {
   moduleSettings = destination;
+  if (pxx2GetCachedModuleSettings(this - moduleState, destination)) {
+    mode = MODULE_MODE_NORMAL;
+    return;
+  }
   moduleSettings->state = PXX2_SETTINGS_READ;
   mode = MODULE_MODE_MODULE_SETTINGS;
 }
@@ -185,6 +197,10 @@ void ModuleState::writeModuleSettings(ModuleSettings* source)
 void ModuleState::readReceiverSettings(ReceiverSettings* destination)
 {
   receiverSettings = destination;
+  if (pxx2GetCachedReceiverSettings(this - moduleState, destination)) {
+    mode = MODULE_MODE_NORMAL;
+    return;
+  }
   receiverSettings->state = PXX2_SETTINGS_READ;
   mode = MODULE_MODE_RECEIVER_SETTINGS;
 }
@@ -420,6 +436,8 @@ static void _deinit_module(uint8_t module)
 
 static void pulsesEnableModule(uint8_t module, uint8_t protocol)
 {
+  // the new protocol driver may take over the serial port of the previous one
+  modulePortBeginSwap(module);
   _deinit_module(module);
 
   switch (protocol) {
@@ -497,6 +515,8 @@ static void pulsesEnableModule(uint8_t module, uint8_t protocol)
     default:
       break;
   }
+
+  modulePortEndSwap(module);
 }
 
 // TODO: declare a function in telemetry
@@ -564,14 +584,20 @@ void pulsesSendNextFrame(uint8_t module)
     auto drv = mod->drv;
     auto ctx = mod->ctx;
     auto buffer = _module_buffers[module]._buffer;
+
+    uint16_t start = getTmr2MHz();
     drv->sendPulses(ctx, buffer, channels, nChannels);
+    moduleTimingSent(module, start, getTmr2MHz(),
+                     mixerSchedulerGetPeriod(module));
   }
 }
 
-void pulsesSendChannels()
+void pulsesSendChannels(uint8_t moduleMask)
 {
   for (uint8_t i = 0; i < MAX_MODULES; i++) {
-    pulsesSendNextFrame(i);
+    if (moduleMask & MIXER_SCHEDULER_DUE_MODULE(i)) {
+      pulsesSendNextFrame(i);
+    }
   }
 }
 
@@ -163,7 +163,9 @@ uint8_t* pulsesGetModuleBuffer(uint8_t module);
 
 void pulsesStopModule(uint8_t module);
 void pulsesSendNextFrame(uint8_t module);
-void pulsesSendChannels();
+// send the frames of the modules set in moduleMask
+// (see MIXER_SCHEDULER_DUE_MODULE())
+void pulsesSendChannels(uint8_t moduleMask);
 
 typedef void (*module_init_cb_t)(uint8_t, const etx_proto_driver_t*);
 typedef void (*module_deinit_cb_t)(uint8_t, const etx_proto_driver_t*);
@@ -23,6 +23,7 @@
 #define _PULSES_COMMON_H_
 
 #include <inttypes.h>
+#include <string.h>
 
 #if defined(EXTMODULE_TIMER_32BITS)
   typedef uint32_t pulse_duration_t;
@@ -53,6 +54,67 @@ enum ModuleSettingsMode
 ModuleSettingsMode getModuleMode(int moduleIndex);
 void setModuleMode(int moduleIndex, ModuleSettingsMode mode);
 
+// Packs 11 bit values LSB first, as sent by SBUS, CRSF and Multi.
+// Each group of 8 values fills exactly 11 bytes, so it is written at once.
+inline uint8_t * pack11BitChannels(uint8_t * p, const uint16_t * values, uint8_t count)
+{
+  for (; count >= 8; count -= 8) {
+    uint32_t v0 = *values++, v1 = *values++, v2 = *values++, v3 = *values++;
+    uint32_t v4 = *values++, v5 = *values++, v6 = *values++, v7 = *values++;
+    p[0] = v0;
+    p[1] = (v0 >> 8) | (v1 << 3);
+    p[2] = (v1 >> 5) | (v2 << 6);
+    p[3] = v2 >> 2;
+    p[4] = (v2 >> 10) | (v3 << 1);
+    p[5] = (v3 >> 7) | (v4 << 4);
+    p[6] = (v4 >> 4) | (v5 << 7);
+    p[7] = v5 >> 1;
+    p[8] = (v5 >> 9) | (v6 << 2);
+    p[9] = (v6 >> 6) | (v7 << 5);
+    p[10] = v7 >> 3;
+    p += 11;
+  }
+
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  while (count--) {
+    bits |= (uint32_t)*values++ << bitsavailable;
+    bitsavailable += 11;
+    while (bitsavailable >= 8) {
+      *p++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+  return p;
+}
+
+// Channel values last sent to a module and their encoded form, so that
+// frames with unchanged channels do not scale them again. The model
+// revision covers the channel settings (PPM center) used by the encoding.
+template <int N>
+struct ChannelsEncodingCache {
+  int16_t inputs[N];
+  uint16_t values[N];
+  uint8_t count;
+  uint16_t revision;
+  bool valid;
+
+  bool matches(const int16_t * channels, uint8_t n, uint16_t rev) const
+  {
+    return valid && count == n && revision == rev &&
+           !memcmp(inputs, channels, n * sizeof(int16_t));
+  }
+
+  void store(const int16_t * channels, uint8_t n, uint16_t rev)
+  {
+    memcpy(inputs, channels, n * sizeof(int16_t));
+    count = n;
+    revision = rev;
+    valid = true;
+  }
+};
+
 template <class T, int SIZE>
 class DataBuffer {
   public:
@@ -177,6 +177,152 @@ PXX2HardwareAndSettings& getPXX2HardwareAndSettingsBuffer()
   return reusableBuffer.hardwareAndSettings;
 }
 
+static PXX2SettingsCache pxx2Cache[NUM_MODULES];
+
+static tmr10ms_t cacheTime()
+{
+  // 0 means empty
+  tmr10ms_t now = get_tmr10ms();
+  return now ? now : 1;
+}
+
+static bool isCacheFresh(tmr10ms_t time, tmr10ms_t validity)
+{
+  return time && (tmr10ms_t)(get_tmr10ms() - time) < validity;
+}
+
+static bool isCachedModule(uint8_t module)
+{
+  return pxx2Cache[module].moduleType == g_model.moduleData[module].type;
+}
+
+// receiver slot still holding the receiver which was cached
+static bool isCachedReceiver(uint8_t module, uint8_t receiver)
+{
+  const char* name = g_model.moduleData[module].pxx2.receiverName[receiver];
+  return isCachedModule(module) && name[0] != '\0' &&
+         !strncmp(pxx2Cache[module].receivers[receiver].name, name,
+                  PXX2_LEN_RX_NAME);
+}
+
+static void selectCachedModule(uint8_t module)
+{
+  if (!isCachedModule(module)) {
+    pxx2InvalidateCache(module);
+    pxx2Cache[module].moduleType = g_model.moduleData[module].type;
+  }
+}
+
+static bool selectCachedReceiver(uint8_t module, uint8_t receiver)
+{
+  if (receiver >= PXX2_MAX_RECEIVERS_PER_MODULE) return false;
+
+  selectCachedModule(module);
+
+  auto& entry = pxx2Cache[module].receivers[receiver];
+  const char* name = g_model.moduleData[module].pxx2.receiverName[receiver];
+  if (strncmp(entry.name, name, PXX2_LEN_RX_NAME)) {
+    memclear(&entry, sizeof(entry));
+    strncpy(entry.name, name, PXX2_LEN_RX_NAME);
+  }
+  return name[0] != '\0';
+}
+
+void pxx2InvalidateCache(uint8_t module)
+{
+  memclear(&pxx2Cache[module], sizeof(pxx2Cache[module]));
+}
+
+void pxx2CacheInformation(uint8_t module, uint8_t index,
+                          const PXX2HardwareInformation& information)
+{
+  if (index == PXX2_HW_INFO_TX_ID) {
+    selectCachedModule(module);
+    pxx2Cache[module].information = information;
+    pxx2Cache[module].informationTime = cacheTime();
+  }
+  else if (selectCachedReceiver(module, index)) {
+    pxx2Cache[module].receivers[index].information = information;
+    pxx2Cache[module].receivers[index].informationTime = cacheTime();
+  }
+}
+
+void pxx2CacheModuleSettings(uint8_t module, const ModuleSettings& settings)
+{
+  selectCachedModule(module);
+  pxx2Cache[module].settings = settings;
+  pxx2Cache[module].settingsTime = cacheTime();
+}
+
+void pxx2CacheReceiverSettings(uint8_t module, const ReceiverSettings& settings)
+{
+  uint8_t receiver = settings.receiverId;
+  if (selectCachedReceiver(module, receiver)) {
+    pxx2Cache[module].receivers[receiver].settings = settings;
+    pxx2Cache[module].receivers[receiver].settingsTime = cacheTime();
+  }
+}
+
+bool pxx2GetCachedInformation(uint8_t module, uint8_t index,
+                              ModuleInformation* destination)
+{
+  if (index == PXX2_HW_INFO_TX_ID) {
+    if (!isCachedModule(module) ||
+        !isCacheFresh(pxx2Cache[module].informationTime,
+                      PXX2_CACHE_INFORMATION_VALIDITY))
+      return false;
+    destination->information = pxx2Cache[module].information;
+    return true;
+  }
+
+  if (index >= PXX2_MAX_RECEIVERS_PER_MODULE ||
+      !isCachedReceiver(module, index))
+    return false;
+
+  const auto& entry = pxx2Cache[module].receivers[index];
+  if (!isCacheFresh(entry.informationTime, PXX2_CACHE_INFORMATION_VALIDITY))
+    return false;
+
+  destination->receivers[index].information = entry.information;
+  destination->receivers[index].timestamp = entry.informationTime;
+  return true;
+}
+
+bool pxx2GetCachedModuleSettings(uint8_t module, ModuleSettings* destination)
+{
+  if (!isCachedModule(module) ||
+      !isCacheFresh(pxx2Cache[module].settingsTime,
+                    PXX2_CACHE_SETTINGS_VALIDITY))
+    return false;
+
+  const auto& settings = pxx2Cache[module].settings;
+  destination->externalAntenna = settings.externalAntenna;
+  destination->txPower = settings.txPower;
+  destination->state = PXX2_SETTINGS_OK;
+  destination->timeout = 0;
+  return true;
+}
+
+bool pxx2GetCachedReceiverSettings(uint8_t module,
+                                   ReceiverSettings* destination)
+{
+  uint8_t receiver = destination->receiverId;
+  if (receiver >= PXX2_MAX_RECEIVERS_PER_MODULE ||
+      !isCachedReceiver(module, receiver))
+    return false;
+
+  const auto& entry = pxx2Cache[module].receivers[receiver];
+  if (!isCacheFresh(entry.settingsTime, PXX2_CACHE_SETTINGS_VALIDITY))
+    return false;
+
+  *destination = entry.settings;
+  destination->receiverId = receiver;
+  destination->state = PXX2_SETTINGS_OK;
+  destination->timeout = 0;
+  destination->dirty = 0;
+  return true;
+}
+
 uint8_t Pxx2Pulses::addFlag0(uint8_t module)
 {
   uint8_t flag0 = g_model.header.modelId[module] & 0x3F;
@@ -218,28 +364,35 @@ void Pxx2Pulses::addPulsesValues(uint16_t low, uint16_t high)
   Pxx2Transport::addByte(high >> 4u);  // High byte of channel
 }
 
+#if !defined(DEBUG_LATENCY_RF_ONLY)
+static ChannelsEncodingCache<MAX_OUTPUT_CHANNELS> pxx2ChannelsCache[NUM_MODULES];
+#endif
+
 void Pxx2Pulses::addChannels(uint8_t module, int16_t* channels, uint8_t nChannels)
 {
-  uint16_t pulseValue = 0;
-  uint16_t pulseValueLow = 0;
-
-  uint8_t channel = g_model.moduleData[module].channelsStart;
-  uint8_t count = sentModuleChannels(module);
+  uint8_t count = min<uint8_t>(sentModuleChannels(module), MAX_OUTPUT_CHANNELS);
 
-  for (int8_t i = 0; i < count; i++, channel++) {
-    int value = channels[i] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
-    pulseValue = limit(1, (value * 512 / 682) + 1024, 2046);
 #if defined(DEBUG_LATENCY_RF_ONLY)
-    if (latencyToggleSwitch)
-      pulseValue = 1;
-    else
-      pulseValue = 2046;
-#endif
-    if (i & 1)
-      addPulsesValues(pulseValueLow, pulseValue);
-    else
-      pulseValueLow = pulseValue;
+  uint16_t pulseValue = latencyToggleSwitch ? 1 : 2046;
+  for (uint8_t i = 1; i < count; i += 2) {
+    addPulsesValues(pulseValue, pulseValue);
+  }
+#else
+  // the channels are only scaled again when they changed
+  auto & cache = pxx2ChannelsCache[module];
+  if (!cache.matches(channels, count, modelDataRevision)) {
+    uint8_t channel = g_model.moduleData[module].channelsStart;
+    for (uint8_t i = 0; i < count; i++, channel++) {
+      int value = channels[i] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
+      cache.values[i] = limit(1, (value * 512 / 682) + 1024, 2046);
+    }
+    cache.store(channels, count, modelDataRevision);
   }
+
+  for (uint8_t i = 1; i < count; i += 2) {
+    addPulsesValues(cache.values[i - 1], cache.values[i]);
+  }
+#endif
 }
 
 void Pxx2Pulses::addFailsafe(uint8_t module)
@@ -494,6 +647,7 @@ void Pxx2Pulses::setupResetFrame(uint8_t module)
   addFrameType(PXX2_TYPE_C_MODULE, PXX2_TYPE_ID_RESET);
   Pxx2Transport::addByte(reusableBuffer.moduleSetup.pxx2.resetReceiverIndex);
   Pxx2Transport::addByte(reusableBuffer.moduleSetup.pxx2.resetReceiverFlags);
+  pxx2InvalidateCache(module);
   moduleState[module].mode = MODULE_MODE_NORMAL;
 }
 
@@ -545,7 +699,7 @@ void Pxx2Pulses::sendOtaUpdate(uint8_t module, const char* rxName,
   else if (data) {
     Pxx2Transport::addByte(0x01);
     Pxx2Transport::addWord(address);
-    for (uint8_t i=0; i<32; i++) {
+    for (uint8_t i=0; i<OTA_BLOCK_SIZE; i++) {
       Pxx2Transport::addByte(data[i]);
     }
   }
@@ -260,6 +260,40 @@ PXX2ModuleSetup& getPXX2ModuleSetupBuffer();
 BindInformation& getPXX2BindInformationBuffer();
 PXX2HardwareAndSettings& getPXX2HardwareAndSettingsBuffer();
 
+// Information and settings last received from each module and receiver,
+// reused by the setup pages until they get stale. Receivers are keyed by
+// the name registered in the model, the module by its type.
+#define PXX2_CACHE_INFORMATION_VALIDITY  6000 /* 60s */
+#define PXX2_CACHE_SETTINGS_VALIDITY     3000 /* 30s */
+
+struct PXX2SettingsCache {
+  uint8_t moduleType;
+  tmr10ms_t informationTime;
+  PXX2HardwareInformation information;
+  tmr10ms_t settingsTime;
+  ModuleSettings settings;
+  struct {
+    char name[PXX2_LEN_RX_NAME];
+    tmr10ms_t informationTime;
+    PXX2HardwareInformation information;
+    tmr10ms_t settingsTime;
+    ReceiverSettings settings;
+  } receivers[PXX2_MAX_RECEIVERS_PER_MODULE];
+};
+
+void pxx2CacheInformation(uint8_t module, uint8_t index,
+                          const PXX2HardwareInformation& information);
+void pxx2CacheModuleSettings(uint8_t module, const ModuleSettings& settings);
+void pxx2CacheReceiverSettings(uint8_t module, const ReceiverSettings& settings);
+void pxx2InvalidateCache(uint8_t module);
+
+// return true when destination could be filled from the cache
+bool pxx2GetCachedInformation(uint8_t module, uint8_t index,
+                              ModuleInformation* destination);
+bool pxx2GetCachedModuleSettings(uint8_t module, ModuleSettings* destination);
+bool pxx2GetCachedReceiverSettings(uint8_t module,
+                                   ReceiverSettings* destination);
+
 extern const etx_proto_driver_t Pxx2Driver;
 
 #endif
@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "io/frsky_firmware_update.h"
+#include "io/flashing_progress.h"
 #include "tasks/mixer_task.h"
 
 #include "pxx2_ota.h"
@@ -78,7 +79,8 @@ const char* Pxx2OtaUpdate::doFlashFirmware(const char* filename,
                                            ProgressHandler progressHandler)
 {
   FIL file;
-  uint8_t buffer[32];
+  // the file is read OTA_READ_AHEAD blocks at a time
+  uint8_t buffer[OTA_BLOCK_SIZE * OTA_READ_AHEAD];
   UINT count;
   const char * result;
 
@@ -106,28 +108,34 @@ const char* Pxx2OtaUpdate::doFlashFirmware(const char* filename,
     size = f_size(&file);
   }
 
+  FlashingProgress progress(progressHandler, getBasename(filename));
   uint32_t done = 0;
   while (1) {
-    progressHandler(getBasename(filename), STR_OTA_UPDATE, done, size);
     if (f_read(&file, buffer, sizeof(buffer), &count) != FR_OK) {
       f_close(&file);
       return "Read file failed";
     }
 
-    result = nextStep(OTA_UPDATE_TRANSFER, nullptr, done, buffer);
-    if (result) {
-      return result;
-    }
+    // a short block (possibly empty) tells the receiver the file ends
+    for (UINT offset = 0;; offset += OTA_BLOCK_SIZE) {
+      progress.report(STR_OTA_UPDATE, done, size);
 
-    if (count < sizeof(buffer)) {
-      f_close(&file);
-      break;
-    }
+      result = nextStep(OTA_UPDATE_TRANSFER, nullptr, done, buffer + offset);
+      if (result) {
+        f_close(&file);
+        return result;
+      }
 
-    done += count;
-  }
+      if (count - offset < OTA_BLOCK_SIZE) {
+        f_close(&file);
+        TRACE("OTA done, %d bytes/s", progress.bytesPerSecond());
+        return nextStep(OTA_UPDATE_EOF, nullptr, done, nullptr);
+      }
 
-  return nextStep(OTA_UPDATE_EOF, nullptr, done, nullptr);
+      done += OTA_BLOCK_SIZE;
+      if (offset + OTA_BLOCK_SIZE == sizeof(buffer)) break;
+    }
+  }
 }
 
 void Pxx2OtaUpdate::flashFirmware(const char * filename, ProgressHandler progressHandler)
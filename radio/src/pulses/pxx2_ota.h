@@ -24,6 +24,10 @@
 #include "pxx2.h"
 #include "popups.h"
 
+// data bytes carried by each OTA_UPDATE_TRANSFER frame
+#define OTA_BLOCK_SIZE    32
+#define OTA_READ_AHEAD    4
+
 class OtaUpdateInformation: public BindInformation {
   public:
     char filename[FF_MAX_LFN + 1];
@@ -26,6 +26,8 @@
 #include <FreeRTOS/include/FreeRTOS.h>
 #include <FreeRTOS/include/task.h>
 
+#include "task_stats.h"
+
 /* configSUPPORT_STATIC_ALLOCATION is set to 1, so the application must provide an
    implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
    used by the Idle task. */
@@ -39,6 +41,8 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer,
     static StaticTask_t xIdleTaskTCB;
     static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
 
+    taskStatsRegister("idle", &xIdleTaskTCB);
+
     /* Pass out a pointer to the StaticTask_t structure in which the Idle task's
     state will be stored. */
     *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
@@ -68,6 +72,8 @@ void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer,
     static StaticTask_t xTimerTaskTCB;
     static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
 
+    taskStatsRegister("timer", &xTimerTaskTCB);
+
     /* Pass out a pointer to the StaticTask_t structure in which the Timer
     task's state will be stored. */
     *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
@@ -148,6 +148,8 @@ inline void RTOS_CREATE_TASK(pthread_t &taskId, void * (*task)(void *), const ch
     #include <FreeRTOS/include/FreeRTOS.h>
     #include <FreeRTOS/include/task.h>
     #include <FreeRTOS/include/semphr.h>
+
+    void taskStatsRegister(const char * name, const void * tcb);
 #ifdef __cplusplus
   }
 #endif
@@ -193,6 +195,7 @@ inline void RTOS_CREATE_TASK(pthread_t &taskId, void * (*task)(void *), const ch
                                        const uint32_t ulStackDepth,
                                        UBaseType_t uxPriority)
   {
+    taskStatsRegister(name, &h->task_struct);
     h->rtos_handle = xTaskCreateStatic(
         pxTaskCode, name, ulStackDepth, 0, uxPriority,
         puxStackBuffer, &h->task_struct);
@@ -246,7 +249,13 @@ inline void RTOS_CREATE_TASK(pthread_t &taskId, void * (*task)(void *), const ch
     return getStackAvailable(&_main_stack_start, stackSize());
   }
 
-  //#define RTOS_CREATE_FLAG(flag)        flag = CoCreateFlag(false, false)
+  static inline void _RTOS_CREATE_FLAG(RTOS_FLAG_HANDLE* flag)
+  {
+    flag->rtos_handle = xSemaphoreCreateBinaryStatic(&flag->mutex_struct);
+  }
+
+  #define RTOS_CREATE_FLAG(flag) _RTOS_CREATE_FLAG(&flag)
+
   //#define RTOS_SET_FLAG(flag)           (void)CoSetFlag(flag)
   //#define RTOS_CLEAR_FLAG(flag)         (void)CoClearFlag(flag)
 
@@ -58,13 +58,70 @@ int sbusAuxGetByte(uint8_t* byte)
   return -1;
 }
 
+static uint32_t (*_sbusAuxGetRxSpan)(void*, const uint8_t**) = nullptr;
+static void (*_sbusAuxConsumeRx)(void*, uint32_t) = nullptr;
+
+void sbusSetAuxRxSpan(void* ctx, uint32_t (*getRxSpan)(void*, const uint8_t**),
+                      void (*consumeRx)(void*, uint32_t))
+{
+  _sbusAuxGetRxSpan = nullptr;
+  _sbusAuxConsumeRx = consumeRx;
+  _sbusAuxGetByteCtx = ctx;
+  _sbusAuxGetRxSpan = getRxSpan;
+}
+
+uint32_t sbusAuxGetRxSpan(const uint8_t** data)
+{
+  auto _getRxSpan = _sbusAuxGetRxSpan;
+  auto _ctx = _sbusAuxGetByteCtx;
+
+  if (_getRxSpan && _sbusAuxConsumeRx) {
+    return _getRxSpan(_ctx, data);
+  }
+
+  return 0;
+}
+
+void sbusAuxConsumeRx(uint32_t len)
+{
+  auto _consumeRx = _sbusAuxConsumeRx;
+  if (_consumeRx) {
+    _consumeRx(_sbusAuxGetByteCtx, len);
+  }
+}
+
 static int (*sbusGetByte)(uint8_t*) = nullptr;
+static uint32_t (*sbusGetRxSpan)(const uint8_t**) = nullptr;
+static void (*sbusConsumeRx)(uint32_t) = nullptr;
 
 void sbusSetGetByte(int (*fct)(uint8_t*))
 {
   sbusGetByte = fct;
 }
 
+void sbusSetGetRxSpan(uint32_t (*getRxSpan)(const uint8_t**),
+                      void (*consumeRx)(uint32_t))
+{
+  sbusGetRxSpan = nullptr;
+  sbusConsumeRx = consumeRx;
+  sbusGetRxSpan = getRxSpan;
+}
+
+// Keep the first bytes of the frame: any overflow
+// ends up in the last slot (the frame is then invalid)
+static void sbusAppend(uint8_t* frame, uint8_t& index, const uint8_t* data,
+                       uint32_t len)
+{
+  uint32_t room = SBUS_FRAME_SIZE - 1 - min<uint32_t>(index, SBUS_FRAME_SIZE - 1);
+  uint32_t count = min<uint32_t>(len, room);
+  memcpy(frame + index, data, count);
+  index += count;
+  if (count < len) {
+    frame[SBUS_FRAME_SIZE - 1] = data[len - 1];
+    index = SBUS_FRAME_SIZE;
+  }
+}
+
 // Range for pulses (ppm input) is [-512:+512]
 void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size)
 {
@@ -104,15 +161,25 @@ void processSbusInput()
 
   uint32_t active = 0;
 
-  // Drain input first (if existing)
+  // Drain input first (if existing): whole spans when the
+  // driver provides them, then whatever is left byte by byte
+  auto _getRxSpan = sbusGetRxSpan;
+  auto _consumeRx = sbusConsumeRx;
+  if (_getRxSpan && _consumeRx) {
+    const uint8_t* data;
+    uint32_t len;
+    while ((len = _getRxSpan(&data)) > 0) {
+      active = 1;
+      sbusAppend(SbusFrame, SbusIndex, data, len);
+      _consumeRx(len);
+    }
+  }
+
   uint8_t rxchar;
   auto _getByte = sbusGetByte;
   while (_getByte && (_getByte(&rxchar) > 0)) {
     active = 1;
-    if (SbusIndex > SBUS_FRAME_SIZE - 1) {
-      SbusIndex = SBUS_FRAME_SIZE - 1;
-    }
-    SbusFrame[SbusIndex++] = rxchar;
+    sbusAppend(SbusFrame, SbusIndex, &rxchar, 1);
   }
 
   // Data has been received
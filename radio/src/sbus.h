@@ -33,9 +33,22 @@ void sbusSetAuxGetByte(void* ctx, int (*fct)(void*, uint8_t*));
 //  with sbusSetAuxGetByte()
 int sbusAuxGetByte(uint8_t* byte);
 
+// Setup SBUS AUX serial span input (optional, see sbusSetGetRxSpan())
+void sbusSetAuxRxSpan(void* ctx, uint32_t (*getRxSpan)(void*, const uint8_t**),
+                      void (*consumeRx)(void*, uint32_t));
+
+// SBUS AUX serial span getters
+uint32_t sbusAuxGetRxSpan(const uint8_t** data);
+void sbusAuxConsumeRx(uint32_t len);
+
 // Setup general SBUS input source
 void sbusSetGetByte(int (*fct)(uint8_t*));
 
+// Setup general SBUS span input source: if set, it is
+// drained before the byte getter set with sbusSetGetByte()
+void sbusSetGetRxSpan(uint32_t (*getRxSpan)(const uint8_t**),
+                      void (*consumeRx)(uint32_t));
+
 void processSbusInput();
 
 #endif // _SBUS_H_
@@ -343,13 +343,25 @@ bool sdListFiles(const char * path, const char * extension, const uint8_t maxlen
 #endif // !LIBOPENUI
 
 #if defined(SDCARD)
-const char * sdCopyFile(const char * srcPath, const char * destPath)
+// Whole sectors at aligned addresses are transferred by FatFs straight
+// between the card and this buffer, as multi-block DMA transfers
+#if defined(SDRAM)
+  #define SD_COPY_BUFFER_SIZE   (32 * 512)
+#else
+  #define SD_COPY_BUFFER_SIZE   (2 * 512)
+#endif
+
+// only used from the UI task
+static uint8_t sdCopyBuffer[SD_COPY_BUFFER_SIZE] __SDRAM;
+
+#define SD_COPY_PROGRESS_PERIOD 10 // 10ms ticks
+
+const char * sdCopyFile(const char * srcPath, const char * destPath, SdCopyProgress progress)
 {
   FIL srcFile;
   FIL destFile;
-  char buf[256];
-  UINT read = sizeof(buf);
-  UINT written = sizeof(buf);
+  UINT read = sizeof(sdCopyBuffer);
+  UINT written = sizeof(sdCopyBuffer);
 
   FRESULT result = f_open(&srcFile, srcPath, FA_OPEN_EXISTING | FA_READ);
   if (result != FR_OK) {
@@ -362,24 +374,50 @@ const char * sdCopyFile(const char * srcPath, const char * destPath)
     return SDCARD_ERROR(result);
   }
 
-  while (result==FR_OK && read==sizeof(buf) && written==sizeof(buf)) {
-    result = f_read(&srcFile, buf, sizeof(buf), &read);
+  // contiguous clusters avoid FAT lookups while writing, when the card
+  // has them; the copy goes on without it otherwise
+  uint32_t total = f_size(&srcFile);
+  if (total > 0) {
+    f_expand(&destFile, total, 1);
+  }
+
+  uint32_t done = 0;
+  bool reported = false;
+  tmr10ms_t lastProgress = get_tmr10ms();
+  while (result==FR_OK && read==sizeof(sdCopyBuffer) && written==sizeof(sdCopyBuffer)) {
+    result = f_read(&srcFile, sdCopyBuffer, sizeof(sdCopyBuffer), &read);
     if (result == FR_OK) {
-      result = f_write(&destFile, buf, read, &written);
+      result = f_write(&destFile, sdCopyBuffer, read, &written);
+      done += written;
+    }
+    if (progress && get_tmr10ms() - lastProgress >= SD_COPY_PROGRESS_PERIOD) {
+      lastProgress = get_tmr10ms();
+      progress(destPath, done, total);
+      reported = true;
     }
   }
 
+  if (result == FR_OK && written != read) {
+    result = FR_DENIED; // card full
+  }
+
   f_close(&destFile);
   f_close(&srcFile);
 
   if (result != FR_OK) {
+    // a preallocated file would end with garbage
+    f_unlink(destPath);
     return SDCARD_ERROR(result);
   }
 
+  if (reported) {
+    progress(destPath, total, total);
+  }
+
   return nullptr;
 }
 
-const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir)
+const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir, SdCopyProgress progress)
 {
   char srcPath[2*CLIPBOARD_PATH_LEN+1];
   char * tmp = strAppend(srcPath, srcDir, CLIPBOARD_PATH_LEN);
@@ -391,7 +429,7 @@ const char * sdCopyFile(const char * srcFilename, const char * srcDir, const cha
   *tmp++ = '/';
   strAppend(tmp, destFilename, CLIPBOARD_PATH_LEN);
 
-  return sdCopyFile(srcPath, destPath);
+  return sdCopyFile(srcPath, destPath, progress);
 }
 
 // Will overwrite if destination exists
@@ -448,23 +486,6 @@ uint32_t sdGetSize()
   return (sdGetNoSectors() / 1000000) * BLOCK_SIZE;
 }
 
-uint32_t sdGetFreeSectors()
-{
-  DWORD nofree;
-  FATFS * fat;
-  if (f_getfree("", &nofree, &fat) != FR_OK) {
-    return 0;
-  }
-  return nofree * fat->csize;
-}
-
-uint32_t sdGetFreeKB()
-{
-  return sdGetFreeSectors() * (1024 / BLOCK_SIZE);
-}
-
-bool sdIsFull() { return sdGetFreeKB() < SDCARD_MIN_FREE_SPACE_MB * 1024; }
-
 #else  // #if !defined(SIMU) || defined(SIMU_DISKIO)
 
 uint32_t sdGetNoSectors()
@@ -484,6 +505,8 @@ uint32_t sdGetFreeSectors()
 
 uint32_t sdGetFreeKB() { return SDCARD_MIN_FREE_SPACE_MB * 1024 + 1; }
 bool sdIsFull() { return false; }
+bool sdFreeSpaceKnown() { return true; }
+void sdFreeSpaceWakeup() {}
 
 #endif  // #if !defined(SIMU) || defined(SIMU_DISKIO)
 
@@ -532,6 +555,131 @@ int ff_del_syncobj (FF_SYNC_t mutex)
   return 1;
 }
 
+#if !defined(SIMU) || defined(SIMU_DISKIO)
+
+// Free space accounting
+//
+// f_getfree() scans the whole FAT when the number of free clusters is not
+// known yet (no valid FSInfo), which takes seconds on large cards. Instead
+// the FAT is counted in the background, a few sectors at a time, and the
+// result is handed over to FatFs, which then keeps it up to date on each
+// cluster allocated or freed by our writes. Until then the free space is
+// unknown and the card is not reported as full.
+//
+// Clusters allocated or freed during the scan in the part of the FAT
+// already counted are missed: the count is only as exact as a space check
+// needs.
+
+#define FREE_SCAN_SECTORS_PER_CALL  16
+
+static uint8_t freeScanBuffer[BLOCK_SIZE] __DMA;
+static DWORD freeScanSector;  // next FAT sector, 0 when not scanning
+static DWORD freeScanCount;
+
+static bool freeClustersValid(const FATFS& fs)
+{
+  return fs.free_clst <= fs.n_fatent - 2;
+}
+
+static void freeScanStart()
+{
+  freeScanSector = freeClustersValid(g_FATFS_Obj) ? 0 : g_FATFS_Obj.fatbase;
+  freeScanCount = 0;
+}
+
+static void freeScanStep()
+{
+  FATFS& fs = g_FATFS_Obj;
+
+  if (fs.fs_type == FS_FAT12) {
+    // small volume: scanning it at once is fast
+    DWORD nofree;
+    FATFS* fat;
+    f_getfree("", &nofree, &fat);
+    freeScanSector = 0;
+    return;
+  }
+
+  RTOS_LOCK_MUTEX(ioMutex);
+
+  uint8_t entrySize = (fs.fs_type == FS_FAT32) ? 4 : 2;
+  DWORD entriesPerSector = BLOCK_SIZE / entrySize;
+
+  for (uint8_t i = 0; i < FREE_SCAN_SECTORS_PER_CALL && freeScanSector; i++) {
+    DWORD first = (freeScanSector - fs.fatbase) * entriesPerSector;
+    if (first >= fs.n_fatent || freeClustersValid(fs)) {
+      // done, unless FatFs got the count meanwhile
+      if (!freeClustersValid(fs)) fs.free_clst = freeScanCount;
+      freeScanSector = 0;
+      break;
+    }
+
+    const uint8_t* data = freeScanBuffer;
+    if (freeScanSector == fs.winsect) {
+      // this FAT sector may have unsaved changes in the FatFs window
+      data = fs.win;
+    }
+    else if (disk_read(fs.pdrv, freeScanBuffer, freeScanSector, 1) != RES_OK) {
+      // try again from the beginning next time
+      freeScanStart();
+      break;
+    }
+
+    DWORD last = min<DWORD>(first + entriesPerSector, fs.n_fatent);
+    for (DWORD entry = max<DWORD>(first, 2); entry < last; entry++) {
+      // FAT entries are little-endian
+      const uint8_t* p = data + (entry - first) * entrySize;
+      DWORD value = p[0] | (p[1] << 8);
+      if (entrySize == 4) value |= ((DWORD)p[2] << 16) | ((DWORD)(p[3] & 0x0F) << 24);
+      if (value == 0) freeScanCount++;
+    }
+
+    freeScanSector++;
+  }
+
+  RTOS_UNLOCK_MUTEX(ioMutex);
+}
+
+void sdFreeSpaceWakeup()
+{
+  if (freeScanSector && sdMounted()) {
+    freeScanStep();
+  }
+}
+
+bool sdFreeSpaceKnown()
+{
+  return sdMounted() && freeClustersValid(g_FATFS_Obj);
+}
+
+uint32_t sdGetFreeSectors()
+{
+  if (!sdFreeSpaceKnown()) {
+    return 0;
+  }
+
+  // no FAT access with a known count
+  DWORD nofree;
+  FATFS * fat;
+  if (f_getfree("", &nofree, &fat) != FR_OK) {
+    return 0;
+  }
+  return nofree * fat->csize;
+}
+
+uint32_t sdGetFreeKB()
+{
+  return sdGetFreeSectors() * (1024 / BLOCK_SIZE);
+}
+
+bool sdIsFull()
+{
+  return sdFreeSpaceKnown() &&
+         sdGetFreeKB() < SDCARD_MIN_FREE_SPACE_MB * 1024;
+}
+
+#endif  // #if !defined(SIMU) || defined(SIMU_DISKIO)
+
 void sdInit()
 {
   TRACE("sdInit");
@@ -548,15 +696,14 @@ void sdMount()
 #endif
   
   if (f_mount(&g_FATFS_Obj, "", 1) == FR_OK) {
-    // call sdGetFreeSectors() now because f_getfree() takes a long time first time it's called
     _g_FATFS_init = true;
-    sdGetFreeSectors();
+#if !defined(SIMU) || defined(SIMU_DISKIO)
+    // the free clusters are counted in the background
+    freeScanStart();
+#endif
 
 #if defined(LOG_TELEMETRY)
-    f_open(&g_telemetryFile, LOGS_PATH "/telemetry.log", FA_OPEN_ALWAYS | FA_WRITE);
-    if (f_size(&g_telemetryFile) > 0) {
-      f_lseek(&g_telemetryFile, f_size(&g_telemetryFile)); // append
-    }
+    logTelemetryOpen();
 #endif
 
 #if defined(LOG_BLUETOOTH)
@@ -578,8 +725,12 @@ void sdDone()
   if (sdMounted()) {
     audioQueue.stopSD();
 
+#if defined(LUA) && defined(LUA_COMPILER)
+    luaCompileCacheReset();
+#endif
+
 #if defined(LOG_TELEMETRY)
-    f_close(&g_telemetryFile);
+    logTelemetryClose();
 #endif
 
 #if defined(LOG_BLUETOOTH)
@@ -82,6 +82,7 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
 
 #define MODELS_EXT          ".bin"
 #define LOGS_EXT            ".csv"
+#define LOGS_BINARY_EXT     ".blg"
 #define SOUNDS_EXT          ".wav"
 #define BMP_EXT             ".bmp"
 #define PNG_EXT             ".png"
@@ -119,6 +120,7 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
   strcat(&filename[sizeof(path)], ext)
 
 extern uint8_t logDelay100ms;
+extern uint8_t logProfile;
 void logsInit();
 void logsClose();
 void logsWrite();
@@ -134,6 +136,11 @@ uint32_t sdGetFreeSectors();
 uint32_t sdGetFreeKB();
 bool sdIsFull();
 
+// false until the free clusters have been counted after mount
+bool sdFreeSpaceKnown();
+// counts the free clusters a few FAT sectors at a time
+void sdFreeSpaceWakeup();
+
 #if defined(PCBTARANIS)
 void sdPoll10ms();
 #endif
@@ -167,8 +174,11 @@ const char * getBasename(const char * path);
 bool isFileAvailable(const char * filename, bool exclDir = false);
 unsigned int findNextFileIndex(char * filename, uint8_t size, const char * directory);
 
-const char * sdCopyFile(const char * src, const char * dest);
-const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir);
+// Called at most every 100ms during long copies, and once at their end
+typedef void (* SdCopyProgress)(const char * destPath, uint32_t done, uint32_t total);
+
+const char * sdCopyFile(const char * src, const char * dest, SdCopyProgress progress = nullptr);
+const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir, SdCopyProgress progress = nullptr);
 const char * sdMoveFile(const char * src, const char * dest);
 const char * sdMoveFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir);
 
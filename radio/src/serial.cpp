@@ -37,6 +37,7 @@
 #if !defined(BOOT)
   #include "opentx.h"
   #include "lua/lua_api.h"
+  #include "telemetry/telemetry_stream.h"
 #else
   #include "dataconstants.h"
 #endif
@@ -210,6 +211,7 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
     luaSetSendCb(ctx, sendByte);
     if (getByte) {
       luaSetGetSerialByte(ctx, getByte);
+      luaSetSerialRxSpan(ctx, drv->getRxSpan, drv->consumeRx);
     } else if (setRxCb) {
       luaAllocRxFifo();
       setRxCb(ctx, luaReceiveData);
@@ -222,6 +224,8 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
 #if defined(SBUS_TRAINER)
   case UART_MODE_SBUS_TRAINER:
     sbusSetAuxGetByte(ctx, getByte);
+    sbusSetAuxRxSpan(ctx, drv ? drv->getRxSpan : nullptr,
+                     drv ? drv->consumeRx : nullptr);
     // TODO: setRxCb (see MODE_LUA)
     break;
 #endif
@@ -238,6 +242,10 @@ static void serialSetCallBacks(int mode, void* ctx, const etx_serial_port_t* por
     telemetrySetMirrorCb(ctx, sendByte);
     break;
 
+  case UART_MODE_TELEMETRY_STREAM:
+    telemetryStreamSetSerialDriver(ctx, drv);
+    break;
+
 #if defined(CLI) && !defined(SIMU)
   case UART_MODE_CLI:
     cliSetSerialDriver(ctx, drv);
@@ -305,6 +313,10 @@ static void serialSetupPort(int mode, etx_serial_init& params)
     params.baudrate = FRSKY_TELEM_MIRROR_BAUDRATE;
     break;
 
+  case UART_MODE_TELEMETRY_STREAM:
+    params.baudrate = TELEMETRY_STREAM_BAUDRATE;
+    break;
+
   case UART_MODE_TELEMETRY:
     if (modelTelemetryProtocol() == PROTOCOL_TELEMETRY_FRSKY_D_SECONDARY) {
       params.baudrate = FRSKY_D_BAUDRATE;
@@ -22,17 +22,13 @@
 #include "opentx.h"
 // #include <ctype.h>
 #include "tasks/mixer_task.h"
+#include "ext_input.h"
 
 #if !defined(SIMU)
   #include <FreeRTOS/include/FreeRTOS.h>
   #include <FreeRTOS/include/timers.h>
 #endif
 
-struct spacemousedata_t
-{
-  signed short axisValues[SPACEMOUSE_CHANNEL_COUNT];
-};
-
 enum class sm_bytetype
 {
   SM_START,
@@ -53,9 +49,6 @@ struct spacemouseTelegram_t
 };
 
 static spacemouseTelegram_t spaceMouseTelegram = { {0} };
-spacemousedata_t spacemouseData;
-
-void spacemouseWakeup();
 
 #if !defined(SIMU)
 static TimerHandle_t spacemouseTimer = nullptr;
@@ -66,7 +59,6 @@ static void spacemouseTimerCb(TimerHandle_t xTimer)
   if (mixerTaskRunning()) {
     DEBUG_TIMER_START(debugTimerSpacemouseWakeup);
     spacemousePoll();
-    spacemouseWakeup();
     DEBUG_TIMER_STOP(debugTimerSpacemouseWakeup);
   }
 }
@@ -96,7 +88,7 @@ void spacemouseStop()
 }
 #endif
 
-void spacemouseParseNewData(uint8_t c)
+static void spacemouseParseNewData(uint8_t c, uint32_t timestamp)
 {
   switch (spaceMouseTelegram.parsestate) {
     case sm_bytetype::SM_START: {
@@ -130,11 +122,13 @@ void spacemouseParseNewData(uint8_t c)
     case sm_bytetype::SM_FOOTER: {
       if ((c == SPACEMOUSE_PROTO_FOOTER) &&
           (spaceMouseTelegram.checkSumReceived == (spaceMouseTelegram.checkSumCalc & 0x3FFF))) {
+          int16_t axisValues[SPACEMOUSE_CHANNEL_COUNT];
           for ( uint8_t channel = 0; channel < SPACEMOUSE_CHANNEL_COUNT; channel++ )
           {
             // The values are 7-bit in LSByte and MSByte only. Set MSBit is reserved for start, stop & commands.
-            spacemouseData.axisValues[channel] = ((spaceMouseTelegram.data[channel*2] << 7) + spaceMouseTelegram.data[(channel*2)+1]) - SPACEMOUSE_INPUT_OFFSET;
+            axisValues[channel] = ((spaceMouseTelegram.data[channel*2] << 7) + spaceMouseTelegram.data[(channel*2)+1]) - SPACEMOUSE_INPUT_OFFSET;
           }
+          extInputPush(EXT_INPUT_SPACEMOUSE, axisValues, SPACEMOUSE_CHANNEL_COUNT, timestamp);
       }
       spaceMouseTelegram.checkSumCalc = 0;
       spaceMouseTelegram.parsestate = sm_bytetype::SM_START;
@@ -150,11 +144,24 @@ static void* spacemouseSerialCtx = nullptr;
 bool spacemouseTraceEnabled = false;
 #endif
 
+static void spacemouseWakeup();
+
+// The packets are parsed by the mixer, right before it samples the
+// external inputs, so that it always uses the last complete one
+static const ExtInputDriver spacemouseInputDriver = {
+  .channels = SPACEMOUSE_CHANNEL_COUNT,
+  .poll = spacemouseWakeup,
+};
+
 void spacemouseSetSerialDriver(void* ctx, const etx_serial_driver_t* drv)
 {
+  extInputUnregister(EXT_INPUT_SPACEMOUSE);
   spacemouseSerialCtx = ctx;
   spacemouseSerialDrv = drv;
   spaceMouseTelegram.parsestate = sm_bytetype::SM_START;
+  if (drv) {
+    extInputRegister(EXT_INPUT_SPACEMOUSE, &spacemouseInputDriver);
+  }
 #if !defined(SIMU)
   spacemouseStart();
 #endif
@@ -166,24 +173,49 @@ int16_t get_spacemouse_value(uint8_t ch)
     return 0;
   }
 
-  return (int16_t)(((float)spacemouseData.axisValues[ch])*SPACEMOUSE_OUTPUT_CONV_FACTOR);
+  int16_t value = extInputGetValue(EXT_INPUT_SPACEMOUSE, ch);
+  return (int16_t)(((float)value)*SPACEMOUSE_OUTPUT_CONV_FACTOR);
 }
 
-void spacemouseWakeup()
+static void spacemouseParseData(const uint8_t* data, uint32_t len,
+                                uint32_t timestamp)
 {
-  if (!spacemouseSerialDrv) return;
-  
-  auto _getByte = spacemouseSerialDrv->getByte;
-  if (!_getByte) return;
-
-  uint8_t byte;
-  while (_getByte(spacemouseSerialCtx, &byte)) {
+  for (uint32_t i = 0; i < len; i++) {
 #if defined(DEBUG)
     if (spacemouseTraceEnabled) {
-      dbgSerialPutc(byte);
+      dbgSerialPutc(data[i]);
     }
 #endif
-    spacemouseParseNewData(byte);
+    spacemouseParseNewData(data[i], timestamp);
+  }
+}
+
+static void spacemouseWakeup()
+{
+  auto drv = spacemouseSerialDrv;
+  auto ctx = spacemouseSerialCtx;
+  if (!drv) return;
+
+  // all packets completed by this call were received since the last one
+  uint32_t timestamp = RTOS_GET_MS();
+
+  // parse the DMA buffer in place when the driver allows it
+  if (drv->getRxSpan && drv->consumeRx) {
+    const uint8_t* data;
+    uint32_t len;
+    while ((len = drv->getRxSpan(ctx, &data)) > 0) {
+      spacemouseParseData(data, len, timestamp);
+      drv->consumeRx(ctx, len);
+    }
+    return;
+  }
+
+  auto _getByte = drv->getByte;
+  if (!_getByte) return;
+
+  uint8_t byte;
+  while (_getByte(ctx, &byte)) {
+    spacemouseParseData(&byte, 1, timestamp);
   }
 }
 
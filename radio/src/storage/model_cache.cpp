@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "crc.h"
+#include "model_cache.h"
+#include "sdcard_common.h"
+
+#include "yaml/yaml_node.h"
+#include "yaml/yaml_datastructs.h"
+
+#define MODEL_CACHE_MAGIC  0x434D5445  // "ETMC"
+
+struct ModelCacheHeader {
+  uint32_t magic;
+  uint32_t layout;
+  uint32_t dataSize;
+  // YAML file the data has been read from / written to
+  uint32_t yamlSize;
+  uint16_t yamlDate;
+  uint16_t yamlTime;
+  uint16_t checksum;
+  uint16_t spare;
+};
+
+static uint32_t hashBytes(uint32_t hash, const void* data, uint32_t len)
+{
+  // FNV-1a
+  auto p = (const uint8_t*)data;
+  while (len--) {
+    hash ^= *p++;
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+static uint32_t hashNode(uint32_t hash, const YamlNode* node);
+
+static uint32_t hashNodes(uint32_t hash, const YamlNode* node)
+{
+  for (; node->type != YDT_NONE; node++) {
+    hash = hashNode(hash, node);
+  }
+  return hash;
+}
+
+static uint32_t hashNode(uint32_t hash, const YamlNode* node)
+{
+  hash = hashBytes(hash, &node->type, sizeof(node->type));
+  hash = hashBytes(hash, &node->size, sizeof(node->size));
+  if (node->tag) hash = hashBytes(hash, node->tag, node->tag_len);
+
+  switch (node->type) {
+    case YDT_ARRAY:
+      hash = hashBytes(hash, &node->u._array.u._a.elmts,
+                       sizeof(node->u._array.u._a.elmts));
+      // no break
+    case YDT_UNION:
+      hash = hashNodes(hash, node->u._array.child);
+      break;
+
+    case YDT_ENUM:
+      for (auto c = node->u._enum.choices; c->str; c++) {
+        hash = hashBytes(hash, &c->id, sizeof(c->id));
+        hash = hashBytes(hash, c->str, strlen(c->str));
+      }
+      break;
+  }
+
+  return hash;
+}
+
+// Any change to the structures or to their YAML description changes
+// the hash and thus invalidates the existing copies
+static uint32_t getLayoutHash()
+{
+  static uint32_t layout = 0;
+  if (!layout) {
+    uint32_t version = EEPROM_VER;
+    uint32_t size = sizeof(ModelData);
+    layout = hashBytes(2166136261U, &version, sizeof(version));
+    layout = hashBytes(layout, &size, sizeof(size));
+    layout = hashNode(layout, get_modeldata_nodes());
+    if (!layout) layout = 1;
+  }
+  return layout;
+}
+
+static void getCacheDir(char* dir, const char* pathName)
+{
+  getModelPath(dir, MODEL_CACHE_DIR, pathName);
+}
+
+static void getCachePath(char* path, const char* filename, const char* pathName)
+{
+  char dir[256];
+  getCacheDir(dir, pathName);
+  getModelPath(path, filename, dir);
+  char* ext = strrchr(path, '.');
+  if (ext) strcpy(ext, MODEL_CACHE_EXT);
+}
+
+static bool getYamlInfo(const char* filename, const char* pathName,
+                        FILINFO* info)
+{
+  char path[256];
+  getModelPath(path, filename, pathName);
+  return f_stat(path, info) == FR_OK;
+}
+
+bool modelCacheRead(const char* filename, ModelData* model,
+                    const char* pathName)
+{
+  FILINFO info;
+  if (!getYamlInfo(filename, pathName, &info)) return false;
+
+  char path[256];
+  getCachePath(path, filename, pathName);
+
+  FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK) return false;
+
+  ModelCacheHeader header;
+  UINT read;
+  bool valid = f_read(&file, &header, sizeof(header), &read) == FR_OK &&
+               read == sizeof(header) && header.magic == MODEL_CACHE_MAGIC &&
+               header.layout == getLayoutHash() &&
+               header.dataSize == sizeof(ModelData) &&
+               header.yamlSize == info.fsize &&
+               header.yamlDate == info.fdate && header.yamlTime == info.ftime;
+
+  if (valid) {
+    valid = f_read(&file, model, sizeof(ModelData), &read) == FR_OK &&
+            read == sizeof(ModelData) &&
+            crc16(CRC_1021, (const uint8_t*)model, sizeof(ModelData)) ==
+                header.checksum;
+  }
+
+  f_close(&file);
+
+  TRACE("model cache %s: %s", filename, valid ? "hit" : "stale");
+  return valid;
+}
+
+void modelCacheWrite(const char* filename, const ModelData* model,
+                     const char* pathName)
+{
+  ModelCacheHeader header;
+  memclear(&header, sizeof(header));
+
+  FILINFO info;
+  if (!getYamlInfo(filename, pathName, &info)) return;
+
+  header.magic = MODEL_CACHE_MAGIC;
+  header.layout = getLayoutHash();
+  header.dataSize = sizeof(ModelData);
+  header.yamlSize = info.fsize;
+  header.yamlDate = info.fdate;
+  header.yamlTime = info.ftime;
+  header.checksum = crc16(CRC_1021, (const uint8_t*)model, sizeof(ModelData));
+
+  char path[256];
+  getCacheDir(path, pathName);
+  if (sdCheckAndCreateDirectory(path)) return;
+
+  getCachePath(path, filename, pathName);
+
+  FIL file;
+  if (f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) return;
+
+  UINT written;
+  bool ok = f_write(&file, &header, sizeof(header), &written) == FR_OK &&
+            written == sizeof(header) &&
+            f_write(&file, model, sizeof(ModelData), &written) == FR_OK &&
+            written == sizeof(ModelData);
+  f_close(&file);
+
+  // a truncated copy would be rejected anyway, but do not keep it around
+  if (!ok) f_unlink(path);
+}
+
+void modelCacheRemove(const char* filename, const char* pathName)
+{
+  char path[256];
+  getCachePath(path, filename, pathName);
+  f_unlink(path);
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct ModelData;
+
+// Binary copies of the model files, loaded straight into g_model instead
+// of parsing the YAML. The YAML files stay the reference: a copy is only
+// used while it matches both the YAML file (size and date) and the data
+// layout of the running firmware.
+// The copies are kept in a CACHE sub-directory of the YAML file's one:
+// MODELS_PATH or a template folder.
+#define MODEL_CACHE_DIR   "CACHE"
+#define MODEL_CACHE_PATH  MODELS_PATH PATH_SEPARATOR MODEL_CACHE_DIR
+#define MODEL_CACHE_EXT   ".bin"
+
+// Returns true if 'model' has been loaded from the binary copy of the
+// YAML file 'filename' (in 'pathName')
+bool modelCacheRead(const char* filename, ModelData* model,
+                    const char* pathName = MODELS_PATH);
+
+// Stores 'model' as the binary copy of the YAML file 'filename', which must
+// have been written or read just before
+void modelCacheWrite(const char* filename, const ModelData* model,
+                     const char* pathName = MODELS_PATH);
+
+void modelCacheRemove(const char* filename, const char* pathName = MODELS_PATH);
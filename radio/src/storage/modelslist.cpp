@@ -28,6 +28,9 @@ using std::list;
 #if defined(SDCARD_YAML)
 #include "opentx.h"
 #include "storage/sdcard_yaml.h"
+#if defined(MODEL_CACHE)
+  #include "storage/model_cache.h"
+#endif
 #include "yaml/yaml_datastructs.h"
 #include "yaml/yaml_labelslist.h"
 #include "yaml/yaml_modelslist.h"
@@ -55,6 +58,18 @@ using std::list;
 ModelsList modelslist;
 ModelMap modelslabels;
 
+static BlockPool<sizeof(ModelCell), 16> modelCellPool;
+
+void *ModelCell::operator new(size_t)
+{
+  return modelCellPool.alloc();
+}
+
+void ModelCell::operator delete(void *ptr)
+{
+  modelCellPool.free(ptr);
+}
+
 ModelCell::ModelCell(const char *fileName) : valid_rfData(false)
 {
   strncpy(modelFilename, fileName, sizeof(modelFilename) - 1);
@@ -124,7 +139,95 @@ void ModelCell::setRfModuleData(uint8_t moduleIdx, ModuleData *modData)
   }
 }
 
+#if defined(SDCARD_YAML)
+/**
+ * @brief Refreshes the cached file hash from the model file on disk, so that
+ *        labels.yml stays valid after the model has been written
+ */
+
+void ModelCell::updateFinfoHash()
+{
+  char path[256];
+  getModelPath(path, modelFilename);
+
+  FILINFO finfo;
+  if (f_stat(path, &finfo) == FR_OK) {
+    FILInfoToHexStr(modelFinfoHash, &finfo);
+  }
+}
+#endif
+
 //-----------------------------------------------------------------------------
+/**
+ * @brief Rebuilds the filtering index if needed
+ * @details The label bits refer to the position of the models in modelslist
+ *          and are rebuilt whenever the labels or the list changed. The sort
+ *          permutation is only recomputed when the models are not in order
+ *          anymore (sort order changed, model renamed or opened)
+ */
+
+void ModelMap::updateIndex()
+{
+  const ModelsVector &models = modelslist;
+
+  if (!indexValid || indexedModels != models) {
+    indexedModels = models;
+    indexWords = (indexedModels.size() + 31) / 32;
+    labelBits.assign((labels.size() + 1) * indexWords, 0);
+
+    // Position of each model in the list
+    std::vector<std::pair<ModelCell *, uint16_t>> positions;
+    positions.reserve(indexedModels.size());
+    for (uint16_t i = 0; i < indexedModels.size(); i++) {
+      positions.emplace_back(indexedModels[i], i);
+    }
+    std::sort(positions.begin(), positions.end());
+
+    // Last row: models with any label
+    uint32_t *labeled = labelBits.data() + labels.size() * indexWords;
+    for (const auto &it : *this) {
+      auto pos = std::lower_bound(
+          positions.begin(), positions.end(),
+          std::make_pair(it.second, (uint16_t)0));
+      if (pos == positions.end() || pos->first != it.second ||
+          it.first >= labels.size())
+        continue;
+      uint32_t *bits = labelBits.data() + it.first * indexWords;
+      bits[pos->second / 32] |= 1U << (pos->second % 32);
+      labeled[pos->second / 32] |= 1U << (pos->second % 32);
+    }
+
+    sortedModels.clear();
+    indexValid = true;
+  }
+
+  auto less = [this](uint16_t a, uint16_t b) -> bool {
+    return isModelBefore(indexedModels[a], indexedModels[b], _sortOrder);
+  };
+
+  if (sortedModels.size() != indexedModels.size() ||
+      !std::is_sorted(sortedModels.begin(), sortedModels.end(), less)) {
+    sortedModels.resize(indexedModels.size());
+    for (uint16_t i = 0; i < sortedModels.size(); i++) sortedModels[i] = i;
+    if (_sortOrder != NO_SORT)
+      std::sort(sortedModels.begin(), sortedModels.end(), less);
+  }
+}
+
+/**
+ * @brief Returns the models whose bit is set, in sort order
+ */
+
+ModelsVector ModelMap::getModelsByBits(const std::vector<uint32_t> &bits)
+{
+  ModelsVector rv;
+  for (auto pos : sortedModels) {
+    if (bits[pos / 32] & (1U << (pos % 32)))
+      rv.push_back(indexedModels[pos]);
+  }
+  return rv;
+}
+
 /**
  * @brief Gets all models which don't have any labels selected
  *
@@ -134,13 +237,12 @@ void ModelCell::setRfModuleData(uint8_t moduleIdx, ModuleData *modData)
 
 ModelsVector ModelMap::getUnlabeledModels()
 {
-  ModelsVector unlabeledModels;
-  for (auto model : modelslist) {
-    if (modelslabels.getLabelsByModel(model).size() == 0)
-      unlabeledModels.emplace_back(model);
-  }
-  sortModelsBy(unlabeledModels, _sortOrder);
-  return unlabeledModels;
+  updateIndex();
+
+  const uint32_t *labeled = labelBits.data() + labels.size() * indexWords;
+  std::vector<uint32_t> bits(indexWords);
+  for (unsigned w = 0; w < indexWords; w++) bits[w] = ~labeled[w];
+  return getModelsByBits(bits);
 }
 
 /**
@@ -149,8 +251,11 @@ ModelsVector ModelMap::getUnlabeledModels()
 
 ModelsVector ModelMap::getAllModels()
 {
-  ModelsVector all = modelslist;
-  sortModelsBy(all, _sortOrder);
+  updateIndex();
+
+  ModelsVector all;
+  all.reserve(sortedModels.size());
+  for (auto pos : sortedModels) all.push_back(indexedModels[pos]);
   return all;
 }
 
@@ -166,12 +271,11 @@ ModelsVector ModelMap::getModelsByLabel(const std::string &lbl)
 {
   int index = getIndexByLabel(lbl);
   if (index < 0) return ModelsVector();
-  ModelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    if (it->first == index) rv.push_back(it->second);
-  }
-  sortModelsBy(rv, _sortOrder);
-  return rv;
+
+  updateIndex();
+
+  auto first = labelBits.begin() + index * indexWords;
+  return getModelsByBits(std::vector<uint32_t>(first, first + indexWords));
 }
 
 /**
@@ -184,29 +288,25 @@ ModelsVector ModelMap::getModelsByLabel(const std::string &lbl)
 
 ModelsVector ModelMap::getModelsByLabels(const LabelsVector &lbls)
 {
-  bool addunlabeled = false;
-  // Build a list of the requested indexes
-  std::vector<int> idxvect;
-  for (const auto &lbl : lbls) {
-    if (lbl == STR_UNLABELEDMODEL) addunlabeled = true;
-    int index = getIndexByLabel(lbl);
-    if (index >= 0) idxvect.push_back(index);
-  }
+  updateIndex();
 
-  ModelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    for (auto idx : idxvect) {
-      if (it->first == idx) rv.push_back(it->second);
+  std::vector<uint32_t> bits(indexWords, 0);
+  for (const auto &lbl : lbls) {
+    const uint32_t *lblbits;
+    bool invert = false;
+    if (lbl == STR_UNLABELEDMODEL) {
+      lblbits = labelBits.data() + labels.size() * indexWords;
+      invert = true;
+    } else {
+      int index = getIndexByLabel(lbl);
+      if (index < 0) continue;
+      lblbits = labelBits.data() + index * indexWords;
     }
+    for (unsigned w = 0; w < indexWords; w++)
+      bits[w] |= invert ? ~lblbits[w] : lblbits[w];
   }
 
-  if (addunlabeled) {
-    ModelsVector unlabeled = getUnlabeledModels();
-    rv.insert(rv.end(), unlabeled.begin(), unlabeled.end());
-  }
-
-  sortModelsBy(rv, _sortOrder);
-  return rv;
+  return getModelsByBits(bits);
 }
 
 /**
@@ -225,25 +325,19 @@ ModelsVector ModelMap::getModelsInLabels(const LabelsVector &lbls)
   if (lbls.size() == 1 && lbls.at(0) == STR_UNLABELEDMODEL)
     return getUnlabeledModels();
 
-  ModelsVector rv;
+  updateIndex();
 
-  for (const auto &mdl : modelslist) {
-    bool hasAllLabels = true;
-    LabelsVector mdllables = getLabelsByModel(mdl);
-    for (const auto &lbl : lbls) {
-      if (lbl == STR_UNLABELEDMODEL)  // If requesting unlabeled model ignore it
-        break;
-      if (std::find(mdllables.begin(), mdllables.end(), lbl) ==
-          mdllables.end()) {
-        hasAllLabels = false;
-        break;
-      }
-    }
-    if (hasAllLabels) rv.push_back(mdl);
+  std::vector<uint32_t> bits(indexWords, ~0U);
+  for (const auto &lbl : lbls) {
+    if (lbl == STR_UNLABELEDMODEL)  // If requesting unlabeled model ignore it
+      break;
+    int index = getIndexByLabel(lbl);
+    if (index < 0) return ModelsVector();  // no model can have it
+    const uint32_t *lblbits = labelBits.data() + index * indexWords;
+    for (unsigned w = 0; w < indexWords; w++) bits[w] &= lblbits[w];
   }
 
-  sortModelsBy(rv, _sortOrder);
-  return rv;
+  return getModelsByBits(bits);
 }
 
 /**
@@ -281,9 +375,8 @@ std::map<std::string, bool> ModelMap::getSelectedLabels(ModelCell *cell)
     if (lbl == "") continue;
     rval[lbl] = false;
   }
-  LabelsVector modlbl = getLabelsByModel(cell);
-  for (const auto &ml : modlbl) {  // Set to true if selected by the model
-    rval[ml] = true;
+  for (const auto &it : *this) {  // Set to true if selected by the model
+    if (it.second == cell) rval[getLabelByIndex(it.first)] = true;
   }
   return rval;
 }
@@ -299,11 +392,8 @@ std::map<std::string, bool> ModelMap::getSelectedLabels(ModelCell *cell)
 
 bool ModelMap::isLabelSelected(const std::string &label, ModelCell *cell)
 {
-  auto lbm = getLabelsByModel(cell);
-  if (std::find(lbm.begin(), lbm.end(), label) == lbm.end()) {
-    return false;
-  }
-  return true;
+  int index = getIndexByLabel(label);
+  return index >= 0 && hasLabel(cell, index);
 }
 
 /**
@@ -686,18 +776,14 @@ bool ModelMap::renameLabel(const std::string &from, std::string to,
     strncpy(modeldata->header.labels, ModelMap::toCSV(lbls).c_str(), LABELS_LENGTH);
     modeldata->header.labels[LABELS_LENGTH-1] = '\0';
 
-    char path[256];
-    getModelPath(path, modcell->modelFilename);
-
     if (modcell == modelslist.getCurrentModel()) {
       // If working on the current model, write current data to file instead
       memcpy(g_model.header.labels, modeldata->header.labels, LABELS_LENGTH);
-      fault = (writeFileYaml(path, get_modeldata_nodes(),
-                             (uint8_t *)&g_model, 0) != NULL);
+      fault = (writeModelYaml(modcell->modelFilename, &g_model) != NULL);
     } else {
-      fault = (writeFileYaml(path, get_modeldata_nodes(),
-                             (uint8_t *)modeldata, 0) != NULL);
+      fault = (writeModelYaml(modcell->modelFilename, modeldata) != NULL);
     }
+    if (!fault) modcell->updateFinfoHash();
 #if defined(SIMU)
     if (SIMU_SLEEP_OR_EXIT_MS(100)) break;
 #endif
@@ -811,10 +897,7 @@ bool ModelMap::updateModelFile(ModelCell *cell)
           LABELS_LENGTH - 1);
   modeldata->header.labels[LABELS_LENGTH - 1] = '\0';
 
-  char path[256];
-  getModelPath(path, cell->modelFilename);
-  fault = (writeFileYaml(path, get_modeldata_nodes(), (uint8_t *)modeldata, 0) !=
-           NULL);
+  fault = (writeModelYaml(cell->modelFilename, modeldata) != NULL);
 
   free(modeldata);
 
@@ -828,30 +911,26 @@ bool ModelMap::updateModelFile(ModelCell *cell)
 }
 
 /**
- * @brief Sorts a ModelsVector by sortby
+ * @brief Compares two models for sorting
  *
- * @param mv ModeslVector to sort
+ * @param a, b Models to compare
  * @param sortby NO_SORT, NAME_ASC, NAME_DES, DATE_ASC, DATE_DES,
+ * @return true if a is to be listed before b
  */
 
-void ModelMap::sortModelsBy(ModelsVector &mv, ModelsSortBy sortby)
+bool ModelMap::isModelBefore(ModelCell *a, ModelCell *b, ModelsSortBy sortby)
 {
-  if (sortby == DATE_DES) {
-    std::sort(mv.begin(), mv.end(), [](ModelCell *a, ModelCell *b) -> bool {
+  switch (sortby) {
+    case DATE_DES:
       return a->lastOpened > b->lastOpened;
-    });
-  } else if (sortby == DATE_ASC) {
-    std::sort(mv.begin(), mv.end(), [](ModelCell *a, ModelCell *b) -> bool {
+    case DATE_ASC:
       return a->lastOpened < b->lastOpened;
-    });
-  } else if (sortby == NAME_ASC) {
-    std::sort(mv.begin(), mv.end(), [](ModelCell *a, ModelCell *b) -> bool {
+    case NAME_ASC:
       return strcmp(a->modelName, b->modelName) < 0;
-    });
-  } else if (sortby == NAME_DES) {
-    std::sort(mv.begin(), mv.end(), [](ModelCell *a, ModelCell *b) -> bool {
+    case NAME_DES:
       return strcmp(a->modelName, b->modelName) > 0;
-    });
+    default:
+      return false;
   }
 }
 
@@ -864,6 +943,7 @@ void ModelMap::sortModelsBy(ModelsVector &mv, ModelsSortBy sortby)
 void ModelMap::setDirty(bool save)
 {
   _isDirty = true;
+  indexValid = false;
   storageDirty(EE_LABELS);
   if (save) storageCheck(true);
 }
@@ -979,6 +1059,22 @@ char *FILInfoToHexStr(char buffer[17], FILINFO *finfo)
   return buffer;
 }
 
+/**
+ * @brief Finds the scanned file info of a model file
+ *
+ * @param name Model filename
+ * @return filedat* nullptr if the file wasn't found in /MODELS
+ */
+
+ModelsList::filedat *ModelsList::findFileHash(const char *name)
+{
+  auto it = std::lower_bound(
+      fileHashInfo.begin(), fileHashInfo.end(), name,
+      [](const filedat &a, const char *b) { return a.name.compare(b) < 0; });
+  if (it == fileHashInfo.end() || it->name != name) return nullptr;
+  return &(*it);
+}
+
 /**
  * @brief Loads the Labels and Models from the labels.yml file
  *
@@ -1041,10 +1137,15 @@ bool ModelsList::loadYaml()
     f_closedir(&moddir);
   }
 
+  // Sorted by name so labels.yml entries can be matched with a binary search
+  std::sort(fileHashInfo.begin(), fileHashInfo.end(),
+            [](const filedat &a, const filedat &b) { return a.name < b.name; });
+
   // Check if models.yml exists
   // Any files found above that are not listed in the file will be moved into
   // /MDOELS/UNUSED and removed from the discovered file hash list
-  char line[LEN_MODELS_IDX_LINE + 1];
+  // Index files are read a sector at a time
+  alignas(4) char buffer[LABELS_READ_BLOCK_SIZE];
   FILINFO fno;
   FRESULT result;
   bool foundInModels = f_stat(MODELSLIST_YAML_PATH, &fno) == FR_OK;
@@ -1074,25 +1175,18 @@ bool ModelsList::loadYaml()
     void *ctx = get_modelslist_iter(&modfiles);
     ymp.init(get_modelslist_parser_calls(), ctx);
     UINT bytes_read = 0;
-    while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
+    while (f_read(&file, buffer, sizeof(buffer), &bytes_read) == FR_OK) {
       if (bytes_read == 0) break;
       if (f_eof(&file)) ymp.set_eof();
-      if (ymp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
+      if (ymp.parse(buffer, bytes_read) != YamlParser::CONTINUE_PARSING) break;
     }
     f_close(&file);
 
     // Loop through file hases, move any files found that don't exists to /unused
     std::vector<filedat> newFileHash;
+    std::sort(modfiles.begin(), modfiles.end());
     for(const auto &fhas: fileHashInfo) {
-      bool found = false;
-      for(const auto &file : modfiles) {
-        if (file == fhas.name) {
-          TRACE_LABELS("Found file %s in models.yml.. OK!", file);
-          found = true;
-          break;
-        }
-      }
-      if(!found) {
+      if(!std::binary_search(modfiles.begin(), modfiles.end(), fhas.name)) {
         moveRequired = true;
         TRACE_LABELS("Model %s not in models.yml, moving to /UNUSED", fhas.name.c_str());
         // Move model into unused folder.
@@ -1100,6 +1194,7 @@ bool ModelsList::loadYaml()
         if(warning)
           POPUP_WARNING(warning);
       } else {
+        TRACE_LABELS("Found file %s in models.yml.. OK!", fhas.name.c_str());
         newFileHash.push_back(fhas); // File exists, keep it
       }
     }
@@ -1133,10 +1228,10 @@ bool ModelsList::loadYaml()
     void *ctx = get_labelslist_iter();
     yp.init(get_labelslist_parser_calls(), ctx);
     UINT bytes_read = 0;
-    while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
+    while (f_read(&file, buffer, sizeof(buffer), &bytes_read) == FR_OK) {
       if (bytes_read == 0) break;
       if (f_eof(&file)) yp.set_eof();
-      if (yp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
+      if (yp.parse(buffer, bytes_read) != YamlParser::CONTINUE_PARSING) break;
     }
     f_close(&file);
   }
@@ -1356,6 +1451,9 @@ void ModelsList::updateCurrentModelCell()
     currentModel->modelFilename[LEN_MODEL_FILENAME] = '\0';
     currentModel->setModelName(g_model.header.name);
     currentModel->setRfData(&g_model);
+#if defined(SDCARD_YAML)
+    currentModel->updateFinfoHash();
+#endif
     modelslabels.setDirty();
   } else {
     TRACE("ModelList Error - No Current Model");
@@ -1452,6 +1550,10 @@ bool ModelsList::removeModel(ModelCell *model)
     return true;
   }
 
+#if defined(MODEL_CACHE)
+  modelCacheRemove(model->modelFilename);
+#endif
+
   // Free memory
   delete(model);
 
@@ -40,12 +40,16 @@
 #endif
 
 #include "dataconstants.h"
+#include "pool_allocator.h"
 #include "rtc.h"
 
 // modelXXXXXXX.bin F,FF F,3F,FF\r\n
 #define LEN_MODELS_IDX_LINE \
   (LEN_MODEL_FILENAME + sizeof(" F,FF F,3F,FF\r\n") - 1)
 
+// models.yml / labels.yml read chunk, one SD sector
+#define LABELS_READ_BLOCK_SIZE 512
+
 #define DEFAULT_MODEL_SORT NAME_ASC
 
 #if LCD_W > LCD_H // Landscape
@@ -70,6 +74,8 @@ typedef struct PACKED {
 
 #define FILE_HASH_LENGTH (sizeof(FInfoH) * 2)  // Hex string output
 
+char *FILInfoToHexStr(char buffer[17], FILINFO *finfo);
+
 class ModelCell
 {
  public:
@@ -96,6 +102,13 @@ class ModelCell
   void setModelId(uint8_t moduleIdx, uint8_t id);
   void setRfModuleData(uint8_t moduleIdx, ModuleData *modData);
   bool fetchRfData();
+#if defined(SDCARD_YAML)
+  void updateFinfoHash();
+#endif
+
+  // cells are allocated from a dedicated pool
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr);
 };
 
 typedef struct {
@@ -115,12 +128,18 @@ typedef enum {
   SORT_COUNT
 } ModelsSortBy;
 
+// one node per label of each model: kept in a pool as they are
+// replaced each time labels are edited
+typedef std::multimap<uint16_t, ModelCell *, std::less<uint16_t>,
+                      PoolAllocator<std::pair<const uint16_t, ModelCell *>>>
+    ModelLabelsMap;
+
 /**
  * @brief ModelMap is a multimap of all models and their cooresponding
  *        labels. Lables are referenced by index, stored in var labels
  */
 
-class ModelMap : protected std::multimap<uint16_t, ModelCell *>
+class ModelMap : protected ModelLabelsMap
 {
  public:
   ModelsVector getUnlabeledModels();
@@ -183,13 +202,25 @@ class ModelMap : protected std::multimap<uint16_t, ModelCell *>
   bool removeModels(
       ModelCell *);  // Should only be called from ModelsList remove model
   bool updateModelFile(ModelCell *);
-  void sortModelsBy(ModelsVector &mv, ModelsSortBy sortby);
+  static bool isModelBefore(ModelCell *a, ModelCell *b, ModelsSortBy sortby);
+
+  // Filtering index: for each label (and a last row for "any label"), one
+  // bit per model in indexedModels, plus the models positions in sort order
+  std::vector<uint32_t> labelBits;
+  ModelsVector indexedModels;
+  std::vector<uint16_t> sortedModels;
+  unsigned indexWords = 0;
+  bool indexValid = false;
+
+  void updateIndex();
+  ModelsVector getModelsByBits(const std::vector<uint32_t> &bits);
 
   void clear()
   {
     _isDirty = true;
+    indexValid = false;
     labels.clear();
-    std::multimap<uint16_t, ModelCell *>::clear();
+    ModelLabelsMap::clear();
   }
 
   int getIndexByLabel(const std::string &str)
@@ -198,6 +229,23 @@ class ModelMap : protected std::multimap<uint16_t, ModelCell *>
     return a == labels.end() ? -1 : a - labels.begin();
   }
 
+  bool hasLabel(ModelCell *cell, uint16_t index) const
+  {
+    auto range = equal_range(index);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == cell) return true;
+    }
+    return false;
+  }
+
+  bool hasLabels(ModelCell *cell) const
+  {
+    for (const auto &it : *this) {
+      if (it.second == cell) return true;
+    }
+    return false;
+  }
+
   std::string getLabelByIndex(uint16_t index)
   {
     if (index < (uint16_t)labels.size())
@@ -265,6 +313,7 @@ class ModelsList : public ModelsVector
     bool celladded = false;
   } filedat;
   std::vector<filedat> fileHashInfo;
+  filedat *findFileHash(const char *name);
 
  protected:
   FIL file;
@@ -43,10 +43,39 @@ RamBackup * ramBackup = &_ramBackup;
 RamBackup * ramBackup = (RamBackup *)BKPSRAM_BASE;
 #endif
 
+// Hash of the data last written to the backup: storageDirty() is called
+// for every edit, even when a value ends up unchanged, and hashing is
+// much cheaper than compressing into the backup SRAM again
+static uint32_t ramBackupHash = 0;
+
+static uint32_t hashBackupData()
+{
+  // FNV-1a, one 32 bit word at a time
+  const uint8_t * data = (const uint8_t *)&ramBackupUncompressed;
+  uint32_t hash = 2166136261u;
+  unsigned int i = 0;
+  for (; i + 4 <= sizeof(ramBackupUncompressed); i += 4) {
+    uint32_t word;
+    memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * 16777619u;
+  }
+  for (; i < sizeof(ramBackupUncompressed); i++) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
 void rambackupWrite()
 {
   copyRadioData(&ramBackupUncompressed.radio, &g_eeGeneral);
   copyModelData(&ramBackupUncompressed.model, &g_model);
+
+  uint32_t hash = hashBackupData();
+  if (hash == ramBackupHash && ramBackup->size != 0) {
+    return;
+  }
+  ramBackupHash = hash;
+
   ramBackup->size = compress(ramBackup->data, sizeof(ramBackup->data),
                              (const uint8_t *)&ramBackupUncompressed,
                              sizeof(ramBackupUncompressed));
@@ -64,6 +93,8 @@ bool rambackupRestore()
   if (uncompress((uint8_t *)&ramBackupUncompressed, sizeof(ramBackupUncompressed), ramBackup->data, ramBackup->size) != sizeof(ramBackupUncompressed))
     return false;
 
+  ramBackupHash = hashBackupData();
+
   memset(&g_eeGeneral, 0, sizeof(g_eeGeneral));
   memset(&g_model, 0, sizeof(g_model));
   copyRadioData(&g_eeGeneral, &ramBackupUncompressed.radio);
@@ -24,6 +24,9 @@
 #include "sdcard_common.h"
 #include "modelslist.h"
 #include "model_init.h"
+#include "tasks.h"
+#include "tasks/storage_task.h"
+#include "tasks/mixer_task.h"
 
 void getModelPath(char * path, const char * filename, const char* pathName)
 {
@@ -69,8 +72,49 @@ void storageFormat()
   setModelDefaults();
 }
 
+#if defined(STORAGE_MODELSLIST)
+static void storageCheckLabels()
+{
+  if (storageDirtyMsk & EE_LABELS) {
+    TRACE("SD card write labels");
+    storageDirtyMsk &= ~EE_LABELS;
+    const char * error = modelslist.save();
+    if (error) {
+      TRACE("writeLabels error=%s", error);
+    }
+  }
+}
+#endif
+
+// screen changes are part of the model file, they are written with it
+static void storageCheckScreens(bool immediately)
+{
+  if ((storageDirtyMsk & EE_SCREENS) &&
+      (immediately || (storageDirtyMsk & EE_MODEL) ||
+       (tmr10ms_t)(get_tmr10ms() - storageDirtyTime10ms) >=
+           (tmr10ms_t)SCREENS_WRITE_DELAY_10MS)) {
+    storageDirtyMsk = (storageDirtyMsk & ~EE_SCREENS) | EE_MODEL;
+  }
+}
+
 void storageCheck(bool immediately)
 {
+  storageCheckScreens(immediately);
+
+#if defined(STORAGE_TASK)
+  if (!immediately) {
+    // the storage task writes a copy of the radio settings / model,
+    // whatever it cannot take yet is retried on the next call
+    storageDirtyMsk &= ~storageTaskStage(storageDirtyMsk);
+    storageCheckLabels();
+    return;
+  }
+
+  if (storageTaskFlush() & EE_MODEL) {
+    modelslist.updateCurrentModelCell();
+  }
+#endif
+
   if (storageDirtyMsk & EE_GENERAL) {
     TRACE("eeprom write general");
     storageDirtyMsk &= ~EE_GENERAL;
@@ -81,14 +125,7 @@ void storageCheck(bool immediately)
   }
 
 #if defined(STORAGE_MODELSLIST)
-  if (storageDirtyMsk & EE_LABELS) {
-    TRACE("SD card write labels");
-    storageDirtyMsk &= ~EE_LABELS;
-    const char * error = modelslist.save();
-    if (error) {
-      TRACE("writeLabels error=%s", error);
-    }
-  }
+  storageCheckLabels();
 #endif
 
   if (storageDirtyMsk & EE_MODEL) {
@@ -128,8 +165,86 @@ const char * createModel()
 }
 #endif
 
+#if defined(STORAGE_MODELSLIST)
+// Copy of the model highlighted in the model selector, read ahead of
+// time so that selecting it does not have to wait for the SD card
+static ModelData* preloadedModel = nullptr;
+static char preloadedFilename[LEN_MODEL_FILENAME + 1];
+
+void preloadModel(const char* filename)
+{
+  if (preloadedModel &&
+      !strncmp(preloadedFilename, filename, LEN_MODEL_FILENAME))
+    return;
+
+  if (!preloadedModel) {
+    preloadedModel = (ModelData*)malloc(sizeof(ModelData));
+    if (!preloadedModel) return;
+  }
+
+  preloadedFilename[0] = '\0';
+  if (!readModel(filename, (uint8_t*)preloadedModel, sizeof(ModelData))) {
+    strncpy(preloadedFilename, filename, LEN_MODEL_FILENAME);
+    preloadedFilename[LEN_MODEL_FILENAME] = '\0';
+  }
+}
+
+void invalidatePreloadedModel(const char* filename)
+{
+  if (!strncmp(preloadedFilename, filename, LEN_MODEL_FILENAME))
+    preloadedFilename[0] = '\0';
+}
+
+void releasePreloadedModel()
+{
+  free(preloadedModel);
+  preloadedModel = nullptr;
+  preloadedFilename[0] = '\0';
+}
+
+// The RF link can stay up if the new model drives the modules exactly
+// like the current one
+static bool isSameModulesSetup(const ModelData* model)
+{
+  return !memcmp(model->moduleData, g_model.moduleData,
+                 sizeof(g_model.moduleData)) &&
+         !memcmp(model->header.modelId, g_model.header.modelId,
+                 sizeof(g_model.header.modelId))
+#if defined(PXX2)
+         && !memcmp(model->modelRegistrationID, g_model.modelRegistrationID,
+                    PXX2_LEN_REGISTRATION_ID)
+#endif
+      ;
+}
+
+static bool loadPreloadedModel(const char* filename)
+{
+  if (!preloadedModel || !preloadedFilename[0] ||
+      strncmp(preloadedFilename, filename, LEN_MODEL_FILENAME))
+    return false;
+
+  bool keepModules = mixerTaskStarted() && isSameModulesSetup(preloadedModel);
+  preModelLoad(keepModules);
+
+  // the modules may still be running: swap the data in one go
+  if (keepModules) mixerTaskStop();
+  memcpy(&g_model, preloadedModel, sizeof(g_model));
+  if (keepModules) mixerTaskStart();
+
+  releasePreloadedModel();
+  return true;
+}
+#endif
+
 const char* loadModel(char* filename, bool alarms)
 {
+#if defined(STORAGE_MODELSLIST)
+  if (loadPreloadedModel(filename)) {
+    postModelLoad(alarms);
+    return nullptr;
+  }
+#endif
+
   preModelLoad();
 
   const char* error = readModel(filename, (uint8_t*)&g_model, sizeof(g_model));
@@ -170,7 +285,22 @@ const char* loadModelTemplate(const char* fileName, const char* filePath)
   return nullptr;
 }
 
-void storageReadAll()
+#if !defined(STORAGE_MODELSLIST)
+static bool modelHeadersDeferred = false;
+
+void loadDeferredModelHeaders()
+{
+  if (modelHeadersDeferred) {
+    modelHeadersDeferred = false;
+    loadModelHeaders();
+  }
+}
+#endif
+
+// The model headers are only used by the model selection, and reading
+// them parses every model file: the boot sequence defers them until
+// the mixer is running
+void storageReadAll(bool deferModelHeaders)
 {
   TRACE("storageReadAll");
 
@@ -185,8 +315,12 @@ void storageReadAll()
   }
 #if !defined(STORAGE_MODELSLIST)
   else {
-    loadModelHeaders();
+    modelHeadersDeferred = deferModelHeaders;
+    if (!deferModelHeaders)
+      loadModelHeaders();
   }
+#else
+  (void)deferModelHeaders;
 #endif
 
   for (uint8_t i = 0; languagePacks[i] != nullptr; i++) {
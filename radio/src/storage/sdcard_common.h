@@ -61,6 +61,14 @@ const char * loadModelTemplate(const char* fileName, const char* filePath);
 const char * createModel();
 const char * writeModel();
 
+#if defined(STORAGE_MODELSLIST)
+// read a model ahead of time, loadModel() then uses it without SD access
+void preloadModel(const char* filename);
+// drop the preloaded copy if it is this model (file changed on disk)
+void invalidatePreloadedModel(const char* filename);
+void releasePreloadedModel();
+#endif
+
 #if !defined(STORAGE_MODELSLIST)
 
 // index storage vs modelslist
@@ -27,6 +27,10 @@
 #include "sdcard_yaml.h"
 #include "modelslist.h"
 
+#if defined(MODEL_CACHE)
+  #include "model_cache.h"
+#endif
+
 #include "yaml/yaml_tree_walker.h"
 #include "yaml/yaml_parser.h"
 #include "yaml/yaml_datastructs.h"
@@ -38,6 +42,10 @@
  #include "storage/eeprom_rlc.h"
 #endif
 
+// Files are read in whole, aligned sectors: FatFs then reads them straight
+// into the buffer instead of copying small chunks out of its sector window
+#define YAML_READ_BLOCK_SIZE  512
+
 const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, void* parser_ctx, ChecksumResult* checksum_result)
 {
     FIL  file;
@@ -56,8 +64,8 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
     uint16_t file_checksum = 0;
 
     bool first_block = true;
-    char buffer[32];
-    while (f_read(&file, buffer, sizeof(buffer)-1, &bytes_read) == FR_OK) {
+    alignas(4) char buffer[YAML_READ_BLOCK_SIZE];
+    while (f_read(&file, buffer, sizeof(buffer), &bytes_read) == FR_OK) {
       if (bytes_read == 0)  // EOF
         break;
       total_bytes += bytes_read;
@@ -74,13 +82,14 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
           char* endPos = startPos;
           // Advance through the value
           while((*endPos != '\r') && (*endPos != '\n')) {
-            if (endPos > buffer + bytes_read) {
+            if (endPos >= buffer + bytes_read) {
               return SDCARD_ERROR(	FR_INT_ERR );
             }
             endPos++;
           }
           // Skip trailing newline
-          while((*endPos == '\r') || (*endPos == '\n')) {
+          while((endPos < buffer + bytes_read) &&
+                ((*endPos == '\r') || (*endPos == '\n'))) {
             *endPos = 0;
             endPos++;
           }
@@ -138,6 +147,7 @@ const char * loadRadioSettingsYaml(bool checks)
 
     ChecksumResult checksum_status;
     const char* p = attemptLoad(RADIO_SETTINGS_YAML_PATH, &checksum_status);
+    generalDataRevision++;
 
     if(!checks)
       return p;
@@ -235,25 +245,88 @@ bool YamlFileChecksum(const YamlNode* root_node, uint8_t* data, uint16_t* checks
 }
 
 
+// Output is staged in whole sectors: FatFs then writes them straight to
+// the card instead of copying lots of small strings into its sector buffer
+#define YAML_WRITE_BLOCK_SIZE  512
+
+// Room for any uint16_t checksum value
+#define YAML_CHECKSUM_DIGITS   5
+
 struct yaml_writer_ctx {
-    FIL*    file;
-    FRESULT result;
+    FIL*     file;
+    FRESULT  result;
+    bool     checksum_enabled;
+    uint16_t checksum;
+    uint16_t buffer_len;
+    uint16_t checksum_ofs;   // buffered bytes before this one are not summed
+    alignas(4) char buffer[YAML_WRITE_BLOCK_SIZE];
 };
 
-static bool yaml_writer(void* opaque, const char* str, size_t len)
+static bool yaml_writer_flush(yaml_writer_ctx* ctx)
 {
+    if (ctx->buffer_len == 0)
+        return true;
+
     UINT bytes_written;
+    UINT len = ctx->buffer_len;
+    ctx->buffer_len = 0;
+
+    // summed a whole block at a time rather than for each fragment
+    if (ctx->checksum_enabled && len > ctx->checksum_ofs) {
+        ctx->checksum = crc16(0, (const uint8_t *)ctx->buffer + ctx->checksum_ofs,
+                              len - ctx->checksum_ofs, ctx->checksum);
+    }
+    ctx->checksum_ofs = 0;
+
+    ctx->result = f_write(ctx->file, ctx->buffer, len, &bytes_written);
+    return (ctx->result == FR_OK) && (bytes_written == len);
+}
+
+static bool yaml_writer(void* opaque, const char* str, size_t len)
+{
     yaml_writer_ctx* ctx = (yaml_writer_ctx*)opaque;
 
 #if defined(DEBUG_YAML)
     TRACE_NOCRLF("%.*s",len,str);
 #endif
 
-    ctx->result = f_write(ctx->file, str, len, &bytes_written);
-    return (ctx->result == FR_OK) && (bytes_written == len);
+    while (len > 0) {
+        size_t chunk = min<size_t>(len, sizeof(ctx->buffer) - ctx->buffer_len);
+        memcpy(ctx->buffer + ctx->buffer_len, str, chunk);
+        ctx->buffer_len += chunk;
+        str += chunk;
+        len -= chunk;
+
+        if (ctx->buffer_len == sizeof(ctx->buffer) && !yaml_writer_flush(ctx))
+            return false;
+    }
+
+    return true;
 }
 
-const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t checksum)
+static bool yaml_write_checksum(yaml_writer_ctx* ctx, uint16_t checksum, bool padded)
+{
+    if (!yaml_writer(ctx, YAMLFILE_CHECKSUM_TAG_NAME, strlen(YAMLFILE_CHECKSUM_TAG_NAME)) ||
+        !yaml_writer(ctx, ": ", 2))
+        return false;
+
+    const char* p_out = yaml_unsigned2str((int)checksum);
+    size_t len = strlen(p_out);
+    if (!yaml_writer(ctx, p_out, len))
+        return false;
+
+    // trailing spaces keep the line length fixed, so that the value
+    // can be patched in once the rest of the file has been written
+    for (; padded && len < YAML_CHECKSUM_DIGITS; len++) {
+        if (!yaml_writer(ctx, " ", 1))
+            return false;
+    }
+
+    return yaml_writer(ctx, "\r\n", 2);
+}
+
+static const char* writeYamlFile(const char* path, const YamlNode* root_node, uint8_t* data,
+                                 uint16_t checksum, uint16_t* calculated_checksum)
 {
     FIL file;
 
@@ -267,39 +340,75 @@ const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t*
     yaml_writer_ctx ctx;
     ctx.file = &file;
     ctx.result = FR_OK;
+    ctx.checksum_enabled = false;
+    ctx.buffer_len = 0;
+    ctx.checksum_ofs = 0;
 
     // Try to add CRC
-    if (checksum != 0) {
-      if (!yaml_writer(&ctx, YAMLFILE_CHECKSUM_TAG_NAME, strlen(YAMLFILE_CHECKSUM_TAG_NAME))) return NULL;
-      if (!yaml_writer(&ctx, ": ", 2)) return SDCARD_ERROR(FR_INVALID_PARAMETER);
-      const char* p_out = NULL;
-      p_out = yaml_unsigned2str((int)checksum);
-      if (p_out && !yaml_writer(&ctx, p_out, strlen(p_out))) return SDCARD_ERROR(FR_INVALID_PARAMETER);
-      yaml_writer(&ctx, "\r\n", 2);
+    if (calculated_checksum || checksum != 0) {
+      if (!yaml_write_checksum(&ctx, checksum, calculated_checksum != nullptr)) {
+        f_close(&file);
+        return SDCARD_ERROR(FR_INVALID_PARAMETER);
+      }
     }
 
+    // The checksum covers everything after its own line
+    ctx.checksum_enabled = (calculated_checksum != nullptr);
+    ctx.checksum = 0xFFFF;
+    ctx.checksum_ofs = ctx.buffer_len;
 
-    if (!tree.generate(yaml_writer, &ctx)) {
+    bool generated = tree.generate(yaml_writer, &ctx);
+    if (!yaml_writer_flush(&ctx) || !generated) {
         if (ctx.result != FR_OK) {
             f_close(&file);
             return SDCARD_ERROR(ctx.result);
         }
     }
 
+    if (calculated_checksum) {
+      *calculated_checksum = ctx.checksum;
+
+      // Rewrite the placeholder line at the start of the file
+      ctx.checksum_enabled = false;
+      result = f_lseek(&file, 0);
+      if (result == FR_OK) {
+        yaml_write_checksum(&ctx, ctx.checksum, true);
+        yaml_writer_flush(&ctx);
+        result = ctx.result;
+      }
+      if (result != FR_OK) {
+        f_close(&file);
+        return SDCARD_ERROR(result);
+      }
+    }
+
     f_close(&file);
     return NULL;
 }
 
+const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t checksum)
+{
+    return writeYamlFile(path, root_node, data, checksum, nullptr);
+}
+
+const char* writeFileYamlWithChecksum(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t* checksum)
+{
+    return writeYamlFile(path, root_node, data, 0, checksum);
+}
+
 const char * writeGeneralSettings()
+{
+    g_eeGeneral.manuallyEdited = false;
+    return writeGeneralSettingsYaml(&g_eeGeneral);
+}
+
+const char * writeGeneralSettingsYaml(const RadioData* radioData)
 {
     TRACE("YAML radio settings writer");
     uint16_t file_checksum = 0;
 
-    YamlFileChecksum(get_radiodata_nodes(), (uint8_t*)&g_eeGeneral, &file_checksum);
-    g_eeGeneral.manuallyEdited = false;
-
-    const char *p = writeFileYaml(RADIO_SETTINGS_TMPFILE_YAML_PATH, get_radiodata_nodes(),
-                         (uint8_t*)&g_eeGeneral, file_checksum);
+    const char *p = writeFileYamlWithChecksum(RADIO_SETTINGS_TMPFILE_YAML_PATH, get_radiodata_nodes(),
+                         (uint8_t*)radioData, &file_checksum);
     TRACE("generalSettings written with checksum %u", file_checksum);
 
     if (p != NULL) {
@@ -334,6 +443,19 @@ const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t siz
         return "YAML size error";
     }
 
+#if defined(MODEL_CACHE)
+    // templates are applied through their binary copy as well
+    bool use_cache =
+        init_model &&
+        (!strcmp(pathName, STR_MODELS_PATH) ||
+         !strncmp(pathName, TEMPLATES_PATH, sizeof(TEMPLATES_PATH) - 1));
+    if (use_cache &&
+        modelCacheRead(filename, reinterpret_cast<ModelData*>(buffer),
+                       pathName)) {
+      return nullptr;
+    }
+#endif
+
     char path[256];
     getModelPath(path, filename, pathName);
 
@@ -364,7 +486,17 @@ const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t siz
       md->rfAlarms.critical = 42;
     }
 
-    return readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree, NULL);
+    const char* error =
+        readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree, NULL);
+
+#if defined(MODEL_CACHE)
+    if (use_cache && !error) {
+      modelCacheWrite(filename, reinterpret_cast<ModelData*>(buffer),
+                      pathName);
+    }
+#endif
+
+    return error;
 }
 
 static const char _wrongExtentionError[] = "wrong file extension";
@@ -380,11 +512,31 @@ const char* readModel(const char* filename, uint8_t* buffer, uint32_t size, cons
 }
 
 const char * writeModelYaml(const char* filename)
+{
+    return writeModelYaml(filename, &g_model);
+}
+
+const char * writeModelYaml(const char* filename, const ModelData* model)
 {
     TRACE("YAML model writer");
     char path[256];
     getModelPath(path, filename);
-    return writeFileYaml(path, get_modeldata_nodes(), (uint8_t*)&g_model,0 );
+    const char* error =
+        writeFileYaml(path, get_modeldata_nodes(), (uint8_t*)model, 0);
+
+#if defined(STORAGE_MODELSLIST)
+    invalidatePreloadedModel(filename);
+#endif
+
+#if defined(MODEL_CACHE)
+    if (!error) {
+      modelCacheWrite(filename, model);
+    } else {
+      modelCacheRemove(filename);
+    }
+#endif
+
+    return error;
 }
 
 #if !defined(STORAGE_MODELSLIST)
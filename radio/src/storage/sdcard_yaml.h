@@ -28,7 +28,17 @@ constexpr uint8_t MODELIDX_STRLEN = sizeof(MODEL_FILENAME_PREFIX "00");
 
 const char * loadRadioSettingsYaml(bool checks);
 const char * writeModelYaml(const char* filename);
+
+struct ModelData;
+struct RadioData;
+
+// write the given copy of the model / radio settings (instead of g_model / g_eeGeneral)
+const char * writeModelYaml(const char* filename, const ModelData* model);
+const char * writeGeneralSettingsYaml(const RadioData* radioData);
 const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t size, const char* pathName = STR_MODELS_PATH);
 bool YamlFileChecksum(const YamlNode* root_node, uint8_t* data, uint16_t* checksum);
 
+// Generates the file and its leading checksum line in a single pass
+const char* writeFileYamlWithChecksum(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t* checksum);
+
 void getModelNumberStr(uint8_t idx, char* model_idx);
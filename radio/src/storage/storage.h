@@ -32,8 +32,22 @@
   #define WRITE_DELAY_10MS 200
 #endif
 
+// layout / widget changes come in bursts (editing, swiping views),
+// they are not worth a model write each
+#define SCREENS_WRITE_DELAY_10MS       6000 /* 60s */
+
 extern uint8_t   storageDirtyMsk;
 extern tmr10ms_t storageDirtyTime10ms;
+
+// incremented each time the model data is modified (or loaded),
+// used to invalidate data derived from the model
+extern uint16_t  modelDataRevision;
+// same for the radio settings
+extern uint16_t  generalDataRevision;
+// incremented when model values are changed at runtime without being
+// saved (GVars streamed from Lua), used by the mixer caches
+extern uint16_t  modelRuntimeRevision;
+
 #define TIME_TO_WRITE()                (storageDirtyMsk && (tmr10ms_t)(get_tmr10ms() - storageDirtyTime10ms) >= (tmr10ms_t)WRITE_DELAY_10MS)
 
 #if defined(RTC_BACKUP_RAM)
@@ -48,7 +62,7 @@ extern tmr10ms_t rambackupDirtyTime10ms;
 //
 void storageEraseAll(bool warn);
 void storageFormat();
-void storageReadAll();
+void storageReadAll(bool deferModelHeaders = false);
 void storageCheck(bool immediately);
 
 //
@@ -57,7 +71,8 @@ void storageCheck(bool immediately);
 void storageDirty(uint8_t msk);
 void storageFlushCurrentModel();
 void postRadioSettingsLoad();
-void preModelLoad();
+// keepModules: leave the RF modules running (same modules setup)
+void preModelLoad(bool keepModules = false);
 void postModelLoad(bool alarms);
 void checkExternalAntenna();
 
@@ -66,6 +81,8 @@ extern ModelHeader modelHeaders[MAX_MODELS];
 
 void loadModelHeader(uint8_t id, ModelHeader *header);
 void loadModelHeaders();
+// Loads the model headers left out by storageReadAll(true)
+void loadDeferredModelHeaders();
 
 uint8_t findNextUnusedModelId(uint8_t index, uint8_t module);
 #endif
@@ -36,6 +36,9 @@
 
 uint8_t   storageDirtyMsk;
 tmr10ms_t storageDirtyTime10ms;
+uint16_t  modelDataRevision;
+uint16_t  generalDataRevision;
+uint16_t  modelRuntimeRevision;
 
 #if defined(RTC_BACKUP_RAM)
 uint8_t   rambackupDirtyMsk = EE_GENERAL | EE_MODEL;
@@ -47,13 +50,24 @@ void storageDirty(uint8_t msk)
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  if (msk & EE_MODEL) {
+    modelDataRevision++;
+  }
+
+  if (msk & EE_GENERAL) {
+    generalDataRevision++;
+  }
+
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
 #endif
 }
 
-void preModelLoad()
+// set by preModelLoad() when the modules were left running
+static bool modulesKept = false;
+
+void preModelLoad(bool keepModules)
 {
   watchdogSuspend(500/*5s*/);
 
@@ -61,8 +75,10 @@ void preModelLoad()
   logsClose();
 #endif
 
+  modulesKept = keepModules;
+
   bool needDelay = false;
-  if (mixerTaskStarted()) {
+  if (mixerTaskStarted() && !keepModules) {
     pulsesStop();
     needDelay = true;
   }
@@ -227,6 +243,7 @@ if(g_model.rssiSource) {
 
   loadCurves();
   sortMixerLines();
+  modelDataRevision++;
 
 #if defined(GUI)
   if (alarms) {
@@ -238,9 +255,10 @@ if(g_model.rssiSource) {
   // Mixer should only be restarted
   // if we are switching between models,
   // not on first boot (started later on)
-  if (mixerTaskStarted()) {
+  if (mixerTaskStarted() && !modulesKept) {
     pulsesStart();
   }
+  modulesKept = false;
 
 #if defined(SDCARD)
   referenceModelAudioFiles();
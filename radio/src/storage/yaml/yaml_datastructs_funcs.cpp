@@ -1477,10 +1477,18 @@ static void r_customFn(void* user, uint8_t* data, uint32_t bitoffs,
   case FUNC_SET_SCREEN:
 #endif  
   case FUNC_HAPTIC:
-  case FUNC_LOGS: // 10th of seconds
     CFN_PARAM(cfn) = yaml_str2uint(val, l_sep);
     break;
 
+  case FUNC_LOGS: // 10th of seconds[,profile]
+    CFN_PARAM(cfn) = yaml_str2uint_ref(val, val_len);
+    if (val_len > 0 && val[0] == ',') {
+      val++; val_len--;
+      CFN_LOGS_PROFILE(cfn) = yaml_str2uint_ref(val, val_len);
+    }
+    eat_comma = false;
+    break;
+
   case FUNC_ADJUST_GVAR: {
 
     CFN_GVAR_INDEX(cfn) = yaml_str2int_ref(val, l_sep);
@@ -1659,11 +1667,20 @@ static bool w_customFn(void* user, uint8_t* data, uint32_t bitoffs,
   case FUNC_SET_SCREEN:
 #endif
   case FUNC_HAPTIC:
-  case FUNC_LOGS: // 10th of seconds
     str = yaml_unsigned2str(CFN_PARAM(cfn));
     if (!wf(opaque, str, strlen(str))) return false;
     break;
 
+  case FUNC_LOGS: // 10th of seconds[,profile]
+    str = yaml_unsigned2str(CFN_PARAM(cfn));
+    if (!wf(opaque, str, strlen(str))) return false;
+    if (CFN_LOGS_PROFILE(cfn)) {
+      if (!wf(opaque, ",", 1)) return false;
+      str = yaml_unsigned2str(CFN_LOGS_PROFILE(cfn));
+      if (!wf(opaque, str, strlen(str))) return false;
+    }
+    break;
+
   case FUNC_ADJUST_GVAR:
     str = yaml_unsigned2str(CFN_GVAR_INDEX(cfn)); // GVAR index
     if (!wf(opaque, str, strlen(str))) return false;
@@ -2099,6 +2116,7 @@ static const struct YamlIdStr enum_UartModes[] = {
   {  UART_MODE_DEBUG, "DEBUG"  },
   {  UART_MODE_SPACEMOUSE, "SPACEMOUSE"  },
   {  UART_MODE_EXT_MODULE, "EXT_MODULE"  },
+  {  UART_MODE_TELEMETRY_STREAM, "TELEMETRY_STREAM"  },
   {  0, NULL  }
 };
 
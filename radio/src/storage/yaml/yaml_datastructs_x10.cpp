@@ -183,6 +183,12 @@ const struct YamlIdStr enum_ModelOverridableEnable[] = {
   {  OVERRIDE_ON, "ON"  },
   {  0, NULL  }
 };
+const struct YamlIdStr enum_StickFilterTypes[] = {
+  {  STICK_FILTER_JITTER, "JITTER"  },
+  {  STICK_FILTER_ONE_EURO, "ONE_EURO"  },
+  {  STICK_FILTER_BIQUAD, "BIQUAD"  },
+  {  0, NULL  }
+};
 const struct YamlIdStr enum_FailsafeModes[] = {
   {  FAILSAFE_NOT_SET, "NOT_SET"  },
   {  FAILSAFE_HOLD, "HOLD"  },
@@ -401,6 +407,8 @@ static const struct YamlNode struct_RadioData[] = {
   YAML_UNSIGNED( "modelSFDisabled", 1 ),
   YAML_UNSIGNED( "modelCustomScriptsDisabled", 1 ),
   YAML_UNSIGNED( "modelTelemetryDisabled", 1 ),
+  YAML_ENUM("stickFilter", 2, enum_StickFilterTypes),
+  YAML_UNSIGNED( "stickFilterCutoff", 3 ),
   YAML_END
 };
 static const struct YamlNode struct_unsigned_8[] = {
@@ -128,24 +128,22 @@ static bool find_node(void* ctx, char* buf, uint8_t len)
     // Model List
     if(mi->level == 1 && mi->section == labelslist_iter::SEC_Models)  {
       bool found=false;
-      for(auto &filehash : modelslist.fileHashInfo) {
-        if(filehash.name == mi->current_attr) {
-          TRACE_LABELS_YAML("  Model %s has a real file, creating a modelcell", mi->current_attr);
-          if(filehash.celladded) {
-            TRACE_LABELS_YAML("    Duplicate found labels.yml model cell %s already added", mi->current_attr);
-            break;
-          }
+      auto filehash = modelslist.findFileHash(mi->current_attr);
+      if(filehash) {
+        TRACE_LABELS_YAML("  Model %s has a real file, creating a modelcell", mi->current_attr);
+        if(filehash->celladded) {
+          TRACE_LABELS_YAML("    Duplicate found labels.yml model cell %s already added", mi->current_attr);
+        } else {
           ModelCell *model = new ModelCell(mi->current_attr);
-          strcpy(model->modelFinfoHash, filehash.hash);
+          strcpy(model->modelFinfoHash, filehash->hash);
           modelslist.push_back(model);
-          filehash.celladded = true;
-          if(filehash.curmodel == true)
+          filehash->celladded = true;
+          if(filehash->curmodel == true)
             modelslist.setCurrentModel(model);
           mi->curmodel = model;
           mi->modeldatavalid = false;
           mi->curmodel->_isDirty = true;
           found = true;
-          break;
         }
       }
       if(!found) {
@@ -272,7 +270,8 @@ static const YamlParserCalls labelslistCalls = {
     to_child,
     to_next_elmt,
     find_node,
-    set_attr
+    set_attr,
+    nullptr
 };
 
 const YamlParserCalls* get_labelslist_parser_calls()
@@ -118,7 +118,8 @@ static const YamlParserCalls modelslistCalls = {
     to_child,
     to_next_elmt,
     find_node,
-    set_attr
+    set_attr,
+    nullptr
 };
 
 const YamlParserCalls* get_modelslist_parser_calls()
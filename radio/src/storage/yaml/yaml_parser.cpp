@@ -39,6 +39,7 @@ void YamlParser::init(const YamlParserCalls* parser_calls, void* parser_ctx)
 
     calls = parser_calls;
     ctx   = parser_ctx;
+    skip_subtree = false;
     reset();
     eof = false;
 }
@@ -46,7 +47,11 @@ void YamlParser::init(const YamlParserCalls* parser_calls, void* parser_ctx)
 void YamlParser::reset()
 {
     state = saved_state;
-    if (state != ps_Dash) {
+    if (state == ps_SkipLine) {
+        // skipped lines do not change the indentation
+        state = saved_state = ps_Indent;
+    }
+    else if (state != ps_Dash) {
         indents[level] = indent;
         state = saved_state = ps_Indent;
     }
@@ -76,6 +81,16 @@ uint8_t YamlParser::getLastIndent()
     return indents[level];
 }
 
+bool YamlParser::skipSubtree()
+{
+    if (!level && calls->is_complete && calls->is_complete(ctx))
+        return false;
+
+    skip_subtree = true;
+    skip_indent = indent;
+    return true;
+}
+
 YamlParser::YamlResult
 YamlParser::parse(const char* buffer, unsigned int size)
 {
@@ -112,10 +127,24 @@ YamlParser::parse(const char* buffer, unsigned int size)
 
             if (*c == '\r' || *c == '\n') {
                 saved_state = state;
+                if (skip_subtree) {
+                    if (state != ps_Dash || indent > skip_indent)
+                        saved_state = ps_SkipLine;
+                    else
+                        skip_subtree = false;
+                }
                 state = ps_CRLF;
                 continue;
             }
 
+            if (skip_subtree) {
+                if (indent > skip_indent) {
+                    state = ps_SkipLine;
+                    continue;
+                }
+                skip_subtree = false;
+            }
+
             if (indent < getLastIndent()) {
                 // go up as many levels as necessary
                 do {
@@ -180,6 +209,8 @@ YamlParser::parse(const char* buffer, unsigned int size)
                     if (!node_found) {
                         TRACE_YAML("YAML_PARSER: Could not find node '%.*s' (2)\n",
                               scratch_len, scratch_buf);
+                        if (!skipSubtree())
+                            return DONE_PARSING;
                     }
                 }
                 saved_state = state;
@@ -193,6 +224,8 @@ YamlParser::parse(const char* buffer, unsigned int size)
                     if (!node_found) {
                         TRACE_YAML("YAML_PARSER: Could not find node '%.*s' (3)\n",
                               scratch_len, scratch_buf);
+                        if (!skipSubtree())
+                            return DONE_PARSING;
                     }
                 }
                 state = ps_Sep;
@@ -300,6 +333,18 @@ YamlParser::parse(const char* buffer, unsigned int size)
             state = ps_Val;
             CONCAT_STR(scratch_buf, scratch_len, *c);
             break;
+
+        case ps_SkipLine: {
+            const char* eol = c;
+            while (eol < end && *eol != '\r' && *eol != '\n')
+                eol++;
+            c = eol;
+            if (c < end) {
+                saved_state = state;
+                state = ps_CRLF;
+            }
+            continue;
+        }
                 
         case ps_CRLF:
             if (*c == '\n') {
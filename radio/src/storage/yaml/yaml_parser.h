@@ -34,6 +34,10 @@ struct YamlParserCalls
     bool (*to_next_elmt) (void* ctx);
     bool (*find_node)    (void* ctx, char* buf, uint8_t len);
     void (*set_attr)     (void* ctx, char* buf, uint16_t len);
+
+    // optional: return true once nothing more is needed from the
+    // document, so the parser can stop at the next unknown root node
+    bool (*is_complete)  (void* ctx);
 };
 
 class YamlParser
@@ -51,6 +55,7 @@ class YamlParser
         ps_ValEsc1,
         ps_ValEsc2,
         ps_ValEsc3,
+        ps_SkipLine,
         ps_CRLF
     };
 
@@ -75,6 +80,11 @@ class YamlParser
     bool node_found;
     bool eof;
 
+    // lines indented deeper than 'skip_indent' belong to a node
+    // that was not found and are skipped without being tokenized
+    bool    skip_subtree;
+    uint8_t skip_indent;
+
     // tree iterator state
     const YamlParserCalls* calls;
     void*                  ctx;
@@ -86,6 +96,9 @@ class YamlParser
     bool    toParent();
     uint8_t getLastIndent();
 
+    // Skip the children of the node on the current line
+    bool    skipSubtree();
+
 public:
 
     enum YamlResult {
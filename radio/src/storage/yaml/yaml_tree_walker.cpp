@@ -200,7 +200,9 @@ static bool yaml_output_attr(void* user, uint8_t* ptr, uint32_t bit_ofs,
 YamlTreeWalker::YamlTreeWalker()
     : stack_level(NODE_STACK_DEPTH),
       virt_level(0),
-      anon_union(0)
+      anon_union(0),
+      root_attrs(0),
+      root_found(0)
 {
     memset(stack,0,sizeof(stack));
 }
@@ -214,6 +216,19 @@ void YamlTreeWalker::reset(const YamlNode* node, uint8_t* data)
     push();
     setNode(node);
     rewind();
+
+    root_attrs = 0;
+    root_found = 0;
+
+    const YamlNode* attr = getAttr();
+    for (uint8_t i = 0; attr && attr->type != YDT_NONE; i++, attr++) {
+        if (i >= 32) {
+            root_attrs = 0;
+            break;
+        }
+        if (attr->type != YDT_PADDING)
+            root_attrs |= 1 << i;
+    }
 }
 
 bool YamlTreeWalker::push()
@@ -253,23 +268,15 @@ void YamlTreeWalker::rewind()
 // the current collection (node of type YDT_NONE) is reached.
 //
 // return true if a match has been found.
-bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
+bool YamlTreeWalker::findNextNode(const char* tag, uint8_t tag_len)
 {
-    if (virt_level)
-        return false;
-
-    rewind();
-
     const struct YamlNode* attr = getAttr();
-    if (isArrayElmt() && attr && attr->type == YDT_IDX) {
-        setAttrValue((char*)tag, tag_len);
-        return true;
-    }
-
     while(attr && attr->type != YDT_NONE) {
 
         if ((tag_len == attr->tag_len)
             && !strncmp(tag, attr->tag, tag_len)) {
+            if (!hasParent())
+                root_found |= 1 << stack[stack_level].attr_idx;
             return true; // attribute found!
         }
 
@@ -280,6 +287,32 @@ bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
     return false;
 }
 
+bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
+{
+    if (virt_level)
+        return false;
+
+    // Attributes are written in node order: the tag is usually found
+    // from the current attribute on, without scanning the collection
+    // again from its start
+    const struct YamlNode* node = getNode();
+    if (!anon_union && node->type != YDT_UNION &&
+        !(isArrayElmt() && node->u._array.child[0].type == YDT_IDX) &&
+        findNextNode(tag, tag_len)) {
+        return true;
+    }
+
+    rewind();
+
+    const struct YamlNode* attr = getAttr();
+    if (isArrayElmt() && attr && attr->type == YDT_IDX) {
+        setAttrValue((char*)tag, tag_len);
+        return true;
+    }
+
+    return findNextNode(tag, tag_len);
+}
+
 // Get the current bit offset
 unsigned int YamlTreeWalker::getBitOffset()
 {
@@ -689,12 +722,18 @@ static void set_attr(void* ctx, char* buf, uint16_t len)
     ((YamlTreeWalker*)ctx)->setAttrValue(buf,len);
 }
 
+static bool is_complete(void* ctx)
+{
+    return ((YamlTreeWalker*)ctx)->isComplete();
+}
+
 const YamlParserCalls YamlTreeWalkerCalls = {
     to_parent,
     to_child,
     to_next_elmt,
     find_node,
-    set_attr
+    set_attr,
+    is_complete
 };
 
 const YamlParserCalls* YamlTreeWalker::get_parser_calls()
@@ -49,6 +49,11 @@ class YamlTreeWalker
     uint8_t virt_level;
     uint8_t anon_union;
 
+    // root attributes expected / found so far (only tracked for
+    // node sets with up to 32 root attributes, e.g. PartialModel)
+    uint32_t root_attrs;
+    uint32_t root_found;
+
     uint8_t* data;
 
     uint32_t getAttrOfs() { return stack[stack_level].bit_ofs; }
@@ -111,6 +116,9 @@ class YamlTreeWalker
     // (and reset the bit offset)
     void rewind();
 
+    // search for the tag from the current attribute on
+    bool findNextNode(const char* tag, uint8_t tag_len);
+
 public:
     YamlTreeWalker();
 
@@ -158,6 +166,11 @@ public:
 
     void setAttrValue(char* buf, uint16_t len);
 
+    // All root attributes have been read
+    bool isComplete() {
+        return root_attrs && (root_found & root_attrs) == root_attrs;
+    }
+
     bool generate(yaml_writer_func wf, void* opaque);
 
     void dump_stack();
@@ -28,6 +28,8 @@
 
 #include "tasks/mixer_task.h"
 
+#include <atomic>
+
 #define CS_LAST_VALUE_INIT -32768
 
 #if defined(COLORLCD)
@@ -66,6 +68,11 @@ CircularBuffer<uint8_t, 8> luaSetStickySwitchBuffer;
 tmr10ms_t switchesMidposStart[MAX_SWITCHES];
 uint64_t  switchesPos = 0;
 
+// switches whose inputs changed since the last getMovedSwitch() call
+static std::atomic<uint32_t> switchesMoved;
+
+static_assert(MAX_SWITCHES <= 32, "MAX_SWITCHES too big for switchesMoved");
+
 static_assert(sizeof(uint64_t) * 8 >= ((MAX_SWITCHES - 1) / 2) + 1,
               "MAX_SWITCHES too big for uint64_t position state");
 
@@ -306,9 +313,22 @@ static uint64_t checkSwitchPosition(uint8_t idx, bool startup)
 
 void getSwitchesPosition(bool startup)
 {
+  uint64_t changed = switchSampleInputs();
+  if (changed) switchesMoved.fetch_or(changed, std::memory_order_relaxed);
+
   uint64_t newPos = 0;
   for (unsigned i = 0; i < switchGetMaxSwitches(); i++) {
     if (!SWITCH_EXISTS(i)) continue;
+
+    // unchanged inputs keep their position, unless a mid position
+    // is still being delayed or the switch has just been configured
+    uint64_t prevPos = switchesPos & ((MASK_CFN_TYPE)0x7 << (i * 3));
+    if (!startup && !(changed & ((uint64_t)1 << i)) &&
+        !switchesMidposStart[i] && prevPos) {
+      newPos |= prevPos;
+      continue;
+    }
+
     newPos |= checkSwitchPosition(i, startup);
   }
   
@@ -635,12 +655,105 @@ uint8_t getXPotPosition(uint8_t idx)
 }
 
 
+static_assert(MAX_LOGICAL_SWITCHES <= 64,
+              "MAX_LOGICAL_SWITCHES too big for uint64_t dependency mask");
+
+// Logical switches are evaluated so that the ones they refer to come first,
+// and a chain of logical switches settles within one mixer cycle. The order
+// is computed again when the model changes.
+static uint8_t lswOrder[MAX_LOGICAL_SWITCHES];
+static uint16_t lswOrderRevision;
+static bool lswOrderValid = false;
+
+static uint64_t lswSwitchDependency(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  if (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH)
+    return (uint64_t)1 << (swtch - SWSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+static uint64_t lswSourceDependency(mixsrc_t source)
+{
+  if (source >= MIXSRC_FIRST_LOGICAL_SWITCH && source <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return (uint64_t)1 << (source - MIXSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+static uint64_t lswDependencies(uint8_t idx)
+{
+  LogicalSwitchData * ls = lswAddress(idx);
+  if (ls->func == LS_FUNC_NONE)
+    return 0;
+
+  uint64_t deps = lswSwitchDependency(ls->andsw);
+  switch (lswFamily(ls->func)) {
+    case LS_FAMILY_BOOL:
+      deps |= lswSwitchDependency(ls->v1) | lswSwitchDependency(ls->v2);
+      break;
+    case LS_FAMILY_COMP:
+      deps |= lswSourceDependency(ls->v1) | lswSourceDependency(ls->v2);
+      break;
+    case LS_FAMILY_TIMER:
+    case LS_FAMILY_STICKY:
+    case LS_FAMILY_EDGE:
+      // inputs read by logicalSwitchesTimerTick()
+      break;
+    default:
+      deps |= lswSourceDependency(ls->v1);
+      break;
+  }
+
+  // a switch referring to itself reads its previous state
+  return deps & ~((uint64_t)1 << idx);
+}
+
+static void updateLogicalSwitchesOrder()
+{
+  if (lswOrderValid && lswOrderRevision == modelDataRevision)
+    return;
+
+  uint64_t deps[MAX_LOGICAL_SWITCHES];
+  for (uint8_t idx = 0; idx < MAX_LOGICAL_SWITCHES; idx++) {
+    deps[idx] = lswDependencies(idx);
+  }
+
+  uint64_t done = 0;
+  uint8_t count = 0;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (uint8_t idx = 0; idx < MAX_LOGICAL_SWITCHES; idx++) {
+      uint64_t bit = (uint64_t)1 << idx;
+      if (!(done & bit) && !(deps[idx] & ~done)) {
+        lswOrder[count++] = idx;
+        done |= bit;
+        progress = true;
+      }
+    }
+  }
+
+  // loops between switches are evaluated in index order,
+  // using the previous state of the switches further down
+  for (uint8_t idx = 0; idx < MAX_LOGICAL_SWITCHES; idx++) {
+    if (!(done & ((uint64_t)1 << idx))) {
+      lswOrder[count++] = idx;
+    }
+  }
+
+  lswOrderRevision = modelDataRevision;
+  lswOrderValid = true;
+}
+
 /**
   @brief Calculates new state of logical switches for mixerCurrentFlightMode
 */
 void evalLogicalSwitches(bool isCurrentFlightmode)
 {
-  for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+  updateLogicalSwitchesOrder();
+
+  for (unsigned int i=0; i<MAX_LOGICAL_SWITCHES; i++) {
+    uint8_t idx = lswOrder[i];
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
     bool result = getLogicalSwitch(idx);
     if (isCurrentFlightmode) {
@@ -674,12 +787,17 @@ swsrc_t getMovedSwitch()
   static tmr10ms_t s_move_last_time = 0;
   swsrc_t result = 0;
 
-  // Switches
+  // Switches: only the ones the mixer has seen changing need a new look,
+  // unless they have never been read
+  uint32_t moved = switchesMoved.exchange(0, std::memory_order_relaxed);
+  if (!mixerTaskRunning()) moved = UINT32_MAX;
+
   auto max_reg_switches = switchGetMaxSwitches();
   for (uint8_t i = 0; i < max_reg_switches; i++) {
     if (SWITCH_EXISTS(i)) {
       swarnstate_t mask = ((swarnstate_t) 0x07 << (i * 3));
       uint8_t prev = (switches_states & mask) >> (i * 3);
+      if (prev && !(moved & (1 << i))) continue;
       uint8_t next = (1024 + getValue(MIXSRC_FIRST_SWITCH + i)) / 1024 + 1;
       if (prev != next) {
         switches_states =
@@ -1003,11 +1121,6 @@ void logicalSwitchesTimerTick()
   }
 }
 
-LogicalSwitchData * lswAddress(uint8_t idx)
-{
-  return &g_model.logicalSw[idx];
-}
-
 uint8_t lswFamily(uint8_t func)
 {
   if (func <= LS_FUNC_ANEG)
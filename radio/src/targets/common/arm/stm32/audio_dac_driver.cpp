@@ -20,6 +20,7 @@
  */
 
 #include "opentx.h"
+#include "task_stats.h"
 
 #if !defined(SIMU)
 const AudioBuffer * nextBuffer = 0;
@@ -219,6 +220,8 @@ extern "C" void AUDIO_TIM_IRQHandler()
 
 extern "C" void AUDIO_DMA_Stream_IRQHandler()
 {
+  TaskStatsIsrScope isrScope(TASK_STATS_ISR_AUDIO);
+
   AUDIO_DMA_Stream->CR &= ~DMA_SxCR_TCIE ;            // Stop interrupt
   AUDIO_DMA->HIFCR = DMA_HIFCR_CTCIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTEIF5 | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CFEIF5 ; // Write ones to clear flags
   AUDIO_DMA_Stream->CR &= ~DMA_SxCR_EN ;                              // Disable DMA channel
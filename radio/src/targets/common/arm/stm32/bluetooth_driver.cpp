@@ -40,9 +40,15 @@ static const stm32_usart_t btUSART = {
   .txDMA = nullptr,
   .txDMA_Stream = 0,
   .txDMA_Channel = 0,
+#if defined(BT_USART_RX_DMA)
+  .rxDMA = BT_USART_RX_DMA,
+  .rxDMA_Stream = BT_USART_RX_DMA_STREAM,
+  .rxDMA_Channel = BT_USART_RX_DMA_CHANNEL,
+#else
   .rxDMA = nullptr,
   .rxDMA_Stream = 0,
   .rxDMA_Channel = 0,
+#endif
 };
 
 DEFINE_STM32_SERIAL_PORT(BTModule, btUSART, BT_RX_FIFO_SIZE, BT_TX_FIFO_SIZE);
@@ -119,6 +125,18 @@ int bluetoothRead(uint8_t* data)
   return STM32SerialDriver.getByte(_bt_usart_ctx, data);
 }
 
+uint32_t bluetoothGetRxSpan(const uint8_t** data)
+{
+  if (!_bt_usart_ctx) return 0;
+  return STM32SerialDriver.getRxSpan(_bt_usart_ctx, data);
+}
+
+void bluetoothConsumeRx(uint32_t len)
+{
+  if (!_bt_usart_ctx) return;
+  STM32SerialDriver.consumeRx(_bt_usart_ctx, len);
+}
+
 uint8_t bluetoothIsWriting(void)
 {
   if (!_bt_usart_ctx)
@@ -37,6 +37,8 @@
 void bluetoothInit(uint32_t baudrate, bool enable);
 void bluetoothWrite(const void* buffer, uint32_t length);
 int bluetoothRead(uint8_t* data);
+uint32_t bluetoothGetRxSpan(const uint8_t** data);
+void bluetoothConsumeRx(uint32_t len);
 uint8_t bluetoothIsWriting();
 void bluetoothDisable();
 
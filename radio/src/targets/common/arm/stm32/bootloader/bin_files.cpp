@@ -178,6 +178,27 @@ FRESULT readBinFile()
     return f_read(&FlashFile, Block_buffer, sizeof(Block_buffer), &BlockCount);
 }
 
+bool compareBinFile(const uint8_t* data, UINT len)
+{
+    FSIZE_t pos = f_tell(&FlashFile);
+    uint8_t buffer[256];
+    bool match = true;
+
+    while (match && len > 0) {
+        UINT count = len < sizeof(buffer) ? len : sizeof(buffer);
+        UINT read = 0;
+        if (f_read(&FlashFile, buffer, count, &read) != FR_OK ||
+            read != count || memcmp(buffer, data, count)) {
+            match = false;
+        }
+        data += count;
+        len -= count;
+    }
+
+    f_lseek(&FlashFile, pos);
+    return match;
+}
+
 FRESULT closeBinFile()
 {
     return f_close(&FlashFile);
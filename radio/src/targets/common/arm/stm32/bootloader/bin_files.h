@@ -93,6 +93,10 @@ void extractFirmwareVersion(VersionTag* tag);
 // Check 'BlockCount' for # of bytes read
 FRESULT readBinFile();
 
+// Compare the next 'len' bytes of the file with 'data'
+// without moving the read position
+bool compareBinFile(const uint8_t* data, UINT len);
+
 // Close the previously opened file
 FRESULT closeBinFile();
 
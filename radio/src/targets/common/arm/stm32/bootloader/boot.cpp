@@ -197,12 +197,41 @@ int menuFlashFile(uint32_t index, event_t event)
   return -1;
 }
 
+#if !defined(SIMU)
+// Bytes left in a sector found identical to the file,
+// which is then neither erased nor written
+static uint32_t sectorSkip = 0;
+
+// Check whether the sector starting at firmwareAddress already holds
+// the next 'size' bytes of the file ('Block_buffer' and beyond)
+static bool isSectorUnchanged(uint32_t blockOffset, uint32_t size)
+{
+  const uint8_t * flash = (const uint8_t *)firmwareAddress;
+  uint32_t len = BlockCount < size ? BlockCount : size;
+
+  if (memcmp(flash, &Block_buffer[blockOffset], len))
+    return false;
+
+  return len == size || compareBinFile(flash + len, size - len);
+}
+#endif
+
 void flashWriteBlock()
 {
   uint32_t blockOffset = 0;
   while (BlockCount) {
 #if !defined(SIMU)
-    flashWrite((uint32_t *)firmwareAddress, (uint32_t *)&Block_buffer[blockOffset]);
+    if (!sectorSkip) {
+      uint32_t size = flashSectorSize(firmwareAddress);
+      if (size && isSectorUnchanged(blockOffset, size))
+        sectorSkip = size;
+    }
+
+    if (sectorSkip) {
+      sectorSkip -= FLASH_PAGESIZE;
+    } else {
+      flashWrite((uint32_t *)firmwareAddress, (uint32_t *)&Block_buffer[blockOffset]);
+    }
 #endif
     blockOffset += FLASH_PAGESIZE;
     firmwareAddress += FLASH_PAGESIZE;
@@ -32,6 +32,7 @@
 
 #include <string.h>
 #include "debug.h"
+#include "event_trace.h"
 
 #if FF_MAX_SS != FF_MIN_SS
 #error "Variable sector size is not supported"
@@ -40,10 +41,6 @@
 #define BLOCK_SIZE FF_MAX_SS
 #define SD_TIMEOUT 300 /* 300ms */
 
-// Disk status
-extern volatile uint32_t WriteStatus;
-extern volatile uint32_t ReadStatus;
-
 /*-----------------------------------------------------------------------*/
 /* Inidialize a Drive                                                    */
 
@@ -99,6 +96,71 @@ DSTATUS disk_status (
 
 uint32_t sdReadRetries = 0;
 
+enum DiskAsyncState {
+  DISK_ASYNC_NONE,
+  DISK_ASYNC_READ,
+  DISK_ASYNC_WRITE,
+};
+
+static DiskAsyncState diskAsyncState = DISK_ASYNC_NONE;
+
+SD_Error disk_wait_async()
+{
+  if (diskAsyncState == DISK_ASYNC_NONE) return SD_OK;
+
+  SD_Error res = diskAsyncState == DISK_ASYNC_READ
+                     ? SD_WaitReadOperation(SD_TIMEOUT)
+                     : SD_WaitWriteOperation(SD_TIMEOUT);
+  diskAsyncState = DISK_ASYNC_NONE;
+
+  if (res != SD_OK) {
+    TRACE("SD async transfer timeout");
+    return SD_ERROR;
+  }
+
+  if (SD_CheckStatusWithTimeout(SD_TIMEOUT) < 0) {
+    TRACE("SD async getstatus timeout");
+    return SD_ERROR;
+  }
+
+  return SD_OK;
+}
+
+static SD_Error disk_start_async(DiskAsyncState state)
+{
+  if (disk_wait_async() != SD_OK) return SD_ERROR;
+  if (SD_Detect() != SD_PRESENT) return SD_ERROR;
+  if (SD_CheckStatusWithTimeout(SD_TIMEOUT) < 0) return SD_ERROR;
+  diskAsyncState = state;
+  return SD_OK;
+}
+
+SD_Error disk_read_async(uint8_t * buff, uint32_t sector, uint32_t count)
+{
+  if (disk_start_async(DISK_ASYNC_READ) != SD_OK) return SD_ERROR;
+
+  if (SD_ReadBlocks(buff, sector, BLOCK_SIZE, count) != SD_OK) {
+    TRACE("SD async ReadBlocks failed, s:%u c:%u", sector, count);
+    diskAsyncState = DISK_ASYNC_NONE;
+    return SD_ERROR;
+  }
+
+  return SD_OK;
+}
+
+SD_Error disk_write_async(const uint8_t * buff, uint32_t sector, uint32_t count)
+{
+  if (disk_start_async(DISK_ASYNC_WRITE) != SD_OK) return SD_ERROR;
+
+  if (SD_WriteBlocks((uint8_t *)buff, sector, BLOCK_SIZE, count) != SD_OK) {
+    TRACE("SD async WriteBlocks failed, s:%u c:%u", sector, count);
+    diskAsyncState = DISK_ASYNC_NONE;
+    return SD_ERROR;
+  }
+
+  return SD_OK;
+}
+
 /*-----------------------------------------------------------------------*/
 /* Read Sector(s)                                                        */
 
@@ -113,7 +175,6 @@ DRESULT disk_read_dma(BYTE drv, BYTE * buff, DWORD sector, UINT count)
 
   for (int retry = 0; retry < 3; retry++) {
 
-    ReadStatus = 0;
     SD_Error Status = SD_ReadBlocks(buff, sector, BLOCK_SIZE, count);
     if (Status != SD_OK) {
       TRACE("SD ReadBlocks=%d, s:%u c: %u", Status, sector, (uint32_t)count);
@@ -122,27 +183,15 @@ DRESULT disk_read_dma(BYTE drv, BYTE * buff, DWORD sector, UINT count)
     }
 
     // Wait that the reading process is completed or a timeout occurs
-    uint32_t timeout = HAL_GetTick();
-    while((ReadStatus == 0) && ((HAL_GetTick() - timeout) < SD_TIMEOUT));
-
-    if (ReadStatus == 0) {
+    if (SD_WaitReadOperation(SD_TIMEOUT) != SD_OK) {
       TRACE("SD read timeout, s:%u c:%u", sector, (uint32_t)count);
       ++sdReadRetries;
       continue;
     }
-      
-    ReadStatus = 0;
-    timeout = HAL_GetTick();
-
-    while((HAL_GetTick() - timeout) < SD_TIMEOUT) {
-      if (SD_GetStatus() == SD_TRANSFER_OK) {
-	res = RES_OK;
-	break;
-      }
-    }
 
-    if (res == RES_OK) {
+    if (SD_CheckStatusWithTimeout(SD_TIMEOUT) == 0) {
       // exit retry loop
+      res = RES_OK;
       break;
     }
 
@@ -161,6 +210,12 @@ DRESULT __disk_read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
   //    an intermediate buffer (move trough the provided buffer)
 
   // TRACE("disk_read %d %p %10d %d", drv, buff, sector, count);
+  EVENT_TRACE_SCOPE(EVENT_TRACE_SD_READ_BEGIN, EVENT_TRACE_SD_READ_END, count);
+
+  // a pending transfer only matters to the
+  // USB mass storage, which checks it itself
+  disk_wait_async();
+
   if (SD_Detect() != SD_PRESENT) {
     TRACE("SD_Detect() != SD_PRESENT");
     return RES_NOTRDY;
@@ -213,6 +268,12 @@ DRESULT __disk_write(
   DRESULT res = RES_OK;
 
   // TRACE("disk_write %d %p %10d %d", drv, buff, sector, count);
+  EVENT_TRACE_SCOPE(EVENT_TRACE_SD_WRITE_BEGIN, EVENT_TRACE_SD_WRITE_END,
+                    count);
+
+  // a pending transfer only matters to the
+  // USB mass storage, which checks it itself
+  disk_wait_async();
 
   if (SD_Detect() != SD_PRESENT)
     return RES_NOTRDY;
@@ -242,27 +303,13 @@ DRESULT __disk_write(
     return RES_ERROR;
   }
 
-  // Wait that the reading process is completed or a timeout occurs
-  uint32_t timeout = HAL_GetTick();
-  while((WriteStatus == 0) && ((HAL_GetTick() - timeout) < SD_TIMEOUT));
-
-  if (WriteStatus == 0) {
+  // Wait that the writing process is completed or a timeout occurs
+  if (SD_WaitWriteOperation(SD_TIMEOUT) != SD_OK) {
     TRACE("SD write timeout, s:%u c:%u", sector, (uint32_t)count);
     return RES_ERROR;
   }
 
-  WriteStatus = 0;
-  res = RES_ERROR;
-  timeout = HAL_GetTick();
-
-  while((HAL_GetTick() - timeout) < SD_TIMEOUT) {
-    if (SD_GetStatus() == SD_TRANSFER_OK) {
-      res = RES_OK;
-      break;
-    }
-  }
-
-  if (res != RES_OK) {
+  if (SD_CheckStatusWithTimeout(SD_TIMEOUT) < 0) {
     TRACE("SD getstatus timeout, s:%u c: %u", sector, (uint32_t)count);
     res = RES_ERROR;
   }
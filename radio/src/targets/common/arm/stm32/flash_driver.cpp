@@ -74,89 +74,78 @@ void eraseSector(uint32_t sector)
   WDG_ENABLE(WDG_DURATION);
 }
 
-void flashWrite(uint32_t * address, const uint32_t * buffer) // page size is 256 bytes
+// Returns the sector starting at address and its size,
+// or -1 if address is not the start of a sector
+static int getSectorStart(uint32_t address, uint32_t * size)
 {
-#define SECTOR_ADDRESS  (((uint32_t)address) &  0xFFFFF)
-
-// Please note that there is an offset of 4 between
-// sector 11 and 12
-#define FLASH_BANK     ((((uint32_t)address) & 0x100000) ? 16 : 0)
-
-    // test for possible flash sector boundary
-    if ((((uint32_t)address) & 0x1FFFF) == 0) {
-        // test first 16KB sectors
-        if (SECTOR_ADDRESS == 0x00000) {
-            eraseSector(0 + FLASH_BANK);
-        }
-        // test 128KB sectors
-        else if (SECTOR_ADDRESS == 0x20000) {
-            eraseSector(5 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0x40000) {
-            eraseSector(6 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0x60000) {
-            eraseSector(7 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0x80000) {
-            eraseSector(8 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0xA0000) {
-            eraseSector(9 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0xC0000) {
-            eraseSector(10 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0xE0000) {
-            eraseSector(11 + FLASH_BANK);
-        }
-    }
-    // test 64KB sector
-    else if (SECTOR_ADDRESS == 0x10000) {
-        eraseSector(4 + FLASH_BANK);
-    }
-    else if ((((uint32_t)address) & 0x3FFF) == 0) {
-        // test other 16KB sectors
-        if (SECTOR_ADDRESS == 0x04000) {
-            eraseSector(1 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0x08000) {
-            eraseSector(2 + FLASH_BANK);
-        }
-        else if (SECTOR_ADDRESS == 0x0C000) {
-            eraseSector(3 + FLASH_BANK);
-        }
-    }
+  uint32_t offset = address & 0xFFFFF;
 
-#undef SECTOR_ADDRESS
-#undef FLASH_BANK
-    
-  for (uint32_t i=0; i<FLASH_PAGESIZE/4; i++) {
-    /* Device voltage range supposed to be [2.7V to 3.6V], the operation will
-     be done by word */
+  // Please note that there is an offset of 4 between
+  // sector 11 and 12
+  int bank = (address & 0x100000) ? 16 : 0;
 
-    // Wait for last operation to be completed
-    waitFlashIdle();
+  // 16KB sectors
+  if (offset < 0x10000) {
+    if (offset & 0x3FFF) return -1;
+    *size = 0x4000;
+    return bank + (offset >> 14);
+  }
 
-    FLASH->CR &= CR_PSIZE_MASK;
-    FLASH->CR |= FLASH_PSIZE_WORD;
-    FLASH->CR |= FLASH_CR_PG;
+  // 64KB sector
+  if (offset == 0x10000) {
+    *size = 0x10000;
+    return bank + 4;
+  }
+
+  // 128KB sectors
+  if (offset & 0x1FFFF) return -1;
+  *size = 0x20000;
+  return bank + 4 + (offset >> 17);
+}
+
+uint32_t flashSectorSize(uint32_t address)
+{
+  uint32_t size;
+  return getSectorStart(address, &size) >= 0 ? size : 0;
+}
 
-    *address = *buffer;
+void flashWrite(uint32_t * address, const uint32_t * buffer) // page size is 256 bytes
+{
+  // test for possible flash sector boundary
+  uint32_t size;
+  int sector = getSectorStart((uint32_t)address, &size);
+  if (sector >= 0) {
+    eraseSector(sector);
+  }
 
-    /* Wait for operation to be completed */
-    waitFlashIdle();
-    FLASH->CR &= ~FLASH_CR_PG;
+  /* Device voltage range supposed to be [2.7V to 3.6V], the operation will
+   be done by word */
+  waitFlashIdle();
+  FLASH->CR &= CR_PSIZE_MASK;
+  FLASH->CR |= FLASH_PSIZE_WORD;
+  FLASH->CR |= FLASH_CR_PG;
 
-    /* Check the written value */
+  for (uint32_t i=0; i<FLASH_PAGESIZE/4; i++) {
+    // programming can only clear bits: a matching word
+    // (e.g. 0xFFFFFFFF in an erased sector) needs no write
     if (*address != *buffer) {
-      /* Flash content doesn't match SRAM content */
-      return;
+      *address = *buffer;
+
+      /* Wait for operation to be completed */
+      waitFlashIdle();
+
+      /* Check the written value */
+      if (*address != *buffer) {
+        /* Flash content doesn't match SRAM content */
+        break;
+      }
     }
     /* Increment FLASH destination address */
     address += 1;
     buffer += 1;
   }
+
+  FLASH->CR &= ~FLASH_CR_PG;
 }
 
 uint32_t isFirmwareStart(const uint8_t * buffer)
@@ -26,6 +26,7 @@
 #include "delays_driver.h"
 #include "hal/adc_driver.h"
 
+#include "board.h"
 #include "hal.h"
 #include "crc.h"
 
@@ -119,6 +120,9 @@ static void _fs_parse(STRUCT_HALL *hallBuffer, unsigned char ch)
 
 static volatile bool _fs_gimbal_detected;
 
+// DWT cycle counter value when the last stick values were received
+static volatile uint32_t _fs_frame_ticks;
+
 static void flysky_gimbal_loop()
 {
   uint8_t byte;
@@ -140,6 +144,7 @@ static void flysky_gimbal_loop()
             for (uint8_t i = 0; i < 4; i++) {
               adcValues[i] = FLYSKY_OFFSET_VALUE - p_values[i];
             }
+            _fs_frame_ticks = ticksNow();
           }
           break;
       }
@@ -148,6 +153,26 @@ static void flysky_gimbal_loop()
   }
 }
 
+// Frames are normally parsed from the USART idle interrupt. This drains
+// whatever the DMA already received, so that the mixer does not miss
+// a frame that completed just before it reads the sticks.
+static void flysky_gimbal_poll()
+{
+  NVIC_DisableIRQ(FLYSKY_HALL_SERIAL_USART_IRQn);
+  flysky_gimbal_loop();
+  NVIC_EnableIRQ(FLYSKY_HALL_SERIAL_USART_IRQn);
+}
+
+static uint32_t flysky_gimbal_get_age_us()
+{
+  return (ticksNow() - _fs_frame_ticks) / SYSTEM_TICKS_1US;
+}
+
+static const etx_hal_serial_sticks_t _fs_serial_sticks = {
+  .poll = flysky_gimbal_poll,
+  .get_age_us = flysky_gimbal_get_age_us,
+};
+
 static void flysky_gimbal_deinit()
 {
   STM32SerialDriver.deinit(_fs_usart_ctx);
@@ -172,6 +197,7 @@ bool flysky_gimbal_init()
     if (_fs_gimbal_detected) {
       // Mask the first 4 inputs (sticks)
       stm32_hal_mask_inputs(0xF);
+      adcSetSerialSticks(&_fs_serial_sticks);
       return true;
     }
   }
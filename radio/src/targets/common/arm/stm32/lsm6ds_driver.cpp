@@ -194,13 +194,23 @@
 #define LSM6DSLTR_ID                            0x6A
 #define LSM6DS33TR_ID                           0x69
 
+#define LSM6DS_FIFO_STATUS_SIZE                 4
+#define LSM6DS_FIFO_OVR_MASK                    0x40
+#define LSM6DS_FIFO_PATTERN_MASK                0x03ff
+#define LSM6DS_FIFO_NO_DECIMATION               0x09
+#define LSM6DS_FIFO_CONTINUOUS_208HZ            0x2e
+
 static const char configure[][2] = {
-  // ODR = 1000 (1.66 kHz (high performance)); FS_XL = 00 (+/-2 g full scale)
-  {LSM6DS_ACCEL_ODR_ADDR, 0x80},
-  // ODR = 1000 (1.66 kHz (high performance)); FS_XL = 00 (245 dps)
-  {LSM6DS_GYRO_ODR_ADDR, 0x80},
+  // ODR = 0101 (208 Hz); FS_XL = 00 (+/-2 g full scale)
+  {LSM6DS_ACCEL_ODR_ADDR, 0x50},
+  // ODR = 0101 (208 Hz); FS_G = 00 (245 dps)
+  {LSM6DS_GYRO_ODR_ADDR, 0x50},
   // IF_INC = 1 (automatically increment register address)
-  {LSM6DS_BDU_ADDR, 0x04}
+  {LSM6DS_BDU_ADDR, 0x04},
+  // gyro and accel in the FIFO, no decimation
+  {LSM6DS_FIFO_CTRL3_ADDR, LSM6DS_FIFO_NO_DECIMATION},
+  // FIFO ODR = 208 Hz, continuous mode (oldest samples overwritten)
+  {LSM6DS_FIFO_MODE_ADDR, LSM6DS_FIFO_CONTINUOUS_208HZ},
 };
 
 #define I2C_TIMEOUT_MAX      10000
@@ -266,9 +276,63 @@ int gyroRead(uint8_t buffer[IMU_BUFFER_LENGTH])
   return I2C_LSM6DS_ReadRegister(LSM6DS_GYRO_OUT_X_L_ADDR, buffer, IMU_BUFFER_LENGTH);
 }
 
+static void flushFifo()
+{
+  // going through bypass mode empties the FIFO
+  I2C_LSM6DS_WriteRegister(LSM6DS_FIFO_MODE_ADDR, LSM6DS_FIFO_MODE_BYPASS);
+  I2C_LSM6DS_WriteRegister(LSM6DS_FIFO_MODE_ADDR, LSM6DS_FIFO_CONTINUOUS_208HZ);
+}
+
+int gyroReadFifo(int16_t samples[][IMU_VALUES_COUNT], uint8_t maxSamples,
+                 uint16_t* dropped)
+{
+  *dropped = 0;
+
+  uint8_t status[LSM6DS_FIFO_STATUS_SIZE];
+  if (I2C_LSM6DS_ReadRegister(LSM6DS_FIFO_DIFF_L, status, sizeof(status)) < 0)
+    return -1;
+
+  uint16_t words = (status[0] | (status[1] << 8)) & LSM6DS_FIFO_DIFF_MASK;
+  uint16_t pattern = (status[2] | (status[3] << 8)) & LSM6DS_FIFO_PATTERN_MASK;
+
+  uint16_t count = words / IMU_VALUES_COUNT;
+  if (count > maxSamples || (status[1] & LSM6DS_FIFO_OVR_MASK) ||
+      pattern >= IMU_VALUES_COUNT) {
+    // keep the latency bounded (or recover from an overrun): drop the
+    // backlog and use the newest sample from the output registers instead
+    flushFifo();
+    if (gyroRead((uint8_t*)samples[0]) < 0)
+      return -1;
+    *dropped = count > 0 ? count - 1 : 0;
+    return 1;
+  }
+
+  if (pattern != 0) {
+    // skip the end of a partially read sample
+    uint8_t skip[IMU_BUFFER_LENGTH];
+    uint8_t len = (IMU_VALUES_COUNT - pattern) * sizeof(int16_t);
+    if (I2C_LSM6DS_ReadRegister(LSM6DS_FIFO_DATA_OUT_L, skip, len) < 0)
+      return -1;
+    words = words > len / 2 ? words - len / 2 : 0;
+    count = words / IMU_VALUES_COUNT;
+  }
+
+  uint8_t n = count;
+  if (n > 0) {
+    // the FIFO output address rolls back to FIFO_DATA_OUT_L automatically
+    if (I2C_LSM6DS_ReadRegister(LSM6DS_FIFO_DATA_OUT_L, (uint8_t*)samples,
+                                n * IMU_BUFFER_LENGTH) < 0)
+      return -1;
+  }
+
+  return n;
+}
+
 #else
 
 int gyroInit() { return -1; }
 int gyroRead(uint8_t buffer[IMU_BUFFER_LENGTH]) { return -1; }
+int gyroReadFifo(int16_t samples[][IMU_VALUES_COUNT], uint8_t maxSamples,
+                 uint16_t* dropped) { return -1; }
 
 #endif
@@ -25,6 +25,9 @@
 #include "FreeRTOSConfig.h"
 #include "hal.h"
 
+// time elapsed before a soft trigger (0 if none pending)
+static volatile uint16_t softTriggerElapsed = 0;
+
 // Start scheduler with default period
 void mixerSchedulerStart()
 {
@@ -66,6 +69,7 @@ void mixerSchedulerSoftTrigger() {
   // - fires MIXER_SCHEDULER_TIMER interrupt after returning from this ISR
   // - MIXER_SCHEDULER_TIMER_IRQHandler(void) takes care of making FreeRTOS calls
   //   to ensure switching to highest priority task.
+  softTriggerElapsed = MIXER_SCHEDULER_TIMER->CNT + 1;
   MIXER_SCHEDULER_TIMER->EGR = TIM_EGR_UG; 
 }
 
@@ -74,8 +78,14 @@ extern "C" void MIXER_SCHEDULER_TIMER_IRQHandler(void)
   MIXER_SCHEDULER_TIMER->SR &= ~TIM_SR_UIF; // clear flag
   mixerSchedulerDisableTrigger();
 
-  // set next period
-  MIXER_SCHEDULER_TIMER->ARR = getMixerSchedulerPeriod() - 1;
+  // set delay until the next module frame is due
+  uint16_t elapsed = softTriggerElapsed;
+  softTriggerElapsed = 0;
+  bool resync = (elapsed != 0);
+  if (!resync) {
+    elapsed = MIXER_SCHEDULER_TIMER->ARR + 1;
+  }
+  MIXER_SCHEDULER_TIMER->ARR = mixerSchedulerNextInterval(elapsed, resync) - 1;
 
   // trigger mixer start
   mixerSchedulerISRTrigger();
@@ -60,8 +60,19 @@ static void module_timer_send(void* ctx, const etx_timer_config_t* cfg,
   stm32_pulse_start_dma_req(timer, pulses, length, ocmode, ocval);  
 }
 
+static void module_timer_send_cyclic(void* ctx, const etx_timer_config_t* cfg,
+                                     const void* pulses, uint16_t length)
+{
+  auto timer = (const stm32_pulse_timer_t*)ctx;
+  stm32_pulse_set_polarity(timer, cfg->polarity);
+
+  uint32_t ocmode = (cfg->type == ETX_PWM) ? LL_TIM_OCMODE_PWM1 : LL_TIM_OCMODE_TOGGLE;
+  stm32_pulse_start_dma_cyclic(timer, pulses, length, ocmode, cfg->cmp_val);
+}
+
 const etx_timer_driver_t STM32ModuleTimerDriver = {
   .init = module_timer_init,
   .deinit = module_timer_deinit,
   .send = module_timer_send,
+  .send_cyclic = module_timer_send_cyclic,
 };
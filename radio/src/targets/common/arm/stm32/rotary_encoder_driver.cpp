@@ -120,7 +120,7 @@ void rotaryEncoderCheck()
   }
 #endif
 
-#if !defined(BOOT) && defined(COLORLCD)
+#if !defined(BOOT)
   static uint32_t last_tick = 0;
   static rotenc_t last_value = 0;
 
@@ -130,7 +130,8 @@ void rotaryEncoderCheck()
   if (diff != 0) {
     uint32_t now = RTOS_GET_MS();
     uint32_t dt = now - last_tick;
-    // pre-compute accumulated dt (dx/dt is done later in LVGL driver)
+    // pre-compute accumulated dt (dx/dt is done later in LVGL driver
+    // or in rotaryEncoderPollingCycle())
     rotencDt += dt;
     last_tick = now;
     last_value += diff * ROTARY_ENCODER_GRANULARITY;
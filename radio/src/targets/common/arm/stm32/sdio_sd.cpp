@@ -30,6 +30,10 @@
 #include "delays_driver.h"
 #include "debug.h"
 
+#if !defined(BOOT)
+  #include "rtos.h"
+#endif
+
 /* Configure PC.08, PC.09, PC.10, PC.11 pins: D0, D1, D2, D3 pins */
 #if !defined(SD_SDIO_DATA_GPIO) && !defined(SD_SDIO_DATA_GPIO_PINS)
 #define SD_SDIO_DATA_GPIO GPIOC
@@ -52,8 +56,69 @@ static SD_HandleTypeDef sdio;
 static DMA_HandleTypeDef sdioTxDma;
 
 // Disk status
-volatile uint32_t WriteStatus = 0;
-volatile uint32_t ReadStatus = 0;
+static volatile uint32_t WriteStatus = 0;
+static volatile uint32_t ReadStatus = 0;
+
+#if !defined(BOOT)
+// Given by the transfer complete callbacks, so that the task waiting
+// for a DMA transfer can sleep instead of spinning on the status flags
+static RTOS_FLAG_HANDLE sdioTransferFlag;
+static bool sdioTransferFlagCreated = false;
+static volatile bool sdioTransferWaiting = false;
+#endif
+
+// Sleeping is only possible from a task context: the USB mass storage
+// callbacks run from the USB interrupt, and the card is first read
+// before the scheduler has been started.
+static bool SD_CanSleep()
+{
+#if defined(BOOT)
+  return false;
+#else
+  return sdioTransferFlagCreated &&
+         (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) == 0 &&
+         xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+#endif
+}
+
+static void SD_TransferComplete(volatile uint32_t* status)
+{
+  *status = 1;
+#if !defined(BOOT)
+  if (sdioTransferWaiting) {
+    RTOS_ISR_SET_FLAG(sdioTransferFlag);
+  }
+#endif
+}
+
+static SD_Error SD_WaitTransferComplete(volatile uint32_t* status,
+                                        uint32_t timeout)
+{
+  uint32_t start = HAL_GetTick();
+
+#if !defined(BOOT)
+  if (SD_CanSleep()) {
+    // The flag may still be given by a transfer that completed after its
+    // waiter timed out, hence the status is checked again on wake up
+    sdioTransferWaiting = true;
+    while (*status == 0) {
+      uint32_t elapsed = HAL_GetTick() - start;
+      if (elapsed >= timeout) break;
+      RTOS_WAIT_FLAG(sdioTransferFlag, timeout - elapsed);
+    }
+    sdioTransferWaiting = false;
+  }
+#endif
+
+  while ((*status == 0) && ((HAL_GetTick() - start) < timeout));
+
+  if (*status == 0) {
+    return SD_ERROR;
+  }
+
+  *status = 0;
+  return SD_OK;
+}
 
 static void SD_LowLevel_Init(void)
 {
@@ -119,6 +184,11 @@ SD_Error SD_Init(void)
   if(_sdio_init) return SD_OK;
   _sdio_init = true;
 
+#if !defined(BOOT)
+  RTOS_CREATE_FLAG(sdioTransferFlag);
+  sdioTransferFlagCreated = true;
+#endif
+
   __IO SD_Error errorstatus = SD_OK;
 
   /* SDIO Peripheral Low Level Init */
@@ -184,6 +254,10 @@ int SD_CheckStatusWithTimeout(uint32_t timeout)
     if (state != SD_TRANSFER_BUSY) {
       return state == SD_TRANSFER_OK ? 0 : -1;
     }
+#if !defined(BOOT)
+    // let other tasks run while the card is programming
+    if (SD_CanSleep()) RTOS_WAIT_TICKS(1);
+#endif
   }
 
   return -1;
@@ -237,6 +311,7 @@ SD_Error SD_GetCardInfo(HAL_SD_CardInfoTypeDef *cardinfo)
   */
 SD_Error SD_ReadBlocks(uint8_t *readbuff, uint32_t ReadAddr, uint16_t BlockSize, uint32_t NumberOfBlocks)
 {
+  ReadStatus = 0;
   HAL_StatusTypeDef res = HAL_SD_ReadBlocks_DMA(&sdio, readbuff, ReadAddr, NumberOfBlocks);
   if(res == HAL_OK)
     return SD_OK;
@@ -244,32 +319,19 @@ SD_Error SD_ReadBlocks(uint8_t *readbuff, uint32_t ReadAddr, uint16_t BlockSize,
   return SD_ERROR;
 }
 
-// /**
-//   * @brief  This function waits until the SDIO DMA data transfer is finished.
-//   *         This function should be called after SDIO_ReadMultiBlocks() function
-//   *         to insure that all data sent by the card are already transferred by
-//   *         the DMA controller.
-//   * @param  None.
-//   * @retval SD_Error: SD Card Error code.
-//   */
-// SD_Error SD_WaitReadOperation(uint32_t timeout)
-// {
-//   volatile HAL_SD_CardStateTypeDef state = HAL_SD_GetCardState(&sdio);
-//   if(state == HAL_SD_CARD_READY || state == HAL_SD_CARD_TRANSFER)
-//     return SD_OK;
-//   timeout = 100;
-
-//   while((HAL_SD_GetCardState(&sdio) == HAL_SD_CARD_SENDING) && (timeout > 0)) {
-//     delay_ms(1);
-//     timeout--;
-//   }
-
-//   state = HAL_SD_GetCardState(&sdio);
-//   if(timeout > 0 && state == HAL_SD_CARD_TRANSFER)
-//     return SD_OK;
-
-//   return SD_ERROR;
-// }
+/**
+  * @brief  This function waits until the SDIO DMA data transfer is finished.
+  *         This function should be called after SD_ReadBlocks() function
+  *         to insure that all data sent by the card are already transferred by
+  *         the DMA controller. The calling task sleeps until the transfer
+  *         complete interrupt when the scheduler is running.
+  * @param  timeout: maximum time to wait in ms.
+  * @retval SD_Error: SD Card Error code.
+  */
+SD_Error SD_WaitReadOperation(uint32_t timeout)
+{
+  return SD_WaitTransferComplete(&ReadStatus, timeout);
+}
 
 /**
   * @brief  Allows to write blocks starting from a specified address in a card.
@@ -288,41 +350,26 @@ SD_Error SD_ReadBlocks(uint8_t *readbuff, uint32_t ReadAddr, uint16_t BlockSize,
   */
 SD_Error SD_WriteBlocks(uint8_t *writebuff, uint32_t WriteAddr, uint16_t BlockSize, uint32_t NumberOfBlocks)
 {
+  WriteStatus = 0;
   HAL_StatusTypeDef res = HAL_SD_WriteBlocks_DMA(&sdio, writebuff, WriteAddr, NumberOfBlocks);
   if(res == HAL_OK)
     return SD_OK;
   return SD_ERROR;
 }
 
-// /**
-//   * @brief  This function waits until the SDIO DMA data transfer is finished.
-//   *         This function should be called after SDIO_WriteBlock() and
-//   *         SDIO_WriteMultiBlocks() function to insure that all data sent by the
-//   *         card are already transferred by the DMA controller.
-//   * @param  None.
-//   * @retval SD_Error: SD Card Error code.
-//   */
-// OPTIMIZE("O0") SD_Error SD_WaitWriteOperation(uint32_t timeout)
-// {
-//   HAL_SD_CardStateTypeDef state = HAL_SD_GetCardState(&sdio);
-//   if(state == HAL_SD_CARD_READY || state == HAL_SD_CARD_TRANSFER)
-//     return SD_OK;
-
-//   timeout = 1000;
-
-//   state = HAL_SD_GetCardState(&sdio);
-//   while((state == HAL_SD_CARD_RECEIVING || state == HAL_SD_CARD_PROGRAMMING) && (timeout > 0)) {
-//     delay_ms(1);
-//     timeout--;
-//     state = HAL_SD_GetCardState(&sdio);
-//   }
-
-//   state = HAL_SD_GetCardState(&sdio);
-//   if(timeout > 0 && state == HAL_SD_CARD_TRANSFER)
-//     return SD_OK;
-
-//   return SD_ERROR;
-// }
+/**
+  * @brief  This function waits until the SDIO DMA data transfer is finished.
+  *         This function should be called after SD_WriteBlocks() function
+  *         to insure that all data have been transferred by the DMA
+  *         controller. The calling task sleeps until the transfer complete
+  *         interrupt when the scheduler is running.
+  * @param  timeout: maximum time to wait in ms.
+  * @retval SD_Error: SD Card Error code.
+  */
+SD_Error SD_WaitWriteOperation(uint32_t timeout)
+{
+  return SD_WaitTransferComplete(&WriteStatus, timeout);
+}
 
 uint32_t SD_GetSectorCount()
 {
@@ -393,7 +440,7 @@ uint32_t SD_GetCardClass()
 extern "C" void HAL_SD_TxCpltCallback(SD_HandleTypeDef *hsd)
 {
   UNUSED(hsd);
-  WriteStatus = 1;
+  SD_TransferComplete(&WriteStatus);
 }
 
 /**
@@ -405,7 +452,7 @@ extern "C" void HAL_SD_TxCpltCallback(SD_HandleTypeDef *hsd)
 extern "C" void HAL_SD_RxCpltCallback(SD_HandleTypeDef *hsd)
 {
   UNUSED(hsd);
-  ReadStatus = 1;
+  SD_TransferComplete(&ReadStatus);
 }
 
 extern "C" void SDIO_IRQHandler(void)
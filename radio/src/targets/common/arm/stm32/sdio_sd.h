@@ -66,5 +66,12 @@ uint32_t SD_GetCardType();
 uint32_t SD_GetCardVersion();
 uint32_t SD_GetCardClass();
 
+// Asynchronous DMA transfers (diskio_sdio.cpp): the buffer must be
+// aligned, DMA capable and left untouched until disk_wait_async()
+// has returned. Other disk accesses first wait for the pending one.
+SD_Error disk_read_async(uint8_t *buff, uint32_t sector, uint32_t count);
+SD_Error disk_write_async(const uint8_t *buff, uint32_t sector, uint32_t count);
+SD_Error disk_wait_async();
+
 #endif // _SDIO_SD_H_
 
@@ -39,6 +39,16 @@ static volatile uint32_t _adc_inhibit_mask;
 // DMA buffers
 static uint16_t _adc_dma_buffer[MAX_ADC_INPUTS] __DMA;
 
+#if defined(ADC_CONTINUOUS)
+// ADCs convert continuously into a circular DMA buffer holding the last
+// OVERSAMPLING sequences, which is averaged on read: the mixer never waits
+// for a conversion, and no IRQ is involved
+#define MAX_ADCS 3
+static uint16_t _adc_cont_buffer[MAX_ADC_INPUTS * OVERSAMPLING] __DMA;
+static uint8_t _adc_nconv[MAX_ADCS];
+static bool _adc_cont_running;
+#endif
+
 // ADCs started
 static uint8_t _adc_started_mask;
 static volatile uint8_t _adc_completed;
@@ -169,7 +179,11 @@ static void adc_setup_scan_mode(ADC_TypeDef* ADCx, uint8_t nconv)
   LL_ADC_REG_StructInit(&adcRegInit);
 
   adcRegInit.TriggerSource = LL_ADC_REG_TRIG_SOFTWARE;
+#if defined(ADC_CONTINUOUS)
+  adcRegInit.ContinuousMode = LL_ADC_REG_CONV_CONTINUOUS;
+#else
   adcRegInit.ContinuousMode = LL_ADC_REG_CONV_SINGLE;
+#endif
 
   if (nconv > 1) {
     adcRegInit.SequencerLength = _seq_length_lookup[nconv - 1];
@@ -330,6 +344,21 @@ bool stm32_hal_adc_init(const stm32_adc_t* ADCs, uint8_t n_ADC,
       nconv = adc_init_channels(adc, inputs, chan, nconv);
       adc_setup_scan_mode(adc->ADCx, nconv);
 
+#if defined(ADC_CONTINUOUS)
+      _adc_nconv[adc - ADCs] = nconv;
+      if (nconv > 1) {
+        if (!adc->DMAx)
+          return false;
+
+        uint16_t* dma_buffer = _adc_cont_buffer + adc->offset * OVERSAMPLING;
+        if (!adc_init_dma_stream(adc->ADCx, adc->DMAx, adc->DMA_Stream,
+                                 adc->DMA_Channel, dma_buffer,
+                                 nconv * OVERSAMPLING))
+          return false;
+
+        LL_DMA_SetMode(adc->DMAx, adc->DMA_Stream, LL_DMA_MODE_CIRCULAR);
+      }
+#else
       if (nconv > 1) {
         if (adc->DMAx) {
           uint16_t* dma_buffer = _adc_dma_buffer + adc->offset;
@@ -349,12 +378,17 @@ bool stm32_hal_adc_init(const stm32_adc_t* ADCs, uint8_t n_ADC,
         NVIC_SetPriority(ADC_IRQn, ADC_IRQ_PRIO);
         NVIC_EnableIRQ(ADC_IRQn);
       }
+#endif
     }
 
     // move to next ADC definition
     adc++; n_ADC--;
   }
 
+#if defined(ADC_CONTINUOUS)
+  _adc_cont_running = false;
+#endif
+
   return true;
 }
 
@@ -379,6 +413,18 @@ static void adc_dma_clear_flags(DMA_TypeDef* DMAx, uint32_t stream)
   }
 }
 
+#if defined(ADC_CONTINUOUS)
+static bool adc_dma_transfer_complete(DMA_TypeDef* DMAx, uint32_t stream)
+{
+  if (stream == LL_DMA_STREAM_4) {
+    return READ_BIT(DMAx->HISR, DMA_HISR_TCIF4);
+  } else if (stream == LL_DMA_STREAM_0) {
+    return READ_BIT(DMAx->LISR, DMA_LISR_TCIF0);
+  }
+  return true;
+}
+#endif
+
 static inline DMA_Stream_TypeDef* _dma_get_stream(DMA_TypeDef *DMAx, uint32_t Stream)
 {
   return ((DMA_Stream_TypeDef*)((uint32_t)((uint32_t)DMAx + STREAM_OFFSET_TAB[Stream])));
@@ -469,9 +515,85 @@ static void adc_start_read(const stm32_adc_t* ADCs, uint8_t n_ADC)
   }
 }
 
+static void copy_adc_values(uint16_t* src, const stm32_adc_t* adc,
+                            const stm32_adc_input_t* inputs);
+
+#if defined(ADC_CONTINUOUS)
+// Start all ADCs once, and wait for the DMA buffers to be filled
+static void adc_start_continuous(const stm32_adc_t* ADCs, uint8_t n_ADC)
+{
+  const stm32_adc_t* adc = ADCs;
+  for (uint8_t i = 0; i < n_ADC; i++, adc++) {
+    auto ADCx = adc->ADCx;
+    if (!LL_ADC_IsEnabled(ADCx) || !_adc_nconv[i]) continue;
+
+    CLEAR_BIT(ADCx->SR, ADC_SR_EOC | ADC_SR_STRT | ADC_SR_OVR);
+    if (_adc_nconv[i] > 1) {
+      adc_dma_clear_flags(adc->DMAx, adc->DMA_Stream);
+      LL_DMA_EnableStream(adc->DMAx, adc->DMA_Stream);
+    }
+    SET_BIT(ADCx->CR2, ADC_CR2_SWSTART);
+  }
+
+  adc = ADCs;
+  for (uint8_t i = 0; i < n_ADC; i++, adc++) {
+    auto ADCx = adc->ADCx;
+    if (!LL_ADC_IsEnabled(ADCx) || !_adc_nconv[i]) continue;
+
+    uint32_t timeout = 100000;
+    if (_adc_nconv[i] > 1) {
+      while (!adc_dma_transfer_complete(adc->DMAx, adc->DMA_Stream) && --timeout);
+    } else {
+      while (!LL_ADC_IsActiveFlag_EOCS(ADCx) && --timeout);
+    }
+  }
+}
+
+// Average the samples currently in the DMA buffers
+static void adc_read_continuous(const stm32_adc_t* ADCs, uint8_t n_ADC,
+                                const stm32_adc_input_t* inputs, uint8_t n_inputs)
+{
+  memclear(_adc_oversampling, sizeof(_adc_oversampling));
+
+  const stm32_adc_t* adc = ADCs;
+  for (uint8_t i = 0; i < n_ADC; i++, adc++) {
+    if (!LL_ADC_IsEnabled(adc->ADCx)) continue;
+
+    uint8_t nconv = _adc_nconv[i];
+    if (nconv > 1) {
+      uint16_t* dma_buffer = _adc_cont_buffer + adc->offset * OVERSAMPLING;
+      for (uint8_t sample = 0; sample < OVERSAMPLING; sample++) {
+        copy_adc_values(dma_buffer + sample * nconv, adc, inputs);
+      }
+    } else if (nconv == 1) {
+      // the data register always holds the last conversion
+      uint16_t value = adc->ADCx->DR;
+      for (uint8_t sample = 0; sample < OVERSAMPLING; sample++) {
+        copy_adc_values(&value, adc, inputs);
+      }
+    }
+  }
+
+  auto adcValues = getAnalogValues();
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    if (~_adc_input_mask & (1 << i)) continue;
+    if (_adc_inhibit_mask & (1 << i)) continue;
+    adcValues[i] = _adc_oversampling[i] / OVERSAMPLING;
+  }
+}
+#endif
+
 bool stm32_hal_adc_start_read(const stm32_adc_t* ADCs, uint8_t n_ADC,
                               const stm32_adc_input_t* inputs, uint8_t n_inputs)
 {
+#if defined(ADC_CONTINUOUS)
+  if (!_adc_cont_running) {
+    adc_start_continuous(ADCs, n_ADC);
+    _adc_cont_running = true;
+  }
+  adc_read_continuous(ADCs, n_ADC, inputs, n_inputs);
+  _adc_completed = 1;
+#else
   _adc_completed = 0;
   _adc_run = 0;
 
@@ -482,6 +604,7 @@ bool stm32_hal_adc_start_read(const stm32_adc_t* ADCs, uint8_t n_ADC,
 
   memclear(_adc_oversampling, sizeof(_adc_oversampling));
   adc_start_read(_adc_ADCs, _adc_n_ADC);
+#endif
 
   return true;
 }
@@ -24,6 +24,7 @@
 #include "stm32_dma.h"
 
 #include "definitions.h"
+#include "task_stats.h"
 
 #include <string.h>
 
@@ -225,9 +226,9 @@ static void force_start_level(const stm32_pulse_timer_t* tim)
   LL_TIM_OC_SetMode(tim->TIMx, channel, mode);
 }
 
-void stm32_pulse_start_dma_req(const stm32_pulse_timer_t* tim,
-                               const void* pulses, uint16_t length,
-                               uint32_t ocmode, uint32_t cmp_val)
+static void start_dma(const stm32_pulse_timer_t* tim, const void* pulses,
+                      uint16_t length, uint32_t ocmode, uint32_t cmp_val,
+                      bool cyclic)
 {
   // Re-configure timer output
   set_compare_reg(tim, cmp_val);
@@ -263,11 +264,16 @@ void stm32_pulse_start_dma_req(const stm32_pulse_timer_t* tim,
   dmaInit.NbData = length;
   dmaInit.Channel = tim->DMA_Channel;
   dmaInit.Priority = LL_DMA_PRIORITY_VERYHIGH;
+  if (cyclic) {
+    dmaInit.Mode = LL_DMA_MODE_CIRCULAR;
+  }
 
   LL_DMA_Init(tim->DMAx, tim->DMA_Stream, &dmaInit);
 
-  // Enable TC IRQ
-  LL_DMA_EnableIT_TC(tim->DMAx, tim->DMA_Stream);
+  // Enable TC IRQ (the cyclic mode never completes)
+  if (!cyclic) {
+    LL_DMA_EnableIT_TC(tim->DMAx, tim->DMA_Stream);
+  }
 
   if (ocmode == LL_TIM_OCMODE_PWM1) {
     // preloads first period for PWM)
@@ -292,8 +298,31 @@ void stm32_pulse_start_dma_req(const stm32_pulse_timer_t* tim,
   LL_TIM_EnableCounter(tim->TIMx);
 }
 
+void stm32_pulse_start_dma_req(const stm32_pulse_timer_t* tim,
+                               const void* pulses, uint16_t length,
+                               uint32_t ocmode, uint32_t cmp_val)
+{
+  start_dma(tim, pulses, length, ocmode, cmp_val, false);
+}
+
+void stm32_pulse_start_dma_cyclic(const stm32_pulse_timer_t* tim,
+                                  const void* pulses, uint16_t length,
+                                  uint32_t ocmode, uint32_t cmp_val)
+{
+  // stop any running pulse train first
+  LL_TIM_DisableCounter(tim->TIMx);
+  LL_TIM_DisableIT_UPDATE(tim->TIMx);
+  LL_TIM_DisableDMAReq_UPDATE(tim->TIMx);
+  LL_DMA_DisableStream(tim->DMAx, tim->DMA_Stream);
+  while (LL_DMA_IsEnabledStream(tim->DMAx, tim->DMA_Stream));
+
+  start_dma(tim, pulses, length, ocmode, cmp_val, true);
+}
+
 void stm32_pulse_dma_tc_isr(const stm32_pulse_timer_t* tim)
 {
+  TaskStatsIsrScope isrScope(TASK_STATS_ISR_PULSES);
+
   if (!stm32_dma_check_tc_flag(tim->DMAx, tim->DMA_Stream))
     return;
 
@@ -314,6 +343,8 @@ void stm32_pulse_dma_tc_isr(const stm32_pulse_timer_t* tim)
 
 void stm32_pulse_tim_update_isr(const stm32_pulse_timer_t* tim)
 {
+  TaskStatsIsrScope isrScope(TASK_STATS_ISR_PULSES);
+
   if (!LL_TIM_IsActiveFlag_UPDATE(tim->TIMx))
     return;
 
@@ -73,6 +73,12 @@ void stm32_pulse_start_dma_req(const stm32_pulse_timer_t* tim,
                                const void* pulses, uint16_t length,
                                uint32_t ocmode, uint32_t cmp_val);
 
+// same as above, but the DMA loops over the pulses without any IRQ
+// until the timer is stopped or re-started
+void stm32_pulse_start_dma_cyclic(const stm32_pulse_timer_t* tim,
+                                  const void* pulses, uint16_t length,
+                                  uint32_t ocmode, uint32_t cmp_val);
+
 // Must be called from DMA TC IRQ handler
 void stm32_pulse_dma_tc_isr(const stm32_pulse_timer_t* tim);
 
@@ -417,6 +417,45 @@ static int stm32_serial_get_last_byte(void* ctx, uint32_t idx, uint8_t* data)
   return 1;
 }
 
+static uint32_t stm32_serial_get_rx_span(void* ctx, const uint8_t** data)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return 0;
+
+  auto sp = st->sp;
+  const auto& rx_buf = sp->rx_buffer;
+  auto buf_len = rx_buf.length;
+  if (!buf_len) return 0;
+
+  auto& buf_st = st->rx_buf;
+
+  uint32_t widx;
+  auto usart = sp->usart;
+  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
+    auto dma = usart->rxDMA;
+    auto stream = usart->rxDMA_Stream;
+    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
+  } else {
+    widx = buf_st.widx;
+  }
+
+  // the span stops at the end of the ring buffer,
+  // the rest is returned by the next call
+  uint32_t ridx = buf_st.ridx;
+  *data = rx_buf.buffer + ridx;
+  return (widx >= ridx ? widx : buf_len) - ridx;
+}
+
+static void stm32_serial_consume_rx(void* ctx, uint32_t len)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return;
+
+  auto buf_len = st->sp->rx_buffer.length;
+  auto& buf_st = st->rx_buf;
+  buf_st.ridx = (buf_st.ridx + len) & (buf_len - 1);
+}
+
 static void stm32_serial_clear_rx_buffer(void* ctx)
 {
   auto st = (stm32_serial_state*)ctx;
@@ -486,6 +525,8 @@ const etx_serial_driver_t STM32SerialDriver = {
   .enableRx = stm32_enable_rx,
   .getByte = stm32_serial_get_byte,
   .getLastByte = stm32_serial_get_last_byte,
+  .getRxSpan = stm32_serial_get_rx_span,
+  .consumeRx = stm32_serial_consume_rx,
   .clearRxBuffer = stm32_serial_clear_rx_buffer,
   .getBaudrate = stm32_serial_get_baudrate,
   .setBaudrate = stm32_serial_set_baudrate,
@@ -226,6 +226,8 @@ const etx_serial_driver_t STM32SoftSerialRxDriver = {
   .enableRx = nullptr,
   .getByte = stm32_softserial_rx_get_byte,
   .getLastByte = nullptr,
+  .getRxSpan = nullptr,
+  .consumeRx = nullptr,
   .clearRxBuffer = stm32_softserial_rx_clear_rx_buffer,
   .getBaudrate = nullptr,
   .setReceiveCb = nullptr,
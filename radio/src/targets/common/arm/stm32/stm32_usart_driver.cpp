@@ -23,6 +23,10 @@
 #include "stm32_gpio_driver.h"
 #include "stm32_dma.h"
 
+#if !defined(BOOT)
+  #include "task_stats.h"
+#endif
+
 #include <string.h>
 
 // WARNING:
@@ -531,6 +535,10 @@ void stm32_usart_set_hw_option(const stm32_usart_t* usart, uint32_t option)
 
 void stm32_usart_isr(const stm32_usart_t* usart, etx_serial_callbacks_t* cb)
 {
+#if !defined(BOOT)
+  TaskStatsIsrScope isrScope(TASK_STATS_ISR_SERIAL);
+#endif
+
   uint32_t status = LL_USART_ReadReg(usart->USARTx, SR);
 
   // cache these first, as RXNE might clear SR
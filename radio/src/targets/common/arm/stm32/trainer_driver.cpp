@@ -142,6 +142,7 @@ static void _init_trainer_capture(const stm32_pulse_timer_t* tim)
   // set proper ISR handler first
   _trainer_timer = tim;
   _trainer_timer_isr = trainer_in_isr;
+  trainerCaptureFifo.clear();
 
   stm32_pulse_init(tim, 0);
   stm32_pulse_config_input(tim);
@@ -387,6 +388,32 @@ int trainerModuleSbusGetByte(uint8_t* data)
   return 0;
 }
 
+uint32_t trainerModuleSbusGetRxSpan(const uint8_t** data)
+{
+  if (!sbus_trainer_mod_st) return 0;
+
+  auto serial_driver = modulePortGetSerialDrv(sbus_trainer_mod_st->rx);
+  auto ctx = modulePortGetCtx(sbus_trainer_mod_st->rx);
+
+  if (ctx && serial_driver->getRxSpan && serial_driver->consumeRx) {
+    return serial_driver->getRxSpan(ctx, data);
+  }
+
+  return 0;
+}
+
+void trainerModuleSbusConsumeRx(uint32_t len)
+{
+  if (!sbus_trainer_mod_st) return;
+
+  auto serial_driver = modulePortGetSerialDrv(sbus_trainer_mod_st->rx);
+  auto ctx = modulePortGetCtx(sbus_trainer_mod_st->rx);
+
+  if (ctx && serial_driver->consumeRx) {
+    serial_driver->consumeRx(ctx, len);
+  }
+}
+
 #elif defined(TRAINER_MODULE_SBUS_USART)
 #include "stm32_serial_driver.h"
 
@@ -425,6 +452,16 @@ int trainerModuleSbusGetByte(uint8_t* data)
   return STM32SerialDriver.getByte(_sbus_trainer_ctx, data);
 }
 
+uint32_t trainerModuleSbusGetRxSpan(const uint8_t** data)
+{
+  return STM32SerialDriver.getRxSpan(_sbus_trainer_ctx, data);
+}
+
+void trainerModuleSbusConsumeRx(uint32_t len)
+{
+  STM32SerialDriver.consumeRx(_sbus_trainer_ctx, len);
+}
+
 #else
   #error "No available SBUS trainer implementation"
 #endif
@@ -40,6 +40,8 @@ extern "C" {
 #include "board.h"
 #include "debug.h"
 
+#include <string.h>
+
 static bool usbDriverStarted = false;
 #if defined(BOOT)
 static usbMode selectedUsbMode = USB_MASS_STORAGE_MODE;
@@ -143,6 +145,79 @@ bool usbStarted()
 #if !defined(BOOT)
 #include "globals.h"
 
+// Unchanged reports are not sent again, but the
+// last one is repeated at least this often
+#define USB_JOYSTICK_REFRESH_US  100000
+
+static uint8_t usbJoystickLastReport[64];
+static uint32_t usbJoystickLastSent;
+static volatile uint32_t usbJoystickQueuedAt;
+
+struct UsbJoystickWindow {
+  uint32_t start;
+  uint16_t sent;
+  uint16_t unchanged;
+  uint32_t latencySum;
+  uint16_t latencyMin;
+  uint16_t latencyMax;
+};
+
+static UsbJoystickWindow usbJoystickWindow;
+static UsbJoystickStats usbJoystickStats;
+
+// called from the USB interrupt when the host has read the report
+void usbJoystickReportSent()
+{
+  uint32_t latency = (ticksNow() - usbJoystickQueuedAt) / SYSTEM_TICKS_1US;
+  if (latency > 0xFFFF) latency = 0xFFFF;
+
+  auto & w = usbJoystickWindow;
+  if (!w.sent || latency < w.latencyMin) w.latencyMin = latency;
+  if (latency > w.latencyMax) w.latencyMax = latency;
+  w.latencySum += latency;
+  w.sent++;
+}
+
+void usbJoystickGetStats(UsbJoystickStats * stats)
+{
+  *stats = usbJoystickStats;
+}
+
+static void usbJoystickCloseWindow(uint32_t now)
+{
+  uint32_t prim = __get_PRIMASK();
+  __disable_irq();
+
+  auto & w = usbJoystickWindow;
+  usbJoystickStats.sent = w.sent;
+  usbJoystickStats.unchanged = w.unchanged;
+  usbJoystickStats.latencyMin = w.latencyMin;
+  usbJoystickStats.latencyAvg = w.sent ? w.latencySum / w.sent : 0;
+  usbJoystickStats.latencyMax = w.latencyMax;
+  memset(&w, 0, sizeof(w));
+  w.start = now;
+
+  if (!prim) __enable_irq();
+}
+
+// Sends 'report' unless the host already has the same one
+static void usbJoystickSendReport(uint8_t * report, uint8_t size)
+{
+  uint32_t now = ticksNow();
+  if (size > sizeof(usbJoystickLastReport)) size = sizeof(usbJoystickLastReport);
+
+  if (!memcmp(report, usbJoystickLastReport, size) &&
+      now - usbJoystickLastSent < USB_JOYSTICK_REFRESH_US * SYSTEM_TICKS_1US) {
+    usbJoystickWindow.unchanged++;
+    return;
+  }
+
+  memcpy(usbJoystickLastReport, report, size);
+  usbJoystickLastSent = now;
+  usbJoystickQueuedAt = now;
+  USBD_HID_SendReport(&USB_OTG_dev, report, size);
+}
+
 /*
   Prepare and send new USB data packet
 
@@ -152,6 +227,11 @@ bool usbStarted()
 */
 void usbJoystickUpdate()
 {
+  uint32_t now = ticksNow();
+  if (now - usbJoystickWindow.start >= SYSTEM_TICKS_1MS * 1000) {
+    usbJoystickCloseWindow(now);
+  }
+
 #if !defined(USBJ_EX)
   static uint8_t HID_Buffer[HID_IN_PACKET];
 
@@ -184,13 +264,13 @@ void usbJoystickUpdate()
       HID_Buffer[i*2 +4] = static_cast<uint8_t>((value >> 8) & 0x07);
 
     }
-    USBD_HID_SendReport(&USB_OTG_dev, HID_Buffer, HID_IN_PACKET);
+    usbJoystickSendReport(HID_Buffer, HID_IN_PACKET);
   }
 #else
   // test to se if TX buffer is free
   if (USBD_HID_SendReport(&USB_OTG_dev, 0, 0) == USBD_OK) {
     usbReport_t ret = usbReport();
-    USBD_HID_SendReport(&USB_OTG_dev, ret.ptr, ret.size);
+    usbJoystickSendReport(ret.ptr, ret.size);
   }
 #endif
 }
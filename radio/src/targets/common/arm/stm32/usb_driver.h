@@ -58,4 +58,24 @@ void setSelectedUsbMode(int mode);
 
 EXTERN_C(uint32_t usbSerialFreeSpace());
 
+// HID joystick reports over the last second
+struct UsbJoystickStats {
+  uint16_t sent;        // reports delivered to the host
+  uint16_t unchanged;   // updates skipped, same report as the last one
+  uint16_t latencyMin;  // us from queuing a report to the host poll
+  uint16_t latencyAvg;
+  uint16_t latencyMax;
+};
+
+EXTERN_C(void usbJoystickReportSent());
+EXTERN_C(void usbJoystickGetStats(struct UsbJoystickStats * stats));
+
+// USB mass storage throughput over the last second, in bytes/s
+struct UsbStorageStats {
+  uint32_t readRate;
+  uint32_t writeRate;
+};
+
+EXTERN_C(void usbStorageGetStats(struct UsbStorageStats * stats));
+
 extern const etx_serial_port_t UsbSerialPort;
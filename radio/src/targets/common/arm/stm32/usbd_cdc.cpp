@@ -246,6 +246,27 @@ void usbSerialPutc(void*, uint8_t c)
   if (!prim) __enable_irq();
 }
 
+// Queues the whole buffer or nothing when there is not enough
+// room, so that framed streams are never cut in the middle
+void usbSerialPutBuf(void*, const uint8_t* data, uint32_t size)
+{
+  if (!cdcConnected) return;
+
+  uint32_t prim = __get_PRIMASK();
+  __disable_irq();
+
+  if (usbSerialFreeSpace() >= size) {
+    uint32_t in = APP_Rx_ptr_in;
+    while (size--) {
+      APP_Rx_Buffer[in] = *data++;
+      in = (in + 1) % APP_RX_DATA_SIZE;
+    }
+    APP_Rx_ptr_in = in;
+  }
+
+  if (!prim) __enable_irq();
+}
+
 /**
   * @brief  VCP_DataRx
   *         Data received over USB OUT endpoint is available here
@@ -306,7 +327,7 @@ static const etx_serial_driver_t usbSerialDriver = {
   .init = usbSerialInit,
   .deinit = nullptr,
   .sendByte = usbSerialPutc,
-  .sendBuffer = nullptr,
+  .sendBuffer = usbSerialPutBuf,
   .waitForTxCompleted = nullptr,
   .getByte = nullptr,
   .clearRxBuffer = nullptr,
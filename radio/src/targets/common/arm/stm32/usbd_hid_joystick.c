@@ -22,6 +22,7 @@
 #include "usbd_desc.h"
 #include "usbd_hid_core.h"
 #include "usbd_req.h"
+#include "usb_driver.h"
 #if defined(USBJ_EX)
 #include "usb_joystick.h"
 #endif
@@ -464,6 +465,7 @@ static uint8_t  USBD_HID_DataIn (void  *pdev,
                               uint8_t epnum)
 {
   ReportSent = 1;
+  usbJoystickReportSent();
   /* Ensure that the FIFO is empty before a new transfer, this condition could 
   be caused by  a new transfer before the end of the previous transfer */
   DCD_EP_Flush(pdev, HID_IN_EP);
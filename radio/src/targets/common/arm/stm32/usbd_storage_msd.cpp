@@ -136,6 +136,65 @@ const USBD_STORAGE_cb_TypeDef  * const USBD_STORAGE_fops = &USBD_MICRO_SDIO_fops
 }
 #endif
 
+// With the SDIO DMA, full packet transfers are overlapped with USB:
+//  - a full packet read prefetches the next one
+//  - a full packet write returns once the DMA is started, and its
+//    result is checked by the next access or by STORAGE_Flush()
+#if defined(SD_SDIO_DMA) && MSC_MEDIA_PACKET > BLOCK_SIZE
+  #define STORAGE_ASYNC
+  #include "sdio_sd.h"
+
+static uint8_t storageBuffer[MSC_MEDIA_PACKET] __DMA;
+static uint32_t storagePrefetchAddr = 0;
+static uint16_t storagePrefetchLen = 0;
+static bool storageWritePending = false;
+
+// Waits for the pending transfer, only a failed write is an error:
+// a prefetch is a guess and will simply be read again
+static int8_t storageWaitAsync()
+{
+  SD_Error res = disk_wait_async();
+  bool write = storageWritePending;
+  storageWritePending = false;
+  storagePrefetchLen = 0;
+  return (write && res != SD_OK) ? -1 : 0;
+}
+#endif
+
+#if !defined(BOOT)
+static tmr10ms_t storageStatsStart = 0;
+static uint32_t storageReadBytes = 0;
+static uint32_t storageWriteBytes = 0;
+static UsbStorageStats storageStats;
+
+static void storageStatsAdd(uint32_t & counter, uint16_t blk_len)
+{
+  tmr10ms_t now = get_tmr10ms();
+  tmr10ms_t elapsed = now - storageStatsStart;
+  if (elapsed >= 100) {
+    // a window without transfers means the host was idle
+    bool idle = elapsed >= 200;
+    storageStats.readRate = idle ? 0 : storageReadBytes * 100 / elapsed;
+    storageStats.writeRate = idle ? 0 : storageWriteBytes * 100 / elapsed;
+    storageReadBytes = 0;
+    storageWriteBytes = 0;
+    storageStatsStart = now;
+  }
+  counter += blk_len * BLOCK_SIZE;
+}
+
+void usbStorageGetStats(UsbStorageStats * stats)
+{
+  if (get_tmr10ms() - storageStatsStart >= 200) {
+    stats->readRate = 0;
+    stats->writeRate = 0;
+  }
+  else {
+    *stats = storageStats;
+  }
+}
+#endif
+
 int8_t STORAGE_Init (uint8_t lun)
 {
   NVIC_InitTypeDef NVIC_InitStructure;
@@ -249,8 +308,39 @@ int8_t STORAGE_Read (uint8_t lun,
   }
 #endif
 
+#if !defined(BOOT)
+  storageStatsAdd(storageReadBytes, blk_len);
+#endif
+
+#if defined(STORAGE_ASYNC)
+  bool prefetched = false;
+  if (storagePrefetchLen && storagePrefetchAddr == blk_addr &&
+      storagePrefetchLen == blk_len) {
+    storagePrefetchLen = 0;
+    if (disk_wait_async() == SD_OK) {
+      memcpy(buf, storageBuffer, blk_len * BLOCK_SIZE);
+      prefetched = true;
+    }
+  }
+
+  if (!prefetched) {
+    if (storageWaitAsync() < 0) return -1;
+    if (__disk_read(0, buf, blk_addr, blk_len) != RES_OK) return -1;
+  }
+
+  // sequential read: fetch the next packet while this one is sent
+  uint32_t next = blk_addr + blk_len;
+  if (blk_len * BLOCK_SIZE == MSC_MEDIA_PACKET &&
+      next + blk_len <= SD_GetSectorCount() &&
+      disk_read_async(storageBuffer, next, blk_len) == SD_OK) {
+    storagePrefetchAddr = next;
+    storagePrefetchLen = blk_len;
+  }
+  return 0;
+#else
   // read without cache
   return (__disk_read(0, buf, blk_addr, blk_len) == RES_OK) ? 0 : -1;
+#endif
 }
 /**
   * @brief  Write data to the medium
@@ -274,10 +364,37 @@ int8_t STORAGE_Write (uint8_t lun,
   }
 #endif
 
+#if !defined(BOOT)
+  storageStatsAdd(storageWriteBytes, blk_len);
+#endif
+
+#if defined(STORAGE_ASYNC)
+  // also reports the failure of the previous write
+  if (storageWaitAsync() < 0) return -1;
+
+  if (blk_len * BLOCK_SIZE == MSC_MEDIA_PACKET) {
+    // the USB receives the next packet while this one is written
+    memcpy(storageBuffer, buf, MSC_MEDIA_PACKET);
+    if (disk_write_async(storageBuffer, blk_addr, blk_len) != SD_OK) return -1;
+    storageWritePending = true;
+    return 0;
+  }
+#endif
+
   // write without cache
   return (__disk_write(0, buf, blk_addr, blk_len) == RES_OK) ? 0 : -1;
 }
 
+int8_t STORAGE_Flush(uint8_t lun)
+{
+#if defined(STORAGE_ASYNC)
+  if (lun == STORAGE_SDCARD_LUN) {
+    return storageWaitAsync();
+  }
+#endif
+  return 0;
+}
+
 /**
   * @brief  Return number of supported logical unit
   * @param  None
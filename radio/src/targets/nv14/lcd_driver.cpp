@@ -1348,6 +1348,80 @@ void DMAWait()
   while(DMA2D->CR & DMA2D_CR_START);
 }
   
+void DMAFillRect(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
+                 uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+  DMAWait();
+  DMA2D_DeInit();
+
+  RGB_SPLIT(color, red, green, blue);
+
+  DMA2D_InitTypeDef DMA2D_InitStruct;
+  DMA2D_InitStruct.DMA2D_Mode = DMA2D_R2M;
+  DMA2D_InitStruct.DMA2D_CMode = DMA2D_RGB565;
+  DMA2D_InitStruct.DMA2D_OutputMemoryAdd = CONVERT_PTR_UINT(dest + y*destw + x);
+  DMA2D_InitStruct.DMA2D_OutputGreen = green;
+  DMA2D_InitStruct.DMA2D_OutputBlue = blue;
+  DMA2D_InitStruct.DMA2D_OutputRed = red;
+  DMA2D_InitStruct.DMA2D_OutputAlpha = 0;
+  DMA2D_InitStruct.DMA2D_OutputOffset = destw - w;
+  DMA2D_InitStruct.DMA2D_NumberOfLine = h;
+  DMA2D_InitStruct.DMA2D_PixelPerLine = w;
+  DMA2D_Init(&DMA2D_InitStruct);
+
+  /* Start Transfer */
+  DMA2D_StartTransfer();
+}
+
+// same as DMAFillRect(), blended with 'opacity' (0-255) over the current pixels
+void DMABlendRect(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
+                  uint16_t y, uint16_t w, uint16_t h, uint16_t color,
+                  uint8_t opacity)
+{
+  DMAWait();
+  DMA2D_DeInit();
+
+  DMA2D_InitTypeDef DMA2D_InitStruct;
+  DMA2D_InitStruct.DMA2D_Mode = DMA2D_M2M_BLEND;
+  DMA2D_InitStruct.DMA2D_CMode = CM_RGB565;
+  DMA2D_InitStruct.DMA2D_OutputMemoryAdd = CONVERT_PTR_UINT(dest + y*destw + x);
+  DMA2D_InitStruct.DMA2D_OutputBlue = 0;
+  DMA2D_InitStruct.DMA2D_OutputGreen = 0;
+  DMA2D_InitStruct.DMA2D_OutputRed = 0;
+  DMA2D_InitStruct.DMA2D_OutputAlpha = 0;
+  DMA2D_InitStruct.DMA2D_OutputOffset = destw - w;
+  DMA2D_InitStruct.DMA2D_NumberOfLine = h;
+  DMA2D_InitStruct.DMA2D_PixelPerLine = w;
+  DMA2D_Init(&DMA2D_InitStruct);
+
+  // A8 foreground with a fixed alpha: the color comes from the FG color
+  // register and the alpha from 'opacity', the data read is not used
+  // (the destination area itself is read, it is always valid memory)
+  DMA2D_FG_InitTypeDef DMA2D_FG_InitStruct;
+  DMA2D_FG_StructInit(&DMA2D_FG_InitStruct);
+  DMA2D_FG_InitStruct.DMA2D_FGMA = CONVERT_PTR_UINT(dest + y*destw + x);
+  DMA2D_FG_InitStruct.DMA2D_FGO = 2 * destw - w;
+  DMA2D_FG_InitStruct.DMA2D_FGCM = CM_A8;
+  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_MODE = REPLACE_ALPHA_VALUE;
+  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_VALUE = opacity;
+  DMA2D_FG_InitStruct.DMA2D_FGC_RED   = GET_RED(color);   // 8 bit red
+  DMA2D_FG_InitStruct.DMA2D_FGC_GREEN = GET_GREEN(color); // 8 bit green
+  DMA2D_FG_InitStruct.DMA2D_FGC_BLUE  = GET_BLUE(color);  // 8 bit blue
+  DMA2D_FGConfig(&DMA2D_FG_InitStruct);
+
+  DMA2D_BG_InitTypeDef DMA2D_BG_InitStruct;
+  DMA2D_BG_StructInit(&DMA2D_BG_InitStruct);
+  DMA2D_BG_InitStruct.DMA2D_BGMA = CONVERT_PTR_UINT(dest + y*destw + x);
+  DMA2D_BG_InitStruct.DMA2D_BGO = destw - w;
+  DMA2D_BG_InitStruct.DMA2D_BGCM = CM_RGB565;
+  DMA2D_BG_InitStruct.DMA2D_BGPFC_ALPHA_MODE = NO_MODIF_ALPHA_VALUE;
+  DMA2D_BG_InitStruct.DMA2D_BGPFC_ALPHA_VALUE = 0;
+  DMA2D_BGConfig(&DMA2D_BG_InitStruct);
+
+  /* Start Transfer */
+  DMA2D_StartTransfer();
+}
+
 void DMACopyBitmap(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
                    uint16_t y, const uint16_t *src, uint16_t srcw,
                    uint16_t srch, uint16_t srcx, uint16_t srcy, uint16_t w,
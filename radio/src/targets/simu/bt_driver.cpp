@@ -24,6 +24,8 @@
 void bluetoothInit(unsigned int, bool) {}
 void bluetoothWrite(const void*, uint32_t) {}
 int bluetoothRead(uint8_t*) { return 0; }
+uint32_t bluetoothGetRxSpan(const uint8_t**) { return 0; }
+void bluetoothConsumeRx(uint32_t) {}
 void bluetoothDisable() {}
 bool bluetoothIsWriting() { return false; }
 volatile uint8_t btChipPresent;
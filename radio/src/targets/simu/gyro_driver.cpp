@@ -22,3 +22,4 @@
 void gyroInit() {}
 void gyroRead() {}
 void gyroRead(unsigned char*) {}
+int gyroReadFifo(short (*)[6], unsigned char, unsigned short*) { return -1; }
@@ -23,6 +23,7 @@
 #include "hal/serial_driver.h"
 #include "hal/module_port.h"
 #include "dataconstants.h"
+#include "fifo.h"
 
 void intmoduleStop() {}
 void intmoduleFifoError() {}
@@ -60,12 +61,35 @@ void stop_trainer_module_sbus() {}
 void init_intmodule_heartbeat() {}
 void stop_intmodule_heartbeat() {}
 
-static void* init(void*, const etx_serial_init*) { return (void*)1; }
+// Bytes injected with simuModuleRxPush() are read back from the module RX
+// port, so that they go through the real telemetry protocol parsers
+#define SIMU_MODULE_RX_FIFO_SIZE 16384
+typedef Fifo<uint8_t, SIMU_MODULE_RX_FIFO_SIZE> ModuleRxFifo;
+
+#if defined(HARDWARE_INTERNAL_MODULE)
+static ModuleRxFifo _intmoduleRxFifo;
+#endif
+#if defined(HARDWARE_EXTERNAL_MODULE)
+static ModuleRxFifo _extmoduleRxFifo;
+#endif
+
+static void* init(void* hw_def, const etx_serial_init*)
+{
+  auto fifo = (ModuleRxFifo*)hw_def;
+  fifo->clear();
+  return fifo;
+}
+
 static void deinit(void*) {}
 static void sendByte(void*, uint8_t) {}
 static void sendBuffer(void*, const uint8_t*, uint32_t) {}
 static void waitForTxCompleted(void*) {}
-static int getByte(void*,uint8_t*) { return -1; }
+
+static int getByte(void* ctx, uint8_t* data)
+{
+  auto fifo = (ModuleRxFifo*)ctx;
+  return fifo->pop(*data) ? 1 : 0;
+}
 
 const etx_serial_driver_t _fakeSerialDriver = {
     .init = init,
@@ -77,6 +101,8 @@ const etx_serial_driver_t _fakeSerialDriver = {
     .enableRx = nullptr,
     .getByte = getByte,
     .getLastByte = nullptr,
+    .getRxSpan = nullptr,
+    .consumeRx = nullptr,
     .clearRxBuffer = nullptr,
     .getBaudrate = nullptr,
     .setBaudrate = nullptr,
@@ -110,7 +136,7 @@ const etx_module_port_t _internal_ports[] = {
     .type = ETX_MOD_TYPE_SERIAL,
     .dir_flags = ETX_MOD_DIR_TX_RX | ETX_MOD_FULL_DUPLEX,
     .drv = { .serial = &_fakeSerialDriver },
-    .hw_def = nullptr,
+    .hw_def = &_intmoduleRxFifo,
   },
 #else // INTMODULE_USART
   {
@@ -118,7 +144,7 @@ const etx_module_port_t _internal_ports[] = {
     .type = ETX_MOD_TYPE_SERIAL,
     .dir_flags = ETX_MOD_DIR_TX,
     .drv = { .serial = &_fakeSerialDriver },
-    .hw_def = nullptr,
+    .hw_def = &_intmoduleRxFifo,
   },
 #endif
 #if defined(INTERNAL_MODULE_PXX1)
@@ -127,7 +153,7 @@ const etx_module_port_t _internal_ports[] = {
     .type = ETX_MOD_TYPE_SERIAL,
     .dir_flags = ETX_MOD_DIR_TX | ETX_MOD_DIR_RX,
     .drv = { .serial = &_fakeSerialDriver },
-    .hw_def = nullptr,
+    .hw_def = &_intmoduleRxFifo,
   },
 #endif
 };
@@ -159,7 +185,7 @@ const etx_module_port_t _external_ports[] = {
     .type = ETX_MOD_TYPE_SERIAL,
     .dir_flags = ETX_MOD_DIR_TX_RX | ETX_MOD_FULL_DUPLEX,
     .drv = { .serial = &_fakeSerialDriver },
-    .hw_def = nullptr,
+    .hw_def = &_extmoduleRxFifo,
   },
 #endif
   // Timer output on PPM
@@ -176,7 +202,7 @@ const etx_module_port_t _external_ports[] = {
     .type = ETX_MOD_TYPE_SERIAL,
     .dir_flags = ETX_MOD_DIR_TX,
     .drv = { .serial = &_fakeSerialDriver },
-    .hw_def = nullptr,
+    .hw_def = &_extmoduleRxFifo,
   },
   // TX/RX half-duplex on S.PORT
   {
@@ -184,7 +210,7 @@ const etx_module_port_t _external_ports[] = {
     .type = ETX_MOD_TYPE_SERIAL,
     .dir_flags = ETX_MOD_DIR_TX | ETX_MOD_DIR_RX,
     .drv = { .serial = &_fakeSerialDriver },
-    .hw_def = nullptr,
+    .hw_def = &_extmoduleRxFifo,
   },
 #if defined(TELEMETRY_TIMER)
   // RX soft-serial sampled bit-by-bit via timer IRQ on S.PORT
@@ -193,7 +219,7 @@ const etx_module_port_t _external_ports[] = {
     .type = ETX_MOD_TYPE_SERIAL,
     .dir_flags = ETX_MOD_DIR_RX,
     .drv = { .serial = &_fakeSerialDriver },
-    .hw_def = nullptr,
+    .hw_def = &_extmoduleRxFifo,
   },
 #endif
 };
@@ -222,3 +248,19 @@ BEGIN_MODULES()
   &_sport_module,
 #endif
 END_MODULES()
+
+int simuModuleRxPush(uint8_t module, const uint8_t* data, uint32_t len)
+{
+  auto mod_st = modulePortGetState(module);
+  if (!mod_st || !mod_st->rx.port || !mod_st->rx.ctx ||
+      mod_st->rx.port->type != ETX_MOD_TYPE_SERIAL ||
+      mod_st->rx.port->drv.serial != &_fakeSerialDriver)
+    return -1;
+
+  auto fifo = (ModuleRxFifo*)mod_st->rx.ctx;
+  int count = 0;
+  while ((uint32_t)count < len && !fifo->isFull()) {
+    fifo->push(data[count++]);
+  }
+  return count;
+}
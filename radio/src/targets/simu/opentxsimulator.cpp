@@ -23,6 +23,11 @@
 #include "opentx.h"
 #include "simulcd.h"
 #include "switches.h"
+#include "mixer_profiler.h"
+
+#if defined(COLORLCD)
+  #include "LvglWrapper.h"
+#endif
 
 #include "hal/adc_driver.h"
 #include "hal/rotary_encoder.h"
@@ -210,6 +215,14 @@ uint8_t * OpenTxSimulator::getLcd()
   return (uint8_t *)simuLcdBuf;
 }
 
+QRect OpenTxSimulator::getLcdDirtyRect()
+{
+  int x, y, w, h;
+  if (!simuLcdGetDirtyRect(x, y, w, h))
+    return QRect();
+  return QRect(x, y, w, h);
+}
+
 void OpenTxSimulator::setAnalogValue(uint8_t index, int16_t value)
 {
   static int dim = DIM(g_anas);
@@ -422,6 +435,20 @@ void OpenTxSimulator::sendTelemetry(const QByteArray data)
                               data.count());
 }
 
+// Raw bytes received from a module: they are fed to the RX port of the first
+// module with one open (external first), and parsed by its protocol driver
+void OpenTxSimulator::sendTelemetryStream(const QByteArray data)
+{
+  for (int module = NUM_MODULES - 1; module >= 0; module--) {
+    int count = simuModuleRxPush(module, (const uint8_t *)data.constData(), data.size());
+    if (count < 0)
+      continue;
+    if (count < data.size())
+      ETXS_DBG << "telemetry stream overflow, dropped" << data.size() - count << "bytes";
+    return;
+  }
+}
+
 uint8_t OpenTxSimulator::getSensorInstance(uint16_t id, uint8_t defaultValue)
 {
   for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
@@ -535,6 +562,7 @@ void OpenTxSimulator::run()
 
   if (!(loops % (SIMULATOR_INTERFACE_HEARTBEAT_PERIOD / 10))) {
     emit heartbeat(loops, simuTimerMicros() / 1000);
+    checkPerformanceStats();
   }
 }
 
@@ -560,6 +588,36 @@ bool OpenTxSimulator::checkLcdChanged()
   return false;
 }
 
+void OpenTxSimulator::checkPerformanceStats()
+{
+  for (uint8_t stage = 0; stage < MIXER_STAGE_COUNT; stage++) {
+    MixerStageStats stats;
+    mixerProfilerGetStats(stage, stats);
+    if (stage > MIXER_STAGE_TOTAL && !stats.max)
+      continue;  // latencies are only measured with the matching sticks / modules
+    emit performanceStat(QString("Mixer %1").arg(mixerProfilerStageNames[stage]), stats.p50, stats.p99, stats.max);
+  }
+
+#if defined(LUA)
+  // Lua scripts are only timed as a whole, in 10ms units
+  emit performanceStat("Lua", -1, -1, maxLuaDuration * 10000);
+#endif
+
+#if defined(SIMU_AUDIO)
+  // sound queued ahead of the host audio device (underruns are traced)
+  uint8_t buffers;
+  uint32_t underruns;
+  simuAudioGetStats(buffers, underruns);
+  emit performanceStat("Audio buffers", -1, -1, buffers * AUDIO_BUFFER_DURATION * 1000);
+#endif
+
+#if defined(COLORLCD)
+  // frame rendering time is binned by 1ms
+  auto lvgl = LvglWrapper::instance();
+  emit performanceStat("Render", -1, lvgl->getFrameTimeP99() * 1000, lvgl->getFrameTimeMax() * 1000);
+#endif
+}
+
 void OpenTxSimulator::checkOutputsChanged()
 {
   static TxOutputs lastOutputs;
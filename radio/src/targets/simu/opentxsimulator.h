@@ -53,6 +53,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual bool isRunning();
     virtual void readRadioData(QByteArray & dest);
     virtual uint8_t * getLcd();
+    virtual QRect getLcdDirtyRect();
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0);
     virtual uint16_t getSensorRatio(uint16_t id);
     virtual const int getCapability(Capability cap);
@@ -79,6 +80,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual void lcdFlushed();
     virtual void setTrainerTimeout(uint16_t ms);
     virtual void sendTelemetry(const QByteArray data);
+    virtual void sendTelemetryStream(const QByteArray data);
     virtual void setLuaStateReloadPermanentScripts();
     virtual void addTracebackDevice(QIODevice * device);
     virtual void removeTracebackDevice(QIODevice * device);
@@ -92,6 +94,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     void setStopRequested(bool stop);
     bool checkLcdChanged();
     void checkOutputsChanged();
+    void checkPerformanceStats();
     uint8_t getStickMode();
     const char * getPhaseName(unsigned int phase);
     const QString getCurrentPhaseName();
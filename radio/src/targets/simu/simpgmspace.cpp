@@ -66,8 +66,26 @@ extern const etx_hal_adc_driver_t simu_adc_driver;
 
 void lcdCopy(void * dest, void * src);
 
+static bool simuVirtualClock = false;
+static uint64_t simuVirtualMicros = 0;
+
+void simuSetVirtualClock(bool enabled)
+{
+  simuVirtualMicros = 0;
+  simuVirtualClock = enabled;
+}
+
+void simuAdvanceClock(uint32_t us)
+{
+  simuVirtualMicros += us;
+}
+
 uint64_t simuTimerMicros(void)
 {
+  if (simuVirtualClock) {
+    return simuVirtualMicros;
+  }
+
 #if SIMPGMSPC_USE_QT
   static QElapsedTimer ticker;
   if (!ticker.isValid())
@@ -255,8 +273,17 @@ struct SimulatorAudio {
   int leftoverLen;
   bool threadRunning;
   pthread_t threadPid;
+  uint8_t minBuffers;       // one period of the host audio device
+  uint8_t buffers;          // buffers filled ahead
+  bool lastFull;            // last callback was filled with sound
+  bool starved;             // last callback ran out of sound
+  uint16_t sinceUnderrun;   // callbacks with sound since the last underrun
+  uint32_t underruns;
 } simuAudio;
 
+// callbacks without underrun before the buffering is reduced again
+#define SIMU_AUDIO_SHRINK_DELAY   500
+
 bool simuIsRunning()
 {
   return simu_running;
@@ -301,24 +328,54 @@ void copyBuffer(uint8_t * dest, const uint16_t * buff, unsigned int samples)
   }
 }
 
+// The sound stopping for one callback and going on afterwards means
+// that the buffers underran: more of them are then filled ahead
+void updateAudioBuffering(bool gotData, bool filled)
+{
+  if (gotData && simuAudio.starved) {
+    simuAudio.underruns++;
+    simuAudio.sinceUnderrun = 0;
+    if (simuAudio.buffers < AUDIO_BUFFER_COUNT) {
+      audioQueue.buffersFifo.setFillLimit(++simuAudio.buffers);
+    }
+    TRACE_SIMPGMSPACE("audio underrun #%u, %u buffers", simuAudio.underruns, simuAudio.buffers);
+  }
+  else if (gotData && ++simuAudio.sinceUnderrun >= SIMU_AUDIO_SHRINK_DELAY) {
+    simuAudio.sinceUnderrun = 0;
+    if (simuAudio.buffers > simuAudio.minBuffers) {
+      audioQueue.buffersFifo.setFillLimit(--simuAudio.buffers);
+    }
+  }
+
+  simuAudio.starved = (gotData && !filled) || (!gotData && simuAudio.lastFull);
+  simuAudio.lastFull = gotData && filled;
+}
+
 void fillAudioBuffer(void *udata, Uint8 *stream, int len)
 {
   SDL_memset(stream, 0, len);
+  bool gotData = false;
 
   if (simuAudio.leftoverLen) {
+    gotData = true;
     int len1 = min(len/2, simuAudio.leftoverLen);
     copyBuffer(stream, simuAudio.leftoverData, len1);
     len -= len1*2;
     stream += len1*2;
     simuAudio.leftoverLen -= len1;
     // putchar('l');
-    if (simuAudio.leftoverLen) return;		// buffer fully filled
+    if (simuAudio.leftoverLen) {
+      // buffer fully filled
+      updateAudioBuffering(true, true);
+      return;
+    }
   }
 
   if (audioQueue.buffersFifo.filledAtleast(len/(AUDIO_BUFFER_SIZE*2)+1) ) {
     while(true) {
       const AudioBuffer * nextBuffer = audioQueue.buffersFifo.getNextFilledBuffer();
       if (nextBuffer) {
+        gotData = true;
         if (len >= nextBuffer->size*2) {
           copyBuffer(stream, nextBuffer->data, nextBuffer->size);
           stream += nextBuffer->size*2;
@@ -343,6 +400,8 @@ void fillAudioBuffer(void *udata, Uint8 *stream, int len)
     }
   }
 
+  updateAudioBuffering(gotData, len == 0);
+
   //fill the rest of buffer with silence
   if (len > 0) {
     SDL_memset(stream, 0x8000, len);  // make sure this is silence.
@@ -350,6 +409,12 @@ void fillAudioBuffer(void *udata, Uint8 *stream, int len)
   }
 }
 
+void simuAudioGetStats(uint8_t & buffers, uint32_t & underruns)
+{
+  buffers = simuAudio.buffers;
+  underruns = simuAudio.underruns;
+}
+
 void * audioThread(void *)
 {
   /*
@@ -368,7 +433,7 @@ void * audioThread(void *)
   wanted.freq = AUDIO_SAMPLE_RATE;
   wanted.format = AUDIO_S16SYS;
   wanted.channels = 1;    /* 1 = mono, 2 = stereo */
-  wanted.samples = AUDIO_BUFFER_SIZE*2;  /* Good low-latency value for callback */
+  wanted.samples = AUDIO_BUFFER_SIZE;  /* one radio buffer (10ms) per callback */
   wanted.callback = fillAudioBuffer;
   wanted.userdata = nullptr;
 
@@ -380,6 +445,13 @@ void * audioThread(void *)
     fprintf(stderr, "Couldn't open audio: %s\n", SDL_GetError());
     return nullptr;
   }
+
+  // enough buffers for one callback to start with
+  simuAudio.minBuffers = min<int>(have.samples / AUDIO_BUFFER_SIZE + 1, AUDIO_BUFFER_COUNT);
+  simuAudio.buffers = simuAudio.minBuffers;
+  audioQueue.buffersFifo.setFillLimit(simuAudio.buffers);
+  TRACE_SIMPGMSPACE("audio: %d samples per callback, %u buffers", have.samples, simuAudio.buffers);
+
   SDL_PauseAudio(0);
 
   while (simuAudio.threadRunning) {
@@ -393,6 +465,10 @@ void * audioThread(void *)
 void startAudioThread(int volumeGain)
 {
   simuAudio.leftoverLen = 0;
+  simuAudio.lastFull = false;
+  simuAudio.starved = false;
+  simuAudio.sinceUnderrun = 0;
+  simuAudio.underruns = 0;
   simuAudio.threadRunning = true;
   simuAudio.volumeGain = volumeGain;
   TRACE_SIMPGMSPACE("startAudioThread(%d)", volumeGain);
@@ -574,6 +650,8 @@ void disableSpeaker()
 #endif
 
 int trainerModuleSbusGetByte(unsigned char*) { return 0; }
+uint32_t trainerModuleSbusGetRxSpan(const uint8_t**) { return 0; }
+void trainerModuleSbusConsumeRx(uint32_t) {}
 
 void rtcInit()
 {
@@ -613,6 +691,8 @@ static const etx_serial_driver_t _fake_drv = {
   .enableRx = nullptr,
   .getByte = _fake_drv_get_byte,
   .getLastByte = nullptr,
+  .getRxSpan = nullptr,
+  .consumeRx = nullptr,
   .clearRxBuffer = nullptr,
   .getBaudrate = nullptr,
   .setBaudrate = nullptr,
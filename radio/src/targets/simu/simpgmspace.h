@@ -46,12 +46,22 @@ extern char * main_thread_error;
 
 
 uint64_t simuTimerMicros(void);
+
+// Run on a virtual clock which only moves with simuAdvanceClock()
+// (headless batch runs, faster than real-time)
+void simuSetVirtualClock(bool enabled);
+void simuAdvanceClock(uint32_t us);
 uint8_t simuSleep(uint32_t ms);  // returns true if thread shutdown requested
 
 void simuSetKey(uint8_t key, bool state);
 void simuSetTrim(uint8_t trim, bool state);
 void simuSetSwitch(uint8_t swtch, int8_t state);
 
+// Feed raw bytes to the module RX port, as if received from the module.
+// Returns the number of bytes accepted (the RX FIFO may be full),
+// or -1 if the module has no serial RX port open.
+int simuModuleRxPush(uint8_t module, const uint8_t* data, uint32_t len);
+
 #if defined(__cplusplus)
 void simuInit();
 void simuStart(bool tests = true, const char * sdPath = nullptr, const char * settingsPath = nullptr);
@@ -63,6 +73,8 @@ void stopEepromThread();
 #if defined(SIMU_AUDIO)
   void startAudioThread(int volumeGain = 10);
   void stopAudioThread(void);
+  // buffers filled ahead and number of underruns since the start
+  void simuAudioGetStats(uint8_t & buffers, uint32_t & underruns);
 #else
   #define startAudioThread(dummy)
   #define stopAudioThread()
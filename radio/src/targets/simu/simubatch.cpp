@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+// Headless batch runner: steps the firmware on a virtual clock, as fast
+// as the host allows, from a scripted input trace, and writes the output
+// channels as CSV.
+//
+// Trace format, one event per line ('#' starts a comment):
+//
+//   <time ms> <input>=<value> [<input>=<value> ...]
+//
+// with input one of:
+//   a<n>   analog input n (-1024..1024)
+//   s<n>   switch n (-1, 0, 1)
+//   tr<n>  trainer channel n (-512..512)
+//   t<n>   telemetry sensor n (1-based), in the sensor unit and precision
+
+#include "opentx.h"
+#include "switches.h"
+#include "mixer_scheduler.h"
+#include "tasks/mixer_task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <unistd.h>
+
+static int16_t batchAnalogs[MAX_ANALOG_INPUTS];
+
+uint16_t simu_get_analog(uint8_t idx)
+{
+  return batchAnalogs[idx] * 2 + 2048;
+}
+
+static bool applyInput(const char * name, long value)
+{
+  char * end;
+
+  if (!strncmp(name, "tr", 2)) {
+    long idx = strtol(name + 2, &end, 10);
+    if (*end || idx < 0 || idx >= MAX_TRAINER_CHANNELS) return false;
+    trainerInput[idx] = limit<long>(-512, value, 512);
+    trainerInputValidityTimer = TRAINER_IN_VALID_TIMEOUT;
+    return true;
+  }
+
+  long idx = strtol(name + 1, &end, 10);
+  if (*end || idx < 0) return false;
+
+  switch (name[0]) {
+    case 'a':
+      if (idx >= MAX_ANALOG_INPUTS) return false;
+      batchAnalogs[idx] = limit<long>(-1024, value, 1024);
+      return true;
+
+    case 's':
+      if (idx >= switchGetMaxSwitches()) return false;
+      simuSetSwitch(idx, limit<long>(-1, value, 1));
+      return true;
+
+    case 't':
+      if (idx < 1 || idx > MAX_TELEMETRY_SENSORS) return false;
+      {
+        const TelemetrySensor & sensor = g_model.telemetrySensors[idx - 1];
+        telemetryItems[idx - 1].setValue(sensor, value, sensor.unit,
+                                         sensor.prec);
+      }
+      return true;
+  }
+
+  return false;
+}
+
+struct TraceReader {
+  FILE * file;
+  unsigned line;
+  long time;      // ms, time of the pending events (-1 at the end)
+  char buffer[512];
+
+  // read the next line with events
+  void next()
+  {
+    char * p;
+    do {
+      if (!fgets(buffer, sizeof(buffer), file)) {
+        time = -1;
+        return;
+      }
+      line++;
+      if ((p = strchr(buffer, '#'))) *p = '\0';
+      p = buffer + strspn(buffer, " \t\r\n");
+    } while (!*p);
+
+    char * end;
+    long t = strtol(p, &end, 10);
+    if (end == p || t < time) {
+      fprintf(stderr, "trace:%u: invalid or decreasing time\n", line);
+      exit(EXIT_FAILURE);
+    }
+    time = t;
+    memmove(buffer, end, strlen(end) + 1);
+  }
+
+  void apply()
+  {
+    for (char * tok = strtok(buffer, " \t\r\n"); tok;
+         tok = strtok(nullptr, " \t\r\n")) {
+      char * eq = strchr(tok, '=');
+      if (eq) *eq = '\0';
+      if (!eq || !applyInput(tok, strtol(eq + 1, nullptr, 10))) {
+        fprintf(stderr, "trace:%u: invalid input '%s'\n", line, tok);
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+};
+
+static void printHeader(uint8_t channels, bool switches, bool timers)
+{
+  printf("time");
+  for (uint8_t i = 0; i < channels; i++) printf(",CH%d", i + 1);
+  if (switches) printf(",LS");
+  if (timers) {
+    for (uint8_t i = 0; i < TIMERS; i++) printf(",T%d", i + 1);
+  }
+  printf("\n");
+}
+
+static void printOutputs(uint32_t ms, uint8_t channels, bool switches,
+                         bool timers)
+{
+  MixerOutputSnapshot outputs;
+  mixerGetOutputSnapshot(&outputs);
+
+  printf("%u", ms);
+  for (uint8_t i = 0; i < channels; i++) {
+    printf(",%d", outputs.channelOutputs[i]);
+  }
+  if (switches) {
+    uint64_t mask = 0;
+    for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+      if (getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i)) mask |= (uint64_t)1 << i;
+    }
+    printf(",%llx", (unsigned long long)mask);
+  }
+  if (timers) {
+    for (uint8_t i = 0; i < TIMERS; i++) printf(",%d", (int)timersStates[i].val);
+  }
+  printf("\n");
+}
+
+static void usage(const char * name)
+{
+  fprintf(stderr,
+          "usage: %s [-s sd_path] [-r settings_path] [-d duration_ms]\n"
+          "          [-p output_period_ms] [-n channels] [-l] [-t]\n"
+          "          model_file [trace_file]\n"
+          "  -l  add the logical switches (hex mask)\n"
+          "  -t  add the timers\n",
+          name);
+  exit(EXIT_FAILURE);
+}
+
+int main(int argc, char ** argv)
+{
+  const char * sdPath = nullptr;
+  const char * settingsPath = nullptr;
+  long duration = -1;
+  long outputPeriod = 10;
+  long channels = 16;
+  bool switches = false;
+  bool timers = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "s:r:d:p:n:lt")) != -1) {
+    switch (opt) {
+      case 's': sdPath = optarg; break;
+      case 'r': settingsPath = optarg; break;
+      case 'd': duration = atol(optarg); break;
+      case 'p': outputPeriod = atol(optarg); break;
+      case 'n': channels = atol(optarg); break;
+      case 'l': switches = true; break;
+      case 't': timers = true; break;
+      default: usage(argv[0]);
+    }
+  }
+  if (optind >= argc || outputPeriod <= 0 || channels <= 0 ||
+      channels > MAX_OUTPUT_CHANNELS)
+    usage(argv[0]);
+
+  TraceReader trace = {stdin, 0, 0, ""};
+  if (optind + 1 < argc) {
+    trace.file = fopen(argv[optind + 1], "r");
+    if (!trace.file) {
+      perror(argv[optind + 1]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (duration < 0 && trace.file == stdin && isatty(fileno(stdin)))
+    usage(argv[0]);
+
+  simuInit();
+  simuSetVirtualClock(true);
+  simuFatfsSetPaths(sdPath, settingsPath);
+  g_tmr10ms = 1;
+
+#if defined(LIBOPENUI)
+  lcdInitDisplayDriver();
+#endif
+#if !defined(COLORLCD)
+  menuLevel = 0;
+#endif
+
+  if (!storageReadRadioSettings(false)) {
+    generalDefault();
+  }
+  postRadioSettingsLoad();
+
+  char modelFile[LEN_MODEL_FILENAME + 1];
+  strAppend(modelFile, argv[optind], LEN_MODEL_FILENAME);
+  const char * error = loadModel(modelFile, false);
+  if (error) {
+    fprintf(stderr, "%s: %s\n", argv[optind], error);
+    return EXIT_FAILURE;
+  }
+
+  printHeader(channels, switches, timers);
+
+  const uint32_t period = getMixerSchedulerPeriod();
+  uint64_t now = 0;
+  uint64_t next10ms = 10000;
+  uint64_t nextOutput = 0;
+
+  trace.next();
+  while (duration >= 0 ? now <= (uint64_t)duration * 1000 : trace.time >= 0) {
+    while (trace.time >= 0 && (uint64_t)trace.time * 1000 <= now) {
+      trace.apply();
+      trace.next();
+    }
+
+    mixerRunCycle();
+
+    if (now >= nextOutput) {
+      printOutputs(now / 1000, channels, switches, timers);
+      nextOutput += outputPeriod * 1000;
+    }
+
+    now += period;
+    simuAdvanceClock(period);
+    while (now >= next10ms) {
+      per10ms();
+      next10ms += 10000;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
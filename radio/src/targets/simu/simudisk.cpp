@@ -211,7 +211,7 @@ void sdInit(void)
     sdGetFreeSectors();
 
 #if defined(LOG_TELEMETRY)
-    f_open(&g_telemetryFile, LOGS_PATH "/telemetry.log", FA_OPEN_ALWAYS | FA_WRITE);
+    f_open(&g_telemetryFile, LOGS_PATH "/telemetry.bin", FA_OPEN_ALWAYS | FA_WRITE);
     if (f_size(&g_telemetryFile) > 0) {
       f_lseek(&g_telemetryFile, f_size(&g_telemetryFile)); // append
     }
@@ -255,7 +255,7 @@ void sdMount()
     sdGetFreeSectors();
 
 #if defined(LOG_TELEMETRY)
-    f_open(&g_telemetryFile, LOGS_PATH "/telemetry.log", FA_OPEN_ALWAYS | FA_WRITE);
+    f_open(&g_telemetryFile, LOGS_PATH "/telemetry.bin", FA_OPEN_ALWAYS | FA_WRITE);
     if (f_size(&g_telemetryFile) > 0) {
       f_lseek(&g_telemetryFile, f_size(&g_telemetryFile)); // append
     }
@@ -180,9 +180,22 @@ std::string convertFromSimuPath(const char * path)
   return result;
 }
 
-typedef std::map<std::string, std::string> filemap_t;
+// Directory listings used to find files case insensitively, kept until
+// the directory changes (entries added, removed or renamed), so that the
+// SD card is not listed again on each lookup or simulator restart
+struct DirectoryIndex
+{
+  time_t mtime = 0;
+  time_t scanned = 0;
+  std::map<std::string, std::string> files;  // lower case path -> real path
+};
+
+typedef std::map<std::string, DirectoryIndex> dirindex_t;
+
+dirindex_t directoryIndex;
 
-filemap_t fileMap;
+// some host file systems only keep the mtime to 2s
+#define DIRECTORY_INDEX_MIN_AGE    2
 
 void splitPath(const std::string & path, std::string & dir, std::string & name)
 {
@@ -264,28 +277,50 @@ std::vector<std::string> listDirectoryFiles(const std::string & dirName)
   return result;
 }
 
+std::string toLowerCase(std::string str)
+{
+  std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+  return str;
+}
+
+const DirectoryIndex * indexDirectory(const std::string & dirName)
+{
+  std::string statName = removeTrailingPathDelimiter(dirName);
+  struct stat tmp;
+  if (stat(statName.empty() ? dirName.c_str() : statName.c_str(), &tmp)) {
+    directoryIndex.erase(dirName);
+    return nullptr;
+  }
+
+  DirectoryIndex & index = directoryIndex[dirName];
+  if (index.scanned && index.mtime == tmp.st_mtime &&
+      index.scanned - index.mtime >= DIRECTORY_INDEX_MIN_AGE) {
+    return &index;
+  }
+
+  // new or changed directory, or changed too recently to trust its mtime
+  index.mtime = tmp.st_mtime;
+  index.scanned = time(nullptr);
+  index.files.clear();
+  for (const auto & file : listDirectoryFiles(dirName)) {
+    index.files[toLowerCase(file)] = file;
+  }
+  // TRACE_SIMPGMSPACE("indexDirectory(%s): %d files", dirName.c_str(), index.files.size());
+  return &index;
+}
+
 std::string findTrueFileName(const std::string & path)
 {
   // TRACE_SIMPGMSPACE("findTrueFileName(%s)", path.c_str());
-  std::string result;
-  filemap_t::iterator i = fileMap.find(path);
-  if (i != fileMap.end()) {
-    result = i->second;
-    // TRACE_SIMPGMSPACE("\tfound in map: %s", result.c_str());
-    return result;
-  }
-  else {
-    //find file and add to map
-    std::string dirName;
-    std::string fileName;
-    splitPath(path, dirName, fileName);
-    std::vector<std::string> files = listDirectoryFiles(dirName);
-    for(unsigned int i=0; i<files.size(); ++i) {
-      if (!strcasecmp(files[i].c_str(), path.c_str())) {
-        // TRACE_SIMPGMSPACE("\tfound: %s", files[i].c_str());
-        fileMap.insert(filemap_t::value_type(path, files[i]));
-        return files[i];
-      }
+  std::string dirName;
+  std::string fileName;
+  splitPath(path, dirName, fileName);
+  const DirectoryIndex * index = indexDirectory(dirName);
+  if (index) {
+    auto i = index->files.find(toLowerCase(path));
+    if (i != index->files.end()) {
+      // TRACE_SIMPGMSPACE("\tfound: %s", i->second.c_str());
+      return i->second;
     }
   }
   TRACE_SIMPGMSPACE("\tnot found");
@@ -398,6 +433,12 @@ UINT f_size(FIL* fil)
   return 0;
 }
 
+FRESULT f_expand (FIL* fil, FSIZE_t size, BYTE opt)
+{
+  // the host file system allocates its own clusters
+  return FR_OK;
+}
+
 FRESULT f_close (FIL * fil)
 {
   TRACE_SIMPGMSPACE("f_close(%p) (FIL:%p)", fil->obj.fs, fil);
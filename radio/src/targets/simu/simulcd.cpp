@@ -23,10 +23,42 @@
 #include "simulcd.h"
 #include "rtos.h"
 #include <string.h>
+#include <algorithm>
+#include <mutex>
 #include <utility>
 
 bool simuLcdRefresh = false;
 
+// Bounding box of the areas redrawn since the last simuLcdGetDirtyRect(),
+// so that the simulator only converts what changed
+static std::mutex _dirtyMutex;
+static int _dirty_x1 = LCD_W, _dirty_y1 = LCD_H, _dirty_x2 = -1, _dirty_y2 = -1;
+
+static void simuLcdMarkDirty(int x1, int y1, int x2, int y2)
+{
+  std::lock_guard<std::mutex> lock(_dirtyMutex);
+  _dirty_x1 = std::min(_dirty_x1, std::max(x1, 0));
+  _dirty_y1 = std::min(_dirty_y1, std::max(y1, 0));
+  _dirty_x2 = std::max(_dirty_x2, std::min(x2, LCD_W - 1));
+  _dirty_y2 = std::max(_dirty_y2, std::min(y2, LCD_H - 1));
+}
+
+bool simuLcdGetDirtyRect(int& x, int& y, int& w, int& h)
+{
+  std::lock_guard<std::mutex> lock(_dirtyMutex);
+  if (_dirty_x2 < _dirty_x1 || _dirty_y2 < _dirty_y1)
+    return false;
+
+  x = _dirty_x1;
+  y = _dirty_y1;
+  w = _dirty_x2 - _dirty_x1 + 1;
+  h = _dirty_y2 - _dirty_y1 + 1;
+  _dirty_x1 = LCD_W;
+  _dirty_y1 = LCD_H;
+  _dirty_x2 = _dirty_y2 = -1;
+  return true;
+}
+
 void toplcdOff() {}
 
 #if !defined(lcdOff)
@@ -41,10 +73,11 @@ void lcdInit() {}
 
 void lcdRefresh()
 {
+  memcpy(simuLcdBuf, displayBuf, DISPLAY_BUFFER_SIZE * sizeof(pixel_t));
+
   // Mark screen dirty for async refresh
+  simuLcdMarkDirty(0, 0, LCD_W - 1, LCD_H - 1);
   simuLcdRefresh = true;
-
-  memcpy(simuLcdBuf, displayBuf, DISPLAY_BUFFER_SIZE * sizeof(pixel_t));
 }
 
 #else
@@ -138,6 +171,16 @@ static void _copy_area(uint16_t* dst, uint16_t* src, const rect_t& copy_area)
 pixel_t* simuLcdBuf = nullptr;
 #endif
 
+static void _mark_refreshed_areas()
+{
+  lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+  for(int i = 0; i < disp->inv_p; i++) {
+    if(disp->inv_area_joined[i]) continue;
+    const lv_area_t& area = disp->inv_areas[i];
+    simuLcdMarkDirty(area.x1, area.y1, area.x2, area.y2);
+  }
+}
+
 static void simuRefreshLcd(lv_disp_drv_t * disp_drv, uint16_t *buffer, const rect_t& copy_area)
 {
 #if !defined(LCD_VERTICAL_INVERT) // rename into "Use direct mode" ???
@@ -147,6 +190,7 @@ static void simuRefreshLcd(lv_disp_drv_t * disp_drv, uint16_t *buffer, const rec
   simuLcdBuf = buffer;
 
   // Trigger async refresh
+  _mark_refreshed_areas();
   simuLcdRefresh = true;
 
 #else
@@ -165,6 +209,7 @@ static void simuRefreshLcd(lv_disp_drv_t * disp_drv, uint16_t *buffer, const rec
     }
 
     // Trigger async refresh
+    _mark_refreshed_areas();
     simuLcdRefresh = true;
 
     // Copy refreshed & rotated areas into new back buffer
@@ -225,6 +270,25 @@ void DMAFillRect(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
   }
 }
 
+void DMABlendRect(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
+                  uint16_t y, uint16_t w, uint16_t h, uint16_t color,
+                  uint8_t opacity)
+{
+  RGB_SPLIT(color, red, green, blue);
+  uint16_t bgWeight = 255 - opacity;
+
+  for (int i = 0; i < h; i++) {
+    uint16_t *p = dest + (y + i) * destw + x;
+    for (int j = 0; j < w; j++, p++) {
+      RGB_SPLIT(*p, bgRed, bgGreen, bgBlue);
+      uint16_t r = (bgRed * bgWeight + red * opacity) / 255;
+      uint16_t g = (bgGreen * bgWeight + green * opacity) / 255;
+      uint16_t b = (bgBlue * bgWeight + blue * opacity) / 255;
+      *p = RGB_JOIN(r, g, b);
+    }
+  }
+}
+
 void DMACopyBitmap(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
                    uint16_t y, const uint16_t *src, uint16_t srcw,
                    uint16_t srch, uint16_t srcx, uint16_t srcy, uint16_t w,
@@ -28,6 +28,9 @@
 extern int g_snapshot_idx;
 extern bool simuLcdRefresh;
 
+// Returns the region changed since the previous call (false if none)
+bool simuLcdGetDirtyRect(int& x, int& y, int& w, int& h);
+
 #if defined(COLORLCD)
 extern pixel_t* simuLcdBuf;
 #else
@@ -116,6 +116,20 @@ uint32_t switchState(uint8_t pos)
   }
 }
 
+uint64_t switchSampleInputs()
+{
+  static int8_t previousStates[n_total_switches] = { 0 };
+  uint64_t changed = 0;
+  for (uint8_t i = 0; i < n_total_switches; i++) {
+    if (switchesStates[i] != previousStates[i] ||
+        _hw_switch_defs[i].type == SWITCH_HW_ADC) {
+      previousStates[i] = switchesStates[i];
+      changed |= (uint64_t)1 << i;
+    }
+  }
+  return changed;
+}
+
 SwitchHwPos switchGetPosition(uint8_t idx)
 {
   assert(idx < n_total_switches);
@@ -79,6 +79,7 @@ enum {
 void unlockFlash();
 void lockFlash();
 void flashWrite(uint32_t * address, const uint32_t * buffer);
+uint32_t flashSectorSize(uint32_t address); // 0 if not a sector start
 uint32_t isFirmwareStart(const uint8_t * buffer);
 uint32_t isBootloaderStart(const uint8_t * buffer);
 
@@ -21,6 +21,7 @@
 
 #include "board.h"
 #include "debug.h"
+#include "event_trace.h"
 #include "FatFs/diskio.h"
 #include "FatFs/ff.h"
 
@@ -670,6 +671,7 @@ DRESULT disk_read (
 {
   if (drv || !count) return RES_PARERR;
   if (Stat & STA_NOINIT) return RES_NOTRDY;
+  EVENT_TRACE_SCOPE(EVENT_TRACE_SD_READ_BEGIN, EVENT_TRACE_SD_READ_END, count);
   int8_t res = SD_ReadSectors(buff, sector, count);
   TRACE_SD_CARD_EVENT((res != 0), sd_disk_read, (count << 24) + (sector & 0x00FFFFFF));
   return (res != 0) ? RES_ERROR : RES_OK;
@@ -725,6 +727,8 @@ DRESULT disk_write (
   if (drv || !count) return RES_PARERR;
   if (Stat & STA_NOINIT) return RES_NOTRDY;
   if (Stat & STA_PROTECT) return RES_WRPRT;
+  EVENT_TRACE_SCOPE(EVENT_TRACE_SD_WRITE_BEGIN, EVENT_TRACE_SD_WRITE_END,
+                    count);
   int8_t res = SD_WriteSectors(buff, sector, count);
   TRACE_SD_CARD_EVENT((res != 0), sd_disk_write, (count << 24) + (sector & 0x00FFFFFF));
   return (res != 0) ? RES_ERROR : RES_OK;
@@ -2797,8 +2797,10 @@
   #define BT_USART                      USART3
   #define BT_USART_IRQHandler           USART3_IRQHandler
   #define BT_USART_IRQn                 USART3_IRQn
-  // #define BT_DMA_Stream_RX              DMA1_Stream1
-  // #define BT_DMA_Channel_RX             DMA_Channel_4
+  // USART3 RX, same stream as AUX_SERIAL (BT replaces it)
+  #define BT_USART_RX_DMA               DMA1
+  #define BT_USART_RX_DMA_STREAM        LL_DMA_STREAM_1
+  #define BT_USART_RX_DMA_CHANNEL       LL_DMA_CHANNEL_4
 #else
   #if defined(PCBX9D) || defined(PCBX9DP) || defined(RADIO_FAMILY_JUMPER_T12) || defined(RADIO_TX12) || defined(RADIO_TX12MK2)|| defined(RADIO_BOXER) || defined(RADIO_T8) || defined(RADIO_COMMANDO8) || defined(RADIO_ZORRO)
     // To avoid change in modelsize, todo: remove me
@@ -49,6 +49,27 @@
 bool lcdInitFinished = false;
 void lcdInitFinish();
 
+// Unchanged parts of the frame are not sent again, but everything is resent
+// every LCD_FULL_REFRESH_FRAMES frames in case the controller lost some data
+#define LCD_FULL_REFRESH_FRAMES        64
+static uint8_t lcdFramesToFullRefresh = 0;
+
+#if LCD_W == 128
+// What the controller shows, one LCD_W bytes page per 8 rows
+static uint8_t lcdSentBuf[LCD_W * LCD_H / 8];
+#else
+static uint32_t lcdSentHash;
+
+static uint32_t lcdFrameHash(const uint8_t * p, uint32_t len)
+{
+  uint32_t hash = 2166136261u;  // FNV-1a
+  while (len--) {
+    hash = (hash ^ *p++) * 16777619u;
+  }
+  return hash;
+}
+#endif
+
 void lcdWriteCommand(uint8_t byte)
 {
   LCD_A0_LOW();
@@ -204,7 +225,43 @@ volatile bool lcd_busy;
 #if !defined(LCD_DUAL_BUFFER)
 void lcdRefreshWait()
 {
+#if LCD_W != 128
+  // the DMA reads displayBuf
   WAIT_FOR_DMA_END();
+#endif
+}
+#endif
+
+#if LCD_W == 128
+// Pages of lcdSentBuf still to be sent, the DMA interrupt chains them
+static volatile uint8_t lcdPagesToSend;
+
+static void lcdSendPage(uint8_t y)
+{
+  lcdWriteCommand(0x10); // Column addr 0
+  lcdWriteCommand(0xB0 | y); // Page addr y
+#if !defined(LCD_VERTICAL_INVERT)
+  lcdWriteCommand(0x04);
+#endif
+
+  LCD_NCS_LOW();
+  LCD_A0_HIGH();
+
+  LCD_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
+  LCD_DMA->HIFCR = LCD_DMA_FLAGS; // Write ones to clear bits
+  LCD_DMA_Stream->M0AR = (uint32_t)&lcdSentBuf[y * LCD_W];
+  LCD_DMA_Stream->CR |= DMA_SxCR_EN | DMA_SxCR_TCIE; // Enable DMA & TC interrupts
+  LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
+}
+
+static bool lcdSendNextPage()
+{
+  uint8_t pages = lcdPagesToSend;
+  if (!pages) return false;
+
+  lcdPagesToSend = pages & (pages - 1);
+  lcdSendPage(__builtin_ctz(pages));
+  return true;
 }
 #endif
 
@@ -214,36 +271,40 @@ void lcdRefresh(bool wait)
     lcdInitFinish();
   }
 
+  bool fullRefresh = (lcdFramesToFullRefresh == 0);
+  lcdFramesToFullRefresh = fullRefresh ? LCD_FULL_REFRESH_FRAMES - 1
+                                       : lcdFramesToFullRefresh - 1;
+
 #if LCD_W == 128
-  uint8_t * p = displayBuf;
+  // lcdSentBuf is the front buffer: once the changed pages are copied,
+  // the UI can draw the next frame into displayBuf while they are sent
+  WAIT_FOR_DMA_END();
+
+  uint8_t pages = 0;
+  uint8_t * p = lcdSentBuf;
+  const uint8_t * q = displayBuf;
+  for (uint8_t y=0; y < 8; y++, p+=LCD_W, q+=LCD_W) {
+    if (!fullRefresh && !memcmp(p, q, LCD_W)) continue;
+    memcpy(p, q, LCD_W);
+    pages |= 1 << y;
+  }
+  if (!pages) return;
+
 #if defined(LCD_W_OFFSET)
   lcdWriteCommand(LCD_W_OFFSET);
 #endif
-  for (uint8_t y=0; y < 8; y++, p+=LCD_W) {
-    lcdWriteCommand(0x10); // Column addr 0
-    lcdWriteCommand(0xB0 | y); // Page addr y
-#if !defined(LCD_VERTICAL_INVERT)
-    lcdWriteCommand(0x04);
-#endif
-
-    LCD_NCS_LOW();
-    LCD_A0_HIGH();
-
-    lcd_busy = true;
-    LCD_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
-    LCD_DMA->HIFCR = LCD_DMA_FLAGS; // Write ones to clear bits
-    LCD_DMA_Stream->M0AR = (uint32_t)p;
-    LCD_DMA_Stream->CR |= DMA_SxCR_EN | DMA_SxCR_TCIE; // Enable DMA & TC interrupts
-    LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
-
-    WAIT_FOR_DMA_END();
-
-    LCD_NCS_HIGH();
-    LCD_A0_HIGH();
-  }
+  lcd_busy = true;
+  lcdPagesToSend = pages;
+  lcdSendNextPage();
 #else
   // Wait if previous DMA transfer still active
   WAIT_FOR_DMA_END();
+
+  // the whole frame goes in one transfer: skip it when nothing changed
+  uint32_t hash = lcdFrameHash(displayBuf, DISPLAY_BUFFER_SIZE);
+  if (!fullRefresh && hash == lcdSentHash) return;
+  lcdSentHash = hash;
+
   lcd_busy = true;
 
   lcdWriteAddress(0, 0);
@@ -281,6 +342,10 @@ extern "C" void LCD_DMA_Stream_IRQHandler()
     */
   }
   LCD_NCS_HIGH();
+
+#if LCD_W == 128
+  if (lcdSendNextPage()) return;
+#endif
   lcd_busy = false;
 }
 
@@ -291,6 +356,7 @@ extern "C" void LCD_DMA_Stream_IRQHandler()
 void lcdOff()
 {
   WAIT_FOR_DMA_END();
+  lcdFramesToFullRefresh = 0;
 
   /*
   LCD Sleep mode is also good for draining capacitors and enables us
@@ -341,6 +407,7 @@ void lcdInit()
 void lcdInitFinish()
 {
   lcdInitFinished = true;
+  lcdFramesToFullRefresh = 0;
 
   /*
     LCD needs longer time to initialize in low temperatures. The data-sheet
@@ -378,9 +445,7 @@ void lcdSetRefVolt(uint8_t val)
     lcdInitFinish();
   }
 
-#if LCD_W != 128
   WAIT_FOR_DMA_END();
-#endif
 
   lcdWriteCommand(0x81); // Set Vop
   lcdWriteCommand(val+LCD_CONTRAST_OFFSET); // 0-255
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "task_stats.h"
+#include "event_trace.h"
+
+struct TaskStatsTask {
+  const char * name;
+  const void * tcb;
+  uint32_t runtime;  // cycles in the current window
+  uint16_t load;     // last window, 0.1%
+};
+
+struct TaskStatsIsrData {
+  volatile uint32_t runtime;
+  volatile uint32_t count;
+  uint16_t load;
+  uint32_t lastCount;
+};
+
+static const char * const taskStatsIsrNames[TASK_STATS_ISR_COUNT] = {
+  "serial",
+  "pulses",
+  "audio",
+};
+
+// the last entry accounts for unregistered tasks
+static TaskStatsTask taskStatsTasks[TASK_STATS_MAX_TASKS + 1];
+static uint8_t taskStatsTasksCount = 0;
+static TaskStatsIsrData taskStatsIsrs[TASK_STATS_ISR_COUNT];
+
+static uint8_t taskStatsCurrent = TASK_STATS_MAX_TASKS;
+static int8_t taskStatsIdle = -1;
+static uint32_t taskStatsLastSwitch = 0;
+static uint32_t taskStatsWindowStart = 0;
+static volatile uint32_t taskStatsWindowCount = 0;
+static uint16_t taskStatsCpu = 0;
+
+static uint8_t taskStatsHistory[TASK_STATS_HISTORY];
+static uint8_t taskStatsHistoryLast = 0;
+static uint8_t taskStatsHistoryCount = 0;
+
+void taskStatsRegister(const char * name, const void * tcb)
+{
+  if (taskStatsTasksCount >= TASK_STATS_MAX_TASKS) return;
+  if (!strcmp(name, "idle")) taskStatsIdle = taskStatsTasksCount;
+
+  // fill the entry before it becomes visible to the switch hook
+  auto & t = taskStatsTasks[taskStatsTasksCount];
+  t.name = name;
+  t.tcb = tcb;
+  taskStatsTasksCount++;
+}
+
+static inline uint16_t taskStatsPerMille(uint32_t part, uint32_t total)
+{
+  return min<uint32_t>(1000, ((uint64_t)part * 1000) / total);
+}
+
+static void taskStatsCloseWindow(uint32_t now)
+{
+  uint32_t window = now - taskStatsWindowStart;
+  taskStatsWindowStart = now;
+
+  for (auto & t : taskStatsTasks) {
+    t.load = taskStatsPerMille(t.runtime, window);
+    t.runtime = 0;
+  }
+
+  for (auto & isr : taskStatsIsrs) {
+    isr.load = taskStatsPerMille(isr.runtime, window);
+    isr.runtime = 0;
+    isr.lastCount = isr.count;
+    isr.count = 0;
+  }
+
+  taskStatsCpu = taskStatsIdle >= 0 ? 1000 - taskStatsTasks[taskStatsIdle].load : 0;
+
+  taskStatsHistoryLast = (taskStatsHistoryLast + 1) % TASK_STATS_HISTORY;
+  taskStatsHistory[taskStatsHistoryLast] = (taskStatsCpu + 5) / 10;
+  if (taskStatsHistoryCount < TASK_STATS_HISTORY) taskStatsHistoryCount++;
+
+  taskStatsWindowCount++;
+}
+
+void taskStatsSwitchedIn(const void * tcb)
+{
+  uint32_t now = ticksNow();
+  taskStatsTasks[taskStatsCurrent].runtime += now - taskStatsLastSwitch;
+  taskStatsLastSwitch = now;
+
+  uint8_t idx = 0;
+  while (idx < taskStatsTasksCount && taskStatsTasks[idx].tcb != tcb) idx++;
+  taskStatsCurrent = idx < taskStatsTasksCount ? idx : TASK_STATS_MAX_TASKS;
+  EVENT_TRACE(EVENT_TRACE_TASK_SWITCH, taskStatsCurrent);
+
+  if (now - taskStatsWindowStart >= SYSTEM_TICKS_1MS * 1000) {
+    taskStatsCloseWindow(now);
+  }
+}
+
+uint32_t taskStatsIsrEnter()
+{
+  return ticksNow();
+}
+
+void taskStatsIsrExit(uint8_t isr, uint32_t start)
+{
+  auto & data = taskStatsIsrs[isr];
+  data.runtime += ticksNow() - start;
+  data.count++;
+}
+
+uint8_t taskStatsCount()
+{
+  return taskStatsTasksCount ? taskStatsTasksCount + 1 : 0;
+}
+
+const char * taskStatsName(uint8_t idx)
+{
+  if (idx >= taskStatsTasksCount) return "other";
+  return taskStatsTasks[idx].name;
+}
+
+uint16_t taskStatsLoad(uint8_t idx)
+{
+  if (idx >= taskStatsTasksCount) idx = TASK_STATS_MAX_TASKS;
+  return taskStatsTasks[idx].load;
+}
+
+uint16_t taskStatsIsrLoad(uint8_t isr)
+{
+  return taskStatsIsrs[isr].load;
+}
+
+uint32_t taskStatsIsrCount(uint8_t isr)
+{
+  return taskStatsIsrs[isr].lastCount;
+}
+
+const char * taskStatsIsrName(uint8_t isr)
+{
+  return taskStatsIsrNames[isr];
+}
+
+uint16_t taskStatsCpuLoad()
+{
+  return taskStatsCpu;
+}
+
+bool taskStatsGetHistory(uint8_t idx, uint8_t & load)
+{
+  if (idx >= taskStatsHistoryCount) return false;
+  load = taskStatsHistory[(taskStatsHistoryLast + TASK_STATS_HISTORY - idx) %
+                          TASK_STATS_HISTORY];
+  return true;
+}
+
+uint32_t taskStatsWindows()
+{
+  return taskStatsWindowCount;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Run time accounting of the RTOS tasks and of some interrupts.
+//
+// Time is measured with the CPU cycle counter on each context switch
+// and summed over windows of one second. Interrupt time is also part
+// of the time of the task it interrupted.
+
+#define TASK_STATS_MAX_TASKS    10
+
+// CPU load history, one sample per second
+#define TASK_STATS_HISTORY      120
+
+enum TaskStatsIsr {
+  TASK_STATS_ISR_SERIAL,
+  TASK_STATS_ISR_PULSES,
+  TASK_STATS_ISR_AUDIO,
+  TASK_STATS_ISR_COUNT
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Register a task control block (at task creation)
+void taskStatsRegister(const char * name, const void * tcb);
+
+// Called by the RTOS when 'tcb' starts running (traceTASK_SWITCHED_IN)
+void taskStatsSwitchedIn(const void * tcb);
+
+// Interrupt time estimates: call enter() first thing in the
+// handler and pass its result to exit() right before returning
+uint32_t taskStatsIsrEnter();
+void taskStatsIsrExit(uint8_t isr, uint32_t start);
+
+#ifdef __cplusplus
+}
+
+struct TaskStatsIsrScope {
+  explicit TaskStatsIsrScope(uint8_t isr) :
+    isr(isr), start(taskStatsIsrEnter())
+  {
+  }
+
+  ~TaskStatsIsrScope()
+  {
+    taskStatsIsrExit(isr, start);
+  }
+
+  uint8_t isr;
+  uint32_t start;
+};
+
+// Number of registered tasks, plus one for unknown ones ("other")
+uint8_t taskStatsCount();
+const char * taskStatsName(uint8_t idx);
+
+// Load over the last window, in 0.1% steps
+uint16_t taskStatsLoad(uint8_t idx);
+uint16_t taskStatsIsrLoad(uint8_t isr);
+uint32_t taskStatsIsrCount(uint8_t isr); // calls in the last window
+const char * taskStatsIsrName(uint8_t isr);
+
+// CPU load (everything but idle) over the last window, in 0.1% steps
+uint16_t taskStatsCpuLoad();
+
+// CPU load 'idx' seconds ago, in %, returns false past the history
+bool taskStatsGetHistory(uint8_t idx, uint8_t & load);
+
+// Incremented on each new window (for display refresh)
+uint32_t taskStatsWindows();
+#endif
@@ -24,8 +24,10 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "tasks/storage_task.h"
 
 #include "watchdog_driver.h"
+#include "power_governor.h"
 
 RTOS_TASK_HANDLE menusTaskId;
 RTOS_DEFINE_STACK(menusTaskId, menusStack, MENUS_STACK_SIZE);
@@ -36,6 +38,7 @@ RTOS_DEFINE_STACK(audioTaskId, audioStack, AUDIO_STACK_SIZE);
 RTOS_MUTEX_HANDLE audioMutex;
 
 #define MENU_TASK_PERIOD_TICKS         (50 / RTOS_MS_PER_TICK)    // 50ms
+#define MENU_TASK_SAVE_PERIOD_TICKS    (POWER_SAVE_MENUS_PERIOD_MS / RTOS_MS_PER_TICK)
 
 #if defined(COLORLCD) && defined(CLI)
 bool perMainEnabled = true;
@@ -64,6 +67,12 @@ TASK_FUNCTION(menusTask)
 
   opentxInit();
 
+  // RF first: the mixer runs during the splash and the deferred init
+  START_SILENCE_PERIOD();
+  mixerTaskInit();
+
+  opentxDeferredInit();
+
 #if defined(SPLASH) && !defined(STARTUP_ANIMATION)
   if (waitSplash){
     extern bool inactivityCheckInputs();
@@ -100,8 +109,6 @@ TASK_FUNCTION(menusTask)
   }
 #endif
 
-  mixerTaskInit();
-
 #if defined(PWR_BUTTON_PRESS)
   while (true) {
     uint32_t pwr_check = pwrCheck();
@@ -125,12 +132,15 @@ TASK_FUNCTION(menusTask)
     perMain();
 #endif
     DEBUG_TIMER_STOP(debugTimerPerMain);
+    powerGovernorUpdate();
     // TODO remove completely massstorage from sky9x firmware
     uint32_t runtime = ((uint32_t)RTOS_GET_TIME() - start);
     // deduct the thread run-time from the wait, if run-time was more than
     // desired period, then skip the wait all together
-    if (runtime < MENU_TASK_PERIOD_TICKS) {
-      RTOS_WAIT_TICKS(MENU_TASK_PERIOD_TICKS - runtime);
+    uint32_t period = powerSaveActive() ? MENU_TASK_SAVE_PERIOD_TICKS
+                                        : MENU_TASK_PERIOD_TICKS;
+    if (runtime < period) {
+      RTOS_WAIT_TICKS(period - runtime);
     }
 
     resetForcePowerOffRequest();
@@ -155,6 +165,10 @@ void tasksStart()
   cliStart();
 #endif
 
+#if defined(STORAGE_TASK)
+  storageTaskInit();
+#endif
+
   RTOS_CREATE_TASK(menusTaskId, menusTask, "menus", menusStack,
                    MENUS_STACK_SIZE, MENUS_TASK_PRIO);
 
@@ -34,16 +34,32 @@
 #define AUDIO_STACK_SIZE       400
 #define CLI_STACK_SIZE         1024  // only consumed with CLI build option
 
+#if defined(STORAGE_MODELSLIST) && !defined(SIMU)
+  // model and radio settings are written by a background task
+  #define STORAGE_TASK
+  #define STORAGE_STACK_SIZE   1024
+#endif
+
+#if !defined(SIMU)
+  // telemetry is parsed in its own task, woken up by the RX IRQs
+  #define TELEMETRY_TASK
+  #define TELEMETRY_STACK_SIZE 512
+#endif
+
 #if defined(FREE_RTOS)
 #define MIXER_TASK_PRIO        (tskIDLE_PRIORITY + 4)
 #define AUDIO_TASK_PRIO        (tskIDLE_PRIORITY + 3) // Note: FreeRTOSConfig.h defines software timers as priority 2
+#define TELEMETRY_TASK_PRIO    (tskIDLE_PRIORITY + 2)
 #define MENUS_TASK_PRIO        (tskIDLE_PRIORITY + 1)
 #define CLI_TASK_PRIO          (tskIDLE_PRIORITY + 1)
+#define STORAGE_TASK_PRIO      (tskIDLE_PRIORITY) // below menus, SD writes must not hold off the UI
 #else
 #define MIXER_TASK_PRIO        (4)
 #define AUDIO_TASK_PRIO        (2)
+#define TELEMETRY_TASK_PRIO    (2)
 #define MENUS_TASK_PRIO        (1)
 #define CLI_TASK_PRIO          (1)
+#define STORAGE_TASK_PRIO      (0)
 #endif
 
 
@@ -55,6 +71,14 @@ extern TaskStack<AUDIO_STACK_SIZE> audioStack;
 extern TaskStack<CLI_STACK_SIZE> cliStack;
 #endif
 
+#if defined(STORAGE_TASK)
+extern TaskStack<STORAGE_STACK_SIZE> storageStack;
+#endif
+
+#if defined(TELEMETRY_TASK)
+extern TaskStack<TELEMETRY_STACK_SIZE> telemetryStack;
+#endif
+
 void tasksStart();
 
 extern volatile uint16_t timeForcePowerOffPressed;
@@ -22,12 +22,19 @@
 #include "tasks.h"
 #include "mixer_task.h"
 #include "mixer_scheduler.h"
+#include "mixer_profiler.h"
+#include "module_timing.h"
+#include "ext_input.h"
+#include "event_trace.h"
 
 #include "opentx.h"
 #include "switches.h"
+#include "hal/adc_driver.h"
 
 #include "watchdog_driver.h"
 
+#include <atomic>
+
 RTOS_TASK_HANDLE mixerTaskId;
 RTOS_DEFINE_STACK(mixerTaskId, mixerStack, MIXER_STACK_SIZE);
 
@@ -95,6 +102,63 @@ bool mixerTaskRunning()
   return _mixer_running && !_mixer_exit;
 }
 
+// Double buffered seqlock: the mixer writes the buffer readers are not
+// pointing to and publishes it by incrementing the sequence. A reader
+// only has to retry if the sequence moved while it was copying.
+static MixerOutputSnapshot outputSnapshots[2];
+static std::atomic<uint32_t> outputSnapshotSeq;
+
+static void mixerPublishOutputs()
+{
+  uint32_t seq = outputSnapshotSeq.load(std::memory_order_relaxed);
+  MixerOutputSnapshot& snapshot = outputSnapshots[(seq + 1) & 1];
+
+  // order the writes below after the previous publication
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(snapshot.channelOutputs, channelOutputs, sizeof(snapshot.channelOutputs));
+  memcpy(snapshot.ex_chans, ex_chans, sizeof(snapshot.ex_chans));
+  outputSnapshotSeq.store(seq + 1, std::memory_order_release);
+}
+
+void mixerGetOutputSnapshot(MixerOutputSnapshot* snapshot)
+{
+  uint32_t seq;
+  do {
+    seq = outputSnapshotSeq.load(std::memory_order_acquire);
+    memcpy(snapshot, &outputSnapshots[seq & 1], sizeof(MixerOutputSnapshot));
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while (outputSnapshotSeq.load(std::memory_order_relaxed) != seq);
+}
+
+int16_t mixerGetChannelOutput(uint8_t channel)
+{
+  uint32_t seq;
+  int16_t value;
+  do {
+    seq = outputSnapshotSeq.load(std::memory_order_acquire);
+    value = outputSnapshots[seq & 1].channelOutputs[channel];
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while (outputSnapshotSeq.load(std::memory_order_relaxed) != seq);
+  return value;
+}
+
+int16_t mixerGetMixOutput(uint8_t channel)
+{
+  uint32_t seq;
+  int16_t value;
+  do {
+    seq = outputSnapshotSeq.load(std::memory_order_acquire);
+    value = outputSnapshots[seq & 1].ex_chans[channel];
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while (outputSnapshotSeq.load(std::memory_order_relaxed) != seq);
+  return value;
+}
+
+uint32_t mixerGetCycleCount()
+{
+  return outputSnapshotSeq.load(std::memory_order_acquire);
+}
+
 volatile uint16_t timeForcePowerOffPressed = 0;
 
 bool isForcePowerOffRequested()
@@ -121,15 +185,14 @@ constexpr uint8_t MIXER_MAX_PERIOD = MAX_REFRESH_RATE / 1000 /*ms*/;
 
 void execMixerFrequentActions()
 {
+  // PPM trainer edges captured since the last run
+  processTrainerPulses();
+
 #if defined(SBUS_TRAINER)
   // SBUS trainer
   processSbusInput();
 #endif
 
-#if defined(IMU)
-  gyro.wakeup();
-#endif
-
 #if defined(BLUETOOTH)
   bluetooth.wakeup();
 #endif
@@ -164,6 +227,12 @@ TASK_FUNCTION(mixerTask)
       }
     }
 
+    uint8_t dueModules = mixerSchedulerTakeDueModules();
+    if (timeout >= MIXER_MAX_PERIOD) {
+      // no trigger came in time: run everything
+      dueModules = MIXER_SCHEDULER_DUE_ALL;
+    }
+
 #if defined(DEBUG_MIXER_SCHEDULER)
     GPIO_SetBits(EXTMODULE_TX_GPIO, EXTMODULE_TX_GPIO_PIN);
     GPIO_ResetBits(EXTMODULE_TX_GPIO, EXTMODULE_TX_GPIO_PIN);
@@ -189,12 +258,29 @@ TASK_FUNCTION(mixerTask)
 
       uint16_t t0 = getTmr2MHz();
 
+      EVENT_TRACE(EVENT_TRACE_MIXER_BEGIN, dueModules);
       DEBUG_TIMER_START(debugTimerMixer);
       mixerTaskLock();
 
-      doMixerCalculations();
-      pulsesSendChannels();
-      doMixerPeriodicUpdates();
+      bool mixesDue = dueModules & MIXER_SCHEDULER_DUE_MIXES;
+      if (mixesDue) {
+        doMixerCalculations();
+      }
+
+      uint16_t t1 = getTmr2MHz();
+      pulsesSendChannels(dueModules);
+      t1 = mixerProfilerStep(MIXER_STAGE_PULSES, t1);
+      if (mixesDue) {
+#if defined(STM32) && !defined(SIMU)
+        // report the new channels before the slow periodic updates
+        if (getSelectedUsbMode() == USB_JOYSTICK_MODE) {
+          usbJoystickUpdate();
+        }
+#endif
+        doMixerPeriodicUpdates();
+        mixerProfilerStep(MIXER_STAGE_PERIODIC, t1);
+        mixerPublishOutputs();
+      }
 
       // TODO: what are these for???
       DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
@@ -202,10 +288,13 @@ TASK_FUNCTION(mixerTask)
 
       mixerTaskUnlock();
       DEBUG_TIMER_STOP(debugTimerMixer);
+      EVENT_TRACE(EVENT_TRACE_MIXER_END, 0);
 
-#if defined(STM32) && !defined(SIMU)
-      if (getSelectedUsbMode() == USB_JOYSTICK_MODE) {
-        usbJoystickUpdate();
+#if defined(IMU)
+      // once the frame is sent, so that the I2C transfer does not delay
+      // the next trigger: the new samples are used by the next cycle
+      if (mixesDue) {
+        gyro.wakeup();
       }
 #endif
 
@@ -214,6 +303,7 @@ TASK_FUNCTION(mixerTask)
       WDG_RESET();
 
       t0 = getTmr2MHz() - t0;
+      mixerProfilerRecord(MIXER_STAGE_TOTAL, t0);
       if (t0 > maxMixerDuration)
         maxMixerDuration = t0;
     }
@@ -222,6 +312,17 @@ TASK_FUNCTION(mixerTask)
   TASK_RETURN();
 }
 
+#if defined(SIMU)
+void mixerRunCycle()
+{
+  mixerTaskLock();
+  doMixerCalculations();
+  doMixerPeriodicUpdates();
+  mixerPublishOutputs();
+  mixerTaskUnlock();
+}
+#endif
+
 void doMixerCalculations()
 {
   static tmr10ms_t lastTMR = 0;
@@ -242,15 +343,46 @@ void doMixerCalculations()
   // therefore forget the exact calculation and use only 1 instead; good compromise
   lastTMR = tmr10ms;
 
+  uint16_t t0 = getTmr2MHz();
+  uint16_t sticksTime = t0;
+
+  // time since the previous cycle, only measured while the 2MHz timer
+  // cannot have wrapped around (32ms)
+  static uint16_t lastCycleTime = 0;
+  uint16_t tickUs = (tick10ms <= 2 && s_mixer_first_run_done) ? (uint16_t)(t0 - lastCycleTime) / 2 : 0;
+  lastCycleTime = t0;
+
   DEBUG_TIMER_START(debugTimerGetAdc);
   getADC();
   DEBUG_TIMER_STOP(debugTimerGetAdc);
+  t0 = mixerProfilerStep(MIXER_STAGE_ADC, t0);
+
+  // external inputs are sampled once, all mixes of the cycle use these values
+  extInputSample(RTOS_GET_MS());
+
+  uint32_t sticksAge = adcGetSticksAge();
+  if (sticksAge) {
+    uint16_t ageTicks = min<uint32_t>(sticksAge * 2, UINT16_MAX);
+    mixerProfilerRecord(MIXER_STAGE_STICKS_AGE, ageTicks);
+    sticksTime -= ageTicks;
+  }
+  moduleTimingSticksSampled(sticksTime);
 
   DEBUG_TIMER_START(debugTimerGetSwitches);
   getSwitchesPosition(!s_mixer_first_run_done);
   DEBUG_TIMER_STOP(debugTimerGetSwitches);
+  t0 = mixerProfilerStep(MIXER_STAGE_SWITCHES, t0);
+
+#if defined(LUA)
+  luaShmPopGVars();
+#endif
 
   DEBUG_TIMER_START(debugTimerEvalMixes);
-  evalMixes(tick10ms);
+  evalMixes(tick10ms, tickUs);
   DEBUG_TIMER_STOP(debugTimerEvalMixes);
+
+#if defined(LUA)
+  luaShmPushSources();
+#endif
+  mixerProfilerStep(MIXER_STAGE_EVAL_MIXES, t0);
 }
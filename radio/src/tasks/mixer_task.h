@@ -20,6 +20,7 @@
  */
 
 #include "rtos.h"
+#include "dataconstants.h"
 
 // needed by the mixer scheduler
 extern RTOS_TASK_HANDLE mixerTaskId;
@@ -78,3 +79,28 @@ void mixerTaskUnlock();
 // returns true if the lock could be acquired
 bool mixerTaskTryLock();
 
+#if defined(SIMU)
+// run one mixer cycle synchronously (mixes and periodic updates,
+// no pulses), for headless runs driven by a virtual clock
+void mixerRunCycle();
+#endif
+
+// outputs of one complete mixer cycle
+struct MixerOutputSnapshot {
+  int16_t channelOutputs[MAX_OUTPUT_CHANNELS];
+  int16_t ex_chans[MAX_OUTPUT_CHANNELS];
+};
+
+// copy the outputs published at the end of the last mixer cycle
+//
+// Please note: this never blocks the mixer. The copy is retried
+//              if the mixer published while it was running.
+//
+void mixerGetOutputSnapshot(MixerOutputSnapshot* snapshot);
+
+// one value of the outputs published at the end of the last mixer cycle
+int16_t mixerGetChannelOutput(uint8_t channel);  // channelOutputs
+int16_t mixerGetMixOutput(uint8_t channel);      // ex_chans
+
+// number of mixer cycles completed since boot
+uint32_t mixerGetCycleCount();
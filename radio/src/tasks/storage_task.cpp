@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "tasks.h"
+#include "storage_task.h"
+
+#include "opentx.h"
+#include "storage/sdcard_yaml.h"
+
+#if defined(STORAGE_TASK)
+
+RTOS_TASK_HANDLE storageTaskId;
+RTOS_DEFINE_STACK(storageTaskId, storageStack, STORAGE_STACK_SIZE);
+
+#define STORAGE_TASK_PERIOD_TICKS      (20 / RTOS_MS_PER_TICK)    // 20ms
+
+// held while the staging buffers are being filled or written
+static RTOS_MUTEX_HANDLE storageMutex;
+
+static ModelData stagedModel;
+static char stagedModelFilename[LEN_MODEL_FILENAME + 1];
+static RadioData stagedRadio;
+
+static volatile uint8_t stagedMsk = 0;
+static volatile uint8_t writtenMsk = 0;
+
+// must be called with the staging lock held
+static uint8_t storageWriteStaged()
+{
+  uint8_t msk = stagedMsk;
+
+  if (msk & EE_GENERAL) {
+    TRACE("storage task: write general");
+    const char* error = writeGeneralSettingsYaml(&stagedRadio);
+    if (error) {
+      TRACE("writeGeneralSettings error=%s", error);
+    }
+  }
+
+  if (msk & EE_MODEL) {
+    TRACE("storage task: write model");
+    const char* error = writeModelYaml(stagedModelFilename, &stagedModel);
+    if (error) {
+      TRACE("writeModel error=%s", error);
+    }
+  }
+
+  stagedMsk = 0;
+  return msk;
+}
+
+TASK_FUNCTION(storageTask)
+{
+  while (true) {
+    RTOS_WAIT_TICKS(STORAGE_TASK_PERIOD_TICKS);
+
+    if (stagedMsk) {
+      RTOS_LOCK_MUTEX(storageMutex);
+      writtenMsk |= storageWriteStaged();
+      RTOS_UNLOCK_MUTEX(storageMutex);
+    }
+  }
+
+  TASK_RETURN();
+}
+
+void storageTaskInit()
+{
+  RTOS_CREATE_MUTEX(storageMutex);
+  RTOS_CREATE_TASK(storageTaskId, storageTask, "storage", storageStack,
+                   STORAGE_STACK_SIZE, STORAGE_TASK_PRIO);
+}
+
+uint8_t storageTaskStage(uint8_t msk)
+{
+  msk &= (EE_GENERAL | EE_MODEL);
+  if (!msk || !RTOS_TRYLOCK_MUTEX(storageMutex)) {
+    return 0;
+  }
+
+  // a previous copy not written yet is simply replaced
+  if (msk & EE_GENERAL) {
+    g_eeGeneral.manuallyEdited = false;
+    memcpy(&stagedRadio, &g_eeGeneral, sizeof(stagedRadio));
+  }
+
+  if (msk & EE_MODEL) {
+    if ((stagedMsk & EE_MODEL) &&
+        strncmp(stagedModelFilename, g_eeGeneral.currModelFilename,
+                LEN_MODEL_FILENAME)) {
+      // another model is still waiting to be written
+      msk &= ~EE_MODEL;
+    } else {
+      memcpy(&stagedModel, &g_model, sizeof(stagedModel));
+      strncpy(stagedModelFilename, g_eeGeneral.currModelFilename,
+              LEN_MODEL_FILENAME);
+      stagedModelFilename[LEN_MODEL_FILENAME] = '\0';
+    }
+  }
+
+  stagedMsk |= msk;
+  RTOS_UNLOCK_MUTEX(storageMutex);
+
+  return msk;
+}
+
+uint8_t storageTaskFlush()
+{
+  RTOS_LOCK_MUTEX(storageMutex);
+  uint8_t msk = storageWriteStaged() | writtenMsk;
+  writtenMsk = 0;
+  RTOS_UNLOCK_MUTEX(storageMutex);
+  return msk;
+}
+
+uint8_t storageTaskWritten()
+{
+  if (!writtenMsk || !RTOS_TRYLOCK_MUTEX(storageMutex)) {
+    return 0;
+  }
+
+  uint8_t msk = writtenMsk;
+  writtenMsk = 0;
+  RTOS_UNLOCK_MUTEX(storageMutex);
+  return msk;
+}
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// The storage task writes the model and the radio settings in the
+// background: storageCheck() copies the dirty data into a staging buffer
+// and returns, so that slow SD card writes do not stall the UI.
+
+// create the staging lock and start the task
+void storageTaskInit();
+
+// Copy the dirty parts of 'msk' (EE_GENERAL / EE_MODEL) into the staging
+// buffer. Returns the parts that were taken: nothing is taken while the
+// previous write is still in progress, the data will simply be picked up
+// on a later call (repeated changes are coalesced this way).
+uint8_t storageTaskStage(uint8_t msk);
+
+// Write whatever is still staged from the calling task and return once the
+// storage task is idle. Returns the parts (EE_GENERAL / EE_MODEL) written.
+uint8_t storageTaskFlush();
+
+// Returns the parts written by the storage task since the last call
+uint8_t storageTaskWritten();
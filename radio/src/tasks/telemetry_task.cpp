@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "tasks.h"
+#include "telemetry_task.h"
+
+#include "opentx.h"
+#include "hal/module_port.h"
+#include "event_trace.h"
+
+#if defined(TELEMETRY_TASK)
+
+RTOS_TASK_HANDLE telemetryTaskId;
+RTOS_DEFINE_STACK(telemetryTaskId, telemetryStack, TELEMETRY_STACK_SIZE);
+
+// ports without RX idle IRQ and periodic checks still need polling
+#define TELEMETRY_TASK_PERIOD_MS       2
+
+static bool telemetryTaskStarted = false;
+static volatile bool telemetryRunning = false;
+
+TASK_FUNCTION(telemetryTask)
+{
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TELEMETRY_TASK_PERIOD_MS));
+
+    if (telemetryRunning) {
+      DEBUG_TIMER_START(debugTimerTelemetryWakeup);
+      telemetryWakeup();
+      DEBUG_TIMER_STOP(debugTimerTelemetryWakeup);
+    }
+  }
+
+  TASK_RETURN();
+}
+
+void telemetryTaskNotifyFromISR()
+{
+  if (!telemetryRunning) return;
+  EVENT_TRACE(EVENT_TRACE_TELEMETRY_RX, 0);
+
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(telemetryTaskId.rtos_handle,
+                         &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+void telemetryStart()
+{
+  if (!telemetryTaskStarted) {
+    telemetryTaskStarted = true;
+    RTOS_CREATE_TASK(telemetryTaskId, telemetryTask, "telemetry",
+                     telemetryStack, TELEMETRY_STACK_SIZE,
+                     TELEMETRY_TASK_PRIO);
+    modulePortSetRxIdleCb(telemetryTaskNotifyFromISR);
+  }
+
+  telemetryRunning = true;
+}
+
+void telemetryStop()
+{
+  telemetryRunning = false;
+}
+
+#endif
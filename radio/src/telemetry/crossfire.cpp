@@ -22,6 +22,7 @@
 #include "crossfire.h"
 
 #include "opentx.h"
+#include "crossfire_params.h"
 
 const CrossfireSensor crossfireSensors[] = {
   {LINK_ID,        0, STR_SENSOR_RX_RSSI1,      UNIT_DB,                0},
@@ -119,6 +120,9 @@ void processCrossfireTelemetryFrame(uint8_t module)
     moduleState[module].counter = CRSF_FRAME_MODELID;
   }
 
+  // parameter frames go to the native browser while it is open
+  if (crossfireParamsProcessFrame(module, rxBuffer, rxBufferCount)) return;
+
   uint8_t crsfPayloadLen = rxBuffer[1];
   uint8_t id = rxBuffer[2];
   int32_t value;
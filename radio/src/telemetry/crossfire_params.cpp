@@ -0,0 +1,699 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "crossfire.h"
+#include "crossfire_params.h"
+
+enum CrossfireFieldState {
+  FIELD_NEEDED,
+  FIELD_READING,
+  FIELD_DONE,
+  FIELD_FAILED,
+};
+
+struct CrossfireField {
+  uint8_t state;
+  uint8_t size;  // 0 until read (or loaded from the cache)
+  uint8_t data[CRSF_PARAM_MAX_SIZE];
+};
+
+// field read in flight, its chunks are collected here
+struct CrossfireRead {
+  uint8_t field;  // 0 when unused
+  uint8_t chunk;
+  uint8_t retries;
+  bool send;
+  tmr10ms_t deadline;
+  uint8_t size;
+  uint8_t data[CRSF_PARAM_MAX_SIZE];
+};
+
+struct CrossfireParamsState {
+  uint8_t module;
+  uint8_t devicesCount;
+  CrossfireDevice devices[CRSF_PARAMS_MAX_DEVICES];
+  uint8_t address;  // selected device
+  uint8_t fieldsCount;
+  CrossfireField fields[CRSF_PARAMS_MAX_FIELDS];  // fields 1..fieldsCount
+  CrossfireRead reads[CRSF_PARAMS_IN_FLIGHT];
+  uint8_t write[1 + 4];  // field and value
+  uint8_t writeSize;
+  uint8_t commandField;  // command in progress, polled
+  tmr10ms_t commandDeadline;
+  tmr10ms_t nextPing;
+};
+
+// Only allocated while the browser is open
+static CrossfireParamsState * state = nullptr;
+static RTOS_MUTEX_HANDLE paramsMutex;
+static bool paramsMutexCreated = false;
+static uint16_t structureRevision = 0;
+static uint16_t valuesRevision = 0;
+
+struct CrossfireCacheHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t fieldsCount;
+  uint8_t paramsVersion;
+  uint8_t reserved;
+};
+
+#define CRSF_CACHE_VERSION  1
+
+static int32_t getBigEndian(const uint8_t * data, uint8_t size, bool isSigned)
+{
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < size; i++) {
+    value = (value << 8) + data[i];
+  }
+  if (isSigned && size < 4 && (value & (1u << (8 * size - 1)))) {
+    value |= ~0u << (8 * size);
+  }
+  return (int32_t)value;
+}
+
+static const char * getString(const uint8_t * & ptr, const uint8_t * end)
+{
+  const char * result = (const char *)ptr;
+  while (ptr < end && *ptr) ptr++;
+  if (ptr >= end) return nullptr;
+  ptr++;
+  return result;
+}
+
+bool crossfireParamDecode(uint8_t id, const uint8_t * data, uint8_t size,
+                          CrossfireParam & param)
+{
+  memclear(&param, sizeof(param));
+  if (size < 3) return false;
+
+  const uint8_t * end = data + size;
+  param.id = id;
+  param.parent = data[0];
+  param.type = data[1] & 0x7F;
+  param.hidden = data[1] & 0x80;
+
+  const uint8_t * ptr = data + 2;
+  param.name = getString(ptr, end);
+  if (!param.name) return false;
+
+  switch (param.type) {
+    case CRSF_UINT8:
+    case CRSF_INT8:
+    case CRSF_UINT16:
+    case CRSF_INT16:
+    case CRSF_UINT32:
+    case CRSF_INT32:
+    {
+      uint8_t width = 1 << (param.type / 2);
+      bool isSigned = param.type & 1;
+      if (ptr + 4 * width > end) return false;
+      param.value = getBigEndian(ptr, width, isSigned);
+      param.min = getBigEndian(ptr + width, width, isSigned);
+      param.max = getBigEndian(ptr + 2 * width, width, isSigned);
+      ptr += 4 * width;  // default value skipped
+      param.unit = getString(ptr, end);
+      break;
+    }
+
+    case CRSF_FLOAT:
+      if (ptr + 21 > end) return false;
+      param.value = getBigEndian(ptr, 4, true);
+      param.min = getBigEndian(ptr + 4, 4, true);
+      param.max = getBigEndian(ptr + 8, 4, true);
+      param.prec = ptr[16];
+      param.step = getBigEndian(ptr + 17, 4, true);
+      ptr += 21;
+      param.unit = getString(ptr, end);
+      break;
+
+    case CRSF_TEXT_SELECTION:
+      param.options = getString(ptr, end);
+      if (!param.options || ptr + 4 > end) return false;
+      param.value = ptr[0];
+      param.min = ptr[1];
+      param.max = ptr[2];
+      ptr += 4;
+      param.unit = getString(ptr, end);
+      break;
+
+    case CRSF_STRING:
+    case CRSF_INFO:
+      param.text = getString(ptr, end);
+      if (!param.text) return false;
+      break;
+
+    case CRSF_COMMAND:
+      if (ptr + 2 > end) return false;
+      param.value = ptr[0];
+      param.timeout = ptr[1];
+      ptr += 2;
+      param.text = getString(ptr, end);
+      break;
+
+    default:
+      break;
+  }
+
+  return true;
+}
+
+const char * crossfireParamOption(const CrossfireParam & param, int index,
+                                  char * buffer, uint8_t size)
+{
+  buffer[0] = '\0';
+  const char * option = param.options;
+  if (!option) return buffer;
+
+  for (; index > 0 && *option; option++) {
+    if (*option == ';') index--;
+  }
+
+  uint8_t len = 0;
+  while (option[len] && option[len] != ';' && len < size - 1) {
+    buffer[len] = option[len];
+    len++;
+  }
+  buffer[len] = '\0';
+  return buffer;
+}
+
+static bool pushFrame(uint8_t command, uint8_t destination,
+                      const uint8_t * payload, uint8_t size)
+{
+  if (!outputTelemetryBuffer.isAvailable()) return false;
+
+  outputTelemetryBuffer.pushByte(MODULE_ADDRESS);
+  outputTelemetryBuffer.pushByte(4 + size);  // command, addresses, payload and CRC
+  outputTelemetryBuffer.pushByte(command);
+  outputTelemetryBuffer.pushByte(destination);
+  outputTelemetryBuffer.pushByte(RADIO_ADDRESS);
+  for (uint8_t i = 0; i < size; i++) {
+    outputTelemetryBuffer.pushByte(payload[i]);
+  }
+  outputTelemetryBuffer.pushByte(crc8(outputTelemetryBuffer.data + 2, 3 + size));
+
+  uint8_t endpoint = 0;
+#if defined(HARDWARE_EXTERNAL_MODULE)
+  if (state->module == EXTERNAL_MODULE) endpoint = TELEMETRY_ENDPOINT_SPORT;
+#endif
+  outputTelemetryBuffer.setDestination(endpoint);
+  return true;
+}
+
+void crossfireParamsStart(uint8_t module)
+{
+  if (!paramsMutexCreated) {
+    RTOS_CREATE_MUTEX(paramsMutex);
+    paramsMutexCreated = true;
+  }
+
+  crossfireParamsStop();
+
+  auto params = (CrossfireParamsState *)malloc(sizeof(CrossfireParamsState));
+  if (!params) return;
+  memclear(params, sizeof(CrossfireParamsState));
+  params->module = module;
+  params->nextPing = get_tmr10ms();
+
+  RTOS_LOCK_MUTEX(paramsMutex);
+  state = params;
+  structureRevision++;
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+}
+
+void crossfireParamsStop()
+{
+  if (!paramsMutexCreated) return;
+
+  RTOS_LOCK_MUTEX(paramsMutex);
+  auto params = state;
+  state = nullptr;
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+
+  free(params);
+}
+
+bool crossfireParamsActive()
+{
+  return state != nullptr;
+}
+
+uint8_t crossfireParamsDevicesCount()
+{
+  return state ? state->devicesCount : 0;
+}
+
+bool crossfireParamsGetDevice(uint8_t index, CrossfireDevice & device)
+{
+  bool result = false;
+  RTOS_LOCK_MUTEX(paramsMutex);
+  if (state && index < state->devicesCount) {
+    device = state->devices[index];
+    result = true;
+  }
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+  return result;
+}
+
+static CrossfireDevice * findDevice(uint8_t address)
+{
+  for (uint8_t i = 0; i < state->devicesCount; i++) {
+    if (state->devices[i].address == address) return &state->devices[i];
+  }
+  return nullptr;
+}
+
+static void getCacheFilename(char * path, const CrossfireDevice & device)
+{
+  sprintf(path, CRSF_PARAMS_CACHE_PATH "/%08X%08X.bin",
+          (unsigned)device.serial, (unsigned)device.swVersion);
+}
+
+static void loadCache(const CrossfireDevice & device)
+{
+  char path[sizeof(CRSF_PARAMS_CACHE_PATH) + 22];
+  getCacheFilename(path, device);
+
+  FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK) return;
+
+  CrossfireCacheHeader header;
+  UINT read;
+  if (f_read(&file, &header, sizeof(header), &read) == FR_OK &&
+      read == sizeof(header) && !memcmp(header.magic, "CRSF", 4) &&
+      header.version == CRSF_CACHE_VERSION &&
+      header.fieldsCount == device.fieldsCount &&
+      header.paramsVersion == device.paramsVersion) {
+    uint8_t record[2];
+    uint8_t data[CRSF_PARAM_MAX_SIZE];
+    while (f_read(&file, record, sizeof(record), &read) == FR_OK &&
+           read == sizeof(record) && record[1] < CRSF_PARAM_MAX_SIZE &&
+           f_read(&file, data, record[1], &read) == FR_OK &&
+           read == record[1]) {
+      RTOS_LOCK_MUTEX(paramsMutex);
+      if (state && record[0] >= 1 && record[0] <= state->fieldsCount) {
+        auto & field = state->fields[record[0] - 1];
+        // still read again for the current values
+        if (field.size == 0) {
+          memcpy(field.data, data, record[1]);
+          field.size = record[1];
+        }
+      }
+      RTOS_UNLOCK_MUTEX(paramsMutex);
+    }
+    TRACE("CRSF parameters of %s loaded from %s", device.name, path);
+  }
+
+  f_close(&file);
+}
+
+void crossfireParamsSaveCache()
+{
+  CrossfireDevice device;
+  RTOS_LOCK_MUTEX(paramsMutex);
+  const CrossfireDevice * selected = state ? findDevice(state->address) : nullptr;
+  if (selected) device = *selected;
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+  if (!selected) return;
+
+  if (sdCheckAndCreateDirectory(CRSF_PARAMS_CACHE_PATH)) return;
+
+  char path[sizeof(CRSF_PARAMS_CACHE_PATH) + 22];
+  getCacheFilename(path, device);
+
+  FIL file;
+  if (f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) return;
+
+  CrossfireCacheHeader header = {{'C', 'R', 'S', 'F'}, CRSF_CACHE_VERSION,
+                                 device.fieldsCount, device.paramsVersion, 0};
+  UINT written;
+  f_write(&file, &header, sizeof(header), &written);
+
+  // one field at a time, not to hold the telemetry task while writing
+  uint8_t record[2 + CRSF_PARAM_MAX_SIZE];
+  for (uint8_t id = 1; id <= device.fieldsCount; id++) {
+    record[1] = 0;
+    RTOS_LOCK_MUTEX(paramsMutex);
+    if (state && id <= state->fieldsCount) {
+      const auto & field = state->fields[id - 1];
+      record[0] = id;
+      record[1] = field.size;
+      memcpy(&record[2], field.data, field.size);
+    }
+    RTOS_UNLOCK_MUTEX(paramsMutex);
+    if (record[1] > 0) {
+      f_write(&file, record, 2 + record[1], &written);
+    }
+  }
+
+  f_close(&file);
+}
+
+void crossfireParamsSelectDevice(uint8_t address)
+{
+  CrossfireDevice device;
+  bool found = false;
+
+  RTOS_LOCK_MUTEX(paramsMutex);
+  if (state) {
+    auto selected = findDevice(address);
+    if (selected) {
+      device = *selected;
+      found = true;
+      state->address = address;
+      state->fieldsCount = min<uint8_t>(device.fieldsCount, CRSF_PARAMS_MAX_FIELDS);
+      memclear(state->fields, sizeof(state->fields));
+      memclear(state->reads, sizeof(state->reads));
+      state->writeSize = 0;
+      state->commandField = 0;
+    }
+  }
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+
+  if (found) {
+    loadCache(device);
+    structureRevision++;
+  }
+}
+
+uint8_t crossfireParamsFieldsCount()
+{
+  return state ? state->fieldsCount : 0;
+}
+
+uint8_t crossfireParamsFieldsLoaded()
+{
+  uint8_t result = 0;
+  RTOS_LOCK_MUTEX(paramsMutex);
+  if (state) {
+    for (uint8_t i = 0; i < state->fieldsCount; i++) {
+      if (state->fields[i].state >= FIELD_DONE) result++;
+    }
+  }
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+  return result;
+}
+
+bool crossfireParamsGetField(uint8_t field, CrossfireParam & param,
+                             uint8_t (&buffer)[CRSF_PARAM_MAX_SIZE])
+{
+  uint8_t size = 0;
+  RTOS_LOCK_MUTEX(paramsMutex);
+  if (state && field >= 1 && field <= state->fieldsCount) {
+    size = state->fields[field - 1].size;
+    memcpy(buffer, state->fields[field - 1].data, size);
+  }
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+
+  if (size == 0) return false;
+  buffer[size] = '\0';
+  return crossfireParamDecode(field, buffer, size, param);
+}
+
+// The values of a field may change others (packet rate and telemetry
+// ratio for example), all of them are read again
+static void readAllFields()
+{
+  for (uint8_t i = 0; i < state->fieldsCount; i++) {
+    if (state->fields[i].state != FIELD_READING)
+      state->fields[i].state = FIELD_NEEDED;
+  }
+}
+
+void crossfireParamsWrite(uint8_t field, const uint8_t * value, uint8_t size)
+{
+  if (size > sizeof(state->write) - 1) return;
+
+  RTOS_LOCK_MUTEX(paramsMutex);
+  if (state) {
+    state->write[0] = field;
+    memcpy(&state->write[1], value, size);
+    state->writeSize = 1 + size;
+    readAllFields();
+  }
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+}
+
+void crossfireParamsWriteValue(const CrossfireParam & param, int32_t value)
+{
+  uint8_t size;
+  switch (param.type) {
+    case CRSF_UINT8:
+    case CRSF_INT8:
+    case CRSF_TEXT_SELECTION:
+      size = 1;
+      break;
+    case CRSF_UINT16:
+    case CRSF_INT16:
+      size = 2;
+      break;
+    case CRSF_UINT32:
+    case CRSF_INT32:
+    case CRSF_FLOAT:
+      size = 4;
+      break;
+    default:
+      return;
+  }
+
+  uint8_t data[4];
+  for (uint8_t i = 0; i < size; i++) {
+    data[i] = value >> (8 * (size - 1 - i));
+  }
+  crossfireParamsWrite(param.id, data, size);
+}
+
+void crossfireParamsCommand(const CrossfireParam & param, uint8_t status)
+{
+  crossfireParamsWrite(param.id, &status, 1);
+}
+
+uint16_t crossfireParamsStructureRevision()
+{
+  return structureRevision;
+}
+
+uint16_t crossfireParamsValuesRevision()
+{
+  return valuesRevision;
+}
+
+static void sendReads(tmr10ms_t now)
+{
+  // timeouts
+  for (auto & read : state->reads) {
+    if (read.field && !read.send && (int32_t)(now - read.deadline) >= 0) {
+      if (++read.retries > CRSF_PARAMS_RETRIES) {
+        TRACE("CRSF field %d not read", read.field);
+        state->fields[read.field - 1].state = FIELD_FAILED;
+        read.field = 0;
+      }
+      else {
+        read.send = true;
+      }
+    }
+  }
+
+  // new reads
+  uint8_t next = 0;
+  for (auto & read : state->reads) {
+    if (read.field) continue;
+    while (next < state->fieldsCount && state->fields[next].state != FIELD_NEEDED)
+      next++;
+    if (next == state->fieldsCount) break;
+    state->fields[next].state = FIELD_READING;
+    memclear(&read, sizeof(read));
+    read.field = next + 1;
+    read.send = true;
+  }
+
+  // one frame at a time in the output buffer
+  for (auto & read : state->reads) {
+    if (read.field && read.send) {
+      uint8_t payload[2] = {read.field, read.chunk};
+      if (pushFrame(PARAMETER_READ_ID, state->address, payload, sizeof(payload))) {
+        read.send = false;
+        read.deadline = now + CRSF_PARAMS_TIMEOUT;
+      }
+      break;
+    }
+  }
+}
+
+void crossfireParamsWakeup()
+{
+  if (!state) return;
+
+  RTOS_LOCK_MUTEX(paramsMutex);
+  if (state) {
+    tmr10ms_t now = get_tmr10ms();
+    if (!state->address) {
+      if ((int32_t)(now - state->nextPing) >= 0 &&
+          pushFrame(PING_DEVICES_ID, BROADCAST_ADDRESS, nullptr, 0)) {
+        state->nextPing = now + 100;
+      }
+    }
+    else if (state->writeSize) {
+      if (pushFrame(PARAMETER_WRITE_ID, state->address, state->write, state->writeSize))
+        state->writeSize = 0;
+    }
+    else {
+      if (state->commandField && (int32_t)(now - state->commandDeadline) >= 0) {
+        // the device answers the poll with the new state of the command
+        state->write[0] = state->commandField;
+        state->write[1] = CRSF_COMMAND_POLL;
+        state->writeSize = 2;
+        state->fields[state->commandField - 1].state = FIELD_NEEDED;
+        state->commandField = 0;
+      }
+      sendReads(now);
+    }
+  }
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+}
+
+static void processDeviceInfo(const uint8_t * frame, const uint8_t * end)
+{
+  const uint8_t * ptr = frame + 5;
+  const char * name = getString(ptr, end);
+  if (!name || ptr + 14 > end) return;
+
+  CrossfireDevice * device = findDevice(frame[4]);
+  if (!device) {
+    if (state->devicesCount == CRSF_PARAMS_MAX_DEVICES) return;
+    device = &state->devices[state->devicesCount++];
+  }
+
+  device->address = frame[4];
+  strncpy(device->name, name, CRSF_DEVICE_NAME_LEN);
+  device->name[CRSF_DEVICE_NAME_LEN] = '\0';
+  device->serial = getBigEndian(ptr, 4, false);
+  device->hwVersion = getBigEndian(ptr + 4, 4, false);
+  device->swVersion = getBigEndian(ptr + 8, 4, false);
+  device->fieldsCount = ptr[12];
+  device->paramsVersion = ptr[13];
+  structureRevision++;
+}
+
+static bool sameStructure(const CrossfireField & field, const uint8_t * data,
+                          uint8_t size)
+{
+  CrossfireParam before, after;
+  if (field.size == 0 ||
+      !crossfireParamDecode(0, field.data, field.size, before) ||
+      !crossfireParamDecode(0, data, size, after))
+    return false;
+
+  return before.parent == after.parent && before.type == after.type &&
+         before.hidden == after.hidden && !strcmp(before.name, after.name) &&
+         (!before.options || !strcmp(before.options, after.options));
+}
+
+static void fieldRead(uint8_t id, const uint8_t * data, uint8_t size)
+{
+  auto & field = state->fields[id - 1];
+
+  if (sameStructure(field, data, size))
+    valuesRevision++;
+  else
+    structureRevision++;
+
+  memcpy(field.data, data, size);
+  field.data[size] = '\0';
+  field.size = size;
+  field.state = FIELD_DONE;
+
+  CrossfireParam param;
+  if (crossfireParamDecode(id, field.data, size, param) &&
+      param.type == CRSF_COMMAND &&
+      (param.value == CRSF_COMMAND_START || param.value == CRSF_COMMAND_PROGRESS)) {
+    state->commandField = id;
+    state->commandDeadline = get_tmr10ms() + max<uint8_t>(param.timeout, 10);
+  }
+  else if (state->commandField == id) {
+    state->commandField = 0;
+  }
+}
+
+static void processParameterEntry(const uint8_t * frame, const uint8_t * end)
+{
+  uint8_t id = frame[5];
+  uint8_t chunksRemaining = frame[6];
+  const uint8_t * data = frame + 7;
+  if (frame[4] != state->address || id < 1 || id > state->fieldsCount || data > end)
+    return;
+  uint8_t size = end - data;
+
+  for (auto & read : state->reads) {
+    if (read.field != id) continue;
+
+    if (read.size + size >= CRSF_PARAM_MAX_SIZE) {
+      state->fields[id - 1].state = FIELD_FAILED;
+      read.field = 0;
+    }
+    else {
+      memcpy(&read.data[read.size], data, size);
+      read.size += size;
+      if (chunksRemaining == 0) {
+        fieldRead(id, read.data, read.size);
+        read.field = 0;
+      }
+      else {
+        // next chunk at once
+        read.chunk++;
+        read.retries = 0;
+        read.send = true;
+      }
+    }
+    return;
+  }
+
+  // not requested (answer to a write)
+  if (chunksRemaining == 0 && size < CRSF_PARAM_MAX_SIZE) {
+    fieldRead(id, data, size);
+  }
+}
+
+bool crossfireParamsProcessFrame(uint8_t module, const uint8_t * frame,
+                                 uint8_t count)
+{
+  if (!state || count < 7) return false;
+
+  uint8_t id = frame[2];
+  if ((id != DEVICE_INFO_ID && id != PARAMETER_SETTINGS_ENTRY_ID) ||
+      frame[3] != RADIO_ADDRESS)
+    return false;
+
+  bool result = false;
+  RTOS_LOCK_MUTEX(paramsMutex);
+  if (state && state->module == module) {
+    const uint8_t * end = frame + count - 1;  // CRC
+    if (id == DEVICE_INFO_ID)
+      processDeviceInfo(frame, end);
+    else
+      processParameterEntry(frame, end);
+    result = true;
+  }
+  RTOS_UNLOCK_MUTEX(paramsMutex);
+  return result;
+}
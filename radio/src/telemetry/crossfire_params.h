@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Native browser of the parameters of CRSF devices (ELRS / Crossfire TX
+// modules and receivers).
+//
+// Field reads are pipelined: up to CRSF_PARAMS_IN_FLIGHT fields are
+// requested without waiting for the previous answers, and the next chunk
+// of a field is requested as soon as one arrives. Requests and retries are
+// sent from the telemetry task, answers are handled with the telemetry
+// frames. The parameter tree is cached on SD per device serial number and
+// firmware version, so that it shows at once while the values are read
+// again.
+
+#define PARAMETER_SETTINGS_ENTRY_ID   0x2B
+#define PARAMETER_READ_ID             0x2C
+#define PARAMETER_WRITE_ID            0x2D
+
+#define CRSF_PARAMS_MAX_DEVICES       4
+#define CRSF_PARAMS_MAX_FIELDS        64
+#define CRSF_PARAM_MAX_SIZE           192  // all chunks of a field
+#define CRSF_DEVICE_NAME_LEN          16
+#define CRSF_PARAMS_IN_FLIGHT         4
+#define CRSF_PARAMS_TIMEOUT           20   // 10ms ticks before a read is sent again
+#define CRSF_PARAMS_RETRIES           5
+
+#define CRSF_PARAMS_CACHE_PATH        RADIO_PATH "/CRSF"
+
+enum CrossfireParamType {
+  CRSF_UINT8 = 0,
+  CRSF_INT8,
+  CRSF_UINT16,
+  CRSF_INT16,
+  CRSF_UINT32,
+  CRSF_INT32,
+  CRSF_FLOAT = 8,
+  CRSF_TEXT_SELECTION,
+  CRSF_STRING,
+  CRSF_FOLDER,
+  CRSF_INFO,
+  CRSF_COMMAND,
+  CRSF_OUT_OF_RANGE = 127,
+};
+
+enum CrossfireCommandStatus {
+  CRSF_COMMAND_READY = 0,
+  CRSF_COMMAND_START,
+  CRSF_COMMAND_PROGRESS,
+  CRSF_COMMAND_CONFIRMATION_NEEDED,
+  CRSF_COMMAND_CONFIRM,
+  CRSF_COMMAND_CANCEL,
+  CRSF_COMMAND_POLL,
+};
+
+struct CrossfireDevice {
+  uint8_t address;
+  char name[CRSF_DEVICE_NAME_LEN + 1];
+  uint32_t serial;
+  uint32_t hwVersion;
+  uint32_t swVersion;
+  uint8_t fieldsCount;
+  uint8_t paramsVersion;
+};
+
+// Decoded parameter entry, the strings point into its raw data
+struct CrossfireParam {
+  uint8_t id;
+  uint8_t parent;
+  uint8_t type;
+  bool hidden;
+  const char * name;
+  int32_t value;    // numbers, selections and command status
+  int32_t min;
+  int32_t max;
+  uint8_t prec;     // float
+  int32_t step;     // float
+  uint8_t timeout;  // command, 10ms ticks
+  const char * options;  // selection, separated with ';'
+  const char * text;     // string, info and command info
+  const char * unit;
+};
+
+bool crossfireParamDecode(uint8_t id, const uint8_t * data, uint8_t size,
+                          CrossfireParam & param);
+
+// Returns option `index` of a selection, copied to `buffer`
+const char * crossfireParamOption(const CrossfireParam & param, int index,
+                                  char * buffer, uint8_t size);
+
+void crossfireParamsStart(uint8_t module);
+void crossfireParamsStop();
+bool crossfireParamsActive();
+
+uint8_t crossfireParamsDevicesCount();
+bool crossfireParamsGetDevice(uint8_t index, CrossfireDevice & device);
+
+// Starts reading the fields of `address`, from the SD cache when possible
+void crossfireParamsSelectDevice(uint8_t address);
+uint8_t crossfireParamsFieldsCount();
+uint8_t crossfireParamsFieldsLoaded();
+
+// Copies the raw data of `field` into `buffer` and decodes it
+bool crossfireParamsGetField(uint8_t field, CrossfireParam & param,
+                             uint8_t (&buffer)[CRSF_PARAM_MAX_SIZE]);
+
+void crossfireParamsWrite(uint8_t field, const uint8_t * value, uint8_t size);
+void crossfireParamsWriteValue(const CrossfireParam & param, int32_t value);
+void crossfireParamsCommand(const CrossfireParam & param, uint8_t status);
+
+// Bumped when a field or a device is added or changes (structure), or
+// when only a value changes (values)
+uint16_t crossfireParamsStructureRevision();
+uint16_t crossfireParamsValuesRevision();
+
+// SD cache, called from the UI once all the fields are read
+void crossfireParamsSaveCache();
+
+// Telemetry side
+void crossfireParamsWakeup();
+bool crossfireParamsProcessFrame(uint8_t module, const uint8_t * frame,
+                                 uint8_t count);
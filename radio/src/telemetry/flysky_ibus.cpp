@@ -145,27 +145,12 @@ enum
 };
 
 
+// Sorted by type, for getFlySkySensor()
 const FlySkySensor flySkySensors[] = {
-  // flysky start
-  { SENSOR_TYPE_RX_VOL,              STR_SENSOR_A1,             UNIT_VOLTS,             2 },  // RX Voltage (remapped, really 0x0)
   { SENSOR_TYPE_TEMPERATURE,         STR_SENSOR_TEMP1,          UNIT_CELSIUS,           1 },  // Temperature
   { SENSOR_TYPE_MOT,                 STR_SENSOR_RPM,            UNIT_RAW,               0 },  // RPM
   { SENSOR_TYPE_EXT_VOL,             STR_SENSOR_A3,             UNIT_VOLTS,             2 },  // External voltage
-  { SENSOR_TYPE_BVD,                 "BVD",                     UNIT_VOLTS,             2 },  // BVD
   { SENSOR_TYPE_GYROSCOPE_1_AXIS,    STR_SENSOR_CELLS,          UNIT_DEGREE,            1 },  //
-  { SENSOR_TYPE_PRES,                STR_SENSOR_PRES,           UNIT_RAW,               2 },  // 4 bytes In fact Temperature + Pressure -> Altitude
-  { SENSOR_TYPE_ALT,                 STR_SENSOR_ALT,            UNIT_METERS,            2 },
-  { SENSOR_TYPE_RF_MODULE_TEMP,      STR_SENSOR_TEMP2,          UNIT_CELSIUS,           0 },  // 1 bytes temperature
-  { SENSOR_TYPE_RF_MODULE_VOL,       STR_SENSOR_TXV,            UNIT_VOLTS,             2 },  // 2 bytes voltage
-  { SENSOR_TYPE_RF_MODULE_POWER,     STR_SENSOR_TX_POWER,       UNIT_DBM,               0 },  // 2 bytes DBM
-//  { SENSOR_TYPE_RF_MODULE_RAW,       STR_SENSOR_TX_POWER,       UNIT_RAW,               0 },  // 2 bytes DBM
-  { SENSOR_TYPE_TX_V,                STR_SENSOR_TXV,            UNIT_VOLTS,             2 },  // TX Voltage
-  { SENSOR_TYPE_RX_SNR,              STR_SENSOR_RX_SNR,         UNIT_DB,                0 },  // RX SNR
-  { SENSOR_TYPE_RX_NOISE,            STR_SENSOR_RX_NOISE,       UNIT_DBM,               0 },  // RX Noise
-  { SENSOR_TYPE_RX_RSSI,             STR_SENSOR_RSSI,           UNIT_DBM,               0 },  // RX RSSI (0xfc)
-  { SENSOR_TYPE_RX_ERR_RATE,         STR_SENSOR_RX_QUALITY,     UNIT_PERCENT,           0 },  // RX error rate
-  ////////////////////////////////////////////////////////////////
-
   { AFHDS2A_ID_BAT_CURR,              STR_SENSOR_CURR,          UNIT_AMPS,              2 },  // battery current A * 100
   { AFHDS2A_ID_FUEL,                  STR_SENSOR_CAPACITY,      UNIT_RAW,               0 },  // remaining battery percentage / mah drawn otherwise or fuel level no unit!
   { AFHDS2A_ID_RPM,                   STR_SENSOR_RPM,           UNIT_RAW,               0 },  // throttle value / battery capacity
@@ -184,21 +169,39 @@ const FlySkySensor flySkySensors[] = {
   { AFHDS2A_ID_GPS_DIST,              STR_SENSOR_DIST,          UNIT_METERS,            0 },  // 2 bytes dist from home m unsigned
   { AFHDS2A_ID_ARMED,                 STR_SENSOR_ARM,           UNIT_RAW,               0 },  // 2 bytes
   { AFHDS2A_ID_FLIGHT_MODE,           STR_SENSOR_FLIGHT_MODE,   UNIT_RAW,               0 },  // 2 bytes index
-  { SENSOR_TYPE_PRES | 0x100,         STR_SENSOR_TEMP2,         UNIT_CELSIUS,           1 },  // 2 bytes Temperature
+  { SENSOR_TYPE_PRES,                STR_SENSOR_PRES,           UNIT_RAW,               2 },  // 4 bytes In fact Temperature + Pressure -> Altitude
   { AFHDS2A_ID_ODO1,                  STR_SENSOR_ODO1,          UNIT_METERS,            2 },  // 2 bytes Odometer1 -- some magic with 330 needed
   { AFHDS2A_ID_ODO2,                  STR_SENSOR_ODO2,          UNIT_METERS,            2 },  // 2 bytes Odometer2 -- some magic with 330 needed
   { AFHDS2A_ID_SPE,                   STR_SENSOR_ASPD,          UNIT_KMH,               2 },  // 2 bytes Speed km/h -- some magic with 330 needed
+  { SENSOR_TYPE_TX_V,                STR_SENSOR_TXV,            UNIT_VOLTS,             2 },  // TX Voltage
   { AFHDS2A_ID_GPS_LAT,               STR_SENSOR_GPS,           UNIT_RAW,               0 },  // 4 bytes signed WGS84 in degrees * 1E7
   { AFHDS2A_ID_GPS_LON,               STR_SENSOR_GPS,           UNIT_RAW,               0 },  // 4 bytes signed WGS84 in degrees * 1E7
   { AFHDS2A_ID_GPS_ALT,               STR_SENSOR_GPSALT,        UNIT_METERS,            2 },  // 4 bytes signed GPS alt m*100
   { AFHDS2A_ID_ALT,                   STR_SENSOR_ALT,           UNIT_METERS,            2 },  // 4 bytes signed Alt m*100
   { AFHDS2A_ID_RX_SIG_AFHDS3,         STR_SENSOR_RX_QUALITY,    UNIT_PERCENT,           0 },  // RX error rate
   { AFHDS2A_ID_RX_SNR_AFHDS3,         STR_SENSOR_RX_SNR,        UNIT_DB,                1 },  // RX SNR
+  { SENSOR_TYPE_RX_SNR,              STR_SENSOR_RX_SNR,         UNIT_DB,                0 },  // RX SNR
+  { SENSOR_TYPE_RX_NOISE,            STR_SENSOR_RX_NOISE,       UNIT_DBM,               0 },  // RX Noise
+  { SENSOR_TYPE_RX_RSSI,             STR_SENSOR_RSSI,           UNIT_DBM,               0 },  // RX RSSI (0xfc)
+  { SENSOR_TYPE_RX_ERR_RATE,         STR_SENSOR_RX_QUALITY,     UNIT_PERCENT,           0 },  // RX error rate
+  { SENSOR_TYPE_BVD,                 "BVD",                     UNIT_VOLTS,             2 },  // BVD
+  { SENSOR_TYPE_PRES | 0x100,         STR_SENSOR_TEMP2,         UNIT_CELSIUS,           1 },  // 2 bytes Temperature
   { AFHDS2A_ID_TX_RSSI,               STR_SENSOR_TX_RSSI,       UNIT_DBM,               0 },  // Pseudo sensor for TRSSI
+  { SENSOR_TYPE_RX_VOL,              STR_SENSOR_A1,             UNIT_VOLTS,             2 },  // RX Voltage (remapped, really 0x0)
+  { SENSOR_TYPE_ALT,                 STR_SENSOR_ALT,            UNIT_METERS,            2 },
+  { SENSOR_TYPE_RF_MODULE_TEMP,      STR_SENSOR_TEMP2,          UNIT_CELSIUS,           0 },  // 1 bytes temperature
+  { SENSOR_TYPE_RF_MODULE_VOL,       STR_SENSOR_TXV,            UNIT_VOLTS,             2 },  // 2 bytes voltage
+  { SENSOR_TYPE_RF_MODULE_POWER,     STR_SENSOR_TX_POWER,       UNIT_DBM,               0 },  // 2 bytes DBM
+//  { SENSOR_TYPE_RF_MODULE_RAW,       STR_SENSOR_TX_POWER,       UNIT_RAW,               0 },  // 2 bytes DBM
 
   { 0x00,                            NULL,                      UNIT_RAW,               0 },  // sentinel
 };
 
+const FlySkySensor * getFlySkySensor(uint16_t id)
+{
+  return findSortedSensor(flySkySensors, &FlySkySensor::type, id);
+}
+
 int32_t getALT(uint32_t value);
 inline int setFlyskyTelemetryValue( int16_t type, uint8_t instance, int32_t value, uint32_t unit, uint32_t prec)
 {
@@ -289,10 +292,9 @@ void processFlySkyAFHDS3Sensor(const uint8_t * packet, uint8_t len )
     value -= 400; // Temperature sensors have 40 degree offset
   }
 
-  for (const FlySkySensor * sensor = flySkySensors; sensor->type; sensor++)
+  const FlySkySensor * sensor = getFlySkySensor(type);
+  if (sensor)
   {
-    if (sensor->type != type) continue;
-
     if (sensor->unit == UNIT_VOLTS) value = (int16_t) value; // Voltage types are unsigned 16bit integers
 
     setFlyskyTelemetryValue(type, id, value, sensor->unit, sensor->precision);
@@ -380,8 +382,8 @@ void processFlySkySensor(const uint8_t * packet, uint8_t type)
     }
     return;
   }
-  for (const FlySkySensor * sensor = flySkySensors; sensor->type; sensor++) {
-    if (sensor->type != id) continue;
+  const FlySkySensor * sensor = getFlySkySensor(id);
+  if (sensor) {
     if (sensor->unit == UNIT_CELSIUS) value -= 400; // Temperature sensors have 40 degree offset
     else if (sensor->unit == UNIT_VOLTS) value = (int16_t) value; // Voltage types are unsigned 16bit integers
     setTelemetryValue(PROTOCOL_TELEMETRY_FLYSKY_IBUS, id, 0, instance, value, sensor->unit, sensor->precision);
@@ -457,15 +459,6 @@ void processFlySkyTelemetryData(uint8_t data, uint8_t * rxBuffer, uint8_t &rxBuf
   }
 }
 
-const FlySkySensor * getFlySkySensor(uint16_t id)
-{
-  for (const FlySkySensor * sensor = flySkySensors; sensor->type; sensor++) {
-    if (id == sensor->type)
-      return sensor;
-  }
-  return nullptr;
-}
-
 void flySkySetDefault(int index, uint16_t id, uint8_t subId, uint8_t instance)
 {
   TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
@@ -119,12 +119,22 @@ static void processGetHardwareInfoFrame(uint8_t module, const uint8_t * frame)
       globalData.upgradeModulePopup = 1;
       POPUP_WARNING(STR_MODULE_UPGRADE_ALERT);
     }
+    pxx2CacheInformation(module, index, destination->information);
   }
   else if (index < PXX2_MAX_RECEIVERS_PER_MODULE && modelId < DIM(PXX2ReceiversNames)) {
     memcpy(&destination->receivers[index].information, &frame[4], length);
     destination->receivers[index].timestamp = get_tmr10ms();
     if (destination->receivers[index].information.capabilities & ~((1 << RECEIVER_CAPABILITY_COUNT) - 1))
       destination->information.capabilityNotSupported = true;
+    pxx2CacheInformation(module, index, destination->receivers[index].information);
+  }
+  else {
+    return;
+  }
+
+  // answer to the last request: send the next one without waiting for the timeout
+  if (index == (uint8_t)(destination->current - 1)) {
+    destination->timeout = 0;
   }
 }
 
@@ -145,6 +155,7 @@ static void processModuleSettingsFrame(uint8_t module, const uint8_t * frame)
 
   destination->state = PXX2_SETTINGS_OK;
   destination->timeout = 0;
+  pxx2CacheModuleSettings(module, *destination);
   moduleState[module].mode = MODULE_MODE_NORMAL;
 }
 
@@ -182,6 +193,7 @@ static void processReceiverSettingsFrame(uint8_t module, const uint8_t * frame)
 
   destination->state = PXX2_SETTINGS_OK;
   destination->timeout = 0;
+  pxx2CacheReceiverSettings(module, *destination);
   moduleState[module].mode = MODULE_MODE_NORMAL;
 }
 
@@ -360,13 +372,8 @@ static void processSpectrumAnalyserFrame(uint8_t module, const uint8_t * frame)
   TRACE("Fq=%u => %d, Pw=%d", frequency, offset, int32_t(power));
 
   uint32_t x = offset / reusableBuffer.spectrumAnalyser.step;
-  if (x < LCD_W) {
-    reusableBuffer.spectrumAnalyser.bars[x] = max<int>(0, -SPECTRUM_ANALYSER_POWER_FLOOR + power); // we remove everything below -120dB
-#if defined(COLORLCD)
-    if (reusableBuffer.spectrumAnalyser.bars[x] > reusableBuffer.spectrumAnalyser.max[x])
-      reusableBuffer.spectrumAnalyser.max[x] = reusableBuffer.spectrumAnalyser.bars[x];
-#endif
-  }
+  // we remove everything below -120dB
+  spectrumAnalyserSetColumns(x, 1, max<int>(0, -SPECTRUM_ANALYSER_POWER_FLOOR + power));
 }
 
 static void processPowerMeterFrame(uint8_t module, const uint8_t * frame)
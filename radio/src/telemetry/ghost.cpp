@@ -62,6 +62,7 @@ enum
   GHOST_ID_GPS_SATS = 0x0014            // GPS Satellite Count
 };
 
+// Sorted by id, for getGhostSensor()
 const GhostSensor ghostSensors[] = {
   {GHOST_ID_RX_RSSI,         STR_SENSOR_RSSI,             UNIT_DB,                0},
   {GHOST_ID_RX_LQ,           STR_SENSOR_RX_QUALITY,       UNIT_PERCENT,           0},
@@ -83,9 +84,9 @@ const GhostSensor ghostSensors[] = {
 
   {GHOST_ID_GPS_LAT,         STR_GPS,                     UNIT_GPS_LATITUDE,      0},
   {GHOST_ID_GPS_LONG,        STR_GPS,                     UNIT_GPS_LONGITUDE,     0},
-  {GHOST_ID_GPS_GSPD,        STR_SENSOR_GSPD,             UNIT_KMH,               1},
-  {GHOST_ID_GPS_HDG,         STR_SENSOR_HDG,              UNIT_DEGREE,            3},
   {GHOST_ID_GPS_ALT,         STR_SENSOR_GPSALT,           UNIT_METERS,            0},
+  {GHOST_ID_GPS_HDG,         STR_SENSOR_HDG,              UNIT_DEGREE,            3},
+  {GHOST_ID_GPS_GSPD,        STR_SENSOR_GSPD,             UNIT_KMH,               1},
   {GHOST_ID_GPS_SATS,        STR_SENSOR_SATELLITES,       UNIT_RAW,               0},
 
   {0x00,                     NULL,                  UNIT_RAW,               0},
@@ -93,11 +94,7 @@ const GhostSensor ghostSensors[] = {
 
 const GhostSensor *getGhostSensor(uint8_t id)
 {
-  for (const GhostSensor * sensor = ghostSensors; sensor->id; sensor++) {
-    if (id == sensor->id)
-      return sensor;
-  }
-  return nullptr;
+  return findSortedSensor(ghostSensors, &GhostSensor::id, id);
 }
 
 void processGhostTelemetryValue(uint8_t index, int32_t value)
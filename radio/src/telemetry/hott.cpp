@@ -217,11 +217,8 @@ struct HottSensor
   const uint8_t precision;
 };
 
+// Sorted by id, for getHottSensor()
 const HottSensor hottSensors[] = {
-  // TX
-  { HOTT_ID_TX_RSSI_DL,   STR_SENSOR_HOTT_ID_TX_RSSI_DL,  UNIT_DB, 0},                	// downlink signal strength (rx --> tx as seen by tx) 
-  { HOTT_ID_TX_LQI_DL,    STR_SENSOR_HOTT_ID_TX_LQI_DL,   UNIT_RAW, 0},               	// downlink signal quality (rx --> tx s seen by tx)
-
   // RX
   { HOTT_ID_RX_RSSI_UL,   STR_SENSOR_HOTT_ID_RX_RSSI_UL,  UNIT_DB, 0 },               	// uplink signal strength (tx --> rx as seen by rx)
   { HOTT_ID_RX_LQI_UL,    STR_SENSOR_HOTT_ID_RX_LQI_UL,   UNIT_RAW, 0 },              	// uplink signal quality (tx --> rx as seen by rx)
@@ -285,7 +282,11 @@ const HottSensor hottSensors[] = {
   { HOTT_ID_EAM_CAP,      STR_SENSOR_HOTT_ID_EAM_CAP,     UNIT_MAH, 0 },              	// EAM Batt capacity
   { HOTT_ID_EAM_VV,       STR_SENSOR_HOTT_ID_EAM_VV,      UNIT_METERS_PER_SECOND, 2 },	// EAM vertical velcocity
   { HOTT_ID_EAM_RPM,      STR_SENSOR_HOTT_ID_EAM_RPM,    UNIT_RPMS, 0 },              	// EAM rpm  
-  { HOTT_ID_EAM_SPEED,    STR_SENSOR_HOTT_ID_EAM_SPEED,   UNIT_KMH,  0 } ,            	// EAM speed
+  { HOTT_ID_EAM_SPEED,    STR_SENSOR_HOTT_ID_EAM_SPEED,   UNIT_KMH,  0 },            	// EAM speed
+
+  // TX
+  { HOTT_ID_TX_RSSI_DL,   STR_SENSOR_HOTT_ID_TX_RSSI_DL,  UNIT_DB, 0},                	// downlink signal strength (rx --> tx as seen by tx) 
+  { HOTT_ID_TX_LQI_DL,    STR_SENSOR_HOTT_ID_TX_LQI_DL,   UNIT_RAW, 0},               	// downlink signal quality (rx --> tx s seen by tx)
   
   // sentinel
   {0x00,                  NULL,                     UNIT_RAW, 0}                // sentinel
@@ -293,11 +294,7 @@ const HottSensor hottSensors[] = {
 
 const HottSensor * getHottSensor(uint16_t id)
 {
-  for (const HottSensor * sensor = hottSensors; sensor->id; sensor++) {
-    if (id == sensor->id)
-      return sensor;
-  }
-  return nullptr;
+  return findSortedSensor(hottSensors, &HottSensor::id, id);
 }
 
 int16_t processHoTTdBm(int16_t value)
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "link_history.h"
+
+// Metrics are quantized to 1..255 (0 means no data):
+// q = value / divisor + offset
+struct LinkHistoryScale {
+  int16_t offset;
+  uint8_t divisor;
+};
+
+static const LinkHistoryScale scales[LINK_HISTORY_METRICS] = {
+  {128, 1},  // RSSI (dB)
+  {1, 1},    // LQ (%)
+  {128, 1},  // SNR (dB)
+  {1, 10},   // TX power (mW)
+};
+
+// Delta codes: 0 no change, 1..7 positive steps, 9..15 negative steps,
+// 8 no data. After no data, codes 1..15 are absolute values (code * 17).
+static const uint8_t deltaSteps[8] = {0, 1, 2, 4, 8, 16, 32, 64};
+#define CODE_NO_DATA    8
+
+struct LinkHistoryState {
+  uint16_t size;
+  uint16_t first;  // oldest sample
+  uint16_t count;
+  uint8_t base[LINK_HISTORY_METRICS];  // value before the oldest sample
+  uint8_t last[LINK_HISTORY_METRICS];  // value of the newest sample
+};
+
+static uint16_t fineSamples[LINK_HISTORY_FINE_SAMPLES];
+static uint16_t coarseSamples[LINK_HISTORY_COARSE_SAMPLES];
+static LinkHistoryState tracks[LINK_HISTORY_TRACKS];
+
+static uint16_t coarsePeriod;
+static uint16_t coarseCount;
+static uint8_t coarseWorst[LINK_HISTORY_METRICS];
+
+static uint16_t * trackSamples(uint8_t track)
+{
+  return track == LINK_HISTORY_FINE ? fineSamples : coarseSamples;
+}
+
+static uint8_t quantize(uint8_t metric, int16_t value)
+{
+  if (value == LINK_HISTORY_NO_DATA) return 0;
+  return limit<int>(1, value / scales[metric].divisor + scales[metric].offset, 255);
+}
+
+static int16_t dequantize(uint8_t metric, uint8_t q)
+{
+  if (q == 0) return LINK_HISTORY_NO_DATA;
+  return (q - scales[metric].offset) * scales[metric].divisor;
+}
+
+static uint8_t applyCode(uint8_t value, uint8_t code)
+{
+  if (code == 0) return value;
+  if (value == 0) return code * 17;
+  if (code == CODE_NO_DATA) return 0;
+  int result = code < 8 ? value + deltaSteps[code] : value - deltaSteps[code - 8];
+  return limit<int>(1, result, 255);
+}
+
+// code bringing `last` closest to `target`, `last` is updated
+static uint8_t encode(uint8_t & last, uint8_t target)
+{
+  if (target == 0) {
+    uint8_t code = last ? CODE_NO_DATA : 0;
+    last = 0;
+    return code;
+  }
+
+  uint8_t best = 0;
+  int bestError = abs(target - last);
+  for (uint8_t code = 1; code < 16 && bestError > 0; code++) {
+    if (code == CODE_NO_DATA && last) continue;
+    int error = abs(target - applyCode(last, code));
+    if (error < bestError) {
+      best = code;
+      bestError = error;
+    }
+  }
+
+  last = applyCode(last, best);
+  return best;
+}
+
+static inline uint8_t sampleCode(uint16_t sample, uint8_t metric)
+{
+  return (sample >> (4 * metric)) & 0x0F;
+}
+
+// lowest RSSI, LQ and SNR, highest TX power
+static void keepWorst(uint8_t * worst, const uint8_t * q)
+{
+  for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+    if (metric == LINK_HISTORY_TX_POWER)
+      worst[metric] = max(worst[metric], q[metric]);
+    else
+      worst[metric] = min(worst[metric], q[metric]);
+  }
+}
+
+static void pushSample(uint8_t track, const uint8_t * q)
+{
+  auto & state = tracks[track];
+  uint16_t * samples = trackSamples(track);
+
+  if (state.count == state.size) {
+    // drop the oldest sample into the base values
+    uint16_t oldest = samples[state.first];
+    for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+      state.base[metric] = applyCode(state.base[metric], sampleCode(oldest, metric));
+    }
+    state.first = (state.first + 1) % state.size;
+    state.count--;
+  }
+
+  uint16_t sample = 0;
+  for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+    sample |= encode(state.last[metric], q[metric]) << (4 * metric);
+  }
+  samples[(state.first + state.count) % state.size] = sample;
+  state.count++;
+}
+
+// merge pairs of coarse samples in place, halving the resolution
+static void compactCoarse()
+{
+  auto & state = tracks[LINK_HISTORY_COARSE];
+  uint16_t * samples = coarseSamples;
+
+  uint8_t values[LINK_HISTORY_METRICS];
+  uint8_t encoded[LINK_HISTORY_METRICS];
+  memcpy(values, state.base, sizeof(values));
+  memcpy(encoded, state.base, sizeof(encoded));
+
+  uint16_t count = 0;
+  for (uint16_t i = 0; i + 1 < state.count; i += 2) {
+    uint8_t worst[LINK_HISTORY_METRICS];
+    for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+      values[metric] = applyCode(values[metric], sampleCode(samples[i], metric));
+      worst[metric] = values[metric];
+    }
+    for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+      values[metric] = applyCode(values[metric], sampleCode(samples[i + 1], metric));
+    }
+    keepWorst(worst, values);
+
+    uint16_t sample = 0;
+    for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+      sample |= encode(encoded[metric], worst[metric]) << (4 * metric);
+    }
+    samples[count++] = sample;
+  }
+
+  state.count = count;
+  memcpy(state.last, encoded, sizeof(state.last));
+  coarsePeriod *= 2;
+}
+
+void linkHistoryReset()
+{
+  memclear(tracks, sizeof(tracks));
+  tracks[LINK_HISTORY_FINE].size = LINK_HISTORY_FINE_SAMPLES;
+  tracks[LINK_HISTORY_COARSE].size = LINK_HISTORY_COARSE_SAMPLES;
+  coarsePeriod = LINK_HISTORY_COARSE_PERIOD;
+  coarseCount = 0;
+}
+
+void linkHistoryPush(const int16_t values[LINK_HISTORY_METRICS])
+{
+  if (!tracks[LINK_HISTORY_FINE].size) linkHistoryReset();
+
+  uint8_t q[LINK_HISTORY_METRICS];
+  for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+    q[metric] = quantize(metric, values[metric]);
+  }
+
+  pushSample(LINK_HISTORY_FINE, q);
+
+  if (coarseCount++ == 0)
+    memcpy(coarseWorst, q, sizeof(coarseWorst));
+  else
+    keepWorst(coarseWorst, q);
+
+  if (coarseCount >= coarsePeriod) {
+    coarseCount = 0;
+    if (tracks[LINK_HISTORY_COARSE].count == LINK_HISTORY_COARSE_SAMPLES) {
+      compactCoarse();
+    }
+    pushSample(LINK_HISTORY_COARSE, coarseWorst);
+  }
+}
+
+static int16_t sensorValue(uint8_t index)
+{
+  const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  TelemetryItem & item = telemetryItems[index];
+  if (!item.isAvailable() || item.isOld()) return LINK_HISTORY_NO_DATA;
+
+  int32_t value = item.value;
+  for (uint8_t i = 0; i < sensor.prec; i++) value /= 10;
+  return limit<int32_t>(-32767, value, 32767);
+}
+
+static bool isSensor(const TelemetrySensor & sensor, const char * label)
+{
+  return !strncmp(sensor.label, label, TELEM_LABEL_LEN);
+}
+
+void linkHistoryWakeup()
+{
+  static tmr10ms_t nextSample = 0;
+  if ((int32_t)(get_tmr10ms() - nextSample) < 0) return;
+  nextSample = get_tmr10ms() + 100;
+
+  int16_t values[LINK_HISTORY_METRICS];
+  for (auto & value : values) value = LINK_HISTORY_NO_DATA;
+
+  if (TELEMETRY_STREAMING()) {
+    bool rssiInDbm = false;
+    for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+      const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      if (!sensor.isAvailable()) continue;
+
+      if (isSensor(sensor, STR_SENSOR_RX_RSSI1)) {
+        values[LINK_HISTORY_RSSI] = sensorValue(i);
+        rssiInDbm = true;
+      }
+      else if (isSensor(sensor, STR_SENSOR_RSSI) && !rssiInDbm) {
+        values[LINK_HISTORY_RSSI] = sensorValue(i);
+      }
+      else if (isSensor(sensor, STR_SENSOR_RX_QUALITY)) {
+        values[LINK_HISTORY_LQ] = sensorValue(i);
+      }
+      else if (isSensor(sensor, STR_SENSOR_RX_SNR)) {
+        values[LINK_HISTORY_SNR] = sensorValue(i);
+      }
+      else if (isSensor(sensor, STR_SENSOR_TX_POWER) &&
+               sensor.unit == UNIT_MILLIWATTS) {
+        values[LINK_HISTORY_TX_POWER] = sensorValue(i);
+      }
+    }
+  }
+
+  linkHistoryPush(values);
+}
+
+uint16_t linkHistoryCount(uint8_t track)
+{
+  return tracks[track].count;
+}
+
+uint16_t linkHistoryPeriod(uint8_t track)
+{
+  return track == LINK_HISTORY_FINE ? 1 : coarsePeriod;
+}
+
+LinkHistoryReader::LinkHistoryReader(uint8_t track, uint16_t last) :
+    track(track)
+{
+  const auto & state = tracks[track];
+  index = state.first;
+  remaining = state.count;
+  skip = (last && last < remaining) ? remaining - last : 0;
+  memcpy(values, state.base, sizeof(values));
+}
+
+bool LinkHistoryReader::next(LinkHistorySample & sample)
+{
+  const auto & state = tracks[track];
+  const uint16_t * samples = trackSamples(track);
+
+  while (remaining > 0 && state.size > 0) {
+    uint16_t code = samples[index];
+    index = (index + 1) % state.size;
+    remaining--;
+
+    for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+      values[metric] = applyCode(values[metric], sampleCode(code, metric));
+    }
+
+    if (skip > 0) {
+      skip--;
+      continue;
+    }
+
+    for (uint8_t metric = 0; metric < LINK_HISTORY_METRICS; metric++) {
+      sample.values[metric] = dequantize(metric, values[metric]);
+    }
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Link quality history kept in RAM, so that fades can be looked at
+// without logging to SD.
+//
+// The link sensors are sampled once per second. Each sample stores one
+// 4-bit delta code per metric, so a sample takes 2 bytes:
+//  - fine track: 1s resolution over the last 10 minutes (ring)
+//  - coarse track: 10s resolution over the session. When it is full,
+//    pairs of samples are merged and its resolution halves.
+// Coarse samples keep the worst value of their period (lowest RSSI, LQ
+// and SNR, highest TX power). Large steps take a few samples to be
+// reached, except a loss of data which is recorded at once. Values coming
+// back after a loss are within 8 of the actual one at once.
+
+enum LinkHistoryMetric {
+  LINK_HISTORY_RSSI,
+  LINK_HISTORY_LQ,
+  LINK_HISTORY_SNR,
+  LINK_HISTORY_TX_POWER,
+  LINK_HISTORY_METRICS
+};
+
+enum LinkHistoryTrack {
+  LINK_HISTORY_FINE,
+  LINK_HISTORY_COARSE,
+  LINK_HISTORY_TRACKS
+};
+
+#define LINK_HISTORY_FINE_SAMPLES      600
+#define LINK_HISTORY_COARSE_SAMPLES    360
+#define LINK_HISTORY_COARSE_PERIOD     10 // seconds
+
+// metric without data (sensor missing or telemetry lost)
+#define LINK_HISTORY_NO_DATA           INT16_MIN
+
+struct LinkHistorySample {
+  int16_t values[LINK_HISTORY_METRICS];
+};
+
+// Sequential decoder, from the oldest sample to the newest one.
+// Samples written while reading may be missed or shifted.
+class LinkHistoryReader
+{
+ public:
+  // start `last` samples before the newest one (0 for all)
+  explicit LinkHistoryReader(uint8_t track, uint16_t last = 0);
+
+  bool next(LinkHistorySample & sample);
+
+ protected:
+  uint8_t track;
+  uint16_t index;
+  uint16_t remaining;
+  uint16_t skip;
+  uint8_t values[LINK_HISTORY_METRICS];
+};
+
+void linkHistoryReset();
+
+// Called from the telemetry wakeup, samples once per second
+void linkHistoryWakeup();
+
+// Append one sample of each metric (LINK_HISTORY_NO_DATA when missing)
+void linkHistoryPush(const int16_t values[LINK_HISTORY_METRICS]);
+
+uint16_t linkHistoryCount(uint8_t track);
+
+// seconds per sample
+uint16_t linkHistoryPeriod(uint8_t track);
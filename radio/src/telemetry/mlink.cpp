@@ -30,9 +30,8 @@ struct MLinkSensor
   const uint8_t precision;
 };
 
+// Sorted by id, for getMLinkSensor()
 const MLinkSensor mlinkSensors[] = {
-  {MLINK_SPECIAL,         STR_SENSOR_SPECIAL,           UNIT_RAW,               0},
-  {MLINK_RX_VOLTAGE,      STR_SENSOR_BATT,              UNIT_VOLTS,             1},
   {MLINK_VOLTAGE,         STR_SENSOR_VFAS,              UNIT_VOLTS,             1},
   {MLINK_CURRENT,         STR_SENSOR_CURR,              UNIT_AMPS,              1},
   {MLINK_VARIO,           STR_SENSOR_VSPD,              UNIT_METERS_PER_SECOND, 1},
@@ -42,23 +41,22 @@ const MLinkSensor mlinkSensors[] = {
   {MLINK_HEADING,         STR_SENSOR_HDG,               UNIT_DEGREE,            1},
   {MLINK_ALT,             STR_SENSOR_ALT ,              UNIT_METERS,            0},
   {MLINK_FUEL,            STR_SENSOR_FUEL,              UNIT_PERCENT,           0},
+  {MLINK_LQI,             STR_SENSOR_RSSI,              UNIT_RAW,               0},
   {MLINK_CAPACITY,        STR_SENSOR_CAPACITY,          UNIT_MAH,               0},
   {MLINK_FLOW,            STR_SENSOR_FLOW,              UNIT_MILLILITERS,       0},
   {MLINK_DISTANCE,        STR_SENSOR_DIST,              UNIT_KM,                1},
   {MLINK_GRATE,           STR_SENSOR_ACC,               UNIT_G,                 1},
-  {MLINK_LQI,             STR_SENSOR_RSSI,              UNIT_RAW,               0},
+  {MLINK_RX_VOLTAGE,      STR_SENSOR_BATT,              UNIT_VOLTS,             1},
   {MLINK_LOSS,            STR_SENSOR_LOSS,              UNIT_RAW,               0},
   {MLINK_TX_RSSI,         STR_SENSOR_TX_RSSI,           UNIT_RAW,               0},
   {MLINK_TX_LQI,          STR_SENSOR_TX_QUALITY,        UNIT_RAW,               0},
+  {MLINK_SPECIAL,         STR_SENSOR_SPECIAL,           UNIT_RAW,               0},
+  {0,                     nullptr,                      UNIT_RAW,               0}, // sentinel
 };
 
 const MLinkSensor * getMLinkSensor(uint16_t id)
 {
-  for (const MLinkSensor * sensor = mlinkSensors; sensor->id; sensor++) {
-    if (id == sensor->id)
-      return sensor;
-  }
-  return nullptr;
+  return findSortedSensor(mlinkSensors, &MLinkSensor::id, id);
 }
 
 void processMLinkPacket(const uint8_t * packet, bool multi)
@@ -70,6 +70,70 @@ enum MultiBufferState : uint8_t
   MultiStatusOrFrskyData
 };
 
+// Complete packets are sorted by consumer and processed once per
+// telemetry poll, so that spectrum scans or config pages do not
+// hold up sensor telemetry
+enum MultiPacketQueue : uint8_t
+{
+  MultiQueueTelemetry,
+  MultiQueueStatus,
+  MultiQueueConfig,
+  MultiQueueScanner,
+  MultiQueueCount
+};
+
+// Packets are stored as [type][len][data...]
+template <int N>
+class MultiPacketRing
+{
+  static_assert((N > 1) & !(N & (N - 1)), "Ring size must be a power of two!");
+
+  public:
+    bool push(uint8_t type, const uint8_t * data, uint8_t len)
+    {
+      if (N - (uint16_t)(widx - ridx) < len + 2) {
+        return false;
+      }
+      put(type);
+      put(len);
+      for (uint8_t i = 0; i < len; i++) {
+        put(data[i]);
+      }
+      return true;
+    }
+
+    // Copy the next packet (header included) into 'packet',
+    // which must be able to hold N bytes
+    bool pop(uint8_t * packet)
+    {
+      if (ridx == widx) {
+        return false;
+      }
+      packet[0] = get();
+      uint8_t len = packet[1] = get();
+      for (uint8_t i = 0; i < len; i++) {
+        packet[2 + i] = get();
+      }
+      return true;
+    }
+
+  protected:
+    uint8_t buffer[N];
+    uint16_t widx = 0;
+    uint16_t ridx = 0;
+
+    void put(uint8_t byte) { buffer[widx++ & (N - 1)] = byte; }
+    uint8_t get() { return buffer[ridx++ & (N - 1)]; }
+};
+
+struct MultiPacketQueues
+{
+  MultiPacketRing<256> telemetry;
+  MultiPacketRing<128> status;
+  MultiPacketRing<64> config;
+  MultiPacketRing<64> scanner;
+};
+
 
 #if defined(INTERNAL_MODULE_MULTI)
 
@@ -78,6 +142,7 @@ static uint8_t multiBindStatus[NUM_MODULES] = {MULTI_BIND_NONE, MULTI_BIND_NONE}
 
 static MultiBufferState multiTelemetryBufferState[NUM_MODULES];
 static uint16_t multiTelemetryLastRxTS[NUM_MODULES];
+static MultiPacketQueues multiPacketQueues[NUM_MODULES];
 
 MultiModuleStatus &getMultiModuleStatus(uint8_t module)
 {
@@ -109,6 +174,11 @@ static uint16_t& getMultiTelemetryLastRxTS(uint8_t module)
   return multiTelemetryLastRxTS[module];
 }
 
+static MultiPacketQueues& getMultiPacketQueues(uint8_t module)
+{
+  return multiPacketQueues[module];
+}
+
 #else // !INTERNAL_MODULE_MULTI
 
 static MultiModuleStatus multiModuleStatus;
@@ -116,6 +186,7 @@ static uint8_t multiBindStatus = MULTI_BIND_NONE;
 
 static MultiBufferState multiTelemetryBufferState;
 static uint16_t multiTelemetryLastRxTS;
+static MultiPacketQueues multiPacketQueues;
 
 MultiModuleStatus& getMultiModuleStatus(uint8_t)
 {
@@ -147,6 +218,11 @@ uint16_t& getMultiTelemetryLastRxTS(uint8_t module)
   return multiTelemetryLastRxTS;
 }
 
+static MultiPacketQueues& getMultiPacketQueues(uint8_t)
+{
+  return multiPacketQueues;
+}
+
 #endif // INTERNAL_MODULE_MULTI
 
 bool isMultiModeScanning(uint8_t module)
@@ -172,30 +248,12 @@ static void processMultiScannerPacket(const uint8_t *data, const uint8_t moduleI
       uint8_t power = max<int>(0,(data[channel+1] - 34) >> 1); // remove everything below -120dB
 
 #if LCD_W == 480
-      coord_t x = cur_channel*2;
-      if (x < LCD_W) {
-        reusableBuffer.spectrumAnalyser.bars[x] = power;
-        reusableBuffer.spectrumAnalyser.bars[x+1] = power;
-        if (power > reusableBuffer.spectrumAnalyser.max[x]) {
-          reusableBuffer.spectrumAnalyser.max[x] = power;
-          reusableBuffer.spectrumAnalyser.max[x+1] = power;
-        }
+      spectrumAnalyserSetColumns(cur_channel * 2, 2, power);
 #elif LCD_W == 212
-        coord_t x = cur_channel;
-      if (x <= LCD_W) {
-        reusableBuffer.spectrumAnalyser.bars[x] = power;
-        if (power > reusableBuffer.spectrumAnalyser.max[x]) {
-          reusableBuffer.spectrumAnalyser.max[x] = power;
-        }
+      spectrumAnalyserSetColumns(cur_channel, 1, power);
 #else
-      coord_t x = cur_channel/2 + 1;
-      if (x <= LCD_W) {
-        reusableBuffer.spectrumAnalyser.bars[x] = power;
-        if (power > reusableBuffer.spectrumAnalyser.max[x]) {
-          reusableBuffer.spectrumAnalyser.max[x] = power;
-        }
+      spectrumAnalyserSetColumns(cur_channel / 2 + 1, 1, power);
 #endif
-      }
       if (++cur_channel > MULTI_SCANNER_MAX_CHANNEL)
         cur_channel = 0;
     }
@@ -562,6 +620,76 @@ void MultiModuleStatus::getStatusString(char * statusText) const
   }
 }
 
+static MultiPacketQueue getMultiPacketQueue(uint8_t type)
+{
+  switch (type) {
+    case MultiStatus:
+    case DSMBindPacket:
+    case InputSync:
+    case ConfigCommand:
+    case FrskySportPolling:
+    case MultiProtoDef:
+      return MultiQueueStatus;
+
+    case ConfigTelemetry:
+      return MultiQueueConfig;
+
+    case SpectrumScannerPacket:
+      return MultiQueueScanner;
+
+    default:
+      return MultiQueueTelemetry;
+  }
+}
+
+static void queueMultiTelemetryPacket(uint8_t module, uint8_t type,
+                                      const uint8_t * data, uint8_t len)
+{
+  MultiPacketQueues & queues = getMultiPacketQueues(module);
+  MultiPacketQueue queue = getMultiPacketQueue(type);
+
+  bool queued;
+  switch (queue) {
+    case MultiQueueStatus:
+      queued = queues.status.push(type, data, len);
+      break;
+    case MultiQueueConfig:
+      queued = queues.config.push(type, data, len);
+      break;
+    case MultiQueueScanner:
+      queued = queues.scanner.push(type, data, len);
+      break;
+    default:
+      queued = queues.telemetry.push(type, data, len);
+      break;
+  }
+
+  if (!queued) {
+    TRACE("[MP] queue %d full, packet type 0x%02X dropped", queue, type);
+  }
+}
+
+void processMultiTelemetryQueues(uint8_t module)
+{
+  // large enough for the biggest ring
+  static uint8_t packet[256];
+
+  MultiPacketQueues & queues = getMultiPacketQueues(module);
+
+  while (queues.telemetry.pop(packet)) {
+    processMultiTelemetryPaket(packet, module);
+  }
+  while (queues.status.pop(packet)) {
+    processMultiTelemetryPaket(packet, module);
+  }
+  while (queues.config.pop(packet)) {
+    processMultiTelemetryPaket(packet, module);
+  }
+  while (queues.scanner.pop(packet)) {
+    processMultiTelemetryPaket(packet, module);
+  }
+}
+
 static void processMultiTelemetryByte(const uint8_t data, uint8_t module)
 {
   uint8_t * rxBuffer = getTelemetryRxBuffer(module);
@@ -587,8 +715,8 @@ static void processMultiTelemetryByte(const uint8_t data, uint8_t module)
     }
     debugPrintf(CRLF);
 #endif
-    // Packet is complete, process it
-    processMultiTelemetryPaket(rxBuffer, module);
+    // Packet is complete, queue it
+    queueMultiTelemetryPacket(module, rxBuffer[0], rxBuffer + 2, rxBuffer[1]);
     setMultiTelemetryBufferState(module, NoProtocolDetected);
   }
 }
@@ -696,7 +824,8 @@ void processMultiTelemetryData(uint8_t data, uint8_t module)
       if (rxBufferCount < TELEMETRY_RX_PACKET_SIZE) {
         rxBuffer[rxBufferCount++] = data;
         if (rxBufferCount > 5 && rxBuffer[0] == rxBufferCount - 1) {
-          processMultiStatusPacket(rxBuffer + 1, module, rxBuffer[0]);
+          queueMultiTelemetryPacket(module, MultiStatus, rxBuffer + 1,
+                                    rxBuffer[0]);
           rxBufferCount = 0;
           setMultiTelemetryBufferState(module, NoProtocolDetected);
         }
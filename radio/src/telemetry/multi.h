@@ -95,6 +95,9 @@ Type 0x0B Spectrum Scanner telemetry data
 
 void processMultiTelemetryData(uint8_t data, uint8_t module);
 
+// Process the packets completed by processMultiTelemetryData()
+void processMultiTelemetryQueues(uint8_t module);
+
 #define MULTI_SCANNER_MAX_CHANNEL 249
 
 struct MultiModuleStatus {
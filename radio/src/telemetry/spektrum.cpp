@@ -140,6 +140,7 @@ struct SpektrumSensor {
   const uint8_t precision;
 };
 
+// Sorted by I2C address, the sensors of an address are processed in order
 const SpektrumSensor spektrumSensors[] = {
   // 0x01 High voltage internal sensor
   {I2C_VOLTAGE,      0,  int16,     STR_SENSOR_A1,                UNIT_VOLTS,     2}, // 0.01V increments 
@@ -351,6 +352,16 @@ const SpektrumSensor spektrumSensors[] = {
   {0,                0,  int16,     NULL,                   UNIT_RAW,             0} //sentinel
 };
 
+// First sensor of the given address, or the one following it
+static const SpektrumSensor * getFirstSpektrumSensor(uint8_t i2cAddress)
+{
+  return std::lower_bound(
+      spektrumSensors, spektrumSensors + DIM(spektrumSensors) - 1, i2cAddress,
+      [](const SpektrumSensor & sensor, uint8_t i2cAddress) {
+        return sensor.i2caddress < i2cAddress;
+      });
+}
+
 // Alt Low and High needs to be combined (in 2 diff packets)
 static uint8_t gpsAltHigh = 0;
 
@@ -610,12 +621,10 @@ void processSpektrumPacket(const uint8_t *packet)
   } // I2C_SMART_BAT_BASE_ADDRESS
 
   bool handled = false;
-  for (const SpektrumSensor * sensor = spektrumSensors; sensor->i2caddress; sensor++) {
+  for (const SpektrumSensor * sensor = getFirstSpektrumSensor(i2cAddress);
+       sensor->i2caddress && sensor->i2caddress == i2cAddress; sensor++) {
     uint16_t pseudoId = (sensor->i2caddress << 8 | sensor->startByte);
 
-    if (i2cAddress != sensor->i2caddress)  // Not the sensor for current packet
-      continue;
-  
     handled = true;
 
     // Extract value, skip header
@@ -884,8 +893,9 @@ const SpektrumSensor *getSpektrumSensor(uint16_t pseudoId)
 {
   uint8_t startByte = (uint8_t) (pseudoId & 0xff);
   uint8_t i2cadd = (uint8_t) (pseudoId >> 8);
-  for (const SpektrumSensor * sensor = spektrumSensors; sensor->i2caddress; sensor++) {
-    if (i2cadd == sensor->i2caddress && startByte == sensor->startByte) {
+  for (const SpektrumSensor * sensor = getFirstSpektrumSensor(i2cadd);
+       sensor->i2caddress && sensor->i2caddress == i2cadd; sensor++) {
+    if (startByte == sensor->startByte) {
       return sensor;
     }
   }
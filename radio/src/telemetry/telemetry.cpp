@@ -26,16 +26,14 @@
 #include "mixer_scheduler.h"
 #include "io/multi_protolist.h"
 #include "hal/module_port.h"
+#include "telemetry_stream.h"
+#include "link_history.h"
+#include "crossfire_params.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
 #endif
 
-#if !defined(SIMU)
-  #include <FreeRTOS/include/FreeRTOS.h>
-  #include <FreeRTOS/include/timers.h>
-#endif
-
 #include "spektrum.h"
 
 #if defined(CROSSFIRE)
@@ -61,6 +59,7 @@
 #endif
 
 uint8_t telemetryStreaming = 0;
+uint32_t telemetryValuesCount = 0;
 uint8_t telemetryRxBuffer[TELEMETRY_RX_PACKET_SIZE];
 uint8_t telemetryRxBufferCount = 0;
 
@@ -202,44 +201,6 @@ void telemetryMirrorSend(uint8_t data)
   }
 }
 
-#if !defined(SIMU)
-static TimerHandle_t telemetryTimer = nullptr;
-static StaticTimer_t telemetryTimerBuffer;
-
-static void telemetryTimerCb(TimerHandle_t xTimer)
-{
-  (void)xTimer;
-
-  DEBUG_TIMER_START(debugTimerTelemetryWakeup);
-  telemetryWakeup();
-  DEBUG_TIMER_STOP(debugTimerTelemetryWakeup);
-}
-
-void telemetryStart()
-{
-  if (!telemetryTimer) {
-    telemetryTimer =
-        xTimerCreateStatic("Telem", 2 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
-                           telemetryTimerCb, &telemetryTimerBuffer);
-  }
-
-  if (telemetryTimer) {
-    if( xTimerStart( telemetryTimer, 0 ) != pdPASS ) {
-      /* The timer could not be set into the Active state. */
-    }
-  }
-}
-
-void telemetryStop()
-{
-  if (telemetryTimer) {
-    if( xTimerStop( telemetryTimer, 5 / RTOS_MS_PER_TICK ) != pdPASS ) {
-      /* The timer could not be stopped. */
-    }
-  }
-}
-#endif
-
 inline bool isBadAntennaDetected()
 {
   if (!isRasValueValid())
@@ -264,20 +225,45 @@ static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv,
   auto serial_drv = modulePortGetSerialDrv(mod_st->rx);
   auto serial_ctx = modulePortGetCtx(mod_st->rx);
 
-  if (!serial_drv  || !serial_ctx || !serial_drv->getByte)
+  if (!serial_drv  || !serial_ctx)
     return;
 
   uint8_t* rxBuffer = getTelemetryRxBuffer(module);
   uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
 
+  if (serial_drv->getRxSpan && serial_drv->consumeRx) {
+    // parse the received bytes in place, one contiguous span at a time
+    const uint8_t* span;
+    uint32_t len = serial_drv->getRxSpan(serial_ctx, &span);
+    while (len > 0) {
+      telemetryStreamRaw(module, span, len);
+      LOG_TELEMETRY_RX(module, span, len);
+      if (drv->processSpan) {
+        for (uint32_t i = 0; i < len; i++) {
+          telemetryMirrorSend(span[i]);
+        }
+        drv->processSpan(ctx, span, len, rxBuffer, &rxBufferCount);
+      } else {
+        for (uint32_t i = 0; i < len; i++) {
+          telemetryMirrorSend(span[i]);
+          drv->processData(ctx, span[i], rxBuffer, &rxBufferCount);
+        }
+      }
+      serial_drv->consumeRx(serial_ctx, len);
+      len = serial_drv->getRxSpan(serial_ctx, &span);
+    }
+    return;
+  }
+
+  if (!serial_drv->getByte)
+    return;
+
   uint8_t data;
-  if (serial_drv->getByte(serial_ctx, &data) > 0) {
-    LOG_TELEMETRY_WRITE_START();
-    do {
-      telemetryMirrorSend(data);
-      drv->processData(ctx, data, rxBuffer, &rxBufferCount);
-      LOG_TELEMETRY_WRITE_BYTE(data);
-    } while (serial_drv->getByte(serial_ctx, &data) > 0);
+  while (serial_drv->getByte(serial_ctx, &data) > 0) {
+    telemetryMirrorSend(data);
+    telemetryStreamRaw(module, &data, 1);
+    drv->processData(ctx, data, rxBuffer, &rxBufferCount);
+    LOG_TELEMETRY_RX(module, &data, 1);
   }
 }
 
@@ -286,6 +272,131 @@ static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv,
 // lower.
 volatile uint8_t _telemetryIsPolling = false;
 
+static_assert(MAX_TELEMETRY_SENSORS <= 64,
+              "MAX_TELEMETRY_SENSORS too big for uint64_t dependency mask");
+
+// Calculated sensors are evaluated after the sensors they are computed
+// from, so that chains (e.g. Cells -> Min cell -> Sum) are resolved in one
+// wakeup. The order is computed again when the model changes.
+static uint8_t calcSensorsOrder[MAX_TELEMETRY_SENSORS];
+static uint8_t calcSensorsCount;
+static uint16_t calcSensorsRevision;
+static bool calcSensorsValid = false;
+
+// Returns the sensors read by eval() (1-based indexes, 0 if unused)
+static uint8_t getCalculatedSensorInputs(const TelemetrySensor & sensor, uint8_t * inputs)
+{
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      inputs[0] = sensor.cell.source;
+      return 1;
+
+    case TELEM_FORMULA_DIST:
+      inputs[0] = sensor.dist.gps;
+      inputs[1] = sensor.dist.alt;
+      return 2;
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY:
+      for (uint8_t i = 0; i < 4; i++) {
+        inputs[i] = abs(sensor.calc.sources[i]);
+      }
+      return 4;
+
+    default:
+      // consumption and totalize are updated elsewhere
+      return 0;
+  }
+}
+
+static void updateCalculatedSensorsOrder()
+{
+  if (calcSensorsValid && calcSensorsRevision == modelDataRevision)
+    return;
+
+  uint64_t deps[MAX_TELEMETRY_SENSORS];
+  uint64_t pending = 0;
+  for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    deps[i] = 0;
+    if (sensor.type != TELEM_TYPE_CALCULATED)
+      continue;
+    uint8_t inputs[4];
+    uint8_t count = getCalculatedSensorInputs(sensor, inputs);
+    for (uint8_t n = 0; n < count; n++) {
+      if (inputs[n] > 0 && inputs[n] <= MAX_TELEMETRY_SENSORS && inputs[n] != i + 1)
+        deps[i] |= (uint64_t)1 << (inputs[n] - 1);
+    }
+    pending |= (uint64_t)1 << i;
+    // force the first evaluation
+    telemetryItems[i].inputsKey = 0;
+  }
+
+  uint8_t count = 0;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+      uint64_t bit = (uint64_t)1 << i;
+      if ((pending & bit) && !(deps[i] & pending)) {
+        calcSensorsOrder[count++] = i;
+        pending &= ~bit;
+        progress = true;
+      }
+    }
+  }
+
+  // loops are evaluated in index order
+  for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (pending & ((uint64_t)1 << i)) {
+      calcSensorsOrder[count++] = i;
+    }
+  }
+
+  calcSensorsCount = count;
+  calcSensorsRevision = modelDataRevision;
+  calcSensorsValid = true;
+}
+
+// Changes whenever one of the inputs receives a value, or becomes old or
+// unavailable. Never 0, which is kept for sensors not evaluated yet.
+static uint16_t getCalculatedSensorInputsKey(const TelemetrySensor & sensor)
+{
+  uint8_t inputs[4];
+  uint8_t count = getCalculatedSensorInputs(sensor, inputs);
+  uint16_t key = 5381;
+  for (uint8_t n = 0; n < count; n++) {
+    uint8_t state = 0;
+    if (inputs[n] > 0 && inputs[n] <= MAX_TELEMETRY_SENSORS) {
+      TelemetryItem & item = telemetryItems[inputs[n] - 1];
+      state = item.generation + (item.isOld() ? 0x55 : (item.isAvailable() ? 0 : 0xAA));
+    }
+    key = ((key << 5) + key) + state;
+  }
+  return key ? key : 1;
+}
+
+static void evalCalculatedSensors()
+{
+  updateCalculatedSensorsOrder();
+
+  for (uint8_t n = 0; n < calcSensorsCount; n++) {
+    uint8_t i = calcSensorsOrder[n];
+    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    if (sensor.type != TELEM_TYPE_CALCULATED)
+      continue;
+    TelemetryItem & item = telemetryItems[i];
+    uint16_t key = getCalculatedSensorInputsKey(sensor);
+    if (key != item.inputsKey) {
+      item.inputsKey = key;
+      item.eval(sensor);
+    }
+  }
+}
+
 void telemetryWakeup()
 {
   _telemetryIsPolling = true;
@@ -293,15 +404,19 @@ void telemetryWakeup()
     auto mod = pulsesGetModuleDriver(i);
     if (!mod) continue;
     pollTelemetry(i, mod->drv, mod->ctx);
+    if (mod->drv && mod->drv->processQueued) {
+      mod->drv->processQueued(mod->ctx);
+    }
   }
   _telemetryIsPolling = false;
 
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
+  telemetryStreamWakeup();
+  linkHistoryWakeup();
+
+#if defined(CROSSFIRE)
+  crossfireParamsWakeup();
+#endif
 
 #if defined(VARIO)
   if (TELEMETRY_STREAMING() && !IS_FAI_ENABLED()) {
@@ -419,6 +534,12 @@ void telemetryReset()
     telemetryItem.clear();
   }
 
+#if defined(LUA)
+  telemetryStatsReset();
+#endif
+
+  linkHistoryReset();
+
   telemetryStreaming = 0; // reset counter only if valid telemetry packets are being detected
 
   telemetryState = TELEMETRY_INIT;
@@ -476,23 +597,136 @@ void telemetryInit(uint8_t protocol)
 
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
 extern FIL g_telemetryFile;
-void logTelemetryWriteStart()
+
+#define TELEMETRY_CAPTURE_BLOCK        512
+#define TELEMETRY_CAPTURE_HEADER       6
+#define TELEMETRY_CAPTURE_MAX_DATA     255
+
+// written by the mixer task (captureHead) and the menus task (captureTail),
+// both only ever increase so that they can be compared without locking
+static uint8_t captureBuffer[8 * TELEMETRY_CAPTURE_BLOCK] __DMA;
+static volatile uint32_t captureHead = 0;
+static volatile uint32_t captureTail = 0;
+static volatile bool captureEnabled = false;
+static uint32_t captureDropped = 0;
+static uint8_t captureBlocks = 0;
+
+static void capturePut(uint32_t pos, const uint8_t * data, uint32_t len)
 {
-  static tmr10ms_t lastTime = 0;
-  tmr10ms_t newTime = get_tmr10ms();
-  if (lastTime != newTime) {
-    struct gtm utm;
-    gettime(&utm);
-    f_printf(&g_telemetryFile, "\r\n%4d-%02d-%02d,%02d:%02d:%02d.%02d0:",
-             utm.tm_year + TM_YEAR_BASE, utm.tm_mon + 1, utm.tm_mday,
-             utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
-    lastTime = newTime;
+  for (uint32_t i = 0; i < len; i++) {
+    captureBuffer[(pos + i) % sizeof(captureBuffer)] = data[i];
   }
 }
 
-void logTelemetryWriteByte(uint8_t data)
+static uint32_t captureRecord(uint32_t pos, uint8_t flags, const uint8_t * data, uint8_t len)
 {
-  f_printf(&g_telemetryFile, " %02X", data);
+  uint32_t time = RTOS_GET_MS();
+  uint8_t header[TELEMETRY_CAPTURE_HEADER] = {
+    uint8_t(time), uint8_t(time >> 8), uint8_t(time >> 16), uint8_t(time >> 24),
+    flags, len
+  };
+  capturePut(pos, header, TELEMETRY_CAPTURE_HEADER);
+  if (data) {
+    capturePut(pos + TELEMETRY_CAPTURE_HEADER, data, len);
+  }
+  else {
+    for (uint32_t i = 0; i < len; i++) {
+      captureBuffer[(pos + TELEMETRY_CAPTURE_HEADER + i) % sizeof(captureBuffer)] = 0;
+    }
+  }
+  return TELEMETRY_CAPTURE_HEADER + len;
+}
+
+void logTelemetryCapture(uint8_t flags, const uint8_t * data, uint32_t len)
+{
+  if (!captureEnabled)
+    return;
+
+  while (len > 0) {
+    uint8_t count = min<uint32_t>(len, TELEMETRY_CAPTURE_MAX_DATA);
+    uint32_t head = captureHead;
+    if (head + TELEMETRY_CAPTURE_HEADER + count - captureTail > sizeof(captureBuffer)) {
+      // the SD card is too slow or not there, better lose frames than timing
+      captureDropped++;
+      return;
+    }
+    captureHead = head + captureRecord(head, flags, data, count);
+    data += count;
+    len -= count;
+  }
+}
+
+void logTelemetryOpen()
+{
+  if (f_open(&g_telemetryFile, LOGS_PATH "/telemetry.bin", FA_OPEN_ALWAYS | FA_WRITE) != FR_OK)
+    return;
+  if (f_size(&g_telemetryFile) > 0) {
+    f_lseek(&g_telemetryFile, f_size(&g_telemetryFile)); // append
+  }
+  captureHead = captureTail = 0;
+  captureBlocks = 0;
+  captureEnabled = true;
+}
+
+void logTelemetryFlush()
+{
+  if (!captureEnabled)
+    return;
+
+  // only whole blocks, at block boundaries in the file: they go straight
+  // to the card without going through the FatFs sector buffer
+  while (captureHead - captureTail >= TELEMETRY_CAPTURE_BLOCK) {
+    UINT written;
+    f_write(&g_telemetryFile, &captureBuffer[captureTail % sizeof(captureBuffer)],
+            TELEMETRY_CAPTURE_BLOCK, &written);
+    captureTail += TELEMETRY_CAPTURE_BLOCK;
+    if (++captureBlocks >= 8) {
+      // keep the file size up to date in case of power loss
+      f_sync(&g_telemetryFile);
+      captureBlocks = 0;
+    }
+  }
+
+  if (captureDropped) {
+    TRACE("Telemetry capture: %d records dropped", captureDropped);
+    captureDropped = 0;
+  }
+}
+
+void logTelemetryClose()
+{
+  if (!captureEnabled)
+    return;
+
+  logTelemetryFlush();
+
+  // The mixer task has a higher priority: it is never interrupted in the
+  // middle of a record by this task, and adds none once disabled
+  captureEnabled = false;
+
+  // complete the last block with padding records, so that the next session
+  // appends at a block boundary too
+  uint32_t head = captureHead;
+  uint32_t gap = (TELEMETRY_CAPTURE_BLOCK - head % TELEMETRY_CAPTURE_BLOCK) % TELEMETRY_CAPTURE_BLOCK;
+  if (gap > 0 && gap < TELEMETRY_CAPTURE_HEADER)
+    gap += TELEMETRY_CAPTURE_BLOCK;
+  while (gap > 0) {
+    uint32_t size = min<uint32_t>(gap, TELEMETRY_CAPTURE_HEADER + TELEMETRY_CAPTURE_MAX_DATA);
+    if (gap - size > 0 && gap - size < TELEMETRY_CAPTURE_HEADER)
+      size = gap - TELEMETRY_CAPTURE_HEADER;
+    head += captureRecord(head, TELEMETRY_CAPTURE_PADDING, nullptr, size - TELEMETRY_CAPTURE_HEADER);
+    gap -= size;
+  }
+
+  // at most 2 blocks were pending, the buffer has room for them
+  while (head - captureTail >= TELEMETRY_CAPTURE_BLOCK) {
+    UINT written;
+    f_write(&g_telemetryFile, &captureBuffer[captureTail % sizeof(captureBuffer)],
+            TELEMETRY_CAPTURE_BLOCK, &written);
+    captureTail += TELEMETRY_CAPTURE_BLOCK;
+  }
+
+  f_close(&g_telemetryFile);
 }
 #endif
 
@@ -502,6 +736,30 @@ OutputTelemetryBuffer outputTelemetryBuffer __DMA;
 Fifo<uint8_t, LUA_TELEMETRY_INPUT_FIFO_SIZE> * luaInputTelemetryFifo = NULL;
 #endif
 
+void spectrumAnalyserSetColumns(uint32_t x, uint8_t width, uint8_t power)
+{
+  auto& spectrum = reusableBuffer.spectrumAnalyser;
+
+  uint32_t end = min<uint32_t>(x + width, LCD_W);
+  if (x >= end) return;
+
+  for (uint32_t i = x; i < end; i++) {
+    spectrum.bars[i] = power;
+    if (power >= spectrum.max[i])
+      spectrum.max[i] = power;
+#if defined(COLORLCD)
+    else
+      spectrum.max[i]--;  // peak decays with each new sweep
+#endif
+    // 1/8 exponential average
+    spectrum.avg[i] = (spectrum.avg[i] * 7 + power + 4) / 8;
+  }
+
+  // columns to be redrawn
+  if (x < spectrum.changedFrom) spectrum.changedFrom = x;
+  if (end > spectrum.changedTo) spectrum.changedTo = end;
+}
+
 #if defined(HARDWARE_INTERNAL_MODULE)
 static ModuleSyncStatus moduleSyncStatus[NUM_MODULES];
 
@@ -523,6 +781,15 @@ ModuleSyncStatus::ModuleSyncStatus()
   memset(this, 0, sizeof(ModuleSyncStatus));
 }
 
+// Phase lock loop settings: each lag report applies 1/SYNC_PHASE_GAIN_DIV
+// of the error as a phase step, spread over periods of at most
+// 1/SYNC_PHASE_STEP_DIV of the refresh rate, and learns the drift
+// between both clocks as a period trim with 1/SYNC_TRIM_GAIN_DIV gain.
+#define SYNC_PHASE_GAIN_DIV  2
+#define SYNC_PHASE_STEP_DIV  8
+#define SYNC_TRIM_GAIN_DIV   4
+#define SYNC_TRIM_MAX_DIV    64
+
 void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag)
 {
   if (!newRefreshRate)
@@ -533,13 +800,34 @@ void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag)
   else if (newRefreshRate > MAX_REFRESH_RATE)
     newRefreshRate = MAX_REFRESH_RATE;
 
+  if (!isValid() || newRefreshRate != refreshRate) {
+    // (re)acquire the lock from scratch
+    periodTrim = 0;
+    trimRemainder = 0;
+    lagAverage = newInputLag;
+    lagJitter = 0;
+  }
+  else if (periodsSinceUpdate > 0) {
+    // the lag left since the last report is the drift between both clocks
+    int32_t trimMax = ((int32_t)newRefreshRate << 8) / SYNC_TRIM_MAX_DIV;
+    periodTrim += ((int32_t)newInputLag << 8) /
+                  ((int32_t)periodsSinceUpdate * SYNC_TRIM_GAIN_DIV);
+    periodTrim = limit<int32_t>(-trimMax, periodTrim, trimMax);
+
+    int32_t deviation = newInputLag - lagAverage;
+    lagJitter = (lagJitter * 7 + abs(deviation)) / 8;
+    lagAverage = (lagAverage * 7 + newInputLag) / 8;
+  }
+
   refreshRate = newRefreshRate;
   inputLag    = newInputLag;
-  currentLag  = newInputLag;
+  currentLag  = newInputLag / SYNC_PHASE_GAIN_DIV;
   lastUpdate  = get_tmr10ms();
+  periodsSinceUpdate = 0;
 
 #if 0
-  TRACE("[SYNC] update rate = %dus; lag = %dus",refreshRate,currentLag);
+  TRACE("[SYNC] update rate = %dus; lag = %dus; trim = %d/256us",
+        refreshRate, inputLag, periodTrim);
 #endif
 }
 
@@ -550,15 +838,19 @@ void ModuleSyncStatus::invalidate() {
 
 uint16_t ModuleSyncStatus::getAdjustedRefreshRate()
 {
-  int16_t lag = currentLag;
-  int32_t newRefreshRate = refreshRate;
+  if (periodsSinceUpdate < UINT16_MAX)
+    periodsSinceUpdate++;
+
+  // frequency correction, keeping the fractional part for later periods
+  int32_t trim = (periodTrim + trimRemainder) / 256;
+  trimRemainder = periodTrim + trimRemainder - trim * 256;
+  int32_t lockedRefreshRate = refreshRate + trim;
+
+  // phase correction
+  int32_t maxStep = refreshRate / SYNC_PHASE_STEP_DIV;
+  int32_t newRefreshRate =
+      lockedRefreshRate + limit<int32_t>(-maxStep, currentLag, maxStep);
 
-  if (lag == 0) {
-    return refreshRate;
-  }
-  
-  newRefreshRate += lag;
-  
   if (newRefreshRate < MIN_REFRESH_RATE) {
       newRefreshRate = MIN_REFRESH_RATE;
   }
@@ -566,7 +858,7 @@ uint16_t ModuleSyncStatus::getAdjustedRefreshRate()
     newRefreshRate = MAX_REFRESH_RATE;
   }
 
-  currentLag -= newRefreshRate - refreshRate;
+  currentLag -= newRefreshRate - lockedRefreshRate;
 #if 0
   TRACE("[SYNC] mod rate = %dus; lag = %dus",newRefreshRate,currentLag);
 #endif
@@ -583,7 +875,9 @@ void ModuleSyncStatus::getRefreshString(char * statusText)
   char * tmp = statusText;
 #if defined(DEBUG)
   *tmp++ = 'L';
-  tmp = strAppendSigned(tmp, inputLag, 5);
+  tmp = strAppendSigned(tmp, lagAverage, 5);
+  tmp = strAppend(tmp, "J");
+  tmp = strAppendUnsigned(tmp, lagJitter, 4);
   tmp = strAppend(tmp, "R");
   tmp = strAppendUnsigned(tmp, refreshRate, 5);
 #else
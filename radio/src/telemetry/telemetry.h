@@ -31,6 +31,7 @@
 #include "io/frsky_sport.h"
 
 extern uint8_t telemetryStreaming; // >0 (true) == data is streaming in. 0 = no data detected for some time
+extern uint32_t telemetryValuesCount; // sensor values received since boot
 
 inline bool TELEMETRY_STREAMING()
 {
@@ -189,14 +190,27 @@ inline uint8_t modelTelemetryProtocol()
 
 #include "telemetry_sensors.h"
 
+// Raw capture to LOGS_PATH "/telemetry.bin": one record per received span
+// or sent telemetry frame, little endian:
+//   uint32 time (ms), uint8 flags, uint8 length, data[length]
+// flags: module index in bits 0-6, bit 7 set for frames sent to the module,
+// 0xFF for padding records. Records are buffered in RAM and written by the
+// menus task in whole 512 bytes blocks.
+#define TELEMETRY_CAPTURE_TX           0x80
+#define TELEMETRY_CAPTURE_PADDING      0xFF
+
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
-void logTelemetryWriteStart();
-void logTelemetryWriteByte(uint8_t data);
-#define LOG_TELEMETRY_WRITE_START()    logTelemetryWriteStart()
-#define LOG_TELEMETRY_WRITE_BYTE(data) logTelemetryWriteByte(data)
+void logTelemetryCapture(uint8_t flags, const uint8_t * data, uint32_t len);
+void logTelemetryOpen();
+void logTelemetryFlush();
+void logTelemetryClose();
+#define LOG_TELEMETRY_RX(module, data, len) logTelemetryCapture(module, data, len)
+#define LOG_TELEMETRY_TX(module, data, len) logTelemetryCapture((module) | TELEMETRY_CAPTURE_TX, data, len)
+#define LOG_TELEMETRY_FLUSH()               logTelemetryFlush()
 #else
-#define LOG_TELEMETRY_WRITE_START()
-#define LOG_TELEMETRY_WRITE_BYTE(data)
+#define LOG_TELEMETRY_RX(module, data, len)
+#define LOG_TELEMETRY_TX(module, data, len)
+#define LOG_TELEMETRY_FLUSH()
 #endif
 #define TELEMETRY_OUTPUT_BUFFER_SIZE  64
 
@@ -284,13 +298,24 @@ extern OutputTelemetryBuffer outputTelemetryBuffer __DMA;
 
 #if defined(LUA)
 #include "fifo.h"
-#define LUA_TELEMETRY_INPUT_FIFO_SIZE  256
+// Large enough to hold a whole burst of ELRS / Crossfire parameter frames
+#if !defined(LUA_TELEMETRY_INPUT_FIFO_SIZE)
+  #if defined(COLORLCD)
+    #define LUA_TELEMETRY_INPUT_FIFO_SIZE  1024
+  #else
+    #define LUA_TELEMETRY_INPUT_FIFO_SIZE  512
+  #endif
+#endif
 extern Fifo<uint8_t, LUA_TELEMETRY_INPUT_FIFO_SIZE> * luaInputTelemetryFifo;
 #endif
 
 void processPXX2Frame(uint8_t idx, const uint8_t* frame,
                       const etx_serial_driver_t* drv, void* ctx);
 
+// Store a power sample received from the module into `width` spectrum
+// analyser columns starting at x, updating peak and average in place
+void spectrumAnalyserSetColumns(uint32_t x, uint8_t width, uint8_t power);
+
 // Module pulse synchronization
 struct ModuleSyncStatus
 {
@@ -299,8 +324,17 @@ struct ModuleSyncStatus
   int16_t   inputLag;    // in us
 
   tmr10ms_t lastUpdate;  // in 10ms
-  int16_t   currentLag;  // in us
-  
+  int16_t   currentLag;  // phase correction still to apply, in us
+
+  // phase lock: period trim learnt from the lag drift
+  int32_t   periodTrim;        // in 1/256 us per period
+  int16_t   trimRemainder;     // in 1/256 us
+  uint16_t  periodsSinceUpdate;
+
+  // achieved lag, filtered, in us
+  int16_t   lagAverage;
+  uint16_t  lagJitter;
+
   inline bool isValid() const {
     // 2 seconds
     return (get_tmr10ms() - lastUpdate < 200);
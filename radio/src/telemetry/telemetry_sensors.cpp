@@ -56,6 +56,117 @@
 #endif
 
 TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
+
+#if defined(LUA)
+static TelemetryStats telemetryStats[TELEMETRY_STATS_COUNT];
+static uint64_t telemetryStatsSensors; // one bit per sensor having stats
+static_assert(MAX_TELEMETRY_SENSORS <= 64, "telemetryStatsSensors too small");
+
+void TelemetryStats::reset(uint8_t index)
+{
+  memclear(this, sizeof(TelemetryStats));
+  sensor = index + 1;
+  second = get_tmr10ms() / 100;
+}
+
+void TelemetryStats::add(int32_t value, uint16_t now)
+{
+  uint16_t elapsed = now - second;
+  if (elapsed > 0) {
+    elapsed = min<uint16_t>(elapsed, TELEMETRY_STATS_SECONDS + 1);
+    while (elapsed--) {
+      current = (current + 1) % (TELEMETRY_STATS_SECONDS + 1);
+      sums[current] = 0;
+      counts[current] = 0;
+    }
+    second = now;
+  }
+
+  if (counts[current] < UINT8_MAX) {
+    sums[current] += value;
+    counts[current]++;
+  }
+}
+
+bool TelemetryStats::getBucket(uint8_t age, uint16_t now,
+                               int32_t & average) const
+{
+  // no value was received during the seconds after the current bucket
+  uint16_t idle = now - second;
+  if (age < idle) return false;
+
+  uint16_t back = age - idle;
+  if (back > TELEMETRY_STATS_SECONDS) return false;
+
+  uint8_t index = (current + TELEMETRY_STATS_SECONDS + 1 - back) %
+                  (TELEMETRY_STATS_SECONDS + 1);
+  if (counts[index] == 0) return false;
+
+  average = sums[index] / counts[index];
+  return true;
+}
+
+bool TelemetryStats::getAverage(uint8_t seconds, uint16_t now,
+                                int32_t & result) const
+{
+  int32_t sum = 0;
+  uint8_t count = 0;
+  for (uint8_t age = 1; age <= seconds; age++) {
+    int32_t average;
+    if (getBucket(age, now, average)) {
+      sum += average;
+      count++;
+    }
+  }
+  if (count == 0) return false;
+  result = sum / count;
+  return true;
+}
+
+bool TelemetryStats::getChange(uint8_t seconds, uint16_t now,
+                               int32_t & delta, uint8_t & elapsed) const
+{
+  int32_t newest = 0;
+  uint8_t newestAge = 0;
+  int32_t oldest = 0;
+  uint8_t oldestAge = 0;
+  for (uint8_t age = 1; age <= seconds; age++) {
+    int32_t average;
+    if (getBucket(age, now, average)) {
+      if (newestAge == 0) {
+        newest = average;
+        newestAge = age;
+      }
+      oldest = average;
+      oldestAge = age;
+    }
+  }
+  if (oldestAge == newestAge) return false;
+  delta = newest - oldest;
+  elapsed = oldestAge - newestAge;
+  return true;
+}
+
+TelemetryStats * getTelemetryStats(uint8_t index)
+{
+  TelemetryStats * unused = nullptr;
+  for (auto & stats : telemetryStats) {
+    if (stats.sensor == index + 1) return &stats;
+    if (stats.sensor == 0 && !unused) unused = &stats;
+  }
+  if (unused) {
+    unused->reset(index);
+    telemetryStatsSensors |= (uint64_t)1 << index;
+  }
+  return unused;
+}
+
+void telemetryStatsReset()
+{
+  telemetryStatsSensors = 0;
+  memclear(telemetryStats, sizeof(telemetryStats));
+}
+#endif
 uint8_t allowNewSensors;
 
 bool isFaiForbidden(source_t idx)
@@ -265,6 +376,13 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
     }
   }
 
+#if defined(LUA)
+  uint8_t index = this - telemetryItems;
+  if (telemetryStatsSensors & ((uint64_t)1 << index)) {
+    getTelemetryStats(index)->add(newVal, get_tmr10ms() / 100);
+  }
+#endif
+
   value = newVal;
   setFresh();
 }
@@ -465,10 +583,113 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
   }
 }
 
+// Open addressing index of the custom sensor slots by (id, subId), so
+// that incoming values do not scan every slot. Entries hold the slot + 1,
+// sensors sharing the same key each get their own entry along the same
+// probe sequence. It is rebuilt whenever the model data changes.
+#define SENSOR_INDEX_BITS  7
+#define SENSOR_INDEX_SIZE  (1 << SENSOR_INDEX_BITS)
+static_assert(SENSOR_INDEX_SIZE >= 2 * MAX_TELEMETRY_SENSORS,
+              "sensor index too small");
+
+static uint8_t sensorIndex[SENSOR_INDEX_SIZE];
+static uint16_t sensorIndexRevision;
+static bool sensorIndexValid = false;
+
+static inline uint8_t sensorIndexHash(uint16_t id, uint8_t subId)
+{
+  return (uint16_t)((id ^ (subId << 11)) * 0x9E37u) >> (16 - SENSOR_INDEX_BITS);
+}
+
+// Discovery of new sensors. Only a few sensors are created per 10ms tick,
+// so that a burst of unknown sensors (e.g. many ESC instances) is spread
+// over several ticks: the next values of the deferred ones create them.
+// Keys which did not get a slot because the table is full are kept in a
+// small set, so that their values are dropped without another attempt.
+#define SENSOR_DISCOVERY_PER_TICK  4
+#define UNASSIGNED_KEYS_BITS       5
+#define UNASSIGNED_KEYS_SIZE       (1 << UNASSIGNED_KEYS_BITS)
+
+struct UnassignedKey {
+  uint16_t id;
+  uint8_t subId;
+  uint8_t instance;
+  uint8_t protocol;  // protocol + 1, 0 when unused
+};
+
+static UnassignedKey unassignedKeys[UNASSIGNED_KEYS_SIZE];
+static uint8_t firstFreeSensor;  // no free slot below
+static tmr10ms_t discoveryTick;
+static uint8_t discoveryCount;
+
+static void sensorIndexInsert(int index)
+{
+  const TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+  uint8_t h = sensorIndexHash(telemetrySensor.id, telemetrySensor.subId);
+  while (sensorIndex[h])
+    h = (h + 1) & (SENSOR_INDEX_SIZE - 1);
+  sensorIndex[h] = index + 1;
+}
+
+static void checkSensorIndex()
+{
+  if (sensorIndexValid && sensorIndexRevision == modelDataRevision)
+    return;
+
+  memclear(sensorIndex, sizeof(sensorIndex));
+  firstFreeSensor = MAX_TELEMETRY_SENSORS;
+  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    const TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+    if (!telemetrySensor.isAvailable() && firstFreeSensor == MAX_TELEMETRY_SENSORS)
+      firstFreeSensor = index;
+    if (telemetrySensor.type == TELEM_TYPE_CUSTOM)
+      sensorIndexInsert(index);
+  }
+
+  // a slot may have been freed, or another model loaded
+  memclear(unassignedKeys, sizeof(unassignedKeys));
+  discoveryCount = 0;
+
+  sensorIndexRevision = modelDataRevision;
+  sensorIndexValid = true;
+}
+
+static UnassignedKey * findUnassignedKey(TelemetryProtocol protocol,
+                                         uint16_t id, uint8_t subId,
+                                         uint8_t instance, bool insert)
+{
+  uint8_t h = (sensorIndexHash(id, subId) ^ instance) &
+              (UNASSIGNED_KEYS_SIZE - 1);
+  for (uint8_t i = 0; i < UNASSIGNED_KEYS_SIZE; i++) {
+    UnassignedKey &key = unassignedKeys[h];
+    if (!key.protocol) {
+      if (!insert) return nullptr;
+      key = {id, subId, instance, (uint8_t)(protocol + 1)};
+      return &key;
+    }
+    if (key.protocol == protocol + 1 && key.id == id && key.subId == subId &&
+        key.instance == instance)
+      return &key;
+    h = (h + 1) & (UNASSIGNED_KEYS_SIZE - 1);
+  }
+  return nullptr;
+}
+
+static int discoveryFreeIndex()
+{
+  while (firstFreeSensor < MAX_TELEMETRY_SENSORS) {
+    if (!g_model.telemetrySensors[firstFreeSensor].isAvailable())
+      return firstFreeSensor;
+    firstFreeSensor++;
+  }
+  return -1;
+}
+
 void delTelemetryIndex(uint8_t index)
 {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
   telemetryItems[index].clear();
+  sensorIndexValid = false;
   storageDirty(EE_MODEL);
 }
 
@@ -501,7 +722,11 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 {
   bool sensorFound = false;
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+  telemetryValuesCount++;
+  checkSensorIndex();
+  for (uint8_t h = sensorIndexHash(id, subId); sensorIndex[h];
+       h = (h + 1) & (SENSOR_INDEX_SIZE - 1)) {
+    int index = sensorIndex[h] - 1;
     TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
 
     if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
@@ -520,8 +745,25 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
     return -1;
   }
 
-  int index = availableTelemetryIndex();
+  if (findUnassignedKey(protocol, id, subId, instance, false)) {
+    return -1;
+  }
+
+  tmr10ms_t now = get_tmr10ms();
+  if (discoveryTick != now) {
+    discoveryTick = now;
+    discoveryCount = 0;
+  }
+  if (discoveryCount >= SENSOR_DISCOVERY_PER_TICK) {
+    return -1;
+  }
+
+  int index = discoveryFreeIndex();
   if (index >= 0) {
+    discoveryCount++;
+    // the new sensor changes the key of this slot, it is added to the
+    // index below once its defaults are set
+    sensorIndexValid = false;
     switch (protocol) {
       case PROTOCOL_TELEMETRY_FRSKY_SPORT:
         frskySportSetDefault(index, id, subId, instance);
@@ -585,11 +827,18 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
       default:
         return index;
     }
+
+    // only this slot was changed by the defaults
+    sensorIndexInsert(index);
+    sensorIndexRevision = modelDataRevision;
+    sensorIndexValid = true;
+
     telemetryItems[index].setValue(g_model.telemetrySensors[index], value, unit, prec);
     return index;
   }
   else {
-    POPUP_WARNING(STR_TELEMETRYFULL);
+    if (findUnassignedKey(protocol, id, subId, instance, true))
+      POPUP_WARNING(STR_TELEMETRYFULL);
     return -1;
   }
 }
@@ -22,6 +22,7 @@
 #ifndef _TELEMETRY_SENSORS_H_
 #define _TELEMETRY_SENSORS_H_
 
+#include <algorithm>
 #include "telemetry.h"
 
 constexpr int8_t TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE = -2;
@@ -49,6 +50,9 @@ class TelemetryItem
 
     int8_t timeout; // for detection of sensor loss
 
+    uint8_t generation;   // incremented on each new value
+    uint16_t inputsKey;   // inputs seen by the last eval() (calculated sensors)
+
     union {
       struct {
         int32_t  offsetAuto;
@@ -125,6 +129,7 @@ class TelemetryItem
     inline void setFresh()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_START;
+      generation++;
     }
 
     inline void setOld()
@@ -134,7 +139,54 @@ class TelemetryItem
 };
 
 extern TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
+
+#if defined(LUA)
+constexpr uint8_t TELEMETRY_STATS_SECONDS = 10;
+constexpr uint8_t TELEMETRY_STATS_COUNT = 8;
+
+// Sums of the values received during each of the last seconds, so that
+// averages and rates over a few seconds cost O(1) per value
+class TelemetryStats
+{
+  public:
+    void reset(uint8_t index);
+    void add(int32_t value, uint16_t now);
+    bool getAverage(uint8_t seconds, uint16_t now, int32_t & result) const;
+    // change between the oldest and the newest second with values
+    bool getChange(uint8_t seconds, uint16_t now, int32_t & delta,
+                   uint8_t & elapsed) const;
+
+    uint8_t sensor;   // index + 1, 0 when unused
+
+  protected:
+    // the current second is in sums[current], it is not used until complete
+    int32_t sums[TELEMETRY_STATS_SECONDS + 1];
+    uint8_t counts[TELEMETRY_STATS_SECONDS + 1];
+    uint8_t current;
+    uint16_t second;
+
+    bool getBucket(uint8_t age, uint16_t now, int32_t & average) const;
+};
+
+// Returns the statistics of a sensor, they are started on the first call
+// and nullptr is returned once all TELEMETRY_STATS_COUNT are in use
+TelemetryStats * getTelemetryStats(uint8_t index);
+void telemetryStatsReset();
+#endif
 extern uint8_t allowNewSensors;
 bool isFaiForbidden(source_t idx);
 
+// Binary search in a protocol sensor table sorted by id and terminated by
+// a sentinel
+template <class T, size_t N>
+const T * findSortedSensor(const T (&sensors)[N], const uint16_t T::*id,
+                           uint16_t value)
+{
+  const T * end = sensors + N - 1;
+  const T * sensor = std::lower_bound(
+      sensors, end, value,
+      [=](const T & sensor, uint16_t value) { return sensor.*id < value; });
+  return (sensor != end && sensor->*id == value) ? sensor : nullptr;
+}
+
 #endif // _TELEMETRY_SENSORS_H_
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "telemetry_stream.h"
+
+#define TELEMETRY_STREAM_BUFFER_SIZE  512
+#define TELEMETRY_STREAM_HEADER_SIZE  3
+#define TELEMETRY_STREAM_MAX_PAYLOAD  255
+
+static void* streamCtx = nullptr;
+static const etx_serial_driver_t* streamDrv = nullptr;
+
+static uint8_t streamBuffer[TELEMETRY_STREAM_BUFFER_SIZE];
+static uint16_t streamCount = 0;
+
+// header of the frame being filled, or -1
+static int16_t streamFrame = -1;
+static uint8_t streamFrameModule = 0xFF;
+
+static uint8_t streamSensorGeneration[MAX_TELEMETRY_SENSORS];
+static uint32_t streamLastChannels = 0;
+
+void telemetryStreamSetSerialDriver(void* ctx, const etx_serial_driver_t* drv)
+{
+  streamDrv = nullptr;
+  streamCtx = ctx;
+  streamCount = 0;
+  streamFrame = -1;
+  memset(streamSensorGeneration, 0, sizeof(streamSensorGeneration));
+  streamDrv = drv;
+}
+
+static void streamCloseFrame()
+{
+  if (streamFrame < 0) return;
+
+  uint8_t* frame = &streamBuffer[streamFrame];
+  streamBuffer[streamCount++] = crc8(frame + 1, 2 + frame[2]);
+  streamFrame = -1;
+}
+
+static void streamFlush()
+{
+  streamCloseFrame();
+  if (!streamCount) return;
+
+  auto drv = streamDrv;
+  if (drv) {
+    if (drv->sendBuffer) {
+      drv->sendBuffer(streamCtx, streamBuffer, streamCount);
+    } else if (drv->sendByte) {
+      for (uint16_t i = 0; i < streamCount; i++) {
+        drv->sendByte(streamCtx, streamBuffer[i]);
+      }
+    }
+  }
+  streamCount = 0;
+}
+
+// Room for 'len' more payload bytes in the current frame,
+// otherwise starts a new frame of 'type'
+static void streamReserve(uint8_t type, uint8_t len)
+{
+  if (streamFrame >= 0 && streamBuffer[streamFrame + 1] == type &&
+      streamBuffer[streamFrame + 2] + len <= TELEMETRY_STREAM_MAX_PAYLOAD &&
+      streamCount + len + 1 <= TELEMETRY_STREAM_BUFFER_SIZE) {
+    return;
+  }
+
+  streamCloseFrame();
+  if (streamCount + TELEMETRY_STREAM_HEADER_SIZE + len + 1 >
+      TELEMETRY_STREAM_BUFFER_SIZE) {
+    streamFlush();
+  }
+
+  streamFrame = streamCount;
+  streamBuffer[streamCount++] = TELEMETRY_STREAM_SYNC;
+  streamBuffer[streamCount++] = type;
+  streamBuffer[streamCount++] = 0;
+}
+
+static void streamWrite(const void* data, uint8_t len)
+{
+  memcpy(&streamBuffer[streamCount], data, len);
+  streamCount += len;
+  streamBuffer[streamFrame + 2] += len;
+}
+
+void telemetryStreamRaw(uint8_t module, const uint8_t* data, uint32_t len)
+{
+  if (!streamDrv) return;
+
+  while (len > 0) {
+    uint8_t chunk = min<uint32_t>(len, TELEMETRY_STREAM_MAX_PAYLOAD - 1);
+    if (streamFrameModule != module) {
+      streamCloseFrame();
+      streamFrameModule = module;
+    }
+
+    // the module index starts each frame
+    streamReserve(TELEMETRY_STREAM_RAW, chunk + 1);
+    if (streamBuffer[streamFrame + 2] == 0) {
+      streamWrite(&module, 1);
+    }
+    streamWrite(data, chunk);
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+static void streamChannels(uint32_t now)
+{
+  streamReserve(TELEMETRY_STREAM_CHANNELS,
+                sizeof(now) + MAX_OUTPUT_CHANNELS * sizeof(int16_t));
+  streamWrite(&now, sizeof(now));
+  streamWrite(channelOutputs, MAX_OUTPUT_CHANNELS * sizeof(int16_t));
+  streamCloseFrame();
+}
+
+static void streamSensors()
+{
+  for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (!isTelemetryFieldAvailable(i)) continue;
+
+    TelemetryItem& item = telemetryItems[i];
+    if (!item.isAvailable() || item.generation == streamSensorGeneration[i])
+      continue;
+    streamSensorGeneration[i] = item.generation;
+
+    const TelemetrySensor& sensor = g_model.telemetrySensors[i];
+    uint8_t entry[7] = {i};
+    memcpy(&entry[1], &item.value, sizeof(int32_t));
+    entry[5] = sensor.unit;
+    entry[6] = sensor.prec;
+    streamReserve(TELEMETRY_STREAM_SENSORS, sizeof(entry));
+    streamWrite(entry, sizeof(entry));
+  }
+  streamCloseFrame();
+}
+
+void telemetryStreamWakeup()
+{
+  if (!streamDrv) return;
+
+  uint32_t now = RTOS_GET_MS();
+  if (now - streamLastChannels >= TELEMETRY_STREAM_CHANNELS_MS) {
+    streamLastChannels = now;
+    streamChannels(now);
+  }
+
+  streamSensors();
+  streamFlush();
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "hal/serial_driver.h"
+
+// Framed binary stream of the telemetry for a ground station,
+// selected with the "Telem Stream" serial port mode (VCP or AUX).
+//
+// Frame: 0xA5, type, payload length, payload, crc8 (type to payload)
+//
+// Frames are batched and sent once per telemetry wakeup. The USB
+// VCP drops a whole batch when it is full, never part of a frame.
+
+#define TELEMETRY_STREAM_SYNC          0xA5
+#define TELEMETRY_STREAM_BAUDRATE      921600
+
+// Channel outputs period
+#define TELEMETRY_STREAM_CHANNELS_MS   10
+
+enum TelemetryStreamFrameType {
+  // uint32 ms, int16 channels[MAX_OUTPUT_CHANNELS]
+  TELEMETRY_STREAM_CHANNELS = 1,
+  // n * (uint8 sensor index, int32 value, uint8 unit, uint8 prec)
+  TELEMETRY_STREAM_SENSORS,
+  // uint8 module, raw bytes as received
+  TELEMETRY_STREAM_RAW,
+};
+
+void telemetryStreamSetSerialDriver(void* ctx, const etx_serial_driver_t* drv);
+
+// Raw bytes received from a module
+void telemetryStreamRaw(uint8_t module, const uint8_t* data, uint32_t len);
+
+// Adds the channels and the new sensor values, then sends the batch
+void telemetryStreamWakeup();
@@ -20,6 +20,8 @@
  */
 
 #include "gtests.h"
+#include "telemetry/crossfire.h"
+#include "telemetry/crossfire_params.h"
 
 #if defined(CROSSFIRE)
 uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
@@ -44,5 +46,101 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+TEST(Crossfire, paramDecode)
+{
+  const char data[] = "\x00\x09Packet Rate\0" "50Hz;150Hz;250Hz;500Hz\0"
+                      "\x03\x00\x03\x01" "Hz";
+  CrossfireParam param;
+  ASSERT_TRUE(crossfireParamDecode(1, (const uint8_t *)data, sizeof(data), param));
+  EXPECT_EQ(CRSF_TEXT_SELECTION, param.type);
+  EXPECT_STREQ("Packet Rate", param.name);
+  EXPECT_EQ(3, param.value);
+  EXPECT_EQ(3, param.max);
+  EXPECT_STREQ("Hz", param.unit);
+
+  char option[16];
+  EXPECT_STREQ("500Hz", crossfireParamOption(param, 3, option, sizeof(option)));
+  EXPECT_STREQ("50Hz", crossfireParamOption(param, 0, option, sizeof(option)));
+
+  const char number[] = "\x02\x03Offset\0\xFF\xF6\xFF\x9C\x00\x64\x00\x00" "dB";
+  ASSERT_TRUE(crossfireParamDecode(2, (const uint8_t *)number, sizeof(number), param));
+  EXPECT_EQ(2, param.parent);
+  EXPECT_EQ(-10, param.value);
+  EXPECT_EQ(-100, param.min);
+  EXPECT_EQ(100, param.max);
+
+  // truncated
+  EXPECT_FALSE(crossfireParamDecode(2, (const uint8_t *)number, 12, param));
+}
+
+static uint8_t crossfireFrame(uint8_t * frame, uint8_t type, const uint8_t * payload, uint8_t size)
+{
+  frame[0] = RADIO_ADDRESS;
+  frame[1] = size + 2;
+  frame[2] = type;
+  memcpy(&frame[3], payload, size);
+  frame[3 + size] = crc8(&frame[2], size + 1);
+  return size + 4;
+}
+
+TEST(Crossfire, paramsPipelinedReads)
+{
+  uint8_t frame[64];
+  outputTelemetryBuffer.reset();
+  crossfireParamsStart(EXTERNAL_MODULE);
+
+  crossfireParamsWakeup();
+  EXPECT_EQ(PING_DEVICES_ID, outputTelemetryBuffer.data[2]);
+  outputTelemetryBuffer.reset();
+
+  const uint8_t info[] = {RADIO_ADDRESS, MODULE_ADDRESS, 'T', 'X', 0,
+                          'E', 'L', 'R', 'S', 0, 0, 0, 0, 0, 3, 1, 0, 6, 1};
+  uint8_t count = crossfireFrame(frame, DEVICE_INFO_ID, info, sizeof(info));
+  EXPECT_TRUE(crossfireParamsProcessFrame(EXTERNAL_MODULE, frame, count));
+  EXPECT_EQ(1, crossfireParamsDevicesCount());
+
+  crossfireParamsSelectDevice(MODULE_ADDRESS);
+  EXPECT_EQ(6, crossfireParamsFieldsCount());
+
+  // several fields requested without waiting for the answers
+  for (uint8_t field = 1; field <= CRSF_PARAMS_IN_FLIGHT; field++) {
+    crossfireParamsWakeup();
+    EXPECT_EQ(PARAMETER_READ_ID, outputTelemetryBuffer.data[2]);
+    EXPECT_EQ(field, outputTelemetryBuffer.data[5]);
+    EXPECT_EQ(0, outputTelemetryBuffer.data[6]);
+    outputTelemetryBuffer.reset();
+  }
+  crossfireParamsWakeup();
+  EXPECT_TRUE(outputTelemetryBuffer.isAvailable());
+
+  // answer of field 2 in two chunks
+  const uint8_t chunk1[] = {RADIO_ADDRESS, MODULE_ADDRESS, 2, 1, 0, 12, 'B', 'i'};
+  count = crossfireFrame(frame, PARAMETER_SETTINGS_ENTRY_ID, chunk1, sizeof(chunk1));
+  EXPECT_TRUE(crossfireParamsProcessFrame(EXTERNAL_MODULE, frame, count));
+  crossfireParamsWakeup();
+  EXPECT_EQ(2, outputTelemetryBuffer.data[5]);
+  EXPECT_EQ(1, outputTelemetryBuffer.data[6]);
+  outputTelemetryBuffer.reset();
+
+  const uint8_t chunk2[] = {RADIO_ADDRESS, MODULE_ADDRESS, 2, 0, 'n', 'd', 0, 'o', 'k', 0};
+  count = crossfireFrame(frame, PARAMETER_SETTINGS_ENTRY_ID, chunk2, sizeof(chunk2));
+  EXPECT_TRUE(crossfireParamsProcessFrame(EXTERNAL_MODULE, frame, count));
+  EXPECT_EQ(1, crossfireParamsFieldsLoaded());
+
+  CrossfireParam param;
+  uint8_t buffer[CRSF_PARAM_MAX_SIZE];
+  ASSERT_TRUE(crossfireParamsGetField(2, param, buffer));
+  EXPECT_EQ(CRSF_INFO, param.type);
+  EXPECT_STREQ("Bind", param.name);
+  EXPECT_STREQ("ok", param.text);
+
+  // the free slot goes to the next field
+  crossfireParamsWakeup();
+  EXPECT_EQ(5, outputTelemetryBuffer.data[5]);
+  outputTelemetryBuffer.reset();
+
+  crossfireParamsStop();
+  EXPECT_FALSE(crossfireParamsProcessFrame(EXTERNAL_MODULE, frame, count));
+}
 #endif
 
@@ -44,6 +44,31 @@ TEST(Storage, BackupAndRestore)
   if (memcmp(&ramBackupUncompressed, &ramBackupRestored, sizeof(ramBackupUncompressed)) != 0)
     TRACE("ERROR restore");
 }
+
+TEST(Storage, BackupSkippedWhenUnchanged)
+{
+  rambackupWrite();
+  uint16_t size = ramBackup->size;
+  ASSERT_NE(size, 0);
+
+  // an unchanged model must not be compressed again
+  uint8_t first = ramBackup->data[0];
+  ramBackup->data[0] ^= 0xFF;
+  rambackupWrite();
+  EXPECT_EQ(size, ramBackup->size);
+  EXPECT_EQ((uint8_t)(first ^ 0xFF), ramBackup->data[0]);
+  ramBackup->data[0] = first;
+
+  g_model.header.name[0] ^= 0x01;
+  rambackupWrite();
+  Backup::RamBackupUncompressed ramBackupRestored;
+  EXPECT_EQ(sizeof(ramBackupRestored),
+            uncompress((uint8_t *)&ramBackupRestored, sizeof(ramBackupRestored),
+                       ramBackup->data, ramBackup->size));
+  EXPECT_EQ(ramBackupRestored.model.header.name[0],
+            g_model.header.name[0]);
+  g_model.header.name[0] ^= 0x01;
+}
 #endif
 
 #if defined(EEPROM) && defined(EEPROM_RLC)
@@ -186,3 +211,50 @@ TEST(Eeprom, rm)
   EXPECT_EQ(sz, 0);
 }
 #endif
+
+#if defined(SDCARD_YAML)
+#include "storage/yaml/yaml_parser.h"
+#include "storage/yaml/yaml_tree_walker.h"
+#include "storage/yaml/yaml_datastructs.h"
+
+TEST(Storage, PartialModelYaml)
+{
+  const char model[] =
+      "semver: 2.9.0\r\n"
+      "header:\r\n"
+      "   name: \"Plane\"\r\n"
+      "mixData:\r\n"
+      "   -\r\n"
+      "      destCh: 0\r\n"
+      "      name: \"a very long mix name that is not needed\"\r\n"
+      "   -\r\n"
+      "      destCh: 1\r\n"
+      "timers:\r\n"
+      "   0:\r\n"
+      "      start: 60\r\n"
+      "      unknown:\r\n"
+      "         nested: 1\r\n"
+      "      mode: ON\r\n"
+      "      name: \"T1\"\r\n"
+      "telemetryProtocol: 0\r\n"
+      "header:\r\n"
+      "   name: \"Other\"\r\n";
+
+  PartialModel partial;
+  memclear(&partial, sizeof(partial));
+
+  YamlTreeWalker tree;
+  tree.reset(get_partialmodel_nodes(), (uint8_t*)&partial);
+
+  YamlParser yp;
+  yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+  yp.set_eof();
+
+  // parsing stops at the first root node after header and timers
+  EXPECT_EQ(YamlParser::DONE_PARSING, yp.parse(model, sizeof(model) - 1));
+  EXPECT_STREQ("Plane", partial.header.name);
+  EXPECT_EQ(60U, partial.timers[0].start);
+  EXPECT_EQ(TMRMODE_ON, partial.timers[0].mode);
+  EXPECT_EQ(0, strncmp("T1", partial.timers[0].name, 2));
+}
+#endif
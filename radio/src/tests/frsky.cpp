@@ -20,6 +20,7 @@
  */
 
 #include "gtests.h"
+#include "telemetry/link_history.h"
 
 void frskyDProcessPacket(const uint8_t *packet);
 bool checkSportPacket(const uint8_t *packet);
@@ -530,3 +531,172 @@ TEST(FrSkySPORT, frskyCurrent)
   EXPECT_EQ(telemetryItems[0].valueMax, 505);
 }
 
+
+TEST(FrSkySPORT, sensorDefaults)
+{
+  MODEL_RESET();
+
+  frskySportSetDefault(0, CURR_FIRST_ID, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_AMPS);
+  frskySportSetDefault(0, CURR_LAST_ID, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_AMPS);
+  frskySportSetDefault(0, VFAS_FIRST_ID, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_VOLTS);
+
+  // sensors sharing an id range
+  frskySportSetDefault(0, RBOX_BATT1_FIRST_ID, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_VOLTS);
+  frskySportSetDefault(0, RBOX_BATT1_LAST_ID, 1, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_AMPS);
+  frskySportSetDefault(0, SERVO_FIRST_ID, 2, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_CELSIUS);
+  frskySportSetDefault(0, SERVO_FIRST_ID, 3, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_TEXT);
+  frskySportSetDefault(0, SERVO_FIRST_ID, 4, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_RAW);
+
+  // single ids at the end of the table
+  frskySportSetDefault(0, RSSI_ID, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_DB);
+  frskySportSetDefault(0, R9_PWR_ID, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_MILLIWATTS);
+
+  // unknown ids
+  frskySportSetDefault(0, 0x0C00, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_RAW);
+  frskySportSetDefault(0, 0xF105, 0, 0);
+  EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_RAW);
+}
+
+TEST(Telemetry, sensorDiscoveryBudget)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  // a burst of new sensors is created over several ticks
+  for (int pass = 0; pass < 2; pass++) {
+    for (uint16_t i = 0; i < 6; i++) {
+      setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, 0x5100 + i, 0, 1,
+                        100 + i, UNIT_RAW, 0);
+    }
+    EXPECT_EQ(lastUsedTelemetryIndex(), pass == 0 ? 3 : 5);
+    g_tmr10ms++;
+  }
+
+  EXPECT_EQ(g_model.telemetrySensors[5].id, 0x5105);
+  EXPECT_EQ(telemetryItems[5].value, 105);
+  EXPECT_EQ(availableTelemetryIndex(), 6);
+
+  allowNewSensors = false;
+}
+
+#if defined(LUA)
+TEST(Telemetry, sensorStats)
+{
+  TelemetryStats stats;
+  int32_t average;
+  int32_t delta;
+  uint8_t elapsed;
+
+  stats.reset(0);
+
+  // 2 values per second, increasing by 10 each second
+  for (uint16_t second = 100; second < 105; second++) {
+    stats.add(second * 10 - 2, second);
+    stats.add(second * 10 + 2, second);
+  }
+
+  // the current second is not complete yet
+  EXPECT_TRUE(stats.getAverage(1, 104, average));
+  EXPECT_EQ(average, 1030);
+  EXPECT_TRUE(stats.getAverage(4, 104, average));
+  EXPECT_EQ(average, 1015);
+  EXPECT_TRUE(stats.getChange(4, 104, delta, elapsed));
+  EXPECT_EQ(delta, 30);
+  EXPECT_EQ(elapsed, 3);
+  EXPECT_FALSE(stats.getChange(1, 104, delta, elapsed));
+
+  // no more values
+  EXPECT_TRUE(stats.getAverage(10, 110, average));
+  EXPECT_EQ(average, 1020);
+  EXPECT_FALSE(stats.getAverage(5, 110, average));
+  EXPECT_FALSE(stats.getAverage(10, 120, average));
+
+  // values again after a gap longer than the window
+  stats.add(500, 130);
+  EXPECT_FALSE(stats.getAverage(10, 130, average));
+  EXPECT_TRUE(stats.getAverage(10, 131, average));
+  EXPECT_EQ(average, 500);
+}
+#endif
+
+static void pushLinkHistory(int16_t rssi, int16_t lq)
+{
+  int16_t values[LINK_HISTORY_METRICS] = {rssi, lq, LINK_HISTORY_NO_DATA,
+                                          LINK_HISTORY_NO_DATA};
+  linkHistoryPush(values);
+}
+
+static int16_t lastLinkHistory(uint8_t track, uint8_t metric)
+{
+  LinkHistoryReader reader(track, 1);
+  LinkHistorySample sample;
+  EXPECT_TRUE(reader.next(sample));
+  EXPECT_FALSE(reader.next(sample));
+  return sample.values[metric];
+}
+
+TEST(Telemetry, linkHistory)
+{
+  linkHistoryReset();
+
+  // large steps are reached after a few samples
+  for (int i = 0; i < 8; i++) {
+    pushLinkHistory(-60, 100);
+  }
+  EXPECT_EQ(linkHistoryCount(LINK_HISTORY_FINE), 8);
+  EXPECT_EQ(lastLinkHistory(LINK_HISTORY_FINE, LINK_HISTORY_RSSI), -60);
+  EXPECT_EQ(lastLinkHistory(LINK_HISTORY_FINE, LINK_HISTORY_LQ), 100);
+  EXPECT_EQ(lastLinkHistory(LINK_HISTORY_FINE, LINK_HISTORY_SNR),
+            LINK_HISTORY_NO_DATA);
+
+  // a loss of data is recorded at once
+  pushLinkHistory(LINK_HISTORY_NO_DATA, LINK_HISTORY_NO_DATA);
+  EXPECT_EQ(lastLinkHistory(LINK_HISTORY_FINE, LINK_HISTORY_LQ),
+            LINK_HISTORY_NO_DATA);
+
+  // the coarse track keeps the worst value of each period
+  for (int i = 0; i < 21; i++) {
+    pushLinkHistory(-60, i == 15 ? 99 : 100);
+  }
+  EXPECT_EQ(linkHistoryCount(LINK_HISTORY_COARSE), 3);
+  EXPECT_EQ(lastLinkHistory(LINK_HISTORY_COARSE, LINK_HISTORY_LQ), 99);
+
+  // the fine track is a ring of the last samples
+  for (int i = 0; i < LINK_HISTORY_FINE_SAMPLES; i++) {
+    pushLinkHistory(-70, 90);
+  }
+  EXPECT_EQ(linkHistoryCount(LINK_HISTORY_FINE), LINK_HISTORY_FINE_SAMPLES);
+  LinkHistoryReader reader(LINK_HISTORY_FINE);
+  LinkHistorySample sample;
+  uint16_t count = 0;
+  while (reader.next(sample)) count++;
+  EXPECT_EQ(count, LINK_HISTORY_FINE_SAMPLES);
+  EXPECT_EQ(sample.values[LINK_HISTORY_LQ], 90);
+
+  // when full, the coarse track halves its resolution
+  linkHistoryReset();
+  for (int i = 0; i < LINK_HISTORY_COARSE_SAMPLES * LINK_HISTORY_COARSE_PERIOD; i++) {
+    pushLinkHistory(-60, 100);
+  }
+  EXPECT_EQ(linkHistoryCount(LINK_HISTORY_COARSE), LINK_HISTORY_COARSE_SAMPLES);
+  EXPECT_EQ(linkHistoryPeriod(LINK_HISTORY_COARSE), LINK_HISTORY_COARSE_PERIOD);
+  for (int i = 0; i < LINK_HISTORY_COARSE_PERIOD * 2; i++) {
+    pushLinkHistory(-60, 100);
+  }
+  EXPECT_EQ(linkHistoryCount(LINK_HISTORY_COARSE), LINK_HISTORY_COARSE_SAMPLES / 2 + 1);
+  EXPECT_EQ(linkHistoryPeriod(LINK_HISTORY_COARSE), LINK_HISTORY_COARSE_PERIOD * 2);
+  EXPECT_EQ(lastLinkHistory(LINK_HISTORY_COARSE, LINK_HISTORY_LQ), 100);
+  EXPECT_EQ(lastLinkHistory(LINK_HISTORY_COARSE, LINK_HISTORY_RSSI), -60);
+}
@@ -62,6 +62,24 @@ TEST_F(SpecialFunctionsTest, FlightReset)
   EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_FLIGHT_RESET)), false);
 }
 
+TEST_F(SpecialFunctionsTest, FunctionAddedAfterFirstRun)
+{
+  mainRequestFlags = 0;
+  simuSetSwitch(0, -1);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_FLIGHT_RESET)), false);
+
+  // the function is picked up once the model is marked as modified
+  g_model.customFn[1].swtch = SWSRC_FIRST_SWITCH;
+  g_model.customFn[1].func = FUNC_RESET;
+  g_model.customFn[1].all.val = FUNC_RESET_FLIGHT;
+  g_model.customFn[1].active = true;
+  storageDirty(EE_MODEL);
+
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_FLIGHT_RESET)), true);
+}
+
 #if defined(GVARS)
 TEST_F(SpecialFunctionsTest, GvarsInc)
 {
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(INTERNAL_GPS)
+void gpsNewData(uint8_t c);
+
+static void gpsFeed(const uint8_t * data, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    gpsNewData(data[i]);
+  }
+}
+
+static void gpsFeed(const char * str)
+{
+  gpsFeed((const uint8_t *)str, strlen(str));
+}
+
+static uint32_t ubxFrame(uint8_t * frame, uint8_t msgClass, uint8_t msgId,
+                         const uint8_t * payload, uint16_t len)
+{
+  frame[0] = 0xB5;
+  frame[1] = 0x62;
+  frame[2] = msgClass;
+  frame[3] = msgId;
+  frame[4] = len;
+  frame[5] = len >> 8;
+  memcpy(&frame[6], payload, len);
+  uint8_t ckA = 0, ckB = 0;
+  for (uint32_t i = 2; i < 6u + len; i++) {
+    ckA += frame[i];
+    ckB += ckA;
+  }
+  frame[6 + len] = ckA;
+  frame[7 + len] = ckB;
+  return 8 + len;
+}
+
+static void put32(uint8_t * p, int32_t value)
+{
+  memcpy(p, &value, sizeof(value));
+}
+
+TEST(Gps, NMEAFrames)
+{
+  memclear(&gpsData, sizeof(gpsData));
+  gpsFeed("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+  EXPECT_EQ(gpsData.packetCount, 1u);
+  EXPECT_EQ(gpsData.errorCount, 0u);
+  EXPECT_EQ(gpsData.fix, 1);
+  EXPECT_EQ(gpsData.numSat, 8);
+  EXPECT_EQ(gpsData.latitude, 48117300);
+  EXPECT_EQ(gpsData.longitude, 11516666);
+  EXPECT_EQ(gpsData.altitude, 545);
+  EXPECT_EQ(gpsData.hdop, 90);
+  EXPECT_EQ(gpsData.protocol, GPS_PROTOCOL_NMEA);
+}
+
+TEST(Gps, UBXNavPvt)
+{
+  memclear(&gpsData, sizeof(gpsData));
+
+  uint8_t pvt[92] = {0};
+  pvt[20] = 3;                  // fixType: 3D
+  pvt[21] = 0x01;               // gnssFixOK
+  pvt[23] = 12;                 // numSV
+  put32(&pvt[24], 115166660);   // lon
+  put32(&pvt[28], 481173000);   // lat
+  put32(&pvt[36], 545400);      // hMSL
+  put32(&pvt[40], 1500);        // hAcc
+  put32(&pvt[44], 2500);        // vAcc
+  put32(&pvt[56], -1200);       // velD
+  put32(&pvt[60], 12340);       // gSpeed
+  put32(&pvt[64], 9000000);     // headMot
+  put32(&pvt[68], 300);         // sAcc
+  pvt[76] = 150;                // pDOP
+
+  // UBX frames can be received between NMEA sentences
+  uint8_t frame[100];
+  uint32_t len = ubxFrame(frame, 0x01, 0x07, pvt, sizeof(pvt));
+  gpsFeed("$GPGSV,1,1,00*79\r\n");
+  gpsFeed(frame, len);
+
+  EXPECT_EQ(gpsData.errorCount, 0u);
+  EXPECT_EQ(gpsData.packetCount, 2u);
+  EXPECT_EQ(gpsData.protocol, GPS_PROTOCOL_UBX);
+  EXPECT_EQ(gpsData.fix, 1);
+  EXPECT_EQ(gpsData.numSat, 12);
+  EXPECT_EQ(gpsData.latitude, 48117300);
+  EXPECT_EQ(gpsData.longitude, 11516666);
+  EXPECT_EQ(gpsData.altitude, 545);
+  EXPECT_EQ(gpsData.speed, 123);
+  EXPECT_EQ(gpsData.groundCourse, 900);
+  EXPECT_EQ(gpsData.verticalSpeed, 12);
+  EXPECT_EQ(gpsData.hAcc, 15);
+  EXPECT_EQ(gpsData.vAcc, 25);
+  EXPECT_EQ(gpsData.sAcc, 3);
+  EXPECT_EQ(gpsData.hdop, 150);
+
+  // corrupted frame
+  frame[30] ^= 0xFF;
+  gpsFeed(frame, len);
+  EXPECT_EQ(gpsData.errorCount, 1u);
+  EXPECT_EQ(gpsData.numSat, 12);
+}
+#endif
@@ -164,6 +164,85 @@ TEST(Lua, testModelInputs)
 
 }
 
+TEST(Lua, testModelBatchGetters)
+{
+  MODEL_RESET();
+  luaExecStr("model.insertInput(3, 0, {name='test1', source=MIXSRC_Thr, weight=56})");
+  luaExecStr("model.insertInput(3, 1, {name='test2', source=MIXSRC_Rud, weight=-56})");
+
+  luaExecStr("lines = model.getInputs(3)");
+  luaExecStr("if #lines ~= 2 or lines[1].name ~= 'test1' or lines[2].weight ~= -56 then error('getInputs()') end");
+
+  // reused tables, limited to the requested fields
+  luaExecStr("first = lines[1]");
+  luaExecStr("model.deleteInput(3, 1)");
+  luaExecStr("lines[1].weight = 0");
+  luaExecStr("model.getInputs(3, {name=true}, lines)");
+  luaExecStr("if #lines ~= 1 or lines[1] ~= first or lines[1].weight ~= 0 then error('getInputs() reuse') end");
+
+  luaExecStr("model.setLogicalSwitches(1, {{func=LS_FUNC_VPOS, v1=1, v2=10}, {func=LS_FUNC_VNEG, v1=2, v2=-10}})");
+  EXPECT_EQ(LS_FUNC_VPOS, g_model.logicalSw[1].func);
+  EXPECT_EQ(-10, g_model.logicalSw[2].v2);
+  luaExecStr("ls = model.getLogicalSwitches({func=true})");
+  luaExecStr("if ls[2].func ~= LS_FUNC_VPOS or ls[2].v1 ~= nil then error('getLogicalSwitches()') end");
+}
+
+TEST(Lua, testSetWakeup)
+{
+  // outside of a background function
+  luaExecStr("if setWakeup({telemetry=true}) then error('setWakeup() not running') end");
+
+  LuaWakeup wakeup = {};
+  luaRunningWakeup = &wakeup;
+  luaExecStr("if setWakeup({}) then error('setWakeup() no condition') end");
+  luaExecStr("if not setWakeup({telemetry=true, sources={MIXSRC_SA, 'nosuchsource'}}) then error('setWakeup()') end");
+  luaRunningWakeup = nullptr;
+  EXPECT_EQ(1, wakeup.sourcesCount);
+
+  EXPECT_TRUE(luaWakeupParked(wakeup));
+  telemetryValuesCount++;
+  EXPECT_FALSE(luaWakeupParked(wakeup));
+  EXPECT_FALSE(wakeup.parked);
+}
+
+TEST(Lua, testShmRings)
+{
+  MODEL_RESET();
+  luaExecStr("shmRingBind(1)");
+  luaExecStr("if not shmRingPush(1, 7, 10, -20) then error('shmRingPush()') end");
+  luaExecStr("used, free = shmRingInfo(1)");
+  luaExecStr("if used ~= 1 then error('shmRingInfo()') end");
+  luaExecStr("t, a, b, c = shmRingPop(1)");
+  luaExecStr("if t ~= 7 or a ~= 10 or b ~= -20 or c ~= nil then error('shmRingPop()') end");
+  luaExecStr("if shmRingPop(1) ~= nil then error('shmRingPop() empty') end");
+
+  // one record per mixer cycle into GV1
+  luaExecStr("shmRingBind(1, {gvar=0})");
+  luaExecStr("shmRingPush(1, 0, 5) shmRingPush(1, 0, 6)");
+  luaShmPopGVars();
+  EXPECT_EQ(5, GVAR_VALUE(0, 0));
+  luaShmPopGVars();
+  EXPECT_EQ(6, GVAR_VALUE(0, 0));
+  luaShmPopGVars();
+  EXPECT_EQ(6, GVAR_VALUE(0, 0));
+
+  // mixes weighted by the streamed GVar follow it
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = GV_CALC_VALUE_IDX_POS(0, GV1_LARGE);
+  storageDirty(EE_MODEL);
+  luaExecStr("shmRingPush(1, 0, 50) shmRingPush(1, 0, 100)");
+  luaShmPopGVars();
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX / 2);
+  luaShmPopGVars();
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+  evalMixes(1);
+  EXPECT_EQ(channelOutputs[0], 1024);
+  luaExecStr("shmRingBind(1)");
+}
+
 TEST(Lua, Switches)
 {
   luaExecStr("if MIXSRC_SA == nil then error('failed') end");
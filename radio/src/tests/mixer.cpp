@@ -21,6 +21,7 @@
 
 #include "gtests.h"
 #include "hal/adc_driver.h"
+#include "ext_input.h"
 
 class TrimsTest : public OpenTxTest {};
 class MixerTest : public OpenTxTest {};
@@ -524,6 +525,26 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothCurveFollowsPointEdits)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.curves[0].smooth = 1;
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  EXPECT_EQ(applyCustomCurve(-1024, 0), -1024);
+  EXPECT_EQ(applyCustomCurve(1024, 0), 1024);
+
+  for (int8_t i=0; i<5; i++) {
+    g_model.points[i] = 0;
+  }
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(applyCustomCurve(-1024 + 128, 0), 0);
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -543,6 +564,57 @@ TEST_F(MixerTest, InfiniteRecursiveChannels)
   EXPECT_EQ(chans[0], 0);
 }
 
+TEST_F(MixerTest, CurvePointsChangeAfterStorageDirty)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[0].curve.type = CURVE_REF_CUSTOM;
+  g_model.mixData[0].curve.value = 1;
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+
+  g_model.points[4] = 50;
+  storageDirty(EE_MODEL);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX/2);
+}
+
+TEST_F(MixerTest, OutputLimitsChangeAfterStorageDirty)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  evalMixes(1);
+  EXPECT_EQ(channelOutputs[0], CHANNEL_MAX);
+
+  g_model.limitData[0].max = -500; // 50%
+  storageDirty(EE_MODEL);
+  evalMixes(1);
+  EXPECT_EQ(channelOutputs[0], CHANNEL_MAX/2);
+
+  g_model.limitData[0].revert = 1;
+  storageDirty(EE_MODEL);
+  evalMixes(1);
+  EXPECT_EQ(channelOutputs[0], -CHANNEL_MAX/2);
+}
+
+TEST_F(MixerTest, OutputCurveKeepsPrecision)
+{
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  g_model.limitData[0].curve = 1;
+  storageDirty(EE_MODEL);
+  // 100.5 is rounded away from 0 instead of being truncated before the curve
+  EXPECT_EQ(applyLimits(0, 256*100 + 128), 101);
+  EXPECT_EQ(applyLimits(0, -(256*100 + 128)), -101);
+  EXPECT_EQ(applyLimits(0, 256*RESX), RESX);
+}
+
 TEST_F(MixerTest, BlockingChannel)
 {
   g_model.mixData[0].destCh = 0;
@@ -642,6 +714,27 @@ TEST_F(MixerTest, SlowOnSwitchSource)
   CHECK_SLOW_MOVEMENT(0, +1, 500);
 }
 
+TEST_F(MixerTest, SlowAtMixerPeriod)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_ADD;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[0].speedUp = 50;
+
+  s_mixer_first_run_done = true;
+
+  // 4 cycles of 2.5ms move as far as one 10ms tick, each one a quarter
+  int32_t lastAct = 0;
+  for (int i=1; i<=100; i++) {
+    for (int cycle=1; cycle<=4; cycle++) {
+      evalFlightModeMixes(e_perout_mode_normal, cycle == 4, (bitfield_channels_t)-1, 2500);
+      EXPECT_EQ(chans[0], 256 * ((lastAct + cycle * ((1<<19)/500) / 4) >> 8));
+    }
+    lastAct += (1<<19)/500;
+  }
+}
+
 TEST_F(MixerTest, SlowDisabledOnStartup)
 {
   g_model.mixData[0].destCh = 0;
@@ -801,6 +894,49 @@ TEST(Heli, Mode2Test)
   EXPECT_EQ(chans[2], CHANNEL_MAX/2);
   SYSTEM_RESET();
 }
+
+TEST(Heli, SwashTypesTest)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.swashR.collectiveSource = MIXSRC_Thr;
+  g_model.swashR.elevatorSource = MIXSRC_Ele;
+  g_model.swashR.aileronSource = MIXSRC_Ail;
+  g_model.swashR.collectiveWeight = 100;
+  g_model.swashR.elevatorWeight = 100;
+  g_model.swashR.aileronWeight = 100;
+  for (int i = 0; i < 3; i++) {
+    g_model.mixData[i].destCh = i;
+    g_model.mixData[i].mltpx = MLTPX_ADD;
+    g_model.mixData[i].srcRaw = MIXSRC_CYC1 + i;
+    g_model.mixData[i].weight = 100;
+  }
+  anaSetFiltered(THR_STICK, 0);
+
+  anaSetFiltered(ELE_STICK, 0);
+  anaSetFiltered(AIL_STICK, 1024);
+  g_model.swashR.type = SWASH_TYPE_120X;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], -CHANNEL_MAX);
+  EXPECT_EQ(chans[1], CHANNEL_MAX/2);
+  EXPECT_EQ(chans[2], CHANNEL_MAX/2);
+
+  anaSetFiltered(ELE_STICK, 1024);
+  anaSetFiltered(AIL_STICK, 0);
+  g_model.swashR.type = SWASH_TYPE_140;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], -CHANNEL_MAX);
+  EXPECT_EQ(chans[1], CHANNEL_MAX);
+  EXPECT_EQ(chans[2], CHANNEL_MAX);
+
+  g_model.swashR.type = SWASH_TYPE_90;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], -CHANNEL_MAX);
+  EXPECT_EQ(chans[1], 0);
+  EXPECT_EQ(chans[2], 0);
+}
 #endif
 
 TEST(Trainer, UnpluggedTest)
@@ -865,6 +1001,72 @@ TEST_F(MixerTest, flightModeOverflow)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, 1024);
 }
 
+TEST_F(MixerTest, flightModeTransitionUnchangedChannels)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 2;
+  g_model.flightModeData[0].fadeIn = 100;
+  g_model.flightModeData[0].fadeOut = 100;
+  g_model.flightModeData[1].fadeIn = 100;
+  g_model.flightModeData[1].fadeOut = 100;
+  // CH1 differs between FM0 and FM1
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_REPL;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].flightModes = 0b11110;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 0;
+  g_model.mixData[1].mltpx = MLTPX_REPL;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].flightModes = 0b11101;
+  g_model.mixData[1].weight = -10;
+  // CH2 is the same in all flight modes
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].mltpx = MLTPX_ADD;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].weight = 50;
+  // CH3 follows CH1
+  g_model.mixData[3].destCh = 2;
+  g_model.mixData[3].mltpx = MLTPX_ADD;
+  g_model.mixData[3].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[3].weight = 100;
+  evalMixes(1);
+  simuSetSwitch(0, 1);
+  for (int i = 0; i < 1100; i++) {
+    evalMixes(1);
+    EXPECT_EQ(channelOutputs[1], 512);
+    EXPECT_LE(abs(channelOutputs[2] - channelOutputs[0]), 1);
+  }
+  EXPECT_EQ(channelOutputs[0], -102);
+}
+
+#if defined(GVARS)
+TEST_F(MixerTest, GVarInheritanceAfterStorageDirty)
+{
+  MODEL_RESET();
+  g_model.flightModeData[0].gvars[0] = 10;
+  g_model.flightModeData[1].gvars[0] = GVAR_MAX + 1; // FM1 uses FM0
+  g_model.flightModeData[2].gvars[0] = GVAR_MAX + 2; // FM2 uses FM1
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(getGVarValue(0, 1), 10);
+  EXPECT_EQ(getGVarValue(0, 2), 10);
+
+  // values are read in place
+  g_model.flightModeData[0].gvars[0] = 15;
+  EXPECT_EQ(getGVarValue(0, 2), 15);
+
+  // inheritance changes are taken into account on the next revision
+  g_model.flightModeData[1].gvars[0] = 20;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(getGVarValue(0, 1), 20);
+  EXPECT_EQ(getGVarValue(0, 2), 20);
+  EXPECT_EQ(getGVarValue(-1, 2), -20);
+}
+#endif
+
 TEST_F(TrimsTest, throttleTrimWithCrossTrims)
 {
   g_model.thrTrim = 1;
@@ -1017,3 +1219,59 @@ TEST_F(TrimsTest, invertedThrottlePlusThrottleTrimWithCrossTrims)
   EXPECT_EQ(channelOutputs[2], +1024);
   EXPECT_EQ(channelOutputs[1], 0);
 }
+
+static uint8_t extInputPolls;
+
+static void extInputTestPoll()
+{
+  extInputPolls++;
+}
+
+TEST(ExtInput, SampleAndAge)
+{
+  static const ExtInputDriver drv = {
+    .channels = 2,
+    .poll = extInputTestPoll,
+  };
+
+  extInputRegister(EXT_INPUT_SPACEMOUSE, &drv);
+  extInputPolls = 0;
+
+  // nothing received yet
+  extInputSample(1000);
+  EXPECT_EQ(extInputPolls, 1);
+  EXPECT_EQ(extInputGetAge(EXT_INPUT_SPACEMOUSE), EXT_INPUT_NO_DATA);
+  EXPECT_TRUE(extInputIsStale(EXT_INPUT_SPACEMOUSE));
+  EXPECT_EQ(extInputGetValue(EXT_INPUT_SPACEMOUSE, 0), 0);
+
+  // values only change when sampled, extra channels are dropped
+  const int16_t values[] = {100, -200, 300};
+  extInputPush(EXT_INPUT_SPACEMOUSE, values, 3, 1005);
+  EXPECT_EQ(extInputGetValue(EXT_INPUT_SPACEMOUSE, 0), 0);
+
+  extInputSample(1010);
+  EXPECT_EQ(extInputGetAge(EXT_INPUT_SPACEMOUSE), 5u);
+  EXPECT_FALSE(extInputIsStale(EXT_INPUT_SPACEMOUSE));
+  EXPECT_EQ(extInputGetValue(EXT_INPUT_SPACEMOUSE, 0), 100);
+  EXPECT_EQ(extInputGetValue(EXT_INPUT_SPACEMOUSE, 1), -200);
+  EXPECT_EQ(extInputGetValue(EXT_INPUT_SPACEMOUSE, 2), 0);
+
+  // the last packet wins, a packet newer than the cycle has no age
+  const int16_t newer[] = {400, 500};
+  extInputPush(EXT_INPUT_SPACEMOUSE, values, 2, 1012);
+  extInputPush(EXT_INPUT_SPACEMOUSE, newer, 2, 1021);
+  extInputSample(1020);
+  EXPECT_EQ(extInputGetAge(EXT_INPUT_SPACEMOUSE), 0u);
+  EXPECT_EQ(extInputGetValue(EXT_INPUT_SPACEMOUSE, 0), 400);
+
+  // no more packets: stale after EXT_INPUT_STALE_MS
+  extInputSample(1021 + EXT_INPUT_STALE_MS);
+  EXPECT_FALSE(extInputIsStale(EXT_INPUT_SPACEMOUSE));
+  extInputSample(1022 + EXT_INPUT_STALE_MS);
+  EXPECT_TRUE(extInputIsStale(EXT_INPUT_SPACEMOUSE));
+  EXPECT_EQ(extInputGetValue(EXT_INPUT_SPACEMOUSE, 1), 0);
+  EXPECT_EQ(extInputPolls, 5);
+
+  extInputUnregister(EXT_INPUT_SPACEMOUSE);
+  EXPECT_EQ(extInputGetAge(EXT_INPUT_SPACEMOUSE), EXT_INPUT_NO_DATA);
+}
@@ -70,6 +70,37 @@ TEST(getSwitch, OldTypeStickyCSW)
 }
 #endif
 
+#if defined(PCBTARANIS)
+TEST(evalLogicalSwitches, chainSettlesInOneCycle)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 depends on L2, which depends on L3
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SW2, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_OR, SWSRC_FIRST_LOGICAL_SWITCH + 2, SWSRC_NONE);
+  setLogicalSwitch(2, LS_FUNC_AND, SWSRC_FIRST_SWITCH, SWSRC_NONE);
+  modelDataRevision++;
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+
+  // the whole chain follows SA0 in the same cycle
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+}
+#endif
+
 TEST(getSwitch, nullSW)
 {
   MODEL_RESET();
@@ -318,3 +349,39 @@ TEST(getSwitch, edgeRelease)
   EXPECT_EQ(getSwitch(SWSRC_SW2), false);
 
 }
+
+#if defined(PCBTARANIS)
+TEST(getSwitchesPosition, unchangedInputs)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  g_eeGeneral.switchesDelay = 0;
+
+  simuSetSwitch(0, -1);  // SA up
+  getSwitchesPosition(true);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH, GETSWITCH_MIDPOS_DELAY), true);
+
+  // nothing moved: the position is kept
+  getSwitchesPosition(false);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH, GETSWITCH_MIDPOS_DELAY), true);
+
+  // mid position is delayed
+  simuSetSwitch(0, 0);
+  getSwitchesPosition(false);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH, GETSWITCH_MIDPOS_DELAY), true);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH + 1, GETSWITCH_MIDPOS_DELAY), false);
+
+  // ... and reached with the inputs no longer changing
+  g_tmr10ms += SWITCHES_DELAY() + 1;
+  getSwitchesPosition(false);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH, GETSWITCH_MIDPOS_DELAY), false);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH + 1, GETSWITCH_MIDPOS_DELAY), true);
+
+  simuSetSwitch(0, 1);  // SA down
+  getSwitchesPosition(false);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH + 1, GETSWITCH_MIDPOS_DELAY), false);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_SWITCH + 2, GETSWITCH_MIDPOS_DELAY), true);
+}
+#endif
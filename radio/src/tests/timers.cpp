@@ -193,3 +193,19 @@ TEST(Timers, timerThrottleTriggered)
   EXPECT_TRUE(evalTimersForNSecondsAndTest(10,         0, 0, TMR_NEGATIVE,-11));
   EXPECT_TRUE(evalTimersForNSecondsAndTest(100,        0, 0, TMR_STOPPED,-111));
 }
+
+TEST(Timers, timerTriggersFollowModel)
+{
+  initModelTimer(0, TMRMODE_ON, 0);
+  timerReset(0);
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(10, THR_100, 0, TMR_RUNNING, 10));
+
+  // model edits bump the model revision
+  g_model.timers[0].mode = TMRMODE_OFF;
+  modelDataRevision++;
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(10, THR_100, 0, TMR_RUNNING, 10));
+
+  g_model.timers[0].mode = TMRMODE_ON;
+  modelDataRevision++;
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(5, THR_100, 0, TMR_RUNNING, 15));
+}
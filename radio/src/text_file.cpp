@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "text_file.h"
+
+void textIndexInit(TextFileIndex & index)
+{
+  memclear(&index, sizeof(index));
+  index.step = 1;
+  index.count = 1;
+}
+
+static void addLine(TextFileIndex & index, uint32_t offset)
+{
+  index.linesCount++;
+  if (index.linesCount % index.step) return;
+
+  if (index.count == TEXT_INDEX_ENTRIES) {
+    for (uint16_t i = 1; i < TEXT_INDEX_ENTRIES / 2; i++) {
+      index.offsets[i] = index.offsets[2 * i];
+    }
+    index.count = TEXT_INDEX_ENTRIES / 2;
+    index.step *= 2;
+    if (index.linesCount % index.step) return;
+  }
+
+  index.offsets[index.count++] = offset;
+}
+
+void textIndexAdd(TextFileIndex & index, const char * data, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++) {
+    if (data[i] == '\n') {
+      addLine(index, index.indexed + i + 1);
+    }
+  }
+  if (size > 0) {
+    index.indexed += size;
+    index.lastChar = data[size - 1];
+  }
+}
+
+uint32_t textIndexLines(const TextFileIndex & index)
+{
+  // last line without end of line
+  if (index.indexed > 0 && index.lastChar != '\n')
+    return index.linesCount + 1;
+  return index.linesCount;
+}
+
+bool textIndexUpdate(TextFileIndex & index, const char * path, uint32_t size)
+{
+  if (index.complete) return true;
+
+  FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK) {
+    index.complete = true;
+    return true;
+  }
+
+  if (f_lseek(&file, index.indexed) == FR_OK) {
+    char block[TEXT_READ_BLOCK_SIZE];
+    UINT read = 0;
+    while (size > 0) {
+      if (f_read(&file, block, sizeof(block), &read) != FR_OK || read == 0) {
+        index.complete = true;
+        break;
+      }
+      textIndexAdd(index, block, read);
+      size -= min<uint32_t>(size, read);
+    }
+    if (index.indexed >= f_size(&file)) {
+      index.complete = true;
+    }
+  }
+  else {
+    index.complete = true;
+  }
+
+  f_close(&file);
+  return index.complete;
+}
+
+FRESULT TextFileReader::open(const char * path)
+{
+  close();
+  auto result = f_open(&file, path, FA_OPEN_EXISTING | FA_READ);
+  opened = (result == FR_OK);
+  pos = len = 0;
+  return result;
+}
+
+void TextFileReader::close()
+{
+  if (opened) {
+    f_close(&file);
+    opened = false;
+  }
+}
+
+FRESULT TextFileReader::seek(uint32_t offset)
+{
+  pos = len = 0;
+  return f_lseek(&file, offset);
+}
+
+FRESULT TextFileReader::seekLine(const TextFileIndex & index, uint32_t line)
+{
+  uint32_t entry = min<uint32_t>(line / index.step, index.count - 1);
+  auto result = seek(index.offsets[entry]);
+  if (result == FR_OK) {
+    for (uint32_t skip = line - entry * index.step; skip > 0; skip--) {
+      int c;
+      do {
+        c = getChar();
+      } while (c >= 0 && c != '\n');
+      if (c < 0) break;
+    }
+  }
+  return result;
+}
+
+int TextFileReader::getChar()
+{
+  if (pos >= len) {
+    pos = 0;
+    if (f_read(&file, buffer, sizeof(buffer), &len) != FR_OK) len = 0;
+    if (len == 0) return -1;
+  }
+  return (uint8_t)buffer[pos++];
+}
+
+int TextFileReader::readLine(char * line, int size)
+{
+  int length = 0;
+  int c = getChar();
+  if (c < 0) return -1;
+
+  while (c >= 0 && c != '\n') {
+    if (c != '\r' && length < size - 1) {
+      line[length++] = c;
+    }
+    c = getChar();
+  }
+
+  line[length] = '\0';
+  return length;
+}
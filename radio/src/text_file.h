@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include "ff.h"
+
+// Line index of a text file, so that large files are shown one page at a
+// time instead of being loaded whole. It is built in one pass, a few
+// blocks per call, and keeps the offset of one line every `step` lines.
+// When it is full, every other entry is dropped and `step` doubles, so its
+// size does not depend on the length of the file.
+
+#define TEXT_INDEX_ENTRIES      32
+#define TEXT_INDEX_UPDATE_SIZE  (8 * 1024)  // bytes indexed per update
+#define TEXT_READ_BLOCK_SIZE    128
+
+struct TextFileIndex {
+  uint32_t indexed;     // bytes scanned so far
+  uint32_t linesCount;  // '\n' found so far
+  uint16_t step;        // lines between two entries
+  uint16_t count;
+  uint8_t complete;
+  char lastChar;
+  uint32_t offsets[TEXT_INDEX_ENTRIES];  // lines 0, step, 2 * step, ...
+};
+
+void textIndexInit(TextFileIndex & index);
+
+// Add the next `size` bytes of the file
+void textIndexAdd(TextFileIndex & index, const char * data, uint32_t size);
+
+// Lines found so far (the whole file once the index is complete)
+uint32_t textIndexLines(const TextFileIndex & index);
+
+// Index the next part of the file, returns true once it is complete
+bool textIndexUpdate(TextFileIndex & index, const char * path,
+                     uint32_t size = TEXT_INDEX_UPDATE_SIZE);
+
+// Sequential reading of lines, in blocks
+class TextFileReader
+{
+ public:
+  ~TextFileReader() { close(); }
+
+  FRESULT open(const char * path);
+  void close();
+
+  FRESULT seek(uint32_t offset);
+
+  // Start of line `line`, from the closest entry of the index
+  FRESULT seekLine(const TextFileIndex & index, uint32_t line);
+
+  // Line without its end of line, truncated to `size - 1` characters.
+  // Returns its length, or -1 at the end of the file.
+  int readLine(char * line, int size);
+
+ protected:
+  FIL file;
+  bool opened = false;
+  char buffer[TEXT_READ_BLOCK_SIZE];
+  UINT pos = 0;
+  UINT len = 0;
+
+  int getChar();
+};
@@ -513,13 +513,117 @@ static int f_read (lua_State *L) {
 
 #else
 
+/*
+** Reads never go past the end of the current sector, so that giving back
+** what follows the line stays within the FatFs sector buffer.
+*/
+static int read_line (lua_State *L, FILE *f, int chop) {
+  luaL_Buffer b;
+  luaL_buffinit(L, &b);
+  for (;;) {
+    UINT nr;
+    char *p = luaL_prepbuffer(&b);
+    UINT n = FF_MIN_SS - (UINT)(f_tell(f) % FF_MIN_SS);
+    char *eol;
+    if (n > LUAL_BUFFERSIZE) n = LUAL_BUFFERSIZE;
+    if (f_read(f, p, n, &nr) != FR_OK || nr == 0) {  /* eof? */
+      luaL_pushresult(&b);  /* close buffer */
+      return (lua_rawlen(L, -1) > 0);  /* check whether read something */
+    }
+    eol = (char *)memchr(p, '\n', nr);
+    if (eol == NULL)
+      luaL_addsize(&b, nr);
+    else {
+      size_t l = eol - p + 1;
+      f_lseek(f, f_tell(f) - (nr - l));  /* give back what follows */
+      luaL_addsize(&b, l - chop);  /* chop 'eol' if needed */
+      luaL_pushresult(&b);  /* close buffer */
+      return 1;  /* read at least an `eol' */
+    }
+  }
+}
+
+#define MAX_SIZE_T	(~(size_t)0)
+
+static void read_all (lua_State *L, FILE *f) {
+  size_t rlen = LUAL_BUFFERSIZE;  /* how much to read in each cycle */
+  luaL_Buffer b;
+  luaL_buffinit(L, &b);
+  for (;;) {
+    UINT nr = 0;
+    char *p = luaL_prepbuffsize(&b, rlen);
+    f_read(f, p, rlen, &nr);
+    luaL_addsize(&b, nr);
+    if (nr < rlen) break;  /* eof? */
+    else if (rlen <= (MAX_SIZE_T / 4))  /* avoid buffers too large */
+      rlen *= 2;  /* double buffer size at each iteration */
+  }
+  luaL_pushresult(&b);  /* close buffer */
+}
+
 static int io_read (lua_State *L) {
   LStream *p = tolstream(L);
+  int success;
+  if (lua_type(L, 2) == LUA_TSTRING) {
+    const char *fmt = lua_tostring(L, 2);
+    if (*fmt == '*') fmt++;  /* skip optional '*' (for compatibility) */
+    switch (*fmt) {
+      case 'l':  /* line */
+        success = read_line(L, &p->f, 1);
+        break;
+      case 'L':  /* line with end-of-line */
+        success = read_line(L, &p->f, 0);
+        break;
+      case 'a':  /* file */
+        read_all(L, &p->f);  /* read entire file */
+        success = 1; /* always success */
+        break;
+      default:
+        return luaL_argerror(L, 2, "invalid format");
+    }
+    if (!success) {
+      lua_pop(L, 1);  /* remove last result */
+      lua_pushnil(L);  /* push nil instead */
+    }
+    return 1;
+  }
   size_t l = (size_t)lua_tointeger(L, 2);
   read_chars(L, &p->f, l);
   return 1;
 }
 
+static int io_readline (lua_State *L) {
+  LStream *p = (LStream *)lua_touserdata(L, lua_upvalueindex(1));
+  if (read_line(L, &p->f, 1))
+    return 1;
+  if (lua_toboolean(L, lua_upvalueindex(2)))  /* generator opened file? */
+    f_close(&p->f);
+  return 0;
+}
+
+/*
+** io.lines(file or filename): iterator on the lines of the file, without
+** their end-of-line. A file opened from its name is closed at the end.
+*/
+static int io_lines (lua_State *L) {
+  int toclose = 0;
+  if (lua_type(L, 1) == LUA_TSTRING) {
+    const char *filename = lua_tostring(L, 1);
+    LStream *p = newfile(L);
+    if (f_open(&p->f, filename, FA_READ) != FR_OK)
+      return luaL_error(L, "cannot open file " LUA_QS, filename);
+    lua_replace(L, 1);  /* put file at index 1 */
+    toclose = 1;
+  }
+  else {
+    tofile(L);  /* check that it's a valid file handle */
+  }
+  lua_settop(L, 1);
+  lua_pushboolean(L, toclose);
+  lua_pushcclosure(L, io_readline, 2);
+  return 1;
+}
+
 #endif
 
 #if !defined(USE_FATFS)
@@ -652,6 +756,7 @@ LROT_BEGIN(iolib, NULL, 0)
   LROT_FUNCENTRY( seek, io_seek )
   LROT_FUNCENTRY( open, io_open )
   LROT_FUNCENTRY( read, io_read )
+  LROT_FUNCENTRY( lines, io_lines )
   LROT_FUNCENTRY( write, io_write )
 LROT_END(iolib, NULL, 0)
 
@@ -93,6 +93,7 @@ typedef struct _USBD_STORAGE
   * @{
   */ 
 extern const USBD_STORAGE_cb_TypeDef * const USBD_STORAGE_fops;   // modified my OpenTX
+int8_t STORAGE_Flush(uint8_t lun);   // modified by EdgeTX
 /**
   * @}
   */ 
@@ -738,6 +738,12 @@ static int8_t SCSI_ProcessWrite (uint8_t lun)
   
   if (SCSI_blk_len == 0)
   {
+    /* Writes may complete after Write() has returned */
+    if (STORAGE_Flush(lun) < 0)	// modified by EdgeTX
+    {
+      SCSI_SenseCode(lun, HARDWARE_ERROR, WRITE_FAULT);
+      return -1;
+    }
     MSC_BOT_SendCSW (cdev, CSW_CMD_PASSED);
   }
   else
@@ -29,6 +29,14 @@
 
 void DMAWait();
 
+// Below this number of pixels, setting up DMA2D costs more than the CPU loop
+#define DMA2D_MIN_PIXELS      64
+
+// Masks are converted into A8 chunks of this size for DMA2D
+#define DMA2D_MASK_CHUNK_SIZE 2048
+
+static uint8_t dmaMaskBuffer[2][DMA2D_MASK_CHUNK_SIZE] __DMA;
+
 RLEBitmap::RLEBitmap(uint8_t format, const uint8_t* rle_data) :
   BitmapBufferBase<uint16_t>(format, 0, 0, nullptr)
 {
@@ -312,6 +320,15 @@ void BitmapBuffer::drawHorizontalLineAbs(coord_t x, coord_t y, coord_t w, uint8_
   //
   opacity = 0x0F - opacity;
 
+  if (pat == SOLID && w >= DMA2D_MIN_PIXELS) {
+    if (opacity == OPACITY_MAX)
+      DMAFillRect(data, _width, _height, x, y, w, 1, color);
+    else if (opacity != 0)
+      DMABlendRect(data, _width, _height, x, y, w, 1, color, opacity * 17);
+    DMAWait();
+    return;
+  }
+
   DMAWait();
   if (pat == SOLID) {
     while (w--) {
@@ -586,6 +603,27 @@ void BitmapBuffer::drawFilledRect(coord_t x, coord_t y, coord_t w, coord_t h,
     lv_area_t clipped_coords;
     if (!_lv_area_intersect(&clipped_coords, &coords, draw_ctx->clip_area))
       return;
+
+    // large areas of this buffer are filled by DMA2D
+    if (draw_ctx->buf == data &&
+        lv_area_get_size(&clipped_coords) >= DMA2D_MIN_PIXELS) {
+      const lv_area_t* buf_area = draw_ctx->buf_area;
+      coord_t dx = clipped_coords.x1 - buf_area->x1;
+      coord_t dy = clipped_coords.y1 - buf_area->y1;
+      coord_t dw = lv_area_get_width(&clipped_coords);
+      coord_t dh = lv_area_get_height(&clipped_coords);
+      if (blend_dsc.opa >= LV_OPA_MAX)
+        DMAFillRect(data, lv_area_get_width(buf_area),
+                    lv_area_get_height(buf_area), dx, dy, dw, dh, color);
+      else
+        DMABlendRect(data, lv_area_get_width(buf_area),
+                     lv_area_get_height(buf_area), dx, dy, dw, dh, color,
+                     blend_dsc.opa);
+      // LVGL software rendering does not wait for DMA2D
+      DMAWait();
+      return;
+    }
+
     blend_dsc.blend_area = &clipped_coords;
     lv_draw_sw_blend(draw_ctx, &blend_dsc);
   }
@@ -969,11 +1007,35 @@ void BitmapBuffer::drawMask(coord_t x, coord_t y, const BitmapBuffer * mask, Lcd
   if (y >= ymax || x >= xmax || width <= 0 || x + width < xmin || y + height < ymin)
     return;
 
-  // TODO: This should be doable the same way as with
-  //       drawBitmapPattern() (just with ARGB as input).
-  //
   pixel_t color = COLOR_VAL(flags);
 
+  coord_t firstRow = max<coord_t>(0, ymin - y);
+  coord_t lastRow = min<coord_t>(height, ymax - y);
+  if (width * (lastRow - firstRow) >= DMA2D_MIN_PIXELS &&
+      width <= DMA2D_MASK_CHUNK_SIZE) {
+    // The 4 bit opacities are converted into A8 chunks, one chunk being
+    // converted while DMA2D blends the previous one
+    coord_t chunkRows = DMA2D_MASK_CHUNK_SIZE / width;
+    uint8_t chunk = 0;
+    for (coord_t row = firstRow; row < lastRow; row += chunkRows) {
+      coord_t rows = min<coord_t>(chunkRows, lastRow - row);
+      uint8_t * a8 = dmaMaskBuffer[chunk];
+      for (coord_t r = 0; r < rows; r++) {
+        const pixel_t * q = mask->getPixelPtrAbs(offsetX, row + r);
+        for (coord_t col = 0; col < width; col++) {
+          *a8++ = *((uint8_t *)q) * 17;
+          MOVE_TO_NEXT_RIGHT_PIXEL(q);
+        }
+      }
+      DMACopyAlphaMask(data, _width, _height, x, y + row,
+                       dmaMaskBuffer[chunk], width, rows, 0, 0, width, rows,
+                       color);
+      chunk ^= 1;
+    }
+    DMAWait();
+    return;
+  }
+
   DMAWait();
   for (coord_t row = 0; row < height; row++) {
     if (y + row < ymin || y + row >= ymax)
@@ -190,25 +190,74 @@ void Choice::onClicked()
     openMenu();
 }
 
+std::string Choice::getValueText(int value) const
+{
+  if (textHandler) return textHandler(value);
+  if (unsigned(value - vmin) < values.size()) return values[value - vmin];
+  return std::to_string(value);
+}
+
+void Choice::updateCache()
+{
+  if (!cacheKeyHandler) {
+    cacheValid = false;
+    return;
+  }
+
+  uint32_t key = cacheKeyHandler();
+  if (cacheValid && key == cachedKey) return;
+
+  cachedValues.clear();
+  cachedTexts.clear();
+  for (int i = vmin; i <= vmax; ++i) {
+    if (isValueAvailable && !isValueAvailable(i)) continue;
+    cachedValues.push_back(i);
+    cachedTexts.emplace_back(getValueText(i));
+  }
+  cachedKey = key;
+  cacheValid = true;
+}
+
+bool Choice::isAvailable(int min, int max)
+{
+  updateCache();
+  if (cacheValid) {
+    auto it = std::lower_bound(cachedValues.begin(), cachedValues.end(), min);
+    return it != cachedValues.end() && *it <= max;
+  }
+
+  if (!isValueAvailable) return true;
+  for (int i = min; i <= max; i++) {
+    if (isValueAvailable(i)) return true;
+  }
+  return false;
+}
+
 void Choice::fillMenu(Menu *menu, const FilterFct& filter)
 {
   menu->removeLines();
   auto value = _getValue();
-  
+
+  updateCache();
+
   int count = 0;
   int selectedIx = -1;
-  for (int i = vmin; i <= vmax; ++i) {
-    if (filter && !filter(i)) continue;
-    if (isValueAvailable && !isValueAvailable(i)) continue;
-    if (textHandler) {
-      menu->addLineBuffered(textHandler(i), [=]() { setValue(i); });
-    } else if (unsigned(i - vmin) < values.size()) {
-      menu->addLineBuffered(values[i - vmin], [=]() { setValue(i); });
-    } else {
-      menu->addLineBuffered(std::to_string(i), [=]() { setValue(i); });
+  if (cacheValid) {
+    for (size_t n = 0; n < cachedValues.size(); ++n) {
+      int i = cachedValues[n];
+      if (filter && !filter(i)) continue;
+      menu->addLineBuffered(cachedTexts[n], [=]() { setValue(i); });
+      if (value == i) { selectedIx = count; }
+      ++count;
+    }
+  } else {
+    for (int i = vmin; i <= vmax; ++i) {
+      if (filter && !filter(i)) continue;
+      if (isValueAvailable && !isValueAvailable(i)) continue;
+      menu->addLineBuffered(getValueText(i), [=]() { setValue(i); });
+      if (value == i) { selectedIx = count; }
+      ++count;
     }
-    if (value == i) { selectedIx = count; }
-    ++count;
   }
   menu->updateLines();
   if (selectedIx >= 0) { menu->select(selectedIx); }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include "form.h"
 
@@ -108,10 +109,24 @@ class Choice: public ChoiceBase {
     void setAvailableHandler(std::function<bool(int)> handler)
     {
       isValueAvailable = std::move(handler);
+      cacheValid = false;
+    }
+
+    // The available values and their text are kept from one menu opening
+    // to the next, as long as the key returned by the handler is the same
+    void setCacheKeyHandler(std::function<uint32_t()> handler)
+    {
+      cacheKeyHandler = std::move(handler);
+      cacheValid = false;
     }
 
     unsigned getIndexFromValue(int value) const
     {
+      if (cacheValid) {
+        return std::lower_bound(cachedValues.begin(), cachedValues.end(),
+                                value) - cachedValues.begin();
+      }
+
       if (!isValueAvailable) {
         return value - vmin;
       }
@@ -153,6 +168,7 @@ class Choice: public ChoiceBase {
     void setTextHandler(std::function<std::string(int)> handler)
     {
       textHandler = std::move(handler);
+      cacheValid = false;
       lv_event_send(lvobj, LV_EVENT_VALUE_CHANGED, nullptr);
     }
 
@@ -164,12 +180,14 @@ class Choice: public ChoiceBase {
     void setMin(int value)
     {
       vmin = value;
+      cacheValid = false;
       invalidate();
     }
 
     void setMax(int value)
     {
       vmax = value;
+      cacheValid = false;
       invalidate();
     }
 
@@ -188,6 +206,15 @@ class Choice: public ChoiceBase {
     std::function<bool(int)> isValueAvailable;
     std::function<std::string(int)> textHandler;
     std::function <void(Menu *)> beforeDisplayMenuHandler;
+    std::function<uint32_t()> cacheKeyHandler;
+
+    std::vector<int> cachedValues;
+    std::vector<std::string> cachedTexts;
+    uint32_t cachedKey = 0;
+    bool cacheValid = false;
+    void updateCache();
+    bool isAvailable(int min, int max);
+    std::string getValueText(int value) const;
 
     typedef std::function<bool(int16_t)> FilterFct;
     void fillMenu(Menu *menu, const FilterFct& filter = nullptr);
@@ -121,19 +121,6 @@ bool MenuToolbar::filterMenu(MenuToolbarButton* btn, int16_t filtermin,
   return btn->checked();
 }
 
-typedef std::function<bool(int)> IsValueAvailable;
-static int getFirstAvailable(int min, int max, IsValueAvailable isValueAvailable)
-{
-  int retval = 0;
-  for (int i = min; i <= max; i++) {
-    if (isValueAvailable(i)) {
-      retval = i;
-      break;
-    }
-  }
-  return retval;
-}
-
 void MenuToolbar::addButton(const char* picto, int16_t filtermin,
                             int16_t filtermax)
 {
@@ -142,9 +129,7 @@ void MenuToolbar::addButton(const char* picto, int16_t filtermin,
 
   if (vmin > filtermin || vmax < filtermin) return;
 
-  if (choice->isValueAvailable &&
-      getFirstAvailable(filtermin, filtermax, choice->isValueAvailable) == 0)
-    return;
+  if (!choice->isAvailable(filtermin, filtermax)) return;
 
   rect_t r = getButtonRect(children.size());
   auto button = new MenuToolbarButton(this, r, picto);
@@ -461,5 +461,14 @@ void Window::removeChild(Window* window)
 
 void Window::invalidate(const rect_t & rect)
 {
-  if (lvobj) lv_obj_invalidate(lvobj);
+  if (!lvobj) return;
+
+  // only the given part of the window (in window coordinates) is redrawn
+  lv_area_t area;
+  lv_obj_get_coords(lvobj, &area);
+  area.x1 += rect.x;
+  area.y1 += rect.y;
+  area.x2 = area.x1 + rect.w - 1;
+  area.y2 = area.y1 + rect.h - 1;
+  lv_obj_invalidate_area(lvobj, &area);
 }
@@ -31,8 +31,52 @@ volatile tmr10ms_t g_tmr10ms;
 
 TimerState timersStates[TIMERS] = { { 0 } };
 
+// Timers in use and what they depend on, derived from the model timers
+// when they change rather than re-read every 10ms
+struct TimerTrigger {
+  uint8_t    idx;
+  tmrmode_t  mode;
+  swsrc_t    swtch;
+  tmrstart_t start;
+  tmrval_t   countdownEnd;  // countdown events happen below this value
+  uint8_t    countdown:1;
+  uint8_t    minuteBeep:1;
+  uint8_t    showElapsed:1;
+};
+
+static TimerTrigger timerTriggers[TIMERS];
+static uint8_t timerTriggersCount;
+static uint16_t timerTriggersRevision;
+static bool timerTriggersValid = false;
+
+static void checkTimerTriggers()
+{
+  if (timerTriggersValid && timerTriggersRevision == modelDataRevision)
+    return;
+
+  timerTriggersCount = 0;
+  for (uint8_t i = 0; i < TIMERS; i++) {
+    const TimerData & timer = g_model.timers[i];
+    if (timer.mode == TMRMODE_OFF) continue;
+
+    TimerTrigger & trigger = timerTriggers[timerTriggersCount++];
+    trigger.idx = i;
+    trigger.mode = timer.mode;
+    trigger.swtch = timer.swtch;
+    trigger.start = timer.start;
+    trigger.countdownEnd = max<tmrval_t>(TIMER_COUNTDOWN_START(i), 30);
+    trigger.countdown = timer.countdownBeep && timer.start;
+    trigger.minuteBeep = timer.minuteBeep;
+    trigger.showElapsed = timer.showElapsed;
+  }
+
+  timerTriggersRevision = modelDataRevision;
+  timerTriggersValid = true;
+}
+
 void timerReset(uint8_t idx)
 {
+  timerTriggersValid = false;
   TimerState & timerState = timersStates[idx];
   timerState.state = TMR_OFF; // is changed to RUNNING dep from mode
   timerState.val = g_model.timers[idx].start;
@@ -41,6 +85,7 @@ void timerReset(uint8_t idx)
 
 void timerSet(int idx, int val)
 {
+  timerTriggersValid = false;
   TimerState & timerState = timersStates[idx];
   timerState.state = TMR_OFF; // is changed to RUNNING dep from mode
   timerState.val = val;
@@ -73,106 +118,107 @@ void saveTimers()
 
 void evalTimers(int16_t throttle, uint8_t tick10ms)
 {
-  for (uint8_t i=0; i<TIMERS; i++) {
-    tmrmode_t timerMode = g_model.timers[i].mode;
-    tmrstart_t timerStart = g_model.timers[i].start;
-    int16_t     timerSwtch = g_model.timers[i].swtch;
+  checkTimerTriggers();
+
+  for (uint8_t t=0; t<timerTriggersCount; t++) {
+    const TimerTrigger & trigger = timerTriggers[t];
+    uint8_t i = trigger.idx;
+    tmrmode_t timerMode = trigger.mode;
+    tmrstart_t timerStart = trigger.start;
     TimerState * timerState = &timersStates[i];
-    uint32_t showElapsed = g_model.timers[i].showElapsed;
-
-    if (timerMode) {
-      if ((timerState->state == TMR_OFF)
-          && (timerMode != TMRMODE_THR_START)
-          && (timerMode != TMRMODE_START)) {
-       
-        timerState->state = TMR_RUNNING;
-        timerState->cnt = 0;
-        timerState->sum = 0;
-      }
 
-      if (timerMode == TMRMODE_THR_REL) {
-        timerState->cnt++;
-        timerState->sum += throttle;
-      }
+    if ((timerState->state == TMR_OFF)
+        && (timerMode != TMRMODE_THR_START)
+        && (timerMode != TMRMODE_START)) {
+
+      timerState->state = TMR_RUNNING;
+      timerState->cnt = 0;
+      timerState->sum = 0;
+    }
+
+    if (timerMode == TMRMODE_THR_REL) {
+      timerState->cnt++;
+      timerState->sum += throttle;
+    }
 
-      if ((timerState->val_10ms += tick10ms) >= 100) {
-        if (timerState->val == TIMER_MAX) break;
-        if (timerState->val == TIMER_MIN) break;
+    if ((timerState->val_10ms += tick10ms) >= 100) {
+      if (timerState->val == TIMER_MAX) break;
+      if (timerState->val == TIMER_MIN) break;
 
-        timerState->val_10ms -= 100;
-        tmrval_t newTimerVal = timerState->val;
-        if (timerStart) newTimerVal = timerStart - newTimerVal;
+      timerState->val_10ms -= 100;
+      tmrval_t newTimerVal = timerState->val;
+      if (timerStart) newTimerVal = timerStart - newTimerVal;
 
-        if (timerMode == TMRMODE_START) {
-          // Start timer based on switch
-          if (getSwitch(timerSwtch) && timerState->state == TMR_OFF) {
+      if (timerMode == TMRMODE_START) {
+        // Start timer based on switch
+        if (timerState->state == TMR_OFF && getSwitch(trigger.swtch)) {
+          timerState->state = TMR_RUNNING;  // start timer running
+          timerState->cnt = 0;
+          timerState->sum = 0;
+        }
+        if (timerState->state != TMR_OFF) {
+          newTimerVal++;
+        }
+      } else if (getSwitch(trigger.swtch)) {
+
+        // Modes conditional on switch at any time
+        if (timerMode == TMRMODE_ON) {
+          newTimerVal++;
+        } else if (timerMode == TMRMODE_THR) {
+          if (throttle) newTimerVal++;
+        } else if (timerMode == TMRMODE_THR_REL) {
+          // throttle was normalized to 0 to 128 value
+          // (throttle/64*2 (because - range is added as well)
+          if ((timerState->sum / timerState->cnt) >= 128) {
+            newTimerVal++;  // add second used of throttle
+            timerState->sum -= 128 * timerState->cnt;
+          }
+          timerState->cnt = 0;
+        } else if (timerMode == TMRMODE_THR_START) {
+          // we can't rely on (throttle || newTimerVal > 0) as a detection if
+          // timer should be running because having persistent timer brakes
+          // this rule
+          if ((throttle > THR_TRG_TRESHOLD) && timerState->state == TMR_OFF) {
             timerState->state = TMR_RUNNING;  // start timer running
             timerState->cnt = 0;
             timerState->sum = 0;
+            // TRACE("Timer[%d] THr triggered", i);
           }
-          if (timerState->state != TMR_OFF) {
-            newTimerVal++;
-          } 
-        } else if (getSwitch(timerSwtch)) {
-
-          // Modes conditional on switch at any time
-          if (timerMode == TMRMODE_ON) {
-            newTimerVal++;
-          } else if (timerMode == TMRMODE_THR) {
-            if (throttle) newTimerVal++;
-          } else if (timerMode == TMRMODE_THR_REL) {
-            // throttle was normalized to 0 to 128 value
-            // (throttle/64*2 (because - range is added as well)
-            if ((timerState->sum / timerState->cnt) >= 128) {  
-              newTimerVal++;  // add second used of throttle
-              timerState->sum -= 128 * timerState->cnt;
-            }
-            timerState->cnt = 0;
-          } else if (timerMode == TMRMODE_THR_START) {
-            // we can't rely on (throttle || newTimerVal > 0) as a detection if
-            // timer should be running because having persistent timer brakes
-            // this rule
-            if ((throttle > THR_TRG_TRESHOLD) && timerState->state == TMR_OFF) {
-              timerState->state = TMR_RUNNING;  // start timer running
-              timerState->cnt = 0;
-              timerState->sum = 0;
-              // TRACE("Timer[%d] THr triggered", i);
-            }
-            if (timerState->state != TMR_OFF) newTimerVal++;
-          }
+          if (timerState->state != TMR_OFF) newTimerVal++;
         }
+      }
 
-        switch (timerState->state) {
-          case TMR_RUNNING:
-            if (timerStart && newTimerVal >= (tmrval_t)timerStart) {
-              AUDIO_TIMER_ELAPSED(i);
-              timerState->state = TMR_NEGATIVE;
-              // TRACE("Timer[%d] negative", i);
-            }
-            break;
-          case TMR_NEGATIVE:
-            if (newTimerVal >= (tmrval_t)timerStart + MAX_ALERT_TIME) {
-              timerState->state = TMR_STOPPED;
-              // TRACE("Timer[%d] stopped state at %d", i, newTimerVal);
-            }
-            break;
-        }
+      switch (timerState->state) {
+        case TMR_RUNNING:
+          if (timerStart && newTimerVal >= (tmrval_t)timerStart) {
+            AUDIO_TIMER_ELAPSED(i);
+            timerState->state = TMR_NEGATIVE;
+            // TRACE("Timer[%d] negative", i);
+          }
+          break;
+        case TMR_NEGATIVE:
+          if (newTimerVal >= (tmrval_t)timerStart + MAX_ALERT_TIME) {
+            timerState->state = TMR_STOPPED;
+            // TRACE("Timer[%d] stopped state at %d", i, newTimerVal);
+          }
+          break;
+      }
+
+      // if counting backwards - display backwards
+      if (timerStart) newTimerVal = timerStart - newTimerVal;
 
-        // if counting backwards - display backwards
-        if (timerStart) newTimerVal = timerStart - newTimerVal;
-
-        if (newTimerVal != timerState->val) {
-          timerState->val = newTimerVal;
-          if (timerState->state == TMR_RUNNING) {
-            if (g_model.timers[i].countdownBeep && g_model.timers[i].start) {
-              AUDIO_TIMER_COUNTDOWN(i, newTimerVal);
-            }
-            tmrval_t announceVal = newTimerVal;
-            if (showElapsed) announceVal = timerStart - newTimerVal;
-            if (g_model.timers[i].minuteBeep && (announceVal % 60) == 0) {
-              AUDIO_TIMER_MINUTE(announceVal);
-              // TRACE("Timer[%d] %d minute announcement", i, newTimerVal/60);
-            }
+      // announcements only when the value changes
+      if (newTimerVal != timerState->val) {
+        timerState->val = newTimerVal;
+        if (timerState->state == TMR_RUNNING) {
+          if (trigger.countdown && newTimerVal <= trigger.countdownEnd) {
+            AUDIO_TIMER_COUNTDOWN(i, newTimerVal);
+          }
+          tmrval_t announceVal = newTimerVal;
+          if (trigger.showElapsed) announceVal = timerStart - newTimerVal;
+          if (trigger.minuteBeep && (announceVal % 60) == 0) {
+            AUDIO_TIMER_MINUTE(announceVal);
+            // TRACE("Timer[%d] %d minute announcement", i, newTimerVal/60);
           }
         }
       }
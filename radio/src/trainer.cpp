@@ -27,6 +27,39 @@ int16_t trainerInput[MAX_TRAINER_CHANNELS];
 uint8_t trainerInputValidityTimer;
 uint8_t currentTrainerMode = 0xff;
 
+Fifo<uint16_t, TRAINER_CAPTURE_FIFO_SIZE> trainerCaptureFifo;
+
+void processTrainerPulses()
+{
+  static uint16_t lastCapt = 0;
+  static int8_t channelNumber = -1;
+
+  uint16_t capture;
+  while (trainerCaptureFifo.pop(capture)) {
+    uint16_t val = (uint16_t)(capture - lastCapt) / 2;
+    lastCapt = capture;
+
+    // G: Prioritize reset pulse. (Needed when less than 16 incoming pulses)
+    //
+    if (val > 4000 && val < 19000) {
+      channelNumber = 0; // triggered
+    }
+    else {
+      if (channelNumber >= 0 && channelNumber < MAX_TRAINER_CHANNELS) {
+        if (val > 800 && val < 2200) {
+          trainerInputValidityTimer = TRAINER_IN_VALID_TIMEOUT;
+          trainerInput[channelNumber++] =
+            // +-500 != 512, but close enough.
+            (int16_t)(val - 1500) * (g_eeGeneral.PPM_Multiplier+10) / 10;
+        }
+        else {
+          channelNumber = -1; // not triggered
+        }
+      }
+    }
+  }
+}
+
 enum {
   TRAINER_NOT_CONNECTED = 0,
   TRAINER_CONNECTED,
@@ -76,6 +109,7 @@ void stopTrainer()
 #if defined(SBUS_TRAINER)
     case TRAINER_MODE_MASTER_SERIAL:
       sbusSetGetByte(nullptr);
+      sbusSetGetRxSpan(nullptr, nullptr);
       break;
 #endif
 
@@ -88,6 +122,7 @@ void stopTrainer()
 #if defined(TRAINER_MODULE_SBUS)
     case TRAINER_MODE_MASTER_SBUS_EXTERNAL_MODULE:
       sbusSetGetByte(nullptr);
+      sbusSetGetRxSpan(nullptr, nullptr);
       stop_trainer_module_sbus();
       break;
 #endif
@@ -128,6 +163,7 @@ void checkTrainerSettings()
 #if defined(SBUS_TRAINER)
       case TRAINER_MODE_MASTER_SERIAL:
         sbusSetGetByte(sbusAuxGetByte);
+        sbusSetGetRxSpan(sbusAuxGetRxSpan, sbusAuxConsumeRx);
         break;
 #endif
 
@@ -141,6 +177,8 @@ void checkTrainerSettings()
       case TRAINER_MODE_MASTER_SBUS_EXTERNAL_MODULE:
         init_trainer_module_sbus();
         sbusSetGetByte(trainerModuleSbusGetByte);
+        sbusSetGetRxSpan(trainerModuleSbusGetRxSpan,
+                         trainerModuleSbusConsumeRx);
         break;
 #endif
     }
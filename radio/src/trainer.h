@@ -23,6 +23,7 @@
 #define _TRAINER_H_
 
 #include "dataconstants.h"
+#include "fifo.h"
 
 // Trainer input channels
 extern int16_t trainerInput[MAX_TRAINER_CHANNELS];
@@ -38,36 +39,18 @@ void checkTrainerSettings();
 void stopTrainer();
 void forceResetTrainerSettings();
 
+// Raw PPM edge timestamps, queued by the capture ISR and
+// decoded in bulk by processTrainerPulses() from the mixer task
+#define TRAINER_CAPTURE_FIFO_SIZE 64
+extern Fifo<uint16_t, TRAINER_CAPTURE_FIFO_SIZE> trainerCaptureFifo;
+
 // Needs to be inlined to avoid slow function calls in ISR routines
 inline void captureTrainerPulses(uint16_t capture)
 {
-  static uint16_t lastCapt = 0;
-  static int8_t channelNumber = -1;
-
-  uint16_t val = (uint16_t)(capture - lastCapt) / 2;
-  lastCapt = capture;
-
-  // We process trainerInput right here to make servo movement as smooth as possible
-  //    while under trainee control
-  //
-  // G: Prioritize reset pulse. (Needed when less than 16 incoming pulses)
-  //
-  if (val > 4000 && val < 19000) {
-    channelNumber = 0; // triggered
-  }
-  else {
-    if (channelNumber >= 0 && channelNumber < MAX_TRAINER_CHANNELS) {
-      if (val > 800 && val < 2200) {
-        trainerInputValidityTimer = TRAINER_IN_VALID_TIMEOUT;
-        trainerInput[channelNumber++] =
-          // +-500 != 512, but close enough.
-          (int16_t)(val - 1500) * (g_eeGeneral.PPM_Multiplier+10) / 10;
-      }
-      else {
-        channelNumber = -1; // not triggered
-      }
-    }
-  }
+  trainerCaptureFifo.push(capture);
 }
 
+// Decode all queued PPM edges into trainerInput
+void processTrainerPulses();
+
 #endif // _TRAINER_H_
@@ -97,6 +97,7 @@ ISTR(SWTYPES);
 ISTR(POTTYPES);
 ISTR(ANTENNA_MODES);
 ISTR(SAMPLE_MODES);
+ISTR(STICK_FILTER_TYPES);
 ISTR(SPORT_UPDATE_POWER_MODES);
 ISTR(CRSF_BAUDRATE);
 ISTR(PPM_POL);
@@ -273,12 +274,18 @@ const char STR_US[] = TR_US;
 const char STR_HZ[]  = TR_HZ;
 const char STR_TMIXMAXMS[] = TR_TMIXMAXMS;
 const char STR_FREE_STACK[] = TR_FREE_STACK;
+const char STR_CPU_LOAD[] = TR_CPU_LOAD;
 const char STR_INT_GPS_LABEL[]  = TR_INT_GPS_LABEL;
 const char STR_HEARTBEAT_LABEL[]  = TR_HEARTBEAT_LABEL;
 const char STR_LUA_SCRIPTS_LABEL[]  = TR_LUA_SCRIPTS_LABEL;
 const char STR_FREE_MEM_LABEL[]  = TR_FREE_MEM_LABEL;
 const char STR_DURATION_MS[] = TR_DURATION_MS;
 const char STR_INTERVAL_MS[] = TR_INTERVAL_MS;
+const char STR_WIDGET_MAX_US[] = TR_WIDGET_MAX_US;
+const char STR_WIDGET_CACHED[] = TR_WIDGET_CACHED;
+const char STR_FRAME_RATE[] = TR_FRAME_RATE;
+const char STR_FRAME_P99_MS[] = TR_FRAME_P99_MS;
+const char STR_FRAME_MAX_MS[] = TR_FRAME_MAX_MS;
 const char STR_MEM_USED_SCRIPT[] = TR_MEM_USED_SCRIPT;
 const char STR_MEM_USED_WIDGET[] = TR_MEM_USED_WIDGET;
 const char STR_MEM_USED_EXTRA[] = TR_MEM_USED_EXTRA;
@@ -622,6 +629,8 @@ const char STR_TELEMETRY_SENSORS[] = TR_TELEMETRY_SENSORS;
 const char STR_VALUE[] = TR_VALUE;
 const char STR_PERIOD[] = TR_PERIOD;
 const char STR_INTERVAL[] = TR_INTERVAL;
+const char STR_LOGS_ON_CHANGE[] = TR_LOGS_ON_CHANGE;
+const char STR_LOGS_LOGICAL_SWITCHES[] = TR_LOGS_LOGICAL_SWITCHES;
 const char STR_REPEAT[] = TR_REPEAT;
 const char STR_ENABLE[] = TR_ENABLE;
 const char STR_TOPLCDTIMER[] = TR_TOPLCDTIMER;
@@ -731,6 +740,8 @@ const char STR_MENU_OTHER[] = TR_MENU_OTHER;
 const char STR_MENU_INVERT[] = TR_MENU_INVERT;
 const char STR_AUDIO_MUTE[] = TR_AUDIO_MUTE;
 const char STR_JITTER_FILTER[] = TR_JITTER_FILTER;
+const char STR_STICK_FILTER[] = TR_STICK_FILTER;
+const char STR_STICK_FILTER_CUTOFF[] = TR_STICK_FILTER_CUTOFF;
 const char STR_DEAD_ZONE[] = TR_DEAD_ZONE;
 const char STR_RTC_CHECK[]  = TR_RTC_CHECK;
 const char STR_EXIT[] = TR_EXIT;
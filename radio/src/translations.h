@@ -450,12 +450,18 @@ extern const char STR_US[];
 extern const char STR_HZ[];
 extern const char STR_TMIXMAXMS[];
 extern const char STR_FREE_STACK[];
+extern const char STR_CPU_LOAD[];
 extern const char STR_INT_GPS_LABEL[];
 extern const char STR_HEARTBEAT_LABEL[];
 extern const char STR_LUA_SCRIPTS_LABEL[];
 extern const char STR_FREE_MEM_LABEL[];
 extern const char STR_DURATION_MS[];
 extern const char STR_INTERVAL_MS[];
+extern const char STR_WIDGET_MAX_US[];
+extern const char STR_WIDGET_CACHED[];
+extern const char STR_FRAME_RATE[];
+extern const char STR_FRAME_P99_MS[];
+extern const char STR_FRAME_MAX_MS[];
 extern const char STR_MEM_USED_SCRIPT[];
 extern const char STR_MEM_USED_WIDGET[];
 extern const char STR_MEM_USED_EXTRA[];
@@ -809,6 +815,7 @@ extern const char STR_MAXBAUDRATE[];
 extern const char STR_BAUDRATE[];
 extern const char STR_SAMPLE_MODE[];
 extern const char* const STR_SAMPLE_MODES[];
+extern const char* const STR_STICK_FILTER_TYPES[];
 extern const char STR_BLUETOOTH_BAUDRATE[];
 extern const char STR_SD_INFO_TITLE[];
 extern const char STR_SD_TYPE[];
@@ -1015,6 +1022,8 @@ extern const char STR_TELEMETRY_SENSORS[];
 extern const char STR_VALUE[];
 extern const char STR_PERIOD[];
 extern const char STR_INTERVAL[];
+extern const char STR_LOGS_ON_CHANGE[];
+extern const char STR_LOGS_LOGICAL_SWITCHES[];
 extern const char STR_REPEAT[];
 extern const char STR_ENABLE[];
 extern const char STR_TOPLCDTIMER[];
@@ -1126,6 +1135,8 @@ extern const char STR_MENU_OTHER[];
 extern const char STR_MENU_INVERT[];
 extern const char STR_AUDIO_MUTE[];
 extern const char STR_JITTER_FILTER[];
+extern const char STR_STICK_FILTER[];
+extern const char STR_STICK_FILTER_CUTOFF[];
 extern const char STR_DEAD_ZONE[];
 extern const char STR_RTC_CHECK[];
 extern const char STR_SPORT_UPDATE_POWER_MODE[];
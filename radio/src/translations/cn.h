@@ -49,7 +49,7 @@
 #define TR_TRNMODE                     "关","相加","替换"
 #define TR_TRNCHN                      "CH1","CH2","CH3","CH4"
 
-#define TR_AUX_SERIAL_MODES            "调试","回传镜像","回传输入","SBUS教练","LUA脚本","CLI","GPS","Debug","SpaceMouse","外置发射"
+#define TR_AUX_SERIAL_MODES            "调试","回传镜像","回传输入","SBUS教练","LUA脚本","CLI","GPS","Debug","SpaceMouse","外置发射","回传数据流"
 #define TR_SWTYPES                     "无","回弹","2段","3段"
 #define TR_POTTYPES                    "无","有中点旋钮","多段旋钮","无中点旋钮","侧滑块"
 #define TR_VPERSISTENT                 "禁用","随飞行记录复位","随手动复位"
@@ -400,12 +400,18 @@
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
 #define TR_FREE_STACK                  "Free stack"
+#define TR_CPU_LOAD                    "CPU load"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
 #define TR_FREE_MEM_LABEL              "Free mem"
 #define TR_DURATION_MS                 TR("[D]","持续时间(ms): ")
 #define TR_INTERVAL_MS                 TR("[I]","间隔时间(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT             "脚本(B): "
 #define TR_MEM_USED_WIDGET             "小部件(B): "
 #define TR_MEM_USED_EXTRA              "附加(B): "
@@ -852,6 +858,8 @@
 #define TR_VALUE                       "数值"
 #define TR_PERIOD                      "周期"
 #define TR_INTERVAL                    "间隔"
+#define TR_LOGS_ON_CHANGE              "On change"
+#define TR_LOGS_LOGICAL_SWITCHES       "Logical switches"
 #define TR_REPEAT                      "循环"
 #define TR_ENABLE                      "启用"
 #define TR_DISABLE                     "Disable"
@@ -1108,6 +1116,9 @@
 #define TR_MENU_INVERT                 "反向"
 #define TR_AUDIO_MUTE                  TR("自动静音","音频停播时自动静音")
 #define TR_JITTER_FILTER               "模拟输入滤波"
+#define TR_STICK_FILTER                "Stick filter"
+#define TR_STICK_FILTER_TYPES          "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF         "Filter cutoff"
 #define TR_DEAD_ZONE                   "死区"
 #define TR_RTC_CHECK                   TR("检查时间电池", "检查时间驱动电池电压")
 #define TR_AUTH_FAILURE                "验证失败"
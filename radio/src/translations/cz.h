@@ -52,7 +52,7 @@
 #define TR_VBLMODE                     TR("Vyp","Vypnuto"),TR("Kláv.","Klávesy"),"Páky","Vše",TR("Zap","Zapnuto")
 #define TR_TRNMODE                     "X","Sečíst","Zaměnit"
 #define TR_TRNCHN                      "CH1","CH2","CH3","CH4"
-#define TR_AUX_SERIAL_MODES            "VYP","Telemetrie zrcadlení","Telemetrie vstup","SBUS Trenér","LUA","CLI","GPS","Debug","SpaceMouse","Externí modul"
+#define TR_AUX_SERIAL_MODES            "VYP","Telemetrie zrcadlení","Telemetrie vstup","SBUS Trenér","LUA","CLI","GPS","Debug","SpaceMouse","Externí modul","Telemetrie stream"
 #define TR_SWTYPES                     "Žádný","Bez aretace","2-polohový","3-polohový"
 #define TR_POTTYPES                    "Žádný",TR("Pot s aret.","Pot s aretací"),TR("Vícepol př.","Vícepol. přep."),TR("Pot","Potenciometr"),"Slider"
 #define TR_VPERSISTENT                 "Ne","V rámci letu","Reset ručně"
@@ -415,12 +415,18 @@
 
 #define TR_TMIXMAXMS                   "Tmix max"
 #define TR_FREE_STACK                  "Free stack"
+#define TR_CPU_LOAD                    "CPU load"
 #define TR_INT_GPS_LABEL               "Vnitřní GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua skripty"
 #define TR_FREE_MEM_LABEL              "Free mem"
 #define TR_DURATION_MS             TR("[D]","Duration(ms): ")
 #define TR_INTERVAL_MS             TR("[I]","Interval(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
@@ -862,6 +868,8 @@
 #define TR_VALUE                       "Hodnota"
 #define TR_PERIOD                      "Perioda"
 #define TR_INTERVAL                    "Interval"
+#define TR_LOGS_ON_CHANGE              "On change"
+#define TR_LOGS_LOGICAL_SWITCHES       "Logical switches"
 #define TR_REPEAT                      "Opakovat"
 #define TR_ENABLE                      "Povoleno"
 #define TR_DISABLE                     "Disable"
@@ -1124,6 +1132,9 @@
 #define TR_MENU_INVERT                 "Invertovat"
 #define TR_AUDIO_MUTE                  TR("Ztlumení zvuku","Ztlumení, pokud není slyšet zvuk")
 #define TR_JITTER_FILTER               "ADC Filtr"
+#define TR_STICK_FILTER                "Stick filter"
+#define TR_STICK_FILTER_TYPES          "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF         "Filter cutoff"
 #define TR_DEAD_ZONE                   "Dead zone"
 #define TR_RTC_CHECK                   TR("Kontr RTC", "Hlídat RTC napětí")
 #define TR_AUTH_FAILURE                "Auth-selhala"
@@ -49,7 +49,7 @@
 #define TR_VBLMODE                     "FRA","Taster",TR("Ctrl","Controls"),"Begge","TIL"
 #define TR_TRNMODE                     "FRA",TR("+=","Læg til"),TR(":=","Erstat")
 #define TR_TRNCHN                      "KA1","KA2","KA3","KA4"
-#define TR_AUX_SERIAL_MODES            "FRA","Telem spejlet","Telemetri ind","SBUS træner","LUA","CLI","GPS","Debug","SpaceMouse","Eksternt modul"
+#define TR_AUX_SERIAL_MODES            "FRA","Telem spejlet","Telemetri ind","SBUS træner","LUA","CLI","GPS","Debug","SpaceMouse","Eksternt modul","Telem strøm"
 
 #if LCD_W > LCD_H
   #define TR_SWTYPES                      "Ingen", "2 pos skift","2 position","3 position"
@@ -410,12 +410,18 @@
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
 #define TR_FREE_STACK                  "Fri stak"
+#define TR_CPU_LOAD                    "CPU-belastning"
 #define TR_INT_GPS_LABEL               "Intern GPS"
 #define TR_HEARTBEAT_LABEL             "Hjerte puls"
 #define TR_LUA_SCRIPTS_LABEL           "Lua script"
 #define TR_FREE_MEM_LABEL              "Fri mem"
 #define TR_DURATION_MS             TR("[D]","Varighed(ms): ")
 #define TR_INTERVAL_MS             TR("[I]","Interval(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
@@ -862,6 +868,8 @@
 #define TR_VALUE                       "Værdi"
 #define TR_PERIOD                      "Periode"
 #define TR_INTERVAL                    "Interval"
+#define TR_LOGS_ON_CHANGE              "On change"
+#define TR_LOGS_LOGICAL_SWITCHES       "Logical switches"
 #define TR_REPEAT                      "Gentag"
 #define TR_ENABLE                      "Aktiver"
 #define TR_DISABLE                     "Deaktiver"
@@ -1124,6 +1132,9 @@
 #define TR_MENU_INVERT                 "Invers"
 #define TR_AUDIO_MUTE                  TR("Audio fra","Audio fra, hvis der ikke gives lyd")
 #define TR_JITTER_FILTER               "ADC filter"
+#define TR_STICK_FILTER                "Stick filter"
+#define TR_STICK_FILTER_TYPES          "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF         "Filter cutoff"
 #define TR_DEAD_ZONE                   "Dødt område"
 #define TR_RTC_CHECK                   TR("Check RTC", "Check RTC spænding")
 #define TR_AUTH_FAILURE                "Godkendelse fejlet"
@@ -52,7 +52,7 @@
 #define TR_VBLMODE                     "AUS","Taste","Stks","Beide","EIN"
 #define TR_TRNMODE                     "AUS",TR("+=","Addiere"),TR(":=","Ersetze")
 #define TR_TRNCHN                      "CH1","CH2","CH3","CH4"
-#define TR_AUX_SERIAL_MODES            "AUS","Telem weiterl.","Telemetrie In","SBUS Eingang","LUA","CLI","GPS","Debug","SpaceMouse","Externes Modul"
+#define TR_AUX_SERIAL_MODES            "AUS","Telem weiterl.","Telemetrie In","SBUS Eingang","LUA","CLI","GPS","Debug","SpaceMouse","Externes Modul","Telem Stream"
 #define TR_SWTYPES                     "Kein","Taster","2POS","3POS"
 #define TR_POTTYPES                    "Kein",TR("Poti m.Ras","Poti mit Raste"),TR("Stufens.","Stufen-Schalter"),TR("Pot","Poti ohne Raste"), "Schieber"
 #define TR_VPERSISTENT                 "AUS","Flugzeit","Manuell Rück"
@@ -406,12 +406,18 @@
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS         	       "Tmix max"
 #define TR_FREE_STACK     		       "Freier Stack"
+#define TR_CPU_LOAD                    "CPU-Last"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
 #define TR_FREE_MEM_LABEL              "Free mem"
 #define TR_DURATION_MS             TR("[D]","Dauer(ms): ")
 #define TR_INTERVAL_MS             TR("[I]","Intervall(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
@@ -851,6 +857,8 @@
 #define TR_VALUE               		   "Wert"
 #define TR_PERIOD                    "Periode"
 #define TR_INTERVAL                  "Intervall"
+#define TR_LOGS_ON_CHANGE            "Bei Änderung"
+#define TR_LOGS_LOGICAL_SWITCHES     "Log. Schalter"
 #define TR_REPEAT                      "Wiederholung"
 #define TR_ENABLE                      "Aktivieren"
 #define TR_TOPLCDTIMER        		   "oberer LCD Timer"
@@ -1114,6 +1122,9 @@
 #define TR_MENU_INVERT                 "Invertieren<!>"
 #define TR_AUDIO_MUTE                  TR("Ton Stumm","Geräuschunterdrückung")
 #define TR_JITTER_FILTER               "ADC Filter"
+#define TR_STICK_FILTER                "Knüppelfilter"
+#define TR_STICK_FILTER_TYPES          "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF         "Grenzfreq."
 #define TR_DEAD_ZONE                   "Dead zone"
 #define TR_RTC_CHECK                   TR("RTC Prüfen", "RTC Spann. prüfen")
 #define TR_AUTH_FAILURE                "Auth-Fehler"
@@ -48,7 +48,7 @@
 #define TR_TRNMODE                     "OFF",TR("+=","Add"),TR(":=","Replace")
 #define TR_TRNCHN                      "CH1","CH2","CH3","CH4"
 
-#define TR_AUX_SERIAL_MODES            "OFF","Telem Mirror","Telemetry In","SBUS Trainer","LUA","CLI","GPS","Debug","SpaceMouse","External module"
+#define TR_AUX_SERIAL_MODES            "OFF","Telem Mirror","Telemetry In","SBUS Trainer","LUA","CLI","GPS","Debug","SpaceMouse","External module","Telem Stream"
 #define TR_SWTYPES                     "None","Toggle","2POS","3POS"
 #define TR_POTTYPES                    "None",TR("Pot w. det","Pot with detent"),TR("Multipos","Multipos Switch"),"Pot", "Slider"
 #define TR_VPERSISTENT                 "OFF","Flight","Manual Reset"
@@ -405,12 +405,18 @@
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
 #define TR_FREE_STACK                  "Free stack"
+#define TR_CPU_LOAD                    "CPU load"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
 #define TR_FREE_MEM_LABEL              "Free mem"
 #define TR_DURATION_MS             TR("[D]","Duration(ms): ")
 #define TR_INTERVAL_MS             TR("[I]","Interval(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
@@ -857,6 +863,8 @@
 #define TR_VALUE                       "Value"
 #define TR_PERIOD                      "Period"
 #define TR_INTERVAL                    "Interval"
+#define TR_LOGS_ON_CHANGE              "On change"
+#define TR_LOGS_LOGICAL_SWITCHES       "Logical switches"
 #define TR_REPEAT                      "Repeat"
 #define TR_ENABLE                      "Enable"
 #define TR_TOPLCDTIMER                 "Top LCD Timer"
@@ -1112,6 +1120,9 @@
 #define TR_MENU_INVERT                 "Invert"
 #define TR_AUDIO_MUTE                  TR("Audio mute","Mute if no sound")
 #define TR_JITTER_FILTER               "ADC filter"
+#define TR_STICK_FILTER                "Stick filter"
+#define TR_STICK_FILTER_TYPES          "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF         TR("Cutoff","Filter cutoff")
 #define TR_DEAD_ZONE                   "Dead zone"
 #define TR_RTC_CHECK                   TR("Check RTC", "Check RTC voltage")
 #define TR_AUTH_FAILURE                "Auth-failure"
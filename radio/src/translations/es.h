@@ -50,7 +50,7 @@
 #define TR_TRNMODE             "OFF",TR("+=","Añadir"),TR(":=","Cambiar")
 #define TR_TRNCHN              "CH1","CH2","CH3","CH4"
 
-#define TR_AUX_SERIAL_MODES    "UIT","Telem Mirror","Telemetría","Entrenador SBUS","LUA","CLI","GPS","Debug","SpaceMouse","Módulo externo"
+#define TR_AUX_SERIAL_MODES    "UIT","Telem Mirror","Telemetría","Entrenador SBUS","LUA","CLI","GPS","Debug","SpaceMouse","Módulo externo","Telem Stream"
 #define TR_SWTYPES             "Nada","Palanca","2POS","3POS"
 #define TR_POTTYPES            "Nada",TR("Pot con fij","Pot con fijador"),TR("Multipos","Switch multipos"),"Pot","Slider"
 #define TR_VPERSISTENT         "OFF","Vuelo","Reset manual"
@@ -396,12 +396,18 @@
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "Tmix máx"
 #define TR_FREE_STACK                 "Stack libre"
+#define TR_CPU_LOAD                   "Carga CPU"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL          "Lua scripts"
 #define TR_FREE_MEM_LABEL             "Free mem"
 #define TR_DURATION_MS             TR("[D]","Duration(ms): ")
 #define TR_INTERVAL_MS             TR("[I]","Interval(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
@@ -853,6 +859,8 @@
 #define TR_VALUE               "Valor"
 #define TR_PERIOD              "Period"
 #define TR_INTERVAL            "Interval"
+#define TR_LOGS_ON_CHANGE      "On change"
+#define TR_LOGS_LOGICAL_SWITCHES "Logical switches"
 #define TR_REPEAT                      "Repeat"
 #define TR_ENABLE                      "Enable"
 #define TR_DISABLE                     "Disable"
@@ -1116,6 +1124,9 @@
 #define TR_MENU_INVERT         "Invertir"
 #define TR_AUDIO_MUTE                  TR("Audio mute","Mute if no sound")
 #define TR_JITTER_FILTER       "Filtro ADC"
+#define TR_STICK_FILTER        "Filtro sticks"
+#define TR_STICK_FILTER_TYPES  "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF "Corte"
 #define TR_DEAD_ZONE           "Dead zone"
 #define TR_RTC_CHECK           TR("Check RTC", "Check RTC voltaje")
 #define TR_AUTH_FAILURE        "Fallo " LCDW_128_480_LINEBREAK  "autentificación"
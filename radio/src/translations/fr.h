@@ -51,7 +51,7 @@
 #define TR_VBLMODE                     "OFF",TR("Btns","Touches"),TR("Ctrl","Contrôles"),"Tous","ON"
 #define TR_TRNMODE                     "OFF",TR("+=","Ajoute"),TR(":=","Remplace")
 #define TR_TRNCHN                      "CH1","CH2","CH3","CH4"
-#define TR_AUX_SERIAL_MODES            "OFF","Recopie Télém.","Télémétrie In","Écolage SBUS","LUA","CLI","GPS","Débug","SpaceMouse","Module externe"
+#define TR_AUX_SERIAL_MODES            "OFF","Recopie Télém.","Télémétrie In","Écolage SBUS","LUA","CLI","GPS","Débug","SpaceMouse","Module externe","Flux Télém."
 
 #define TR_SWTYPES                     "Rien","Monostable","2-POS","3-POS"
 #define TR_POTTYPES                    "Rien",TR("Pots av. ctr","Pots avec centre"),TR("Multipos.","Inter multi-pos""Potentiomètre"),TR("Pots","Potentiomètre"),"Curseurs"
@@ -415,12 +415,18 @@
 
 #define TR_TMIXMAXMS                   "Tmix max"
 #define TR_FREE_STACK                  "Pile libre"
+#define TR_CPU_LOAD                    "Charge CPU"
 #define TR_INT_GPS_LABEL               "GPS interne"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
 #define TR_FREE_MEM_LABEL              "Mémoire libre"
 #define TR_DURATION_MS                 TR("[D]","Durée(ms): ")
 #define TR_INTERVAL_MS                 TR("[I]","Intervalle(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
@@ -862,6 +868,8 @@
 #define TR_VALUE                       "Valeur"
 #define TR_PERIOD                      "Période"
 #define TR_INTERVAL                    "Intervalle"
+#define TR_LOGS_ON_CHANGE              "Sur changement"
+#define TR_LOGS_LOGICAL_SWITCHES       "Inters logiques"
 #define TR_REPEAT                      "Répéter"
 #define TR_ENABLE                      "Activer"
 #define TR_DISABLE                     "Désactiver"
@@ -1132,6 +1140,9 @@
 #define TR_MENU_INVERT                 "Inverser"
 #define TR_AUDIO_MUTE                  TR("Audio muet","Muet si pas de son")
 #define TR_JITTER_FILTER               "Filtre ADC"
+#define TR_STICK_FILTER                "Filtre manches"
+#define TR_STICK_FILTER_TYPES          "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF         "Coupure"
 #define TR_DEAD_ZONE                   "Zone Neutre"
 #define TR_RTC_CHECK                   TR("Vérif. RTC", "Vérif. pile RTC")
 #define TR_AUTH_FAILURE                "Échec authentification"
@@ -53,7 +53,7 @@
 #define TR_TRNMODE             "OFF",TR("+=","Add"),TR(":=","Sost.")
 #define TR_TRNCHN              "CH1","CH2","CH3","CH4"
 
-#define TR_AUX_SERIAL_MODES             "OFF","Replica Telem","Telemetria In","SBUS Trainer","LUA","CLI","GPS","Debug","SpaceMouse","Modulo esterno"
+#define TR_AUX_SERIAL_MODES             "OFF","Replica Telem","Telemetria In","SBUS Trainer","LUA","CLI","GPS","Debug","SpaceMouse","Modulo esterno","Flusso Telem"
 #define TR_SWTYPES                      "Disab.","Toggle","2POS","3POS"
 #define TR_POTTYPES                     "Disab.",TR("Pot c. fer","Pot. con centro"),TR("Multipos","Inter. Multipos"),TR("Pot","Potenziometro"),"Slider"
 #define TR_VPERSISTENT                  "NO","Volo","Reset Manuale"
@@ -404,12 +404,18 @@
 #define TR_HZ                           "Hz"
 #define TR_TMIXMAXMS                    "Tmix max"
 #define TR_FREE_STACK                   "Stack libero"
+#define TR_CPU_LOAD                     "Carico CPU"
 #define TR_INT_GPS_LABEL                "GPS interno"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL            "Lua scripts"
 #define TR_FREE_MEM_LABEL               "Mem. libera"
 #define TR_DURATION_MS                  TR("[D]","Duration(ms): ")
 #define TR_INTERVAL_MS                  TR("[I]","Interval(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT              "Script(B): "
 #define TR_MEM_USED_WIDGET              "Widget(B): "
 #define TR_MEM_USED_EXTRA               "Extra(B): "
@@ -856,6 +862,8 @@
 #define TR_VALUE                        "Valore"
 #define TR_PERIOD                       "Periodo"
 #define TR_INTERVAL                     "Intervallo"
+#define TR_LOGS_ON_CHANGE               "On change"
+#define TR_LOGS_LOGICAL_SWITCHES        "Logical switches"
 #define TR_REPEAT                       "Ripeti"
 #define TR_ENABLE                       "Abilita"
 #define TR_TOPLCDTIMER                  "Timer LCD Su"
@@ -1111,6 +1119,9 @@
 #define TR_MENU_INVERT                  "Inverti"
 #define TR_AUDIO_MUTE                   TR("Audio muto","Muto senza suono")
 #define TR_JITTER_FILTER                "Filtro ADC"
+#define TR_STICK_FILTER                 "Filtro stick"
+#define TR_STICK_FILTER_TYPES           "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF          "Taglio"
 #define TR_DEAD_ZONE                    "Zona morta"
 #define TR_RTC_CHECK                    TR("Controllo RTC", "Controllo volt. RTC")
 #define TR_AUTH_FAILURE                 "Fallimento Auth"
@@ -50,7 +50,7 @@
 #define TR_VBLMODE             TR("Wył","Wyłącz"),TR("Przy","Przycisk"),TR("Drąż","Drązki"),"Oba",TR("Zał","Włącz")
 #define TR_TRNMODE             "Wył",TR("+=","Dodaj"),TR(":=","Zastąp")
 #define TR_TRNCHN              "KN1","KN2","KN3","KN4"
-#define TR_AUX_SERIAL_MODES    "Wyłącz","S-Port Kopia","Telemetria","Trener SBUS","LUA","CLI","GPS","Debug","SpaceMouse","Moduł zewnętrzny"
+#define TR_AUX_SERIAL_MODES    "Wyłącz","S-Port Kopia","Telemetria","Trener SBUS","LUA","CLI","GPS","Debug","SpaceMouse","Moduł zewnętrzny","Strumień Telem"
 #define TR_SWTYPES             "Brak","Chwil.","2POZ","3POZ"
 #define TR_POTTYPES            "Brak",TR("Pot w. det","Poten z zapadką"),TR("Multipos","Przeł.Wielopoz."),TR("Pot","Potencjometr"),"Suwak"
 #define TR_VPERSISTENT         "Wyłącz","Lot","Ręczny Reset"
@@ -401,12 +401,18 @@
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "TmixMaks"
 #define TR_FREE_STACK                 "Wolny stos"
+#define TR_CPU_LOAD                   "Obciążenie CPU"
 #define TR_INT_GPS_LABEL              "Wewnęt. GPS"
 #define TR_HEARTBEAT_LABEL            "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL          "Skrypty Lua"
 #define TR_FREE_MEM_LABEL             "Free mem"
 #define TR_DURATION_MS                TR("[C]","Czas trwania(ms): ")
 #define TR_INTERVAL_MS                TR("[O]","Okres(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT            "Skrypt(B): "
 #define TR_MEM_USED_WIDGET            "Widget(B): "
 #define TR_MEM_USED_EXTRA             "Ekstra(B): "
@@ -848,6 +854,8 @@
 #define TR_VALUE               "Wartość"
 #define TR_PERIOD              "Okres"
 #define TR_INTERVAL            "Interwał"
+#define TR_LOGS_ON_CHANGE      "On change"
+#define TR_LOGS_LOGICAL_SWITCHES "Logical switches"
 #define TR_REPEAT              "Powtórz"
 #define TR_ENABLE              "Włącz"
 #define TR_TOPLCDTIMER         "Top LCD Timer"
@@ -1111,6 +1119,9 @@
 #define TR_MENU_INVERT                  "Odwróć"
 #define TR_AUDIO_MUTE                  TR("Audio mute","Mute if no sound")
 #define TR_JITTER_FILTER                "Filtr ADC"
+#define TR_STICK_FILTER                 "Stick filter"
+#define TR_STICK_FILTER_TYPES           "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF          "Filter cutoff"
 #define TR_DEAD_ZONE                    "Dead zone"
 #define TR_RTC_CHECK                    TR("Check RTC", "Check RTC voltage")
 #define TR_AUTH_FAILURE                 "Auth-failure"
@@ -53,7 +53,7 @@
 #define TR_VBLMODE                      "Av",TR("Knapp","Knappar"),TR("Spak","Spakar"),"Allt","PÅ"
 #define TR_TRNMODE                      "Av",TR("+=","Addera"),TR(":=","Ersätt")
 #define TR_TRNCHN                       "KA1","KA2","KA3","KA4"
-#define TR_AUX_SERIAL_MODES             "AV","Speglad telemetri","Telemetri in","SBUS Lärare","LUA","CLI","GPS","Debug","SpaceMouse","Extern modul"
+#define TR_AUX_SERIAL_MODES             "AV","Speglad telemetri","Telemetri in","SBUS Lärare","LUA","CLI","GPS","Debug","SpaceMouse","Extern modul","Telemetriström"
 
 #if LCD_W > LCD_H
   #define TR_SWTYPES                    "Ingen", "2 pos flipp","2 pos","3 pos"
@@ -426,12 +426,18 @@
 
 #define TR_TMIXMAXMS                    "Tmix max"
 #define TR_FREE_STACK                   "Fri stack"
+#define TR_CPU_LOAD                     "CPU-last"
 #define TR_INT_GPS_LABEL                "Intern GPS"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL            "Lua-skript"
 #define TR_FREE_MEM_LABEL               "Ledigt minne"
 #define TR_DURATION_MS                  TR("[D]","Varaktighet(ms): ")
 #define TR_INTERVAL_MS                  TR("[I]","Intervall(ms): ")
+#define TR_WIDGET_MAX_US           TR("[W]","Widget(us): ")
+#define TR_WIDGET_CACHED           TR("[C]","Cached: ")
+#define TR_FRAME_RATE              TR("[F]","FPS: ")
+#define TR_FRAME_P99_MS            TR("[P]","p99(ms): ")
+#define TR_FRAME_MAX_MS            TR("[M]","Max(ms): ")
 #define TR_MEM_USED_SCRIPT              "Skript(B): "
 #define TR_MEM_USED_WIDGET              "Widget(B): "
 #define TR_MEM_USED_EXTRA               "Extra(B): "
@@ -878,6 +884,8 @@
 #define TR_VALUE                        "Värde"
 #define TR_PERIOD                       "Period"
 #define TR_INTERVAL                     "Intervall"
+#define TR_LOGS_ON_CHANGE               "On change"
+#define TR_LOGS_LOGICAL_SWITCHES        "Logical switches"
 #define TR_REPEAT                       "Upprepa"
 #define TR_ENABLE                       "Aktivera"
 #define TR_TOPLCDTIMER                  "Översta LCD timer"
@@ -1149,6 +1157,9 @@
 #define TR_MENU_INVERT                  "Invertera"
 #define TR_AUDIO_MUTE                   TR("Audio av","Audio av om inget ljud")
 #define TR_JITTER_FILTER                "ADC-filter"
+#define TR_STICK_FILTER                 "Stick filter"
+#define TR_STICK_FILTER_TYPES           "Jitter","1-Euro","Biquad"
+#define TR_STICK_FILTER_CUTOFF          "Filter cutoff"
 #define TR_DEAD_ZONE                    "Dödläge"
 #define TR_RTC_CHECK                    TR("Kolla RTC", "Kolla RTC-batteriet")
 #define TR_AUTH_FAILURE                 "Auth-failure"
@@ -25,7 +25,6 @@ void varioWakeup()
 {
   if (isFunctionActive(FUNCTION_VARIO)) {
     int varioFreq, varioDuration, varioPause=0;
-    uint8_t varioFlags;
 
     int verticalSpeed = 0;
     if (g_model.varioData.source) {
@@ -48,7 +47,6 @@ void varioWakeup()
     if (verticalSpeed <= varioCenterMin) {
       varioFreq = VARIO_FREQUENCY_ZERO + (g_eeGeneral.varioPitch*10) - (((VARIO_FREQUENCY_ZERO+(g_eeGeneral.varioPitch*10)-((VARIO_FREQUENCY_ZERO + (g_eeGeneral.varioPitch*10))/2)) * (verticalSpeed-varioCenterMin)) / varioMin);
       varioDuration = 80; // continuous beep: we will enter again here before the tone ends
-      varioFlags = PLAY_BACKGROUND|PLAY_NOW;
     }
     else if (verticalSpeed >= varioCenterMax || !g_model.varioData.centerSilent) {
       varioFreq = VARIO_FREQUENCY_ZERO + (g_eeGeneral.varioPitch*10) + (((VARIO_FREQUENCY_RANGE+(g_eeGeneral.varioRange*10)) * (verticalSpeed-varioCenterMin)) / varioMax);
@@ -58,13 +56,12 @@ void varioWakeup()
       else
         varioDuration = varioPeriod * (85 - (((verticalSpeed-varioCenterMin) * 25) / (varioCenterMax-varioCenterMin))) / 100;
       varioPause = varioPeriod - varioDuration;
-      varioFlags = PLAY_BACKGROUND;
     }
     else {
       return;
     }
 
-    AUDIO_VARIO(varioFreq, varioDuration, varioPause, varioFlags);
+    AUDIO_VARIO(varioFreq, varioDuration, varioPause);
   }
 }
 
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) EdgeTX
+#
+# License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# Checks the output of the CLI "bench" command:
+#  - fails if the mixer worst case exceeds its budget
+#  - fails if a kernel is slower than in a reference log (--reference)
+#  - appends the results to a JSON history file (--record)
+
+import argparse
+import json
+import sys
+
+
+def parse_log(filename):
+    results = {"build": None, "kernels": {}, "mixer_worst": None}
+    with open(filename) as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) < 2 or fields[0] != "bench":
+                continue
+            name = fields[1]
+            if name == "build" and len(fields) >= 4:
+                results["build"] = {"flavour": fields[2], "version": fields[3]}
+            elif name == "mixer_worst_us" and len(fields) >= 5:
+                results["mixer_worst"] = {"us": int(fields[2]),
+                                          "budget": int(fields[3]),
+                                          "pass": fields[4] == "pass"}
+            elif len(fields) >= 5 and fields[2].isdigit():
+                results["kernels"][name] = int(fields[4])
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check CLI bench results")
+    parser.add_argument("log", help="bench output captured from the CLI")
+    parser.add_argument("--reference", help="bench output of the reference build")
+    parser.add_argument("--tolerance", type=float, default=10.0,
+                        help="allowed slow down vs the reference, in %% (default 10)")
+    parser.add_argument("--record", help="JSON history file to append the results to")
+    args = parser.parse_args()
+
+    results = parse_log(args.log)
+    errors = []
+
+    worst = results["mixer_worst"]
+    if worst is None:
+        print("warning: no mixer worst case in the log")
+    elif not worst["pass"]:
+        errors.append("mixer worst case %dus exceeds the %dus budget"
+                      % (worst["us"], worst["budget"]))
+
+    if args.reference:
+        reference = parse_log(args.reference)
+        for name, ns in sorted(results["kernels"].items()):
+            ref = reference["kernels"].get(name)
+            if not ref:
+                continue
+            delta = (ns - ref) * 100.0 / ref
+            print("%-24s %10d ns %10d ns %+6.1f%%" % (name, ref, ns, delta))
+            if delta > args.tolerance:
+                errors.append("%s is %.1f%% slower than the reference" % (name, delta))
+
+    if args.record:
+        try:
+            with open(args.record) as f:
+                history = json.load(f)
+        except (IOError, ValueError):
+            history = []
+        history.append(results)
+        with open(args.record, "w") as f:
+            json.dump(history, f, indent=2)
+
+    for error in errors:
+        print("error: " + error)
+
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
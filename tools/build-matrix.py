@@ -0,0 +1,143 @@
+#!/usr/bin/python3
+
+# Builds several firmware targets at the same time.
+#
+# Each target keeps its own build directory between runs, so that only
+# what changed is rebuilt, and ccache (when installed) shares the objects
+# which are identical between targets.
+
+import argparse
+import concurrent.futures
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from boards import boards
+
+
+def target_name(board, translation):
+    return "%s-%s" % (board.lower().replace("+", "p"), translation.lower())
+
+
+def cmake_options(board, translation, extra_options, use_ccache):
+    options = ["-D%s=%s" % (key, value) for key, value in boards[board].items()]
+    options.append("-DTRANSLATIONS=%s" % translation)
+    options.append("-DCMAKE_BUILD_TYPE=Release")
+    options.append("-DCMAKE_RULE_MESSAGES=OFF")
+    if use_ccache:
+        options.append("-DCMAKE_C_COMPILER_LAUNCHER=ccache")
+        options.append("-DCMAKE_CXX_COMPILER_LAUNCHER=ccache")
+    options += ["-D%s" % option for option in extra_options]
+    return options
+
+
+def run(command, cwd, log):
+    log.write("$ %s\n" % " ".join(command))
+    log.flush()
+    return subprocess.call(command, cwd=cwd, stdout=log, stderr=subprocess.STDOUT) == 0
+
+
+def build(board, translation, args, use_ccache):
+    name = target_name(board, translation)
+    path = os.path.join(args.build_dir, name)
+    os.makedirs(path, exist_ok=True)
+    options = cmake_options(board, translation, args.options, use_ccache)
+    result = {"name": name, "ok": False, "configure": 0.0, "build": 0.0}
+
+    with open(os.path.join(args.build_dir, name + ".log"), "w") as log:
+        # configure again only when the options changed
+        stamp = os.path.join(path, "build-matrix.options")
+        previous = open(stamp).read() if os.path.exists(stamp) else None
+        start = time.time()
+        if previous != "\n".join(options):
+            if os.path.exists(stamp):
+                os.remove(stamp)
+            for cache in ("CMakeCache.txt", "arm-none-eabi/CMakeCache.txt"):
+                if os.path.exists(os.path.join(path, cache)):
+                    os.remove(os.path.join(path, cache))
+            if not run(["cmake"] + options + ["-Wno-dev", args.srcdir], path, log) or \
+               not run(["cmake", "--build", ".", "--target", "arm-none-eabi-configure"], path, log):
+                result["configure"] = time.time() - start
+                return result
+            with open(stamp, "w") as f:
+                f.write("\n".join(options))
+        result["configure"] = time.time() - start
+
+        start = time.time()
+        if not run(["cmake", "--build", "arm-none-eabi", "-j%d" % args.jobs, "--target", args.target], path, log):
+            result["build"] = time.time() - start
+            return result
+        result["build"] = time.time() - start
+
+    os.makedirs(args.output, exist_ok=True)
+    shutil.copy(os.path.join(path, "arm-none-eabi", "firmware.bin"), os.path.join(args.output, name + ".bin"))
+    result["ok"] = True
+    return result
+
+
+def dir_path(string):
+    if os.path.isdir(string):
+        return os.path.abspath(string)
+    else:
+        raise NotADirectoryError(string)
+
+
+def main():
+    cpus = os.cpu_count() or 2
+
+    parser = argparse.ArgumentParser(description="Build several firmware targets in parallel")
+    parser.add_argument("-b", "--boards", action="append", help="Destination boards (see boards.py), ALL for all", required=True)
+    parser.add_argument("-t", "--translations", action="append", help="Translations (default EN)")
+    parser.add_argument("-D", dest="options", action="append", default=[], help="Extra CMake option, e.g. -D LUA=NO")
+    parser.add_argument("-p", "--parallel", type=int, default=max(1, cpus // 4), help="Targets built at the same time")
+    parser.add_argument("-j", "--jobs", type=int, default=0, help="Compile jobs per target (default cores / parallel)")
+    parser.add_argument("--target", default="firmware", help="Firmware target (firmware, firmware-size)")
+    parser.add_argument("--build-dir", default="build-matrix", help="Build directories, kept between runs")
+    parser.add_argument("--output", default="output", help="Firmware output directory")
+    parser.add_argument("--no-ccache", action="store_true", help="Do not use ccache")
+    parser.add_argument("srcdir", type=dir_path)
+
+    args = parser.parse_args()
+    args.build_dir = os.path.abspath(args.build_dir)
+    if args.jobs <= 0:
+        args.jobs = max(1, cpus // args.parallel)
+
+    use_ccache = not args.no_ccache and shutil.which("ccache") is not None
+    if use_ccache:
+        # objects are shared between the build directories of all targets
+        os.environ.setdefault("CCACHE_BASEDIR", os.path.commonpath([args.srcdir, args.build_dir]))
+        os.environ.setdefault("CCACHE_NOHASHDIR", "1")
+
+    targets = []
+    for board in (boards.keys() if "ALL" in args.boards else args.boards):
+        if board not in boards:
+            parser.error("unknown board %s" % board)
+        for translation in (args.translations or ["EN"]):
+            targets.append((board, translation))
+
+    print("Building %d targets, %d at a time with -j%d%s" % (len(targets), args.parallel, args.jobs, ", ccache" if use_ccache else ""))
+    os.makedirs(args.build_dir, exist_ok=True)
+
+    start = time.time()
+    results = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.parallel) as executor:
+        futures = [executor.submit(build, board, translation, args, use_ccache) for board, translation in targets]
+        for future in concurrent.futures.as_completed(futures):
+            result = future.result()
+            print("%-24s %s" % (result["name"], "ok" if result["ok"] else "FAILED (see %s.log)" % os.path.join(args.build_dir, result["name"])))
+            results.append(result)
+
+    print()
+    print("%-24s %10s %10s" % ("target", "configure", "build"))
+    for result in sorted(results, key=lambda r: r["name"]):
+        print("%-24s %9.1fs %9.1fs%s" % (result["name"], result["configure"], result["build"], "" if result["ok"] else "  FAILED"))
+    print("total %.1fs" % (time.time() - start))
+
+    return 0 if all(result["ok"] for result in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,207 @@
+#!/usr/bin/python3
+
+# RAM / flash usage report from the linker map file (firmware.map), by
+# memory region, module and symbol, optionally compared with the map of a
+# baseline build.
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+from collections import defaultdict
+
+
+OUTPUT_SECTION = re.compile(r"^(\.\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)(?:\s+load address 0x([0-9a-f]+))?")
+OUTPUT_SECTION_NAME = re.compile(r"^(\.\S+)\s*$")
+INPUT_SECTION = re.compile(r"^ (\.\S+|COMMON)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*))?$")
+INPUT_SECTION_TAIL = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$")
+REGION = re.compile(r"^(\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)")
+
+SYMBOL_PREFIXES = (".text.", ".rodata.", ".data.", ".bss.", ".ccm.", ".sdram.", ".ram.")
+
+
+class MapFile:
+    def __init__(self, lines, depth):
+        self.regions = []     # (name, origin, length)
+        self.usage = defaultdict(int)          # region -> bytes
+        self.modules = defaultdict(int)        # (region, module) -> bytes
+        self.symbols = defaultdict(int)        # (region, symbol, module) -> bytes
+        self.depth = depth
+        self.parse(lines)
+
+    def region(self, address):
+        for name, origin, length in self.regions:
+            if origin <= address < origin + length and length < 0xffffffff:
+                return name
+        return None
+
+    def module(self, path):
+        archive = re.match(r"(.*/)?([^/]+\.a)\(", path)
+        if archive:
+            return archive.group(2)
+        marker = "CMakeFiles/firmware.dir/"
+        if marker in path:
+            path = path.split(marker, 1)[1]
+        parts = path.replace("\\", "/").split("/")
+        if len(parts) == 1:
+            return parts[0]
+        return "/".join(parts[:min(self.depth, len(parts) - 1)])
+
+    def add(self, section, address, size, path, load_region):
+        region = self.region(address)
+        if not region or not size:
+            return
+        module = self.module(path)
+        symbol = section
+        for prefix in SYMBOL_PREFIXES:
+            if section.startswith(prefix):
+                symbol = section[len(prefix):]
+                break
+        self.usage[region] += size
+        self.modules[(region, module)] += size
+        self.symbols[(region, symbol, module)] += size
+        # initialised data is copied from flash (uninitialised sections get
+        # a load address too, but nothing is stored there)
+        if load_region and load_region != region and section.startswith(".data"):
+            self.usage[load_region] += size
+            self.modules[(load_region, module)] += size
+
+    def parse(self, lines):
+        i = 0
+        # memory regions
+        while i < len(lines) and not lines[i].startswith("Memory Configuration"):
+            i += 1
+        i += 1
+        while i < len(lines) and not lines[i].startswith("Linker script and memory map"):
+            match = REGION.match(lines[i])
+            if match and match.group(1) != "Name":
+                self.regions.append((match.group(1), int(match.group(2), 16), int(match.group(3), 16)))
+            i += 1
+
+        load_region = None
+        pending_output = False
+        while i < len(lines):
+            line = lines[i].rstrip("\n")
+            i += 1
+            if line.startswith("Cross Reference Table"):
+                break
+
+            if pending_output or line.startswith("."):
+                if pending_output:
+                    line = lines[i - 2].rstrip("\n") + line
+                    pending_output = False
+                match = OUTPUT_SECTION.match(line)
+                if match:
+                    address = int(match.group(2), 16)
+                    load = match.group(4)
+                    load_region = self.region(int(load, 16)) if load else None
+                    if load_region == self.region(address):
+                        load_region = None
+                elif OUTPUT_SECTION_NAME.match(line):
+                    pending_output = True
+                continue
+
+            match = INPUT_SECTION.match(line)
+            if not match:
+                continue
+            section = match.group(1)
+            if match.group(2) is None:
+                # long names: address, size and object on the next line
+                if i >= len(lines):
+                    break
+                tail = INPUT_SECTION_TAIL.match(lines[i].rstrip("\n"))
+                if not tail:
+                    continue
+                i += 1
+                address, size, path = tail.groups()
+            else:
+                address, size, path = match.group(2), match.group(3), match.group(4)
+            self.add(section, int(address, 16), int(size, 16), path.strip(), load_region)
+
+
+def demangle(names):
+    tool = shutil.which("arm-none-eabi-c++filt") or shutil.which("c++filt")
+    if not tool or not names:
+        return {name: name for name in names}
+    result = subprocess.run([tool], input="\n".join(names), capture_output=True, text=True).stdout.splitlines()
+    return dict(zip(names, result)) if len(result) == len(names) else {name: name for name in names}
+
+
+def load(filename, depth):
+    with open(filename) as f:
+        return MapFile(f.readlines(), depth)
+
+
+def print_table(title, rows, count, delta=False):
+    print()
+    print(title)
+    for name, value in rows[:count]:
+        print("  %10s  %s" % (("%+d" % value) if delta else value, name))
+
+
+def report(current, regions, count):
+    for name, origin, length in current.regions:
+        if name in regions:
+            used = current.usage.get(name, 0)
+            print("%-12s %8d / %8d bytes  %5.1f%%" % (name, used, length, 100.0 * used / length))
+
+    names = demangle(sorted({symbol for (region, symbol, module) in current.symbols}))
+    for region in regions:
+        modules = sorted(((module, size) for (r, module), size in current.modules.items() if r == region),
+                         key=lambda item: -item[1])
+        print_table("%s by module" % region, modules, count)
+        symbols = sorted((("%s (%s)" % (names[symbol], module), size)
+                          for (r, symbol, module), size in current.symbols.items() if r == region),
+                         key=lambda item: -item[1])
+        print_table("%s by symbol" % region, symbols, count)
+
+
+def diff(current, baseline, regions, count):
+    for name, origin, length in current.regions:
+        if name in regions:
+            used = current.usage.get(name, 0)
+            delta = used - baseline.usage.get(name, 0)
+            print("%-12s %8d bytes  %+d" % (name, used, delta))
+
+    def deltas(new, old, region, key):
+        values = defaultdict(int)
+        for k, size in new.items():
+            if k[0] == region:
+                values[key(k)] += size
+        for k, size in old.items():
+            if k[0] == region:
+                values[key(k)] -= size
+        return sorted(((name, value) for name, value in values.items() if value),
+                      key=lambda item: -abs(item[1]))
+
+    names = demangle(sorted({symbol for (region, symbol, module) in list(current.symbols) + list(baseline.symbols)}))
+    for region in regions:
+        print_table("%s changes by module" % region,
+                    deltas(current.modules, baseline.modules, region, lambda k: k[1]), count, True)
+        print_table("%s changes by symbol" % region,
+                    deltas(current.symbols, baseline.symbols, region, lambda k: names[k[1]]), count, True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report RAM and flash usage from a linker map file")
+    parser.add_argument("map", help="Map file (firmware.map)")
+    parser.add_argument("-b", "--baseline", help="Map file of a baseline build to compare with")
+    parser.add_argument("-r", "--region", action="append", help="Memory regions (default: all used)")
+    parser.add_argument("-n", "--count", type=int, default=20, help="Rows per table")
+    parser.add_argument("-d", "--depth", type=int, default=2, help="Directory depth of the modules")
+
+    args = parser.parse_args()
+
+    current = load(args.map, args.depth)
+    regions = args.region or [name for name, origin, length in current.regions if current.usage.get(name)]
+
+    print(os.path.abspath(args.map))
+    if args.baseline:
+        diff(current, load(args.baseline, args.depth), regions, args.count)
+    else:
+        report(current, regions, args.count)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) EdgeTX
+#
+# License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# Decodes the "Telem Stream" serial port mode, read from a serial
+# device (USB VCP or AUX at 921600 baud) or from a capture file,
+# and prints one line per frame.
+
+import argparse
+import struct
+import sys
+
+# Must match radio/src/telemetry/telemetry_stream.h
+SYNC = 0xA5
+CHANNELS = 1
+SENSORS = 2
+RAW = 3
+
+
+def crc8(data):
+    # polynomial 0xD5, as crc8() in radio/src/crc.cpp
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0xD5) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def frames(read):
+    buf = bytearray()
+    while True:
+        chunk = read()
+        if not chunk:
+            return
+        buf += chunk
+        while len(buf) >= 4:
+            if buf[0] != SYNC:
+                del buf[0]
+                continue
+            size = 4 + buf[2]
+            if len(buf) < size:
+                break
+            if crc8(buf[1:size - 1]) != buf[size - 1]:
+                del buf[0]
+                continue
+            yield buf[1], bytes(buf[3:size - 1])
+            del buf[:size]
+
+
+def decode(ftype, payload):
+    if ftype == CHANNELS:
+        ms, = struct.unpack_from('<I', payload)
+        count = (len(payload) - 4) // 2
+        channels = struct.unpack_from('<%dh' % count, payload, 4)
+        return 'channels,%d,%s' % (ms, ','.join(str(c) for c in channels))
+    if ftype == SENSORS:
+        entries = []
+        for off in range(0, len(payload) - 6, 7):
+            idx, value, unit, prec = struct.unpack_from('<BiBB', payload, off)
+            entries.append('%d:%s/u%d' % (idx, value / 10 ** prec if prec else value, unit))
+        return 'sensors,' + ','.join(entries)
+    if ftype == RAW:
+        return 'raw,%d,%s' % (payload[0], payload[1:].hex())
+    return 'unknown,%d,%s' % (ftype, payload.hex())
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the telemetry stream')
+    parser.add_argument('input', help='serial device or capture file')
+    parser.add_argument('--baudrate', type=int, default=921600)
+    parser.add_argument('--no-raw', action='store_true', help='hide raw frames')
+    args = parser.parse_args()
+
+    if args.input.startswith('/dev/') or args.input.upper().startswith('COM'):
+        import serial
+        port = serial.Serial(args.input, args.baudrate, timeout=1)
+
+        def read():
+            # blocks until data arrives
+            while True:
+                data = port.read(port.in_waiting or 1)
+                if data:
+                    return data
+    else:
+        f = open(args.input, 'rb')
+        read = lambda: f.read(4096)
+
+    try:
+        for ftype, payload in frames(read):
+            if args.no_raw and ftype == RAW:
+                continue
+            print(decode(ftype, payload))
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    sys.exit(main())
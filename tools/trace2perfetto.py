@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) EdgeTX
+#
+# License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# Converts an event trace into the Chrome trace format, which can be
+# opened with https://ui.perfetto.dev or chrome://tracing.
+#
+# The input is either the output of the CLI "evtrace dump" command,
+# or with --binary the raw records streamed over the Segger RTT up
+# buffer 1 (8 bytes each: ticks, event, arg, little endian).
+
+import argparse
+import json
+import struct
+import sys
+
+# Must match EventTraceId in radio/src/event_trace.h
+EVENTS = {
+    1: "task",
+    2: "mixer_begin",
+    3: "mixer_end",
+    4: "pulses_tx",
+    5: "telemetry_rx",
+    6: "sd_read_begin",
+    7: "sd_read_end",
+    8: "sd_write_begin",
+    9: "sd_write_end",
+    10: "lua_begin",
+    11: "lua_end",
+}
+
+# One timeline per kind of event
+THREADS = {
+    "task": 1,
+    "mixer": 2,
+    "pulses": 3,
+    "telemetry": 4,
+    "sd": 5,
+    "lua": 6,
+}
+
+
+def parse_dump(filename):
+    trace = {"clock": None, "tasks": {}, "events": dict(EVENTS), "records": []}
+    with open(filename) as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) < 2 or fields[0] != "evtrace":
+                continue
+            if fields[1] == "clock":
+                trace["clock"] = int(fields[2])
+            elif fields[1] == "task":
+                trace["tasks"][int(fields[2])] = fields[3]
+            elif fields[1] == "event":
+                trace["events"][int(fields[2])] = fields[3]
+            elif fields[1] == "rec":
+                trace["records"].append(tuple(int(v) for v in fields[2:5]))
+    return trace
+
+
+def parse_binary(filename):
+    trace = {"clock": None, "tasks": {}, "events": dict(EVENTS), "records": []}
+    with open(filename, "rb") as f:
+        data = f.read()
+    for offset in range(0, len(data) - 7, 8):
+        trace["records"].append(struct.unpack_from("<IHH", data, offset))
+    return trace
+
+
+def convert(trace, clock):
+    events = []
+    for name, tid in THREADS.items():
+        events.append({"ph": "M", "name": "thread_name", "pid": 1,
+                       "tid": tid, "args": {"name": name}})
+
+    last = None
+    time = 0
+    task = None
+    for ticks, event, arg in trace["records"]:
+        # unwrap the 32 bit cycle counter
+        if last is not None:
+            time += (ticks - last) & 0xFFFFFFFF
+        last = ticks
+        us = time / clock
+
+        name = trace["events"].get(event, "event%d" % event)
+        if name == "task":
+            if task is not None:
+                task["dur"] = us - task["ts"]
+                events.append(task)
+            task = {"ph": "X", "pid": 1, "tid": THREADS["task"], "ts": us,
+                    "name": trace["tasks"].get(arg, "task%d" % arg)}
+        elif name.endswith("_begin") or name.endswith("_end"):
+            kind, _, phase = name.rpartition("_")
+            slice = {"ph": "B" if phase == "begin" else "E", "pid": 1,
+                     "tid": THREADS.get(kind.split("_")[0], 0), "ts": us,
+                     "name": kind}
+            if phase == "begin":
+                slice["args"] = {"arg": arg}
+            events.append(slice)
+        else:
+            events.append({"ph": "i", "s": "t", "pid": 1,
+                           "tid": THREADS.get(name.split("_")[0], 0),
+                           "ts": us, "name": name, "args": {"arg": arg}})
+
+    if task is not None:
+        task["dur"] = 0
+        events.append(task)
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert an EdgeTX event trace to the Chrome trace format")
+    parser.add_argument("input", help="CLI \"evtrace dump\" log or RTT capture")
+    parser.add_argument("output", help="JSON trace file")
+    parser.add_argument("--binary", action="store_true",
+                        help="input is a raw RTT capture")
+    parser.add_argument("--clock", type=int,
+                        help="CPU cycles per us (required with --binary)")
+    args = parser.parse_args()
+
+    trace = parse_binary(args.input) if args.binary else parse_dump(args.input)
+    clock = args.clock or trace["clock"]
+    if not clock:
+        print("error: unknown clock, use --clock", file=sys.stderr)
+        return 1
+    if not trace["records"]:
+        print("error: no event in %s" % args.input, file=sys.stderr)
+        return 1
+
+    with open(args.output, "w") as f:
+        json.dump(convert(trace, clock), f)
+    print("%d events converted" % len(trace["records"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())